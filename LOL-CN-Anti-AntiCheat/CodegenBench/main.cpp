@@ -0,0 +1,194 @@
+// CodegenBench: measures stub generation throughput of the bundled asmjit
+// through the Assembler, Builder, and Compiler front ends using the stub
+// shapes the project actually emits (remote call stubs, hook thunks,
+// syscall stubs), reporting stubs/sec plus code and zone bytes per stub.
+#include <windows.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include <asmjit/x86.h>
+
+using namespace asmjit;
+
+namespace
+{
+	constexpr int k_rounds = 5;
+	constexpr int k_iterations = 20000;
+
+	//Placeholder addresses; the stubs are generated, never executed
+	constexpr uint32_t k_target = 0xDEAD0010;
+	constexpr uint32_t k_context = 0xDEAD0020;
+	constexpr uint32_t k_result = 0xDEAD0030;
+	constexpr uint32_t k_original = 0xDEAD0040;
+
+	CodeInfo s_code_info(ArchInfo::kIdX86);
+	CodeHolderPool s_pool;
+
+	struct stub_cost_t
+	{
+		size_t code_bytes;
+		size_t zone_bytes;
+	};
+
+	//Remote call stub: push the argument pack, call the target, store the
+	//result for the caller to collect -- the RemoteExec shape
+	template<typename emitter_t>
+	Error EmitCallStub(emitter_t& e)
+	{
+		ASMJIT_PROPAGATE(e.push(2));
+		ASMJIT_PROPAGATE(e.push(1));
+		ASMJIT_PROPAGATE(e.push(0));
+		ASMJIT_PROPAGATE(e.mov(x86::eax, k_target));
+		ASMJIT_PROPAGATE(e.call(x86::eax));
+		ASMJIT_PROPAGATE(e.add(x86::esp, 12));
+		ASMJIT_PROPAGATE(e.mov(x86::dword_ptr(k_result), x86::eax));
+		ASMJIT_PROPAGATE(e.ret());
+		return kErrorOk;
+	}
+
+	//Hook thunk: preserve state, hand the context to the handler, continue
+	//at the original
+	template<typename emitter_t>
+	Error EmitHookThunk(emitter_t& e)
+	{
+		ASMJIT_PROPAGATE(e.pushad());
+		ASMJIT_PROPAGATE(e.pushfd());
+		ASMJIT_PROPAGATE(e.push(k_context));
+		ASMJIT_PROPAGATE(e.mov(x86::eax, k_target));
+		ASMJIT_PROPAGATE(e.call(x86::eax));
+		ASMJIT_PROPAGATE(e.popfd());
+		ASMJIT_PROPAGATE(e.popad());
+		ASMJIT_PROPAGATE(e.jmp(x86::dword_ptr(k_original)));
+		return kErrorOk;
+	}
+
+	//Syscall stub: number in eax, through the fast system call gate, back
+	template<typename emitter_t>
+	Error EmitSyscallStub(emitter_t& e)
+	{
+		ASMJIT_PROPAGATE(e.mov(x86::eax, 0x10A));
+		ASMJIT_PROPAGATE(e.mov(x86::edx, x86::esp));
+		ASMJIT_PROPAGATE(e.call(x86::dword_ptr(0x7FFE0300)));
+		ASMJIT_PROPAGATE(e.ret(8));
+		return kErrorOk;
+	}
+
+	//The Compiler path builds the call stub from virtual registers so the
+	//register allocator is part of the measurement
+	Error BuildCompilerCallStub(x86::Compiler& cc)
+	{
+		const FuncSignatureT<uint32_t, uint32_t, uint32_t, uint32_t> v_sign(CallConv::kIdHostCDecl);
+		cc.addFunc(v_sign);
+
+		x86::Gp v_a0 = cc.newUInt32("a0");
+		x86::Gp v_a1 = cc.newUInt32("a1");
+		x86::Gp v_a2 = cc.newUInt32("a2");
+		cc.setArg(0, v_a0);
+		cc.setArg(1, v_a1);
+		cc.setArg(2, v_a2);
+
+		x86::Gp v_ret = cc.newUInt32("ret");
+		FuncCallNode* v_call = cc.call(imm(k_target), v_sign);
+		v_call->setArg(0, v_a0);
+		v_call->setArg(1, v_a1);
+		v_call->setArg(2, v_a2);
+		v_call->setRet(0, v_ret);
+
+		cc.mov(x86::dword_ptr(k_result), v_ret);
+		cc.ret(v_ret);
+
+		ASMJIT_PROPAGATE(cc.endFunc());
+		return cc.finalize();
+	}
+
+	template<typename run_t>
+	void Bench(const char* name, run_t&& run)
+	{
+		LARGE_INTEGER v_freq = {};
+		QueryPerformanceFrequency(&v_freq);
+
+		//One representative run outside the timed loop reports memory;
+		//zone bytes are the holder high-water mark since the pool keeps
+		//blocks across soft resets
+		const stub_cost_t v_cost = run();
+
+		double v_best_sec = 1e100;
+		size_t v_sink = 0;
+
+		for (int r = 0; r < k_rounds; ++r)
+		{
+			LARGE_INTEGER v_begin = {}, v_end = {};
+			QueryPerformanceCounter(&v_begin);
+
+			for (int i = 0; i < k_iterations; ++i)
+				v_sink += run().code_bytes;
+
+			QueryPerformanceCounter(&v_end);
+			v_best_sec = std::min(v_best_sec, double(v_end.QuadPart - v_begin.QuadPart) / double(v_freq.QuadPart));
+		}
+
+		const auto v_stubs_per_sec = double(k_iterations) / v_best_sec;
+		printf("%-24s %11.0f stubs/sec   %4zu code bytes   %6zu zone bytes   (sink %zu)\n",
+			name, v_stubs_per_sec, v_cost.code_bytes, v_cost.zone_bytes, v_sink);
+	}
+
+	template<typename emit_t>
+	stub_cost_t RunAssembler(emit_t&& emit)
+	{
+		CodeHolder* v_code = s_pool.acquire(s_code_info);
+		{
+			x86::Assembler v_asm(v_code);
+			emit(v_asm);
+		}
+
+		const stub_cost_t v_cost = { v_code->codeSize(), v_code->_zone.statistics().reservedSize() };
+		s_pool.release(v_code);
+		return v_cost;
+	}
+
+	template<typename emit_t>
+	stub_cost_t RunBuilder(emit_t&& emit)
+	{
+		CodeHolder* v_code = s_pool.acquire(s_code_info);
+		{
+			x86::Builder v_builder(v_code);
+			emit(v_builder);
+			v_builder.finalize();
+		}
+
+		const stub_cost_t v_cost = { v_code->codeSize(), v_code->_zone.statistics().reservedSize() };
+		s_pool.release(v_code);
+		return v_cost;
+	}
+
+	stub_cost_t RunCompiler()
+	{
+		CodeHolder* v_code = s_pool.acquire(s_code_info);
+		{
+			x86::Compiler v_cc(v_code);
+			BuildCompilerCallStub(v_cc);
+		}
+
+		const stub_cost_t v_cost = { v_code->codeSize(), v_code->_zone.statistics().reservedSize() };
+		s_pool.release(v_code);
+		return v_cost;
+	}
+}
+
+int wmain()
+{
+	printf("best of %d rounds, %d stubs per round\n\n", k_rounds, k_iterations);
+
+	Bench("asm/call-stub", [] { return RunAssembler([](x86::Assembler& a) { EmitCallStub(a); }); });
+	Bench("asm/hook-thunk", [] { return RunAssembler([](x86::Assembler& a) { EmitHookThunk(a); }); });
+	Bench("asm/syscall-stub", [] { return RunAssembler([](x86::Assembler& a) { EmitSyscallStub(a); }); });
+
+	Bench("builder/call-stub", [] { return RunBuilder([](x86::Builder& b) { EmitCallStub(b); }); });
+	Bench("builder/hook-thunk", [] { return RunBuilder([](x86::Builder& b) { EmitHookThunk(b); }); });
+	Bench("builder/syscall-stub", [] { return RunBuilder([](x86::Builder& b) { EmitSyscallStub(b); }); });
+
+	Bench("compiler/call-stub", [] { return RunCompiler(); });
+
+	return 0;
+}
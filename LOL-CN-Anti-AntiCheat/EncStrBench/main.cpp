@@ -0,0 +1,152 @@
+// EncStrBench: measures encstr decrypt cost per cipher/mode/length and
+// scans its own image afterwards to assert that no protected literal
+// survived into the binary as plaintext.
+#include <windows.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include <encstr/ciphers/xor_cipher.hpp>
+#include <encstr/ciphers/xtea_cipher.hpp>
+#include <encstr/ecb.hpp>
+#include <encstr/cbc.hpp>
+#include <encstr/string.hpp>
+
+//The lengths cover the shapes we actually protect: short module names up
+//to path-sized strings
+#define BENCH_STR_8  L"Probe_08"
+#define BENCH_STR_16 L"Probe_Sixteen_16"
+#define BENCH_STR_32 L"Probe_ThirtyTwoCharacters_Long32"
+#define BENCH_STR_64 L"Probe_SixtyFourCharacters_PaddedOutToTheFullLength_0123456789ab64"
+
+namespace
+{
+	constexpr int k_rounds = 5;
+	constexpr int k_iterations = 200000;
+
+	template<typename run_t>
+	void Bench(const char* name, size_t chars, run_t&& run)
+	{
+		LARGE_INTEGER v_freq = {};
+		QueryPerformanceFrequency(&v_freq);
+
+		double v_best_sec = 1e100;
+		unsigned v_sink = 0;
+
+		for (int r = 0; r < k_rounds; ++r)
+		{
+			LARGE_INTEGER v_begin = {}, v_end = {};
+			QueryPerformanceCounter(&v_begin);
+
+			for (int i = 0; i < k_iterations; ++i)
+				v_sink += run();
+
+			QueryPerformanceCounter(&v_end);
+			v_best_sec = std::min(v_best_sec, double(v_end.QuadPart - v_begin.QuadPart) / double(v_freq.QuadPart));
+		}
+
+		const auto v_ns_per_char = v_best_sec * 1e9 / double(k_iterations) / double(chars);
+		printf("%-24s %8.3f ns/char   (sink %u)\n", name, v_ns_per_char, v_sink);
+	}
+
+	//Probe characters are stored xor 0x5A at compile time so the scanner
+	//does not plant the very plaintext it is looking for
+	template<size_t N>
+	struct obf_probe_t
+	{
+		uint8_t bytes[(N - 1) * sizeof(wchar_t)];
+
+		constexpr obf_probe_t(const wchar_t (&str)[N]) :
+			bytes{}
+		{
+			for (size_t i = 0; i + 1 < N; ++i)
+			{
+				bytes[i * 2] = static_cast<uint8_t>(static_cast<uint8_t>(str[i] & 0xff) ^ 0x5A);
+				bytes[i * 2 + 1] = static_cast<uint8_t>(static_cast<uint8_t>((str[i] >> 8) & 0xff) ^ 0x5A);
+			}
+		}
+	};
+
+	template<size_t Size>
+	bool ImageContains(const uint8_t (&obf)[Size])
+	{
+		uint8_t v_probe[Size];
+		for (size_t i = 0; i < Size; ++i)
+			v_probe[i] = static_cast<uint8_t>(obf[i] ^ 0x5A);
+
+		const auto* v_base = reinterpret_cast<const uint8_t*>(GetModuleHandleW(nullptr));
+		const auto* v_dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(v_base);
+		const auto* v_nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(v_base + v_dos->e_lfanew);
+		const auto* v_sections = IMAGE_FIRST_SECTION(v_nt);
+
+		for (WORD s = 0; s < v_nt->FileHeader.NumberOfSections; ++s)
+		{
+			const auto* v_begin = v_base + v_sections[s].VirtualAddress;
+			const size_t v_size = v_sections[s].Misc.VirtualSize;
+			if (v_size < Size)
+				continue;
+
+			for (size_t i = 0; i + Size <= v_size; ++i)
+			{
+				if (memcmp(v_begin + i, v_probe, Size) == 0)
+					return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+//Each cell copies the constexpr-encrypted string and decrypts the copy --
+//the exact runtime pattern of an ENCRYPT_STRING site, decrypt-once state
+//included
+#define BENCH_CELL(name, mode_t, str) \
+	{ \
+		constexpr encstr::string_t<wchar_t, mode_t, std::make_index_sequence<std::size(str) - 1>> v_str(str, \
+			encstr::generate_random_block<__COUNTER__, mode_t::key_size>(), \
+			encstr::generate_random_block<__COUNTER__, mode_t::block_size>()); \
+		Bench(name, std::size(str) - 1, [&]() { auto v_copy = v_str; return unsigned(v_copy.decrypt()[0]); }); \
+	}
+
+int wmain()
+{
+	using xor_ecb = encstr::ecb_t<encstr::ciphers::xor_cipher_t>;
+	using xor_cbc = encstr::cbc_t<encstr::ciphers::xor_cipher_t>;
+	using xtea_ecb = encstr::ecb_t<encstr::ciphers::xtea_cipher_t>;
+	using xtea_cbc = encstr::cbc_t<encstr::ciphers::xtea_cipher_t>;
+
+	printf("best of %d rounds, %d decrypts per round\n\n", k_rounds, k_iterations);
+
+	BENCH_CELL("xor/ecb/8", xor_ecb, BENCH_STR_8);
+	BENCH_CELL("xor/ecb/16", xor_ecb, BENCH_STR_16);
+	BENCH_CELL("xor/ecb/32", xor_ecb, BENCH_STR_32);
+	BENCH_CELL("xor/ecb/64", xor_ecb, BENCH_STR_64);
+
+	BENCH_CELL("xor/cbc/8", xor_cbc, BENCH_STR_8);
+	BENCH_CELL("xor/cbc/16", xor_cbc, BENCH_STR_16);
+	BENCH_CELL("xor/cbc/32", xor_cbc, BENCH_STR_32);
+	BENCH_CELL("xor/cbc/64", xor_cbc, BENCH_STR_64);
+
+	BENCH_CELL("xtea/ecb/8", xtea_ecb, BENCH_STR_8);
+	BENCH_CELL("xtea/ecb/16", xtea_ecb, BENCH_STR_16);
+	BENCH_CELL("xtea/ecb/32", xtea_ecb, BENCH_STR_32);
+	BENCH_CELL("xtea/ecb/64", xtea_ecb, BENCH_STR_64);
+
+	BENCH_CELL("xtea/cbc/8", xtea_cbc, BENCH_STR_8);
+	BENCH_CELL("xtea/cbc/16", xtea_cbc, BENCH_STR_16);
+	BENCH_CELL("xtea/cbc/32", xtea_cbc, BENCH_STR_32);
+	BENCH_CELL("xtea/cbc/64", xtea_cbc, BENCH_STR_64);
+
+	//Codegen regression check: if a toolset update demotes the constexpr
+	//encrypt to runtime work, the literal lands in the image and this scan
+	//turns red
+	static constexpr obf_probe_t v_probe8(BENCH_STR_8);
+	static constexpr obf_probe_t v_probe64(BENCH_STR_64);
+
+	const bool v_leak = ImageContains(v_probe8.bytes) || ImageContains(v_probe64.bytes);
+	printf("\nplaintext leak scan: %s\n", v_leak ? "FAILED - literal found in image" : "clean");
+
+	return v_leak ? 1 : 0;
+}
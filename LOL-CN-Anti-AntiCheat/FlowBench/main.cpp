@@ -0,0 +1,288 @@
+// FlowBench: end-to-end regression gate over the composed flows we ship:
+// attach-to-ready, reconnect re-attach, verification sweep and patch
+// application, driven against a dummy child of this exe with a captured
+// module dump staged into its address space. Phase timings are compared
+// against FlowBench.baseline.txt next to the exe; any phase slower than
+// baseline + threshold fails the run. Kernels have their own benches,
+// this is the gate before a build rolls to production seats.
+// Usage: FlowBench.exe <module dump file> [--rebase] [--threshold <pct>]
+//        FlowBench.exe --target            (internal, dummy target mode)
+#include <windows.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <BlackBone/Process/Process.h>
+#include <BlackBone/Process/WriteBatch.h>
+#include <BlackBone/Patterns/PatternSearch.h>
+
+namespace
+{
+	constexpr int k_iterations = 3;
+	constexpr double k_default_threshold_pct = 25.0;
+	constexpr wchar_t k_baseline_name[] = L"FlowBench.baseline.txt";
+
+	auto LoadDump(const wchar_t* path) -> std::vector<uint8_t>
+	{
+		std::ifstream v_file(path, std::ios::binary | std::ios::ate);
+		if (!v_file.is_open())
+			return {};
+
+		const auto v_size = static_cast<size_t>(v_file.tellg());
+		std::vector<uint8_t> v_data(v_size);
+		v_file.seekg(0);
+		v_file.read(reinterpret_cast<char*>(v_data.data()), v_size);
+		return v_data;
+	}
+
+	auto Now() -> double
+	{
+		static LARGE_INTEGER v_freq = []() { LARGE_INTEGER f = {}; QueryPerformanceFrequency(&f); return f; }();
+		LARGE_INTEGER v_qpc = {};
+		QueryPerformanceCounter(&v_qpc);
+		return double(v_qpc.QuadPart) * 1000.0 / double(v_freq.QuadPart);
+	}
+
+	//Phase record, same shape the dll's PhaseTimer reports at ready-state
+	struct phase_result
+	{
+		std::wstring _name_;
+		double _ms_;
+	};
+
+	std::vector<phase_result> g_phases;
+
+	//Best-of-k wall time for one composed flow
+	template<typename run_t>
+	bool Phase(const wchar_t* name, int iterations, run_t&& run)
+	{
+		double v_best_ms = 1e100;
+		for (int i = 0; i < iterations; ++i)
+		{
+			const auto v_begin = Now();
+			if (!run())
+			{
+				wprintf(L"%-24s FAILED\n", name);
+				return false;
+			}
+			const auto v_ms = Now() - v_begin;
+			if (v_ms < v_best_ms)
+				v_best_ms = v_ms;
+		}
+
+		g_phases.push_back({ name, v_best_ms });
+		return true;
+	}
+
+	auto BaselinePath() -> std::wstring
+	{
+		wchar_t v_path[MAX_PATH] = {};
+		GetModuleFileNameW(nullptr, v_path, MAX_PATH);
+		std::wstring v_dir(v_path);
+		v_dir.erase(v_dir.find_last_of(L'\\') + 1);
+		return v_dir + k_baseline_name;
+	}
+
+	auto LoadBaseline() -> std::map<std::wstring, double>
+	{
+		std::map<std::wstring, double> v_baseline;
+		std::wifstream v_file(BaselinePath());
+		std::wstring v_name;
+		double v_ms = 0.0;
+		while (v_file >> v_name >> v_ms)
+			v_baseline[v_name] = v_ms;
+		return v_baseline;
+	}
+
+	void SaveBaseline()
+	{
+		std::wofstream v_file(BaselinePath(), std::ios::trunc);
+		for (const auto& v_phase : g_phases)
+			v_file << v_phase._name_ << L" " << v_phase._ms_ << L"\n";
+	}
+
+	//Dummy target: stay alive until the driver terminates us
+	int RunTarget()
+	{
+		for (;;)
+			Sleep(1000);
+	}
+
+	auto SpawnTarget() -> PROCESS_INFORMATION
+	{
+		wchar_t v_exe[MAX_PATH] = {};
+		GetModuleFileNameW(nullptr, v_exe, MAX_PATH);
+
+		std::wstring v_cmdline = L"\"" + std::wstring(v_exe) + L"\" --target";
+		STARTUPINFOW v_si = { sizeof(v_si) };
+		PROCESS_INFORMATION v_pi = {};
+		if (!CreateProcessW(v_exe, v_cmdline.data(), nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr, &v_si, &v_pi))
+			v_pi.hProcess = nullptr;
+		return v_pi;
+	}
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+	if (argc >= 2 && wcscmp(argv[1], L"--target") == 0)
+		return RunTarget();
+
+	if (argc < 2)
+	{
+		printf("usage: FlowBench.exe <module dump file> [--rebase] [--threshold <pct>]\n");
+		return 1;
+	}
+
+	auto v_dump = LoadDump(argv[1]);
+	if (v_dump.size() < 64)
+	{
+		printf("failed to load dump\n");
+		return 1;
+	}
+
+	bool v_rebase = false;
+	double v_threshold_pct = k_default_threshold_pct;
+	for (int i = 2; i < argc; ++i)
+	{
+		if (wcscmp(argv[i], L"--rebase") == 0)
+			v_rebase = true;
+		else if (wcscmp(argv[i], L"--threshold") == 0 && i + 1 < argc)
+			v_threshold_pct = wcstod(argv[++i], nullptr);
+	}
+
+	auto v_target = SpawnTarget();
+	if (v_target.hProcess == nullptr)
+	{
+		printf("failed to spawn dummy target\n");
+		return 1;
+	}
+
+	wprintf(L"dump: %zu bytes, target pid %lu, best of %d runs\n\n", v_dump.size(), v_target.dwProcessId, k_iterations);
+
+	bool v_ok = true;
+	blackbone::Process v_proc;
+	blackbone::MemBlock v_fixture;
+
+	//Attach to the running target until fully usable: handle, module list,
+	//RPC environment with a persistent worker. This is the cold path a
+	//seat pays once per game launch, so it runs once, not best-of-k
+	v_ok = v_ok && Phase(L"attach-to-ready", 1, [&]() {
+		if (!NT_SUCCESS(v_proc.Attach(v_target.dwProcessId)))
+			return false;
+		if (!v_proc.modules().GetMainModule())
+			return false;
+		return NT_SUCCESS(v_proc.remote().CreateRPCEnvironment(blackbone::Worker_CreateNew, true));
+	});
+
+	//Stage the captured module fixture in the target so later flows scan
+	//and patch real module bytes
+	if (v_ok)
+	{
+		auto v_mem = v_proc.memory().Allocate(v_dump.size(), PAGE_READWRITE);
+		if (!v_mem || !NT_SUCCESS(v_mem->Write(0, v_dump.size(), v_dump.data())))
+		{
+			printf("failed to stage module fixture\n");
+			v_ok = false;
+		}
+		else
+			v_fixture = std::move(v_mem.result());
+	}
+
+	//Re-attach loop, the reconnect flow: a fresh Process object against
+	//the same live target, up to a resolved main module
+	v_ok = v_ok && Phase(L"reconnect", k_iterations, [&]() {
+		blackbone::Process v_again;
+		if (!NT_SUCCESS(v_again.Attach(v_target.dwProcessId)))
+			return false;
+		if (!v_again.modules().GetMainModule())
+			return false;
+		return NT_SUCCESS(v_again.Detach());
+	});
+
+	//Verification sweep: exact and wildcard scans over the staged module,
+	//the same remote scan shape the integrity checks run
+	v_ok = v_ok && Phase(L"verify-sweep", k_iterations, [&]() {
+		const size_t v_offest = v_dump.size() / 2;
+		std::vector<uint8_t> v_pattern(v_dump.begin() + v_offest, v_dump.begin() + v_offest + 16);
+
+		auto v_masked = v_pattern;
+		v_masked[4] = 0xCC;
+		v_masked[11] = 0xCC;
+
+		blackbone::vecScanResult v_out;
+		blackbone::PatternSearch v_exact(v_pattern);
+		if (v_exact.SearchRemote(v_proc, v_fixture.ptr(), v_dump.size(), v_out) == 0)
+			return false;
+
+		v_out.clear();
+		blackbone::PatternSearch v_wildcard(v_masked);
+		return v_wildcard.SearchRemote(v_proc, 0xCC, v_fixture.ptr(), v_dump.size(), v_out) != 0;
+	});
+
+	//Patch application: a coalesced batch of small writes spread across
+	//the module, flushed in one pass and spot-checked
+	v_ok = v_ok && Phase(L"patch-apply", k_iterations, [&]() {
+		constexpr size_t k_patches = 64;
+		const uint32_t v_marker = 0xDEADC0DE;
+
+		blackbone::WriteBatch v_batch(v_proc.memory());
+		const size_t v_stride = v_dump.size() / k_patches;
+		for (size_t i = 0; i < k_patches; ++i)
+			v_batch.Add(v_fixture.ptr() + i * v_stride, v_marker);
+
+		if (!NT_SUCCESS(v_batch.Flush()))
+			return false;
+
+		return v_fixture.Read<uint32_t>(0, 0) == v_marker;
+	});
+
+	v_fixture.Free();
+	v_proc.Detach();
+	TerminateProcess(v_target.hProcess, 0);
+	CloseHandle(v_target.hThread);
+	CloseHandle(v_target.hProcess);
+
+	if (!v_ok)
+		return 1;
+
+	//Compare against the stored baseline; a missing baseline (or --rebase)
+	//records the current run and passes
+	auto v_baseline = LoadBaseline();
+	bool v_regressed = false;
+
+	wprintf(L"%-24s %10s %10s %8s\n", L"phase", L"ms", L"baseline", L"delta");
+	for (const auto& v_phase : g_phases)
+	{
+		const auto v_it = v_baseline.find(v_phase._name_);
+		if (v_it == v_baseline.end())
+		{
+			wprintf(L"%-24s %10.2f %10s %8s\n", v_phase._name_.c_str(), v_phase._ms_, L"-", L"new");
+			continue;
+		}
+
+		const auto v_delta_pct = (v_phase._ms_ - v_it->second) * 100.0 / v_it->second;
+		const bool v_over = v_delta_pct > v_threshold_pct;
+		v_regressed = v_regressed || v_over;
+		wprintf(L"%-24s %10.2f %10.2f %+7.1f%%%s\n",
+			v_phase._name_.c_str(), v_phase._ms_, v_it->second, v_delta_pct, v_over ? L"  REGRESSED" : L"");
+	}
+
+	if (v_rebase || v_baseline.empty())
+	{
+		SaveBaseline();
+		wprintf(L"\nbaseline %s\n", v_baseline.empty() ? L"recorded" : L"rebased");
+		return 0;
+	}
+
+	if (v_regressed)
+	{
+		wprintf(L"\nFAIL: regression beyond %.1f%% threshold\n", v_threshold_pct);
+		return 1;
+	}
+
+	wprintf(L"\nPASS\n");
+	return 0;
+}
@@ -1,4 +1,6 @@
 #include <AntiCheatBypass.h>
+#include <utility/etw_trace.h>
+#include <utility/singleton.h>
 
 //tcjҪ������
 //NtSetInformationThread
@@ -7,6 +9,24 @@
 //NtOpenProcess
 //NtCreateThreadEx
 
+namespace
+{
+	//Info classes and status codes not in winternl.h
+	constexpr ULONG k_thread_hide_from_debugger = 0x11;
+	constexpr ULONG k_process_debug_port = 0x07;
+	constexpr ULONG k_process_debug_object_handle = 0x1E;
+	constexpr ULONG k_process_debug_flags = 0x1F;
+
+	constexpr NTSTATUS k_status_success = 0;
+	constexpr auto k_status_access_denied = static_cast<NTSTATUS>(0xC0000022);
+	constexpr auto k_status_port_not_set = static_cast<NTSTATUS>(0xC0000353);
+
+	//Hook ids in eHookCall events; the two hooks below are the only ones
+	//the game calls at a rate worth timelining
+	constexpr uint32_t k_etw_hook_set_information_thread = 1;
+	constexpr uint32_t k_etw_hook_query_information_process = 2;
+}
+
 AntiCheatBypass::AntiCheatBypass()
 {
 }
@@ -22,4 +42,126 @@ void AntiCheatBypass::EnableDebug()
 	//NtTerminateProcess Nt��ֹ���� ntdll.dll
 	//ZwTerminateProcess Zw��ֹ���� ntdll.dll
 	//SetUnhandledExceptionFilter UEF�ص���� Kernel32.dll
+	if (_debug_enabled_)
+		return;
+
+	const auto v_ntdll = GetModuleHandleW(L"ntdll.dll");
+	const auto v_kernel32 = GetModuleHandleW(L"kernel32.dll");
+	if (v_ntdll == nullptr || v_kernel32 == nullptr)
+		return;
+
+	_nt_set_information_thread_ = reinterpret_cast<nt_set_information_thread_t>(GetProcAddress(v_ntdll, "NtSetInformationThread"));
+	_nt_query_information_process_ = reinterpret_cast<nt_query_information_process_t>(GetProcAddress(v_ntdll, "NtQueryInformationProcess"));
+	//Zw and Nt share the export address in user mode, one patch covers both
+	_nt_terminate_process_ = reinterpret_cast<nt_terminate_process_t>(GetProcAddress(v_ntdll, "NtTerminateProcess"));
+	const auto v_dbg_ui_remote_breakin = reinterpret_cast<void(__stdcall*)()>(GetProcAddress(v_ntdll, "DbgUiRemoteBreakin"));
+	const auto v_set_uef = reinterpret_cast<LPTOP_LEVEL_EXCEPTION_FILTER(__stdcall*)(LPTOP_LEVEL_EXCEPTION_FILTER)>(GetProcAddress(v_kernel32, "SetUnhandledExceptionFilter"));
+
+	if (_nt_set_information_thread_ == nullptr || _nt_query_information_process_ == nullptr ||
+		_nt_terminate_process_ == nullptr || v_dbg_ui_remote_breakin == nullptr || v_set_uef == nullptr)
+		return;
+
+	//Prepare first: trampolines and patch bytes are built without touching
+	//a single target byte
+	bool v_prepared = true;
+	v_prepared &= _set_information_thread_hook_.HookPrepare(_nt_set_information_thread_, &AntiCheatBypass::OnNtSetInformationThread, this,
+		blackbone::CallOrder::NoOriginal, blackbone::ReturnMethod::UseNew);
+	v_prepared &= _query_information_process_hook_.HookPrepare(_nt_query_information_process_, &AntiCheatBypass::OnNtQueryInformationProcess, this,
+		blackbone::CallOrder::NoOriginal, blackbone::ReturnMethod::UseNew);
+	v_prepared &= _terminate_process_hook_.HookPrepare(_nt_terminate_process_, &AntiCheatBypass::OnNtTerminateProcess, this,
+		blackbone::CallOrder::NoOriginal, blackbone::ReturnMethod::UseNew);
+	v_prepared &= _dbg_ui_remote_breakin_hook_.HookPrepare(v_dbg_ui_remote_breakin, &AntiCheatBypass::OnDbgUiRemoteBreakin, this,
+		blackbone::CallOrder::NoOriginal, blackbone::ReturnMethod::UseNew);
+	v_prepared &= _set_unhandled_exception_filter_hook_.HookPrepare(v_set_uef, &AntiCheatBypass::OnSetUnhandledExceptionFilter, this,
+		blackbone::CallOrder::NoOriginal, blackbone::ReturnMethod::UseNew);
+
+	if (!v_prepared)
+		return;
+
+	//Then one transaction: a single suspend/protect cycle patches every
+	//site together, instead of five serialized install windows
+	blackbone::HookTransaction v_transaction;
+	v_transaction.Queue(_set_information_thread_hook_);
+	v_transaction.Queue(_query_information_process_hook_);
+	v_transaction.Queue(_terminate_process_hook_);
+	v_transaction.Queue(_dbg_ui_remote_breakin_hook_);
+	v_transaction.Queue(_set_unhandled_exception_filter_hook_);
+
+	_debug_enabled_ = v_transaction.Commit();
+}
+
+NTSTATUS AntiCheatBypass::OnNtSetInformationThread(HANDLE& thread, ULONG& info_class, PVOID& info, ULONG& length)
+{
+	const base::etw_trace::hook_scope v_trace(k_etw_hook_set_information_thread);
+
+	//ThreadHideFromDebugger reports success without taking effect
+	if (info_class == k_thread_hide_from_debugger && info == nullptr && length == 0)
+		return k_status_success;
+
+	return _nt_set_information_thread_(thread, info_class, info, length);
+}
+
+NTSTATUS AntiCheatBypass::OnNtQueryInformationProcess(HANDLE& process, ULONG& info_class, PVOID& info, ULONG& length, PULONG& return_length)
+{
+	const base::etw_trace::hook_scope v_trace(k_etw_hook_query_information_process);
+
+	const auto v_status = _nt_query_information_process_(process, info_class, info, length, return_length);
+	if (v_status < 0 || info == nullptr)
+		return v_status;
+
+	//Only queries about ourselves are scrubbed
+	if (GetProcessId(process) != GetCurrentProcessId())
+		return v_status;
+
+	switch (info_class)
+	{
+	case k_process_debug_port:
+		if (length >= sizeof(HANDLE))
+			*static_cast<HANDLE*>(info) = nullptr;
+		break;
+
+	case k_process_debug_object_handle:
+		if (length >= sizeof(HANDLE))
+			*static_cast<HANDLE*>(info) = nullptr;
+		return k_status_port_not_set;
+
+	case k_process_debug_flags:
+		//PROCESS_DEBUG_INHERIT reads back as not being debugged
+		if (length >= sizeof(ULONG))
+			*static_cast<ULONG*>(info) = 1;
+		break;
+
+	default:
+		break;
+	}
+
+	return v_status;
+}
+
+NTSTATUS AntiCheatBypass::OnNtTerminateProcess(HANDLE& process, NTSTATUS& exit_status)
+{
+	//Terminating anything but ourselves is refused
+	if (process != nullptr && GetProcessId(process) != GetCurrentProcessId())
+		return k_status_access_denied;
+
+	return _nt_terminate_process_(process, exit_status);
+}
+
+void AntiCheatBypass::OnDbgUiRemoteBreakin()
+{
+	//A remote break-in thread lands here; returning lets it exit cleanly
+}
+
+LPTOP_LEVEL_EXCEPTION_FILTER AntiCheatBypass::OnSetUnhandledExceptionFilter(LPTOP_LEVEL_EXCEPTION_FILTER& filter)
+{
+	//Swallow the install, answering with the previous filter like the
+	//real call would
+	const auto v_previous = _uef_filter_;
+	_uef_filter_ = filter;
+	return v_previous;
+}
+
+AntiCheatBypass& get_anti_cheat_bypass()
+{
+	return base::singleton_atomic<AntiCheatBypass>::instance();
 }
@@ -1,11 +1,44 @@
 #pragma once
 #include "framework.h"
 
+#include <BlackBone/LocalHook/LocalHook.hpp>
+#include <BlackBone/LocalHook/HookTransaction.h>
+
 class AntiCheatBypass
 {
 public:
 	AntiCheatBypass();
 	~AntiCheatBypass();
 	void EnableDebug();
+
+private:
+	using nt_set_information_thread_t = NTSTATUS(__stdcall*)(HANDLE, ULONG, PVOID, ULONG);
+	using nt_query_information_process_t = NTSTATUS(__stdcall*)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+	using nt_terminate_process_t = NTSTATUS(__stdcall*)(HANDLE, NTSTATUS);
+
+	//Hook bodies; each runs with its own hook disabled, so the saved raw
+	//pointers below reach the original code
+	NTSTATUS OnNtSetInformationThread(HANDLE& thread, ULONG& info_class, PVOID& info, ULONG& length);
+	NTSTATUS OnNtQueryInformationProcess(HANDLE& process, ULONG& info_class, PVOID& info, ULONG& length, PULONG& return_length);
+	NTSTATUS OnNtTerminateProcess(HANDLE& process, NTSTATUS& exit_status);
+	void OnDbgUiRemoteBreakin();
+	LPTOP_LEVEL_EXCEPTION_FILTER OnSetUnhandledExceptionFilter(LPTOP_LEVEL_EXCEPTION_FILTER& filter);
+
+private:
+	bool _debug_enabled_{};
+	//Last filter the game tried to install through the intercepted
+	//SetUnhandledExceptionFilter
+	LPTOP_LEVEL_EXCEPTION_FILTER _uef_filter_{};
+
+	nt_set_information_thread_t _nt_set_information_thread_{};
+	nt_query_information_process_t _nt_query_information_process_{};
+	nt_terminate_process_t _nt_terminate_process_{};
+
+	blackbone::Detour<NTSTATUS(__stdcall*)(HANDLE, ULONG, PVOID, ULONG), AntiCheatBypass> _set_information_thread_hook_;
+	blackbone::Detour<NTSTATUS(__stdcall*)(HANDLE, ULONG, PVOID, ULONG, PULONG), AntiCheatBypass> _query_information_process_hook_;
+	blackbone::Detour<NTSTATUS(__stdcall*)(HANDLE, NTSTATUS), AntiCheatBypass> _terminate_process_hook_;
+	blackbone::Detour<void(__stdcall*)(), AntiCheatBypass> _dbg_ui_remote_breakin_hook_;
+	blackbone::Detour<LPTOP_LEVEL_EXCEPTION_FILTER(__stdcall*)(LPTOP_LEVEL_EXCEPTION_FILTER), AntiCheatBypass> _set_unhandled_exception_filter_hook_;
 };
 
+AntiCheatBypass& get_anti_cheat_bypass();
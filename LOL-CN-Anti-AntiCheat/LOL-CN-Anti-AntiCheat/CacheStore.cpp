@@ -0,0 +1,270 @@
+#include <CacheStore.h>
+#include <utility/memory_prefetch.h>
+#include <utility/singleton.h>
+#include <bee/utility/path_helper.h>
+
+namespace
+{
+	constexpr uint32_t k_magic = 'SCCL';	//"LCCS"
+	constexpr uint32_t k_version = 1;
+
+	//power of two, probed linearly; write-once entries mean duplicates
+	//for replaced keys, so the table is sized well above the live set
+	constexpr uint32_t k_bucket_count = 4096;
+	constexpr size_t k_payload_capacity = 4 * 1024 * 1024;
+
+	//fnv1a-64
+	constexpr uint64_t k_fnv_offset = 14695981039346656037ull;
+	constexpr uint64_t k_fnv_prime = 1099511628211ull;
+}
+
+struct CacheStore::store_header
+{
+	uint32_t _magic_;
+	uint32_t _version_;
+	uint32_t _bucket_count_;
+	uint32_t _payload_offset_;
+	//next free payload byte, relative to _payload_offset_; only moves
+	//under the writer mutex
+	volatile LONGLONG _payload_used_;
+};
+
+struct CacheStore::store_entry
+{
+	//0 = empty; written last with a full-barrier exchange, so a reader
+	//that sees the key sees every other field of the entry
+	volatile LONGLONG _key_hash_;
+	uint64_t _stamp_;
+	uint32_t _offset_;	//payload-relative
+	uint32_t _size_;
+};
+
+namespace
+{
+	constexpr size_t k_table_offset = sizeof(CacheStore::store_header);
+	constexpr size_t k_payload_offset = k_table_offset + k_bucket_count * sizeof(CacheStore::store_entry);
+	constexpr size_t k_store_size = k_payload_offset + k_payload_capacity;
+}
+
+CacheStore::CacheStore()
+	: _file_(INVALID_HANDLE_VALUE)
+	, _mapping_(nullptr)
+	, _write_lock_(nullptr)
+	, _view_(nullptr)
+{
+	Open();
+}
+
+
+CacheStore::~CacheStore()
+{
+	if (_view_ != nullptr)
+		UnmapViewOfFile(_view_);
+	if (_mapping_ != nullptr)
+		CloseHandle(_mapping_);
+	if (_file_ != INVALID_HANDLE_VALUE)
+		CloseHandle(_file_);
+	if (_write_lock_ != nullptr)
+		CloseHandle(_write_lock_);
+}
+
+void CacheStore::Open()
+{
+	_write_lock_ = CreateMutexW(nullptr, FALSE, L"Local\\LOL_CN_CacheStore_Lock");
+	if (_write_lock_ == nullptr)
+		return;
+
+	_file_ = CreateFileW(GetStorePath().c_str(), GENERIC_READ | GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (_file_ == INVALID_HANDLE_VALUE)
+		return;
+
+	//the mapping extends a fresh file to the full fixed size; sparse-ish
+	//on NTFS until the payload region is actually written
+	_mapping_ = CreateFileMappingW(_file_, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(k_store_size >> 32), static_cast<DWORD>(k_store_size & 0xFFFFFFFF), nullptr);
+	if (_mapping_ == nullptr)
+		return;
+
+	_view_ = static_cast<uint8_t*>(MapViewOfFile(_mapping_, FILE_MAP_ALL_ACCESS, 0, 0, k_store_size));
+	if (_view_ == nullptr)
+		return;
+
+	//initialize or re-initialize the header under the writer mutex; an
+	//unrecognized layout (older build, corruption) is wiped rather than
+	//interpreted
+	const auto v_header = reinterpret_cast<store_header*>(_view_);
+	if (v_header->_magic_ != k_magic || v_header->_version_ != k_version
+		|| v_header->_bucket_count_ != k_bucket_count || v_header->_payload_offset_ != k_payload_offset)
+	{
+		if (WaitForSingleObject(_write_lock_, 5000) != WAIT_OBJECT_0)
+		{
+			UnmapViewOfFile(_view_);
+			_view_ = nullptr;
+			return;
+		}
+
+		if (v_header->_magic_ != k_magic || v_header->_version_ != k_version
+			|| v_header->_bucket_count_ != k_bucket_count || v_header->_payload_offset_ != k_payload_offset)
+		{
+			memset(_view_, 0, k_payload_offset);
+			v_header->_version_ = k_version;
+			v_header->_bucket_count_ = k_bucket_count;
+			v_header->_payload_offset_ = k_payload_offset;
+			v_header->_payload_used_ = 0;
+			InterlockedExchange(reinterpret_cast<volatile long*>(&v_header->_magic_), static_cast<long>(k_magic));
+		}
+		ReleaseMutex(_write_lock_);
+	}
+}
+
+bool CacheStore::Lookup(const wchar_t* ns, const std::wstring& key, const uint64_t stamp, std::vector<uint8_t>& out)
+{
+	if (_view_ == nullptr)
+		return false;
+
+	const auto v_entries = reinterpret_cast<store_entry*>(_view_ + k_table_offset);
+	const auto v_payload = _view_ + k_payload_offset;
+	const auto v_hash = static_cast<LONGLONG>(MakeKeyHash(ns, key));
+
+	//probe to the first empty bucket and keep the newest match: entries
+	//are write-once, so a replaced key simply has a later duplicate
+	const store_entry* v_found = nullptr;
+	for (uint32_t i = 0; i < k_bucket_count; ++i)
+	{
+		const auto& v_entry = v_entries[(static_cast<uint64_t>(v_hash) + i) & (k_bucket_count - 1)];
+		const auto v_key = v_entry._key_hash_;
+		if (v_key == 0)
+			break;
+		if (v_key == v_hash)
+			v_found = &v_entry;
+	}
+
+	if (v_found == nullptr || v_found->_stamp_ != stamp)
+		return false;
+	if (v_found->_offset_ > k_payload_capacity || v_found->_size_ > k_payload_capacity - v_found->_offset_)
+		return false;
+
+	out.assign(v_payload + v_found->_offset_, v_payload + v_found->_offset_ + v_found->_size_);
+	return true;
+}
+
+bool CacheStore::Store(const wchar_t* ns, const std::wstring& key, const uint64_t stamp, const void* data, const size_t size)
+{
+	if (_view_ == nullptr || size > k_payload_capacity)
+		return false;
+
+	const auto v_header = reinterpret_cast<store_header*>(_view_);
+	const auto v_entries = reinterpret_cast<store_entry*>(_view_ + k_table_offset);
+	const auto v_payload = _view_ + k_payload_offset;
+	const auto v_hash = static_cast<LONGLONG>(MakeKeyHash(ns, key));
+
+	if (WaitForSingleObject(_write_lock_, 5000) != WAIT_OBJECT_0)
+		return false;
+
+	//find the bucket after the newest match; skip the write entirely if
+	//that match already holds this exact record
+	store_entry* v_slot = nullptr;
+	const store_entry* v_newest = nullptr;
+	for (uint32_t i = 0; i < k_bucket_count; ++i)
+	{
+		auto& v_entry = v_entries[(static_cast<uint64_t>(v_hash) + i) & (k_bucket_count - 1)];
+		if (v_entry._key_hash_ == 0)
+		{
+			v_slot = &v_entry;
+			break;
+		}
+		if (v_entry._key_hash_ == v_hash)
+			v_newest = &v_entry;
+	}
+
+	if (v_newest != nullptr && v_newest->_stamp_ == stamp && v_newest->_size_ == size
+		&& memcmp(v_payload + v_newest->_offset_, data, size) == 0)
+	{
+		ReleaseMutex(_write_lock_);
+		return true;
+	}
+
+	const auto v_used = v_header->_payload_used_;
+	if (v_slot == nullptr || static_cast<size_t>(v_used) + size > k_payload_capacity)
+	{
+		//table or payload full: the store degrades to a no-op, callers
+		//fall back to recomputing
+		ReleaseMutex(_write_lock_);
+		return false;
+	}
+
+	//payload first, key last: a crash before the exchange leaves the
+	//bytes unreachable and the store consistent
+	memcpy(v_payload + v_used, data, size);
+	v_header->_payload_used_ = v_used + static_cast<LONGLONG>(size);
+	v_slot->_stamp_ = stamp;
+	v_slot->_offset_ = static_cast<uint32_t>(v_used);
+	v_slot->_size_ = static_cast<uint32_t>(size);
+	InterlockedExchange64(&v_slot->_key_hash_, v_hash);
+
+	ReleaseMutex(_write_lock_);
+	return true;
+}
+
+void CacheStore::Prefetch() const
+{
+	if (_view_ == nullptr)
+		return;
+
+	const auto v_header = reinterpret_cast<const store_header*>(_view_);
+	const auto v_end = k_payload_offset + static_cast<size_t>(v_header->_payload_used_);
+
+	//one batched fault instead of a touch per page; the loop remains as
+	//the pre-Win8 fallback
+	if (base::prefetch_range(GetCurrentProcess(), _view_, v_end))
+		return;
+
+	volatile uint8_t v_sink = 0;
+	for (size_t v_offset = 0; v_offset < v_end; v_offset += 0x1000)
+		v_sink += _view_[v_offset];
+	(void)v_sink;
+}
+
+auto CacheStore::Hash(const void* data, const size_t size) -> uint64_t
+{
+	auto v_hash = k_fnv_offset;
+	const auto v_bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i)
+	{
+		v_hash ^= v_bytes[i];
+		v_hash *= k_fnv_prime;
+	}
+	return v_hash;
+}
+
+auto CacheStore::GetStorePath() const -> fs::path
+{
+	const auto& v_dll_dir = bee::path_helper::dll_directory();
+	if (!v_dll_dir.empty())
+		return v_dll_dir / L"cache_store.dat";
+
+	return fs::path(L"cache_store.dat");
+}
+
+auto CacheStore::MakeKeyHash(const wchar_t* ns, const std::wstring& key) -> uint64_t
+{
+	//namespace, separator, key - hashed as raw bytes; 0 is reserved for
+	//an empty bucket
+	auto v_hash = Hash(ns, wcslen(ns) * sizeof(wchar_t));
+	v_hash ^= '|';
+	v_hash *= k_fnv_prime;
+
+	const auto v_bytes = reinterpret_cast<const uint8_t*>(key.data());
+	for (size_t i = 0; i < key.size() * sizeof(wchar_t); ++i)
+	{
+		v_hash ^= v_bytes[i];
+		v_hash *= k_fnv_prime;
+	}
+	return v_hash != 0 ? v_hash : 1;
+}
+
+CacheStore& get_cache_store()
+{
+	return base::singleton_atomic<CacheStore>::instance();
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "framework.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Unified persistent cache store
+//one memory-mapped file holding every disk cache as a namespace: an
+//open-addressed hash table of fixed-size entries over an append-only
+//payload region, so a cold attach does a single map instead of one file
+//open per cache. entries are write-once and their key is published
+//last, which makes lookups lock-free and safe across processes - a
+//crash mid-write leaves only unreachable payload bytes, never a torn
+//record. writers serialize on a named mutex; a replaced key gets a
+//fresh entry and readers take the newest match. every entry carries a
+//caller stamp (module version hash, timestamp) checked on lookup, so
+//stale records age out by failing validation instead of by file juggling
+class CacheStore
+{
+public:
+	CacheStore();
+	~CacheStore();
+
+	//Copy the newest payload stored under ns/key, if present and
+	//stamped as expected
+	bool Lookup(const wchar_t* ns, const std::wstring& key, uint64_t stamp, std::vector<uint8_t>& out);
+
+	//Append the payload and publish it under ns/key; an existing entry
+	//for the key stays in the file but stops being the newest match
+	bool Store(const wchar_t* ns, const std::wstring& key, uint64_t stamp, const void* data, size_t size);
+
+	//Touch the mapping sequentially so first lookups do not page-fault
+	//one page at a time
+	void Prefetch() const;
+
+	//fnv1a-64 over raw bytes, exposed so callers can build stamps the
+	//same way the store builds keys
+	[[nodiscard]] static auto Hash(const void* data, size_t size) -> uint64_t;
+
+private:
+	struct store_header;
+	struct store_entry;
+
+	void Open();
+	[[nodiscard]] auto GetStorePath() const -> fs::path;
+	[[nodiscard]] static auto MakeKeyHash(const wchar_t* ns, const std::wstring& key) -> uint64_t;
+
+private:
+	HANDLE _file_;
+	HANDLE _mapping_;
+	//serializes writers across processes, readers never take it
+	HANDLE _write_lock_;
+	uint8_t* _view_;
+};
+
+CacheStore& get_cache_store();
@@ -0,0 +1,133 @@
+#include <KernelSelect.h>
+#include <CacheStore.h>
+#include <utility/singleton.h>
+
+#include <intrin.h>
+
+namespace
+{
+	//namespace in the unified cache store
+	const wchar_t* const k_store_ns = L"kernel";
+
+	//timed passes per candidate after the warm-up
+	constexpr int k_timed_passes = 3;
+
+	//Brand string straight from CPUID, the part of the key that actually
+	//identifies the silicon
+	auto cpu_brand() -> std::string
+	{
+		int v_regs[4] = { 0 };
+		__cpuid(v_regs, static_cast<int>(0x80000000));
+		if (static_cast<unsigned>(v_regs[0]) < 0x80000004)
+			return "unknown";
+
+		char v_brand[49] = { 0 };
+		for (int v_leaf = 0; v_leaf < 3; ++v_leaf)
+		{
+			__cpuid(v_regs, static_cast<int>(0x80000002) + v_leaf);
+			memcpy(v_brand + v_leaf * 16, v_regs, 16);
+		}
+		return v_brand;
+	}
+}
+
+KernelSelect::KernelSelect()
+{
+	//brand alone is not enough: the same part in a throttled dual-core
+	//laptop and a desktop can prefer different kernels, so the logical
+	//core count joins the identity
+	SYSTEM_INFO v_info = { };
+	GetSystemInfo(&v_info);
+
+	const auto v_brand = cpu_brand();
+	_cpu_identity_.assign(v_brand.begin(), v_brand.end());
+	_cpu_identity_ += L"/" + std::to_wstring(v_info.dwNumberOfProcessors);
+}
+
+
+KernelSelect::~KernelSelect()
+= default;
+
+size_t KernelSelect::Choose(const std::wstring& family, const std::vector<Variant>& variants)
+{
+	if (variants.size() < 2)
+		return 0;
+
+	std::lock_guard<std::mutex> v_guard(_lock_);
+
+	const auto v_memo = _chosen_.find(family);
+	if (v_memo != _chosen_.end())
+		return v_memo->second;
+
+	//the stamp covers the variant names, so adding, dropping or renaming
+	//a candidate invalidates the persisted winner
+	std::string v_names;
+	for (const auto& v_variant : variants)
+		v_names += v_variant._name_, v_names += '|';
+	const auto v_stamp = CacheStore::Hash(v_names.data(), v_names.size());
+
+	const auto v_key = MakeKey(family);
+
+	std::vector<uint8_t> v_payload;
+	if (get_cache_store().Lookup(k_store_ns, v_key, v_stamp, v_payload)
+		&& v_payload.size() == sizeof(uint32_t))
+	{
+		const auto v_stored = *reinterpret_cast<const uint32_t*>(v_payload.data());
+		if (v_stored < variants.size())
+		{
+			_chosen_[family] = v_stored;
+			return v_stored;
+		}
+	}
+
+	//First contact on this machine: race the candidates
+	size_t v_winner = 0;
+	auto v_best = TimeOne(variants[0]._run_);
+	for (size_t v_index = 1; v_index < variants.size(); ++v_index)
+	{
+		const auto v_time = TimeOne(variants[v_index]._run_);
+		if (v_time < v_best)
+		{
+			v_best = v_time;
+			v_winner = v_index;
+		}
+	}
+
+	const auto v_stored = static_cast<uint32_t>(v_winner);
+	get_cache_store().Store(k_store_ns, v_key, v_stamp, &v_stored, sizeof(v_stored));
+
+	_chosen_[family] = v_winner;
+	return v_winner;
+}
+
+auto KernelSelect::MakeKey(const std::wstring& family) const -> std::wstring
+{
+	return family + L"|" + _cpu_identity_;
+}
+
+uint64_t KernelSelect::TimeOne(const std::function<void()>& run)
+{
+	//warm-up pass pulls code and workload data into cache so the timed
+	//passes compare kernels, not first-touch faults
+	run();
+
+	auto v_best = MAXLONGLONG;
+	for (int v_pass = 0; v_pass < k_timed_passes; ++v_pass)
+	{
+		LARGE_INTEGER v_begin = { }, v_end = { };
+		QueryPerformanceCounter(&v_begin);
+		run();
+		QueryPerformanceCounter(&v_end);
+
+		const auto v_ticks = v_end.QuadPart - v_begin.QuadPart;
+		if (v_ticks < v_best)
+			v_best = v_ticks;
+	}
+
+	return static_cast<uint64_t>(v_best);
+}
+
+KernelSelect& get_kernel_select()
+{
+	return base::singleton_atomic<KernelSelect>::instance();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "framework.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Self-measuring A/B kernel selection
+//a kernel family registers its variants and asks once which one to run:
+//on first contact the candidates are timed on a small representative
+//workload and the winner is persisted in the unified cache store keyed
+//by CPU identity, so every seat converges on its own fastest
+//implementation and later launches skip the measurement entirely. The
+//stamp is a hash of the variant names, so shipping a new or renamed
+//variant re-runs the measurement
+class KernelSelect
+{
+public:
+	struct Variant
+	{
+		const char* _name_;
+		//candidate, run over the family's representative workload
+		std::function<void()> _run_;
+	};
+
+	KernelSelect();
+	~KernelSelect();
+
+	//Index of the fastest variant on this machine; measured at most once
+	//per process, memoized in-process and persisted across launches
+	size_t Choose(const std::wstring& family, const std::vector<Variant>& variants);
+
+private:
+	[[nodiscard]] auto MakeKey(const std::wstring& family) const -> std::wstring;
+
+	//Best-of-three wall time after one warm-up pass
+	static uint64_t TimeOne(const std::function<void()>& run);
+
+private:
+	std::mutex _lock_;
+	//brand string + logical core count, the persistence key component
+	std::wstring _cpu_identity_;
+	std::unordered_map<std::wstring, size_t> _chosen_;
+};
+
+KernelSelect& get_kernel_select();
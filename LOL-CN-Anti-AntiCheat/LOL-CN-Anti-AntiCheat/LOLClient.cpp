@@ -1,10 +1,53 @@
 #include <LOLClient.h>
+#include <ModuleBaseCache.h>
 #include <utility/singleton.h>
 #include <bee/utility/file_helper.h>
 #include "bee/utility/path_helper.h"
 
 using encoder = encstr::cbc_t<encstr::ciphers::xor_cipher_t>;
 
+namespace
+{
+	//Loader notification plumbing; the structures are not in the SDK
+	//headers, layout documented for LdrRegisterDllNotification
+	typedef struct _UNICODE_STRING_
+	{
+		USHORT Length;
+		USHORT MaximumLength;
+		PWSTR Buffer;
+	} UNICODE_STRING_;
+
+	typedef struct _LDR_DLL_NOTIFICATION_DATA_
+	{
+		ULONG Flags;
+		const UNICODE_STRING_* FullDllName;
+		const UNICODE_STRING_* BaseDllName;
+		PVOID DllBase;
+		ULONG SizeOfImage;
+	} LDR_DLL_NOTIFICATION_DATA_;
+
+	constexpr ULONG k_ldr_notification_loaded = 1;
+	constexpr ULONG k_ldr_notification_unloaded = 2;
+
+	typedef VOID(CALLBACK* ldr_notification_callback_t)(ULONG reason, const LDR_DLL_NOTIFICATION_DATA_* data, PVOID context);
+	typedef LONG(NTAPI* LdrRegisterDllNotification_t)(ULONG flags, ldr_notification_callback_t callback, PVOID context, PVOID* cookie);
+	typedef LONG(NTAPI* LdrUnregisterDllNotification_t)(PVOID cookie);
+
+	//Runs under the loader lock: the handler only compares names and
+	//flips an atomic, nothing that loads or waits
+	VOID CALLBACK module_notify_thunk(ULONG reason, const LDR_DLL_NOTIFICATION_DATA_* data, PVOID context)
+	{
+		if (data == nullptr || data->BaseDllName == nullptr || data->BaseDllName->Buffer == nullptr)
+			return;
+
+		const std::wstring_view v_base_name(data->BaseDllName->Buffer, data->BaseDllName->Length / sizeof(WCHAR));
+		static_cast<LOLClient*>(context)->OnModuleNotify(
+			reason == k_ldr_notification_loaded,
+			v_base_name,
+			reinterpret_cast<uintptr_t>(data->DllBase));
+	}
+}
+
 LOLClient::LOLClient()
 	: _game_lobby_name_(ENCRYPT_STRING_AUTO_W(encoder, L"LeagueClient.exe"))
 	, _game_main_name_(ENCRYPT_STRING_AUTO_W(encoder, L"League of Legends.exe"))
@@ -31,64 +74,69 @@ LOLClient::LOLClient()
 	, _game_main_full_path_(L"")
 {
 	SetGameFullPath();
+	StartModuleWatch();
+	PublishSnapshot();
 }
 
 
 LOLClient::~LOLClient()
-= default;
+{
+	StopModuleWatch();
+}
 
 auto LOLClient::GetGameMainPid() const -> uintptr_t
 {
 	return _game_main_pid_;
 }
 
-auto LOLClient::GetGameMainFullPath() -> fs::path
+auto LOLClient::GetGameMainFullPath() const -> const fs::path&
 {
-
-	return std::move(_game_main_full_path_);
+	//Used to move out of the member, which left the second caller with an
+	//empty path; hand out a reference to the cached value instead
+	return _game_main_full_path_;
 }
 
-auto LOLClient::GetGameLobbyName() const -> std::wstring
+auto LOLClient::GetGameLobbyName() const noexcept -> std::wstring_view
 {
 	return _game_lobby_name_;
 }
 
-auto LOLClient::GetGameMainName() const -> std::wstring
+auto LOLClient::GetGameMainName() const noexcept -> std::wstring_view
 {
 	return _game_main_name_;
 }
 
-auto LOLClient::GetLOLBaseName() const -> std::wstring
+auto LOLClient::GetLOLBaseName() const noexcept -> std::wstring_view
 {
 	return _lol_base_name_;
 }
 
-auto LOLClient::GetTerSafeName() const -> std::wstring
+auto LOLClient::GetTerSafeName() const noexcept -> std::wstring_view
 {
 	return _ter_safe_name_;
 }
 
-auto LOLClient::GetTenRpcsName() const -> std::wstring
+auto LOLClient::GetTenRpcsName() const noexcept -> std::wstring_view
 {
 	return _ten_rpcs_name_;
 }
 
-auto LOLClient::GetTenSlxName() const -> std::wstring
+auto LOLClient::GetTenSlxName() const noexcept -> std::wstring_view
 {
 	return _ten_slx_name_;
 }
 
-auto LOLClient::GetTCJName() const -> std::wstring
+auto LOLClient::GetTCJName() const noexcept -> std::wstring_view
 {
 	return _tcj_name_;
 }
 
-auto LOLClient::GetGameRpcsName() const -> std::wstring
+auto LOLClient::GetGameRpcsName() const noexcept -> std::wstring_view
 {
 	return _game_rpcs_name_;
 }
 
-auto LOLClient::GetPolicyProbeName() const -> std::wstring
+auto LOLClient::GetPolicyProbeName() const noexcept -> std::wstring_view
 {
 	return _policy_probe_name_;
 }
@@ -144,6 +192,117 @@ auto LOLClient::GetPolicyProbeBase() const -> uintptr_t
 	return _policy_probe_handle_;
 }
 
+auto LOLClient::GetSnapshot() const -> ClientSnapshot
+{
+	return _snapshot_.read();
+}
+
+void LOLClient::PublishSnapshot()
+{
+	//Writers are serialized: the constructor runs before the notification
+	//is registered, and loader notifications run under the loader lock
+	ClientSnapshot v_snapshot{};
+	v_snapshot.game_main_pid = _game_main_pid_;
+	v_snapshot.game_main_base = _game_main_handle_.load(std::memory_order_relaxed);
+	v_snapshot.lol_base_base = _lol_base_handle_.load(std::memory_order_relaxed);
+	v_snapshot.ter_safe_base = _ter_safe_handle_.load(std::memory_order_relaxed);
+	v_snapshot.ten_rpcs_base = _ten_rpcs_handle_.load(std::memory_order_relaxed);
+	v_snapshot.ten_slx_base = _ten_slx_handle_.load(std::memory_order_relaxed);
+	v_snapshot.tcj_base = _tcj_handle_.load(std::memory_order_relaxed);
+	v_snapshot.game_rpcs_base = _game_rpcs_handle_.load(std::memory_order_relaxed);
+	v_snapshot.policy_probe_base = _policy_probe_handle_.load(std::memory_order_relaxed);
+	_snapshot_.write(v_snapshot);
+}
+
+void LOLClient::StartModuleWatch()
+{
+	//The constructor already snapshotted whatever is resident; the
+	//notification keeps the table fresh for everything that loads later
+	_watch_table_ = {
+		{ &_game_main_name_, &_game_main_handle_ },
+		{ &_lol_base_name_, &_lol_base_handle_ },
+		{ &_ter_safe_name_, &_ter_safe_handle_ },
+		{ &_ten_rpcs_name_, &_ten_rpcs_handle_ },
+		{ &_ten_slx_name_, &_ten_slx_handle_ },
+		{ &_tcj_name_, &_tcj_handle_ },
+		{ &_game_rpcs_name_, &_game_rpcs_handle_ },
+		{ &_policy_probe_name_, &_policy_probe_handle_ },
+	};
+
+	const auto v_register = reinterpret_cast<LdrRegisterDllNotification_t>(
+		GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "LdrRegisterDllNotification"));
+	if (v_register != nullptr)
+	{
+		v_register(0, module_notify_thunk, this, &_ldr_cookie_);
+	}
+}
+
+void LOLClient::StopModuleWatch()
+{
+	if (_ldr_cookie_ != nullptr)
+	{
+		const auto v_unregister = reinterpret_cast<LdrUnregisterDllNotification_t>(
+			GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "LdrUnregisterDllNotification"));
+		if (v_unregister != nullptr)
+		{
+			v_unregister(_ldr_cookie_);
+		}
+		_ldr_cookie_ = nullptr;
+	}
+}
+
+void LOLClient::OnModuleNotify(const bool loaded, const std::wstring_view base_name, const uintptr_t base)
+{
+	//Keep the process-wide cache consistent for every module, watched or
+	//not, and bump its epoch so derived-address caches revalidate
+	get_module_base_cache().OnModuleEvent(loaded, base_name, base);
+
+	for (const auto& [v_name, v_handle] : _watch_table_)
+	{
+		if (v_name->size() != base_name.size())
+			continue;
+		if (_wcsnicmp(v_name->c_str(), base_name.data(), base_name.size()) != 0)
+			continue;
+
+		v_handle->store(loaded ? base : 0, std::memory_order_release);
+		PublishSnapshot();
+
+		if (loaded)
+		{
+			//Publish under the lock so a waiter cannot check-then-sleep
+			//past the notification
+			std::lock_guard<std::mutex> v_guard(_module_wait_lock_);
+			_module_wait_cv_.notify_all();
+		}
+		break;
+	}
+}
+
+auto LOLClient::WaitForModuleBase(const std::wstring& module_name, const unsigned timeout_ms) -> uintptr_t
+{
+	std::atomic<uintptr_t>* v_handle = nullptr;
+	for (const auto& [v_name, v_entry] : _watch_table_)
+	{
+		if (_wcsicmp(v_name->c_str(), module_name.c_str()) == 0)
+		{
+			v_handle = v_entry;
+			break;
+		}
+	}
+	if (v_handle == nullptr)
+		return 0;
+
+	//Fast path: already resident
+	auto v_base = v_handle->load(std::memory_order_acquire);
+	if (v_base != 0)
+		return v_base;
+
+	std::unique_lock<std::mutex> v_guard(_module_wait_lock_);
+	_module_wait_cv_.wait_for(v_guard, std::chrono::milliseconds(timeout_ms),
+		[&]() { return v_handle->load(std::memory_order_acquire) != 0; });
+	return v_handle->load(std::memory_order_acquire);
+}
+
 void LOLClient::SetGameFullPath()
 {
 	//��������д��
@@ -153,5 +312,5 @@ void LOLClient::SetGameFullPath()
 
 LOLClient& get_lol_client()
 {
-	return base::singleton_nonthreadsafe<LOLClient>::instance();
+	return base::singleton_atomic<LOLClient>::instance();
 }
@@ -1,5 +1,27 @@
 #pragma once
 #include "framework.h"
+#include <utility/seqlock.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+//Coherent multi-field view of the client state, filled through a seqlock
+//so hook paths can read all bases at once without per-field atomics
+struct ClientSnapshot
+{
+	uintptr_t game_main_pid;
+	uintptr_t game_main_base;
+	uintptr_t lol_base_base;
+	uintptr_t ter_safe_base;
+	uintptr_t ten_rpcs_base;
+	uintptr_t ten_slx_base;
+	uintptr_t tcj_base;
+	uintptr_t game_rpcs_base;
+	uintptr_t policy_probe_base;
+};
+
 class LOLClient
 {
 public:
@@ -8,17 +30,19 @@ public:
 
 	//������Ϣ
 	uintptr_t GetGameMainPid() const;
-	fs::path GetGameMainFullPath();
+	[[nodiscard]] auto GetGameMainFullPath() const -> const fs::path&;
 	//����
-	[[nodiscard]] auto GetGameLobbyName() const -> std::wstring;
-	[[nodiscard]] auto GetGameMainName() const -> std::wstring;
-	[[nodiscard]] auto GetLOLBaseName() const -> std::wstring;
-	[[nodiscard]] auto GetTerSafeName() const -> std::wstring;
-	[[nodiscard]] auto GetTenRpcsName() const -> std::wstring;
-	[[nodiscard]] auto GetTenSlxName() const -> std::wstring;
-	[[nodiscard]] auto GetTCJName() const -> std::wstring;
-	[[nodiscard]] auto GetGameRpcsName() const -> std::wstring;
-	[[nodiscard]] auto GetPolicyProbeName() const -> std::wstring;
+	//Views into immutable members: valid for the client's lifetime, no
+	//copy per call (these run from hooks)
+	[[nodiscard]] auto GetGameLobbyName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetGameMainName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetLOLBaseName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetTerSafeName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetTenRpcsName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetTenSlxName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetTCJName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetGameRpcsName() const noexcept -> std::wstring_view;
+	[[nodiscard]] auto GetPolicyProbeName() const noexcept -> std::wstring_view;
 
 	//��ַ
 	//LOLClient
@@ -35,10 +59,24 @@ public:
 
 	//HWID
 	[[nodiscard]] auto GetPolicyProbeBase() const -> uintptr_t;
+
+	//One coherent copy of every base: fields read together never mix
+	//pre- and post-notification state the way per-field getters can
+	[[nodiscard]] auto GetSnapshot() const -> ClientSnapshot;
 public:
+	//Blocks until the named tracked module is resident (anticheat modules
+	//like TerSafe.dll load after us); returns its base, 0 on timeout
+	auto WaitForModuleBase(const std::wstring& module_name, unsigned timeout_ms) -> uintptr_t;
+
+	//Loader notification entry (LdrRegisterDllNotification), not for
+	//direct callers
+	void OnModuleNotify(bool loaded, std::wstring_view base_name, uintptr_t base);
 
 private:
 	void SetGameFullPath();
+	void StartModuleWatch();
+	void StopModuleWatch();
+	void PublishSnapshot();
 private:
 	//Name
 	const std::wstring _game_lobby_name_;
@@ -51,26 +89,36 @@ private:
 	const std::wstring _game_rpcs_name_;
 	const std::wstring _policy_probe_name_;
 
-	//HMODULE
-	uintptr_t _game_lobby_handle_;
-	uintptr_t _game_main_handle_;
-	uintptr_t _lol_base_handle_{};
-	uintptr_t _ter_safe_handle_;
-	uintptr_t _ten_rpcs_handle_;
-	uintptr_t _ten_slx_handle_;
-	uintptr_t _tcj_handle_;
-	uintptr_t _game_rpcs_handle_;
-	uintptr_t _policy_probe_handle_;
+	//HMODULE, updated from the loader notification the moment a tracked
+	//module loads or unloads
+	std::atomic<uintptr_t> _game_lobby_handle_;
+	std::atomic<uintptr_t> _game_main_handle_;
+	std::atomic<uintptr_t> _lol_base_handle_{};
+	std::atomic<uintptr_t> _ter_safe_handle_;
+	std::atomic<uintptr_t> _ten_rpcs_handle_;
+	std::atomic<uintptr_t> _ten_slx_handle_;
+	std::atomic<uintptr_t> _tcj_handle_;
+	std::atomic<uintptr_t> _game_rpcs_handle_;
+	std::atomic<uintptr_t> _policy_probe_handle_;
+
+	//Module watch
+	std::vector<std::pair<const std::wstring*, std::atomic<uintptr_t>*>> _watch_table_;
+	std::mutex _module_wait_lock_;
+	std::condition_variable _module_wait_cv_;
+	void* _ldr_cookie_{};
 
 	//Basic Info
 	fs::path _game_main_full_path_;
 	uintptr_t _game_main_pid_;
 
+	//Seqlock-guarded copy of the state above, rewritten on every module
+	//event (rare) and read from hooks (hot)
+	base::seqlock<ClientSnapshot> _snapshot_;
+
 
 
 
 };
-extern LOLClient g_lol_client;
 
 LOLClient& get_lol_client();
 
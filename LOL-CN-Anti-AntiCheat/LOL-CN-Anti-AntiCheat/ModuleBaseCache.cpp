@@ -0,0 +1,80 @@
+#include <ModuleBaseCache.h>
+#include <utility/singleton.h>
+
+#include <encstr/fnv1a.hpp>
+
+ModuleBaseCache::ModuleBaseCache()
+= default;
+
+
+ModuleBaseCache::~ModuleBaseCache()
+= default;
+
+auto ModuleBaseCache::Get(const std::wstring& module_name) -> uintptr_t
+{
+	const auto v_hash = HashName(module_name);
+
+	for (size_t i = 0; i < k_slot_count; ++i)
+	{
+		const auto& v_slot = _slots_[(v_hash + i) & (k_slot_count - 1)];
+		const auto v_slot_hash = v_slot._hash_.load(std::memory_order_acquire);
+		if (v_slot_hash == v_hash)
+			return v_slot._base_.load(std::memory_order_acquire);
+		if (v_slot_hash == 0)
+			break;
+	}
+
+	//Miss: resolve once and publish for every later caller
+	const auto v_base = reinterpret_cast<uintptr_t>(GetModuleHandleW(module_name.c_str()));
+	Store(v_hash, v_base);
+	return v_base;
+}
+
+auto ModuleBaseCache::Epoch() const noexcept -> unsigned
+{
+	return _epoch_.load(std::memory_order_acquire);
+}
+
+void ModuleBaseCache::OnModuleEvent(const bool loaded, const std::wstring_view base_name, const uintptr_t base)
+{
+	Store(HashName(base_name), loaded ? base : 0);
+	_epoch_.fetch_add(1, std::memory_order_release);
+}
+
+auto ModuleBaseCache::HashName(const std::wstring_view module_name) -> uint32_t
+{
+	//Case-folded: loader events and callers spell names differently
+	auto v_hash = encstr::fnv1a_i(module_name);
+	if (v_hash == 0)
+		v_hash = 1;
+	return v_hash;
+}
+
+void ModuleBaseCache::Store(const uint32_t hash, const uintptr_t base)
+{
+	std::lock_guard<std::mutex> v_guard(_write_lock_);
+
+	for (size_t i = 0; i < k_slot_count; ++i)
+	{
+		auto& v_slot = _slots_[(hash + i) & (k_slot_count - 1)];
+		const auto v_slot_hash = v_slot._hash_.load(std::memory_order_relaxed);
+		if (v_slot_hash == hash)
+		{
+			v_slot._base_.store(base, std::memory_order_release);
+			return;
+		}
+		if (v_slot_hash == 0)
+		{
+			//Base first, then hash: a reader that sees the hash sees the base
+			v_slot._base_.store(base, std::memory_order_release);
+			v_slot._hash_.store(hash, std::memory_order_release);
+			return;
+		}
+	}
+	//Table full: drop the entry, the caller still holds a correct resolve
+}
+
+ModuleBaseCache& get_module_base_cache()
+{
+	return base::singleton_atomic<ModuleBaseCache>::instance();
+}
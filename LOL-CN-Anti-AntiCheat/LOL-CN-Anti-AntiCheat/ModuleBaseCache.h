@@ -0,0 +1,51 @@
+#pragma once
+#include "framework.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+//Process-wide module-base cache
+//one shared view of module bases: reads are lock-free against a fixed
+//open-addressed table, the loader notification feeds load/unload events
+//in, and an epoch counter lets consumers cache derived addresses and
+//revalidate them with a single load
+class ModuleBaseCache
+{
+public:
+	ModuleBaseCache();
+	~ModuleBaseCache();
+
+	//Lock-free cached lookup; resolves through GetModuleHandleW and
+	//publishes the slot on first miss
+	auto Get(const std::wstring& module_name) -> uintptr_t;
+
+	//Bumped on every module load/unload; consumers tag derived values
+	//with the epoch they were computed under
+	[[nodiscard]] auto Epoch() const noexcept -> unsigned;
+
+	//Fed from the loader notification callback (see LOLClient), runs
+	//under the loader lock so it only updates a slot and bumps the epoch
+	void OnModuleEvent(bool loaded, std::wstring_view base_name, uintptr_t base);
+
+private:
+	struct Slot
+	{
+		std::atomic<uint32_t> _hash_{};
+		std::atomic<uintptr_t> _base_{};
+	};
+
+	//Power of two, a process tracks a few dozen modules at most
+	static constexpr size_t k_slot_count = 64;
+
+	[[nodiscard]] static auto HashName(std::wstring_view module_name) -> uint32_t;
+	void Store(uint32_t hash, uintptr_t base);
+
+private:
+	Slot _slots_[k_slot_count];
+	std::atomic<unsigned> _epoch_{};
+	//Writers only; readers never take it
+	std::mutex _write_lock_;
+};
+
+ModuleBaseCache& get_module_base_cache();
@@ -1,9 +1,52 @@
 #include <OffestManager.h>
+#include <ModuleBaseCache.h>
+#include <OffsetDatabase.h>
+#include <OffsetPack.h>
+#include <utility/singleton.h>
 #include <bee/utility/module_version_win.h>
 
+#include <BlackBone/Patterns/PatternSearch.h>
+#include <BlackBone/Misc/ScanArena.h>
+
+#include <vector>
+
 
 using encoder = encstr::cbc_t<encstr::ciphers::xor_cipher_t>;
 
+namespace
+{
+	//One fallback signature per database slot: the distinctive entry bytes
+	//of the target thread routine and the module it lives in, taken from
+	//the reversed 9.10 build. When a new game build has no database record
+	//these are scanned once and the result is stored keyed by that version
+	//0xCC marks a wildcard byte (padding, never part of these prologues)
+	constexpr uint8_t k_signature_wildcard = 0xCC;
+
+	struct OffsetSignature
+	{
+		uint32_t _slot_;
+		uintptr_t (LOLClient::* _base_getter_)() const;
+		std::vector<uint8_t> _pattern_;
+	};
+
+	const OffsetSignature k_offset_signatures[] =
+	{
+		//TP self-exception-trigger thread entry in League of Legends.exe
+		{ OffsetDatabase::kLolBaseSelfExceptionTrigThreadEntry, &LOLClient::GetLOLBase,
+			{ 0x55, 0x8B, 0xEC, 0x83, 0xE4, 0xF8, 0x81, 0xEC, k_signature_wildcard, k_signature_wildcard, 0x00, 0x00, 0xA1, k_signature_wildcard, k_signature_wildcard, k_signature_wildcard, k_signature_wildcard, 0x33, 0xC4 } },
+		//TerSafe.dll .text code-hash thread entry
+		{ OffsetDatabase::kTerSafeGameCodeHashThreadEntry, &LOLClient::GetTerSafeBase,
+			{ 0x55, 0x8B, 0xEC, 0x81, 0xEC, k_signature_wildcard, k_signature_wildcard, 0x00, 0x00, 0x56, 0x57, 0x8B, 0xF1, 0xE8 } },
+	};
+
+	auto GetImageSize(const uintptr_t base) -> size_t
+	{
+		const auto* v_dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+		const auto* v_nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + static_cast<uintptr_t>(v_dos->e_lfanew));
+		return v_nt->OptionalHeader.SizeOfImage;
+	}
+}
+
 
 OffestManager::OffestManager()
 	:_current_game_version_(ENCRYPT_STRING_AUTO_W(encoder, L"9.10.273.9316"))
@@ -30,14 +73,29 @@ void OffestManager::Init()
 }
 uintptr_t OffestManager::GetSelfExceptionTrigThreadEntryAddr() const
 {
+	const auto v_epoch = get_module_base_cache().Epoch();
+	if (_self_exception_addr_epoch_.load(std::memory_order_acquire) == v_epoch)
+		return _self_exception_addr_.load(std::memory_order_relaxed);
+
 	auto& v_lol_client = get_lol_client();
-	return v_lol_client.GetLOLBase() + lol_base_self_exception_trig_thread_entry_offest;
+	const auto v_addr = v_lol_client.GetLOLBase() + lol_base_self_exception_trig_thread_entry_offest;
+	//Value before epoch: a reader seeing the fresh epoch sees the address
+	_self_exception_addr_.store(v_addr, std::memory_order_relaxed);
+	_self_exception_addr_epoch_.store(v_epoch, std::memory_order_release);
+	return v_addr;
 }
 
 uintptr_t OffestManager::GetGlobalGameHashThreadEntryAddr() const
 {
+	const auto v_epoch = get_module_base_cache().Epoch();
+	if (_game_hash_addr_epoch_.load(std::memory_order_acquire) == v_epoch)
+		return _game_hash_addr_.load(std::memory_order_relaxed);
+
 	auto& v_lol_client = get_lol_client();
-	return v_lol_client.GetTerSafeBase() + _ter_safe_game_code_hash_thread_entry_offest;
+	const auto v_addr = v_lol_client.GetTerSafeBase() + _ter_safe_game_code_hash_thread_entry_offest;
+	_game_hash_addr_.store(v_addr, std::memory_order_relaxed);
+	_game_hash_addr_epoch_.store(v_epoch, std::memory_order_release);
+	return v_addr;
 }
 
 bool OffestManager::IsGameMainModified() const
@@ -59,11 +117,11 @@ auto OffestManager::GetUserGameVersion() const -> std::wstring
 void OffestManager::SetUserGameVersion()
 {
 	auto& v_lol_client = get_lol_client();
-	const auto v_tmp_version = bee::module_version(v_lol_client.GetGameMainFullPath().wstring().c_str());
-	const auto v_n_major_version = HIWORD(v_tmp_version.fixed_file_info()->dwFileVersionMS);
-	const auto v_n_minor_version = LOWORD(v_tmp_version.fixed_file_info()->dwFileVersionMS);
-	const auto v_n_build_version = HIWORD(v_tmp_version.fixed_file_info()->dwFileVersionLS);
-	const auto v_n_revi_version = LOWORD(v_tmp_version.fixed_file_info()->dwFileVersionLS);
+	const auto v_tmp_version = bee::module_version::cached(v_lol_client.GetGameMainFullPath().wstring().c_str());
+	const auto v_n_major_version = HIWORD(v_tmp_version->fixed_file_info()->dwFileVersionMS);
+	const auto v_n_minor_version = LOWORD(v_tmp_version->fixed_file_info()->dwFileVersionMS);
+	const auto v_n_build_version = HIWORD(v_tmp_version->fixed_file_info()->dwFileVersionLS);
+	const auto v_n_revi_version = LOWORD(v_tmp_version->fixed_file_info()->dwFileVersionLS);
 	
 	_user_game_version_ =
 		std::to_wstring(v_n_major_version) + \
@@ -74,4 +132,76 @@ void OffestManager::SetUserGameVersion()
 		L"." + \
 		std::to_wstring(v_n_revi_version);
 
+	//Database hit: the shipped data file knows the running version, take
+	//its offsets and treat the version as supported; the constructor
+	//constants stay as the fallback for the built-in version
+	const auto* v_record = get_offset_database().Find(v_n_major_version, v_n_minor_version, v_n_build_version, v_n_revi_version);
+	if (v_record != nullptr)
+	{
+		lol_base_self_exception_trig_thread_entry_offest = static_cast<uintptr_t>(v_record->offsets[OffsetDatabase::kLolBaseSelfExceptionTrigThreadEntry]);
+		_ter_safe_game_code_hash_thread_entry_offest = static_cast<uintptr_t>(v_record->offsets[OffsetDatabase::kTerSafeGameCodeHashThreadEntry]);
+		_current_game_version_ = _user_game_version_;
+	}
+	else if (_user_game_version_ != _current_game_version_)
+	{
+		OffsetDatabase::Record v_resolved = {};
+		v_resolved.version[0] = v_n_major_version;
+		v_resolved.version[1] = v_n_minor_version;
+		v_resolved.version[2] = v_n_build_version;
+		v_resolved.version[3] = v_n_revi_version;
+
+		//The pushed distribution pack knows builds before the local flat
+		//database does; a hit is promoted into the database so every
+		//later launch skips the pack decode too
+		if (get_offset_pack().Find(v_n_major_version, v_n_minor_version, v_n_build_version, v_n_revi_version, v_resolved))
+		{
+			lol_base_self_exception_trig_thread_entry_offest = static_cast<uintptr_t>(v_resolved.offsets[OffsetDatabase::kLolBaseSelfExceptionTrigThreadEntry]);
+			_ter_safe_game_code_hash_thread_entry_offest = static_cast<uintptr_t>(v_resolved.offsets[OffsetDatabase::kTerSafeGameCodeHashThreadEntry]);
+			_current_game_version_ = _user_game_version_;
+			get_offset_database().Store(v_resolved);
+		}
+		//Unknown build: try the signature fallback once and persist the
+		//result, so every later launch on this machine is a database hit
+		else if (ResolveOffsetsBySignature(v_resolved))
+		{
+			lol_base_self_exception_trig_thread_entry_offest = static_cast<uintptr_t>(v_resolved.offsets[OffsetDatabase::kLolBaseSelfExceptionTrigThreadEntry]);
+			_ter_safe_game_code_hash_thread_entry_offest = static_cast<uintptr_t>(v_resolved.offsets[OffsetDatabase::kTerSafeGameCodeHashThreadEntry]);
+			_current_game_version_ = _user_game_version_;
+			get_offset_database().Store(v_resolved);
+		}
+	}
+}
+
+bool OffestManager::ResolveOffsetsBySignature(OffsetDatabase::Record& record) const
+{
+	auto& v_lol_client = get_lol_client();
+
+	//One arena for the whole resolve pass: every match list is bump-allocated
+	//and the reset rewinds it in O(1), nothing hits the process heap per hit
+	blackbone::ScanArena v_arena;
+
+	for (const auto& v_signature : k_offset_signatures)
+	{
+		const auto v_base = (v_lol_client.*(v_signature._base_getter_))();
+		if (v_base == 0)
+			return false;
+
+		v_arena.Reset();
+		auto v_matches = v_arena.MakeResults();
+		const blackbone::PatternSearch v_searcher(v_signature._pattern_);
+		v_searcher.Search(k_signature_wildcard, reinterpret_cast<void*>(v_base), GetImageSize(v_base), v_matches);
+
+		//Only an unambiguous single hit is trusted
+		if (v_matches.size() != 1)
+			return false;
+
+		record.offsets[v_signature._slot_] = static_cast<uint64_t>(v_matches[0] - v_base);
+	}
+
+	return true;
+}
+
+OffestManager& get_offest_manager()
+{
+	return base::singleton_atomic<OffestManager>::instance();
 }
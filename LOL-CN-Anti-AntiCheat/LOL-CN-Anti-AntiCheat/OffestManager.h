@@ -1,6 +1,8 @@
 #pragma once
 #include "framework.h"
 #include <LOLClient.h>
+#include <OffsetDatabase.h>
+#include <atomic>
 
 class OffestManager
 {
@@ -19,6 +21,10 @@ public:
 
 private:
 	void SetUserGameVersion();
+	//Scans each offset's fallback signature against its loaded module;
+	//fills the record's offset slots, false when any signature is missing
+	//or ambiguous
+	[[nodiscard]] bool ResolveOffsetsBySignature(OffsetDatabase::Record& record) const;
 	[[nodiscard]] auto GetCurrentGameVersion() const->std::wstring;
 	[[nodiscard]] auto GetUserGameVersion() const->std::wstring;
 
@@ -32,5 +38,14 @@ private:
 	//TP League of Legends.exe �����.text code hash �߳����
 	uintptr_t _ter_safe_game_code_hash_thread_entry_offest;
 
+	//Derived-address caches, revalidated against the module cache epoch
+	//so the hot getters cost two loads while no module moved
+	mutable std::atomic<unsigned> _self_exception_addr_epoch_{ ~0u };
+	mutable std::atomic<uintptr_t> _self_exception_addr_{};
+	mutable std::atomic<unsigned> _game_hash_addr_epoch_{ ~0u };
+	mutable std::atomic<uintptr_t> _game_hash_addr_{};
+
 };
 
+OffestManager& get_offest_manager();
+
@@ -0,0 +1,125 @@
+#include <OffsetDatabase.h>
+#include <utility/singleton.h>
+#include <bee/utility/path_helper.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	//'LODB' little endian
+	constexpr uint32_t k_magic = 0x42444F4C;
+	constexpr uint32_t k_format = 1;
+
+	bool VersionLess(const uint16_t(&lhs)[4], const uint16_t(&rhs)[4])
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (lhs[i] != rhs[i])
+				return lhs[i] < rhs[i];
+		}
+		return false;
+	}
+}
+
+OffsetDatabase::OffsetDatabase()
+	: _records_(nullptr)
+	, _record_count_(0)
+{
+	Load();
+}
+
+OffsetDatabase::~OffsetDatabase()
+= default;
+
+bool OffsetDatabase::Load()
+{
+	auto v_view = bee::file::view(GetDatabaseFilePath().wstring(), true);
+	if (!v_view || v_view.size() < sizeof(Header))
+		return false;
+
+	const auto* v_header = reinterpret_cast<const Header*>(v_view.data());
+	if (v_header->magic != k_magic || v_header->format != k_format)
+		return false;
+
+	const auto v_count = v_header->record_count;
+	if (v_view.size() < sizeof(Header) + static_cast<size_t>(v_count) * sizeof(Record))
+		return false;
+
+	_view_ = std::move(v_view);
+	_records_ = reinterpret_cast<const Record*>(_view_.data() + sizeof(Header));
+	_record_count_ = v_count;
+	return true;
+}
+
+auto OffsetDatabase::Find(const uint16_t major, const uint16_t minor, const uint16_t build, const uint16_t revision) const -> const Record*
+{
+	if (_records_ == nullptr || _record_count_ == 0)
+		return nullptr;
+
+	const uint16_t v_key[4] = { major, minor, build, revision };
+	const auto* v_end = _records_ + _record_count_;
+	const auto* v_found = std::lower_bound(_records_, v_end, v_key,
+		[](const Record& record, const uint16_t(&key)[4]) { return VersionLess(record.version, key); });
+
+	if (v_found == v_end || VersionLess(v_key, v_found->version))
+		return nullptr;
+
+	return v_found;
+}
+
+bool OffsetDatabase::Store(const Record& record)
+{
+	//Work on a private copy: the mapping is read-only and has to be torn
+	//down before the file can be rewritten
+	std::vector<Record> v_records;
+	if (_records_ != nullptr)
+		v_records.assign(_records_, _records_ + _record_count_);
+
+	const auto v_insert = std::lower_bound(v_records.begin(), v_records.end(), record,
+		[](const Record& lhs, const Record& rhs) { return VersionLess(lhs.version, rhs.version); });
+	if (v_insert != v_records.end() && !VersionLess(record.version, v_insert->version))
+		*v_insert = record;
+	else
+		v_records.insert(v_insert, record);
+
+	_records_ = nullptr;
+	_record_count_ = 0;
+	_view_ = bee::file::view();
+
+	{
+		//Rename-swap: the whole database is flushed into a side file with
+		//one durable write, then swapped over the mapped original - a
+		//crash leaves either the old file or the new one, never a torn mix
+		const auto v_temp_path = GetDatabaseFilePath().wstring() + L".tmp";
+		DeleteFileW(v_temp_path.c_str());	//a stale side file from a crash must not be appended to
+		bee::file::batch v_batch(v_temp_path, sizeof(Header) + v_records.size() * sizeof(Record));
+		if (!v_batch)
+			return false;
+
+		const Header v_header = { k_magic, k_format, static_cast<uint32_t>(v_records.size()) };
+		v_batch.append(&v_header, sizeof(v_header));
+		v_batch.append(v_records.data(), v_records.size() * sizeof(Record));
+		if (!v_batch.flush())
+			return false;
+	}
+
+	if (!bee::file::batch::replace(GetDatabaseFilePath().wstring() + L".tmp", GetDatabaseFilePath().wstring()))
+		return false;
+
+	return Load();
+}
+
+auto OffsetDatabase::GetDatabaseFilePath() const -> fs::path
+{
+	const auto& v_dll_dir = bee::path_helper::dll_directory();
+	if (!v_dll_dir.empty())
+		return v_dll_dir / L"offsets.db";
+
+	return fs::path(L"offsets.db");
+}
+
+OffsetDatabase& get_offset_database()
+{
+	return base::singleton_atomic<OffsetDatabase>::instance();
+}
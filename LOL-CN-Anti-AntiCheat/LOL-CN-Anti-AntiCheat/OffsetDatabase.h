@@ -0,0 +1,60 @@
+#pragma once
+#include "framework.h"
+#include <bee/utility/file_helper.h>
+
+//Memory-mapped game offset database
+//flat binary file of (version quadruple -> offset table) records sorted
+//by version, mapped zero-copy and binary-searched in place, so a game
+//patch becomes a data-file push with no parse cost
+class OffsetDatabase
+{
+public:
+	//Slots inside a record's offset table; spare slots stay zero so a new
+	//offset ships without a format bump
+	enum OffsetSlot : uint32_t
+	{
+		kLolBaseSelfExceptionTrigThreadEntry = 0,
+		kTerSafeGameCodeHashThreadEntry = 1,
+
+		kSlotCount = 8,
+	};
+
+#pragma pack(push, 1)
+	struct Header
+	{
+		uint32_t magic;			//'LODB'
+		uint32_t format;
+		uint32_t record_count;
+	};
+
+	struct Record
+	{
+		uint16_t version[4];	//major, minor, build, revision
+		uint64_t offsets[kSlotCount];
+	};
+#pragma pack(pop)
+
+	OffsetDatabase();
+	~OffsetDatabase();
+
+	//Maps the database file next to the dll; false when absent or malformed
+	bool Load();
+
+	//Binary search by version quadruple, nullptr when the version is unknown
+	[[nodiscard]] auto Find(uint16_t major, uint16_t minor, uint16_t build, uint16_t revision) const -> const Record*;
+
+	//Merge an auto-resolved record into the file (replacing any record with
+	//the same version) and remap, so the next launch is a plain Find hit
+	bool Store(const Record& record);
+
+private:
+	[[nodiscard]] auto GetDatabaseFilePath() const -> fs::path;
+
+private:
+	//Keeps the mapping alive, _records_ points into it
+	bee::file::view _view_;
+	const Record* _records_;
+	uint32_t _record_count_;
+};
+
+OffsetDatabase& get_offset_database();
@@ -0,0 +1,109 @@
+#include <OffsetPack.h>
+#include <utility/singleton.h>
+#include <bee/utility/path_helper.h>
+
+#include <algorithm>
+
+static_assert(k_offset_pack_slot_count == OffsetDatabase::kSlotCount,
+	"pack format and database slot tables must stay in step");
+
+namespace
+{
+	bool VersionLess(const uint16_t(&lhs)[4], const uint16_t(&rhs)[4])
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (lhs[i] != rhs[i])
+				return lhs[i] < rhs[i];
+		}
+		return false;
+	}
+}
+
+OffsetPack::OffsetPack()
+	: _index_(nullptr)
+	, _record_count_(0)
+	, _payload_(nullptr)
+	, _payload_size_(0)
+{
+	Load();
+}
+
+
+OffsetPack::~OffsetPack()
+= default;
+
+bool OffsetPack::Load()
+{
+	auto v_view = bee::file::view(GetPackFilePath().wstring(), true);
+	if (!v_view || v_view.size() < sizeof(OffsetPackHeader))
+		return false;
+
+	const auto* v_header = reinterpret_cast<const OffsetPackHeader*>(v_view.data());
+	if (v_header->magic != k_offset_pack_magic || v_header->format != k_offset_pack_format)
+		return false;
+
+	//every section has to land inside the file before anything points at it
+	const auto v_index_end = sizeof(OffsetPackHeader) + static_cast<size_t>(v_header->record_count) * sizeof(OffsetPackIndexEntry);
+	if (v_index_end > v_view.size()
+		|| v_header->dict_offset != v_index_end
+		|| v_header->payload_offset != static_cast<size_t>(v_header->dict_offset) + v_header->dict_size
+		|| static_cast<size_t>(v_header->payload_offset) + v_header->payload_size > v_view.size())
+	{
+		return false;
+	}
+
+	_view_ = std::move(v_view);
+	_index_ = reinterpret_cast<const OffsetPackIndexEntry*>(_view_.data() + sizeof(OffsetPackHeader));
+	_record_count_ = reinterpret_cast<const OffsetPackHeader*>(_view_.data())->record_count;
+	_payload_ = _view_.data() + reinterpret_cast<const OffsetPackHeader*>(_view_.data())->payload_offset;
+	_payload_size_ = reinterpret_cast<const OffsetPackHeader*>(_view_.data())->payload_size;
+	return true;
+}
+
+bool OffsetPack::Find(const uint16_t major, const uint16_t minor, const uint16_t build, const uint16_t revision, OffsetDatabase::Record& out) const
+{
+	if (_index_ == nullptr || _record_count_ == 0)
+		return false;
+
+	const uint16_t v_key[4] = { major, minor, build, revision };
+	const auto* v_end = _index_ + _record_count_;
+	const auto* v_found = std::lower_bound(_index_, v_end, v_key,
+		[](const OffsetPackIndexEntry& entry, const uint16_t(&key)[4]) { return VersionLess(entry.version, key); });
+
+	if (v_found == v_end || VersionLess(v_key, v_found->version))
+		return false;
+	if (v_found->payload_offset > _payload_size_ || v_found->payload_size > _payload_size_ - v_found->payload_offset)
+		return false;
+
+	//decode only the found record: eight varint slots, the signature
+	//entries behind them are not needed here
+	const auto* v_cursor = _payload_ + v_found->payload_offset;
+	const auto* v_limit = v_cursor + v_found->payload_size;
+
+	out = {};
+	memcpy(out.version, v_found->version, sizeof(out.version));
+	for (auto& v_slot : out.offsets)
+	{
+		uint64_t v_value = 0;
+		if (!OffsetPackReadVarint(v_cursor, v_limit, v_value))
+			return false;
+		v_slot = v_value;
+	}
+
+	return true;
+}
+
+auto OffsetPack::GetPackFilePath() const -> fs::path
+{
+	const auto& v_dll_dir = bee::path_helper::dll_directory();
+	if (!v_dll_dir.empty())
+		return v_dll_dir / L"offsets.pack";
+
+	return fs::path(L"offsets.pack");
+}
+
+OffsetPack& get_offset_pack()
+{
+	return base::singleton_atomic<OffsetPack>::instance();
+}
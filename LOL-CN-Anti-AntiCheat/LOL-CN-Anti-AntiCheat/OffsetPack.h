@@ -0,0 +1,38 @@
+#pragma once
+#include "framework.h"
+#include <OffsetDatabase.h>
+#include <OffsetPackFormat.h>
+#include <bee/utility/file_helper.h>
+
+//Reader for the compressed offset distribution file (offsets.pack)
+//the patch-day push lands as one LODC file; loading it is a map plus a
+//header check, lookups binary-search the fixed index in place and only
+//the found record's varint payload is decoded. OffestManager consults
+//this after the local flat database misses and promotes hits into it,
+//so the decode runs at most once per game version
+class OffsetPack
+{
+public:
+	OffsetPack();
+	~OffsetPack();
+
+	//Maps the pack file next to the dll; false when absent or malformed
+	bool Load();
+
+	//Decode the offsets for a version quadruple; false when unknown.
+	//Signature payloads stay in the file for tooling and future resolvers
+	bool Find(uint16_t major, uint16_t minor, uint16_t build, uint16_t revision, OffsetDatabase::Record& out) const;
+
+private:
+	[[nodiscard]] auto GetPackFilePath() const -> fs::path;
+
+private:
+	//Keeps the mapping alive, _index_ and _payload_ point into it
+	bee::file::view _view_;
+	const OffsetPackIndexEntry* _index_;
+	uint32_t _record_count_;
+	const uint8_t* _payload_;
+	uint32_t _payload_size_;
+};
+
+OffsetPack& get_offset_pack();
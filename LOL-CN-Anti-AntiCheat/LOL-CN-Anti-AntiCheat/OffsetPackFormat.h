@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//Compressed offset+signature distribution format ("LODC")
+//the patch-day push format: a fixed-size sorted index block enables
+//memory-mapped binary search without inflating anything, record payloads
+//are varint streams (zero offset slots cost one byte) and signature
+//bytes are dictionary-compressed - every signature is a (offset, length)
+//reference into one shared dictionary, with substring reuse. cold load
+//is a map plus a header check: no allocation, no parse. this header is
+//shared between the dll reader (OffsetPack) and the builder tool
+//(OffsetPackTool), so it depends on nothing but the standard library
+
+constexpr uint32_t k_offset_pack_magic = 0x43444F4C;	//'LODC' little endian
+constexpr uint32_t k_offset_pack_format = 1;
+constexpr uint32_t k_offset_pack_slot_count = 8;		//mirrors OffsetDatabase::kSlotCount
+
+#pragma pack(push, 1)
+struct OffsetPackHeader
+{
+	uint32_t magic;
+	uint32_t format;
+	uint32_t record_count;
+	uint32_t dict_offset;		//from file start
+	uint32_t dict_size;
+	uint32_t payload_offset;	//from file start
+	uint32_t payload_size;
+};
+
+//Sorted by version; binary-searched in place on the mapping
+struct OffsetPackIndexEntry
+{
+	uint16_t version[4];		//major, minor, build, revision
+	uint32_t payload_offset;	//relative to the payload section
+	uint32_t payload_size;
+};
+#pragma pack(pop)
+
+//Record payload stream:
+//  slot_count * varint        offset slots, in slot order
+//  varint                     signature count
+//  per signature:
+//    varint                   slot the signature resolves
+//    varint                   dictionary offset
+//    varint                   signature length
+
+//LEB128, unsigned
+inline void OffsetPackWriteVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back(static_cast<uint8_t>(value) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+//Returns false when the stream ends mid-value
+inline bool OffsetPackReadVarint(const uint8_t*& cursor, const uint8_t* end, uint64_t& value)
+{
+	value = 0;
+	for (unsigned v_shift = 0; cursor < end && v_shift < 64; v_shift += 7)
+	{
+		const auto v_byte = *cursor++;
+		value |= static_cast<uint64_t>(v_byte & 0x7F) << v_shift;
+		if ((v_byte & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+//One-pass pack builder: collect entries, then Build() sorts the index,
+//grows the dictionary with substring reuse and emits the file image
+class OffsetPackBuilder
+{
+public:
+	struct Signature
+	{
+		uint32_t _slot_;
+		std::vector<uint8_t> _bytes_;
+	};
+
+	struct Entry
+	{
+		uint16_t _version_[4];
+		uint64_t _offsets_[k_offset_pack_slot_count];
+		std::vector<Signature> _signatures_;
+	};
+
+	void Add(Entry entry)
+	{
+		_entries_.emplace_back(std::move(entry));
+	}
+
+	[[nodiscard]] auto Build() -> std::vector<uint8_t>
+	{
+		std::sort(_entries_.begin(), _entries_.end(),
+			[](const Entry& lhs, const Entry& rhs)
+			{
+				return std::lexicographical_compare(lhs._version_, lhs._version_ + 4, rhs._version_, rhs._version_ + 4);
+			});
+
+		//payloads first, they decide the index entries and the dictionary
+		std::vector<uint8_t> v_payload;
+		std::vector<OffsetPackIndexEntry> v_index;
+		v_index.reserve(_entries_.size());
+
+		for (const auto& v_entry : _entries_)
+		{
+			OffsetPackIndexEntry v_slot = {};
+			memcpy(v_slot.version, v_entry._version_, sizeof(v_slot.version));
+			v_slot.payload_offset = static_cast<uint32_t>(v_payload.size());
+
+			for (const auto v_offest : v_entry._offsets_)
+				OffsetPackWriteVarint(v_payload, v_offest);
+
+			OffsetPackWriteVarint(v_payload, v_entry._signatures_.size());
+			for (const auto& v_signature : v_entry._signatures_)
+			{
+				OffsetPackWriteVarint(v_payload, v_signature._slot_);
+				OffsetPackWriteVarint(v_payload, DictOffset(v_signature._bytes_));
+				OffsetPackWriteVarint(v_payload, v_signature._bytes_.size());
+			}
+
+			v_slot.payload_size = static_cast<uint32_t>(v_payload.size()) - v_slot.payload_offset;
+			v_index.emplace_back(v_slot);
+		}
+
+		OffsetPackHeader v_header = {};
+		v_header.magic = k_offset_pack_magic;
+		v_header.format = k_offset_pack_format;
+		v_header.record_count = static_cast<uint32_t>(v_index.size());
+		v_header.dict_offset = static_cast<uint32_t>(sizeof(v_header) + v_index.size() * sizeof(OffsetPackIndexEntry));
+		v_header.dict_size = static_cast<uint32_t>(_dict_.size());
+		v_header.payload_offset = v_header.dict_offset + v_header.dict_size;
+		v_header.payload_size = static_cast<uint32_t>(v_payload.size());
+
+		std::vector<uint8_t> v_file;
+		v_file.reserve(v_header.payload_offset + v_payload.size());
+		v_file.insert(v_file.end(), reinterpret_cast<const uint8_t*>(&v_header), reinterpret_cast<const uint8_t*>(&v_header + 1));
+		v_file.insert(v_file.end(), reinterpret_cast<const uint8_t*>(v_index.data()), reinterpret_cast<const uint8_t*>(v_index.data() + v_index.size()));
+		v_file.insert(v_file.end(), _dict_.begin(), _dict_.end());
+		v_file.insert(v_file.end(), v_payload.begin(), v_payload.end());
+		return v_file;
+	}
+
+private:
+	//Reuse any existing occurrence of the bytes (identical signatures and
+	//shared substrings cost nothing), append only when absent
+	auto DictOffset(const std::vector<uint8_t>& bytes) -> uint64_t
+	{
+		if (!bytes.empty() && _dict_.size() >= bytes.size())
+		{
+			const auto v_found = std::search(_dict_.begin(), _dict_.end(), bytes.begin(), bytes.end());
+			if (v_found != _dict_.end())
+				return static_cast<uint64_t>(v_found - _dict_.begin());
+		}
+
+		const auto v_offest = _dict_.size();
+		_dict_.insert(_dict_.end(), bytes.begin(), bytes.end());
+		return v_offest;
+	}
+
+private:
+	std::vector<Entry> _entries_;
+	std::vector<uint8_t> _dict_;
+};
@@ -0,0 +1,116 @@
+#include <PhaseTimer.h>
+#include <utility/singleton.h>
+#include <bee/utility/path_helper.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	struct open_phase
+	{
+		std::wstring _name_;
+		int64_t _qpc_;
+		uint64_t _cpu_100ns_;
+	};
+
+	//per-thread stack of open phases
+	thread_local std::vector<open_phase> t_open_phases;
+
+	//Kernel + user time of the calling thread, in 100ns units
+	auto thread_cpu_100ns() -> uint64_t
+	{
+		FILETIME v_creation = {}, v_exit = {}, v_kernel = {}, v_user = {};
+		if (!GetThreadTimes(GetCurrentThread(), &v_creation, &v_exit, &v_kernel, &v_user))
+			return 0;
+
+		const auto v_kernel_time = (static_cast<uint64_t>(v_kernel.dwHighDateTime) << 32) | v_kernel.dwLowDateTime;
+		const auto v_user_time = (static_cast<uint64_t>(v_user.dwHighDateTime) << 32) | v_user.dwLowDateTime;
+		return v_kernel_time + v_user_time;
+	}
+}
+
+PhaseTimer::PhaseTimer()
+	: _qpc_frequency_(0)
+	, _tm_phase_us_(get_telemetry().RegisterHistogram("phase.wall_us"))
+{
+	LARGE_INTEGER v_freq = { };
+	QueryPerformanceFrequency(&v_freq);
+	_qpc_frequency_ = v_freq.QuadPart;
+}
+
+
+PhaseTimer::~PhaseTimer()
+= default;
+
+void PhaseTimer::Begin(const std::wstring& name)
+{
+	LARGE_INTEGER v_now = { };
+	QueryPerformanceCounter(&v_now);
+	t_open_phases.push_back({ name, v_now.QuadPart, thread_cpu_100ns() });
+}
+
+void PhaseTimer::End()
+{
+	if (t_open_phases.empty())
+		return;
+
+	LARGE_INTEGER v_now = { };
+	QueryPerformanceCounter(&v_now);
+
+	const auto v_open = std::move(t_open_phases.back());
+	t_open_phases.pop_back();
+
+	phase_entry v_entry;
+	v_entry._name_ = std::move(v_open._name_);
+	v_entry._depth_ = static_cast<uint32_t>(t_open_phases.size());
+	v_entry._ms_ = static_cast<double>(v_now.QuadPart - v_open._qpc_) * 1000.0 / static_cast<double>(_qpc_frequency_);
+	v_entry._cpu_ms_ = static_cast<double>(thread_cpu_100ns() - v_open._cpu_100ns_) / 10000.0;
+
+	_tm_phase_us_.Record(static_cast<uint64_t>(v_entry._ms_ * 1000.0));
+
+	std::lock_guard<std::mutex> v_guard(_lock_);
+	_entries_.emplace_back(std::move(v_entry));
+}
+
+auto PhaseTimer::Report() -> std::wstring
+{
+	std::wstringstream v_report;
+
+	std::lock_guard<std::mutex> v_guard(_lock_);
+	for (const auto& v_entry : _entries_)
+	{
+		v_report << std::wstring(static_cast<size_t>(v_entry._depth_) * 2, L' ')
+			<< v_entry._name_ << L": " << v_entry._ms_ << L" ms"
+			<< L" (cpu " << v_entry._cpu_ms_ << L" ms)\n";
+	}
+
+	return v_report.str();
+}
+
+void PhaseTimer::WriteReport()
+{
+	auto v_report_path = fs::path(L"phase_report.log");
+	const auto& v_dll_dir = bee::path_helper::dll_directory();
+	if (!v_dll_dir.empty())
+		v_report_path = v_dll_dir / v_report_path;
+
+	std::wofstream v_file(v_report_path, std::ios::out | std::ios::app);
+	if (v_file.is_open())
+		v_file << Report();
+}
+
+PhaseTimer::Scope::Scope(const std::wstring& name)
+{
+	get_phase_timer().Begin(name);
+}
+
+PhaseTimer::Scope::~Scope()
+{
+	get_phase_timer().End();
+}
+
+PhaseTimer& get_phase_timer()
+{
+	return base::singleton_atomic<PhaseTimer>::instance();
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "framework.h"
+#include <mutex>
+#include <vector>
+
+#include <Telemetry.h>
+
+//QPC-stamped startup phase timing: named phases nest per thread and are
+//accumulated into a report retrievable at runtime or written at ready-state.
+//This is the surface every startup-latency change proves its win against
+class PhaseTimer
+{
+public:
+	PhaseTimer();
+	~PhaseTimer();
+
+	//Open a phase on the calling thread, nested under any open phase
+	void Begin(const std::wstring& name);
+	//Close the innermost open phase and record its duration
+	void End();
+
+	//Flat report, one line per recorded phase: depth-indented name + ms
+	[[nodiscard]] auto Report() -> std::wstring;
+
+	//Append the report next to the dll (phase_report.log)
+	void WriteReport();
+
+	//RAII phase
+	class Scope
+	{
+	public:
+		explicit Scope(const std::wstring& name);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+private:
+	struct phase_entry
+	{
+		std::wstring _name_;
+		uint32_t _depth_;
+		double _ms_;
+		//Thread CPU time spent inside the phase; the gap to wall time is
+		//blocking (I/O, waits), which is what attach-latency hunts care about
+		double _cpu_ms_;
+	};
+
+private:
+	int64_t _qpc_frequency_;
+	std::mutex _lock_;
+	std::vector<phase_entry> _entries_;
+
+	//Phase wall-time distribution for the telemetry sampler, in
+	//microseconds so the log2 buckets resolve sub-millisecond phases
+	Telemetry::Histogram _tm_phase_us_;
+};
+
+PhaseTimer& get_phase_timer();
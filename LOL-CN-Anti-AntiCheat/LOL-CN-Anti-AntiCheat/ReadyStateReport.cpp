@@ -0,0 +1,84 @@
+#include <ReadyStateReport.h>
+#include <PhaseTimer.h>
+#include <ScanResultCache.h>
+#include <SharedSymbolCache.h>
+#include <utility/singleton.h>
+
+#include <sstream>
+
+namespace
+{
+	//Segment layout, written once at ready-state then read-only; readers
+	//spin on ready before trusting chars/text
+	struct ready_report_block
+	{
+		volatile long ready;
+		uint32_t chars;
+		wchar_t text[1];
+	};
+
+	//Generous upper bound for the report text
+	constexpr size_t k_segment_size = 16 * 1024;
+}
+
+ReadyStateReport::ReadyStateReport()
+= default;
+
+
+ReadyStateReport::~ReadyStateReport()
+= default;
+
+void ReadyStateReport::Publish()
+{
+	const auto v_report = Build();
+
+	const auto v_name = MakeSegmentName();
+	_segment_ = std::make_unique<bee::win::subprocess::sharedmemory>(
+		bee::win::subprocess::open_or_create, v_name.c_str(), k_segment_size);
+	if (!_segment_->ok())
+		return;
+
+	const auto v_block = reinterpret_cast<ready_report_block*>(_segment_->data());
+	const auto v_capacity = (k_segment_size - offsetof(ready_report_block, text)) / sizeof(wchar_t) - 1;
+	const auto v_chars = std::min(v_report.size(), v_capacity);
+
+	memcpy(v_block->text, v_report.c_str(), v_chars * sizeof(wchar_t));
+	v_block->text[v_chars] = L'\0';
+	v_block->chars = static_cast<uint32_t>(v_chars);
+	InterlockedExchange(&v_block->ready, 1);
+}
+
+auto ReadyStateReport::Build() -> std::wstring
+{
+	std::wstringstream v_report;
+
+	v_report << L"=== ready-state report, pid " << GetCurrentProcessId() << L" ===\n";
+
+	//Per-stage wall and CPU time; the gap between them is blocking
+	v_report << get_phase_timer().Report();
+
+	const auto v_scan = get_scan_result_cache().GetStats();
+	const auto v_lookups = v_scan._hits_ + v_scan._misses_;
+	v_report << L"scan_cache: " << v_scan._hits_ << L"/" << v_lookups << L" hits";
+	if (v_lookups != 0)
+		v_report << L" (" << (v_scan._hits_ * 100 / v_lookups) << L"%)";
+	v_report << L", " << v_scan._remote_bytes_ << L" bytes scanned remotely\n";
+
+	v_report << L"symbol_cache: "
+		<< (get_shared_symbol_cache().WasAdopted() ? L"adopted from shared segment" : L"resolved in-process") << L"\n";
+
+	return v_report.str();
+}
+
+auto ReadyStateReport::MakeSegmentName() const -> std::wstring
+{
+	//Per-pid: a collector enumerates game processes and opens each
+	wchar_t v_name[64] = { 0 };
+	swprintf_s(v_name, L"Local\\LOL_CN_Ready_%08X", GetCurrentProcessId());
+	return v_name;
+}
+
+ReadyStateReport& get_ready_state_report()
+{
+	return base::singleton_atomic<ReadyStateReport>::instance();
+}
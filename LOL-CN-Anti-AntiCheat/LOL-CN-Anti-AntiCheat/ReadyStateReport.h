@@ -0,0 +1,31 @@
+#pragma once
+#include "framework.h"
+#include <memory>
+#include <string>
+
+#include <bee/subprocess/sharedmemory_win.h>
+
+//Ready-state latency budget report
+//aggregated when the init pipeline completes: per-stage wall/CPU time
+//from PhaseTimer plus cache hit rates and remote-read volume, published
+//into a per-pid shared memory segment so tooling can pull it without
+//touching the game process
+class ReadyStateReport
+{
+public:
+	ReadyStateReport();
+	~ReadyStateReport();
+
+	//Build the report and publish it into the segment
+	void Publish();
+
+private:
+	[[nodiscard]] auto Build() -> std::wstring;
+	[[nodiscard]] auto MakeSegmentName() const -> std::wstring;
+
+private:
+	//keeps the section alive for external readers
+	std::unique_ptr<bee::win::subprocess::sharedmemory> _segment_;
+};
+
+ReadyStateReport& get_ready_state_report();
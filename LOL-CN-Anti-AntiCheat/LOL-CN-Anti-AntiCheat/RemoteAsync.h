@@ -0,0 +1,193 @@
+#pragma once
+#include "framework.h"
+#include <utility/thread_pool.h>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <BlackBone/Process/ProcessMemory.h>
+#include <BlackBone/Process/RPC/RemoteExec.h>
+
+//Coroutine layer over remote operations
+//monitoring logic that used to park a dedicated thread per blocking
+//read/call chain is written as sequential co_await code instead; the
+//blocking blackbone calls run on the shared pool and the coroutine
+//resumes on the worker that finished them, so one logical flow no
+//longer owns a thread while it waits
+namespace remote_async
+{
+	//Coroutine return type: lazy, awaitable, moves its result out once.
+	//The continuation is resumed by symmetric transfer so chained awaits
+	//do not grow the stack
+	template<typename result_type>
+	class RemoteTask
+	{
+	public:
+		struct promise_type
+		{
+			std::optional<result_type> _value_;
+			std::exception_ptr _error_;
+			std::coroutine_handle<> _continuation_;
+
+			auto get_return_object() { return RemoteTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+			struct final_awaiter
+			{
+				bool await_ready() noexcept { return false; }
+				auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept -> std::coroutine_handle<>
+				{
+					auto v_continuation = handle.promise()._continuation_;
+					return v_continuation ? v_continuation : std::noop_coroutine();
+				}
+				void await_resume() noexcept { }
+			};
+
+			auto final_suspend() noexcept { return final_awaiter{}; }
+			void return_value(result_type value) { _value_.emplace(std::move(value)); }
+			void unhandled_exception() { _error_ = std::current_exception(); }
+		};
+
+		explicit RemoteTask(std::coroutine_handle<promise_type> handle)
+			: _handle_(handle)
+		{ }
+
+		RemoteTask(RemoteTask&& other) noexcept
+			: _handle_(std::exchange(other._handle_, nullptr))
+		{ }
+
+		RemoteTask(const RemoteTask&) = delete;
+		RemoteTask& operator=(const RemoteTask&) = delete;
+
+		~RemoteTask()
+		{
+			if (_handle_)
+				_handle_.destroy();
+		}
+
+		bool await_ready() const noexcept { return false; }
+
+		auto await_suspend(std::coroutine_handle<> awaiter) noexcept -> std::coroutine_handle<>
+		{
+			_handle_.promise()._continuation_ = awaiter;
+			return _handle_;
+		}
+
+		auto await_resume() -> result_type
+		{
+			if (_handle_.promise()._error_)
+				std::rethrow_exception(_handle_.promise()._error_);
+			return std::move(*_handle_.promise()._value_);
+		}
+
+		//Blocking bridge for non-coroutine callers: starts the task and
+		//helps the pool until it finishes
+		auto Get() -> result_type
+		{
+			_handle_.resume();
+			base::shared_thread_pool().help_until([this] { return _handle_.done(); });
+			return await_resume();
+		}
+
+	private:
+		std::coroutine_handle<promise_type> _handle_;
+	};
+
+	//Awaitable that runs a blocking callable on the shared pool and
+	//resumes the coroutine with its result on the finishing worker
+	template<typename fn_type>
+	class PoolAwaitable
+	{
+	public:
+		using result_type = std::invoke_result_t<fn_type>;
+
+		explicit PoolAwaitable(fn_type fn)
+			: _fn_(std::move(fn))
+		{ }
+
+		bool await_ready() const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			base::shared_thread_pool().submit([this, handle]
+			{
+				try
+				{
+					_value_.emplace(_fn_());
+				}
+				catch (...)
+				{
+					_error_ = std::current_exception();
+				}
+				handle.resume();
+			});
+		}
+
+		auto await_resume() -> result_type
+		{
+			if (_error_)
+				std::rethrow_exception(_error_);
+			return std::move(*_value_);
+		}
+
+	private:
+		fn_type _fn_;
+		std::optional<result_type> _value_;
+		std::exception_ptr _error_;
+	};
+
+	//co_await RunAsync([&]{ return blocking_call(); })
+	template<typename fn_type>
+	auto RunAsync(fn_type fn)
+	{
+		return PoolAwaitable<fn_type>(std::move(fn));
+	}
+
+	//Hop to a pool worker without running anything: the rest of the
+	//coroutine continues off the caller's thread
+	inline auto SwitchToPool()
+	{
+		struct awaitable
+		{
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				base::shared_thread_pool().submit([handle] { handle.resume(); });
+			}
+			void await_resume() noexcept { }
+		};
+		return awaitable{};
+	}
+
+	//co_await wrappers over the remote primitives we compose most; the
+	//referenced objects must stay alive until the await resumes
+
+	inline auto ReadAsync(blackbone::ProcessMemory& memory, blackbone::ptr_t address, size_t size, PVOID result)
+	{
+		return RunAsync([=, &memory] { return memory.Read(address, size, result); });
+	}
+
+	template<typename data_type>
+	auto ReadAsync(blackbone::ProcessMemory& memory, blackbone::ptr_t address, data_type& result)
+	{
+		return RunAsync([=, &memory, &result] { return memory.Read(address, result); });
+	}
+
+	inline auto WriteAsync(blackbone::ProcessMemory& memory, blackbone::ptr_t address, size_t size, const void* data)
+	{
+		return RunAsync([=, &memory] { return memory.Write(address, size, data); });
+	}
+
+	inline auto ExecDirectAsync(blackbone::RemoteExec& remote, blackbone::ptr_t code, blackbone::ptr_t arg)
+	{
+		return RunAsync([=, &remote] { return remote.ExecDirect(code, arg); });
+	}
+
+	inline auto ExecInWorkerThreadAsync(blackbone::RemoteExec& remote, PVOID code, size_t size, uint64_t& callResult)
+	{
+		return RunAsync([=, &remote, &callResult] { return remote.ExecInWorkerThread(code, size, callResult); });
+	}
+}
@@ -0,0 +1,202 @@
+#include <ScanResultCache.h>
+#include <CacheStore.h>
+#include <KernelSelect.h>
+#include <utility/memory_prefetch.h>
+#include <utility/singleton.h>
+#include <bee/utility/module_version_win.h>
+
+namespace
+{
+	//fnv1a-64
+	constexpr uint64_t k_fnv_offset = 14695981039346656037ull;
+	constexpr uint64_t k_fnv_prime = 1099511628211ull;
+
+	//namespace in the unified cache store
+	const wchar_t* const k_store_ns = L"scan";
+
+	//Local scan engine measured once per machine: BMH wins on some
+	//low-end parts where the vector loads stall, AVX2 wins nearly
+	//everywhere else, so the first scan races both over a synthetic
+	//module-sized buffer and every seat keeps its own winner
+	auto chosen_scan_engine() -> blackbone::PatternSearch::eSearchEngine
+	{
+		static const auto v_engine = []
+		{
+			std::vector<uint8_t> v_workload(256 * 1024);
+			uint32_t v_state = 0x9e3779b9;
+			for (auto& v_byte : v_workload)
+			{
+				v_state = v_state * 1664525u + 1013904223u;
+				v_byte = static_cast<uint8_t>(v_state >> 24);
+			}
+
+			//absent needle, so both candidates pay the full traversal
+			const uint8_t v_needle[] = { 0xde, 0xad, 0xbe, 0xef, 0xf0, 0x0d, 0xca, 0xfe, 0xba, 0x5e, 0xba, 0x11, 0x13, 0x37, 0xc0, 0xde };
+			blackbone::PatternSearch v_searcher(v_needle, sizeof(v_needle));
+
+			const auto v_run = [&v_searcher, &v_workload](blackbone::PatternSearch::eSearchEngine engine)
+			{
+				v_searcher.SetSearchEngine(engine);
+				blackbone::vecScanResult v_matches;
+				v_searcher.Search(v_workload.data(), v_workload.size(), v_matches);
+			};
+
+			const auto v_winner = get_kernel_select().Choose(L"scan.local", {
+				{ "bmh_scalar", [&v_run] { v_run(blackbone::PatternSearch::Scalar); } },
+				{ "vectorized", [&v_run] { v_run(blackbone::PatternSearch::Vectorized); } } });
+
+			return v_winner == 0
+				? blackbone::PatternSearch::Scalar
+				: blackbone::PatternSearch::Vectorized;
+		}();
+
+		return v_engine;
+	}
+}
+
+ScanResultCache::ScanResultCache()
+	: _tm_hits_(get_telemetry().RegisterCounter("scan_cache.hits"))
+	, _tm_misses_(get_telemetry().RegisterCounter("scan_cache.misses"))
+	, _tm_remote_bytes_(get_telemetry().RegisterCounter("scan_cache.remote_bytes"))
+{
+}
+
+
+ScanResultCache::~ScanResultCache()
+= default;
+
+size_t ScanResultCache::SearchRemote(
+	blackbone::Process& remote,
+	const fs::path& module_path,
+	const std::vector<uint8_t>& pattern,
+	blackbone::ptr_t scan_start,
+	size_t scan_size,
+	blackbone::vecScanResult& out)
+{
+	const auto v_stamp = GetModuleStamp(module_path);
+	const auto v_key = MakeKey(module_path, HashPattern(pattern));
+
+	auto v_hit = _results_.find(v_key);
+	if (v_hit == _results_.end())
+	{
+		//Cold in this process: the store may still hold the offsets from
+		//an earlier run against the same module version
+		std::vector<uint8_t> v_payload;
+		if (get_cache_store().Lookup(k_store_ns, v_key, v_stamp, v_payload)
+			&& v_payload.size() % sizeof(uint64_t) == 0)
+		{
+			const auto v_offests = reinterpret_cast<const uint64_t*>(v_payload.data());
+			v_hit = _results_.emplace(v_key,
+				std::vector<uint64_t>(v_offests, v_offests + v_payload.size() / sizeof(uint64_t))).first;
+		}
+	}
+
+	//Warm attach: rebase the stored offsets, no remote read at all
+	if (v_hit != _results_.end())
+	{
+		_hit_count_.fetch_add(1, std::memory_order_relaxed);
+		_tm_hits_.Add();
+		for (const auto v_offest : v_hit->second)
+			out.emplace_back(scan_start + v_offest);
+		return out.size();
+	}
+
+	//Cold attach: scan and remember
+	_miss_count_.fetch_add(1, std::memory_order_relaxed);
+	_remote_bytes_.fetch_add(scan_size, std::memory_order_relaxed);
+	_tm_misses_.Add();
+	_tm_remote_bytes_.Add(static_cast<LONGLONG>(scan_size));
+	//Batch the target range's faults ahead of the scan instead of taking
+	//them one read at a time inside it
+	base::prefetch_range(remote.core().handle(), reinterpret_cast<void*>(scan_start), scan_size);
+	blackbone::PatternSearch v_searcher(pattern);
+	v_searcher.SetSearchEngine(chosen_scan_engine());
+	v_searcher.SearchRemote(remote, scan_start, scan_size, out);
+	Store(v_key, v_stamp, scan_start, out);
+
+	return out.size();
+}
+
+auto ScanResultCache::GetStats() const -> Stats
+{
+	return {
+		_hit_count_.load(std::memory_order_relaxed),
+		_miss_count_.load(std::memory_order_relaxed),
+		_remote_bytes_.load(std::memory_order_relaxed) };
+}
+
+void ScanResultCache::Prefetch()
+{
+	get_cache_store().Prefetch();
+}
+
+void ScanResultCache::InvalidateModule(const fs::path& module_path)
+{
+	//Store entries for the old version age out by failing the stamp
+	//check; only the in-process memo needs dropping
+	const auto v_prefix = module_path.wstring() + L"|";
+	for (auto v_it = _results_.begin(); v_it != _results_.end();)
+	{
+		if (v_it->first.compare(0, v_prefix.size(), v_prefix) == 0)
+			v_it = _results_.erase(v_it);
+		else
+			++v_it;
+	}
+
+	_versions_.erase(module_path.wstring());
+}
+
+void ScanResultCache::Store(const std::wstring& key, const uint64_t stamp, blackbone::ptr_t scan_start, const blackbone::vecScanResult& results)
+{
+	std::vector<uint64_t> v_offests;
+	v_offests.reserve(results.size());
+	for (const auto v_addr : results)
+		v_offests.emplace_back(v_addr - scan_start);
+
+	get_cache_store().Store(k_store_ns, key, stamp,
+		v_offests.data(), v_offests.size() * sizeof(uint64_t));
+
+	_results_[key] = std::move(v_offests);
+}
+
+auto ScanResultCache::MakeKey(const fs::path& module_path, uint64_t pattern_hash) -> std::wstring
+{
+	wchar_t v_hash_hex[17] = { 0 };
+	swprintf_s(v_hash_hex, L"%016llx", pattern_hash);
+
+	//the version lives in the entry stamp now, not in the key
+	return module_path.wstring() + L"|" + v_hash_hex;
+}
+
+auto ScanResultCache::GetModuleStamp(const fs::path& module_path) -> uint64_t
+{
+	const auto v_cached = _versions_.find(module_path.wstring());
+	if (v_cached != _versions_.end())
+		return v_cached->second;
+
+	//the full version quadruple as one word, the store rejects entries
+	//recorded against any other build of the module
+	const auto v_tmp_version = bee::module_version::cached(module_path.wstring().c_str());
+	const auto v_stamp =
+		(static_cast<uint64_t>(v_tmp_version->fixed_file_info()->dwFileVersionMS) << 32)
+		| v_tmp_version->fixed_file_info()->dwFileVersionLS;
+
+	_versions_[module_path.wstring()] = v_stamp;
+	return v_stamp;
+}
+
+auto ScanResultCache::HashPattern(const std::vector<uint8_t>& pattern) -> uint64_t
+{
+	auto v_hash = k_fnv_offset;
+	for (const auto v_byte : pattern)
+	{
+		v_hash ^= v_byte;
+		v_hash *= k_fnv_prime;
+	}
+	return v_hash;
+}
+
+ScanResultCache& get_scan_result_cache()
+{
+	return base::singleton_atomic<ScanResultCache>::instance();
+}
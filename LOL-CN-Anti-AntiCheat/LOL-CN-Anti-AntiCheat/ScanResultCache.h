@@ -0,0 +1,68 @@
+#pragma once
+#include "framework.h"
+#include <atomic>
+#include <vector>
+
+#include <BlackBone/Patterns/PatternSearch.h>
+#include <BlackBone/Process/Process.h>
+#include <Telemetry.h>
+
+//Disk-backed pattern scan cache, a namespace in the unified cache store
+//key: module path + pattern hash, stamped with the module file version
+//value: match offsets relative to scan start, so ASLR does not invalidate entries
+class ScanResultCache
+{
+public:
+	ScanResultCache();
+	~ScanResultCache();
+
+	//Cache-aware remote scan, falls back to PatternSearch::SearchRemote on miss
+	size_t SearchRemote(
+		blackbone::Process& remote,
+		const fs::path& module_path,
+		const std::vector<uint8_t>& pattern,
+		blackbone::ptr_t scan_start,
+		size_t scan_size,
+		blackbone::vecScanResult& out);
+
+	//Drop every entry recorded for another version of the module
+	void InvalidateModule(const fs::path& module_path);
+
+	//Fault the cache store in ahead of the first SearchRemote
+	void Prefetch();
+
+	//Attach-path counters for the ready-state report
+	struct Stats
+	{
+		uint64_t _hits_;
+		uint64_t _misses_;
+		//Bytes covered by cold remote scans; warm attaches read nothing
+		uint64_t _remote_bytes_;
+	};
+	[[nodiscard]] auto GetStats() const -> Stats;
+
+private:
+	void Store(const std::wstring& key, uint64_t stamp, blackbone::ptr_t scan_start, const blackbone::vecScanResult& results);
+
+	[[nodiscard]] auto MakeKey(const fs::path& module_path, uint64_t pattern_hash) -> std::wstring;
+	[[nodiscard]] auto GetModuleStamp(const fs::path& module_path) -> uint64_t;
+
+	static auto HashPattern(const std::vector<uint8_t>& pattern) -> uint64_t;
+
+private:
+	//key -> relative match offsets, memo of this process's store lookups
+	std::unordered_map<std::wstring, std::vector<uint64_t>> _results_;
+	//module path -> version stamp, bee::module_version is not cheap
+	std::unordered_map<std::wstring, uint64_t> _versions_;
+
+	std::atomic<uint64_t> _hit_count_{};
+	std::atomic<uint64_t> _miss_count_{};
+	std::atomic<uint64_t> _remote_bytes_{};
+
+	//Externally sampled mirrors of the counters above
+	Telemetry::Counter _tm_hits_;
+	Telemetry::Counter _tm_misses_;
+	Telemetry::Counter _tm_remote_bytes_;
+};
+
+ScanResultCache& get_scan_result_cache();
@@ -0,0 +1,71 @@
+#include <SharedSymbolCache.h>
+#include <utility/singleton.h>
+
+#include <BlackBone/Symbols/SymbolData.h>
+
+namespace
+{
+	//Segment layout, written once by the publisher then read-only
+	struct shared_symbol_block
+	{
+		volatile long ready;
+		blackbone::SymbolData data;
+	};
+}
+
+SharedSymbolCache::SharedSymbolCache()
+= default;
+
+
+SharedSymbolCache::~SharedSymbolCache()
+= default;
+
+void SharedSymbolCache::Acquire()
+{
+	const auto v_name = MakeSegmentName();
+	_segment_ = std::make_unique<bee::win::subprocess::sharedmemory>(
+		bee::win::subprocess::open_or_create, v_name.c_str(), sizeof(shared_symbol_block));
+
+	if (!_segment_->ok())
+	{
+		//No segment, resolve in-process as before
+		blackbone::Symbols();
+		return;
+	}
+
+	const auto v_block = reinterpret_cast<shared_symbol_block*>(_segment_->data());
+
+	//Later instance: the set is already published, zero symbol work
+	if (InterlockedCompareExchange(&v_block->ready, 0, 0) != 0)
+	{
+		blackbone::SetSymbols(v_block->data);
+		_adopted_ = true;
+		return;
+	}
+
+	//First instance: resolve, then publish behind the ready flag.
+	//A racing instance at worst resolves too and publishes the same set
+	v_block->data = blackbone::Symbols();
+	InterlockedExchange(&v_block->ready, 1);
+}
+
+auto SharedSymbolCache::MakeSegmentName() const -> std::wstring
+{
+	//Keyed by the ntdll PE timestamp so a Windows update changes the name
+	uint32_t v_stamp = 0;
+	if (const auto v_base = reinterpret_cast<const uint8_t*>(GetModuleHandleW(L"ntdll.dll")))
+	{
+		const auto v_dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(v_base);
+		const auto v_nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(v_base + v_dos->e_lfanew);
+		v_stamp = v_nt->FileHeader.TimeDateStamp;
+	}
+
+	wchar_t v_name[64] = { 0 };
+	swprintf_s(v_name, L"Local\\LOL_CN_Symbols_%08X", v_stamp);
+	return v_name;
+}
+
+SharedSymbolCache& get_shared_symbol_cache()
+{
+	return base::singleton_atomic<SharedSymbolCache>::instance();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "framework.h"
+#include <memory>
+
+#include <bee/subprocess/sharedmemory_win.h>
+
+//Cross-process symbol segment: the first injected instance resolves the
+//ntdll symbol set and publishes it, later instances map the segment and
+//adopt the set without any symbol work
+class SharedSymbolCache
+{
+public:
+	SharedSymbolCache();
+	~SharedSymbolCache();
+
+	//Adopt the published set, or resolve and publish it for the others
+	void Acquire();
+
+	//true when Acquire adopted a published set instead of resolving
+	[[nodiscard]] bool WasAdopted() const { return _adopted_; }
+
+private:
+	[[nodiscard]] auto MakeSegmentName() const -> std::wstring;
+
+private:
+	//keeps the section alive so later instances can still open it
+	std::unique_ptr<bee::win::subprocess::sharedmemory> _segment_;
+	bool _adopted_{};
+};
+
+SharedSymbolCache& get_shared_symbol_cache();
@@ -0,0 +1,100 @@
+#include <Telemetry.h>
+#include <utility/singleton.h>
+
+//Segment layout; header first so a reader can validate magic/version
+//before trusting any slot
+struct telemetry_block
+{
+	uint32_t _magic_;
+	uint32_t _version_;
+	//published with InterlockedExchange after the slot name is written,
+	//so a sampler only walks fully initialized slots
+	volatile long _counter_count_;
+	volatile long _histogram_count_;
+	Telemetry::counter_slot _counters_[Telemetry::k_max_counters];
+	Telemetry::histogram_slot _histograms_[Telemetry::k_max_histograms];
+};
+
+namespace
+{
+	constexpr uint32_t k_magic = 'MTCL';	//"LCTM"
+	constexpr uint32_t k_version = 1;
+}
+
+Telemetry::Telemetry()
+	: _block_(nullptr)
+{
+	const auto v_name = MakeSegmentName();
+	_segment_ = std::make_unique<bee::win::subprocess::sharedmemory>(
+		bee::win::subprocess::open_or_create, v_name.c_str(), sizeof(telemetry_block));
+	if (!_segment_->ok())
+		return;
+
+	//freshly created sections are zero pages, so the counts start at 0;
+	//stamp the header last
+	_block_ = reinterpret_cast<telemetry_block*>(_segment_->data());
+	_block_->_version_ = k_version;
+	InterlockedExchange(reinterpret_cast<volatile long*>(&_block_->_magic_), static_cast<long>(k_magic));
+}
+
+
+Telemetry::~Telemetry()
+= default;
+
+auto Telemetry::RegisterCounter(const char* name) -> Counter
+{
+	std::lock_guard<std::mutex> v_guard(_lock_);
+	if (_block_ == nullptr)
+		return Counter();
+
+	const auto v_count = _block_->_counter_count_;
+	for (long i = 0; i < v_count; ++i)
+	{
+		if (strncmp(_block_->_counters_[i]._name_, name, k_name_chars) == 0)
+			return Counter(&_block_->_counters_[i]._value_);
+	}
+
+	if (v_count >= static_cast<long>(k_max_counters))
+		return Counter();
+
+	auto& v_slot = _block_->_counters_[v_count];
+	strncpy_s(v_slot._name_, name, _TRUNCATE);
+	InterlockedExchange(&_block_->_counter_count_, v_count + 1);
+	return Counter(&v_slot._value_);
+}
+
+auto Telemetry::RegisterHistogram(const char* name) -> Histogram
+{
+	std::lock_guard<std::mutex> v_guard(_lock_);
+	if (_block_ == nullptr)
+		return Histogram();
+
+	const auto v_count = _block_->_histogram_count_;
+	for (long i = 0; i < v_count; ++i)
+	{
+		if (strncmp(_block_->_histograms_[i]._name_, name, k_name_chars) == 0)
+			return Histogram(&_block_->_histograms_[i]);
+	}
+
+	if (v_count >= static_cast<long>(k_max_histograms))
+		return Histogram();
+
+	auto& v_slot = _block_->_histograms_[v_count];
+	strncpy_s(v_slot._name_, name, _TRUNCATE);
+	InterlockedExchange(&_block_->_histogram_count_, v_count + 1);
+	return Histogram(&v_slot);
+}
+
+auto Telemetry::MakeSegmentName() const -> std::wstring
+{
+	//Per-pid, same scheme as the ready-state segment: the collector
+	//enumerates game processes and opens each
+	wchar_t v_name[64] = { 0 };
+	swprintf_s(v_name, L"Local\\LOL_CN_Telemetry_%08X", GetCurrentProcessId());
+	return v_name;
+}
+
+Telemetry& get_telemetry()
+{
+	return base::singleton_atomic<Telemetry>::instance();
+}
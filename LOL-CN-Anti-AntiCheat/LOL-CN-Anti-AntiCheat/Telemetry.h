@@ -0,0 +1,108 @@
+#pragma once
+#include "framework.h"
+#include <intrin.h>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <bee/subprocess/sharedmemory_win.h>
+
+//Shared-memory telemetry segment
+//fixed-slot named counters and log2 histograms in a per-pid section:
+//slots are registered by name at init, bumped with single interlocked
+//adds from hot paths, and sampled by the external helper process without
+//ever touching the game. Counts and sums only grow, so a sampler can
+//diff two reads for rates; the slot tables only grow too, so a reader
+//trusting _counter_count_ never sees a half-written name
+class Telemetry
+{
+public:
+	static constexpr size_t k_max_counters = 64;
+	static constexpr size_t k_max_histograms = 16;
+	static constexpr size_t k_histogram_buckets = 16;
+	static constexpr size_t k_name_chars = 32;
+
+	struct counter_slot
+	{
+		char _name_[k_name_chars];
+		volatile LONGLONG _value_;
+	};
+
+	//power-of-two buckets: bucket i counts values in [2^i, 2^(i+1)),
+	//the last bucket absorbs everything above
+	struct histogram_slot
+	{
+		char _name_[k_name_chars];
+		volatile LONGLONG _count_;
+		volatile LONGLONG _sum_;
+		volatile LONGLONG _buckets_[k_histogram_buckets];
+	};
+
+	//Handle to one registered counter; Add is one interlocked add on the
+	//mapped page. A handle that failed to register points at a
+	//process-local discard slot, so call sites never branch
+	class Counter
+	{
+	public:
+		Counter() = default;
+
+		void Add(const LONGLONG delta = 1) const noexcept
+		{
+			InterlockedExchangeAdd64(_cell_, delta);
+		}
+
+	private:
+		friend class Telemetry;
+		explicit Counter(volatile LONGLONG* cell) : _cell_(cell) {}
+
+		volatile LONGLONG* _cell_ = &s_discard_counter_._value_;
+	};
+
+	class Histogram
+	{
+	public:
+		Histogram() = default;
+
+		void Record(const uint64_t value) const noexcept
+		{
+			unsigned long v_bucket = 0;
+			_BitScanReverse64(&v_bucket, value | 1);
+			if (v_bucket >= k_histogram_buckets)
+				v_bucket = k_histogram_buckets - 1;
+
+			InterlockedExchangeAdd64(&_slot_->_buckets_[v_bucket], 1);
+			InterlockedExchangeAdd64(&_slot_->_sum_, static_cast<LONGLONG>(value));
+			InterlockedExchangeAdd64(&_slot_->_count_, 1);
+		}
+
+	private:
+		friend class Telemetry;
+		explicit Histogram(histogram_slot* slot) : _slot_(slot) {}
+
+		histogram_slot* _slot_ = &s_discard_histogram_;
+	};
+
+	Telemetry();
+	~Telemetry();
+
+	//Register a slot by name at init; the same name returns the same slot,
+	//a full table (or a failed segment) returns a discard handle
+	[[nodiscard]] auto RegisterCounter(const char* name) -> Counter;
+	[[nodiscard]] auto RegisterHistogram(const char* name) -> Histogram;
+
+private:
+	[[nodiscard]] auto MakeSegmentName() const -> std::wstring;
+
+private:
+	//fallback cells for unregistered handles, updates land here and are
+	//simply never read
+	inline static counter_slot s_discard_counter_ = {};
+	inline static histogram_slot s_discard_histogram_ = {};
+
+	std::mutex _lock_;
+	//keeps the section alive for external readers
+	std::unique_ptr<bee::win::subprocess::sharedmemory> _segment_;
+	struct telemetry_block* _block_;
+};
+
+Telemetry& get_telemetry();
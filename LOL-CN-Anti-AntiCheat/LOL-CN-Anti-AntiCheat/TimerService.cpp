@@ -0,0 +1,111 @@
+#include <TimerService.h>
+#include <utility/singleton.h>
+#include <utility/thread_governor.h>
+
+#include <algorithm>
+
+TimerService::TimerService()
+= default;
+
+TimerService::~TimerService()
+{
+	{
+		std::lock_guard<std::mutex> v_guard(_lock_);
+		_stop_ = true;
+	}
+	_cv_.notify_all();
+	if (_worker_.joinable())
+		_worker_.join();
+}
+
+auto TimerService::Register(const std::wstring& name, const unsigned period_ms, const unsigned slack_ms, std::function<void()> callback) -> int
+{
+	std::lock_guard<std::mutex> v_guard(_lock_);
+
+	task_entry v_task;
+	v_task._id_ = _next_id_++;
+	v_task._name_ = name;
+	v_task._period_ = std::chrono::milliseconds(period_ms);
+	v_task._slack_ = std::chrono::milliseconds(slack_ms);
+	v_task._due_ = std::chrono::steady_clock::now() + v_task._period_;
+	v_task._callback_ = std::move(callback);
+
+	const auto v_id = v_task._id_;
+	_tasks_.emplace_back(std::move(v_task));
+
+	EnsureWorker();
+	_cv_.notify_all();
+	return v_id;
+}
+
+void TimerService::Unregister(const int id)
+{
+	std::lock_guard<std::mutex> v_guard(_lock_);
+	for (auto v_it = _tasks_.begin(); v_it != _tasks_.end(); ++v_it)
+	{
+		if (v_it->_id_ == id)
+		{
+			_tasks_.erase(v_it);
+			break;
+		}
+	}
+	_cv_.notify_all();
+}
+
+void TimerService::EnsureWorker()
+{
+	if (!_worker_.joinable())
+		_worker_ = std::thread(&TimerService::WorkerLoop, this);
+}
+
+void TimerService::WorkerLoop()
+{
+	//Stay off the cores the game hammers: the governor applies lowest
+	//priority plus the process-wide placement policy, and keeps this
+	//thread enrolled in frame-time backoff
+	base::shared_thread_governor().register_current_thread(THREAD_PRIORITY_LOWEST);
+
+	std::unique_lock<std::mutex> v_guard(_lock_);
+	while (!_stop_)
+	{
+		if (_tasks_.empty())
+		{
+			_cv_.wait(v_guard);
+			continue;
+		}
+
+		const auto v_next = std::min_element(_tasks_.begin(), _tasks_.end(),
+			[](const task_entry& lhs, const task_entry& rhs) { return lhs._due_ < rhs._due_; })->_due_;
+		_cv_.wait_until(v_guard, v_next);
+		if (_stop_)
+			break;
+
+		//One wake runs everything due now or inside its slack window, so
+		//tasks with compatible cadences share the wake instead of each
+		//costing a context switch
+		const auto v_now = std::chrono::steady_clock::now();
+		std::vector<std::function<void()>> v_batch;
+		for (auto& v_task : _tasks_)
+		{
+			if (v_task._due_ <= v_now + v_task._slack_)
+			{
+				v_batch.emplace_back(v_task._callback_);
+				v_task._due_ = v_now + v_task._period_;
+			}
+		}
+
+		if (v_batch.empty())
+			continue;
+
+		//Callbacks run unlocked so they may register and unregister
+		v_guard.unlock();
+		for (const auto& v_run : v_batch)
+			v_run();
+		v_guard.lock();
+	}
+}
+
+TimerService& get_timer_service()
+{
+	return base::singleton_atomic<TimerService>::instance();
+}
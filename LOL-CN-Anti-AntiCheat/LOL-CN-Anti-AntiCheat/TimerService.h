@@ -0,0 +1,52 @@
+#pragma once
+#include "framework.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Coalesced timer service
+//one low-priority worker replaces per-subsystem polling threads:
+//registrants declare a period and a slack window, work due inside the
+//same wake runs as one batch, and the worker is pinned to the highest
+//core to stay off the ones the game hammers
+class TimerService
+{
+public:
+	TimerService();
+	~TimerService();
+
+	//Returns a handle for Unregister. period is the cadence; slack is how
+	//early the task may run so it can share a wake with its neighbours
+	auto Register(const std::wstring& name, unsigned period_ms, unsigned slack_ms, std::function<void()> callback) -> int;
+	void Unregister(int id);
+
+private:
+	struct task_entry
+	{
+		int _id_;
+		//diagnostic label, shows up when a callback misbehaves in a dump
+		std::wstring _name_;
+		std::chrono::milliseconds _period_;
+		std::chrono::milliseconds _slack_;
+		std::chrono::steady_clock::time_point _due_;
+		std::function<void()> _callback_;
+	};
+
+	void WorkerLoop();
+	//Starts the worker on first registration, under _lock_
+	void EnsureWorker();
+
+private:
+	std::mutex _lock_;
+	std::condition_variable _cv_;
+	std::vector<task_entry> _tasks_;
+	std::thread _worker_;
+	bool _stop_{};
+	int _next_id_{ 1 };
+};
+
+TimerService& get_timer_service();
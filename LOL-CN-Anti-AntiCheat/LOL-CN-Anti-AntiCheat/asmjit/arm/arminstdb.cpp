@@ -9,6 +9,7 @@
 #include "../core/build.h"
 #ifdef ASMJIT_BUILD_ARM
 
+#include "../core/osutils.h"
 #include "../core/support.h"
 #include "../arm/arminstdb.h"
 #include "../arm/armoperand.h"
@@ -604,6 +605,49 @@ static const InstNameAZ ArmInstNameAZ[26] = {
 // ----------------------------------------------------------------------------
 // ${nameData:End}
 
+// Hash index over the frozen instruction-name table. The table maps a name
+// hash to `instructionId + 1` via open addressing with linear probing, zero
+// means an empty slot. It's built once on the first `idByName()` query and
+// turns every query after that into a few array loads instead of a per-prefix
+// binary search over `instData`.
+enum : uint32_t {
+  // Power of two, more than twice `ArmInst::_kIdCount`, so the load factor
+  // stays below 0.5 and probe sequences are short.
+  kArmInstNameHashSize = 1024
+};
+
+static uint16_t ArmInstNameHashData[kArmInstNameHashSize];
+static volatile uint32_t ArmInstNameHashReady;
+static Lock ArmInstNameHashLock;
+
+static ASMJIT_INLINE uint32_t ArmInst_hashName(const char* name, size_t size) noexcept {
+  // FNV-1a.
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; i++)
+    hash = (hash ^ uint8_t(name[i])) * 16777619u;
+  return hash;
+}
+
+static ASMJIT_NOINLINE void ArmInst_buildNameHash() noexcept {
+  ScopedLock locked(ArmInstNameHashLock);
+  if (ArmInstNameHashReady)
+    return;
+
+  const char* nameData = ArmInstDB::nameData;
+  const ArmInst* instData = ArmInstDB::instData;
+
+  for (uint32_t id = 1; id < ArmInst::_kIdCount; id++) {
+    const char* instName = nameData + instData[id]._nameDataIndex;
+    uint32_t slot = ArmInst_hashName(instName, ::strlen(instName)) & (kArmInstNameHashSize - 1);
+
+    while (ArmInstNameHashData[slot])
+      slot = (slot + 1) & (kArmInstNameHashSize - 1);
+    ArmInstNameHashData[slot] = uint16_t(id + 1);
+  }
+
+  ArmInstNameHashReady = 1;
+}
+
 uint32_t ArmInst::idByName(const char* name, size_t size) noexcept {
   if (ASMJIT_UNLIKELY(!name))
     return Globals::kInvalidInstId;
@@ -614,34 +658,20 @@ uint32_t ArmInst::idByName(const char* name, size_t size) noexcept {
   if (ASMJIT_UNLIKELY(size == 0 || size > kArmInstMaxSize))
     return Globals::kInvalidInstId;
 
-  uint32_t prefix = uint32_t(name[0]) - kArmInstAlphaIndexFirst;
-  if (ASMJIT_UNLIKELY(prefix > kArmInstAlphaIndexLast - kArmInstAlphaIndexFirst))
-    return Globals::kInvalidInstId;
-
-  uint32_t index = ArmInstNameAZ[prefix].start;
-  if (ASMJIT_UNLIKELY(!index))
-    return Globals::kInvalidInstId;
+  if (ASMJIT_UNLIKELY(!ArmInstNameHashReady))
+    ArmInst_buildNameHash();
 
   const char* nameData = ArmInstDB::nameData;
   const ArmInst* instData = ArmInstDB::instData;
 
-  const ArmInst* base = instData + index;
-  const ArmInst* end  = instData + ArmInstNameAZ[prefix].end;
-
-  for (size_t lim = (size_t)(end - base); lim != 0; lim >>= 1) {
-    const ArmInst* cur = base + (lim >> 1);
-    int result = Support::cmpInstName(nameData + cur[0]._nameDataIndex, name, size);
-
-    if (result < 0) {
-      base = cur + 1;
-      lim--;
-      continue;
-    }
-
-    if (result > 0)
-      continue;
+  uint32_t slot = ArmInst_hashName(name, size) & (kArmInstNameHashSize - 1);
+  uint32_t stored;
 
-    return uint32_t((size_t)(cur - instData));
+  while ((stored = ArmInstNameHashData[slot]) != 0) {
+    uint32_t id = stored - 1;
+    if (Support::cmpInstName(nameData + instData[id]._nameDataIndex, name, size) == 0)
+      return id;
+    slot = (slot + 1) & (kArmInstNameHashSize - 1);
   }
 
   return Globals::kInvalidInst;
@@ -49,6 +49,7 @@ BaseBuilder::BaseBuilder() noexcept
     _cursor(nullptr),
     _firstNode(nullptr),
     _lastNode(nullptr),
+    _passthrough(nullptr),
     _nodeFlags(0) {}
 BaseBuilder::~BaseBuilder() noexcept {}
 
@@ -621,7 +622,41 @@ Error BaseBuilder::runPasses() {
 // [asmjit::BaseBuilder - Emit]
 // ============================================================================
 
+//! Forwards the pending per-instruction state and the instruction itself to
+//! the passthrough emitter, bypassing node allocation entirely.
+static ASMJIT_INLINE Error BaseBuilder_passthroughEmit(BaseBuilder* self, uint32_t instId, const Operand_& o0, const Operand_& o1, const Operand_& o2, const Operand_& o3) {
+  BaseEmitter* dst = self->_passthrough;
+
+  dst->setInstOptions(self->instOptions());
+  dst->setExtraReg(self->extraReg());
+  dst->setInlineComment(self->inlineComment());
+
+  self->resetInstOptions();
+  self->resetExtraReg();
+  self->resetInlineComment();
+
+  return dst->_emit(instId, o0, o1, o2, o3);
+}
+
+//! \overload
+static ASMJIT_INLINE Error BaseBuilder_passthroughEmit(BaseBuilder* self, uint32_t instId, const Operand_& o0, const Operand_& o1, const Operand_& o2, const Operand_& o3, const Operand_& o4, const Operand_& o5) {
+  BaseEmitter* dst = self->_passthrough;
+
+  dst->setInstOptions(self->instOptions());
+  dst->setExtraReg(self->extraReg());
+  dst->setInlineComment(self->inlineComment());
+
+  self->resetInstOptions();
+  self->resetExtraReg();
+  self->resetInlineComment();
+
+  return dst->_emit(instId, o0, o1, o2, o3, o4, o5);
+}
+
 Error BaseBuilder::_emit(uint32_t instId, const Operand_& o0, const Operand_& o1, const Operand_& o2, const Operand_& o3) {
+  if (_passthrough)
+    return BaseBuilder_passthroughEmit(this, instId, o0, o1, o2, o3);
+
   uint32_t opCount = 4;
 
   if (o3.isNone()) {
@@ -698,6 +733,9 @@ Error BaseBuilder::_emit(uint32_t instId, const Operand_& o0, const Operand_& o1
 }
 
 Error BaseBuilder::_emit(uint32_t instId, const Operand_& o0, const Operand_& o1, const Operand_& o2, const Operand_& o3, const Operand_& o4, const Operand_& o5) {
+  if (_passthrough)
+    return BaseBuilder_passthroughEmit(this, instId, o0, o1, o2, o3, o4, o5);
+
   uint32_t opCount = Globals::kMaxOpCount;
   if (o5.isNone()) {
     opCount = 5;
@@ -777,6 +815,9 @@ Error BaseBuilder::align(uint32_t alignMode, uint32_t alignment) {
   if (ASMJIT_UNLIKELY(!_code))
     return DebugUtils::errored(kErrorNotInitialized);
 
+  if (_passthrough)
+    return _passthrough->align(alignMode, alignment);
+
   AlignNode* node = newAlignNode(alignMode, alignment);
   if (ASMJIT_UNLIKELY(!node))
     return reportError(DebugUtils::errored(kErrorOutOfMemory));
@@ -793,6 +834,9 @@ Error BaseBuilder::embed(const void* data, uint32_t size) {
   if (ASMJIT_UNLIKELY(!_code))
     return DebugUtils::errored(kErrorNotInitialized);
 
+  if (_passthrough)
+    return _passthrough->embed(data, size);
+
   EmbedDataNode* node = newEmbedDataNode(data, size);
   if (ASMJIT_UNLIKELY(!node))
     return reportError(DebugUtils::errored(kErrorOutOfMemory));
@@ -840,6 +884,9 @@ Error BaseBuilder::comment(const char* data, size_t size) {
   if (ASMJIT_UNLIKELY(!_code))
     return DebugUtils::errored(kErrorNotInitialized);
 
+  if (_passthrough)
+    return _passthrough->comment(data, size);
+
   CommentNode* node = newCommentNode(data, size);
   if (ASMJIT_UNLIKELY(!node))
     return reportError(DebugUtils::errored(kErrorOutOfMemory));
@@ -901,6 +948,25 @@ Error BaseBuilder::serialize(BaseEmitter* dst) {
   return err;
 }
 
+// ============================================================================
+// [asmjit::BaseBuilder - Passthrough]
+// ============================================================================
+
+Error BaseBuilder::setPassthrough(BaseEmitter* dst) noexcept {
+  if (ASMJIT_UNLIKELY(!dst || dst == this))
+    return DebugUtils::errored(kErrorInvalidArgument);
+
+  if (ASMJIT_UNLIKELY(!dst->isInitialized()))
+    return DebugUtils::errored(kErrorNotInitialized);
+
+  _passthrough = dst;
+  return kErrorOk;
+}
+
+void BaseBuilder::resetPassthrough() noexcept {
+  _passthrough = nullptr;
+}
+
 // ============================================================================
 // [asmjit::BaseBuilder - Logging]
 // ============================================================================
@@ -960,6 +1026,7 @@ Error BaseBuilder::onDetach(CodeHolder* code) noexcept {
   _cursor = nullptr;
   _firstNode = nullptr;
   _lastNode = nullptr;
+  _passthrough = nullptr;
 
   return Base::onDetach(code);
 }
@@ -283,6 +283,31 @@ public:
   //! nodes held by Builder/Compiler into another Builder-like emitter.
   ASMJIT_API Error serialize(BaseEmitter* dst);
 
+  // --------------------------------------------------------------------------
+  // [Passthrough]
+  // --------------------------------------------------------------------------
+
+  //! Gets the passthrough emitter, null if passthrough mode is disabled.
+  inline BaseEmitter* passthroughEmitter() const noexcept { return _passthrough; }
+  //! Gets whether instructions are forwarded directly to another emitter.
+  inline bool isPassthroughEnabled() const noexcept { return _passthrough != nullptr; }
+
+  //! Enables passthrough mode, forwarding emitted code directly to `dst`.
+  //!
+  //! By calling this the caller declares that the code it's about to emit is
+  //! a single basic block - straight-line instructions, data, and alignment
+  //! only. While the mode is active `_emit()`, `align()`, `embed()`, and
+  //! `comment()` go straight to `dst` (most probably an Assembler attached to
+  //! the same `CodeHolder`): no node is allocated, nothing is appended to the
+  //! node list, and no `Pass` will ever see the code, so `serialize()` and
+  //! `runPasses()` are unnecessary for it. Labels and other node-based
+  //! constructs must not be used while the mode is active.
+  //!
+  //! Useful for small stubs where node management costs more than encoding.
+  ASMJIT_API Error setPassthrough(BaseEmitter* dst) noexcept;
+  //! Disables passthrough mode.
+  ASMJIT_API void resetPassthrough() noexcept;
+
   // --------------------------------------------------------------------------
   // [Logging]
   // --------------------------------------------------------------------------
@@ -325,6 +350,9 @@ public:
   //! Last node of the current section.
   BaseNode* _lastNode;
 
+  //! Passthrough target, null if passthrough mode is disabled.
+  BaseEmitter* _passthrough;
+
   //! Flags assigned to each new node.
   uint32_t _nodeFlags;
   //! The sections links are dirty (used internally).
@@ -1019,4 +1019,118 @@ Error CodeHolder::copyFlattenedData(void* dst, size_t dstSize, uint32_t options)
   return kErrorOk;
 }
 
+Error CodeHolder::finalizeBatch(BatchEntry* entries, size_t count, void* dst, size_t dstSize, uint64_t slabBase, uint32_t alignment, size_t* sizeOut) noexcept {
+  if (sizeOut)
+    *sizeOut = 0;
+
+  if (ASMJIT_UNLIKELY(alignment != 0 && !Support::isPowerOf2(alignment)))
+    return DebugUtils::errored(kErrorInvalidArgument);
+
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    CodeHolder* code = entries[i].code;
+    if (ASMJIT_UNLIKELY(!code))
+      return DebugUtils::errored(kErrorInvalidArgument);
+
+    ASMJIT_PROPAGATE(code->flatten());
+    ASMJIT_PROPAGATE(code->resolveUnresolvedLinks());
+
+    if (alignment)
+      offset = Support::alignUp(offset, alignment);
+
+    if (ASMJIT_UNLIKELY(offset > dstSize))
+      return DebugUtils::errored(kErrorTooLarge);
+
+    ASMJIT_PROPAGATE(code->relocateToBase(slabBase + offset));
+
+    // Relocation can shrink the code in case some relocations didn't require
+    // records in an address table, so query the final size only afterwards.
+    size_t codeSize = code->codeSize();
+    if (ASMJIT_UNLIKELY(codeSize > dstSize - offset))
+      return DebugUtils::errored(kErrorTooLarge);
+
+    ASMJIT_PROPAGATE(code->copyFlattenedData(static_cast<uint8_t*>(dst) + offset, codeSize, kCopyWithPadding));
+
+    entries[i].offset = offset;
+    entries[i].size = codeSize;
+    offset += codeSize;
+  }
+
+  if (sizeOut)
+    *sizeOut = offset;
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::CodeHolderPool - Construction / Destruction]
+// ============================================================================
+
+static void CodeHolderPool_destroyHolder(CodeHolder* code) noexcept {
+  code->~CodeHolder();
+  ::free(code);
+}
+
+CodeHolderPool::CodeHolderPool() noexcept
+  : _lock(),
+    _count(0) {}
+
+CodeHolderPool::~CodeHolderPool() noexcept {
+  reset();
+}
+
+// ============================================================================
+// [asmjit::CodeHolderPool - Acquire / Release]
+// ============================================================================
+
+CodeHolder* CodeHolderPool::acquire(const CodeInfo& info) noexcept {
+  CodeHolder* code = nullptr;
+
+  {
+    ScopedLock locked(_lock);
+    if (_count)
+      code = _holders[--_count];
+  }
+
+  if (!code) {
+    void* p = ::malloc(sizeof(CodeHolder));
+    if (ASMJIT_UNLIKELY(!p))
+      return nullptr;
+    code = new(p) CodeHolder();
+  }
+
+  // A parked holder was soft-reset, so `init()` only rebuilds the text
+  // section inside the zone block it already owns.
+  if (ASMJIT_UNLIKELY(code->init(info) != kErrorOk)) {
+    CodeHolderPool_destroyHolder(code);
+    return nullptr;
+  }
+
+  return code;
+}
+
+void CodeHolderPool::release(CodeHolder* code) noexcept {
+  if (ASMJIT_UNLIKELY(!code))
+    return;
+
+  // Keeps the first zone block and the allocator's free lists alive.
+  code->reset(Globals::kResetSoft);
+
+  {
+    ScopedLock locked(_lock);
+    if (_count < kPoolCapacity) {
+      _holders[_count++] = code;
+      return;
+    }
+  }
+
+  CodeHolderPool_destroyHolder(code);
+}
+
+void CodeHolderPool::reset() noexcept {
+  ScopedLock locked(_lock);
+  while (_count)
+    CodeHolderPool_destroyHolder(_holders[--_count]);
+}
+
 ASMJIT_END_NAMESPACE
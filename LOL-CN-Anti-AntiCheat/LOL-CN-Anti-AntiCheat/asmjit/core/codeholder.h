@@ -10,6 +10,7 @@
 #include "../core/arch.h"
 #include "../core/datatypes.h"
 #include "../core/operand.h"
+#include "../core/osutils.h"
 #include "../core/string.h"
 #include "../core/support.h"
 #include "../core/target.h"
@@ -769,6 +770,33 @@ public:
   //! never write anything outside the providede buffer.
   ASMJIT_API Error copyFlattenedData(void* dst, size_t dstSize, uint32_t options = 0) noexcept;
 
+  //! A single unit of a \ref finalizeBatch() call.
+  struct BatchEntry {
+    //! CodeHolder to finalize (input), must contain generated code.
+    CodeHolder* code;
+    //! Offset of the holder's code within the slab (output).
+    size_t offset;
+    //! Final size of the holder's code (output).
+    size_t size;
+  };
+
+  //! Finalizes a group of CodeHolders into a single target slab in one pass.
+  //!
+  //! Flattens each holder in `entries`, resolves its unresolved links,
+  //! relocates it against `slabBase`, and copies the finalized code into
+  //! `dst`, packing entries one after another aligned to `alignment` bytes
+  //! (zero or a power of 2, zero meaning no padding). On success each
+  //! entry's `offset` and `size` are filled and `*sizeOut`, if provided,
+  //! receives the total number of bytes used.
+  //!
+  //! `slabBase` is the absolute address the slab will be executed from;
+  //! pass `(uint64_t)(uintptr_t)dst` when the slab executes in place.
+  //!
+  //! NOTE: Flattening and relocation mutate each holder, so a failed batch
+  //! leaves the holders processed so far finalized - discard the slab and
+  //! reset the holders before retrying.
+  ASMJIT_API static Error finalizeBatch(BatchEntry* entries, size_t count, void* dst, size_t dstSize, uint64_t slabBase, uint32_t alignment = 0, size_t* sizeOut = nullptr) noexcept;
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -807,6 +835,56 @@ public:
   ZoneTree<AddressTableEntry> _addressTableEntries;
 };
 
+// ============================================================================
+// [asmjit::CodeHolderPool]
+// ============================================================================
+
+//! Recycles `CodeHolder` instances across code-generation requests.
+//!
+//! Each `acquire()` returns a holder already initialized for the given
+//! `CodeInfo`; `release()` soft-resets it (`Globals::kResetSoft`, which keeps
+//! the zone's first block and the allocator state) and parks it for the next
+//! request. For workloads that emit many small code blobs back to back this
+//! turns the per-request section/zone setup into an O(1) reuse.
+//!
+//! The pool is thread-safe; holders it hands out are not (same rules as a
+//! plain `CodeHolder`).
+class CodeHolderPool {
+public:
+  ASMJIT_NONCOPYABLE(CodeHolderPool)
+
+  //! Creates an empty pool.
+  ASMJIT_API CodeHolderPool() noexcept;
+  //! Destroys the pool, freeing all parked holders.
+  ASMJIT_API ~CodeHolderPool() noexcept;
+
+  //! Returns a holder initialized for `info`, reusing a parked one if possible.
+  //!
+  //! Returns null on allocation or `init()` failure.
+  ASMJIT_API CodeHolder* acquire(const CodeInfo& info) noexcept;
+  //! Soft-resets `code` and parks it for reuse (frees it if the pool is full).
+  ASMJIT_API void release(CodeHolder* code) noexcept;
+
+  //! Frees all parked holders and their retained memory.
+  ASMJIT_API void reset() noexcept;
+
+  //! Gets the number of holders currently parked in the pool.
+  inline size_t pooledCount() const noexcept { return _count; }
+
+private:
+  enum : uint32_t {
+    //! Maximum number of parked holders; `release()` frees the rest.
+    kPoolCapacity = 16
+  };
+
+  //! Guards `_holders` / `_count`.
+  Lock _lock;
+  //! Number of parked holders.
+  size_t _count;
+  //! Parked holders, ready to be re-initialized.
+  CodeHolder* _holders[kPoolCapacity];
+};
+
 //! \}
 
 ASMJIT_END_NAMESPACE
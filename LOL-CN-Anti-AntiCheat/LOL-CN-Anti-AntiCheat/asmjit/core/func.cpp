@@ -102,6 +102,84 @@ ASMJIT_FAVOR_SIZE Error FuncFrame::finalize() noexcept {
   return DebugUtils::errored(kErrorInvalidArgument);
 }
 
+// ============================================================================
+// [asmjit::FuncLayoutCache]
+// ============================================================================
+
+static ASMJIT_INLINE uint32_t FuncLayoutCache_hashSignature(const FuncSignature& sign) noexcept {
+  // FNV-1a over the signature shape.
+  uint32_t hash = 2166136261u;
+  hash = (hash ^ sign.callConv()) * 16777619u;
+  hash = (hash ^ sign.vaIndex()) * 16777619u;
+  hash = (hash ^ sign.ret()) * 16777619u;
+
+  uint32_t argCount = sign.argCount();
+  const uint8_t* args = sign.args();
+
+  hash = (hash ^ argCount) * 16777619u;
+  for (uint32_t i = 0; i < argCount; i++)
+    hash = (hash ^ args[i]) * 16777619u;
+  return hash;
+}
+
+FuncLayoutCache::FuncLayoutCache() noexcept
+  : _lock() {
+  ::memset(_entries, 0, sizeof(_entries));
+}
+
+Error FuncLayoutCache::init(FuncDetail& detail, const FuncSignature& sign) noexcept {
+  FuncFrame frame;
+  return init(detail, frame, sign);
+}
+
+Error FuncLayoutCache::init(FuncDetail& detail, FuncFrame& frame, const FuncSignature& sign) noexcept {
+  uint32_t argCount = sign.argCount();
+  if (ASMJIT_UNLIKELY(argCount > Globals::kMaxFuncArgs))
+    return DebugUtils::errored(kErrorInvalidArgument);
+
+  uint32_t hash = FuncLayoutCache_hashSignature(sign);
+  Entry& entry = _entries[hash % kCacheSize];
+
+  {
+    ScopedLock locked(_lock);
+    if (entry.used &&
+        entry.hash == hash &&
+        entry.callConv == sign.callConv() &&
+        entry.vaIndex == sign.vaIndex() &&
+        entry.ret == sign.ret() &&
+        entry.argCount == argCount &&
+        (argCount == 0 || ::memcmp(entry.argTypes, sign.args(), argCount) == 0)) {
+      detail = entry.detail;
+      frame = entry.frame;
+      return kErrorOk;
+    }
+  }
+
+  ASMJIT_PROPAGATE(detail.init(sign));
+  ASMJIT_PROPAGATE(frame.init(detail));
+
+  {
+    ScopedLock locked(_lock);
+    entry.hash = hash;
+    entry.used = 1;
+    entry.callConv = uint8_t(sign.callConv());
+    entry.vaIndex = uint8_t(sign.vaIndex());
+    entry.ret = uint8_t(sign.ret());
+    entry.argCount = uint8_t(argCount);
+    if (argCount)
+      ::memcpy(entry.argTypes, sign.args(), argCount);
+    entry.detail = detail;
+    entry.frame = frame;
+  }
+
+  return kErrorOk;
+}
+
+void FuncLayoutCache::reset() noexcept {
+  ScopedLock locked(_lock);
+  ::memset(_entries, 0, sizeof(_entries));
+}
+
 // ============================================================================
 // [asmjit::FuncArgsAssignment]
 // ============================================================================
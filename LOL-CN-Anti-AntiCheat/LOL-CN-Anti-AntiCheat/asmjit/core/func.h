@@ -10,6 +10,7 @@
 #include "../core/arch.h"
 #include "../core/callconv.h"
 #include "../core/operand.h"
+#include "../core/osutils.h"
 #include "../core/type.h"
 #include "../core/support.h"
 
@@ -850,6 +851,62 @@ public:
   uint32_t _nonGpSaveOffset;
 };
 
+// ============================================================================
+// [asmjit::FuncLayoutCache]
+// ============================================================================
+
+//! Signature-keyed cache of computed function layouts.
+//!
+//! `FuncDetail::init()` and `FuncFrame::init()` recompute argument assignment
+//! and stack layout from scratch for every function, which is wasted work for
+//! code that emits many functions sharing a handful of signatures. The cache
+//! keys the computed `FuncDetail` / `FuncFrame` pair by the signature's
+//! (calling convention, return type, argument types) shape and copies it into
+//! the caller's objects on a hit, skipping the layout computation entirely.
+//!
+//! The cache is direct-mapped and thread-safe; a colliding signature simply
+//! replaces the previous occupant of its slot.
+class FuncLayoutCache {
+public:
+  ASMJIT_NONCOPYABLE(FuncLayoutCache)
+
+  //! Creates an empty cache.
+  ASMJIT_API FuncLayoutCache() noexcept;
+
+  //! Initializes `detail` for `sign`, reusing a cached layout if possible.
+  ASMJIT_API Error init(FuncDetail& detail, const FuncSignature& sign) noexcept;
+  //! Initializes both `detail` and the initial (non-finalized) `frame` for
+  //! `sign`, reusing a cached layout if possible.
+  ASMJIT_API Error init(FuncDetail& detail, FuncFrame& frame, const FuncSignature& sign) noexcept;
+
+  //! Evicts all cached layouts.
+  ASMJIT_API void reset() noexcept;
+
+private:
+  //! One cached layout, valid if `used` is non-zero.
+  struct Entry {
+    uint32_t hash;
+    uint8_t used;
+    uint8_t callConv;
+    uint8_t vaIndex;
+    uint8_t ret;
+    uint8_t argCount;
+    uint8_t argTypes[Globals::kMaxFuncArgs];
+    FuncDetail detail;
+    FuncFrame frame;
+  };
+
+  enum : uint32_t {
+    //! Number of direct-mapped slots; stub generation uses few signatures.
+    kCacheSize = 16
+  };
+
+  //! Guards `_entries`.
+  Lock _lock;
+  //! Direct-mapped entries.
+  Entry _entries[kCacheSize];
+};
+
 // ============================================================================
 // [asmjit::FuncArgsAssignment]
 // ============================================================================
@@ -303,6 +303,11 @@ public:
   JitAllocatorPool* pools;
   //! Number of allocator pools.
   size_t poolCount;
+
+  //! Cumulative count of successful allocations.
+  uint64_t allocationCount = 0;
+  //! Cumulative count of successful releases.
+  uint64_t releaseCount = 0;
 };
 
 static const JitAllocator::Impl JitAllocatorImpl_none {};
@@ -320,6 +325,7 @@ static inline JitAllocatorPrivateImpl* JitAllocatorImpl_new(const JitAllocator::
 
   uint32_t options = params->options;
   uint32_t blockSize = params->blockSize;
+  uint32_t maxBlockSize = params->maxBlockSize;
   uint32_t granularity = params->granularity;
   uint32_t fillPattern = params->fillPattern;
 
@@ -332,6 +338,10 @@ static inline JitAllocatorPrivateImpl* JitAllocatorImpl_new(const JitAllocator::
   if (blockSize < 64 * 1024 || blockSize > 256 * 1024 * 1024 || !Support::isPowerOf2(blockSize))
     blockSize = vmInfo.pageGranularity;
 
+  // Setup the block growth cap [blockSize..256MB].
+  if (maxBlockSize < blockSize || maxBlockSize > 256 * 1024 * 1024 || !Support::isPowerOf2(maxBlockSize))
+    maxBlockSize = kJitAllocatorMaxBlockSize;
+
   // Setup granularity [64..256].
   if (granularity < 64 || granularity > 256 || !Support::isPowerOf2(granularity))
     granularity = kJitAllocatorBaseGranularity;
@@ -350,6 +360,7 @@ static inline JitAllocatorPrivateImpl* JitAllocatorImpl_new(const JitAllocator::
 
   impl->options = options;
   impl->blockSize = blockSize;
+  impl->maxBlockSize = maxBlockSize;
   impl->granularity = granularity;
   impl->fillPattern = fillPattern;
   impl->pageSize = vmInfo.pageSize;
@@ -388,7 +399,7 @@ static inline size_t JitAllocatorImpl_calculateIdealBlockSize(JitAllocatorPrivat
   JitAllocatorBlock* last = pool->blocks.last();
   size_t blockSize = last ? last->blockSize : size_t(impl->blockSize);
 
-  if (blockSize < kJitAllocatorMaxBlockSize)
+  if (blockSize < impl->maxBlockSize)
     blockSize *= 2u;
 
   if (allocationSize > blockSize) {
@@ -611,6 +622,9 @@ JitAllocator::Statistics JitAllocator::statistics() const noexcept {
       statistics._usedSize     += size_t(pool.totalAreaUsed) * pool.granularity;
       statistics._overheadSize += size_t(pool.totalOverheadBytes);
     }
+
+    statistics._allocationCount = impl->allocationCount;
+    statistics._releaseCount = impl->releaseCount;
   }
 
   return statistics;
@@ -752,6 +766,7 @@ Error JitAllocator::alloc(void** roPtrOut, void** rwPtrOut, size_t size) noexcep
 
   *roPtrOut = block->roPtr() + offset;
   *rwPtrOut = block->rwPtr() + offset;
+  impl->allocationCount++;
   return kErrorOk;
 }
 
@@ -808,6 +823,7 @@ Error JitAllocator::release(void* ro) noexcept {
     }
   }
 
+  impl->releaseCount++;
   return kErrorOk;
 }
 
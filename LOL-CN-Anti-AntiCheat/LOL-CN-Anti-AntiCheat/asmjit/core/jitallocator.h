@@ -90,6 +90,8 @@ public:
     uint32_t options;
     //! Base block size (0 if the allocator is not initialized).
     uint32_t blockSize;
+    //! Maximum block size the geometric block growth is allowed to reach.
+    uint32_t maxBlockSize;
     //! Base granularity (0 if the allocator is not initialized).
     uint32_t granularity;
     //! A pattern that is used to fill unused memory if secure mode is enabled.
@@ -128,6 +130,18 @@ public:
     //! be used instead.
     uint32_t blockSize;
 
+    //! Maximum block size in bytes (default 16MB).
+    //!
+    //! Block sizes double with each newly allocated block of a pool until
+    //! they reach this cap. Workloads that allocate many small regions can
+    //! lower the cap to keep address space consumption predictable, while
+    //! heavy ones can raise it to reduce the block count.
+    //!
+    //! \remarks Must be a power of 2 equal or greater to `blockSize`. If the
+    //! input is not valid then the default maximum block size will be used
+    //! instead.
+    uint32_t maxBlockSize;
+
     //! Base granularity (and also natural alignment) of allocations in bytes
     //! (default 64).
     //!
@@ -173,6 +187,8 @@ public:
 
   //! Gets a base block size (a minimum size of block that the allocator would allocate).
   inline uint32_t blockSize() const noexcept { return _impl->blockSize; }
+  //! Gets the maximum block size the block growth is allowed to reach.
+  inline uint32_t maxBlockSize() const noexcept { return _impl->maxBlockSize; }
   //! Gets a base granularity of the allocator.
   inline uint32_t granularity() const noexcept { return _impl->granularity; }
   //! Gets a pattern that is used to fill unused memory if `kFlagUseFillPattern` is set.
@@ -208,6 +224,8 @@ public:
       _usedSize = 0;
       _reservedSize = 0;
       _overheadSize = 0;
+      _allocationCount = 0;
+      _releaseCount = 0;
     }
 
     //! Gets count of blocks managed by `JitAllocator`.
@@ -222,6 +240,13 @@ public:
     //! Gets the number of bytes the allocator needs to manage the allocated memory.
     inline size_t overheadSize() const noexcept { return _overheadSize; }
 
+    //! Gets the cumulative number of successful `alloc()` calls.
+    inline uint64_t allocationCount() const noexcept { return _allocationCount; }
+    //! Gets the cumulative number of successful `release()` calls.
+    inline uint64_t releaseCount() const noexcept { return _releaseCount; }
+    //! Gets the number of regions currently alive.
+    inline uint64_t liveCount() const noexcept { return _allocationCount - _releaseCount; }
+
     inline double usedSizeAsPercent() const noexcept {
       return (double(usedSize()) / (double(reservedSize()) + 1e-16)) * 100.0;
     }
@@ -242,6 +267,10 @@ public:
     size_t _reservedSize;
     //! Allocation overhead (in bytes) required to maintain all blocks.
     size_t _overheadSize;
+    //! Cumulative count of successful allocations.
+    uint64_t _allocationCount;
+    //! Cumulative count of successful releases.
+    uint64_t _releaseCount;
   };
 
   //! Gets JIT allocator statistics.
@@ -845,7 +845,14 @@ ASMJIT_FAVOR_SPEED Error RAPass::buildLiveness() noexcept {
   // Calculate IN/OUT of each block.
   // --------------------------------------------------------------------------
 
-  {
+  if (numReachableBlocks == 1) {
+    // A single reachable block has no predecessors, so the initial
+    // recalculation is already the fixed point - skip the work-list
+    // machinery entirely.
+    LiveOps::recalcInOut(_pov[0], numBitWords, true);
+    numVisits++;
+  }
+  else {
     ZoneStack<RABlock*> workList;
     ZoneBitVector workBits;
 
@@ -1077,7 +1084,36 @@ static void RAPass_dumpSpans(String& sb, uint32_t index, const LiveRegSpans& liv
   sb.appendChar('\n');
 }
 
+// Maximum number of virtual registers of a single-block function allocated
+// through the trivial fast path instead of global bin-packing.
+static constexpr uint32_t kRATrivialFuncWorkRegLimit = 16;
+
 Error RAPass::runGlobalAllocator() noexcept {
+  // Trivial functions - a single basic block with only a few virtual
+  // registers - have no cross-block live ranges to reconcile, so global
+  // bin-packing would only burn time sorting and unioning live spans. The
+  // local allocator resolves such blocks on its own; just propagate
+  // register-id hints (function arguments and precolored registers) to home
+  // ids so it still prefers them. This makes Compiler-generated stubs of
+  // this shape approach Assembler-path speed.
+  if (reachableBlockCount() == 1 && workRegCount() <= kRATrivialFuncWorkRegLimit) {
+    for (uint32_t group = 0; group < BaseReg::kGroupVirt; group++) {
+      uint32_t usedRegs = 0;
+      for (RAWorkReg* workReg : workRegs(group)) {
+        if (!workReg->hasHintRegId())
+          continue;
+
+        uint32_t physMask = Support::bitMask(workReg->hintRegId());
+        if ((_availableRegs[group] & physMask) && !(usedRegs & physMask)) {
+          workReg->setHomeRegId(workReg->hintRegId());
+          usedRegs |= physMask;
+        }
+      }
+    }
+
+    return kErrorOk;
+  }
+
   ASMJIT_PROPAGATE(initGlobalLiveSpans());
 
   for (uint32_t group = 0; group < BaseReg::kGroupVirt; group++) {
@@ -36,6 +36,7 @@ void Zone::_init(size_t blockSize, size_t blockAlignment, const Support::Tempora
   _blockSize = blockSize & kBlockSizeMask;
   _isTemporary = temporary != nullptr;
   _blockAlignmentShift = Support::ctz(blockAlignment) & kBlockAlignmentShiftMask;
+  _maxBlockSize = _blockSize;
 
   // Setup the first [temporary] block, if necessary.
   if (temporary) {
@@ -168,11 +169,53 @@ void* Zone::_alloc(size_t size, size_t alignment) noexcept {
     _end = end;
     _block = newBlock;
 
+    // Geometric growth - each new block doubles the default block size until
+    // the configured limit is reached (no-op unless `setMaxBlockSize()` was
+    // used, as the limit defaults to the block size itself).
+    if (_blockSize < _maxBlockSize)
+      _blockSize = Support::min<size_t>(size_t(_blockSize) * 2u, _maxBlockSize);
+
     ASMJIT_ASSERT(_ptr <= _end);
     return static_cast<void*>(ptr);
   }
 }
 
+// ============================================================================
+// [asmjit::Zone - Statistics]
+// ============================================================================
+
+Zone::Statistics Zone::statistics() const noexcept {
+  Statistics statistics;
+  statistics.reset();
+
+  if (_block == &_zeroBlock)
+    return statistics;
+
+  // Blocks preceding the current one were exhausted before a new block was
+  // needed, count them as fully used. Blocks after the current one are kept
+  // by a soft `reset()` and are completely unused.
+  const Block* block = _block->prev;
+  while (block) {
+    statistics._blockCount++;
+    statistics._usedSize += block->size;
+    statistics._reservedSize += block->size;
+    block = block->prev;
+  }
+
+  statistics._blockCount++;
+  statistics._usedSize += (size_t)(_ptr - _block->data());
+  statistics._reservedSize += _block->size;
+
+  block = _block->next;
+  while (block) {
+    statistics._blockCount++;
+    statistics._reservedSize += block->size;
+    block = block->next;
+  }
+
+  return statistics;
+}
+
 void* Zone::allocZeroed(size_t size, size_t alignment) noexcept {
   void* p = alloc(size, alignment);
   if (ASMJIT_UNLIKELY(!p))
@@ -93,7 +93,8 @@ public:
     : _ptr(other._ptr),
       _end(other._end),
       _block(other._block),
-      _packedData(other._packedData) {
+      _packedData(other._packedData),
+      _maxBlockSize(other._maxBlockSize) {
     ASMJIT_ASSERT(!other.isTemporary());
     other._block = const_cast<Block*>(&_zeroBlock);
     other._ptr = other._block->data();
@@ -127,8 +128,22 @@ public:
 
   //! Gets the default block size.
   ASMJIT_INLINE size_t blockSize() const noexcept { return _blockSize; }
+  //! Gets the block size the geometric growth is allowed to reach, equals
+  //! `blockSize()` if growth is disabled.
+  ASMJIT_INLINE size_t maxBlockSize() const noexcept { return _maxBlockSize; }
   //! Gets the default block alignment.
   ASMJIT_INLINE size_t blockAlignment() const noexcept { return size_t(1) << _blockAlignmentShift; }
+
+  //! Enables geometric block growth - each newly allocated block doubles the
+  //! default block size until it reaches `maxBlockSize`.
+  //!
+  //! Growth suits zones whose workload is usually tiny but occasionally big:
+  //! small codegen pays for small blocks only, while rare big codegen stops
+  //! chaining allocations after a few doublings. Passing a value equal or
+  //! lower to the current `blockSize()` disables growth again.
+  ASMJIT_INLINE void setMaxBlockSize(size_t maxBlockSize) noexcept {
+    _maxBlockSize = Support::max<size_t>(Support::min<size_t>(maxBlockSize, kMaxBlockSize), blockSize());
+  }
   //! Gets remaining size of the current block.
   ASMJIT_INLINE size_t remainingSize() const noexcept { return (size_t)(_end - _ptr); }
 
@@ -331,6 +346,43 @@ public:
   //! Helper to duplicate a formatted string, maximum size is 256 bytes.
   ASMJIT_API char* sformat(const char* str, ...) noexcept;
 
+  // --------------------------------------------------------------------------
+  // [Statistics]
+  // --------------------------------------------------------------------------
+
+  //! Statistics about a `Zone`.
+  //!
+  //! Gathered by walking the block list on demand, so querying costs nothing
+  //! unless used. Since a soft `reset()` keeps all blocks, `reservedSize()`
+  //! after soft resets is the high-water mark of the zone's footprint.
+  struct Statistics {
+    inline void reset() noexcept {
+      _blockCount = 0;
+      _usedSize = 0;
+      _reservedSize = 0;
+    }
+
+    //! Gets the number of blocks the `Zone` maintains.
+    inline size_t blockCount() const noexcept { return _blockCount; }
+    //! Gets how many bytes are currently used, exhausted blocks counted as
+    //! fully used (their alignment waste is not tracked).
+    inline size_t usedSize() const noexcept { return _usedSize; }
+    //! Gets the number of allocated but currently unused bytes.
+    inline size_t unusedSize() const noexcept { return _reservedSize - _usedSize; }
+    //! Gets the total number of bytes reserved (sum of sizes of all blocks).
+    inline size_t reservedSize() const noexcept { return _reservedSize; }
+
+    //! Number of blocks.
+    size_t _blockCount;
+    //! Bytes used.
+    size_t _usedSize;
+    //! Bytes reserved.
+    size_t _reservedSize;
+  };
+
+  //! Gets statistics about this `Zone`.
+  ASMJIT_API Statistics statistics() const noexcept;
+
   // --------------------------------------------------------------------------
   // [Swap]
   // --------------------------------------------------------------------------
@@ -344,6 +396,7 @@ public:
     std::swap(_end, other._end);
     std::swap(_block, other._block);
     std::swap(_packedData, other._packedData);
+    std::swap(_maxBlockSize, other._maxBlockSize);
   }
 
   // --------------------------------------------------------------------------
@@ -368,6 +421,9 @@ public:
     };
     size_t _packedData;
   };
+
+  //! Block size the geometric growth is allowed to reach.
+  size_t _maxBlockSize;
 };
 
 // ============================================================================
@@ -1,9 +1,114 @@
 #include "framework.h"
 #include <dll_module.h>
+#include <AntiCheatBypass.h>
 #include <LOLClient.h>
+#include <OffestManager.h>
+#include <PhaseTimer.h>
+#include <ReadyStateReport.h>
+#include <ScanResultCache.h>
+#include <SharedSymbolCache.h>
+#include <utility/binlog.h>
+#include <utility/deferred_init.h>
+#include <utility/etw_trace.h>
+#include <utility/memory_prefetch.h>
+#include <utility/thread_governor.h>
+
+#include <BlackBone/Process/Process.h>
+#include <encstr/pool.hpp>
+
+#include <chrono>
 
 using encoder = encstr::cbc_t<encstr::ciphers::xor_cipher_t>;
-LOLClient g_lol_client;
+
+namespace
+{
+	//Warm the caches AntiCheatBypass resolves through, in dependency order:
+	//ntdll symbols first, then export indexes, then the disk scan cache
+	DWORD WINAPI prefetch_worker(LPVOID)
+	{
+		//Background mode lowers I/O and page priority as well
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+		{
+			PhaseTimer::Scope v_phase(L"prefetch");
+
+			{
+				//Our own image first: asmjit and blackbone are linked in,
+				//so one batched warm-up here replaces the scattered soft
+				//faults their first execution would take
+				PhaseTimer::Scope v_sub(L"image_warm");
+				HMODULE v_self = nullptr;
+				if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+					reinterpret_cast<LPCWSTR>(&prefetch_worker), &v_self))
+				{
+					base::prefetch_module_image(v_self);
+				}
+			}
+
+			{
+				//Symbol set, adopted from the cross-process segment when
+				//another injected instance already resolved it
+				PhaseTimer::Scope v_sub(L"symbols");
+				get_shared_symbol_cache().Acquire();
+			}
+
+			{
+				//Export indexes for the modules the bypass resolves from
+				PhaseTimer::Scope v_sub(L"export_index");
+				blackbone::Process v_proc;
+				if (NT_SUCCESS(v_proc.Attach(GetCurrentProcessId())))
+				{
+					v_proc.modules().GetExport(L"ntdll.dll", "NtSetInformationThread");
+					v_proc.modules().GetExport(L"kernel32.dll", "SetUnhandledExceptionFilter");
+				}
+			}
+
+			{
+				//Disk-backed pattern scan results
+				PhaseTimer::Scope v_sub(L"scan_cache");
+				get_scan_result_cache().Prefetch();
+			}
+		}
+
+		//Prefetch completion is our ready-state, flush the timings and
+		//publish the latency budget report for external tooling
+		get_phase_timer().WriteReport();
+		get_ready_state_report().Publish();
+
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+		return 0;
+	}
+
+	DWORD WINAPI init_worker(LPVOID param)
+	{
+		static_cast<dll_module*>(param)->run_init_stages();
+		return 0;
+	}
+
+	//Declared against the stage it needs, not buried in the pipeline body:
+	//the pool decrypt pass wants the offset work done first so its linear
+	//walk is the only thing touching the string pages
+	const base::deferred_init::registrar s_warm_encstr{
+		static_cast<unsigned>(dll_module::init_stage::eOffsets),
+		[]()
+		{
+			//One linear pass over the pooled string storages, in address
+			//order, so the scattered first-use decrypts become a single
+			//predictable cost here; afterwards their section pages hold only
+			//decrypted strings and can go read-only
+			PhaseTimer::Scope v_sub(L"encstr_warm");
+			encstr::warm_pool();
+
+			const auto v_range = encstr::pool_storage_range();
+			const auto v_first = static_cast<const uint8_t*>(v_range.first);
+			const auto v_last = static_cast<const uint8_t*>(v_range.second);
+			if (v_last > v_first + 1)
+			{
+				DWORD v_old_protect = 0;
+				VirtualProtect(const_cast<uint8_t*>(v_first), static_cast<SIZE_T>(v_last - v_first), PAGE_READONLY, &v_old_protect);
+			}
+		} };
+}
 
 dll_module::dll_module()
 = default;
@@ -14,10 +119,94 @@ dll_module::~dll_module()
 
 void dll_module::attach()
 {
-	const auto v_str_cmdline = std::wstring(GetCommandLineW());
-	if (v_str_cmdline.find(g_lol_client.GetGameMainName()) == std::wstring::npos)
+	//Still under the loader lock: queue the worker and return; everything
+	//that reads files, parses versions or loads modules runs there, so
+	//injection-to-return latency stays in the microsecond range
+	const auto v_h_thread = CreateThread(nullptr, 0, init_worker, this, 0, nullptr);
+	if (v_h_thread != nullptr)
+	{
+		base::shared_thread_governor().register_thread(v_h_thread);
+		CloseHandle(v_h_thread);
+	}
+}
+
+void dll_module::run_init_stages()
+{
+	PhaseTimer::Scope v_phase(L"init");
+
+	{
+		//Stage 1: client identity (exe path, module names, module watch)
+		PhaseTimer::Scope v_sub(L"client_info");
+		auto& v_lol_client = get_lol_client();
+
+		const auto v_str_cmdline = std::wstring(GetCommandLineW());
+		if (v_str_cmdline.find(v_lol_client.GetGameMainName()) == std::wstring::npos)
+		{
+			//Not the game process: nothing to set up, unblock any waiter
+			publish_stage(init_stage::eHooks);
+			detach();
+			return;
+		}
+	}
+	publish_stage(init_stage::eClientInfo);
+	base::shared_deferred_init().run_stage(static_cast<unsigned>(init_stage::eClientInfo));
+	base::shared_etw_trace().init_stage(static_cast<unsigned>(init_stage::eClientInfo));
+	BINLOG_INFO("init stage %s complete", "client_info");
+
+	{
+		//Stage 2: game version and offset selection (database or
+		//signature fallback), needs the client paths from stage 1
+		PhaseTimer::Scope v_sub(L"offsets");
+		get_offest_manager().Init();
+	}
+	publish_stage(init_stage::eOffsets);
+	base::shared_deferred_init().run_stage(static_cast<unsigned>(init_stage::eOffsets));
+	base::shared_etw_trace().init_stage(static_cast<unsigned>(init_stage::eOffsets));
+	BINLOG_INFO("init stage %s complete", "offsets");
+
+	{
+		//Stage 3: arm the bypass, needs the offsets from stage 2; the
+		//singleton keeps the detours alive for the process lifetime
+		PhaseTimer::Scope v_sub(L"hooks");
+		get_anti_cheat_bypass().EnableDebug();
+	}
+	publish_stage(init_stage::eHooks);
+	base::shared_deferred_init().run_stage(static_cast<unsigned>(init_stage::eHooks));
+	base::shared_etw_trace().init_stage(static_cast<unsigned>(init_stage::eHooks));
+	BINLOG_INFO("init stage %s complete", "hooks");
+
+	start_prefetch();
+}
+
+void dll_module::publish_stage(const init_stage stage)
+{
+	_reached_stage_.store(static_cast<unsigned>(stage), std::memory_order_release);
+
+	//Publish under the lock so a waiter cannot check-then-sleep past it
+	std::lock_guard<std::mutex> v_guard(_stage_lock_);
+	_stage_cv_.notify_all();
+}
+
+bool dll_module::wait_for_stage(const init_stage stage, const unsigned timeout_ms)
+{
+	const auto v_wanted = static_cast<unsigned>(stage);
+	if (_reached_stage_.load(std::memory_order_acquire) >= v_wanted)
+		return true;
+
+	std::unique_lock<std::mutex> v_guard(_stage_lock_);
+	return _stage_cv_.wait_for(v_guard, std::chrono::milliseconds(timeout_ms),
+		[&]() { return _reached_stage_.load(std::memory_order_acquire) >= v_wanted; });
+}
+
+void dll_module::start_prefetch() const
+{
+	//The worker only runs after the loader lock is released,
+	//while the game itself is still loading
+	const auto v_h_thread = CreateThread(nullptr, 0, prefetch_worker, nullptr, 0, nullptr);
+	if (v_h_thread != nullptr)
 	{
-		detach();
+		base::shared_thread_governor().register_thread(v_h_thread, THREAD_PRIORITY_LOWEST);
+		CloseHandle(v_h_thread);
 	}
 }
 
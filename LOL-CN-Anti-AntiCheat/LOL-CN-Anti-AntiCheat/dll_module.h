@@ -1,11 +1,41 @@
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 class dll_module
 {
 public:
+	//Ordered init stages; a later stage may assume every earlier one
+	enum class init_stage : unsigned
+	{
+		eQueued = 0,	//DllMain returned, worker not run yet
+		eClientInfo,	//LOLClient built: paths, names, module watch
+		eOffsets,		//OffestManager built: version + offset selection
+		eHooks,			//AntiCheatBypass armed, init complete
+	};
+
 	dll_module();
 	~dll_module();
+	//Loader-lock safe: only queues the init worker, all real work
+	//(file I/O, version parsing, hooks) runs on the worker thread
 	void attach();
 	void detach();
+
+	//Dependency gate for consumers that need a stage done before they can
+	//run; false on timeout
+	bool wait_for_stage(init_stage stage, unsigned timeout_ms);
+
+	//Init worker entry, not for direct callers
+	void run_init_stages();
+
+private:
+	void publish_stage(init_stage stage);
+	void start_prefetch() const;
+
+private:
+	std::atomic<unsigned> _reached_stage_{};
+	std::mutex _stage_lock_;
+	std::condition_variable _stage_cv_;
 };
 extern dll_module g_dMod;
-
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <utility/noncopyable.h>
+#include <utility/singleton.h>
+#include <utility/thread_governor.h>
+
+#include <bee/utility/format.h>
+#include <bee/utility/path_helper.h>
+
+#include <windows.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace base {
+	// binary logging with off-thread formatting. the hot path writes one
+	// compact record (format literal pointer + raw argument words) into a
+	// per-thread lock-free ring - no formatting, no locks, no system
+	// calls, well under 100ns - and a background flusher drains the
+	// rings, renders the records through bee::format and appends them to
+	// the log file in one coalesced write per cycle. when a ring is full
+	// the record is dropped and counted rather than ever stalling the
+	// caller. format strings and logged C strings must be literals (the
+	// flusher reads them later, so the pointers have to stay valid), and
+	// every argument marker is %s - the recorded argument kind decides
+	// the rendering.
+	enum class log_level : unsigned
+	{
+		eTrace = 0,
+		eDebug,
+		eInfo,
+		eWarn,
+		eError,
+	};
+
+	class binlog : private noncopyable
+	{
+	public:
+		static constexpr size_t k_max_args = 4;
+		static constexpr size_t k_ring_slots = 1024;	//per thread, power of two
+
+		//one argument word plus how to render it
+		enum class arg_kind : unsigned char
+		{
+			eNone = 0,
+			eInt,		//signed 64-bit
+			eUint,		//unsigned 64-bit (also pointers)
+			eFloat,		//double
+			eCString,	//const char* literal
+		};
+
+		struct record
+		{
+			unsigned long long tick_ms;
+			const char* format;
+			unsigned long thread_id;
+			log_level level;
+			unsigned char arg_count;
+			arg_kind kinds[k_max_args];
+			unsigned long long args[k_max_args];
+		};
+
+		binlog() = default;
+
+		//Hot path: one slot write and one release store. The first call
+		//from a thread allocates its ring and lazily starts the flusher
+		void write(const record& item)
+		{
+			auto* v_ring = ring_for_thread();
+
+			const auto v_head = v_ring->head.load(std::memory_order_relaxed);
+			const auto v_tail = v_ring->tail.load(std::memory_order_acquire);
+			if (v_head - v_tail >= k_ring_slots)
+			{
+				v_ring->dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			v_ring->slots[v_head & (k_ring_slots - 1)] = item;
+			v_ring->head.store(v_head + 1, std::memory_order_release);
+		}
+
+		//Argument packing for the logging macros
+		static unsigned long long pack(const long long value, arg_kind& kind) { kind = arg_kind::eInt; return static_cast<unsigned long long>(value); }
+		static unsigned long long pack(const int value, arg_kind& kind) { kind = arg_kind::eInt; return static_cast<unsigned long long>(static_cast<long long>(value)); }
+		static unsigned long long pack(const long value, arg_kind& kind) { kind = arg_kind::eInt; return static_cast<unsigned long long>(static_cast<long long>(value)); }
+		static unsigned long long pack(const unsigned long long value, arg_kind& kind) { kind = arg_kind::eUint; return value; }
+		static unsigned long long pack(const unsigned int value, arg_kind& kind) { kind = arg_kind::eUint; return value; }
+		static unsigned long long pack(const unsigned long value, arg_kind& kind) { kind = arg_kind::eUint; return value; }
+		static unsigned long long pack(const double value, arg_kind& kind)
+		{
+			kind = arg_kind::eFloat;
+			unsigned long long v_bits;
+			std::memcpy(&v_bits, &value, sizeof(v_bits));
+			return v_bits;
+		}
+		static unsigned long long pack(const char* value, arg_kind& kind) { kind = arg_kind::eCString; return reinterpret_cast<unsigned long long>(value); }
+		template <typename pointee_type>
+		static unsigned long long pack(pointee_type* value, arg_kind& kind) { kind = arg_kind::eUint; return reinterpret_cast<unsigned long long>(value); }
+
+		template <typename... arg_types>
+		void log(const log_level level, const char* format, const arg_types... args)
+		{
+			static_assert(sizeof...(args) <= k_max_args, "too many log arguments");
+
+			record v_item = {};
+			v_item.tick_ms = GetTickCount64();
+			v_item.format = format;
+			v_item.thread_id = GetCurrentThreadId();
+			v_item.level = level;
+			v_item.arg_count = static_cast<unsigned char>(sizeof...(args));
+
+			size_t v_index = 0;
+			((v_item.args[v_index] = pack(args, v_item.kinds[v_index]), ++v_index), ...);
+
+			write(v_item);
+		}
+
+		[[nodiscard]] unsigned long long dropped() const noexcept
+		{
+			unsigned long long v_total = 0;
+			for (const auto* v_ring = rings_.load(std::memory_order_acquire); v_ring != nullptr; v_ring = v_ring->next)
+				v_total += v_ring->dropped.load(std::memory_order_relaxed);
+			return v_total;
+		}
+
+	private:
+		struct ring
+		{
+			std::atomic<unsigned> head{ 0 };	//producer side
+			std::atomic<unsigned> tail{ 0 };	//flusher side
+			std::atomic<unsigned long long> dropped{ 0 };
+			ring* next = nullptr;
+			record slots[k_ring_slots] = {};
+		};
+
+		//Rings are CAS-pushed onto a list that is never unlinked, so a
+		//thread exiting cannot invalidate anything the flusher holds
+		ring* ring_for_thread()
+		{
+			thread_local ring* v_ring = nullptr;
+			if (v_ring == nullptr)
+			{
+				v_ring = new ring();
+
+				auto* v_head = rings_.load(std::memory_order_relaxed);
+				do
+				{
+					v_ring->next = v_head;
+				} while (!rings_.compare_exchange_weak(v_head, v_ring, std::memory_order_release, std::memory_order_relaxed));
+
+				ensure_flusher();
+			}
+			return v_ring;
+		}
+
+		void ensure_flusher()
+		{
+			std::lock_guard<std::mutex> v_guard(flusher_lock_);
+			if (!flusher_.joinable())
+				flusher_ = std::thread([this] { flusher_main(); });
+		}
+
+		void flusher_main()
+		{
+			shared_thread_governor().register_current_thread(THREAD_PRIORITY_LOWEST);
+
+			std::string v_batch;
+			v_batch.reserve(64 * 1024);
+
+			for (;;)
+			{
+				{
+					std::unique_lock<std::mutex> v_guard(flusher_lock_);
+					flusher_cv_.wait_for(v_guard, std::chrono::milliseconds(k_flush_interval_ms));
+				}
+
+				v_batch.clear();
+				for (auto* v_ring = rings_.load(std::memory_order_acquire); v_ring != nullptr; v_ring = v_ring->next)
+					drain_ring(v_ring, v_batch);
+
+				if (!v_batch.empty())
+					append(v_batch);
+			}
+		}
+
+		void drain_ring(ring* item, std::string& batch)
+		{
+			auto v_tail = item->tail.load(std::memory_order_relaxed);
+			const auto v_head = item->head.load(std::memory_order_acquire);
+
+			for (; v_tail != v_head; ++v_tail)
+			{
+				const auto& v_record = item->slots[v_tail & (k_ring_slots - 1)];
+				render(v_record, batch);
+			}
+
+			item->tail.store(v_tail, std::memory_order_release);
+		}
+
+		//Off-thread rendering: the expensive part runs here, never at the
+		//log site
+		static void render(const record& item, std::string& batch)
+		{
+			static const char* const k_level_names[] = { "trace", "debug", "info", "warn", "error" };
+
+			batch += bee::format("[%08llu] [%-5s] [%05lu] ",
+				item.tick_ms, k_level_names[static_cast<unsigned>(item.level)], item.thread_id);
+
+			//Every marker in the format literal is %s: the recorded kind,
+			//not the marker, decides how a word renders, so the literal
+			//never disagrees with the packed type
+			switch (item.arg_count)
+			{
+			case 0: batch += item.format; break;
+			case 1: batch += bee::format(item.format, rendered(item, 0)); break;
+			case 2: batch += bee::format(item.format, rendered(item, 0), rendered(item, 1)); break;
+			case 3: batch += bee::format(item.format, rendered(item, 0), rendered(item, 1), rendered(item, 2)); break;
+			default: batch += bee::format(item.format, rendered(item, 0), rendered(item, 1), rendered(item, 2), rendered(item, 3)); break;
+			}
+			batch += '\n';
+		}
+
+		//Render one packed word back to text by its recorded kind
+		static std::string rendered(const record& item, const size_t index)
+		{
+			switch (item.kinds[index])
+			{
+			case arg_kind::eInt:
+				return bee::format("%lld", static_cast<long long>(item.args[index]));
+			case arg_kind::eFloat:
+			{
+				double v_value;
+				std::memcpy(&v_value, &item.args[index], sizeof(v_value));
+				return bee::format("%g", v_value);
+			}
+			case arg_kind::eCString:
+				return reinterpret_cast<const char*>(item.args[index]);
+			case arg_kind::eUint:
+			default:
+				return bee::format("%llu", item.args[index]);
+			}
+		}
+
+		//One coalesced append per flush cycle
+		void append(const std::string& batch)
+		{
+			if (file_ == INVALID_HANDLE_VALUE)
+			{
+				const auto& v_dir = bee::path_helper::dll_directory();
+				const auto v_path = (!v_dir.empty() ? v_dir / L"bypass.log" : fs::path(L"bypass.log")).wstring();
+				file_ = CreateFileW(v_path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+					OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file_ == INVALID_HANDLE_VALUE)
+					return;
+			}
+
+			DWORD v_written = 0;
+			WriteFile(file_, batch.data(), static_cast<DWORD>(batch.size()), &v_written, nullptr);
+		}
+
+	private:
+		static constexpr unsigned k_flush_interval_ms = 50;
+
+		std::atomic<ring*> rings_{ nullptr };
+		std::mutex flusher_lock_;
+		std::condition_variable flusher_cv_;
+		std::thread flusher_;
+		HANDLE file_ = INVALID_HANDLE_VALUE;
+	};
+
+	inline binlog& shared_binlog()
+	{
+		return singleton_atomic<binlog>::instance();
+	}
+}
+
+//Compile-time level stripping: calls below the configured floor compile
+//to nothing, arguments are not even evaluated
+#ifndef BINLOG_MIN_LEVEL
+#ifdef _DEBUG
+#define BINLOG_MIN_LEVEL 0
+#else
+#define BINLOG_MIN_LEVEL 2
+#endif
+#endif
+
+#define BINLOG_AT(level, ...) \
+	do { \
+		if constexpr (static_cast<unsigned>(level) >= BINLOG_MIN_LEVEL) \
+			base::shared_binlog().log(level, __VA_ARGS__); \
+	} while (0)
+
+#define BINLOG_TRACE(...) BINLOG_AT(base::log_level::eTrace, __VA_ARGS__)
+#define BINLOG_DEBUG(...) BINLOG_AT(base::log_level::eDebug, __VA_ARGS__)
+#define BINLOG_INFO(...)  BINLOG_AT(base::log_level::eInfo, __VA_ARGS__)
+#define BINLOG_WARN(...)  BINLOG_AT(base::log_level::eWarn, __VA_ARGS__)
+#define BINLOG_ERROR(...) BINLOG_AT(base::log_level::eError, __VA_ARGS__)
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <utility/noncopyable.h>
+#include <utility/singleton.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace base {
+	// registry of deferred construction hooks, keyed by init pipeline
+	// stage. a subsystem declares "build me once stage N is done" with a
+	// file-scope registrar instead of relying on first-use from whatever
+	// thread happens to touch it, and the pipeline drains each stage's
+	// hooks in registration order when it completes that stage - so
+	// construction order is stated at the definition site, not left to
+	// link order or call-site luck. hooks registered for a stage that has
+	// already run execute immediately on the registering thread (late
+	// loads still work), which also means registration at namespace scope
+	// must stay cheap: the work belongs in the hook, never the registrar.
+	class deferred_init : private noncopyable
+	{
+	public:
+		using hook_type = std::function<void()>;
+
+		deferred_init() = default;
+
+		// declare a hook to run once 'stage' completes
+		void register_hook(const unsigned stage, hook_type hook)
+		{
+			{
+				std::lock_guard<std::mutex> v_guard(lock_);
+				if (stage > last_run_stage_ || !started_)
+				{
+					if (hooks_.size() <= stage)
+						hooks_.resize(stage + 1);
+					hooks_[stage].emplace_back(std::move(hook));
+					return;
+				}
+			}
+
+			// stage already ran: no pipeline pass will come back for this
+			// hook, run it here
+			hook();
+		}
+
+		// pipeline side: run every hook declared for 'stage', in
+		// registration order. stages are expected in increasing order
+		void run_stage(const unsigned stage)
+		{
+			std::vector<hook_type> v_pending;
+			{
+				std::lock_guard<std::mutex> v_guard(lock_);
+				started_ = true;
+				last_run_stage_ = stage;
+				if (stage < hooks_.size())
+					v_pending.swap(hooks_[stage]);
+			}
+
+			for (const auto& v_hook : v_pending)
+				v_hook();
+		}
+
+		// file-scope registration helper:
+		//   const base::deferred_init::registrar s_reg{ stage, []{ ... } };
+		struct registrar
+		{
+			registrar(const unsigned stage, hook_type hook)
+			{
+				shared_instance().register_hook(stage, std::move(hook));
+			}
+		};
+
+		static deferred_init& shared_instance()
+		{
+			return singleton_atomic<deferred_init>::instance();
+		}
+
+	private:
+		std::mutex lock_;
+		std::vector<std::vector<hook_type>> hooks_;
+		unsigned last_run_stage_ = 0;
+		bool started_ = false;
+	};
+
+	inline deferred_init& shared_deferred_init()
+	{
+		return deferred_init::shared_instance();
+	}
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <utility/noncopyable.h>
+#include <utility/singleton.h>
+
+#include <windows.h>
+#include <evntprov.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace base {
+	// manifest-free etw provider for overlaying our activity on a wpa
+	// trace of the game (gpu/dxgi timelines next to our hooks and
+	// stages). events are fixed-id with small pod payloads, written via
+	// EventWriteTransfer only while a session has the provider enabled -
+	// the disabled hot path is one relaxed load and a branch. decoding
+	// is by event id on the tooling side, no manifest to install.
+	//
+	// provider guid, the contract with the capture side:
+	//   {8d7f30c1-5a42-4c8e-b1de-9a6b30f0c55d}
+	class etw_trace : private noncopyable
+	{
+	public:
+		//stable ids, append-only
+		enum class event_id : USHORT
+		{
+			eInitStage = 1,		//stage_payload
+			eHookCall = 2,		//hook_payload, sampled at the call site
+			eRpcRoundTrip = 3,	//rpc_payload
+			eRegionSweep = 4,	//sweep_payload
+		};
+
+		struct stage_payload
+		{
+			uint32_t _stage_;
+		};
+
+		struct hook_payload
+		{
+			uint32_t _hook_id_;
+			uint32_t _elapsed_us_;
+		};
+
+		struct rpc_payload
+		{
+			uint32_t _rpc_id_;
+			uint32_t _elapsed_us_;
+		};
+
+		struct sweep_payload
+		{
+			uint32_t _pages_;
+			uint32_t _changed_;
+		};
+
+		etw_trace()
+		{
+			EventRegister(&k_provider_guid, enable_callback, this, &handle_);
+		}
+
+		~etw_trace()
+		{
+			if (handle_ != 0)
+				EventUnregister(handle_);
+		}
+
+		[[nodiscard]] bool enabled() const noexcept
+		{
+			return enabled_.load(std::memory_order_relaxed);
+		}
+
+		template <typename payload_type>
+		void write(const event_id id, const payload_type& payload)
+		{
+			if (!enabled())
+				return;
+
+			EVENT_DESCRIPTOR v_desc;
+			EventDescCreate(&v_desc, static_cast<USHORT>(id), 0, 0, 4 /*info*/, 0, 0, 0x1);
+
+			EVENT_DATA_DESCRIPTOR v_data;
+			EventDataDescCreate(&v_data, &payload, sizeof(payload));
+			EventWriteTransfer(handle_, &v_desc, nullptr, nullptr, 1, &v_data);
+		}
+
+		void init_stage(const uint32_t stage)
+		{
+			write(event_id::eInitStage, stage_payload{ stage });
+		}
+
+		void rpc_round_trip(const uint32_t rpc_id, const uint32_t elapsed_us)
+		{
+			write(event_id::eRpcRoundTrip, rpc_payload{ rpc_id, elapsed_us });
+		}
+
+		void region_sweep(const uint32_t pages, const uint32_t changed)
+		{
+			write(event_id::eRegionSweep, sweep_payload{ pages, changed });
+		}
+
+		// sampled hook timing: 1 in k_hook_sample_rate calls is measured
+		// and emitted as one eHookCall event at exit. when no session
+		// listens, construction is the single enabled() branch
+		class hook_scope : private noncopyable
+		{
+		public:
+			explicit hook_scope(const uint32_t hook_id) noexcept
+				: hook_id_(hook_id)
+			{
+				auto& v_trace = shared_instance();
+				if (!v_trace.enabled())
+					return;
+
+				thread_local uint32_t t_calls = 0;
+				if ((++t_calls & (k_hook_sample_rate - 1)) != 0)
+					return;
+
+				LARGE_INTEGER v_now;
+				QueryPerformanceCounter(&v_now);
+				started_qpc_ = v_now.QuadPart;
+			}
+
+			~hook_scope() noexcept
+			{
+				if (started_qpc_ == 0)
+					return;
+
+				LARGE_INTEGER v_now;
+				QueryPerformanceCounter(&v_now);
+				shared_instance().write(event_id::eHookCall,
+					hook_payload{ hook_id_, static_cast<uint32_t>((v_now.QuadPart - started_qpc_) * 1000000 / qpc_frequency()) });
+			}
+
+		private:
+			uint32_t hook_id_;
+			int64_t started_qpc_ = 0;
+		};
+
+		static etw_trace& shared_instance()
+		{
+			return singleton_atomic<etw_trace>::instance();
+		}
+
+	private:
+		static constexpr uint32_t k_hook_sample_rate = 64;	//power of two
+
+		inline static const GUID k_provider_guid =
+			{ 0x8d7f30c1, 0x5a42, 0x4c8e, { 0xb1, 0xde, 0x9a, 0x6b, 0x30, 0xf0, 0xc5, 0x5d } };
+
+		static void NTAPI enable_callback(LPCGUID, const ULONG control_code, UCHAR, ULONGLONG, ULONGLONG, PEVENT_FILTER_DESCRIPTOR, PVOID context)
+		{
+			const auto v_self = static_cast<etw_trace*>(context);
+			if (control_code == EVENT_CONTROL_CODE_ENABLE_PROVIDER)
+				v_self->enabled_.store(true, std::memory_order_relaxed);
+			else if (control_code == EVENT_CONTROL_CODE_DISABLE_PROVIDER)
+				v_self->enabled_.store(false, std::memory_order_relaxed);
+		}
+
+		static int64_t qpc_frequency() noexcept
+		{
+			static const int64_t s_frequency = []
+			{
+				LARGE_INTEGER v_freq = {};
+				QueryPerformanceFrequency(&v_freq);
+				return v_freq.QuadPart != 0 ? v_freq.QuadPart : 1;
+			}();
+			return s_frequency;
+		}
+
+	private:
+		REGHANDLE handle_ = 0;
+		std::atomic<bool> enabled_{ false };
+	};
+
+	inline etw_trace& shared_etw_trace()
+	{
+		return etw_trace::shared_instance();
+	}
+}
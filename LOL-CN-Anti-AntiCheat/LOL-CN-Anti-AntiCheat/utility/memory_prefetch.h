@@ -0,0 +1,62 @@
+#pragma once
+
+#include <windows.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace base {
+	// batched soft-fault warm-up: PrefetchVirtualMemory queues one
+	// sequential read of the given ranges instead of letting first-use
+	// demand paging serialize hundreds of scattered faults. the API is
+	// Win8+, resolved dynamically; on older systems the helpers report
+	// failure and callers fall back to touching pages (or to nothing -
+	// demand paging still works, just slower).
+	inline bool prefetch_ranges(const HANDLE process, PWIN32_MEMORY_RANGE_ENTRY ranges, const ULONG_PTR count)
+	{
+		using prefetch_t = BOOL(WINAPI*)(HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY, ULONG);
+		static const auto s_prefetch = reinterpret_cast<prefetch_t>(
+			GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+
+		if (s_prefetch == nullptr || count == 0)
+			return false;
+
+		return s_prefetch(process, count, ranges, 0) != FALSE;
+	}
+
+	inline bool prefetch_range(const HANDLE process, void* address, const size_t size)
+	{
+		WIN32_MEMORY_RANGE_ENTRY v_range = { address, size };
+		return prefetch_ranges(process, &v_range, 1);
+	}
+
+	// warm every mapped section of an image in one call; the headers
+	// are already resident (we just read them), the sections are what
+	// first execution would fault in piecemeal
+	inline bool prefetch_module_image(const HMODULE module)
+	{
+		const auto v_base = reinterpret_cast<uint8_t*>(module);
+		const auto v_dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(v_base);
+		if (v_dos->e_magic != IMAGE_DOS_SIGNATURE)
+			return false;
+
+		const auto v_nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(v_base + v_dos->e_lfanew);
+		if (v_nt->Signature != IMAGE_NT_SIGNATURE)
+			return false;
+
+		std::vector<WIN32_MEMORY_RANGE_ENTRY> v_ranges;
+		v_ranges.reserve(v_nt->FileHeader.NumberOfSections);
+
+		const auto v_sections = IMAGE_FIRST_SECTION(v_nt);
+		for (WORD i = 0; i < v_nt->FileHeader.NumberOfSections; ++i)
+		{
+			const auto v_size = (std::max)(v_sections[i].Misc.VirtualSize, v_sections[i].SizeOfRawData);
+			if (v_size == 0)
+				continue;
+
+			v_ranges.push_back({ v_base + v_sections[i].VirtualAddress, v_size });
+		}
+
+		return prefetch_ranges(GetCurrentProcess(), v_ranges.data(), v_ranges.size());
+	}
+}
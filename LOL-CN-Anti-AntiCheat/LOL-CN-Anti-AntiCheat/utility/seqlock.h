@@ -0,0 +1,64 @@
+#pragma once
+
+#include <utility/noncopyable.h>
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace base {
+	// seqlock over a trivially-copyable snapshot: readers copy the payload
+	// and retry if a write overlapped, so a read is two sequence loads and
+	// a memcpy - no stores to shared lines, no kernel waits, safe from
+	// hook context. writes are rare and assumed serialized by the caller
+	// (e.g. the loader notification runs under the loader lock); an odd
+	// sequence marks a write in progress.
+	template <typename snapshot_type>
+	class seqlock : private noncopyable
+	{
+		static_assert(std::is_trivially_copyable_v<snapshot_type>,
+			"seqlock payload must be trivially copyable");
+
+	public:
+		seqlock() = default;
+
+		snapshot_type read() const
+		{
+			snapshot_type v_value;
+			for (;;)
+			{
+				const auto v_begin = seq_.load(std::memory_order_acquire);
+				if ((v_begin & 1u) != 0)
+				{
+					YieldProcessor();
+					continue;
+				}
+
+				std::memcpy(&v_value, &value_, sizeof(snapshot_type));
+
+				// the fence orders the copy before the re-check, so a torn
+				// copy always sees a changed sequence and retries
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (seq_.load(std::memory_order_relaxed) == v_begin)
+					return v_value;
+			}
+		}
+
+		void write(const snapshot_type& next)
+		{
+			const auto v_seq = seq_.load(std::memory_order_relaxed);
+			seq_.store(v_seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			std::memcpy(&value_, &next, sizeof(snapshot_type));
+
+			seq_.store(v_seq + 2, std::memory_order_release);
+		}
+
+	private:
+		std::atomic<unsigned> seq_{ 0 };
+		snapshot_type value_{};
+	};
+}
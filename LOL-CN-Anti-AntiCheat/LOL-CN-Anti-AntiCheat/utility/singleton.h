@@ -2,6 +2,10 @@
 
 #include <utility/noncopyable.h>
 
+#include <atomic>
+#include <mutex>
+#include <new>
+
 namespace base {
 	template <typename object_type>
 	struct singleton_nonthreadsafe 
@@ -47,4 +51,53 @@ namespace base {
 	};
 	template <typename object_type>
 	typename singleton_threadsafe<object_type>::object_creator singleton_threadsafe<object_type>::create_object;
+
+	// lazily built instance behind an acquire-load fast path: the steady
+	// state is one load and a predictable branch, no guard variable check,
+	// and a first-access race from worker threads is resolved by call_once
+	// (the storage is constant-initialized, so there is no construction
+	// order against other globals either)
+	template <typename object_type>
+	struct singleton_atomic
+		: private noncopyable
+	{
+	private:
+		singleton_atomic();
+
+		inline static constinit std::atomic<object_type*> object_ = nullptr;
+		inline static constinit std::once_flag once_;
+		alignas(object_type) inline static constinit unsigned char storage_[sizeof(object_type)] = {};
+
+	public:
+		static object_type& instance()
+		{
+			auto* obj = object_.load(std::memory_order_acquire);
+			if (obj != nullptr)
+				return *obj;
+
+			std::call_once(once_, []()
+			{
+				object_.store(::new (static_cast<void*>(storage_)) object_type, std::memory_order_release);
+			});
+			return *object_.load(std::memory_order_acquire);
+		}
+	};
+
+	// for types with a constexpr default constructor: the instance is baked
+	// into the image at build time, instance() compiles to an address
+	template <typename object_type>
+	struct singleton_constinit
+		: private noncopyable
+	{
+	private:
+		singleton_constinit();
+
+		inline static constinit object_type object_{};
+
+	public:
+		static object_type& instance() noexcept
+		{
+			return object_;
+		}
+	};
 }
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <utility/noncopyable.h>
+#include <utility/singleton.h>
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace base {
+	// one placement policy for every thread this module creates (init
+	// pipeline, pool workers, timers), instead of each site improvising
+	// its own SetThreadPriority/SetThreadAffinityMask. the topology is
+	// captured once: on hybrid CPUs the preferred mask covers the
+	// efficiency cores, on homogeneous ones the highest-index half of the
+	// cores (the game's render/main threads gravitate to the first ones).
+	// registered threads also take part in frame-time backoff: when the
+	// probe reports a spike, every registered thread drops to idle
+	// priority until frame times have been calm for a cooldown window.
+	class thread_governor : private noncopyable
+	{
+	public:
+		thread_governor()
+		{
+			capture_topology();
+		}
+
+		~thread_governor()
+		{
+			std::lock_guard<std::mutex> v_guard(lock_);
+			for (const auto& v_entry : threads_)
+				CloseHandle(v_entry.handle);
+		}
+
+		// apply the policy to a thread and keep it registered for backoff.
+		// priority is the thread's normal-state priority; the governor
+		// never raises it above that
+		void register_thread(const HANDLE thread, const int priority = THREAD_PRIORITY_BELOW_NORMAL)
+		{
+			HANDLE v_own = nullptr;
+			if (!DuplicateHandle(GetCurrentProcess(), thread, GetCurrentProcess(), &v_own,
+				THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, 0))
+				return;
+
+			SetThreadPriority(v_own, in_backoff() ? THREAD_PRIORITY_IDLE : priority);
+			if (preferred_mask_ != 0)
+				SetThreadAffinityMask(v_own, preferred_mask_);
+
+			std::lock_guard<std::mutex> v_guard(lock_);
+			threads_.push_back({ v_own, priority });
+		}
+
+		void register_current_thread(const int priority = THREAD_PRIORITY_BELOW_NORMAL)
+		{
+			register_thread(GetCurrentThread(), priority);
+		}
+
+		// frame-time probe input, called from a per-frame vantage point
+		// (present hook, render-loop timer). cheap enough for every frame:
+		// two loads on the calm path
+		void notify_frame_time(const double frame_ms)
+		{
+			const auto v_now = GetTickCount64();
+
+			if (frame_ms > k_spike_frame_ms)
+			{
+				backoff_until_.store(v_now + k_backoff_cooldown_ms, std::memory_order_relaxed);
+				if (!backoff_.exchange(true, std::memory_order_acq_rel))
+					apply_backoff(true);
+				return;
+			}
+
+			if (backoff_.load(std::memory_order_acquire)
+				&& v_now >= backoff_until_.load(std::memory_order_relaxed)
+				&& backoff_.exchange(false, std::memory_order_acq_rel))
+			{
+				apply_backoff(false);
+			}
+		}
+
+		// preferred mask for code that sets affinity itself (e.g. an
+		// explicitly configured pool); zero means leave placement alone
+		[[nodiscard]] DWORD_PTR preferred_affinity() const noexcept
+		{
+			return preferred_mask_;
+		}
+
+		[[nodiscard]] bool in_backoff() const noexcept
+		{
+			return backoff_.load(std::memory_order_acquire);
+		}
+
+	private:
+		//33ms ~ a missed 30fps frame; well above any normal 60/144fps time
+		static constexpr double k_spike_frame_ms = 33.0;
+		static constexpr unsigned k_backoff_cooldown_ms = 2000;
+
+		struct entry
+		{
+			HANDLE handle;
+			int priority;
+		};
+
+		void capture_topology()
+		{
+			//GetSystemCpuSetInformation is Win10+; resolved dynamically so
+			//older systems just skip the hybrid-core logic
+			using get_cpu_sets_t = BOOL(WINAPI*)(PSYSTEM_CPU_SET_INFORMATION, ULONG, PULONG, HANDLE, ULONG);
+			const auto v_get_cpu_sets = reinterpret_cast<get_cpu_sets_t>(
+				GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "GetSystemCpuSetInformation"));
+
+			if (v_get_cpu_sets != nullptr)
+			{
+				ULONG v_size = 0;
+				v_get_cpu_sets(nullptr, 0, &v_size, GetCurrentProcess(), 0);
+				if (v_size != 0)
+				{
+					std::vector<unsigned char> v_buffer(v_size);
+					const auto v_info = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(v_buffer.data());
+					if (v_get_cpu_sets(v_info, v_size, &v_size, GetCurrentProcess(), 0))
+					{
+						//two passes: find the lowest efficiency class, then
+						//collect its cores. identical classes means the CPU
+						//is homogeneous and the mask stays empty
+						unsigned char v_min_class = 0xFF;
+						unsigned char v_max_class = 0;
+						for (ULONG v_offset = 0; v_offset < v_size;)
+						{
+							const auto v_set = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(v_buffer.data() + v_offset);
+							if (v_set->Type == CpuSetInformation && v_set->CpuSet.Group == 0)
+							{
+								v_min_class = (std::min)(v_min_class, v_set->CpuSet.EfficiencyClass);
+								v_max_class = (std::max)(v_max_class, v_set->CpuSet.EfficiencyClass);
+							}
+							v_offset += v_set->Size;
+						}
+
+						if (v_min_class < v_max_class)
+						{
+							for (ULONG v_offset = 0; v_offset < v_size;)
+							{
+								const auto v_set = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(v_buffer.data() + v_offset);
+								if (v_set->Type == CpuSetInformation && v_set->CpuSet.Group == 0
+									&& v_set->CpuSet.EfficiencyClass == v_min_class)
+								{
+									preferred_mask_ |= 1ull << v_set->CpuSet.LogicalProcessorIndex;
+								}
+								v_offset += v_set->Size;
+							}
+							return;
+						}
+					}
+				}
+			}
+
+			//homogeneous (or pre-Win10): the upper half of the cores, away
+			//from the low-index ones the game's hot threads gravitate to
+			SYSTEM_INFO v_info = {};
+			GetSystemInfo(&v_info);
+			const auto v_cores = v_info.dwNumberOfProcessors;
+			if (v_cores >= 4)
+			{
+				for (DWORD i = v_cores / 2; i < v_cores && i < 64; ++i)
+					preferred_mask_ |= 1ull << i;
+			}
+		}
+
+		void apply_backoff(const bool active)
+		{
+			std::lock_guard<std::mutex> v_guard(lock_);
+			for (const auto& v_entry : threads_)
+				SetThreadPriority(v_entry.handle, active ? THREAD_PRIORITY_IDLE : v_entry.priority);
+		}
+
+	private:
+		DWORD_PTR preferred_mask_ = 0;
+		std::mutex lock_;
+		std::vector<entry> threads_;
+		std::atomic<bool> backoff_{ false };
+		std::atomic<unsigned long long> backoff_until_{ 0 };
+	};
+
+	inline thread_governor& shared_thread_governor()
+	{
+		return singleton_atomic<thread_governor>::instance();
+	}
+}
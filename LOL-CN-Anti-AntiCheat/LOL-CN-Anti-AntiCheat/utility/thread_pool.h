@@ -0,0 +1,274 @@
+#pragma once
+
+#include <utility/noncopyable.h>
+#include <utility/singleton.h>
+#include <utility/thread_governor.h>
+
+#include <windows.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace base {
+	// one process-wide work-stealing pool shared by every subsystem that
+	// needs workers (parallel scans, symbol loads, mapping pipelines), so
+	// nothing spawns ad-hoc threads inside the game process. each worker
+	// owns a deque: the owner pops from the back, idle workers steal from
+	// the front, and external submits are spread round-robin. workers run
+	// below normal priority by default so they stay off the game's hot
+	// cores; an affinity mask can pin them away entirely.
+	class thread_pool : private noncopyable
+	{
+	public:
+		using task_type = std::function<void()>;
+
+		struct config
+		{
+			// zero means hardware_concurrency - 1 (at least one)
+			unsigned worker_count = 0;
+			// keep the pool out of the game's way unless told otherwise
+			int priority = THREAD_PRIORITY_BELOW_NORMAL;
+			// zero leaves scheduling to the system
+			DWORD_PTR affinity_mask = 0;
+		};
+
+		thread_pool()
+			: thread_pool(config())
+		{ }
+
+		explicit thread_pool(const config& cfg)
+		{
+			unsigned v_count = cfg.worker_count;
+			if (v_count == 0)
+			{
+				const unsigned v_cores = std::thread::hardware_concurrency();
+				v_count = v_cores > 1 ? v_cores - 1 : 1;
+			}
+
+			queues_.reserve(v_count);
+			for (unsigned i = 0; i < v_count; ++i)
+				queues_.emplace_back(std::make_unique<worker_queue>());
+
+			workers_.reserve(v_count);
+			for (unsigned i = 0; i < v_count; ++i)
+			{
+				workers_.emplace_back([this, i] { worker_main(i); });
+
+				// the governor applies priority plus core placement and
+				// keeps the worker enrolled in frame-time backoff; an
+				// explicitly configured mask still wins
+				const HANDLE v_handle = workers_.back().native_handle();
+				shared_thread_governor().register_thread(v_handle, cfg.priority);
+				if (cfg.affinity_mask != 0)
+					SetThreadAffinityMask(v_handle, cfg.affinity_mask);
+			}
+		}
+
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> v_guard(sleep_lock_);
+				stop_ = true;
+			}
+			sleep_cv_.notify_all();
+
+			for (auto& v_worker : workers_)
+				v_worker.join();
+		}
+
+		unsigned worker_count() const
+		{
+			return static_cast<unsigned>(workers_.size());
+		}
+
+		// a submit from a worker lands on its own deque (back, so it runs
+		// next and stays cache-hot); outside submits are spread round-robin
+		void submit(task_type task)
+		{
+			const unsigned v_index = (worker_index_ != k_invalid_index)
+				? worker_index_
+				: next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+			{
+				std::lock_guard<std::mutex> v_guard(queues_[v_index]->lock);
+				queues_[v_index]->tasks.emplace_back(std::move(task));
+			}
+			sleep_cv_.notify_one();
+		}
+
+		// one lock per destination queue and one wake-up round for the
+		// whole batch instead of per-task signaling
+		void submit_batch(std::vector<task_type> tasks)
+		{
+			if (tasks.empty())
+				return;
+
+			const size_t v_queues = queues_.size();
+			for (size_t i = 0; i < tasks.size();)
+			{
+				const unsigned v_index = next_queue_.fetch_add(1, std::memory_order_relaxed) % v_queues;
+				const size_t v_take = (tasks.size() - i + v_queues - 1) / v_queues;
+
+				std::lock_guard<std::mutex> v_guard(queues_[v_index]->lock);
+				for (size_t j = 0; j < v_take && i < tasks.size(); ++j, ++i)
+					queues_[v_index]->tasks.emplace_back(std::move(tasks[i]));
+			}
+			sleep_cv_.notify_all();
+		}
+
+		// runs pool work on the calling thread until done() turns true --
+		// the join half of fork-join, safe to call from a worker because
+		// the waiter helps instead of blocking the deque it owns
+		template<typename done_type>
+		void help_until(done_type&& done)
+		{
+			task_type v_task;
+			while (!done())
+			{
+				if (take_any(v_task))
+					v_task();
+				else
+					std::this_thread::yield();
+			}
+		}
+
+		// forked task set joined by wait(); wait() helps, so nested groups
+		// inside pool tasks cannot starve the pool
+		class task_group : private noncopyable
+		{
+		public:
+			explicit task_group(thread_pool& pool)
+				: pool_(pool)
+			{ }
+
+			template<typename body_type>
+			void run(body_type&& body)
+			{
+				pending_.fetch_add(1, std::memory_order_relaxed);
+				pool_.submit([this, v_body = std::forward<body_type>(body)]() mutable
+				{
+					v_body();
+					pending_.fetch_sub(1, std::memory_order_release);
+				});
+			}
+
+			void wait()
+			{
+				pool_.help_until([this] { return pending_.load(std::memory_order_acquire) == 0; });
+			}
+
+		private:
+			thread_pool& pool_;
+			std::atomic<size_t> pending_ = 0;
+		};
+
+		// chunks [begin, end) by grain and joins before returning; the
+		// calling thread works on chunks too instead of just waiting
+		template<typename index_type, typename body_type>
+		void parallel_for(index_type begin, index_type end, index_type grain, body_type&& body)
+		{
+			if (begin >= end)
+				return;
+			if (grain < 1)
+				grain = 1;
+
+			task_group v_group(*this);
+			for (index_type i = begin; i < end; i += grain)
+			{
+				const index_type v_first = i;
+				const index_type v_last = (end - i > grain) ? static_cast<index_type>(i + grain) : end;
+				v_group.run([v_first, v_last, &body] { body(v_first, v_last); });
+			}
+			v_group.wait();
+		}
+
+	private:
+		static constexpr unsigned k_invalid_index = ~0u;
+
+		struct worker_queue
+		{
+			std::mutex lock;
+			std::deque<task_type> tasks;
+		};
+
+		bool take_own(unsigned index, task_type& out)
+		{
+			auto& v_queue = *queues_[index];
+			std::lock_guard<std::mutex> v_guard(v_queue.lock);
+			if (v_queue.tasks.empty())
+				return false;
+
+			out = std::move(v_queue.tasks.back());
+			v_queue.tasks.pop_back();
+			return true;
+		}
+
+		bool take_stolen(unsigned thief, task_type& out)
+		{
+			const size_t v_queues = queues_.size();
+			for (size_t i = 1; i < v_queues; ++i)
+			{
+				auto& v_queue = *queues_[(thief + i) % v_queues];
+				std::lock_guard<std::mutex> v_guard(v_queue.lock);
+				if (v_queue.tasks.empty())
+					continue;
+
+				out = std::move(v_queue.tasks.front());
+				v_queue.tasks.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		bool take_any(task_type& out)
+		{
+			const unsigned v_index = (worker_index_ != k_invalid_index) ? worker_index_ : 0;
+			return take_own(v_index, out) || take_stolen(v_index, out);
+		}
+
+		void worker_main(unsigned index)
+		{
+			worker_index_ = index;
+
+			task_type v_task;
+			for (;;)
+			{
+				if (take_own(index, v_task) || take_stolen(index, v_task))
+				{
+					v_task();
+					v_task = nullptr;
+					continue;
+				}
+
+				std::unique_lock<std::mutex> v_guard(sleep_lock_);
+				if (stop_)
+					break;
+				sleep_cv_.wait_for(v_guard, std::chrono::milliseconds(10));
+			}
+		}
+
+		inline static thread_local unsigned worker_index_ = k_invalid_index;
+
+		std::vector<std::unique_ptr<worker_queue>> queues_;
+		std::vector<std::thread> workers_;
+		std::atomic<unsigned> next_queue_ = 0;
+		bool stop_ = false;
+		std::mutex sleep_lock_;
+		std::condition_variable sleep_cv_;
+	};
+
+	// the project-wide pool: blackbone-layer and bee-layer code share the
+	// same workers through this accessor
+	inline thread_pool& shared_thread_pool()
+	{
+		return singleton_atomic<thread_pool>::instance();
+	}
+}
@@ -0,0 +1,93 @@
+// OffsetPackTool: one-pass builder for the compressed offset
+// distribution format (LODC). Reads a flat offsets.db (LODB) and emits
+// the pack pushed to seats on patch day.
+// Usage: OffsetPackTool.exe <offsets.db> <offsets.pack>
+#include <OffsetPackFormat.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+	//Flat database layout, mirrors OffsetDatabase ('LODB')
+	constexpr uint32_t k_db_magic = 0x42444F4C;
+	constexpr uint32_t k_db_format = 1;
+
+#pragma pack(push, 1)
+	struct DbHeader
+	{
+		uint32_t magic;
+		uint32_t format;
+		uint32_t record_count;
+	};
+
+	struct DbRecord
+	{
+		uint16_t version[4];
+		uint64_t offsets[k_offset_pack_slot_count];
+	};
+#pragma pack(pop)
+
+	auto LoadFile(const wchar_t* path) -> std::vector<uint8_t>
+	{
+		std::ifstream v_file(path, std::ios::binary | std::ios::ate);
+		if (!v_file.is_open())
+			return {};
+
+		const auto v_size = static_cast<size_t>(v_file.tellg());
+		std::vector<uint8_t> v_data(v_size);
+		v_file.seekg(0);
+		v_file.read(reinterpret_cast<char*>(v_data.data()), v_size);
+		return v_data;
+	}
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+	if (argc != 3)
+	{
+		wprintf(L"usage: OffsetPackTool.exe <offsets.db> <offsets.pack>\n");
+		return 1;
+	}
+
+	const auto v_db = LoadFile(argv[1]);
+	if (v_db.size() < sizeof(DbHeader))
+	{
+		wprintf(L"cannot read %s\n", argv[1]);
+		return 1;
+	}
+
+	const auto* v_header = reinterpret_cast<const DbHeader*>(v_db.data());
+	if (v_header->magic != k_db_magic || v_header->format != k_db_format
+		|| v_db.size() < sizeof(DbHeader) + static_cast<size_t>(v_header->record_count) * sizeof(DbRecord))
+	{
+		wprintf(L"%s is not a flat offset database\n", argv[1]);
+		return 1;
+	}
+
+	//One pass: every record goes straight into the builder, which sorts
+	//the index and grows the signature dictionary as entries arrive
+	OffsetPackBuilder v_builder;
+	const auto* v_records = reinterpret_cast<const DbRecord*>(v_db.data() + sizeof(DbHeader));
+	for (uint32_t i = 0; i < v_header->record_count; ++i)
+	{
+		OffsetPackBuilder::Entry v_entry = {};
+		memcpy(v_entry._version_, v_records[i].version, sizeof(v_entry._version_));
+		memcpy(v_entry._offsets_, v_records[i].offsets, sizeof(v_entry._offsets_));
+		v_builder.Add(std::move(v_entry));
+	}
+
+	const auto v_pack = v_builder.Build();
+
+	std::ofstream v_out(argv[2], std::ios::binary | std::ios::trunc);
+	if (!v_out.is_open())
+	{
+		wprintf(L"cannot write %s\n", argv[2]);
+		return 1;
+	}
+	v_out.write(reinterpret_cast<const char*>(v_pack.data()), static_cast<std::streamsize>(v_pack.size()));
+
+	wprintf(L"%u records, %zu -> %zu bytes\n", v_header->record_count, v_db.size(), v_pack.size());
+	return 0;
+}
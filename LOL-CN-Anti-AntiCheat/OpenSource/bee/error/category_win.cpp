@@ -1,6 +1,10 @@
 #include <bee/error/category_win.h>
 #include <bee/utility/unicode_win.h>
+#include <list>
+#include <mutex>
 #include <sstream>
+#include <stdio.h>
+#include <unordered_map>
 #include <Windows.h>
 
 namespace bee {
@@ -33,13 +37,44 @@ namespace bee {
         return std::wstring(str);
     }
 
+    // FormatMessage loads and searches message resources; a failure storm
+    // (thousands of identical access-denied statuses) repeats the same
+    // handful of codes, so an LRU makes the repeats a lock plus hash probe
+    static const size_t kMessageCacheCapacity = 64;
+    static std::mutex g_message_lock;
+    static std::list<std::pair<int, std::string>> g_message_lru;
+    static std::unordered_map<int, std::list<std::pair<int, std::string>>::iterator> g_message_index;
+
+    static std::string cached_error_message(int error_code) {
+        std::lock_guard<std::mutex> lock(g_message_lock);
+        auto it = g_message_index.find(error_code);
+        if (it != g_message_index.end()) {
+            g_message_lru.splice(g_message_lru.begin(), g_message_lru, it->second);
+            return it->second->second;
+        }
+        std::string msg = w2u(error_message(error_code));
+        g_message_lru.emplace_front(error_code, msg);
+        g_message_index[error_code] = g_message_lru.begin();
+        if (g_message_lru.size() > kMessageCacheCapacity) {
+            g_message_index.erase(g_message_lru.back().first);
+            g_message_lru.pop_back();
+        }
+        return msg;
+    }
+
+    std::string error_brief(int error_code) noexcept {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "error 0x%08X", (unsigned)error_code);
+        return buf;
+    }
+
     class winCategory : public std::error_category {
     public:
         virtual const char* name() const noexcept {
             return "Windows";
         }
         virtual std::string message(int error_code) const noexcept {
-            return std::move(w2u(error_message(error_code)));
+            return cached_error_message(error_code);
         }
         virtual std::error_condition default_error_condition(int error_code) const noexcept {
             const std::error_condition cond = std::system_category().default_error_condition(error_code);
@@ -4,4 +4,7 @@
 
 namespace bee {
     const std::error_category& windows_category() noexcept;
+    // numeric-only form for hot paths: never touches FormatMessage or the
+    // message resources, just prints the code
+    std::string error_brief(int error_code) noexcept;
 }
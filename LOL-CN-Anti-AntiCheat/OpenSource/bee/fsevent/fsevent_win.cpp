@@ -139,13 +139,13 @@ namespace bee::win::fsevent {
             std::wstring path(fni.FileName, fni.FileNameLength / sizeof(wchar_t));
             switch (fni.Action) {
             case FILE_ACTION_MODIFIED:
-                push_notify(tasktype::Modify, (m_path / path).wstring());
+                m_watch->queue_file_notify(tasktype::Modify, (m_path / path).wstring());
                 break;
             case FILE_ACTION_ADDED:
             case FILE_ACTION_REMOVED:
             case FILE_ACTION_RENAMED_OLD_NAME:
             case FILE_ACTION_RENAMED_NEW_NAME:
-                push_notify(tasktype::Rename, (m_path / path).wstring());
+                m_watch->queue_file_notify(tasktype::Rename, (m_path / path).wstring());
                 break;
             default:
                 assert(false);
@@ -169,9 +169,16 @@ namespace bee::win::fsevent {
         : m_thread()
         , m_apc_queue()
         , m_notify()
+        , m_batches()
         , m_gentask(kInvalidTaskId)
         , m_tasks()
         , m_terminate(false)
+        , m_coalesce_window(100)
+        , m_pending()
+        , m_pending_index()
+        , m_pending_start(0)
+        , m_selected()
+        , m_selected_pos(0)
     { }
 
     watch::~watch() {
@@ -207,8 +214,40 @@ namespace bee::win::fsevent {
 
     void watch::thread_cb() {
         while (!m_terminate || !m_tasks.empty()) {
-            ::SleepEx(INFINITE, true);
+            // wake on the window deadline while a batch is accumulating,
+            // otherwise only on completions and APCs
+            ::SleepEx(m_pending.empty() ? INFINITE : m_coalesce_window, true);
+            flush_pending(m_terminate);
         }
+        flush_pending(true);
+    }
+
+    void watch::queue_file_notify(tasktype type, std::wstring&& path) {
+        if (m_pending.empty()) {
+            m_pending_start = ::GetTickCount64();
+        }
+        auto it = m_pending_index.find(path);
+        if (it != m_pending_index.end()) {
+            // coalesce repeats of the same path; Rename wins over Modify
+            if (type == tasktype::Rename) {
+                m_pending[it->second].type = tasktype::Rename;
+            }
+            return;
+        }
+        m_pending_index.emplace(path, m_pending.size());
+        m_pending.push_back({ type, std::move(path) });
+    }
+
+    void watch::flush_pending(bool force) {
+        if (m_pending.empty()) {
+            return;
+        }
+        if (!force && ::GetTickCount64() - m_pending_start < m_coalesce_window) {
+            return;
+        }
+        m_batches.push(std::move(m_pending));
+        m_pending.clear();
+        m_pending_index.clear();
     }
 
     void watch::stop() {
@@ -318,6 +357,26 @@ namespace bee::win::fsevent {
     }
 
     bool watch::select(notify& n) {
-        return m_notify.pop(n);
+        // control messages first, then records peeled off the current batch
+        if (m_notify.pop(n)) {
+            return true;
+        }
+        if (m_selected_pos >= m_selected.size()) {
+            m_selected.clear();
+            m_selected_pos = 0;
+            if (!m_batches.pop(m_selected)) {
+                return false;
+            }
+        }
+        n = std::move(m_selected[m_selected_pos++]);
+        return true;
+    }
+
+    bool watch::select_batch(std::vector<notify>& batch) {
+        return m_batches.pop(batch);
+    }
+
+    void watch::set_coalesce_window(unsigned ms) {
+        m_coalesce_window = ms;
     }
 }
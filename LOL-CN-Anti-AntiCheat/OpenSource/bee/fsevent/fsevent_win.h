@@ -1,9 +1,12 @@
 #pragma once
 
+#include <stdint.h>
 #include <string>
 #include <map>
 #include <memory>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 #include <bee/utility/lockqueue.h>
 
 namespace bee::win::fsevent {
@@ -32,9 +35,16 @@ namespace bee::win::fsevent {
         taskid add(const std::wstring& path);
         bool   remove(taskid id);
         bool   select(notify& notify);
+        // drains one deduplicated batch of file events; records for the same
+        // path within the coalescing window are merged into a single entry
+        bool   select_batch(std::vector<notify>& batch);
+        // how long file events accumulate before a batch is delivered;
+        // call before add(). 0 delivers one batch per completion
+        void   set_coalesce_window(unsigned ms);
 
     public:
         void   apc_cb();
+        void   queue_file_notify(tasktype type, std::wstring&& path);
 
     private:
         struct apc_arg {
@@ -54,13 +64,23 @@ namespace bee::win::fsevent {
         bool thread_init();
         bool thread_signal();
         void thread_cb();
+        void flush_pending(bool force);
 
     private:
         std::unique_ptr<std::thread>            m_thread;
         lockqueue<apc_arg>                      m_apc_queue;
         lockqueue<notify>                       m_notify;
+        lockqueue<std::vector<notify>>          m_batches;
         taskid                                  m_gentask;
         std::map<taskid, std::unique_ptr<task>> m_tasks;
         bool                                    m_terminate;
+        unsigned                                m_coalesce_window;
+        // watcher-thread only: the batch being accumulated
+        std::vector<notify>                     m_pending;
+        std::unordered_map<std::wstring, size_t> m_pending_index;
+        uint64_t                                m_pending_start;
+        // consumer-side cursor so select() can keep serving single records
+        std::vector<notify>                     m_selected;
+        size_t                                  m_selected_pos;
     };
 }
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <lua.hpp>
+#include <bee/lua/binding.h>
+#include <bee/utility/file_helper.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace bee::lua {
+    // userdata-backed read-only view over mapped or in-process memory.
+    // scripts index the bytes in place through bounds-checked accessors,
+    // so iterating a multi-MB module dump no longer round-trips every
+    // access through a Lua string copy; only the slices a script
+    // explicitly asks for with str() enter the Lua GC
+    struct memview {
+        const uint8_t* data;
+        size_t         size;
+        file::view     mapping; // engaged when the view owns the file mapping
+
+        // positions are 1-based like Lua strings; returns data + (pos-1)
+        // or raises on any access outside [1, size - len + 1]
+        const uint8_t* at(lua_State* L, lua_Integer pos, lua_Integer len) const {
+            if (pos < 1 || len < 0 || (size_t)len > size || (size_t)pos > size - (size_t)len + 1) {
+                luaL_error(L, "view access out of bounds: pos %I len %I size %I", pos, len, (lua_Integer)size);
+            }
+            return data + (pos - 1);
+        }
+    };
+
+    inline memview* toview(lua_State* L, int idx) {
+        return static_cast<memview*>(getObject(L, idx, "view"));
+    }
+
+    namespace view_detail {
+        inline int size(lua_State* L) {
+            lua_pushinteger(L, (lua_Integer)toview(L, 1)->size);
+            return 1;
+        }
+
+        inline int byte(lua_State* L) {
+            memview* self = toview(L, 1);
+            lua_pushinteger(L, *self->at(L, luaL_checkinteger(L, 2), 1));
+            return 1;
+        }
+
+        template <class T>
+        inline int uint(lua_State* L) {
+            memview* self = toview(L, 1);
+            T v;
+            memcpy(&v, self->at(L, luaL_checkinteger(L, 2), sizeof(T)), sizeof(T));
+            lua_pushinteger(L, (lua_Integer)v);
+            return 1;
+        }
+
+        // the one deliberate copy: lift a slice into a Lua string
+        inline int str(lua_State* L) {
+            memview* self = toview(L, 1);
+            lua_Integer pos = luaL_optinteger(L, 2, 1);
+            lua_Integer len = luaL_optinteger(L, 3, (lua_Integer)self->size - pos + 1);
+            lua_pushlstring(L, (const char*)self->at(L, pos, len), (size_t)len);
+            return 1;
+        }
+
+        inline int find(lua_State* L) {
+            memview* self = toview(L, 1);
+            size_t needlelen = 0;
+            const char* needle = luaL_checklstring(L, 2, &needlelen);
+            lua_Integer init = luaL_optinteger(L, 3, 1);
+            if (needlelen == 0 || (size_t)init > self->size) {
+                lua_pushnil(L);
+                return 1;
+            }
+            const uint8_t* first = self->at(L, init, 0);
+            const uint8_t* found = std::search(first, self->data + self->size, (const uint8_t*)needle, (const uint8_t*)needle + needlelen);
+            if (found == self->data + self->size) {
+                lua_pushnil(L);
+                return 1;
+            }
+            lua_pushinteger(L, found - self->data + 1);
+            return 1;
+        }
+
+        inline int destroy(lua_State* L) {
+            toview(L, 1)->~memview();
+            return 0;
+        }
+
+        inline int sub(lua_State* L);
+
+        inline void metatable(lua_State* L) {
+            if (newObject(L, "view")) {
+                static luaL_Reg mt[] = {
+                    { "size", size },
+                    { "byte", byte },
+                    { "u16",  uint<uint16_t> },
+                    { "u32",  uint<uint32_t> },
+                    { "u64",  uint<uint64_t> },
+                    { "str",  str },
+                    { "sub",  sub },
+                    { "find", find },
+                    { NULL, NULL },
+                };
+                luaL_newlibtable(L, mt);
+                luaL_setfuncs(L, mt, 0);
+                lua_setfield(L, -2, "__index");
+                lua_pushcclosure(L, size, 0);
+                lua_setfield(L, -2, "__len");
+                lua_pushcclosure(L, destroy, 0);
+                lua_setfield(L, -2, "__gc");
+            }
+            lua_setmetatable(L, -2);
+        }
+    }
+
+    // non-owning view; the memory must outlive the userdata unless an
+    // anchor on the Lua stack is named via anchoridx (kept as uservalue)
+    inline int newview(lua_State* L, const void* data, size_t size, int anchoridx = 0) {
+        if (anchoridx) {
+            anchoridx = lua_absindex(L, anchoridx);
+        }
+        memview* self = static_cast<memview*>(lua_newuserdatauv(L, sizeof(memview), 1));
+        new (self) memview { (const uint8_t*)data, size };
+        view_detail::metatable(L);
+        if (anchoridx) {
+            lua_pushvalue(L, anchoridx);
+            lua_setiuservalue(L, -2, 1);
+        }
+        return 1;
+    }
+
+    // owning view; the file mapping lives exactly as long as the userdata
+    inline int newview(lua_State* L, file::view&& v) {
+        memview* self = static_cast<memview*>(lua_newuserdatauv(L, sizeof(memview), 1));
+        new (self) memview { v.data(), v.size(), std::move(v) };
+        view_detail::metatable(L);
+        return 1;
+    }
+
+    namespace view_detail {
+        // zero-copy slice; the parent userdata is anchored as uservalue so
+        // a child can outlive every other reference to its mapping
+        inline int sub(lua_State* L) {
+            memview* self = toview(L, 1);
+            lua_Integer pos = luaL_checkinteger(L, 2);
+            lua_Integer len = luaL_optinteger(L, 3, (lua_Integer)self->size - pos + 1);
+            const uint8_t* first = self->at(L, pos, len);
+            return newview(L, first, (size_t)len, 1);
+        }
+    }
+}
@@ -11,6 +11,10 @@
 #endif
 #include <bee/utility/format.h>
 #include <bee/error.h>
+#include <limits>
+#include <mutex>
+#include <time.h>
+#include <unordered_map>
 #if __has_include(<charconv>)
 #   include <charconv>
 #endif
@@ -118,6 +122,48 @@ namespace bee::net {
         memcpy(ep.data(), addrinfo.ai_addr, ep.size());
         return std::move(ep);
     }
+    namespace {
+        struct resolve_entry {
+            endpoint ep;
+            uint64_t expire;
+        };
+        std::mutex resolve_lock;
+        std::unordered_map<std::string, resolve_entry> resolve_cache;
+    }
+
+    nonstd::expected<endpoint, std::string> endpoint::from_hostname_cached(const std::string_view& ip, int port, unsigned ttl_seconds) {
+        std::string key = std::string(ip) + ':' + std::to_string(port);
+        uint64_t now = (uint64_t)::time(NULL);
+        {
+            std::lock_guard<std::mutex> lock(resolve_lock);
+            auto it = resolve_cache.find(key);
+            if (it != resolve_cache.end() && now < it->second.expire) {
+                return it->second.ep;
+            }
+        }
+        auto ep = from_hostname(ip, port);
+        if (ep) {
+            // a numeric address cannot go stale; everything else re-resolves
+            // after the TTL so DNS changes are eventually picked up
+            uint64_t expire = needsnolookup(ip)
+                ? (std::numeric_limits<uint64_t>::max)()
+                : now + ttl_seconds;
+            std::lock_guard<std::mutex> lock(resolve_lock);
+            resolve_cache.insert_or_assign(key, resolve_entry { *ep, expire });
+        }
+        return ep;
+    }
+
+    endpoint endpoint::from_ipv4(uint32_t addr_host_order, int port) {
+        endpoint ep(sizeof(struct sockaddr_in));
+        struct sockaddr_in* sa = (struct sockaddr_in*)ep.data();
+        memset(sa, 0, sizeof(*sa));
+        sa->sin_family = AF_INET;
+        sa->sin_port = htons((uint16_t)port);
+        sa->sin_addr.s_addr = htonl(addr_host_order);
+        return ep;
+    }
+
     endpoint endpoint::from_empty() {
         return endpoint(endpoint::kMaxSize);
     }
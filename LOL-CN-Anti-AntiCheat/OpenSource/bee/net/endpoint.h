@@ -32,6 +32,12 @@ namespace bee::net {
         int             family() const;
 
         static nonstd::expected<endpoint, std::string> from_hostname(const std::string_view& ip, int port);
+        // repeats of the same (name, port) within the TTL skip the resolver
+        // entirely; numeric addresses never expire
+        static nonstd::expected<endpoint, std::string> from_hostname_cached(const std::string_view& ip, int port, unsigned ttl_seconds = 300);
+        // static IPv4:port endpoints, e.g. from_ipv4(0x7F000001, 80) for
+        // 127.0.0.1:80 — no string parsing and no resolver at all
+        static endpoint                                from_ipv4(uint32_t addr_host_order, int port);
         static nonstd::expected<endpoint, std::string> from_unixpath(const std::string_view& path);
         static endpoint                                from_empty();
 
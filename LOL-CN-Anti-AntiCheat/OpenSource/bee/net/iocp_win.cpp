@@ -0,0 +1,154 @@
+#include <winsock2.h>
+#include <mswsock.h>
+#include <bee/net/iocp_win.h>
+#include <bee/net/endpoint.h>
+#include <memory>
+#include <string.h>
+
+namespace bee::net::iocp {
+    struct engine::operation : OVERLAPPED {
+        enum class type {
+            accept,
+            recv,
+            send,
+        };
+        type                    kind;
+        engine::io_callback     done;
+        engine::accept_callback accepted;
+        socket::fd_t            acceptfd;
+        // AcceptEx wants room for both addresses plus 16 bytes each
+        char                    addrbuf[2 * (sizeof(sockaddr_storage) + 16)];
+
+        operation(type t)
+            : kind(t)
+            , done()
+            , accepted()
+            , acceptfd(socket::retired_fd)
+        {
+            memset((OVERLAPPED*)this, 0, sizeof(OVERLAPPED));
+        }
+    };
+
+    static LPFN_ACCEPTEX get_acceptex(SOCKET s) {
+        static LPFN_ACCEPTEX fn = NULL;
+        if (!fn) {
+            GUID guid = WSAID_ACCEPTEX;
+            DWORD bytes = 0;
+            ::WSAIoctl(s, SIO_GET_EXTENSION_FUNCTION_POINTER,
+                &guid, sizeof(guid), &fn, sizeof(fn), &bytes, NULL, NULL);
+        }
+        return fn;
+    }
+
+    engine::engine()
+        : m_port(::CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1))
+    { }
+
+    engine::~engine() {
+        if (m_port) {
+            ::CloseHandle(m_port);
+        }
+    }
+
+    bool engine::ok() const {
+        return m_port != NULL;
+    }
+
+    bool engine::attach(socket::fd_t s) {
+        if (!ok()) {
+            return false;
+        }
+        // the socket itself is the completion key
+        return NULL != ::CreateIoCompletionPort((HANDLE)s, m_port, (ULONG_PTR)s, 0);
+    }
+
+    bool engine::recv(socket::fd_t s, char* buf, size_t len, io_callback done) {
+        auto op = std::make_unique<operation>(operation::type::recv);
+        op->done = std::move(done);
+        WSABUF wsabuf = { (ULONG)len, buf };
+        DWORD flags = 0;
+        if (::WSARecv(s, &wsabuf, 1, NULL, &flags, op.get(), NULL) == SOCKET_ERROR
+            && ::WSAGetLastError() != WSA_IO_PENDING) {
+            return false;
+        }
+        op.release();
+        return true;
+    }
+
+    bool engine::send(socket::fd_t s, const char* buf, size_t len, io_callback done) {
+        auto op = std::make_unique<operation>(operation::type::send);
+        op->done = std::move(done);
+        WSABUF wsabuf = { (ULONG)len, const_cast<char*>(buf) };
+        if (::WSASend(s, &wsabuf, 1, NULL, 0, op.get(), NULL) == SOCKET_ERROR
+            && ::WSAGetLastError() != WSA_IO_PENDING) {
+            return false;
+        }
+        op.release();
+        return true;
+    }
+
+    bool engine::accept(socket::fd_t listener, accept_callback done) {
+        LPFN_ACCEPTEX acceptex = get_acceptex(listener);
+        if (!acceptex) {
+            return false;
+        }
+        endpoint ep = endpoint::from_empty();
+        if (!socket::getsockname(listener, ep)) {
+            return false;
+        }
+        SOCKET fd = ::WSASocketW(ep.family(), SOCK_STREAM, 0, 0, 0, WSA_FLAG_NO_HANDLE_INHERIT);
+        if (fd == INVALID_SOCKET) {
+            return false;
+        }
+        auto op = std::make_unique<operation>(operation::type::accept);
+        op->accepted = std::move(done);
+        op->acceptfd = fd;
+        DWORD bytes = 0;
+        if (!acceptex(listener, fd, op->addrbuf, 0,
+            sizeof(sockaddr_storage) + 16, sizeof(sockaddr_storage) + 16,
+            &bytes, op.get())
+            && ::WSAGetLastError() != WSA_IO_PENDING) {
+            ::closesocket(fd);
+            return false;
+        }
+        op.release();
+        return true;
+    }
+
+    size_t engine::run_once(unsigned timeout_ms) {
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        LPOVERLAPPED overlapped = NULL;
+        BOOL suc = ::GetQueuedCompletionStatus(m_port, &bytes, &key, &overlapped, timeout_ms);
+        if (!overlapped) {
+            // timeout, or a bare wakeup posted without an operation
+            return 0;
+        }
+        int error = suc ? 0 : (int)::GetLastError();
+        std::unique_ptr<operation> op((operation*)overlapped);
+        switch (op->kind) {
+        case operation::type::accept:
+            if (error == 0) {
+                // inherit the listener's properties so shutdown/getpeername work
+                SOCKET listener = (SOCKET)key;
+                ::setsockopt(op->acceptfd, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT,
+                    (const char*)&listener, sizeof(listener));
+            }
+            else if (op->acceptfd != socket::retired_fd) {
+                ::closesocket(op->acceptfd);
+                op->acceptfd = socket::retired_fd;
+            }
+            op->accepted(op->acceptfd, error);
+            break;
+        case operation::type::recv:
+        case operation::type::send:
+            op->done(bytes, error);
+            break;
+        }
+        return 1;
+    }
+
+    void engine::post_wakeup() {
+        ::PostQueuedCompletionStatus(m_port, 0, 0, NULL);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <bee/net/socket.h>
+#include <functional>
+
+namespace bee::net::iocp {
+    // completion-port engine: overlapped accept/recv/send with a callback
+    // per operation, so one thread drives every channel from a single
+    // blocking dequeue instead of readiness polling. Attach a socket once,
+    // then issue operations; run_once() dispatches finished ones
+    class engine {
+    public:
+        typedef std::function<void(size_t bytes, int error)> io_callback;
+        typedef std::function<void(socket::fd_t fd, int error)> accept_callback;
+
+        engine();
+        ~engine();
+        engine(const engine& other) = delete;
+        engine& operator = (const engine& other) = delete;
+
+        bool ok() const;
+        bool attach(socket::fd_t s);
+        bool recv(socket::fd_t s, char* buf, size_t len, io_callback done);
+        bool send(socket::fd_t s, const char* buf, size_t len, io_callback done);
+        bool accept(socket::fd_t listener, accept_callback done);
+        // blocks up to timeout_ms; returns the number of completions
+        // dispatched (0 on timeout)
+        size_t run_once(unsigned timeout_ms);
+        // wakes a blocked run_once without a completion
+        void post_wakeup();
+
+    private:
+        struct operation;
+
+    private:
+        void* m_port;
+    };
+}
@@ -0,0 +1,184 @@
+#include <winsock2.h>
+#include <bee/net/shmchannel_win.h>
+#include <bee/net/endpoint.h>
+#include <bee/subprocess/sharedmemory_win.h>
+#include <atomic>
+#include <string.h>
+
+namespace bee::net::shm {
+    static const uint32_t kChannelMagic = 'BSHM';
+
+    // single-producer single-consumer byte ring; head/tail are free-running
+    // counters, so empty is head == tail and full is tail - head == capacity
+    struct channel::ring {
+        std::atomic<uint32_t> head;
+        std::atomic<uint32_t> tail;
+        char data[1];
+    };
+
+    struct channel_header {
+        uint32_t magic;
+        uint32_t capacity;
+    };
+
+    static size_t ring_bytes(size_t capacity) {
+        return offsetof(channel::ring, data) + capacity;
+    }
+
+    // the section name derives from the client's ephemeral port: unique per
+    // connection, and known to both ends without exchanging protocol bytes
+    static std::wstring section_name(socket::fd_t s, bool server) {
+        endpoint ep = endpoint::from_empty();
+        bool suc = server
+            ? socket::getpeername(s, ep)
+            : socket::getsockname(s, ep);
+        if (!suc) {
+            return std::wstring();
+        }
+        wchar_t name[64];
+        swprintf_s(name, L"Local\\bee_usock_%d", ep.info().port);
+        return name;
+    }
+
+    channel::channel()
+        : m_section()
+        , m_socket(socket::retired_fd)
+        , m_server(false)
+    { }
+
+    channel::~channel()
+    { }
+
+    bool channel::create(socket::fd_t s, size_t capacity) {
+        auto name = section_name(s, true);
+        if (name.empty()) {
+            return false;
+        }
+        m_section.reset(new bee::win::subprocess::sharedmemory(
+            bee::win::subprocess::create_only,
+            name.c_str(),
+            sizeof(channel_header) + 2 * ring_bytes(capacity)));
+        if (!m_section->ok()) {
+            m_section.reset();
+            return false;
+        }
+        auto* header = (channel_header*)m_section->data();
+        header->capacity = (uint32_t)capacity;
+        sendring()->head.store(0, std::memory_order_relaxed);
+        sendring()->tail.store(0, std::memory_order_relaxed);
+        recvring()->head.store(0, std::memory_order_relaxed);
+        recvring()->tail.store(0, std::memory_order_relaxed);
+        // the magic is published last so open() never sees a half-built ring
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = kChannelMagic;
+        m_socket = s;
+        m_server = true;
+        return true;
+    }
+
+    bool channel::open(socket::fd_t s) {
+        auto name = section_name(s, false);
+        if (name.empty()) {
+            return false;
+        }
+        // the server creates the section after accept(); allow it a moment
+        for (int retry = 0; retry < 50; ++retry) {
+            m_section.reset(new bee::win::subprocess::sharedmemory(
+                bee::win::subprocess::open_only,
+                name.c_str()));
+            if (m_section->ok()) {
+                auto* header = (channel_header*)m_section->data();
+                if (header->magic == kChannelMagic) {
+                    m_socket = s;
+                    m_server = false;
+                    return true;
+                }
+            }
+            ::Sleep(1);
+        }
+        m_section.reset();
+        return false;
+    }
+
+    bool channel::ok() const {
+        return !!m_section;
+    }
+
+    channel::ring* channel::sendring() const {
+        auto* header = (channel_header*)m_section->data();
+        char* base = (char*)(header + 1);
+        // server writes ring 0, client writes ring 1
+        return (ring*)(m_server ? base : base + ring_bytes(header->capacity));
+    }
+
+    channel::ring* channel::recvring() const {
+        auto* header = (channel_header*)m_section->data();
+        char* base = (char*)(header + 1);
+        return (ring*)(m_server ? base + ring_bytes(header->capacity) : base);
+    }
+
+    size_t channel::write(const char* data, size_t len) {
+        if (!ok()) {
+            return 0;
+        }
+        auto* header = (channel_header*)m_section->data();
+        ring* r = sendring();
+        uint32_t capacity = header->capacity;
+        uint32_t head = r->head.load(std::memory_order_acquire);
+        uint32_t tail = r->tail.load(std::memory_order_relaxed);
+        uint32_t used = tail - head;
+        size_t n = capacity - used;
+        if (n > len) {
+            n = len;
+        }
+        if (n == 0) {
+            return 0;
+        }
+        uint32_t pos = tail % capacity;
+        size_t first = capacity - pos;
+        if (first > n) {
+            first = n;
+        }
+        memcpy(r->data + pos, data, first);
+        memcpy(r->data, data + first, n - first);
+        r->tail.store(tail + (uint32_t)n, std::memory_order_release);
+        if (used == 0) {
+            // the peer may be asleep on the socket; post a wakeup byte
+            int rc = 0;
+            char wakeup = 1;
+            socket::send(m_socket, rc, &wakeup, 1);
+        }
+        return n;
+    }
+
+    size_t channel::read(char* data, size_t len) {
+        if (!ok()) {
+            return 0;
+        }
+        auto* header = (channel_header*)m_section->data();
+        ring* r = recvring();
+        uint32_t capacity = header->capacity;
+        uint32_t head = r->head.load(std::memory_order_relaxed);
+        uint32_t tail = r->tail.load(std::memory_order_acquire);
+        size_t n = tail - head;
+        if (n > len) {
+            n = len;
+        }
+        if (n == 0) {
+            return 0;
+        }
+        uint32_t pos = head % capacity;
+        size_t first = capacity - pos;
+        if (first > n) {
+            first = n;
+        }
+        memcpy(data, r->data + pos, first);
+        memcpy(data + first, r->data, n - first);
+        r->head.store(head + (uint32_t)n, std::memory_order_release);
+        // swallow wakeup bytes so the socket does not stay readable
+        int rc = 0;
+        char drain[16];
+        socket::recv(m_socket, rc, drain, sizeof(drain));
+        return n;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <bee/net/socket.h>
+#include <memory>
+
+namespace bee::win::subprocess {
+    class sharedmemory;
+}
+
+namespace bee::net::shm {
+    // same-host fast path for the emulated unix socket: after the loopback
+    // handshake both ends attach a shared-memory section holding one ring
+    // per direction, and bulk payload moves through the rings zero-copy
+    // while the socket is kept only for wakeups and connection lifetime.
+    // The section name derives from the client's ephemeral port, so both
+    // ends find it without extra protocol bytes; when the peer never
+    // created a section, open() fails and the caller stays on the socket
+    class channel {
+    public:
+        channel();
+        ~channel();
+        channel(const channel& other) = delete;
+        channel& operator = (const channel& other) = delete;
+
+        // server side, call after accept(); creates the section
+        bool create(socket::fd_t s, size_t capacity = 1 << 20);
+        // client side, call after connect(); waits briefly for the server
+        // to create the section, then gives up
+        bool open(socket::fd_t s);
+        bool ok() const;
+
+        // nonblocking; both return the number of bytes moved. write posts
+        // a one-byte wakeup on the socket when the ring was empty, read
+        // drains pending wakeup bytes
+        size_t write(const char* data, size_t len);
+        size_t read(char* data, size_t len);
+
+    private:
+        struct ring;
+        ring* sendring() const;
+        ring* recvring() const;
+
+    private:
+        std::unique_ptr<bee::win::subprocess::sharedmemory> m_section;
+        socket::fd_t m_socket;
+        bool         m_server;
+    };
+}
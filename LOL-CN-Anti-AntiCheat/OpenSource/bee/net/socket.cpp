@@ -10,6 +10,7 @@
 #   include <netinet/tcp.h>
 #   include <signal.h>
 #   include <netinet/in.h>
+#   include <sys/uio.h>
 #   include <unistd.h>
 #   if defined(__APPLE__)
 #       include <sys/ioctl.h>
@@ -20,6 +21,7 @@
 #include <bee/net/endpoint.h>
 #include <bee/error.h>
 #include <assert.h>
+#include <string.h>
 
 #if defined(_WIN32)
 #    define net_success(x) ((x) != SOCKET_ERROR)
@@ -381,6 +383,69 @@ namespace bee::net::socket {
         return status::success;
     }
 
+    status sendv(fd_t s, int& rc, nonstd::span<const iobuf> bufs, size_t coalesce) {
+        static const size_t kMaxFragments = 64;
+        static const size_t kMaxCoalesce = 4096;
+        size_t total = 0;
+        for (auto const& b : bufs) {
+            total += b.size;
+        }
+        if (coalesce != 0 && total <= coalesce && total <= kMaxCoalesce) {
+            char packed[kMaxCoalesce];
+            size_t n = 0;
+            for (auto const& b : bufs) {
+                memcpy(packed + n, b.data, b.size);
+                n += b.size;
+            }
+            return send(s, rc, packed, (int)total);
+        }
+        rc = 0;
+        for (size_t i = 0; i < bufs.size();) {
+            size_t count = bufs.size() - i;
+            if (count > kMaxFragments) {
+                count = kMaxFragments;
+            }
+            size_t batch = 0;
+#if defined(_WIN32)
+            WSABUF iov[kMaxFragments];
+            for (size_t j = 0; j < count; ++j) {
+                iov[j].buf = const_cast<char*>(bufs[i + j].data);
+                iov[j].len = (ULONG)bufs[i + j].size;
+                batch += bufs[i + j].size;
+            }
+            DWORD sent = 0;
+            if (::WSASend(s, iov, (DWORD)count, &sent, 0, NULL, NULL) == SOCKET_ERROR) {
+                if (rc != 0) {
+                    // earlier fragments already left; report the partial write
+                    return status::success;
+                }
+                return wait_finish() ? status::wait : status::failed;
+            }
+#else
+            struct iovec iov[kMaxFragments];
+            for (size_t j = 0; j < count; ++j) {
+                iov[j].iov_base = const_cast<char*>(bufs[i + j].data);
+                iov[j].iov_len = bufs[i + j].size;
+                batch += bufs[i + j].size;
+            }
+            ssize_t sent = ::writev(s, iov, (int)count);
+            if (sent < 0) {
+                if (rc != 0) {
+                    // earlier fragments already left; report the partial write
+                    return status::success;
+                }
+                return wait_finish() ? status::wait : status::failed;
+            }
+#endif
+            rc += (int)sent;
+            if ((size_t)sent < batch) {
+                return status::success;
+            }
+            i += count;
+        }
+        return status::success;
+    }
+
     status  recvfrom(fd_t s, int& rc, char* buf, int len, endpoint& ep) {
         socklen_t addrlen = ep.addrlen();
         rc = ::recvfrom(s, buf, len, 0, ep.addr(), &addrlen);
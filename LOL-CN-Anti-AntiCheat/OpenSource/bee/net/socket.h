@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bee/nonstd/span.h>
+#include <stddef.h>
 #include <string>
 #if defined _WIN32
 #include <stdint.h>
@@ -58,6 +60,15 @@ namespace bee::net::socket {
     status accept(fd_t s, fd_t& fd, endpoint& ep);
     status recv(fd_t s, int& rc, char* buf, int len);
     status send(fd_t s, int& rc, const char* buf, int len);
+    struct iobuf {
+        const char* data;
+        size_t      size;
+    };
+    // gather write: all fragments leave in one syscall (WSASend/writev)
+    // instead of one send per fragment. When the total payload is at most
+    // `coalesce` bytes the fragments are packed into one stack buffer
+    // first, so small header+payload messages become a single TCP segment
+    status sendv(fd_t s, int& rc, nonstd::span<const iobuf> bufs, size_t coalesce = 0);
     status recvfrom(fd_t s, int& rc, char* buf, int len, endpoint& ep);
     status sendto(fd_t s, int& rc, const char* buf, int len, const endpoint& ep);
     bool   getpeername(fd_t s, endpoint& ep);
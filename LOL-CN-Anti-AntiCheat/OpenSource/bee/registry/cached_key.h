@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Windows.h>
+#include <map>
+#include <string>
+#include <bee/registry/key.h>
+
+namespace bee::registry {
+
+    // caching layer over basic_key: the key handle stays open, decoded
+    // values stay in memory, and RegNotifyChangeKeyValue arms an event
+    // that drops the cache when the key changes. Steady-state reads are
+    // a map lookup plus one non-blocking event check, no registry syscalls
+    template <typename C, typename T = reg_traits<C>>
+    class basic_cached_key
+    {
+    public:
+        typedef C                                char_type;
+        typedef T                                traits_type;
+        typedef basic_cached_key<C, T>           class_type;
+        typedef basic_key<C, T>                  key_type;
+        typedef typename traits_type::string_type string_type;
+
+        explicit basic_cached_key(key_type key)
+            : m_key(key)
+            , m_event(NULL)
+            , m_armed(false)
+            , m_strings()
+            , m_dwords()
+            , m_qwords()
+        { }
+
+        ~basic_cached_key()
+        {
+            if (m_event != NULL)
+            {
+                ::CloseHandle(m_event);
+            }
+        }
+
+        string_type get_string(const string_type& name)
+        {
+            poll_();
+            auto it = m_strings.find(name);
+            if (it != m_strings.end())
+            {
+                return it->second;
+            }
+            string_type value = m_key.value(name).get_string();
+            m_strings.emplace(name, value);
+            return value;
+        }
+
+        uint32_t get_uint32_t(const string_type& name)
+        {
+            poll_();
+            auto it = m_dwords.find(name);
+            if (it != m_dwords.end())
+            {
+                return it->second;
+            }
+            uint32_t value = m_key.value(name).get_uint32_t();
+            m_dwords.emplace(name, value);
+            return value;
+        }
+
+        uint64_t get_uint64_t(const string_type& name)
+        {
+            poll_();
+            auto it = m_qwords.find(name);
+            if (it != m_qwords.end())
+            {
+                return it->second;
+            }
+            uint64_t value = m_key.value(name).get_uint64_t();
+            m_qwords.emplace(name, value);
+            return value;
+        }
+
+        // manual drop, for callers that wrote through another handle
+        void invalidate()
+        {
+            m_strings.clear();
+            m_dwords.clear();
+            m_qwords.clear();
+        }
+
+    protected:
+        // cheap when armed and nothing changed: one zero-timeout wait
+        void poll_()
+        {
+            if (m_armed)
+            {
+                if (::WaitForSingleObject(m_event, 0) != WAIT_OBJECT_0)
+                {
+                    return;
+                }
+                // the notification is one-shot; drop everything and rearm
+                m_armed = false;
+            }
+            invalidate();
+            arm_();
+        }
+
+        void arm_()
+        {
+            if (m_event == NULL)
+            {
+                m_event = ::CreateEventW(NULL, FALSE, FALSE, NULL);
+                if (m_event == NULL)
+                {
+                    return;
+                }
+            }
+            if (ERROR_SUCCESS == ::RegNotifyChangeKeyValue(
+                m_key.handle(open_access::read),
+                FALSE,
+                REG_NOTIFY_CHANGE_NAME | REG_NOTIFY_CHANGE_LAST_SET,
+                m_event,
+                TRUE))
+            {
+                m_armed = true;
+            }
+        }
+
+    private:
+        basic_cached_key(const class_type&);
+        class_type& operator=(const class_type&);
+
+    protected:
+        key_type m_key;
+        HANDLE   m_event;
+        bool     m_armed;
+        std::map<string_type, string_type> m_strings;
+        std::map<string_type, uint32_t>    m_dwords;
+        std::map<string_type, uint64_t>    m_qwords;
+    };
+
+    typedef basic_cached_key<char>    cached_key_a;
+    typedef basic_cached_key<wchar_t> cached_key_w;
+}
@@ -118,6 +118,25 @@ namespace bee::registry {
             return m_key;
         }
 
+        // noexcept open for read paths: NULL instead of an exception when
+        // the key is missing or access is denied
+        hkey_type try_handle() noexcept
+        {
+            if (m_key)
+            {
+                return m_key;
+            }
+            hkey_type key = NULL;
+            result_type res = traits_type::open_key(m_keybase, key_name_().c_str(), &key, (REGSAM)open_access::read | (REGSAM)m_accessfix);
+            if (res != ERROR_SUCCESS)
+            {
+                return NULL;
+            }
+            m_key = key;
+            m_access = open_access::read;
+            return m_key;
+        }
+
         bool del(const string_type& subkey_name, bool delete_tree)
         {
             result_type res = delete_tree
@@ -75,6 +75,13 @@ namespace bee::registry {
         uint64_t                get_uint64_t() const;
         blob_type               get_binary() const;
 
+        // noexcept forms for hot paths: same queries, failures come back
+        // as an error_code instead of unwinding. The throwing getters
+        // above are wrappers around these
+        std::error_code         try_get_string(string_type& result) const noexcept;
+        std::error_code         try_get_uint32_t(uint32_t& result) const noexcept;
+        std::error_code         try_get_uint64_t(uint64_t& result) const noexcept;
+
         template <typename Result>
         Result get(typename std::enable_if<
             is_stringable<char_type, typename std::decay<Result>::type>::value
@@ -183,73 +190,115 @@ namespace bee::registry {
     }
 
     template <typename C, typename T, typename K>
-    inline typename basic_value<C, T, K>::string_type basic_value<C, T, K>::get_string() const
+    inline std::error_code basic_value<C, T, K>::try_get_string(string_type& result) const noexcept
     {
-        string_type ret;
+        hkey_type key = m_key.try_handle();
+        if (key == NULL)
+        {
+            return std::error_code(ERROR_FILE_NOT_FOUND, std::system_category());
+        }
         size_type   data_size = 0;
         uint32_t    dw;
-        result_type res = traits_type::query_value(m_key.handle(open_access::read), m_name.c_str(), dw, NULL, data_size);
-        check_and_throw_exception("could not determine the data size", res);
+        result_type res = traits_type::query_value(key, m_name.c_str(), dw, NULL, data_size);
+        if (ERROR_SUCCESS != res)
+        {
+            return std::error_code(res, std::system_category());
+        }
 
         if (data_size > 0)
         {
             std::dynarray<char_type> buffer(1 + data_size / sizeof(char_type));
 
             data_size = buffer.size() * sizeof(char_type);
-            res = traits_type::query_value(m_key.handle(open_access::read), m_name.c_str(), dw, buffer.data(), data_size);
-            check_and_throw_exception("could not elicit string value", res);
+            res = traits_type::query_value(key, m_name.c_str(), dw, buffer.data(), data_size);
+            if (ERROR_SUCCESS != res)
+            {
+                return std::error_code(res, std::system_category());
+            }
 
             if (data_size > 0)
             {
                 assert(0 != data_size);
                 data_size -= sizeof(char_type);
                 buffer[data_size / sizeof(char_type)] = 0;
-                ret.assign(buffer.data(), data_size / sizeof(char_type));
+                result.assign(buffer.data(), data_size / sizeof(char_type));
 
-                if (ret.length() > 0 && REG_EXPAND_SZ == type())
+                if (result.length() > 0 && REG_EXPAND_SZ == dw)
                 {
-                    size_type size = traits_type::expand_environment_strings(ret.c_str(), NULL, 0);
+                    size_type size = traits_type::expand_environment_strings(result.c_str(), NULL, 0);
 
                     if (0 != size)
                     {
                         std::dynarray<char_type> buffer2(1 + size);
 
-                        if (0 == traits_type::expand_environment_strings(ret.c_str(), &buffer2[0], size))
+                        if (0 == traits_type::expand_environment_strings(result.c_str(), &buffer2[0], size))
                         {
-                            check_and_throw_exception("could not expand environment strings", ::GetLastError());
+                            return std::error_code(::GetLastError(), std::system_category());
                         }
                         else
                         {
-                            ret.assign(buffer2.data(), size);
+                            result.assign(buffer2.data(), size);
                         }
                     }
                 }
             }
         }
 
+        return std::error_code();
+    }
 
+    template <typename C, typename T, typename K>
+    inline typename basic_value<C, T, K>::string_type basic_value<C, T, K>::get_string() const
+    {
+        string_type ret;
+        std::error_code ec = try_get_string(ret);
+        check_and_throw_exception("could not elicit string value", ec.value());
         return ret;
     }
 
+    template <typename C, typename T, typename K>
+    inline std::error_code basic_value<C, T, K>::try_get_uint32_t(uint32_t& result) const noexcept
+    {
+        hkey_type key = m_key.try_handle();
+        if (key == NULL)
+        {
+            return std::error_code(ERROR_FILE_NOT_FOUND, std::system_category());
+        }
+        size_type   cbData = sizeof(result);
+        uint32_t    value_type;
+        result_type res = traits_type::query_value(key, m_name.c_str(), value_type, &result, cbData);
+        return std::error_code(res, std::system_category());
+    }
+
     template <typename C, typename T, typename K>
     inline uint32_t basic_value<C, T, K>::get_uint32_t() const
     {
-        uint32_t  dwValue;
-        size_type   cbData = sizeof(dwValue);
-        uint32_t  value_type;
-        result_type   res = traits_type::query_value(m_key.handle(open_access::read), m_name.c_str(), value_type, &dwValue, cbData);
-        check_and_throw_exception("could not query value", res);
+        uint32_t dwValue = 0;
+        std::error_code ec = try_get_uint32_t(dwValue);
+        check_and_throw_exception("could not query value", ec.value());
         return dwValue;
     }
 
+    template <typename C, typename T, typename K>
+    inline std::error_code basic_value<C, T, K>::try_get_uint64_t(uint64_t& result) const noexcept
+    {
+        hkey_type key = m_key.try_handle();
+        if (key == NULL)
+        {
+            return std::error_code(ERROR_FILE_NOT_FOUND, std::system_category());
+        }
+        size_type   cbData = sizeof(result);
+        uint32_t    value_type;
+        result_type res = traits_type::query_value(key, m_name.c_str(), value_type, &result, cbData);
+        return std::error_code(res, std::system_category());
+    }
+
     template <typename C, typename T, typename K>
     inline uint64_t basic_value<C, T, K>::get_uint64_t() const
     {
-        uint64_t  dwValue;
-        size_type   cbData = sizeof(dwValue);
-        uint32_t  value_type;
-        result_type   res = traits_type::query_value(m_key.handle(open_access::read), m_name.c_str(), value_type, &dwValue, cbData);
-        check_and_throw_exception("could not query value", res);
+        uint64_t dwValue = 0;
+        std::error_code ec = try_get_uint64_t(dwValue);
+        check_and_throw_exception("could not query value", ec.value());
         return dwValue;
     }
 
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <deque>
+#include <vector>
 
 #if defined(_WIN32)
 namespace bee::win::subprocess {
@@ -119,4 +120,60 @@ namespace bee::posix::subprocess {
         }
         return target;
     }
+
+    // builds the same command line over and over without paying for it:
+    // the quoted form of every argument is kept alongside the raw one, so
+    // a rebuild after changing a single slot re-quotes one string, and the
+    // output buffer is sized from the cached lengths and reused across
+    // builds instead of growing through repeated appends
+    template <class char_t>
+    struct args_builder {
+        struct slot {
+            std::basic_string<char_t> raw;
+            std::basic_string<char_t> quoted;
+        };
+        void assign(size_t i, const std::basic_string<char_t>& arg) {
+            if (i >= args.size()) {
+                args.resize(i + 1);
+            }
+            if (args[i].raw == arg && !args[i].quoted.empty()) {
+                return;
+            }
+            args[i].raw = arg;
+            args[i].quoted = quote_arg(arg);
+        }
+        void push(const std::basic_string<char_t>& arg) {
+            assign(args.size(), arg);
+        }
+        void clear() {
+            args.clear();
+        }
+        // emits into the internal buffer; the view stays valid until the
+        // next build() or destruction
+        std::basic_string_view<char_t> build() {
+            size_t total = 0;
+            for (auto const& a : args) {
+                total += a.quoted.size() + 1;
+            }
+            buffer.clear();
+            buffer.reserve(total);
+            for (size_t i = 0; i < args.size(); ++i) {
+                if (i != 0) {
+                    buffer += (char_t)' ';
+                }
+                buffer += args[i].quoted;
+            }
+            return buffer;
+        }
+        // heap copy for callers that hand the command line to CreateProcess,
+        // which may scribble on it
+        char_t* release() {
+            build();
+            char_t* r = new char_t[buffer.size() + 1];
+            memcpy(r, buffer.c_str(), (buffer.size() + 1) * sizeof(char_t));
+            return r;
+        }
+        std::vector<slot> args;
+        std::basic_string<char_t> buffer;
+    };
 }
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Windows.h>
+#include <atomic>
+#include <type_traits>
+#include <bee/subprocess/sharedmemory_win.h>
+
+#pragma comment(lib, "synchronization.lib")
+
+namespace bee::win::subprocess {
+    // typed ring channel living inside a shared-memory section, so both
+    // processes talk through atomics with zero syscalls on the fast path.
+    // Per-slot sequence counters make push safe for multiple producers;
+    // pop is single-consumer. T must be trivially copyable because slots
+    // are raw bytes in the mapped region.
+    //
+    // Blocking waits spin briefly, then sleep on the slot's sequence word
+    // with WaitOnAddress. Address waits only wake within one process, so
+    // a cross-process peer is picked up by the wait timeout instead — the
+    // slow path degrades to adaptive polling, the fast path is untouched
+    template <class T, size_t N>
+    class shmring {
+        static_assert((N & (N - 1)) == 0, "shmring capacity must be a power of two");
+        static_assert(std::is_trivially_copyable<T>::value, "shmring elements live in raw shared memory");
+
+        struct slot {
+            std::atomic<uint32_t> sequence;
+            T value;
+        };
+        struct state {
+            alignas(64) std::atomic<uint32_t> tail;
+            alignas(64) std::atomic<uint32_t> head;
+            alignas(64) slot slots[N];
+        };
+        static const DWORD kWaitSliceMs = 1;
+        static const int kSpinCount = 4000;
+
+    public:
+        // section size the caller must map
+        static size_t size_bytes() {
+            return sizeof(state);
+        }
+
+        // creator side: lay out and zero the cursors
+        bool create(sharedmemory& sm) {
+            if (!sm.ok() || sm.size() < sizeof(state)) {
+                return false;
+            }
+            s_ = (state*)sm.data();
+            s_->tail.store(0, std::memory_order_relaxed);
+            s_->head.store(0, std::memory_order_relaxed);
+            for (uint32_t i = 0; i < N; ++i) {
+                s_->slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            return true;
+        }
+
+        // opener side: attach to a ring the peer already initialized
+        bool open(sharedmemory& sm) {
+            if (!sm.ok() || sm.size() < sizeof(state)) {
+                return false;
+            }
+            s_ = (state*)sm.data();
+            return true;
+        }
+
+        bool ok() const {
+            return s_ != nullptr;
+        }
+
+        // nonblocking; false when the ring is full
+        bool push(const T& value) {
+            uint32_t pos = s_->tail.load(std::memory_order_relaxed);
+            for (;;) {
+                slot& sl = s_->slots[pos & (N - 1)];
+                uint32_t seq = sl.sequence.load(std::memory_order_acquire);
+                int32_t diff = (int32_t)(seq - pos);
+                if (diff == 0) {
+                    if (s_->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        sl.value = value;
+                        sl.sequence.store(pos + 1, std::memory_order_release);
+                        ::WakeByAddressAll(&sl.sequence);
+                        return true;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;
+                }
+                else {
+                    pos = s_->tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // nonblocking; false when the ring is empty
+        bool pop(T& value) {
+            uint32_t pos = s_->head.load(std::memory_order_relaxed);
+            slot& sl = s_->slots[pos & (N - 1)];
+            uint32_t seq = sl.sequence.load(std::memory_order_acquire);
+            if ((int32_t)(seq - (pos + 1)) != 0) {
+                return false;
+            }
+            value = sl.value;
+            sl.sequence.store(pos + N, std::memory_order_release);
+            ::WakeByAddressAll(&sl.sequence);
+            s_->head.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // blocking push; spins first for latency, then waits
+        void push_wait(const T& value) {
+            for (int spin = 0; spin < kSpinCount; ++spin) {
+                if (push(value)) {
+                    return;
+                }
+                YieldProcessor();
+            }
+            for (;;) {
+                if (push(value)) {
+                    return;
+                }
+                uint32_t pos = s_->tail.load(std::memory_order_relaxed);
+                slot& sl = s_->slots[pos & (N - 1)];
+                uint32_t seq = sl.sequence.load(std::memory_order_relaxed);
+                ::WaitOnAddress(&sl.sequence, &seq, sizeof(uint32_t), kWaitSliceMs);
+            }
+        }
+
+        // blocking pop; the spin mode keeps latency-critical reads hot
+        void pop_wait(T& value) {
+            for (int spin = 0; spin < kSpinCount; ++spin) {
+                if (pop(value)) {
+                    return;
+                }
+                YieldProcessor();
+            }
+            for (;;) {
+                if (pop(value)) {
+                    return;
+                }
+                uint32_t pos = s_->head.load(std::memory_order_relaxed);
+                slot& sl = s_->slots[pos & (N - 1)];
+                uint32_t seq = sl.sequence.load(std::memory_order_relaxed);
+                ::WaitOnAddress(&sl.sequence, &seq, sizeof(uint32_t), kWaitSliceMs);
+            }
+        }
+
+    private:
+        state* s_ = nullptr;
+    };
+}
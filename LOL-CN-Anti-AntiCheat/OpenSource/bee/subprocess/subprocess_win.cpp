@@ -346,10 +346,16 @@ namespace bee::win::subprocess {
     }
 
     bool spawn::raw_exec(const wchar_t* application, wchar_t* commandline, const wchar_t* cwd) {
-        std::unique_ptr<wchar_t[]> command_line(commandline);
         std::unique_ptr<wchar_t[]> environment;
         if (!set_env_.empty() || !del_env_.empty()) {
             environment.reset(make_env(set_env_, del_env_));
+        }
+        return raw_exec(application, commandline, cwd, environment.get());
+    }
+
+    bool spawn::raw_exec(const wchar_t* application, wchar_t* commandline, const wchar_t* cwd, const wchar_t* environment) {
+        std::unique_ptr<wchar_t[]> command_line(commandline);
+        if (environment) {
             flags_ |= CREATE_UNICODE_ENVIRONMENT;
         }
         bool resume = false;
@@ -360,7 +366,7 @@ namespace bee::win::subprocess {
             NULL, NULL,
             inherit_handle_,
             flags_ | NORMAL_PRIORITY_CLASS,
-            environment.get(),
+            (LPVOID)environment,
             cwd,
             &si_, &pi_
         ))
@@ -393,6 +399,48 @@ namespace bee::win::subprocess {
         return raw_exec(search_path_ ? 0 : args[0].c_str(), command, cwd);
     }
 
+    bool prepared_spawn::prepare(spawn& s, const args_t& args, const wchar_t* cwd) {
+        if (args.size() == 0) {
+            return false;
+        }
+        std::unique_ptr<wchar_t[]> command(make_args(args));
+        if (!command) {
+            return false;
+        }
+        commandline_ = command.get();
+        has_application_ = !s.search_path_;
+        if (has_application_) {
+            application_ = args[0];
+        }
+        has_cwd_ = cwd != nullptr;
+        if (has_cwd_) {
+            cwd_ = cwd;
+        }
+        if (!s.set_env_.empty() || !s.del_env_.empty()) {
+            // make_env consumes the overrides, which is fine: they are
+            // frozen into the block from here on
+            environment_.reset(make_env(s.set_env_, s.del_env_));
+            if (!environment_) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool prepared_spawn::exec(spawn& s) {
+        if (commandline_.empty()) {
+            return false;
+        }
+        size_t n = commandline_.size() + 1;
+        std::unique_ptr<wchar_t[]> command(new wchar_t[n]);
+        memcpy(command.get(), commandline_.c_str(), n * sizeof(wchar_t));
+        return s.raw_exec(
+            has_application_ ? application_.c_str() : nullptr,
+            command.release(),
+            has_cwd_ ? cwd_.c_str() : nullptr,
+            environment_.get());
+    }
+
     void spawn::env_set(const std::wstring& key, const std::wstring& value) {
         set_env_[key] = value;
     }
@@ -86,6 +86,7 @@ namespace bee::win::subprocess {
 
     class _BEE_API spawn {
         friend class process;
+        friend class prepared_spawn;
     public:
         spawn();
         ~spawn();
@@ -102,6 +103,7 @@ namespace bee::win::subprocess {
 
     private:
         bool raw_exec(const wchar_t* application, wchar_t* commandline, const wchar_t* cwd);
+        bool raw_exec(const wchar_t* application, wchar_t* commandline, const wchar_t* cwd, const wchar_t* environment);
         void do_duplicate_start(bool& resume);
         void do_duplicate_shutdown();
         void do_duplicate_finish();
@@ -118,4 +120,23 @@ namespace bee::win::subprocess {
         bool                    search_path_ = false;
         bool                    detached_ = false;
     };
+
+    // freezes everything a launch needs besides CreateProcessW itself: the
+    // merged environment block, the quoted command line and the cwd. A
+    // helper that is relaunched repeatedly prepares once and then each
+    // exec() pays only the CreateProcessW call (plus one memcpy, because
+    // CreateProcessW may scribble on the command-line buffer)
+    class _BEE_API prepared_spawn {
+    public:
+        bool prepare(spawn& s, const args_t& args, const wchar_t* cwd);
+        bool exec(spawn& s);
+
+    private:
+        std::wstring               application_;
+        std::wstring               commandline_;
+        std::wstring               cwd_;
+        std::unique_ptr<wchar_t[]> environment_;
+        bool                       has_application_ = false;
+        bool                       has_cwd_ = false;
+    };
 }
@@ -0,0 +1,123 @@
+#include <bee/utility/dirscan_win.h>
+#include <Windows.h>
+#include <winternl.h>
+
+namespace bee::dirscan {
+    // not declared in winternl.h; layout documented for FileDirectoryInformation
+    struct FILE_DIRECTORY_INFORMATION_ {
+        ULONG         NextEntryOffset;
+        ULONG         FileIndex;
+        LARGE_INTEGER CreationTime;
+        LARGE_INTEGER LastAccessTime;
+        LARGE_INTEGER LastWriteTime;
+        LARGE_INTEGER ChangeTime;
+        LARGE_INTEGER EndOfFile;
+        LARGE_INTEGER AllocationSize;
+        ULONG         FileAttributes;
+        ULONG         FileNameLength;
+        WCHAR         FileName[1];
+    };
+
+    typedef NTSTATUS(NTAPI* NtQueryDirectoryFile_t)(
+        HANDLE FileHandle,
+        HANDLE Event,
+        PVOID ApcRoutine,
+        PVOID ApcContext,
+        PIO_STATUS_BLOCK IoStatusBlock,
+        PVOID FileInformation,
+        ULONG Length,
+        int FileInformationClass,
+        BOOLEAN ReturnSingleEntry,
+        PUNICODE_STRING FileName,
+        BOOLEAN RestartScan);
+
+    static const int kFileDirectoryInformation = 1;
+    static const NTSTATUS kStatusNoMoreFiles = (NTSTATUS)0x80000006L;
+
+    static NtQueryDirectoryFile_t query_directory() {
+        static NtQueryDirectoryFile_t fn = (NtQueryDirectoryFile_t)
+            ::GetProcAddress(::GetModuleHandleW(L"ntdll.dll"), "NtQueryDirectoryFile");
+        return fn;
+    }
+
+    bool entry::is_directory() const {
+        return (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    }
+
+    scanner::scanner(const std::wstring& dir)
+        : handle_(INVALID_HANDLE_VALUE)
+        , buffer_()
+        , offset_(0)
+        , valid_(false)
+        , restart_(true)
+    {
+        if (!query_directory()) {
+            return;
+        }
+        handle_ = ::CreateFileW(dir.c_str(),
+            FILE_LIST_DIRECTORY | SYNCHRONIZE,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS,
+            NULL);
+        if (handle_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        buffer_.reset(new uint8_t[kBufferSize]);
+    }
+
+    scanner::~scanner() {
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            ::CloseHandle(handle_);
+        }
+    }
+
+    bool scanner::ok() const {
+        return handle_ != INVALID_HANDLE_VALUE && !!buffer_;
+    }
+
+    bool scanner::refill() {
+        IO_STATUS_BLOCK iosb = { };
+        NTSTATUS status = query_directory()(
+            handle_, NULL, NULL, NULL, &iosb,
+            buffer_.get(), (ULONG)kBufferSize,
+            kFileDirectoryInformation,
+            FALSE, NULL,
+            restart_ ? TRUE : FALSE);
+        restart_ = false;
+        if (status == kStatusNoMoreFiles || !NT_SUCCESS(status) || iosb.Information == 0) {
+            valid_ = false;
+            return false;
+        }
+        offset_ = 0;
+        valid_ = true;
+        return true;
+    }
+
+    bool scanner::next(entry& e) {
+        if (!ok()) {
+            return false;
+        }
+        for (;;) {
+            if (!valid_ && !refill()) {
+                return false;
+            }
+            auto* info = (const FILE_DIRECTORY_INFORMATION_*)(buffer_.get() + offset_);
+            if (info->NextEntryOffset != 0) {
+                offset_ += info->NextEntryOffset;
+            }
+            else {
+                valid_ = false;
+            }
+            std::wstring_view name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+            if (name == L"." || name == L"..") {
+                continue;
+            }
+            e.name = name;
+            e.size = (uint64_t)info->EndOfFile.QuadPart;
+            e.attributes = info->FileAttributes;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+namespace bee::dirscan {
+    struct entry {
+        // view into the scanner's batch buffer; valid until the next call
+        // to next()
+        std::wstring_view name;
+        uint64_t          size;
+        uint32_t          attributes;
+
+        bool is_directory() const;
+    };
+
+    // forward-only directory scanner over NtQueryDirectoryFile with a
+    // 64 KB batch buffer: one kernel round trip covers hundreds of entries
+    // and names are handed out as views, so a scan of a large game folder
+    // performs neither a syscall nor an allocation per entry — unlike the
+    // FindNextFile-based iterator in nonstd/filesystem.h
+    class scanner {
+    public:
+        explicit scanner(const std::wstring& dir);
+        ~scanner();
+        scanner(const scanner& other) = delete;
+        scanner& operator = (const scanner& other) = delete;
+
+        bool ok() const;
+        // fills the next entry, skipping "." and ".."; false when done
+        bool next(entry& e);
+
+    private:
+        bool refill();
+
+    private:
+        static const size_t kBufferSize = 64 * 1024;
+        void*                      handle_;
+        std::unique_ptr<uint8_t[]> buffer_;
+        size_t                     offset_;
+        bool                       valid_;
+        bool                       restart_;
+    };
+}
@@ -6,6 +6,7 @@
 #else
 #include <sys/stat.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -63,6 +64,142 @@ namespace bee::file {
             NULL
         ));
     }
+
+    view::view(const handle::string_type& filename, bool prefetch) {
+        HANDLE file = CreateFileW(filename.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ, NULL,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL
+        );
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER filesize;
+        if (!::GetFileSizeEx(file, &filesize) || filesize.QuadPart == 0 || (uint64_t)filesize.QuadPart > SIZE_MAX) {
+            ::CloseHandle(file);
+            return;
+        }
+        HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        // the mapped pages outlive both handles, so close them right away
+        ::CloseHandle(file);
+        if (!mapping) {
+            return;
+        }
+        data_ = static_cast<const uint8_t*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        ::CloseHandle(mapping);
+        if (!data_) {
+            return;
+        }
+        size_ = (size_t)filesize.QuadPart;
+        if (prefetch) {
+            // Win8+; resolved at runtime so Win7 just skips the warm-up
+            typedef BOOL(WINAPI* prefetch_t)(HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY, ULONG);
+            static prefetch_t do_prefetch = (prefetch_t)::GetProcAddress(::GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory");
+            if (do_prefetch) {
+                WIN32_MEMORY_RANGE_ENTRY range = { const_cast<uint8_t*>(data_), size_ };
+                do_prefetch(::GetCurrentProcess(), 1, &range, 0);
+            }
+        }
+    }
+
+    void view::close() {
+        if (data_) {
+            ::UnmapViewOfFile(data_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    stream::stream(const handle::string_type& filename, size_t chunksize)
+        : chunksize_(chunksize)
+    {
+        file_ = CreateFileW(filename.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ, NULL,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            NULL
+        );
+        if (file_ != INVALID_HANDLE_VALUE) {
+            buf_ = new uint8_t[chunksize_];
+        }
+    }
+
+    stream::~stream() {
+        if (file_ != INVALID_HANDLE_VALUE) {
+            ::CloseHandle(file_);
+        }
+        delete[] buf_;
+    }
+
+    stream::operator bool() const {
+        return file_ != INVALID_HANDLE_VALUE;
+    }
+
+    nonstd::span<const uint8_t> stream::next() {
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return {};
+        }
+        DWORD read = 0;
+        if (!::ReadFile(file_, buf_, (DWORD)chunksize_, &read, NULL) || read == 0) {
+            return {};
+        }
+        return { buf_, read };
+    }
+
+    batch::batch(const handle::string_type& filename, size_t reserve) {
+        file_ = CreateFileW(filename.c_str(),
+            FILE_APPEND_DATA,
+            FILE_SHARE_READ, NULL,
+            OPEN_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL
+        );
+        if (file_ != INVALID_HANDLE_VALUE) {
+            buf_.reserve(reserve);
+        }
+    }
+
+    batch::~batch() {
+        if (file_ != INVALID_HANDLE_VALUE) {
+            flush();
+            ::CloseHandle(file_);
+        }
+    }
+
+    batch::operator bool() const {
+        return file_ != INVALID_HANDLE_VALUE;
+    }
+
+    void batch::append(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        buf_.insert(buf_.end(), p, p + size);
+    }
+
+    bool batch::flush() {
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        if (buf_.empty()) {
+            return true;
+        }
+        DWORD written = 0;
+        if (!::WriteFile(file_, buf_.data(), (DWORD)buf_.size(), &written, NULL) || written != buf_.size()) {
+            return false;
+        }
+        if (!::FlushFileBuffers(file_)) {
+            return false;
+        }
+        buf_.clear();
+        return true;
+    }
+
+    bool batch::replace(const handle::string_type& temp, const handle::string_type& target) {
+        return ::MoveFileExW(temp.c_str(), target.c_str(),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+    }
 #else
     FILE* open(handle h, mode m) {
         switch (m) {
@@ -100,5 +237,134 @@ namespace bee::file {
         return handle(fd);
 #endif
     }
+
+    view::view(const handle::string_type& filename, bool prefetch) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == -1 || st.st_size == 0) {
+            ::close(fd);
+            return;
+        }
+        void* p = ::mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping outlives the descriptor, so close it right away
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            return;
+        }
+        data_ = static_cast<const uint8_t*>(p);
+        size_ = (size_t)st.st_size;
+        if (prefetch) {
+            ::madvise(p, size_, MADV_WILLNEED);
+        }
+    }
+
+    void view::close() {
+        if (data_) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    stream::stream(const handle::string_type& filename, size_t chunksize)
+        : chunksize_(chunksize)
+    {
+        file_ = ::open(filename.c_str(), O_RDONLY);
+        if (file_ != -1) {
+            buf_ = new uint8_t[chunksize_];
+        }
+    }
+
+    stream::~stream() {
+        if (file_ != -1) {
+            ::close(file_);
+        }
+        delete[] buf_;
+    }
+
+    stream::operator bool() const {
+        return file_ != -1;
+    }
+
+    nonstd::span<const uint8_t> stream::next() {
+        if (file_ == -1) {
+            return {};
+        }
+        ssize_t read = ::read(file_, buf_, chunksize_);
+        if (read <= 0) {
+            return {};
+        }
+        return { buf_, (size_t)read };
+    }
+
+    batch::batch(const handle::string_type& filename, size_t reserve) {
+        file_ = ::open(filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (file_ != -1) {
+            buf_.reserve(reserve);
+        }
+    }
+
+    batch::~batch() {
+        if (file_ != -1) {
+            flush();
+            ::close(file_);
+        }
+    }
+
+    batch::operator bool() const {
+        return file_ != -1;
+    }
+
+    void batch::append(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        buf_.insert(buf_.end(), p, p + size);
+    }
+
+    bool batch::flush() {
+        if (file_ == -1) {
+            return false;
+        }
+        if (buf_.empty()) {
+            return true;
+        }
+        if (::write(file_, buf_.data(), buf_.size()) != (ssize_t)buf_.size()) {
+            return false;
+        }
+        if (::fsync(file_) == -1) {
+            return false;
+        }
+        buf_.clear();
+        return true;
+    }
+
+    bool batch::replace(const handle::string_type& temp, const handle::string_type& target) {
+        return ::rename(temp.c_str(), target.c_str()) == 0;
+    }
 #endif
+
+    view::~view() {
+        close();
+    }
+
+    view::view(view&& other) noexcept
+        : data_(other.data_)
+        , size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    view& view::operator=(view&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
 }
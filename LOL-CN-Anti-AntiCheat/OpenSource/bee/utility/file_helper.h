@@ -1,7 +1,10 @@
 #pragma once
 
+#include <bee/nonstd/span.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
 #if defined(_WIN32)
 #include <Windows.h>
 #endif
@@ -35,4 +38,68 @@ namespace bee::file {
     handle get_handle(FILE* f);
     handle dup(FILE* f);
     handle lock(const handle::string_type& filename);
+
+    // read-only memory-mapped view of a whole file; consumers parse the
+    // mapping in place instead of copying it into a heap buffer. With
+    // prefetch the pages are faulted in ahead of the first access
+    class view {
+    public:
+        view() = default;
+        explicit view(const handle::string_type& filename, bool prefetch = false);
+        ~view();
+        view(view&& other) noexcept;
+        view& operator=(view&& other) noexcept;
+        view(const view&) = delete;
+        view& operator=(const view&) = delete;
+        operator bool() const { return data_ != nullptr; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        const uint8_t* begin() const { return data_; }
+        const uint8_t* end() const { return data_ + size_; }
+    private:
+        void close();
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    // sequential chunked reader for scans too large to map comfortably;
+    // the chunk buffer is reused, so each span is valid until the next call
+    class stream {
+    public:
+        explicit stream(const handle::string_type& filename, size_t chunksize = 1 << 20);
+        ~stream();
+        stream(const stream&) = delete;
+        stream& operator=(const stream&) = delete;
+        operator bool() const;
+        // returns the next chunk, empty at end of file
+        nonstd::span<const uint8_t> next();
+    private:
+        handle::value_type file_ = (handle::value_type)-1;
+        uint8_t* buf_ = nullptr;
+        size_t chunksize_ = 0;
+    };
+
+    // durable batched appends for cache write-back: records accumulate in
+    // memory and flush as one write followed by a flush-to-disk, so an
+    // update costs one syscall per batch and a crash can only lose whole
+    // batches, never tear a record into a file that later memory-maps.
+    // compaction writes a fresh file and swaps it in with replace()
+    class batch {
+    public:
+        explicit batch(const handle::string_type& filename, size_t reserve = 1 << 16);
+        ~batch();
+        batch(const batch&) = delete;
+        batch& operator=(const batch&) = delete;
+        operator bool() const;
+        // buffered, no i/o until flush
+        void append(const void* data, size_t size);
+        size_t pending() const { return buf_.size(); }
+        // one write + flush-to-disk; on failure the buffer stays for retry
+        bool flush();
+        // atomically replace 'target' with the finished 'temp' file
+        static bool replace(const handle::string_type& temp, const handle::string_type& target);
+    private:
+        handle::value_type file_ = (handle::value_type)-1;
+        std::vector<uint8_t> buf_;
+    };
 }
@@ -56,6 +56,90 @@ inline int crt_snprintf(wchar_t* buf, size_t buf_size, const wchar_t* fmt, const
 #endif
 }
 
+// Output storage for format_analyzer. By default it grows through an
+// inline-then-heap hybrid_array; constructed over a caller-provided buffer
+// it becomes a fixed writer that truncates on overflow and never allocates.
+template <class CharT>
+class output_buffer
+{
+public:
+    output_buffer()
+        : ext_(nullptr)
+        , capacity_(0)
+        , size_(0)
+        , truncated_(false)
+    { }
+
+    output_buffer(CharT* data, std::size_t capacity)
+        : ext_(data)
+        , capacity_(capacity)
+        , size_(0)
+        , truncated_(false)
+    { }
+
+    CharT*      data()        { return ext_ ? ext_ : storage_.data(); }
+    CharT*      begin()       { return data(); }
+    CharT*      end()         { return data() + size(); }
+    std::size_t size()  const { return ext_ ? size_ : storage_.size(); }
+    bool        truncated() const { return truncated_; }
+
+    void push_back(CharT c)
+    {
+        if (!ext_)
+        {
+            storage_.push_back(c);
+            return;
+        }
+        if (size_ < capacity_)
+        {
+            ext_[size_++] = c;
+        }
+        else
+        {
+            truncated_ = true;
+        }
+    }
+
+    void append(const CharT* first, const CharT* last)
+    {
+        if (!ext_)
+        {
+            storage_.append(first, last);
+            return;
+        }
+        std::size_t count = static_cast<std::size_t>(last - first);
+        if (count > capacity_ - size_)
+        {
+            count = capacity_ - size_;
+            truncated_ = true;
+        }
+        memcpy(ext_ + size_, first, count * sizeof(CharT));
+        size_ += count;
+    }
+
+    void resize(std::size_t new_size)
+    {
+        if (!ext_)
+        {
+            storage_.resize(new_size);
+            return;
+        }
+        if (new_size > capacity_)
+        {
+            new_size = capacity_;
+            truncated_ = true;
+        }
+        size_ = new_size;
+    }
+
+private:
+    hybrid_array<CharT, 512> storage_;
+    CharT*                   ext_;
+    std::size_t              capacity_;
+    std::size_t              size_;
+    bool                     truncated_;
+};
+
 template <class CharT>
 class format_analyzer
 {
@@ -92,6 +176,19 @@ public:
         , ch_(0)
     { }
 
+    // fixed-buffer mode: all output lands in [data, data + capacity),
+    // anything past the end is dropped
+    format_analyzer(const char_t* fmt, char_t* data, std::size_t capacity)
+        : buffer_(data, capacity)
+        , format_()
+        , temp_()
+        , fmt_(fmt)
+        , flags_(0)
+        , width_(-1)
+        , precision_(-1)
+        , ch_(0)
+    { }
+
     ~format_analyzer()
     { }
 
@@ -114,6 +211,16 @@ public:
         return std::move(std::basic_string<CharT>(buffer_.begin(), buffer_.end()));
     }
 
+    std::size_t size() const
+    {
+        return buffer_.size();
+    }
+
+    bool truncated() const
+    {
+        return buffer_.truncated();
+    }
+
     void accept() { }
 
     template <class T>
@@ -393,13 +500,20 @@ private:
         {
             buffer_.resize(len + offset);
 
-            int ret = crt_snprintf(&*buffer_.begin() + len, offset, format_.data(), value);
+            // a fixed buffer may hand back less than requested
+            std::size_t avail = buffer_.size() - len;
+            int ret = avail != 0 ? crt_snprintf(buffer_.begin() + len, avail, format_.data(), value) : -1;
 
-            if (ret > 0)
+            if (ret > 0 && static_cast<std::size_t>(ret) <= avail)
             {
                 buffer_.resize(len + ret);
                 break;
             }
+            if (avail < offset)
+            {
+                // out of space, keep the truncated part that fit
+                break;
+            }
         }
     }
 
@@ -573,7 +687,7 @@ private:
         return c+1;
     }
 
-    hybrid_array<char_t, 512> buffer_;
+    output_buffer<char_t>     buffer_;
     hybrid_array<char_t, 16>  format_;
     hybrid_array<char_t, 16>  temp_;
     const char_t*             fmt_;
@@ -736,6 +850,29 @@ BOOST_PP_REPEAT(16, BASE_FORMAT_DEFINE_CREATER, ~)
     {
         format(format_detail::standard_output(fmt), fmt, args...);
     }
+    // Formats into a caller-provided buffer, truncating on overflow, and
+    // null-terminates. Nothing on this path allocates unless an argument
+    // conversion itself does, so it is safe inside hooks. Returns the
+    // number of characters written, excluding the terminator.
+    template <class CharT, class... Args>
+    std::size_t format_to(CharT* data, std::size_t capacity, const CharT* fmt, const Args& ... args)
+    {
+        if (capacity == 0)
+        {
+            return 0;
+        }
+        format_detail::format_analyzer<CharT> fmt_iter(fmt, data, capacity - 1);
+        fmt_iter.accept(args...);
+        fmt_iter.finish();
+        std::size_t n = fmt_iter.size();
+        data[n] = 0;
+        return n;
+    }
+    template <class CharT, std::size_t N, class... Args>
+    std::size_t format_to(CharT (&data)[N], const CharT* fmt, const Args& ... args)
+    {
+        return format_to(data, N, fmt, args...);
+    }
 #endif
 
 }
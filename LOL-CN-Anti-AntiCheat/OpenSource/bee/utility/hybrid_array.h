@@ -3,8 +3,10 @@
 #include <algorithm>
 #include <limits>
 #include <iterator>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <memory>
 #include <memory.h>
 
@@ -26,27 +28,28 @@ namespace bee {
         typedef size_t                                size_type;
         typedef ptrdiff_t                             difference_type;
 
-        static_assert(std::is_pod<value_type>::value, "hybrid_array::value_type must be a pod type.");
+        static_assert(std::is_move_constructible<value_type>::value, "hybrid_array::value_type must be movable.");
 
-        hybrid_array() 
+        hybrid_array()
             : size_(0)
             , capacity_(SIZE)
-            , ptr_(data_) 
+            , ptr_(inline_data())
         { }
 
         hybrid_array(size_type n)
             : size_(0)
             , capacity_(SIZE)
-            , ptr_(data_)
+            , ptr_(inline_data())
         {
             resize(n);
         }
 
-        ~hybrid_array() 
+        ~hybrid_array()
         {
-            if (ptr_ != data_) 
+            destroy(ptr_, ptr_ + size_);
+            if (ptr_ != inline_data())
             {
-                delete [] ptr_;
+                ::operator delete(ptr_);
             }
         }
 
@@ -75,14 +78,26 @@ namespace bee {
         const T*               data()                  const { return ptr_; }
         void                   fill(const T& v)              { std::fill_n(begin(), size(), v); }
         size_type              capacity() const              { return capacity_; }
-        void                   clear()                       { size_ = 0; }
+        void                   clear()                       { destroy(ptr_, ptr_ + size_); size_ = 0; }
 
-        void resize(size_type new_size) 
+        void resize(size_type new_size)
         {
             if (new_size > capacity_)
             {
                 grow(new_size);
             }
+            if (new_size > size_)
+            {
+                // default-init only: pod elements stay uninitialized as before
+                for (size_type i = size_; i < new_size; ++i)
+                {
+                    new (ptr_ + i) value_type;
+                }
+            }
+            else
+            {
+                destroy(ptr_ + new_size, ptr_ + size_);
+            }
             size_ = new_size;
         }
 
@@ -95,12 +110,26 @@ namespace bee {
         }
 
         void push_back(const_reference value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        // constructs in place, never value-initializes first
+        template <typename... Args>
+        reference emplace_back(Args&&... args)
         {
             if (size_ == capacity_)
             {
                 grow(size_ + 1);
             }
-            ptr_[size_++] = value;
+            pointer p = new (ptr_ + size_) value_type(std::forward<Args>(args)...);
+            ++size_;
+            return *p;
         }
 
         void append(const_iterator first, const_iterator last)
@@ -115,32 +144,71 @@ namespace bee {
         }
 
     private:
+        pointer inline_data()
+        {
+            return reinterpret_cast<pointer>(data_);
+        }
+
         void uninitialized_copy(const_iterator first, const_iterator last, iterator dest)
         {
-            const char * const first_ch = const_cast<const char *>(reinterpret_cast<const volatile char *>(first));
-            const char * const last_ch = const_cast<const char *>(reinterpret_cast<const volatile char *>(last));
-            char * const dest_ch = const_cast<char *>(reinterpret_cast<volatile char *>(dest));
-            const size_t count = last_ch - first_ch;
-            memmove(dest_ch, first_ch, count);
+            if constexpr (std::is_trivially_copyable<value_type>::value)
+            {
+                memmove(dest, first, (last - first) * sizeof(value_type));
+            }
+            else
+            {
+                for (; first != last; ++first, ++dest)
+                {
+                    new (dest) value_type(*first);
+                }
+            }
+        }
+
+        void uninitialized_move(iterator first, iterator last, iterator dest)
+        {
+            if constexpr (std::is_trivially_copyable<value_type>::value)
+            {
+                memcpy(dest, first, (last - first) * sizeof(value_type));
+            }
+            else
+            {
+                for (; first != last; ++first, ++dest)
+                {
+                    new (dest) value_type(std::move(*first));
+                }
+            }
         }
 
-        void grow(size_type size) 
+        static void destroy(iterator first, iterator last)
         {
+            if constexpr (!std::is_trivially_destructible<value_type>::value)
+            {
+                for (; first != last; ++first)
+                {
+                    first->~value_type();
+                }
+            }
+        }
+
+        void grow(size_type size)
+        {
+            // geometric policy, at least 1.5x per reallocation
             capacity_ = (std::max)(size, capacity_ + capacity_ / 2);
-            pointer p = new value_type[capacity_];
-            uninitialized_copy(ptr_, ptr_ + size_, p);
-            if (ptr_ != data_)
+            pointer p = static_cast<pointer>(::operator new(capacity_ * sizeof(value_type)));
+            uninitialized_move(ptr_, ptr_ + size_, p);
+            destroy(ptr_, ptr_ + size_);
+            if (ptr_ != inline_data())
             {
-                delete [] ptr_;
+                ::operator delete(ptr_);
             }
             ptr_ = p;
         }
 
         void check(size_type n)
-        { 
+        {
             if (n >= size_)
             {
-                throw std::out_of_range("hybrid_array"); 
+                throw std::out_of_range("hybrid_array");
             }
         }
 
@@ -151,6 +219,6 @@ namespace bee {
         size_type  size_;
         size_type  capacity_;
         pointer    ptr_;
-        value_type data_[SIZE];
+        alignas(value_type) unsigned char data_[SIZE * sizeof(value_type)];
     };
 }
@@ -1,8 +1,30 @@
 #include <bee/utility/module_version_win.h>
 #include <bee/utility/format.h>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace bee {
+	namespace {
+		struct version_cache_entry {
+			uint64_t mtime = 0;
+			uint64_t size = 0;
+			std::shared_ptr<const module_version> block;
+		};
+		std::mutex version_cache_lock;
+		std::unordered_map<std::wstring, version_cache_entry> version_cache;
+
+		// metadata-only query: no read of the file content
+		bool query_file_id(const wchar_t* path, uint64_t& mtime, uint64_t& size) {
+			WIN32_FILE_ATTRIBUTE_DATA fad;
+			if (!::GetFileAttributesExW(path, GetFileExInfoStandard, &fad)) {
+				return false;
+			}
+			mtime = ((uint64_t)fad.ftLastWriteTime.dwHighDateTime << 32) | fad.ftLastWriteTime.dwLowDateTime;
+			size = ((uint64_t)fad.nFileSizeHigh << 32) | fad.nFileSizeLow;
+			return true;
+		}
+	}
 	module_version::module_version()
 		: fixed_file_info_(nullptr)
 		, translation_size_(0)
@@ -21,6 +43,23 @@ namespace bee {
 		, vaild_(create(module_path))
 	{ }
 
+	std::shared_ptr<const module_version> module_version::cached(const wchar_t* module_path) {
+		uint64_t mtime = 0;
+		uint64_t size = 0;
+		if (!query_file_id(module_path, mtime, size)) {
+			// unreadable file: parse (and fail) without polluting the cache
+			return std::make_shared<module_version>(module_path);
+		}
+		std::lock_guard<std::mutex> lock(version_cache_lock);
+		auto& entry = version_cache[module_path];
+		if (!entry.block || entry.mtime != mtime || entry.size != size) {
+			entry.block = std::make_shared<module_version>(module_path);
+			entry.mtime = mtime;
+			entry.size = size;
+		}
+		return entry.block;
+	}
+
 	const wchar_t* module_version::operator[] (const wchar_t* key) const {
 		if (!vaild_) return L"";
 		const wchar_t* value = nullptr;
@@ -128,6 +167,6 @@ namespace bee {
 	{ }
 
 	simple_module_version::simple_module_version(const wchar_t* module_path, const wchar_t* key, const wchar_t pred) {
-		create_simple_file_version(*this, module_version(module_path)[key], pred);
+		create_simple_file_version(*this, (*module_version::cached(module_path))[key], pred);
 	}
 }
@@ -11,6 +11,10 @@ namespace bee {
 	public:
 		module_version();
 		module_version(const wchar_t* module_path);
+		// process-wide cache keyed by (path, mtime, size); repeat queries for
+		// the same binary share one parsed block instead of re-reading the
+		// resource section from disk
+		static std::shared_ptr<const module_version> cached(const wchar_t* module_path);
 		const wchar_t* operator[] (const wchar_t* key) const;
 		VS_FIXEDFILEINFO* fixed_file_info() const;
 		bool select_language(WORD langid);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace bee {
+    // Fixed-capacity lock-free MPSC ring, the non-blocking counterpart of
+    // lockqueue. push is a couple of atomics and never takes a lock, so a
+    // producer inside a time-critical loop cannot be stalled by a
+    // lower-priority consumer holding a mutex. pop moves the element out
+    // and must only be called from one consumer thread.
+    // N must be a power of two.
+    template <class T, size_t N>
+    class mpscqueue {
+        static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+    public:
+        mpscqueue() {
+            for (size_t i = 0; i < N; ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        mpscqueue(const mpscqueue&) = delete;
+        mpscqueue& operator=(const mpscqueue&) = delete;
+
+        // false when the ring is full; the producer never blocks
+        bool push(T&& data) {
+            size_t pos = tail.load(std::memory_order_relaxed);
+            for (;;) {
+                slot& s = slots[pos & (N - 1)];
+                size_t seq = s.sequence.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0) {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        s.value = std::move(data);
+                        s.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;
+                }
+                else {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        bool push(const T& data) {
+            T copy(data);
+            return push(std::move(copy));
+        }
+        bool pop(T& data) {
+            size_t pos = head.load(std::memory_order_relaxed);
+            slot& s = slots[pos & (N - 1)];
+            size_t seq = s.sequence.load(std::memory_order_acquire);
+            if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+                return false;
+            }
+            data = std::move(s.value);
+            s.sequence.store(pos + N, std::memory_order_release);
+            head.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+    private:
+        struct slot {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+        // producers and the consumer never share a cache line
+        alignas(64) std::atomic<size_t> tail{ 0 };
+        alignas(64) std::atomic<size_t> head{ 0 };
+        alignas(64) slot slots[N];
+    };
+}
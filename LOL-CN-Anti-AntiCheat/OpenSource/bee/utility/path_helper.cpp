@@ -32,11 +32,11 @@ namespace bee::path_helper {
         return nonstd::make_unexpected(std::runtime_error("::GetModuleFileNameW return too long."));
     }
 
-    auto exe_path()->nonstd::expected<fs::path, std::exception> {
+    static auto exe_path_impl()->nonstd::expected<fs::path, std::exception> {
         return dll_path(NULL);
     }
 
-    auto dll_path()->nonstd::expected<fs::path, std::exception> {
+    static auto dll_path_impl()->nonstd::expected<fs::path, std::exception> {
         return dll_path(reinterpret_cast<void*>(&__ImageBase));
     }
 }
@@ -48,7 +48,7 @@ namespace bee::path_helper {
 #include <mach-o/dyld.h>
 
 namespace bee::path_helper {
-    auto exe_path()->nonstd::expected<fs::path, std::exception> {
+    static auto exe_path_impl()->nonstd::expected<fs::path, std::exception> {
         uint32_t path_len = 0;
         _NSGetExecutablePath(0, &path_len);
         if (path_len <= 1) {
@@ -68,7 +68,7 @@ namespace bee::path_helper {
 #include <unistd.h>
 
 namespace bee::path_helper {
-    auto exe_path()->nonstd::expected<fs::path, std::exception> {
+    static auto exe_path_impl()->nonstd::expected<fs::path, std::exception> {
         char buffer[0x100];
         ssize_t path_len = ::readlink("/proc/self/exe", buffer, sizeof(buffer)-1);
         if (path_len < 0) {
@@ -106,14 +106,39 @@ namespace bee::path_helper {
         return nonstd::make_unexpected(std::runtime_error("::dladdr failed."));
     }
 
-    auto dll_path()->nonstd::expected<fs::path, std::exception> {
-        return dll_path((void*)&exe_path);
+    static auto dll_path_impl()->nonstd::expected<fs::path, std::exception> {
+        return dll_path((void*)&dll_path_impl);
     }
 }
 
 #endif
 
 namespace bee::path_helper {
+    auto exe_path()->const nonstd::expected<fs::path, std::exception>& {
+        static auto cache = exe_path_impl();
+        return cache;
+    }
+
+    auto dll_path()->const nonstd::expected<fs::path, std::exception>& {
+        static auto cache = dll_path_impl();
+        return cache;
+    }
+
+    auto exe_directory()->const fs::path& {
+        static fs::path cache = exe_path().has_value() ? exe_path().value().parent_path() : fs::path();
+        return cache;
+    }
+
+    auto exe_stem()->const fs::path& {
+        static fs::path cache = exe_path().has_value() ? exe_path().value().stem() : fs::path();
+        return cache;
+    }
+
+    auto dll_directory()->const fs::path& {
+        static fs::path cache = dll_path().has_value() ? dll_path().value().parent_path() : fs::path();
+        return cache;
+    }
+
 #if defined(_WIN32)
     bool equal(fs::path const& lhs, fs::path const& rhs) {
         fs::path lpath = lhs.lexically_normal();
@@ -6,7 +6,12 @@
 
 namespace bee::path_helper {
     _BEE_API auto dll_path(void* module_handle)->nonstd::expected<fs::path, std::exception>;
-    _BEE_API auto exe_path()->nonstd::expected<fs::path, std::exception>;
-    _BEE_API auto dll_path()->nonstd::expected<fs::path, std::exception>;
+    // queried once on first use, then served from process-lifetime storage
+    _BEE_API auto exe_path()->const nonstd::expected<fs::path, std::exception>&;
+    _BEE_API auto dll_path()->const nonstd::expected<fs::path, std::exception>&;
+    // pre-split pieces of the cached paths; empty when the query failed
+    _BEE_API auto exe_directory()->const fs::path&;
+    _BEE_API auto exe_stem()->const fs::path&;
+    _BEE_API auto dll_directory()->const fs::path&;
     _BEE_API bool equal(fs::path const& lhs, fs::path const& rhs);
 }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Windows.h>
+#include <atomic>
+#include <chrono>
+
+#pragma comment(lib, "synchronization.lib")
+
+namespace bee {
+    // Counting semaphore on WaitOnAddress. Unlike bee::semaphore this one
+    // actually counts, so bursts of signals are never lost, and the
+    // uncontended signal/wait path is a single atomic op with no kernel
+    // mutex behind it. wait sleeps on the count word only when it is zero.
+    class fast_semaphore {
+    public:
+        void signal(uint32_t n = 1) {
+            count.fetch_add(n);
+            if (waiting.load() != 0) {
+                if (n == 1) {
+                    ::WakeByAddressSingle(&count);
+                }
+                else {
+                    ::WakeByAddressAll(&count);
+                }
+            }
+        }
+        void wait() {
+            for (;;) {
+                if (try_acquire()) {
+                    return;
+                }
+                waiting.fetch_add(1);
+                uint32_t zero = 0;
+                if (count.load() == 0) {
+                    ::WaitOnAddress(&count, &zero, sizeof(uint32_t), INFINITE);
+                }
+                waiting.fetch_sub(1);
+            }
+        }
+        template<class Rep, class Period>
+        bool wait_for(const std::chrono::duration<Rep, Period>& timeout) {
+            return wait_until(std::chrono::steady_clock::now() + timeout);
+        }
+        template <class Clock, class Duration>
+        bool wait_until(const std::chrono::time_point<Clock, Duration>& timeout) {
+            for (;;) {
+                if (try_acquire()) {
+                    return true;
+                }
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(timeout - Clock::now()).count();
+                if (left <= 0) {
+                    return false;
+                }
+                waiting.fetch_add(1);
+                uint32_t zero = 0;
+                if (count.load() == 0) {
+                    ::WaitOnAddress(&count, &zero, sizeof(uint32_t), static_cast<DWORD>(left));
+                }
+                waiting.fetch_sub(1);
+            }
+        }
+    private:
+        bool try_acquire() {
+            uint32_t c = count.load();
+            while (c != 0) {
+                if (count.compare_exchange_weak(c, c - 1)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    private:
+        std::atomic<uint32_t> count{ 0 };
+        std::atomic<uint32_t> waiting{ 0 };
+    };
+}
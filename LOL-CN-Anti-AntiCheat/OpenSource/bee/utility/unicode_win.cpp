@@ -1,12 +1,99 @@
 #include <bee/utility/unicode_win.h>
 #include <bee/nonstd/dynarray.h>
 #include <Windows.h>
+#include <emmintrin.h>
 
 namespace bee {
+    namespace {
+        // pure-ASCII test, 16 bytes per step; ASCII text converts by widening
+        // or narrowing alone, identically under CP_UTF8 and CP_ACP
+        bool is_ascii(const char* str, size_t len) {
+            size_t i = 0;
+            for (; i + 16 <= len; i += 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+                if (_mm_movemask_epi8(chunk) != 0) {
+                    return false;
+                }
+            }
+            for (; i < len; ++i) {
+                if (static_cast<unsigned char>(str[i]) > 0x7F) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // pure-ASCII test, 8 characters per step
+        bool is_ascii(const wchar_t* str, size_t len) {
+            __m128i limit = _mm_set1_epi16(0x007F);
+            __m128i zero = _mm_setzero_si128();
+            size_t i = 0;
+            for (; i + 8 <= len; i += 8) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(chunk, limit), zero)) != 0xFFFF) {
+                    return false;
+                }
+            }
+            for (; i < len; ++i) {
+                if (str[i] > 0x7F) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t narrow_to_wide(UINT codepage, const std::string_view& str, nonstd::span<wchar_t> buf) {
+            if (str.empty()) {
+                return 0;
+            }
+            if (is_ascii(str.data(), str.size())) {
+                if (str.size() <= buf.size()) {
+                    for (size_t i = 0; i < str.size(); ++i) {
+                        buf[i] = static_cast<wchar_t>(static_cast<unsigned char>(str[i]));
+                    }
+                }
+                return str.size();
+            }
+            int wlen = ::MultiByteToWideChar(codepage, 0, str.data(), (int)str.size(), NULL, 0);
+            if (wlen <= 0) {
+                return 0;
+            }
+            if (static_cast<size_t>(wlen) <= buf.size()) {
+                ::MultiByteToWideChar(codepage, 0, str.data(), (int)str.size(), buf.data(), wlen);
+            }
+            return static_cast<size_t>(wlen);
+        }
+
+        size_t wide_to_narrow(UINT codepage, const std::wstring_view& wstr, nonstd::span<char> buf) {
+            if (wstr.empty()) {
+                return 0;
+            }
+            if (is_ascii(wstr.data(), wstr.size())) {
+                if (wstr.size() <= buf.size()) {
+                    for (size_t i = 0; i < wstr.size(); ++i) {
+                        buf[i] = static_cast<char>(wstr[i]);
+                    }
+                }
+                return wstr.size();
+            }
+            int len = ::WideCharToMultiByte(codepage, 0, wstr.data(), (int)wstr.size(), NULL, 0, 0, 0);
+            if (len <= 0) {
+                return 0;
+            }
+            if (static_cast<size_t>(len) <= buf.size()) {
+                ::WideCharToMultiByte(codepage, 0, wstr.data(), (int)wstr.size(), buf.data(), len, 0, 0);
+            }
+            return static_cast<size_t>(len);
+        }
+    }
+
     std::wstring u2w(const std::string_view& str) {
         if (str.empty())  {
             return L"";
         }
+        if (is_ascii(str.data(), str.size())) {
+            return std::wstring(str.begin(), str.end());
+        }
         int wlen = ::MultiByteToWideChar(CP_UTF8, 0, str.data(), (int)str.size(), NULL, 0);
         if (wlen <= 0)  {
             return L"";
@@ -20,6 +107,9 @@ namespace bee {
         if (wstr.empty())  {
             return "";
         }
+        if (is_ascii(wstr.data(), wstr.size())) {
+            return std::string(wstr.begin(), wstr.end());
+        }
         int len = ::WideCharToMultiByte(CP_UTF8, 0, wstr.data(), (int)wstr.size(), NULL, 0, 0, 0);
         if (len <= 0) {
             return "";
@@ -33,6 +123,9 @@ namespace bee {
         if (str.empty())  {
             return L"";
         }
+        if (is_ascii(str.data(), str.size())) {
+            return std::wstring(str.begin(), str.end());
+        }
         int wlen = ::MultiByteToWideChar(CP_ACP, 0, str.data(), (int)str.size(), NULL, 0);
         if (wlen <= 0) {
             return L"";
@@ -46,6 +139,9 @@ namespace bee {
         if (wstr.empty()) {
             return "";
         }
+        if (is_ascii(wstr.data(), wstr.size())) {
+            return std::string(wstr.begin(), wstr.end());
+        }
         int len = ::WideCharToMultiByte(CP_ACP, 0, wstr.data(), (int)wstr.size(), NULL, 0, 0, 0);
         if (len <= 0) {
             return "";
@@ -62,4 +158,20 @@ namespace bee {
     std::string u2a(const std::string_view& str) {
         return w2a(u2w(str));
     }
+
+    size_t u2w(const std::string_view& str, nonstd::span<wchar_t> buf) {
+        return narrow_to_wide(CP_UTF8, str, buf);
+    }
+
+    size_t w2u(const std::wstring_view& wstr, nonstd::span<char> buf) {
+        return wide_to_narrow(CP_UTF8, wstr, buf);
+    }
+
+    size_t a2w(const std::string_view& str, nonstd::span<wchar_t> buf) {
+        return narrow_to_wide(CP_ACP, str, buf);
+    }
+
+    size_t w2a(const std::wstring_view& wstr, nonstd::span<char> buf) {
+        return wide_to_narrow(CP_ACP, wstr, buf);
+    }
 }
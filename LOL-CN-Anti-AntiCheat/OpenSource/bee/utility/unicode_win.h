@@ -1,6 +1,8 @@
 #pragma once
 
 #include <bee/config.h>
+#include <bee/nonstd/span.h>
+#include <bee/utility/hybrid_array.h>
 #include <string>
 #include <string_view>
 
@@ -11,4 +13,27 @@ namespace bee {
     _BEE_API std::string  w2a(const std::wstring_view& wstr);
     _BEE_API std::string  a2u(const std::string_view& str);
     _BEE_API std::string  u2a(const std::string_view& str);
+
+    // convert into a caller-supplied buffer instead of allocating a string.
+    // Returns the full converted length; a result larger than buf.size()
+    // means the output did not fit and the buffer was left untouched
+    _BEE_API size_t u2w(const std::string_view& str, nonstd::span<wchar_t> buf);
+    _BEE_API size_t w2u(const std::wstring_view& wstr, nonstd::span<char> buf);
+    _BEE_API size_t a2w(const std::string_view& str, nonstd::span<wchar_t> buf);
+    _BEE_API size_t w2a(const std::wstring_view& wstr, nonstd::span<char> buf);
+
+    // hybrid_array-backed convenience: the result stays on the stack
+    // whenever it fits in N characters
+    template <size_t N>
+    void u2w(const std::string_view& str, hybrid_array<wchar_t, N>& out) {
+        // one UTF-16 unit per UTF-8 byte is the upper bound
+        out.resize(str.size());
+        out.resize(u2w(str, nonstd::span<wchar_t>(out.data(), out.size())));
+    }
+    template <size_t N>
+    void w2u(const std::wstring_view& wstr, hybrid_array<char, N>& out) {
+        // three UTF-8 bytes per UTF-16 unit is the upper bound
+        out.resize(wstr.size() * 3);
+        out.resize(w2u(wstr, nonstd::span<char>(out.data(), out.size())));
+    }
 }
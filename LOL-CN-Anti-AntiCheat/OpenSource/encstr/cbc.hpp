@@ -1,6 +1,7 @@
 #pragma once
 #include <encstr/always_inline.hpp>
 #include <encstr/unroll.hpp>
+#include <encstr/utils.hpp>
 
 namespace encstr
 {
@@ -38,6 +39,11 @@ namespace encstr
         ENCSTR_ALWAYS_INLINE static constexpr std::array<uint8_t, Size> decrypt(std::array<uint8_t, Size> input, key_type key, iv_type iv) noexcept
         {
             static_assert(Size % block_size == 0, "Data size is not properly aligned!");
+            if constexpr (has_bulk_decode<cipher_type>::value)
+            {
+                if(!std::is_constant_evaluated())
+                    return cipher_type::bulk_decrypt_cbc(input, key, iv);
+            }
             std::array<uint8_t, Size> result{ 0 };
             
             for(size_t i = 0; i < Size; i += block_size)
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <array>
+#include <emmintrin.h>
 #include <encstr/always_inline.hpp>
 #include <encstr/unroll.hpp>
 
@@ -49,6 +50,64 @@ namespace encstr::ciphers
             return encoder.data;
         }
         ENCSTR_ALWAYS_INLINE constexpr static block_type decode(block_type input, key_type key) noexcept { return encode(input, key); }
+
+        // decode is byte-local and the keystream repeats every key_size
+        // bytes, so the block modes may collapse a runtime decrypt of the
+        // whole string into 16-byte xors (see ecb.hpp / cbc.hpp); the
+        // constexpr encrypt side above is untouched
+        constexpr static bool bulk_decode = (block_size == key_size) && (16 % block_size == 0);
+
+        template<size_t Size>
+        ENCSTR_ALWAYS_INLINE static std::array<uint8_t, Size> bulk_decrypt_ecb(std::array<uint8_t, Size> input, key_type key) noexcept
+        {
+            static_assert(bulk_decode, "Keystream does not tile a 16-byte lane!");
+            uint8_t pattern[16];
+            for(size_t j = 0; j < 16; ++j)
+                pattern[j] = key[j % key_size];
+
+            const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+            size_t i = 0;
+            for(; i + 16 <= Size; i += 16)
+            {
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(input.data() + i), _mm_xor_si128(c, k));
+            }
+            for(; i < Size; ++i)
+                input[i] ^= pattern[i % 16];
+
+            return input;
+        }
+
+        template<size_t Size>
+        ENCSTR_ALWAYS_INLINE static std::array<uint8_t, Size> bulk_decrypt_cbc(std::array<uint8_t, Size> input, key_type key, block_type iv) noexcept
+        {
+            static_assert(bulk_decode, "Keystream does not tile a 16-byte lane!");
+            uint8_t pattern[16];
+            for(size_t j = 0; j < 16; ++j)
+                pattern[j] = key[j % key_size];
+
+            // in decrypt direction every block only needs the previous
+            // ciphertext block, so the chaining stream is just the input
+            // shifted by one block with the iv in front
+            std::array<uint8_t, Size> prev;
+            for(size_t j = 0; j < block_size; ++j)
+                prev[j] = iv[j];
+            for(size_t j = block_size; j < Size; ++j)
+                prev[j] = input[j - block_size];
+
+            const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+            size_t i = 0;
+            for(; i + 16 <= Size; i += 16)
+            {
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+                const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev.data() + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(input.data() + i), _mm_xor_si128(_mm_xor_si128(c, k), p));
+            }
+            for(; i < Size; ++i)
+                input[i] ^= pattern[i % 16] ^ prev[i];
+
+            return input;
+        }
     };
 
     using xor_cipher_t = basic_xor_cipher_t<xor_default_block_size, std::clamp<size_t>(xor_default_block_size, xor_default_key_size_min, xor_default_key_size_max)>;
@@ -92,6 +92,89 @@ namespace encstr::ciphers
 
             return decoder.data;
         }
+
+        // runtime multi-block decode: the 32 rounds of one block form a
+        // serial dependency chain, but blocks of one string are independent
+        // in decrypt direction, so four blocks run their rounds interleaved
+        // and the chain no longer bounds throughput; round constants and
+        // key words are shared across lanes (see ecb.hpp / cbc.hpp for the
+        // dispatch, the constexpr encrypt side is untouched)
+        constexpr static bool bulk_decode = true;
+
+        ENCSTR_ALWAYS_INLINE static uint32_t load_word_(const uint8_t* p) noexcept
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+        ENCSTR_ALWAYS_INLINE static void store_word_(uint8_t* p, uint32_t v) noexcept
+        {
+            p[0] = static_cast<uint8_t>(v & 0xff);
+            p[1] = static_cast<uint8_t>((v >> 8) & 0xff);
+            p[2] = static_cast<uint8_t>((v >> 16) & 0xff);
+            p[3] = static_cast<uint8_t>((v >> 24) & 0xff);
+        }
+
+        template<size_t Lanes>
+        ENCSTR_ALWAYS_INLINE static void decode_lanes_(uint8_t* data, key_type key) noexcept
+        {
+            uint32_t v0[Lanes];
+            uint32_t v1[Lanes];
+            for(size_t j = 0; j < Lanes; ++j)
+            {
+                v0[j] = load_word_(data + j * block_size);
+                v1[j] = load_word_(data + j * block_size + 4);
+            }
+
+            for(auto i = 0u; i < Rounds; ++i)
+            {
+                const uint32_t sum1 = static_cast<uint32_t>(static_cast<uint64_t>(Delta) * static_cast<uint64_t>(Rounds - i));
+                const uint32_t sum0 = sum1 - Delta;
+                const uint32_t mix1 = sum1 + read_uint<uint32_t>(key, ((sum1 >> 11) & 3) * 4);
+                const uint32_t mix0 = sum0 + read_uint<uint32_t>(key, (sum0 & 3) * 4);
+
+                for(size_t j = 0; j < Lanes; ++j)
+                    v1[j] -= (((v0[j] << 4) ^ (v0[j] >> 5)) + v0[j]) ^ mix1;
+                for(size_t j = 0; j < Lanes; ++j)
+                    v0[j] -= (((v1[j] << 4) ^ (v1[j] >> 5)) + v1[j]) ^ mix0;
+            }
+
+            for(size_t j = 0; j < Lanes; ++j)
+            {
+                store_word_(data + j * block_size, v0[j]);
+                store_word_(data + j * block_size + 4, v1[j]);
+            }
+        }
+
+        template<size_t Size>
+        ENCSTR_ALWAYS_INLINE static std::array<uint8_t, Size> bulk_decrypt_ecb(std::array<uint8_t, Size> input, key_type key) noexcept
+        {
+            constexpr size_t nblocks = Size / block_size;
+            size_t b = 0;
+            for(; b + 4 <= nblocks; b += 4)
+                decode_lanes_<4>(input.data() + b * block_size, key);
+            for(; b < nblocks; ++b)
+                decode_lanes_<1>(input.data() + b * block_size, key);
+
+            return input;
+        }
+
+        template<size_t Size>
+        ENCSTR_ALWAYS_INLINE static std::array<uint8_t, Size> bulk_decrypt_cbc(std::array<uint8_t, Size> input, key_type key, block_type iv) noexcept
+        {
+            // in decrypt direction every block only needs the previous
+            // ciphertext block, captured here before decoding in place
+            std::array<uint8_t, Size> prev;
+            for(size_t j = 0; j < block_size; ++j)
+                prev[j] = iv[j];
+            for(size_t j = block_size; j < Size; ++j)
+                prev[j] = input[j - block_size];
+
+            input = bulk_decrypt_ecb(input, key);
+
+            for(size_t j = 0; j < Size; ++j)
+                input[j] ^= prev[j];
+
+            return input;
+        }
     };
 
     using xtea_cipher_t = basic_xtea_cipher_t<xtea_default_rounds, xtea_default_delta>;
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <string_view>
 
 namespace encstr
 {
@@ -15,4 +16,41 @@ namespace encstr
 
 		return result;
     }
+
+    constexpr uint32_t fnv1a(std::wstring_view str)
+    {
+        uint32_t result = 0x811c9dc5ul;
+
+		for (auto chr : str)
+		{
+			result = static_cast<uint32_t>(static_cast<uint64_t>(result) ^ static_cast<uint64_t>(chr));
+			result = static_cast<uint32_t>(static_cast<uint64_t>(result) * static_cast<uint64_t>(16777619ul));
+		}
+
+		return result;
+    }
+
+    // ASCII case-folded variant: module and export names compare
+    // case-insensitively on Windows, so both the constexpr hash of the
+    // protected literal and the runtime hash of an enumerated name have to
+    // fold the same way
+    template<typename CharT>
+    constexpr uint32_t fnv1a_i(std::basic_string_view<CharT> str)
+    {
+        uint32_t result = 0x811c9dc5ul;
+
+		for (auto chr : str)
+		{
+			if (chr >= 'A' && chr <= 'Z')
+				chr = static_cast<CharT>(chr + ('a' - 'A'));
+
+			result = static_cast<uint32_t>(static_cast<uint64_t>(result) ^ static_cast<uint64_t>(chr));
+			result = static_cast<uint32_t>(static_cast<uint64_t>(result) * static_cast<uint64_t>(16777619ul));
+		}
+
+		return result;
+    }
+
+    constexpr uint32_t fnv1a_i(std::string_view str) { return fnv1a_i<char>(str); }
+    constexpr uint32_t fnv1a_i(std::wstring_view str) { return fnv1a_i<wchar_t>(str); }
 }
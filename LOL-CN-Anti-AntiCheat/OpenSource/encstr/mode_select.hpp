@@ -0,0 +1,31 @@
+#pragma once
+#include <type_traits>
+#include <encstr/ecb.hpp>
+#include <encstr/cbc.hpp>
+#include <encstr/string.hpp>
+
+namespace encstr
+{
+    constexpr size_t mode_select_threshold = 32;
+
+    // ECB decrypt is embarrassingly block-parallel while CBC threads the
+    // chaining stream through every block. For short strings whose only
+    // exposure is equal blocks producing equal ciphertext -- module names,
+    // version tags -- that trade is fine, so a site can pick the mode per
+    // string by character count instead of chaining everything
+    template<typename CipherT, size_t Length, size_t Threshold = mode_select_threshold>
+    struct mode_select
+    {
+        using type = std::conditional_t<(Length <= Threshold), ecb_t<CipherT>, cbc_t<CipherT>>;
+    };
+
+    template<typename CipherT, size_t Length, size_t Threshold = mode_select_threshold>
+    using mode_select_t = typename mode_select<CipherT, Length, Threshold>::type;
+}
+
+// like ENCRYPT_STRING_AUTO, but takes the raw cipher and lets the length
+// threshold choose the block mode
+#define ENCRYPT_STRING_SELECT(CharT, CipherT, Str) []() { constexpr encstr::string_t<CharT, encstr::mode_select_t<CipherT, std::size(Str) - 1>, std::make_index_sequence<std::size(Str) - 1>> str(Str, encstr::generate_random_block<__COUNTER__, CipherT::key_size>(), encstr::generate_random_block<__COUNTER__, CipherT::block_size>()); return str; }().decrypt()
+
+#define ENCRYPT_STRING_SELECT_A(CipherT, Str) ENCRYPT_STRING_SELECT(char, CipherT, Str)
+#define ENCRYPT_STRING_SELECT_W(CipherT, Str) ENCRYPT_STRING_SELECT(wchar_t, CipherT, Str)
@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <encstr/always_inline.hpp>
+#include <encstr/random_generator.hpp>
+#include <encstr/string.hpp>
+
+namespace encstr
+{
+    namespace pool_detail
+    {
+        using warm_fn = const void* (*)();
+
+        struct warm_entry
+        {
+            const void* addr;
+            warm_fn fn;
+        };
+
+        inline std::vector<warm_entry>& registry() noexcept(false)
+        {
+            static std::vector<warm_entry> entries;
+            return entries;
+        }
+
+        inline bool register_entry(const void* addr, warm_fn fn) noexcept(false)
+        {
+            registry().push_back({ addr, fn });
+            return true;
+        }
+    }
+
+#if defined(_MSC_VER)
+    // pooled storages live in their own image section: the warm pass walks
+    // them in address order touching each page once, and because nothing
+    // else shares those pages the module can flip them read-only afterwards
+    // (image sections are page-aligned)
+#pragma section("encsp$a", read, write)
+#pragma section("encsp$m", read, write)
+#pragma section("encsp$z", read, write)
+    namespace pool_detail
+    {
+        __declspec(allocate("encsp$a")) __declspec(selectany) extern const char section_first = 0;
+        __declspec(allocate("encsp$z")) __declspec(selectany) extern const char section_last = 0;
+    }
+#define ENCSTR_POOL_STORAGE __declspec(allocate("encsp$m"))
+
+    // bounds of the pooled storage section, for callers that re-protect
+    // the warmed pages (see dll_module::attach)
+    inline std::pair<const void*, const void*> pool_storage_range() noexcept
+    {
+        return { &pool_detail::section_first, &pool_detail::section_last };
+    }
+#else
+#define ENCSTR_POOL_STORAGE
+#endif
+
+    // structural literal wrapper: the characters are part of the template
+    // identity, so the same literal names the same specialization in every
+    // translation unit and the linker folds the storage to one instance
+    template<typename CharT, size_t N>
+    struct pool_literal_t
+    {
+        using value_type = CharT;
+        static constexpr size_t length = N - 1;
+
+        CharT chars[N];
+
+        constexpr pool_literal_t(const CharT (&str)[N]) noexcept :
+            chars{}
+        {
+            for(size_t i = 0; i < N; ++i)
+                chars[i] = str[i];
+        }
+
+        constexpr uint32_t hash() const noexcept
+        {
+            uint32_t result = 0x811c9dc5ul;
+
+            for(size_t i = 0; i < length; ++i)
+            {
+                result = static_cast<uint32_t>(static_cast<uint64_t>(result) ^ static_cast<uint64_t>(chars[i]));
+                result = static_cast<uint32_t>(static_cast<uint64_t>(result) * static_cast<uint64_t>(16777619ul));
+            }
+
+            return result;
+        }
+    };
+
+    template<typename EncryptT, pool_literal_t Lit>
+    struct pool_entry_t
+    {
+        using literal_type = std::remove_cv_t<decltype(Lit)>;
+        using char_type = typename literal_type::value_type;
+        using string_type = string_t<char_type, EncryptT, std::make_index_sequence<literal_type::length>>;
+
+        // key and iv derive from the literal hash instead of the call-site
+        // counter: every site naming the same (literal, cipher) pair has to
+        // produce byte-identical storage or the instances could not fold
+        constexpr static int32_t key_seed = static_cast<int32_t>(Lit.hash() & 0xff) + 1;
+        constexpr static int32_t iv_seed = static_cast<int32_t>((Lit.hash() >> 8) & 0xff) + 1;
+
+        ENCSTR_POOL_STORAGE inline static constinit const string_type storage{
+            std::basic_string_view<char_type>{ Lit.chars, literal_type::length },
+            generate_random_block<key_seed, EncryptT::key_size>(),
+            generate_random_block<iv_seed, EncryptT::block_size>() };
+
+        inline static const bool warmed = pool_detail::register_entry(&storage, []() -> const void* { return storage.decrypt(); });
+
+        ENCSTR_ALWAYS_INLINE static const char_type* get() noexcept(false)
+        {
+            (void)warmed;
+
+            return storage.decrypt();
+        }
+    };
+
+    // decrypts every pooled string in one linear pass, in storage address
+    // order so each page is touched once; call it on the attach path so no
+    // first-use site pays the cold decrypt
+    inline void warm_pool() noexcept(false)
+    {
+        auto& entries = pool_detail::registry();
+        std::sort(entries.begin(), entries.end(), [](const pool_detail::warm_entry& lhs, const pool_detail::warm_entry& rhs) { return lhs.addr < rhs.addr; });
+
+        for(const auto& entry : entries)
+            entry.fn();
+    }
+}
+
+#define ENCRYPT_STRING_POOLED(EncryptorT, Str) encstr::pool_entry_t<EncryptorT, Str>::get()
+
+#define ENCRYPT_STRING_POOLED_A(EncryptorT, Str) ENCRYPT_STRING_POOLED(EncryptorT, Str)
+#define ENCRYPT_STRING_POOLED_W(EncryptorT, Str) ENCRYPT_STRING_POOLED(EncryptorT, Str)
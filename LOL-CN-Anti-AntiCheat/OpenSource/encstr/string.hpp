@@ -1,7 +1,10 @@
 #pragma once
+#include <atomic>
+#include <mutex>
 #include <utility>
 #include <string_view>
 #include <encstr/always_inline.hpp>
+#include <encstr/fnv1a.hpp>
 #include <encstr/utils.hpp>
 #include <encstr/random_generator.hpp>
 
@@ -24,18 +27,47 @@ namespace encstr
 		ENCSTR_ALWAYS_INLINE constexpr explicit string_t(std::basic_string_view<value_type> str, key_type key, iv_type iv) noexcept :
             key_{ key },
             iv_{ iv },
-			data_{ encrypt(str, key, iv) }
+			data_{ encrypt(str, key, iv) },
+            hash_{ fnv1a(str) },
+            hash_i_{ fnv1a_i(str) }
 		{
 		}
 
+        // constexpr hashes of the plaintext, captured before encryption:
+        // call sites that only compare against enumerated module or export
+        // names can hash the candidate and match on these, so the plaintext
+        // never materializes at runtime
+        ENCSTR_ALWAYS_INLINE constexpr uint32_t plain_hash() const noexcept { return hash_; }
+        // ASCII case-folded, for Windows name matching (see fnv1a_i)
+        ENCSTR_ALWAYS_INLINE constexpr uint32_t plain_hash_i() const noexcept { return hash_i_; }
+
+        // plain_ is not copyable, and the copy made at runtime from the
+        // constexpr original must get its own decrypt-once state anyway
+        string_t(const string_t& rhs) noexcept :
+            key_{ rhs.key_ },
+            iv_{ rhs.iv_ },
+            data_{ rhs.data_ },
+            hash_{ rhs.hash_ },
+            hash_i_{ rhs.hash_i_ }
+        {
+            if(rhs.plain_.load(std::memory_order_acquire))
+                plain_.store(reinterpret_cast<const value_type*>(data_.data()), std::memory_order_release);
+        }
+
 		ENCSTR_ALWAYS_INLINE const value_type* decrypt() const noexcept(false)
 		{
-            if(!decrypted_)
+            // steady state is one acquire load of the published pointer; the
+            // decrypt itself runs exactly once even when several threads hit
+            // the string cold
+            const auto* plain = plain_.load(std::memory_order_acquire);
+            if(plain)
+                return plain;
+
+            std::call_once(once_, [this]
             {
-                decrypted_ = true;
-
                 data_ = encryptor_type::decrypt(data_, key_, iv_);
-            }
+                plain_.store(reinterpret_cast<const value_type*>(data_.data()), std::memory_order_release);
+            });
 
             return reinterpret_cast<const value_type*>(data_.data());
 		}
@@ -44,7 +76,10 @@ namespace encstr
         key_type key_;
         iv_type iv_;
 		mutable storage_type data_;
-		mutable bool decrypted_ = false;
+        uint32_t hash_;
+        uint32_t hash_i_;
+		mutable std::atomic<const value_type*> plain_ = nullptr;
+		mutable std::once_flag once_;
 
 		ENCSTR_ALWAYS_INLINE static constexpr storage_type encrypt(std::basic_string_view<value_type> str, key_type key, iv_type iv) noexcept
 		{
@@ -68,6 +103,57 @@ namespace encstr
 	};
 }
 
+namespace encstr
+{
+    template<typename EncryptT, typename IndexT>
+	class dual_string_t;
+
+    // one literal, two encrypted representations: the wide original and a
+    // narrow copy generated in the constexpr constructor, so consumers that
+    // need UTF-8 (logging, the net uplink) read the narrow side directly
+    // instead of transcoding the decrypted wide string at runtime. the
+    // narrowing is a plain cast per character -- every name we protect is
+    // ASCII, where UTF-16 and UTF-8 code units coincide
+    template<typename EncryptT, size_t... I>
+	class dual_string_t<EncryptT, std::index_sequence<I...>> {
+	public:
+        using encryptor_type = EncryptT;
+        using key_type = typename encryptor_type::key_type;
+        using iv_type = typename encryptor_type::iv_type;
+        using wide_type = string_t<wchar_t, EncryptT, std::index_sequence<I...>>;
+        using narrow_type = string_t<char, EncryptT, std::index_sequence<I...>>;
+
+		ENCSTR_ALWAYS_INLINE constexpr explicit dual_string_t(std::wstring_view str, key_type key, iv_type iv) noexcept :
+            wide_{ str, key, iv },
+            narrow_{ std::string_view{ narrow_chars(str).data(), str.size() }, key, iv }
+		{
+		}
+
+		ENCSTR_ALWAYS_INLINE const wchar_t* wide() const noexcept(false) { return wide_.decrypt(); }
+		ENCSTR_ALWAYS_INLINE const char* narrow() const noexcept(false) { return narrow_.decrypt(); }
+
+        ENCSTR_ALWAYS_INLINE constexpr uint32_t plain_hash() const noexcept { return wide_.plain_hash(); }
+        ENCSTR_ALWAYS_INLINE constexpr uint32_t plain_hash_i() const noexcept { return wide_.plain_hash_i(); }
+
+	private:
+        wide_type wide_;
+        narrow_type narrow_;
+
+		ENCSTR_ALWAYS_INLINE static constexpr std::array<char, sizeof...(I) + 1> narrow_chars(std::wstring_view str) noexcept
+		{
+            std::array<char, sizeof...(I) + 1> result{ 0 };
+
+            for(size_t i = 0; i < str.size() && i < sizeof...(I); ++i)
+                result[i] = static_cast<char>(str[i]);
+
+            return result;
+		}
+	};
+}
+
+#define MAKE_ENCRYPTED_DUAL_STRING(EncryptorT, Str, Key, IV) encstr::dual_string_t<EncryptorT, std::make_index_sequence<std::size(Str) - 1>>(Str, Key, IV)
+#define MAKE_ENCRYPTED_DUAL_STRING_AUTO(EncryptorT, Str) encstr::dual_string_t<EncryptorT, std::make_index_sequence<std::size(Str) - 1>>(Str, encstr::generate_random_block<__COUNTER__, EncryptorT::key_size>(), encstr::generate_random_block<__COUNTER__, EncryptorT::block_size>())
+
 #define MAKE_ENCRYPTED_STRING(CharT, EncryptorT, Str, Key, IV) encstr::string_t<CharT, EncryptorT, std::make_index_sequence<std::size(Str) - 1>>(Str, Key, IV)
 #define MAKE_ENCRYPTED_STRING_AUTO(CharT, EncryptorT, Str) MAKE_ENCRYPTED_STRING(CharT, EncryptorT, Str, encstr::generate_random_block<__COUNTER__, EncryptorT::key_size>(), encstr::generate_random_block<__COUNTER__, EncryptorT::block_size>())
 
@@ -23,4 +23,41 @@ namespace encstr
             return std::forward<Fn>(fn)(0, std::forward<Args>(args)...);
         }
     };
+
+    // spelled-out short counts: the dominant strings are a handful of
+    // blocks, and straight-line call sequences do not depend on the
+    // optimizer collapsing the recursion above
+    template<>
+    struct unroll_t<2, 1>
+    {
+        template<typename Fn, typename... Args>
+        ENCSTR_ALWAYS_INLINE constexpr auto operator()(Fn&& fn, Args&&... args) noexcept -> decltype(std::forward<Fn>(fn)(std::declval<size_t>(), std::forward<Args>(args)...))
+        {
+            std::forward<Fn>(fn)(0, std::forward<Args>(args)...);
+            return std::forward<Fn>(fn)(1, std::forward<Args>(args)...);
+        }
+    };
+    template<>
+    struct unroll_t<3, 1>
+    {
+        template<typename Fn, typename... Args>
+        ENCSTR_ALWAYS_INLINE constexpr auto operator()(Fn&& fn, Args&&... args) noexcept -> decltype(std::forward<Fn>(fn)(std::declval<size_t>(), std::forward<Args>(args)...))
+        {
+            std::forward<Fn>(fn)(0, std::forward<Args>(args)...);
+            std::forward<Fn>(fn)(1, std::forward<Args>(args)...);
+            return std::forward<Fn>(fn)(2, std::forward<Args>(args)...);
+        }
+    };
+    template<>
+    struct unroll_t<4, 1>
+    {
+        template<typename Fn, typename... Args>
+        ENCSTR_ALWAYS_INLINE constexpr auto operator()(Fn&& fn, Args&&... args) noexcept -> decltype(std::forward<Fn>(fn)(std::declval<size_t>(), std::forward<Args>(args)...))
+        {
+            std::forward<Fn>(fn)(0, std::forward<Args>(args)...);
+            std::forward<Fn>(fn)(1, std::forward<Args>(args)...);
+            std::forward<Fn>(fn)(2, std::forward<Args>(args)...);
+            return std::forward<Fn>(fn)(3, std::forward<Args>(args)...);
+        }
+    };
 }
@@ -1,10 +1,19 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <type_traits>
 #include <encstr/always_inline.hpp>
 
 namespace encstr
 {
+    // detects ciphers that opt into the runtime bulk-decode fast path
+    // (see ciphers/xor_cipher.hpp); the block modes use it to swap the
+    // per-byte decode loop for wide xors when not constant-evaluated
+    template<typename C, typename = void>
+    struct has_bulk_decode : std::false_type {};
+    template<typename C>
+    struct has_bulk_decode<C, std::enable_if_t<C::bulk_decode>> : std::true_type {};
+
     template<size_t Alignment, size_t Size>
     struct align_to
     {
@@ -0,0 +1,161 @@
+// PatternBench: measures PatternSearch algorithm variants over a captured
+// module dump. Usage: PatternBench.exe <module dump file>
+#include <windows.h>
+#include <intrin.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <BlackBone/Patterns/PatternSearch.h>
+#include <BlackBone/Patterns/PatternBatch.h>
+#include <BlackBone/Patterns/StaticPattern.hpp>
+
+namespace
+{
+	constexpr int k_iterations = 5;
+	constexpr uint8_t k_wildcard = 0xCC;
+
+	auto LoadDump(const wchar_t* path) -> std::vector<uint8_t>
+	{
+		std::ifstream v_file(path, std::ios::binary | std::ios::ate);
+		if (!v_file.is_open())
+			return {};
+
+		const auto v_size = static_cast<size_t>(v_file.tellg());
+		std::vector<uint8_t> v_data(v_size);
+		v_file.seekg(0);
+		v_file.read(reinterpret_cast<char*>(v_data.data()), v_size);
+		return v_data;
+	}
+
+	//Pattern taken from the dump itself so every variant has real matches
+	auto MakePatterns(const std::vector<uint8_t>& dump) -> std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
+	{
+		const size_t v_offest = dump.size() / 2;
+		std::vector<uint8_t> v_exact(dump.begin() + v_offest, dump.begin() + v_offest + 16);
+
+		auto v_masked = v_exact;
+		v_masked[4] = k_wildcard;
+		v_masked[5] = k_wildcard;
+		v_masked[11] = k_wildcard;
+
+		return { v_exact, v_masked };
+	}
+
+	template<typename run_t>
+	void Bench(const char* name, size_t bytes, run_t&& run)
+	{
+		LARGE_INTEGER v_freq = {};
+		QueryPerformanceFrequency(&v_freq);
+
+		double v_best_sec = 1e100;
+		uint64_t v_best_cycles = ~0ull;
+		size_t v_matches = 0;
+
+		for (int i = 0; i < k_iterations; ++i)
+		{
+			LARGE_INTEGER v_begin = {}, v_end = {};
+			QueryPerformanceCounter(&v_begin);
+			const auto v_c0 = __rdtsc();
+
+			v_matches = run();
+
+			const auto v_c1 = __rdtsc();
+			QueryPerformanceCounter(&v_end);
+
+			const auto v_sec = double(v_end.QuadPart - v_begin.QuadPart) / double(v_freq.QuadPart);
+			if (v_sec < v_best_sec)
+			{
+				v_best_sec = v_sec;
+				v_best_cycles = v_c1 - v_c0;
+			}
+		}
+
+		const auto v_mbs = (double(bytes) / (1024.0 * 1024.0)) / v_best_sec;
+		printf("%-28s %10.1f MB/s  %12llu cycles  %zu matches\n",
+			name, v_mbs, static_cast<unsigned long long>(v_best_cycles), v_matches);
+	}
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+	if (argc < 2)
+	{
+		printf("usage: PatternBench.exe <module dump file>\n");
+		return 1;
+	}
+
+	auto v_dump = LoadDump(argv[1]);
+	if (v_dump.size() < 64)
+	{
+		printf("failed to load dump\n");
+		return 1;
+	}
+
+	printf("dump: %zu bytes, best of %d runs\n\n", v_dump.size(), k_iterations);
+
+	auto [v_exact, v_masked] = MakePatterns(v_dump);
+	blackbone::vecScanResult v_out;
+
+	//Exact scan, scalar BMH
+	{
+		blackbone::PatternSearch v_search(v_exact);
+		Bench("exact/bmh", v_dump.size(), [&]() {
+			v_out.clear();
+			return v_search.Search(v_dump.data(), v_dump.size(), v_out);
+		});
+	}
+
+	//Exact scan, AVX2/SSE2 kernel
+	{
+		blackbone::PatternSearch v_search(v_exact);
+		v_search.SetSearchEngine(blackbone::PatternSearch::Vectorized);
+		Bench("exact/vectorized", v_dump.size(), [&]() {
+			v_out.clear();
+			return v_search.Search(v_dump.data(), v_dump.size(), v_out);
+		});
+	}
+
+	//Masked scan, wildcard-aware BMH
+	{
+		blackbone::PatternSearch v_search(v_masked);
+		Bench("wildcard/bmh", v_dump.size(), [&]() {
+			v_out.clear();
+			return v_search.Search(k_wildcard, v_dump.data(), v_dump.size(), v_out);
+		});
+	}
+
+	//First-match early exit
+	{
+		blackbone::PatternSearch v_search(v_exact);
+		Bench("exact/first-match", v_dump.size(), [&]() {
+			return v_search.SearchFirst(v_dump.data(), v_dump.size()) != 0 ? size_t(1) : size_t(0);
+		});
+	}
+
+	//Multi-pattern single pass
+	{
+		blackbone::PatternBatch v_batch;
+		v_batch.Add(v_exact);
+		v_batch.Add(std::vector<uint8_t>(v_dump.begin(), v_dump.begin() + 16));
+		v_batch.Add(std::vector<uint8_t>(v_dump.end() - 16, v_dump.end()));
+
+		std::vector<blackbone::vecScanResult> v_results;
+		Bench("batch/aho-corasick x3", v_dump.size(), [&]() {
+			return v_batch.Scan(v_dump.data(), v_dump.size(), v_results);
+		});
+	}
+
+	//Compile-time compiled pattern
+	{
+		static constexpr auto v_static = blackbone::make_static_pattern("\x48\x8B\xCC\xCC\x05\x48\x8B\xCC\xCC\x06");
+		Bench("static/constexpr-bmh", v_dump.size(), [&]() {
+			v_out.clear();
+			return v_static.Search(v_dump.data(), v_dump.size(), v_out);
+		});
+	}
+
+	return 0;
+}
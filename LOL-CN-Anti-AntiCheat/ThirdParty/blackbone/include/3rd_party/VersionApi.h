@@ -26,6 +26,8 @@ enum eBuildThreshold
     Build_RS3 = 16299,
     Build_RS4 = 17134,
     Build_RS5 = 17763,
+    Build_Win11_21H2 = 22000,
+    Build_Win11_24H2 = 26100,
     Build_RS_MAX = 99999,
 };
 
@@ -42,6 +44,8 @@ enum eVerShort
     Win10_RS3,      // Windows 10 Fall Creators update
     Win10_RS4,      // Windows 10 Spring Creators update
     Win10_RS5,      // Windows 10 October 2018 update
+    Win11,          // Windows 11
+    Win11_24H2,     // Windows 11 2024 update
 };
 
 struct WinVersion
@@ -103,7 +107,11 @@ BLACKBONE_API inline void InitVersion()
         switch (fullver)
         {
         case _WIN32_WINNT_WIN10:
-            if (g_WinVer.native.dwBuildNumber >= Build_RS5)
+            if (g_WinVer.native.dwBuildNumber >= Build_Win11_24H2)
+                g_WinVer.ver = Win11_24H2;
+            else if (g_WinVer.native.dwBuildNumber >= Build_Win11_21H2)
+                g_WinVer.ver = Win11;
+            else if (g_WinVer.native.dwBuildNumber >= Build_RS5)
                 g_WinVer.ver = Win10_RS5;
             else if (g_WinVer.native.dwBuildNumber >= Build_RS4)
                 g_WinVer.ver = Win10_RS4;
@@ -273,6 +281,18 @@ IsWindows10RS5OrGreater()
     return IsWindowsVersionOrGreater( HIBYTE( _WIN32_WINNT_WIN10 ), LOBYTE( _WIN32_WINNT_WIN10 ), 0, Build_RS5 );
 }
 
+VERSIONHELPERAPI
+IsWindows11OrGreater()
+{
+    return IsWindowsVersionOrGreater( HIBYTE( _WIN32_WINNT_WIN10 ), LOBYTE( _WIN32_WINNT_WIN10 ), 0, Build_Win11_21H2 );
+}
+
+VERSIONHELPERAPI
+IsWindows1124H2OrGreater()
+{
+    return IsWindowsVersionOrGreater( HIBYTE( _WIN32_WINNT_WIN10 ), LOBYTE( _WIN32_WINNT_WIN10 ), 0, Build_Win11_24H2 );
+}
+
 VERSIONHELPERAPI
 IsWindowsServer()
 {
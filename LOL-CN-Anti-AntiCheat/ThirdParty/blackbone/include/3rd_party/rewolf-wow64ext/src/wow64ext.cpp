@@ -22,6 +22,7 @@
 
 #include <Windows.h>
 #include <cstddef>
+#include <cstring>
 #include "internal.h"
 #include "wow64ext.h"
 #include "CMemPtr.h"
@@ -178,6 +179,130 @@ _ls_e:                                                  ;//
 }
 #pragma warning(pop)
 
+#pragma warning(push)
+#pragma warning(disable : 4409)
+extern "C" BOOL __cdecl X64CallBatch(X64_CALL_ENTRY* entries, int count)
+{
+	if (!g_isWow64 || nullptr == entries)
+		return FALSE;
+
+	if (count <= 0)
+		return TRUE;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (entries[i].argC > 8)
+			return FALSE;
+		entries[i].rax = 0;
+	}
+
+#ifdef _M_IX86
+    DWORD back_esp = 0;
+	WORD back_fs = 0;
+    __asm
+    {
+        ;// reset FS segment, to properly handle RFG
+        mov    back_fs, fs
+        mov    eax, 0x2B
+        mov    fs, ax
+
+        ;// keep original esp in back_esp variable
+        mov    back_esp, esp
+
+        ;// align esp to 0x10, same requirement as in X64Call
+        and    esp, 0xFFFFFFF0
+
+        X64_Start();
+
+        ;// single x64 window for the whole batch - one segment switch
+        ;// and one FS swap amortized over every queued call
+
+        push   esi                                      ;// push    rsi
+        push   edi                                      ;// push    rdi
+        push   ebx                                      ;// push    rbx
+                                                        ;//
+        mov    esi, entries                             ;// mov     esi, dword ptr [entries]       ; high part of RSI is zeroed
+        mov    ebx, count                               ;// mov     ebx, dword ptr [count]         ; high part of RBX is zeroed
+                                                        ;//
+_next_entry:                                            ;//
+  REX_W test   ebx, ebx                                 ;// test    rbx, rbx
+        jz     _batch_done                              ;// je      _batch_done
+                                                        ;//
+        ;// rdi = number of stack arguments             ;//
+  REX_W mov    eax, dword ptr [esi + 8]                 ;// mov     rax, qword ptr [rsi + 8]
+  REX_W mov    edi, eax                                 ;// mov     rdi, rax
+  REX_W sub    edi, 4                                   ;// sub     rdi, 4
+        jns    _n_ok                                    ;// jns     _n_ok
+  REX_W xor    edi, edi                                 ;// xor     rdi, rdi
+_n_ok:                                                  ;//
+                                                        ;//
+        ;// stack adjustment, loop body starts at       ;//
+        ;// rsp % 16 == 8, call needs 16-byte alignment ;//
+  REX_W mov    eax, edi                                 ;// mov     rax, rdi
+        test   al, 1                                    ;// test    al, 1
+        jnz    _no_adjust                               ;// jnz     _no_adjust
+  REX_W sub    esp, 8                                   ;// sub     rsp, 8
+_no_adjust:                                             ;//
+                                                        ;//
+        ;// put stack arguments in place                ;//
+  REX_W test   eax, eax                                 ;// test    rax, rax
+        jz     _args_done                               ;// je      _args_done
+_push_args:                                             ;//
+        push   dword ptr [esi + eax*8 + 0x28]           ;// push    qword ptr [rsi + rax*8 + 28h]
+  REX_W sub    eax, 1                                   ;// sub     rax, 1
+        jnz    _push_args                               ;// jnz     _push_args
+_args_done:                                             ;//
+                                                        ;//
+        ;// fill first four arguments                   ;//
+  REX_W mov    ecx, dword ptr [esi + 0x10]              ;// mov     rcx, qword ptr [rsi + 10h]
+  REX_W mov    edx, dword ptr [esi + 0x18]              ;// mov     rdx, qword ptr [rsi + 18h]
+        push   dword ptr [esi + 0x20]                   ;// push    qword ptr [rsi + 20h]
+        X64_Pop(_R8);                                   ;// pop     r8
+        push   dword ptr [esi + 0x28]                   ;// push    qword ptr [rsi + 28h]
+        X64_Pop(_R9);                                   ;// pop     r9
+                                                        ;//
+        ;// create stack space for spilling registers   ;//
+  REX_W sub    esp, 0x20                                ;// sub     rsp, 20h
+                                                        ;//
+        call   dword ptr [esi]                          ;// call    qword ptr [rsi]
+                                                        ;//
+        ;// store return value                          ;//
+  REX_W mov    dword ptr [esi + 0x50], eax              ;// mov     qword ptr [rsi + 50h], rax
+                                                        ;//
+        ;// cleanup stack back to the loop invariant    ;//
+  REX_W mov    eax, edi                                 ;// mov     rax, rdi
+  REX_W lea    esp, dword ptr [esp + eax*8 + 0x20]      ;// lea     rsp, [rsp + rax*8 + 20h]
+        test   al, 1                                    ;// test    al, 1
+        jnz    _no_unadjust                             ;// jnz     _no_unadjust
+  REX_W add    esp, 8                                   ;// add     rsp, 8
+_no_unadjust:                                           ;//
+                                                        ;//
+        ;// advance to the next entry                   ;//
+  REX_W add    esi, 0x58                                ;// add     rsi, 58h    ; sizeof(X64_CALL_ENTRY)
+  REX_W sub    ebx, 1                                   ;// sub     rbx, 1
+        jmp    _next_entry                              ;// jmp     _next_entry
+_batch_done:                                            ;//
+                                                        ;//
+        pop    ebx                                      ;// pop     rbx
+        pop    edi                                      ;// pop     rdi
+        pop    esi                                      ;// pop     rsi
+
+        X64_End();
+
+        mov    ax, ds
+        mov    ss, ax
+        mov    esp, back_esp
+
+        ;// restore FS segment
+        mov    ax, back_fs
+        mov    fs, ax
+    }
+#endif // _M_IX86
+
+	return TRUE;
+}
+#pragma warning(pop)
+
 void getMem64(void* dstMem, DWORD64 srcMem, size_t sz)
 {
     if ((nullptr == dstMem) || (0 == srcMem) || (0 == sz))
@@ -432,6 +557,54 @@ extern "C" DWORD64 __cdecl GetProcAddress64(DWORD64 hModule, char* funcName)
     return funcRet;
 }
 
+// Resolved export cache for GetProcAddress64Cached. Entries are
+// append-only and published through the 'ready' flag, so lookups
+// need no lock
+#define X64_FUNC_CACHE_SIZE     64
+#define X64_FUNC_CACHE_NAME_LEN 48
+
+struct X64FuncCacheEntry
+{
+	DWORD64 hModule;
+	DWORD64 addr;
+	volatile LONG ready;
+	char name[X64_FUNC_CACHE_NAME_LEN];
+};
+
+static X64FuncCacheEntry g_x64FuncCache[X64_FUNC_CACHE_SIZE];
+static volatile LONG g_x64FuncCacheCount = 0;
+
+extern "C" DWORD64 __cdecl GetProcAddress64Cached(DWORD64 hModule, const char* funcName)
+{
+	LONG cached = g_x64FuncCacheCount;
+	if (cached > X64_FUNC_CACHE_SIZE)
+		cached = X64_FUNC_CACHE_SIZE;
+
+	for (LONG i = 0; i < cached; i++)
+	{
+		if (g_x64FuncCache[i].ready && g_x64FuncCache[i].hModule == hModule && 0 == strcmp(g_x64FuncCache[i].name, funcName))
+			return g_x64FuncCache[i].addr;
+	}
+
+	DWORD64 addr = GetProcAddress64(hModule, const_cast<char*>(funcName));
+	size_t nameLen = strlen(funcName);
+	if (0 == addr || nameLen >= X64_FUNC_CACHE_NAME_LEN)
+		return addr;
+
+	LONG idx = InterlockedIncrement(&g_x64FuncCacheCount) - 1;
+	if (idx >= X64_FUNC_CACHE_SIZE)
+	{
+		InterlockedDecrement(&g_x64FuncCacheCount);
+		return addr;
+	}
+
+	g_x64FuncCache[idx].hModule = hModule;
+	g_x64FuncCache[idx].addr = addr;
+	memcpy(g_x64FuncCache[idx].name, funcName, nameLen + 1);
+	InterlockedExchange(&g_x64FuncCache[idx].ready, 1);
+	return addr;
+}
+
 extern "C" SIZE_T __cdecl VirtualQueryEx64(HANDLE hProcess, DWORD64 lpAddress, MEMORY_BASIC_INFORMATION64* lpBuffer, SIZE_T dwLength)
 {
     static DWORD64 ntqvm = 0;
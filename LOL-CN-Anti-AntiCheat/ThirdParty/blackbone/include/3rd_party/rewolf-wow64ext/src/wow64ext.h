@@ -359,9 +359,24 @@ struct _CONTEXT64_2
 #   define SPEC dllimport
 #endif
 
+// Single call of a batched barrier crossing.
+// All fields are 8 bytes wide so the x64 side can address the
+// entry with plain qword loads
+#pragma pack(push, 8)
+struct X64_CALL_ENTRY
+{
+    DWORD64 func;       // Target function
+    DWORD64 argC;       // Argument count, 8 at most
+    DWORD64 args[8];    // Arguments, first four go into rcx/rdx/r8/r9
+    DWORD64 rax;        // Return value
+};
+#pragma pack(pop)
+
 extern "C"
 {
 	DWORD64 __cdecl X64Call(DWORD64 func, int argC, ...);
+	BOOL __cdecl X64CallBatch(X64_CALL_ENTRY* entries, int count);
+	DWORD64 __cdecl GetProcAddress64Cached(DWORD64 hModule, const char* funcName);
 	DWORD64 __cdecl GetModuleHandle64(wchar_t* lpModuleName);
     DWORD64 __cdecl getNTDLL64();
 	DWORD64 __cdecl GetProcAddress64(DWORD64 hModule, char* funcName);
@@ -8,7 +8,52 @@
 namespace blackbone
 {
 
-using AsmHelperPtr = std::unique_ptr<IAsmHelper>;
+namespace detail
+{
+    /// <summary>
+    /// Thread-local cache of reusable assembler contexts.
+    /// RemoteExec and hook installation assemble many tiny snippets in
+    /// bursts; reuse turns CodeHolder/Zone construction into a buffer reset
+    /// </summary>
+    struct AsmPool
+    {
+        // Cached contexts per architecture, per thread
+        static const size_t MaxCached = 4;
+
+        std::vector<std::unique_ptr<IAsmHelper>> free32;
+        std::vector<std::unique_ptr<IAsmHelper>> free64;
+
+        static AsmPool& instance()
+        {
+            thread_local AsmPool pool;
+            return pool;
+        }
+    };
+
+    /// <summary>
+    /// Return helper to the thread pool instead of destroying it
+    /// </summary>
+    struct AsmRecycler
+    {
+        void operator()( IAsmHelper* helper ) const
+        {
+            if (helper == nullptr)
+                return;
+
+            auto& pool = AsmPool::instance();
+            auto& slot = helper->assembler()->getArch() == asmjit::kArchX86 ? pool.free32 : pool.free64;
+            if (slot.size() < AsmPool::MaxCached)
+            {
+                helper->Reset();
+                slot.emplace_back( helper );
+            }
+            else
+                delete helper;
+        }
+    };
+}
+
+using AsmHelperPtr = std::unique_ptr<IAsmHelper, detail::AsmRecycler>;
 
 /// <summary>
 /// Get suitable asm generator
@@ -29,12 +74,25 @@ public:
     /// <returns>AsmHelperBase interface</returns>
     static AsmHelperPtr GetAssembler( eAsmArch arch )
     {
+        auto& pool = detail::AsmPool::instance();
         switch (arch)
         {
         case asm32:
-            return std::make_unique<AsmHelper32>();
+            if (!pool.free32.empty())
+            {
+                AsmHelperPtr helper( pool.free32.back().release() );
+                pool.free32.pop_back();
+                return helper;
+            }
+            return AsmHelperPtr( new AsmHelper32() );
         case asm64:
-            return std::make_unique<AsmHelper64>();
+            if (!pool.free64.empty())
+            {
+                AsmHelperPtr helper( pool.free64.back().release() );
+                pool.free64.pop_back();
+                return helper;
+            }
+            return AsmHelperPtr( new AsmHelper64() );
         default:
             return nullptr;
         }
@@ -49,7 +107,7 @@ public:
     {
         if (mt == mt_default)
             mt = sizeof( intptr_t ) > sizeof( int32_t ) ? mt_mod64 : mt_mod32;
-        
+
         switch (mt)
         {
         case mt_mod32:
@@ -79,11 +137,11 @@ public:
     static AsmHelperPtr GetAssembler()
     {
 #ifdef USE64
-        return std::make_unique<AsmHelper64>();
+        return GetAssembler( asm64 );
 #else
-        return std::make_unique<AsmHelper32>();
+        return GetAssembler( asm32 );
 #endif
     }
 };
 
-}
\ No newline at end of file
+}
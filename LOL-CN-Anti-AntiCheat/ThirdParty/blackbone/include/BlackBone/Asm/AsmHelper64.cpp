@@ -170,6 +170,15 @@ void AsmHelper64::EnableX64CallStack( bool state )
     _stackEnabled = state;
 }
 
+/// <summary>
+/// Return helper to a just-constructed state
+/// </summary>
+void AsmHelper64::Reset()
+{
+    IAsmHelper::Reset();
+    _stackEnabled = true;
+}
+
 /// <summary>
 /// Push function argument
 /// </summary>
@@ -65,6 +65,11 @@ public:
     /// </param>
     virtual void EnableX64CallStack( bool state );
 
+    /// <summary>
+    /// Return helper to a just-constructed state
+    /// </summary>
+    virtual void Reset();
+
 private:
     AsmHelper64( const AsmHelper64& ) = delete;
     AsmHelper64& operator = (const AsmHelper64&) = delete;
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "IAsmHelper.h"
+
+#include <array>
+#include <type_traits>
+
+namespace blackbone
+{
+
+// Marshaling class of one argument, mirrors the classification done at
+// runtime by the AsmVariant constructor
+enum class eArgClass : uint8_t
+{
+    Imm,        // Passed as an immediate (numbers, raw and function pointers)
+    Fp32,       // float
+    Fp64,       // double or long double
+    DataPtr,    // Pointer whose pointee is copied to the target and read back
+    DataStruct, // Structure passed by value through a local copy
+};
+
+/// <summary>
+/// Classify an argument type at compile time.
+/// Must stay in lockstep with the AsmVariant constructor - same order of
+/// checks, same outcomes - or the layout will disagree with the variants
+/// actually built at the call site
+/// </summary>
+/// <returns>Marshaling class</returns>
+template<typename T>
+constexpr eArgClass ClassifyArg()
+{
+    using RAW_T = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<RAW_T, float>)
+        return eArgClass::Fp32;
+    else if constexpr (std::is_same_v<RAW_T, double> || std::is_same_v<RAW_T, long double>)
+        return eArgClass::Fp64;
+    else if constexpr (AsmVariant::is_number<RAW_T>)
+        return eArgClass::Imm;
+    else if constexpr (std::is_array_v<std::remove_reference_t<T>>)
+        return eArgClass::DataPtr;
+    else if constexpr (AsmVariant::is_string_ptr<RAW_T, char>)
+        return eArgClass::DataPtr;
+    else if constexpr (AsmVariant::is_string_ptr<RAW_T, wchar_t>)
+        return eArgClass::DataPtr;
+    else if constexpr (AsmVariant::is_void_ptr<RAW_T>)
+        return eArgClass::Imm;
+    else if constexpr (std::is_same_v<RAW_T, HWND>)
+        return eArgClass::Imm;
+    else if constexpr (std::is_function_v<AsmVariant::cleanup_t<RAW_T>>)
+        return eArgClass::Imm;
+    else if constexpr (std::is_pointer_v<RAW_T>)
+        return eArgClass::DataPtr;
+    else if constexpr (sizeof( RAW_T ) <= sizeof( uintptr_t ))
+        return eArgClass::Imm;
+    else
+        return eArgClass::DataStruct;
+}
+
+/// <summary>
+/// Per-signature call frame layout, computed entirely at compile time.
+/// For signatures fixed at compile time - every RemoteFunction - the
+/// argument classes, the number of arguments needing data copies and the
+/// stack frame sizes for both target bitnesses are constants, so the
+/// invocation path can elide whole marshaling steps with if-constexpr
+/// instead of branching per argument per call
+/// </summary>
+template<eCalligConvention Conv, typename... Args>
+struct AsmCallLayout
+{
+    static constexpr size_t arg_count = sizeof...(Args);
+
+    // Trailing Imm is a sentinel so empty signatures still aggregate-init
+    static constexpr std::array<eArgClass, sizeof...(Args) + 1> classes = { ClassifyArg<Args>()..., eArgClass::Imm };
+
+    // Stack bytes one argument occupies on a 32-bit frame
+    template<typename T>
+    static constexpr size_t StackSlot32()
+    {
+        constexpr eArgClass cls = ClassifyArg<T>();
+        if constexpr (cls == eArgClass::Fp64)
+            return sizeof( uint64_t );
+        else if constexpr (cls == eArgClass::DataStruct)
+            return (sizeof( std::decay_t<T> ) + sizeof( uint32_t ) - 1) & ~(sizeof( uint32_t ) - 1);
+        else if constexpr (cls == eArgClass::Imm && sizeof( std::decay_t<T> ) > sizeof( uint32_t ))
+            return sizeof( uint64_t );
+        else
+            return sizeof( uint32_t );
+    }
+
+    // Arguments consumed by registers on a 32-bit frame
+    static constexpr size_t reg_args32 =
+        Conv == cc_fastcall ? (arg_count < 2 ? arg_count : 2) :
+        Conv == cc_thiscall ? (arg_count < 1 ? arg_count : 1) : 0;
+
+    // Arguments passed in registers on a 64-bit frame
+    static constexpr size_t reg_args64 = arg_count < 4 ? arg_count : 4;
+
+    // Bytes pushed for the arguments on a 32-bit frame, register args excluded
+    static constexpr size_t stack_bytes32 = (StackSlot32<Args>() + ... + size_t( 0 )) - reg_args32 * sizeof( uint32_t );
+
+    // Frame reservation on a 64-bit frame: shadow space or one home slot
+    // per argument, aligned the way AsmHelper64::GenCall aligns it
+    static constexpr size_t stack_bytes64 =
+        (((arg_count > 4 ? arg_count * sizeof( uint64_t ) : 0x28) + 0xF) & ~size_t( 0xF )) + sizeof( uint64_t );
+
+    // Arguments that marshal through a local data copy and are read back
+    // after the call; zero means the whole writeback pass can be elided
+    static constexpr size_t data_copy_count =
+        ((size_t( ClassifyArg<Args>() == eArgClass::DataPtr || ClassifyArg<Args>() == eArgClass::DataStruct )) + ... + size_t( 0 ));
+
+    // Signature carries floating point arguments
+    static constexpr bool has_fp_args =
+        ((ClassifyArg<Args>() == eArgClass::Fp32 || ClassifyArg<Args>() == eArgClass::Fp64) || ... || false);
+};
+
+}
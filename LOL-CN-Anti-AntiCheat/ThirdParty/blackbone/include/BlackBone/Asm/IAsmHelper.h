@@ -60,6 +60,15 @@ namespace blackbone
         virtual void SaveRetValAndSignalEvent( uint64_t pSetEvent, uint64_t ResultPtr, uint64_t EventPtr, uint64_t errPtr, eReturnType rtype = rt_int32 ) = 0;
         virtual void EnableX64CallStack( bool state ) = 0;
 
+        /// <summary>
+        /// Return helper to a just-constructed state, keeping the
+        /// underlying code buffer for reuse
+        /// </summary>
+        BLACKBONE_API virtual void Reset()
+        {
+            _assembler.reset( false );
+        }
+
         /// <summary>
         /// Switch processor into WOW64 emulation mode
         /// </summary>
@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "LDasm.h"
+#include <intrin.h>
 
 /*
  Instruction format:
@@ -771,6 +772,142 @@ unsigned int __fastcall ldasm( void *code, ldasm_data *ld, uint32_t is64 )
     return s;
 }
 
+unsigned int __fastcall ldasm_batch( void *code, uint32_t size, ldasm_batch_entry *entries, uint32_t max_count, uint32_t is64 )
+/*
+ Description:
+ Disassemble a whole region in one pass
+
+ Arguments:
+ code      - pointer to the code for disassemble
+ size      - region size in bytes
+ entries   - receives one record per instruction
+ max_count - entries capacity
+ is64      - set this flag for 64-bit code, and clear for 32-bit
+
+ Return:
+ number of filled entries, last one has F_INVALID set on decode failure
+ */
+{
+    uint8_t *p = (uint8_t*)code;
+    uint32_t offset = 0;
+    uint32_t count = 0;
+
+    /* dummy check */
+    if (!code || !entries || !max_count)
+        return 0;
+
+    while (offset < size && count < max_count)
+    {
+        ldasm_batch_entry *e = &entries[count];
+        uint32_t len = ldasm( p + offset, &e->data, is64 );
+
+        e->offset = (uint16_t)offset;
+        e->length = (uint8_t)len;
+        count++;
+
+        if (!len || (e->data.flags & F_INVALID))
+            break;
+
+        offset += len;
+    }
+
+    return count;
+}
+
+/*
+ Direct-mapped cache of decoded prologue regions. Hook sites are
+ revisited on every hook/unhook/re-hook cycle with unchanged bytes,
+ so the second visit is a slot copy instead of a decode pass.
+ A probe of the first region bytes detects re-patched sites.
+ */
+#define LDASM_CACHE_SLOTS 64    /* power of two */
+
+typedef struct _ldasm_cache_slot
+{
+    size_t            addr;     /* region start, 0 if slot is empty */
+    uint64_t          probe;    /* first region bytes at decode time */
+    uint32_t          size;
+    uint32_t          is64;
+    uint32_t          count;
+    ldasm_batch_entry entries[LDASM_BATCH_MAX];
+} ldasm_cache_slot;
+
+static ldasm_cache_slot batch_cache[LDASM_CACHE_SLOTS];
+static volatile long    batch_cache_lock = 0;
+
+static void cache_acquire( void )
+{
+    while (_InterlockedExchange( &batch_cache_lock, 1 ))
+        _mm_pause();
+}
+
+static void cache_release( void )
+{
+    _InterlockedExchange( &batch_cache_lock, 0 );
+}
+
+unsigned int __fastcall ldasm_batch_cached( void *code, uint32_t size, ldasm_batch_entry *entries, uint32_t max_count, uint32_t is64 )
+/*
+ Description:
+ Same as ldasm_batch, serving revisited regions from the cache
+
+ Return:
+ number of filled entries
+ */
+{
+    size_t addr = (size_t)code;
+    ldasm_cache_slot *slot;
+    uint64_t probe;
+    uint32_t count;
+
+    /* dummy check */
+    if (!code || !entries || !max_count)
+        return 0;
+
+    slot = &batch_cache[(addr >> 4) & (LDASM_CACHE_SLOTS - 1)];
+    memcpy( &probe, code, sizeof( probe ) );
+
+    cache_acquire();
+    if (slot->addr == addr && slot->probe == probe && slot->size == size && slot->is64 == is64)
+    {
+        count = slot->count < max_count ? slot->count : max_count;
+        memcpy( entries, slot->entries, count * sizeof( ldasm_batch_entry ) );
+        cache_release();
+        return count;
+    }
+    cache_release();
+
+    count = ldasm_batch( code, size, entries, max_count, is64 );
+
+    if (count && count <= LDASM_BATCH_MAX)
+    {
+        cache_acquire();
+        slot->addr = addr;
+        slot->probe = probe;
+        slot->size = size;
+        slot->is64 = is64;
+        slot->count = count;
+        memcpy( slot->entries, entries, count * sizeof( ldasm_batch_entry ) );
+        cache_release();
+    }
+
+    return count;
+}
+
+void __fastcall ldasm_cache_flush( void )
+/*
+ Description:
+ Drop all cached regions
+ */
+{
+    uint32_t i;
+
+    cache_acquire();
+    for (i = 0; i < LDASM_CACHE_SLOTS; i++)
+        batch_cache[i].addr = 0;
+    cache_release();
+}
+
 // Get function size
 unsigned long __fastcall SizeOfProc( void *Proc )
 {
@@ -39,7 +39,21 @@ typedef struct _ldasm_data
     uint8_t  imm_size;
 } ldasm_data;
 
+/* One decoded instruction of a batch pass */
+typedef struct _ldasm_batch_entry
+{
+    uint16_t   offset;      /* Offset from region start */
+    uint8_t    length;      /* Instruction length */
+    ldasm_data data;        /* Full decode record */
+} ldasm_batch_entry;
+
+/* Max instructions per batch, covers a 128 byte prologue region */
+#define LDASM_BATCH_MAX 32
+
 BLACKBONE_API unsigned int  __fastcall ldasm( void *code, ldasm_data *ld, uint32_t is64 );
+BLACKBONE_API unsigned int  __fastcall ldasm_batch( void *code, uint32_t size, ldasm_batch_entry *entries, uint32_t max_count, uint32_t is64 );
+BLACKBONE_API unsigned int  __fastcall ldasm_batch_cached( void *code, uint32_t size, ldasm_batch_entry *entries, uint32_t max_count, uint32_t is64 );
+BLACKBONE_API void          __fastcall ldasm_cache_flush( void );
 BLACKBONE_API unsigned long __fastcall SizeOfProc( void *Proc );
 BLACKBONE_API void*         __fastcall ResolveJmp( void *Proc );
 
@@ -109,6 +109,7 @@ NTSTATUS DriverControl::Reload( std::wstring path /*= L"" */ )
 /// <returns>Status code</returns>
 NTSTATUS DriverControl::Unload()
 {
+    _hDriverAsync.reset();
     _hDriver.reset();
     return UnloadDriver( DRIVER_SVC_NAME );
 }
@@ -486,6 +487,335 @@ NTSTATUS DriverControl::ProtectMem( DWORD pid, ptr_t base, ptr_t size, DWORD pro
     return STATUS_SUCCESS;
 }
 
+/// <summary>
+/// Queue a memory read
+/// </summary>
+/// <param name="pid">Target PID</param>
+/// <param name="base">Target base</param>
+/// <param name="size">Data size</param>
+/// <param name="buffer">Buffer address</param>
+void DriverBatch::ReadMem( DWORD pid, ptr_t base, ptr_t size, PVOID buffer )
+{
+    BATCH_OP op = { 0 };
+
+    op.type = BatchOp_CopyMemory;
+    op.status = STATUS_PENDING;
+    op.copyMem.pid = pid;
+    op.copyMem.targetPtr = base;
+    op.copyMem.localbuf = (ULONGLONG)buffer;
+    op.copyMem.size = size;
+    op.copyMem.write = FALSE;
+
+    _ops.emplace_back( op );
+}
+
+/// <summary>
+/// Queue a memory write
+/// </summary>
+/// <param name="pid">Target PID</param>
+/// <param name="base">Target base</param>
+/// <param name="size">Data size</param>
+/// <param name="buffer">Buffer address</param>
+void DriverBatch::WriteMem( DWORD pid, ptr_t base, ptr_t size, PVOID buffer )
+{
+    BATCH_OP op = { 0 };
+
+    op.type = BatchOp_CopyMemory;
+    op.status = STATUS_PENDING;
+    op.copyMem.pid = pid;
+    op.copyMem.targetPtr = base;
+    op.copyMem.localbuf = (ULONGLONG)buffer;
+    op.copyMem.size = size;
+    op.copyMem.write = TRUE;
+
+    _ops.emplace_back( op );
+}
+
+/// <summary>
+/// Queue a protection change
+/// </summary>
+/// <param name="pid">Target PID</param>
+/// <param name="base">Region base address</param>
+/// <param name="size">Region size</param>
+/// <param name="protection">New protection</param>
+void DriverBatch::ProtectMem( DWORD pid, ptr_t base, ptr_t size, DWORD protection )
+{
+    BATCH_OP op = { 0 };
+
+    op.type = BatchOp_ProtectMemory;
+    op.status = STATUS_PENDING;
+    op.protectMem.pid = pid;
+    op.protectMem.base = base;
+    op.protectMem.size = size;
+    op.protectMem.newProtection = protection;
+
+    _ops.emplace_back( op );
+}
+
+/// <summary>
+/// Submit a command buffer as one ioctl.
+/// Per-command results are written back into the batch
+/// </summary>
+/// <param name="batch">Queued commands</param>
+/// <returns>Status of the submission itself</returns>
+NTSTATUS DriverControl::ExecuteBatch( DriverBatch& batch )
+{
+    if (batch._ops.empty())
+        return STATUS_SUCCESS;
+
+    // Not loaded
+    if (_hDriver == INVALID_HANDLE_VALUE)
+        return STATUS_DEVICE_DOES_NOT_EXIST;
+
+    DWORD bytes = 0;
+    const uint32_t count = static_cast<uint32_t>(batch._ops.size());
+    std::vector<uint8_t> buffer( sizeof( BATCH_OPS_HEADER ) + (count - 1) * sizeof( BATCH_OP ) );
+
+    auto pHeader = reinterpret_cast<BATCH_OPS_HEADER*>(buffer.data());
+    pHeader->count = count;
+    memcpy( pHeader->ops, batch._ops.data(), count * sizeof( BATCH_OP ) );
+
+    // One transition for the whole batch, the driver fills statuses in place
+    if (!DeviceIoControl( _hDriver, IOCTL_BLACKBONE_BATCH_OPS, buffer.data(), (DWORD)buffer.size(), buffer.data(), (DWORD)buffer.size(), &bytes, NULL ))
+        return LastNtStatus();
+
+    memcpy( batch._ops.data(), pHeader->ops, count * sizeof( BATCH_OP ) );
+    return STATUS_SUCCESS;
+}
+
+namespace
+{
+
+// In-flight overlapped request. Owned by the wait callback once the
+// ioctl is pending; freed after the promise is satisfied
+struct AsyncIoContext
+{
+    OVERLAPPED ovl = { 0 };
+    HANDLE hDevice = NULL;
+    HANDLE hWait = NULL;
+    std::vector<uint8_t> buffer;                            // Shared input/output buffer
+    std::function<void( NTSTATUS, const uint8_t* )> complete;
+    std::promise<NTSTATUS> promise;
+};
+
+/// <summary>
+/// Thread-pool wait callback: harvest overlapped result, run the
+/// copy-back callback and release the request
+/// </summary>
+/// <param name="param">AsyncIoContext</param>
+VOID CALLBACK AsyncIoComplete( PVOID param, BOOLEAN /*timeout*/ )
+{
+    auto pContext = static_cast<AsyncIoContext*>(param);
+
+    DWORD bytes = 0;
+    NTSTATUS status = STATUS_SUCCESS;
+    if (!GetOverlappedResult( pContext->hDevice, &pContext->ovl, &bytes, FALSE ))
+        status = LastNtStatus();
+
+    if (pContext->complete)
+        pContext->complete( status, pContext->buffer.data() );
+
+    pContext->promise.set_value( status );
+
+    UnregisterWait( pContext->hWait );
+    CloseHandle( pContext->ovl.hEvent );
+    delete pContext;
+}
+
+/// <summary>
+/// Make an already-completed future
+/// </summary>
+/// <param name="status">Status code</param>
+/// <returns>Ready future</returns>
+std::future<NTSTATUS> MakeReadyFuture( NTSTATUS status )
+{
+    std::promise<NTSTATUS> promise;
+    promise.set_value( status );
+    return promise.get_future();
+}
+
+}
+
+/// <summary>
+/// Open the second, FILE_FLAG_OVERLAPPED driver handle used by async requests
+/// </summary>
+/// <returns>Status code</returns>
+NTSTATUS DriverControl::EnsureAsyncHandle()
+{
+    if (_hDriverAsync)
+        return STATUS_SUCCESS;
+
+    // Not loaded
+    if (_hDriver == INVALID_HANDLE_VALUE)
+        return STATUS_DEVICE_DOES_NOT_EXIST;
+
+    _hDriverAsync = CreateFileW(
+        BLACKBONE_DEVICE_FILE,
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL
+        );
+
+    return _hDriverAsync ? STATUS_SUCCESS : LastNtStatus();
+}
+
+/// <summary>
+/// Issue an overlapped ioctl. Completion is delivered through the
+/// returned future; the optional callback runs first and gets the
+/// output buffer so results can be copied back to the caller
+/// </summary>
+/// <param name="code">Ioctl code</param>
+/// <param name="input">Input data</param>
+/// <param name="inSize">Input size</param>
+/// <param name="outSize">Output size</param>
+/// <param name="complete">Completion callback</param>
+/// <returns>Future completion status</returns>
+std::future<NTSTATUS> DriverControl::CallAsync(
+    DWORD code,
+    const void* input,
+    DWORD inSize,
+    DWORD outSize,
+    std::function<void( NTSTATUS, const uint8_t* )> complete /*= {}*/
+    )
+{
+    NTSTATUS status = EnsureAsyncHandle();
+    if (!NT_SUCCESS( status ))
+        return MakeReadyFuture( status );
+
+    auto pContext = new AsyncIoContext();
+    pContext->hDevice = _hDriverAsync;
+    pContext->buffer.resize( inSize > outSize ? inSize : outSize );
+    memcpy( pContext->buffer.data(), input, inSize );
+    pContext->complete = std::move( complete );
+    pContext->ovl.hEvent = CreateEventW( NULL, TRUE, FALSE, NULL );
+
+    auto future = pContext->promise.get_future();
+
+    // Register before submission so the wait handle is valid whenever the event fires
+    RegisterWaitForSingleObject( &pContext->hWait, pContext->ovl.hEvent, &AsyncIoComplete, pContext, INFINITE, WT_EXECUTEONLYONCE );
+
+    if (!DeviceIoControl( _hDriverAsync, code, pContext->buffer.data(), inSize, pContext->buffer.data(), outSize, NULL, &pContext->ovl ) &&
+        GetLastError() != ERROR_IO_PENDING)
+    {
+        status = LastNtStatus();
+
+        UnregisterWait( pContext->hWait );
+        CloseHandle( pContext->ovl.hEvent );
+        delete pContext;
+
+        return MakeReadyFuture( status );
+    }
+
+    return future;
+}
+
+/// <summary>
+/// Submit a command buffer through an overlapped ioctl.
+/// The batch must stay valid until the future is ready
+/// </summary>
+/// <param name="batch">Queued commands</param>
+/// <returns>Future status of the submission itself</returns>
+std::future<NTSTATUS> DriverControl::ExecuteBatchAsync( DriverBatch& batch )
+{
+    if (batch._ops.empty())
+        return MakeReadyFuture( STATUS_SUCCESS );
+
+    const uint32_t count = static_cast<uint32_t>(batch._ops.size());
+    std::vector<uint8_t> buffer( sizeof( BATCH_OPS_HEADER ) + (count - 1) * sizeof( BATCH_OP ) );
+
+    auto pHeader = reinterpret_cast<BATCH_OPS_HEADER*>(buffer.data());
+    pHeader->count = count;
+    memcpy( pHeader->ops, batch._ops.data(), count * sizeof( BATCH_OP ) );
+
+    auto pBatch = &batch;
+    return CallAsync(
+        IOCTL_BLACKBONE_BATCH_OPS, buffer.data(), (DWORD)buffer.size(), (DWORD)buffer.size(),
+        [pBatch, count]( NTSTATUS status, const uint8_t* pOut )
+        {
+            if (NT_SUCCESS( status ))
+                memcpy( pBatch->_ops.data(), reinterpret_cast<const BATCH_OPS_HEADER*>(pOut)->ops, count * sizeof( BATCH_OP ) );
+        } );
+}
+
+/// <summary>
+/// Read process memory without blocking the caller.
+/// The buffer must stay valid until the future is ready
+/// </summary>
+/// <param name="pid">Target PID</param>
+/// <param name="base">Target base</param>
+/// <param name="size">Data size</param>
+/// <param name="buffer">Buffer address</param>
+/// <returns>Future completion status</returns>
+std::future<NTSTATUS> DriverControl::ReadMemAsync( DWORD pid, ptr_t base, ptr_t size, PVOID buffer )
+{
+    COPY_MEMORY copyMem = { 0 };
+
+    copyMem.pid = pid;
+    copyMem.targetPtr = base;
+    copyMem.localbuf = (ULONGLONG)buffer;
+    copyMem.size = size;
+    copyMem.write = FALSE;
+
+    return CallAsync( IOCTL_BLACKBONE_COPY_MEMORY, &copyMem, sizeof( copyMem ), 0 );
+}
+
+/// <summary>
+/// Write process memory without blocking the caller.
+/// The buffer must stay valid until the future is ready
+/// </summary>
+/// <param name="pid">Target PID</param>
+/// <param name="base">Target base</param>
+/// <param name="size">Data size</param>
+/// <param name="buffer">Buffer address</param>
+/// <returns>Future completion status</returns>
+std::future<NTSTATUS> DriverControl::WriteMemAsync( DWORD pid, ptr_t base, ptr_t size, PVOID buffer )
+{
+    COPY_MEMORY copyMem = { 0 };
+
+    copyMem.pid = pid;
+    copyMem.targetPtr = base;
+    copyMem.localbuf = (ULONGLONG)buffer;
+    copyMem.size = size;
+    copyMem.write = TRUE;
+
+    return CallAsync( IOCTL_BLACKBONE_COPY_MEMORY, &copyMem, sizeof( copyMem ), 0 );
+}
+
+/// <summary>
+/// Map a single memory region without blocking the caller.
+/// The result struct must stay valid until the future is ready
+/// </summary>
+/// <param name="pid">Target PID</param>
+/// <param name="base">Region base address</param>
+/// <param name="size">Region size</param>
+/// <param name="result">Mapped region info</param>
+/// <returns>Future completion status</returns>
+std::future<NTSTATUS> DriverControl::MapMemoryRegionAsync( DWORD pid, ptr_t base, uint32_t size, MapMemoryRegionResult& result )
+{
+    MAP_MEMORY_REGION data = { 0 };
+
+    data.pid = pid;
+    data.base = base;
+    data.size = size;
+
+    auto pResult = &result;
+    return CallAsync(
+        IOCTL_BLACKBONE_MAP_REGION, &data, sizeof( data ), sizeof( MAP_MEMORY_REGION_RESULT ),
+        [pResult]( NTSTATUS status, const uint8_t* pOut )
+        {
+            if (!NT_SUCCESS( status ))
+                return;
+
+            auto pMapResult = reinterpret_cast<const MAP_MEMORY_REGION_RESULT*>(pOut);
+
+            pResult->newPtr = pMapResult->newPtr;
+            pResult->originalPtr = pMapResult->originalPtr;
+            pResult->removedPtr = pMapResult->removedPtr;
+            pResult->removedSize = pMapResult->removedSize;
+            pResult->size = pMapResult->size;
+        } );
+}
+
 /// <summary>
 /// Inject DLL into arbitrary process
 /// </summary>
@@ -7,6 +7,8 @@
 #include "../../BlackBoneDrv/BlackBoneDef.h"
 
 #include <string>
+#include <functional>
+#include <future>
 #include <map>
 #include <vector>
 
@@ -30,11 +32,92 @@ struct MapMemoryRegionResult
 {
     ptr_t originalPtr;          // Address of region in the target process
     ptr_t newPtr;               // Address of mapped region in the current process
-    ptr_t removedPtr;           // Address of region unmapped because of address conflict 
+    ptr_t removedPtr;           // Address of region unmapped because of address conflict
     uint32_t size;              // Size of mapped region
     uint32_t removedSize;       // Size of unmapped region
 };
 
+// Batched command buffer, mirrored by the driver dispatch.
+// N operations are packed into one ioctl - one user->kernel transition
+// per batch instead of one per operation
+#ifndef IOCTL_BLACKBONE_BATCH_OPS
+#define IOCTL_BLACKBONE_BATCH_OPS (DWORD)CTL_CODE( FILE_DEVICE_BLACKBONE, 0x820, METHOD_BUFFERED, FILE_SPECIAL_ACCESS )
+#endif
+
+enum BatchOpType : uint32_t
+{
+    BatchOp_CopyMemory    = 0,  // COPY_MEMORY payload
+    BatchOp_ProtectMemory = 1,  // PROTECT_MEMORY payload
+};
+
+struct BATCH_OP
+{
+    uint32_t type;              // BatchOpType
+    NTSTATUS status;            // Per-command result, filled by the driver
+    union
+    {
+        COPY_MEMORY copyMem;        // BatchOp_CopyMemory
+        PROTECT_MEMORY protectMem;  // BatchOp_ProtectMemory
+    };
+};
+
+struct BATCH_OPS_HEADER
+{
+    uint32_t count;             // Number of commands that follow
+    BATCH_OP ops[1];
+};
+
+/// <summary>
+/// Command buffer for batched driver requests.
+/// Queue commands, submit through DriverControl::ExecuteBatch,
+/// then read per-command statuses back
+/// </summary>
+class DriverBatch
+{
+public:
+    /// <summary>
+    /// Queue a memory read
+    /// </summary>
+    /// <param name="pid">Target PID</param>
+    /// <param name="base">Target base</param>
+    /// <param name="size">Data size</param>
+    /// <param name="buffer">Buffer address</param>
+    BLACKBONE_API void ReadMem( DWORD pid, ptr_t base, ptr_t size, PVOID buffer );
+
+    /// <summary>
+    /// Queue a memory write
+    /// </summary>
+    /// <param name="pid">Target PID</param>
+    /// <param name="base">Target base</param>
+    /// <param name="size">Data size</param>
+    /// <param name="buffer">Buffer address</param>
+    BLACKBONE_API void WriteMem( DWORD pid, ptr_t base, ptr_t size, PVOID buffer );
+
+    /// <summary>
+    /// Queue a protection change
+    /// </summary>
+    /// <param name="pid">Target PID</param>
+    /// <param name="base">Region base address</param>
+    /// <param name="size">Region size</param>
+    /// <param name="protection">New protection</param>
+    BLACKBONE_API void ProtectMem( DWORD pid, ptr_t base, ptr_t size, DWORD protection );
+
+    /// <summary>
+    /// Get per-command status after ExecuteBatch
+    /// </summary>
+    /// <param name="index">Command index in queue order</param>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS status( size_t index ) const { return _ops[index].status; }
+
+    BLACKBONE_API size_t size() const { return _ops.size(); }
+    BLACKBONE_API bool empty() const { return _ops.empty(); }
+    BLACKBONE_API void clear() { _ops.clear(); }
+
+private:
+    friend class DriverControl;
+    std::vector<BATCH_OP> _ops;     // Queued commands
+};
+
 
 class DriverControl
 {
@@ -270,6 +353,55 @@ public:
     /// <returns>Status code</returns>
     BLACKBONE_API NTSTATUS UnlinkHandleTable( DWORD pid );
 
+    /// <summary>
+    /// Submit a command buffer as one ioctl.
+    /// Per-command results are written back into the batch
+    /// </summary>
+    /// <param name="batch">Queued commands</param>
+    /// <returns>Status of the submission itself</returns>
+    BLACKBONE_API NTSTATUS ExecuteBatch( DriverBatch& batch );
+
+    /// <summary>
+    /// Submit a command buffer through an overlapped ioctl.
+    /// The batch must stay valid until the future is ready
+    /// </summary>
+    /// <param name="batch">Queued commands</param>
+    /// <returns>Future status of the submission itself</returns>
+    BLACKBONE_API std::future<NTSTATUS> ExecuteBatchAsync( DriverBatch& batch );
+
+    /// <summary>
+    /// Read process memory without blocking the caller.
+    /// The buffer must stay valid until the future is ready
+    /// </summary>
+    /// <param name="pid">Target PID</param>
+    /// <param name="base">Target base</param>
+    /// <param name="size">Data size</param>
+    /// <param name="buffer">Buffer address</param>
+    /// <returns>Future completion status</returns>
+    BLACKBONE_API std::future<NTSTATUS> ReadMemAsync( DWORD pid, ptr_t base, ptr_t size, PVOID buffer );
+
+    /// <summary>
+    /// Write process memory without blocking the caller.
+    /// The buffer must stay valid until the future is ready
+    /// </summary>
+    /// <param name="pid">Target PID</param>
+    /// <param name="base">Target base</param>
+    /// <param name="size">Data size</param>
+    /// <param name="buffer">Buffer address</param>
+    /// <returns>Future completion status</returns>
+    BLACKBONE_API std::future<NTSTATUS> WriteMemAsync( DWORD pid, ptr_t base, ptr_t size, PVOID buffer );
+
+    /// <summary>
+    /// Map a single memory region without blocking the caller.
+    /// The result struct must stay valid until the future is ready
+    /// </summary>
+    /// <param name="pid">Target PID</param>
+    /// <param name="base">Region base address</param>
+    /// <param name="size">Region size</param>
+    /// <param name="result">Mapped region info</param>
+    /// <returns>Future completion status</returns>
+    BLACKBONE_API std::future<NTSTATUS> MapMemoryRegionAsync( DWORD pid, ptr_t base, uint32_t size, MapMemoryRegionResult& result );
+
     /// <summary>
     ///  Enumerate committed, accessible, non-guarded memory regions
     /// </summary>
@@ -311,8 +443,34 @@ private:
     /// <param name="path">Driver path</param>
     /// <returns>Status code</returns>
     LSTATUS PrepareDriverRegEntry( const std::wstring& svcName, const std::wstring& path );
+
+    /// <summary>
+    /// Open the second, FILE_FLAG_OVERLAPPED driver handle used by async requests
+    /// </summary>
+    /// <returns>Status code</returns>
+    NTSTATUS EnsureAsyncHandle();
+
+    /// <summary>
+    /// Issue an overlapped ioctl. Completion is delivered through the
+    /// returned future; the optional callback runs first and gets the
+    /// output buffer so results can be copied back to the caller
+    /// </summary>
+    /// <param name="code">Ioctl code</param>
+    /// <param name="input">Input data</param>
+    /// <param name="inSize">Input size</param>
+    /// <param name="outSize">Output size</param>
+    /// <param name="complete">Completion callback</param>
+    /// <returns>Future completion status</returns>
+    std::future<NTSTATUS> CallAsync(
+        DWORD code,
+        const void* input,
+        DWORD inSize,
+        DWORD outSize,
+        std::function<void( NTSTATUS, const uint8_t* )> complete = {}
+        );
 private:
     Handle _hDriver;
+    Handle _hDriverAsync;       // Overlapped handle for async requests
     NTSTATUS _loadStatus = STATUS_NOT_FOUND;
 };
 
@@ -7,13 +7,17 @@
 namespace blackbone
 {
 /// <summary>
-/// Function result or failure status
+/// Function result or failure status.
+/// The value lives in place - there is no heap allocation for the result
+/// wrapper itself, and the status-only constructor builds no T at all,
+/// so failure-heavy probe loops (speculative GetExport and friends) cost
+/// zero heap traffic on every miss
 /// </summary>
 template <typename T>
 struct call_result_t
 {
     NTSTATUS status = STATUS_UNSUCCESSFUL;          // Execution status
-    std::optional<T> result_data = std::nullopt;    // Returned value
+    std::optional<T> result_data = std::nullopt;    // Returned value, in-place storage
 
     call_result_t() = default;
 
@@ -45,27 +49,31 @@ struct call_result_t
 
 #else
 
-#include <memory>
 #include <cassert>
+#include <new>
+#include <stdexcept>
+#include <utility>
 
 namespace blackbone
 {
     /// <summary>
-    /// Function result or failure status
+    /// Function result or failure status.
+    /// Pre-C++17 fallback with the same in-place guarantee as the
+    /// std::optional build: the value is constructed inside the wrapper,
+    /// never on the heap, and the status-only constructor builds no T,
+    /// so failure-heavy probe loops cost zero heap traffic on every miss
     /// </summary>
     template <typename T>
     struct call_result_t
     {
         NTSTATUS status = STATUS_UNSUCCESSFUL;          // Execution status
-        std::unique_ptr<T> result_data;                 // Returned value
 
         call_result_t() = default;
 
         call_result_t(T result_, NTSTATUS status_ = STATUS_SUCCESS)
             : status(status_)
-            , result_data(std::make_unique<T>(std::move(result_)))
         {
-            assert(result_data.get());
+            emplace(std::move(result_));
         }
 
         call_result_t(NTSTATUS status_)
@@ -74,26 +82,97 @@ namespace blackbone
             assert(status_ != STATUS_SUCCESS);
         }
 
+        call_result_t(const call_result_t& other)
+            : status(other.status)
+        {
+            if (other._engaged)
+                emplace(*other.value());
+        }
+
+        call_result_t(call_result_t&& other)
+            : status(other.status)
+        {
+            if (other._engaged)
+                emplace(std::move(*other.value()));
+        }
+
+        call_result_t& operator =(const call_result_t& other)
+        {
+            if (this == &other)
+                return *this;
+
+            destroy();
+            status = other.status;
+            if (other._engaged)
+                emplace(*other.value());
+
+            return *this;
+        }
+
+        call_result_t& operator =(call_result_t&& other)
+        {
+            if (this == &other)
+                return *this;
+
+            destroy();
+            status = other.status;
+            if (other._engaged)
+                emplace(std::move(*other.value()));
+
+            return *this;
+        }
+
+        ~call_result_t()
+        {
+            destroy();
+        }
 
     private:
+        template<typename V>
+        void emplace(V&& v)
+        {
+            new (&_storage) T(std::forward<V>(v));
+            _engaged = true;
+        }
+
+        void destroy()
+        {
+            if (_engaged)
+            {
+                value()->~T();
+                _engaged = false;
+            }
+        }
+
         inline T* value() {
-            if (!result_data) {
+            if (!_engaged) {
                 throw std::logic_error("bad optional access.");
             }
-            return result_data.get();
+            return reinterpret_cast<T*>(&_storage);
+        }
+
+        inline const T* value() const {
+            if (!_engaged) {
+                throw std::logic_error("bad optional access.");
+            }
+            return reinterpret_cast<const T*>(&_storage);
         }
-    public:
 
+    public:
         inline bool success() const { return NT_SUCCESS( status ); }
         inline T& result() { return *value(); }
         inline const T& result() const { return *value(); }
-        inline T result(const T& def_val) const { return result_data ? *result_data.get() : def_val; }
+        inline T result(const T& def_val) const { return _engaged ? *value() : def_val; }
 
         inline explicit operator bool() const { return NT_SUCCESS( status ); }
         inline explicit operator T() const { return *value(); }
 
         inline T* operator ->() { return value(); }
         inline T& operator *() { return *value(); }
+
+    private:
+        alignas(T) unsigned char _storage[sizeof( T )];  // In-place value storage
+        bool _engaged = false;                           // Storage holds a constructed T
     };
 }
 #endif
\ No newline at end of file
@@ -198,6 +198,39 @@ typedef DWORD( NTAPI* fnNtQuerySection )(
     PULONG ReturnLength
     );
 
+// NtMapViewOfSection
+typedef NTSTATUS( NTAPI* fnNtMapViewOfSection )(
+    IN HANDLE SectionHandle,
+    IN HANDLE ProcessHandle,
+    IN OUT PVOID* BaseAddress,
+    IN ULONG_PTR ZeroBits,
+    IN SIZE_T CommitSize,
+    IN OUT PLARGE_INTEGER SectionOffset,
+    IN OUT PSIZE_T ViewSize,
+    IN ULONG InheritDisposition,
+    IN ULONG AllocationType,
+    IN ULONG Win32Protect
+    );
+
+// NtUnmapViewOfSection
+typedef NTSTATUS( NTAPI* fnNtUnmapViewOfSection )(
+    IN HANDLE ProcessHandle,
+    IN PVOID BaseAddress
+    );
+
+// RtlWaitOnAddress
+typedef NTSTATUS( NTAPI* fnRtlWaitOnAddress )(
+    IN volatile VOID* Address,
+    IN PVOID CompareAddress,
+    IN SIZE_T AddressSize,
+    IN OPTIONAL PLARGE_INTEGER Timeout
+    );
+
+// RtlWakeAddressAll
+typedef VOID( NTAPI* fnRtlWakeAddressAll )(
+    IN PVOID Address
+    );
+
 // NtSuspendProcess
 typedef NTSTATUS( NTAPI* fnNtSuspendProcess )(
     HANDLE ProcessHandle
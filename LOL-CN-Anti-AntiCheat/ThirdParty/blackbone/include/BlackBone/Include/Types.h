@@ -6,6 +6,8 @@
 #include <stdint.h>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <vector>
 
 namespace blackbone
 {
@@ -13,6 +15,11 @@ namespace blackbone
 using ptr_t = uint64_t;     // Generic pointer in remote process
 using module_t = ptr_t;  // Module base pointer
 
+// Scan match list. Allocator-aware so callers can back result storage with
+// a per-operation arena (see Misc/ScanArena.h) instead of the process heap;
+// default-constructed instances keep using the default resource
+using vecScanResult = std::pmr::vector<ptr_t>;
+
 // Type of barrier
 enum eBarrier
 {
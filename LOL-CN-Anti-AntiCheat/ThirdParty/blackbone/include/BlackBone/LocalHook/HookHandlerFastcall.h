@@ -29,6 +29,8 @@ struct HookHandler<R( __fastcall* )(Args...), C> : public DetourBase
     {
         ReturnType val_new, val_original;
 
+        const uint64_t tsc = _collectStats ? __rdtsc() : 0;
+
         DisableHook();
 
         if (_order == CallOrder::HookFirst)
@@ -49,6 +51,9 @@ struct HookHandler<R( __fastcall* )(Args...), C> : public DetourBase
         if (this->_hooked)
             EnableHook();
 
+        if (_collectStats)
+            AccountCall( static_cast<int64_t>(__rdtsc() - tsc) );
+
         return (_retType == ReturnMethod::UseOriginal ? val_original : val_new);
     }
 
@@ -0,0 +1,133 @@
+#include "HookTransaction.h"
+#include "../Process/Process.h"
+
+#include <map>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Queue a prepared detour for installation
+/// </summary>
+/// <param name="detour">Detour prepared with HookPrepare</param>
+/// <returns>true if the detour is ready to be committed</returns>
+bool HookTransaction::Queue( DetourBase& detour )
+{
+    // Only prepared, not yet installed inline patches can be batched
+    if (detour._hooked || detour._patchSize == 0 || detour._original == nullptr)
+        return false;
+
+    _pending.emplace_back( &detour );
+    return true;
+}
+
+/// <summary>
+/// Install all queued hooks in one suspend cycle
+/// </summary>
+/// <returns>true on success, queued hooks remain pending on failure</returns>
+bool HookTransaction::Commit()
+{
+    if (_pending.empty())
+        return true;
+
+    Process thisProc;
+    thisProc.Attach( GetCurrentProcessId() );
+
+    const DWORD currentTid = GetCurrentThreadId();
+
+    // Retry while some thread sits inside a patch range
+    for (int attempt = 0; attempt < 10; attempt++)
+    {
+        std::vector<ThreadPtr> suspended;
+        for (auto& thd : thisProc.threads().getAll())
+            if (thd->id() != currentTid && thd->Suspend())
+                suspended.emplace_back( thd );
+
+        if (!ThreadInPatchRange( suspended ))
+        {
+            ApplyPatches();
+
+            for (auto& thd : suspended)
+                thd->Resume();
+
+            _pending.clear();
+            return true;
+        }
+
+        for (auto& thd : suspended)
+            thd->Resume();
+
+        Sleep( 1 );
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Check if any suspended thread IP lies inside a pending patch range
+/// </summary>
+/// <param name="threads">Suspended threads</param>
+/// <returns>true if a conflict exists</returns>
+bool HookTransaction::ThreadInPatchRange( const std::vector<ThreadPtr>& threads )
+{
+    for (auto& thd : threads)
+    {
+        uintptr_t ip = 0;
+
+#ifdef USE64
+        _CONTEXT64 ctx = { 0 };
+        if (!NT_SUCCESS( thd->GetContext( ctx, CONTEXT64_CONTROL, true ) ))
+            return true;
+
+        ip = static_cast<uintptr_t>(ctx.Rip);
+#else
+        _CONTEXT32 ctx = { 0 };
+        if (!NT_SUCCESS( thd->GetContext( ctx, CONTEXT_CONTROL, true ) ))
+            return true;
+
+        ip = static_cast<uintptr_t>(ctx.Eip);
+#endif
+
+        for (auto* detour : _pending)
+        {
+            const uintptr_t start = reinterpret_cast<uintptr_t>(detour->_original);
+            if (ip >= start && ip < start + detour->_patchSize)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Write all pending patches, one protection flip per page
+/// </summary>
+void HookTransaction::ApplyPatches()
+{
+    // Gather pages covered by the patches
+    std::map<uintptr_t, DWORD> pages;
+    for (auto* detour : _pending)
+    {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(detour->_original) & ~uintptr_t( 0xFFF );
+        const uintptr_t end = (reinterpret_cast<uintptr_t>(detour->_original) + detour->_patchSize + 0xFFF) & ~uintptr_t( 0xFFF );
+
+        for (uintptr_t page = start; page < end; page += 0x1000)
+            pages.emplace( page, 0 );
+    }
+
+    for (auto& page : pages)
+        VirtualProtect( reinterpret_cast<void*>(page.first), 0x1000, PAGE_EXECUTE_READWRITE, &page.second );
+
+    for (auto* detour : _pending)
+    {
+        memcpy( detour->_original, detour->_newCode, detour->_patchSize );
+        detour->_hooked = true;
+    }
+
+    for (auto& page : pages)
+        VirtualProtect( reinterpret_cast<void*>(page.first), 0x1000, page.second, &page.second );
+
+    FlushInstructionCache( GetCurrentProcess(), nullptr, 0 );
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "LocalHookBase.h"
+
+#include <memory>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Atomic batch hook installation.
+/// Inline hooks prepared with Detour::HookPrepare are queued and then
+/// committed together: other threads are suspended once, no thread IP may
+/// sit inside any patch range, patch bytes are written with one protection
+/// flip per page, and threads are resumed. This shortens the race window
+/// and removes the per-hook suspend/resume cycles when a block of hooks
+/// is installed in one burst.
+/// </summary>
+class HookTransaction
+{
+public:
+    BLACKBONE_API HookTransaction() = default;
+
+    BLACKBONE_API HookTransaction( const HookTransaction& ) = delete;
+    BLACKBONE_API HookTransaction& operator =( const HookTransaction& ) = delete;
+
+    /// <summary>
+    /// Queue a prepared detour for installation
+    /// </summary>
+    /// <param name="detour">Detour prepared with HookPrepare</param>
+    /// <returns>true if the detour is ready to be committed</returns>
+    BLACKBONE_API bool Queue( DetourBase& detour );
+
+    /// <summary>
+    /// Install all queued hooks in one suspend cycle
+    /// </summary>
+    /// <returns>true on success, queued hooks remain pending on failure</returns>
+    BLACKBONE_API bool Commit();
+
+    /// <summary>
+    /// Discard queued hooks without installing them
+    /// </summary>
+    BLACKBONE_API void Clear() { _pending.clear(); }
+
+private:
+    /// <summary>
+    /// Check if any suspended thread IP lies inside a pending patch range
+    /// </summary>
+    /// <param name="threads">Suspended threads</param>
+    /// <returns>true if a conflict exists</returns>
+    bool ThreadInPatchRange( const std::vector<std::shared_ptr<class Thread>>& threads );
+
+    /// <summary>
+    /// Write all pending patches, one protection flip per page
+    /// </summary>
+    void ApplyPatches();
+
+private:
+    std::vector<DetourBase*> _pending;  // Prepared detours awaiting commit
+};
+
+}
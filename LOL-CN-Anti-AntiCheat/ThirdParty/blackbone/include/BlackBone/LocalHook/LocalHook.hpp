@@ -93,6 +93,59 @@ public:
         return Hook( Ptr, brutal_cast<hktype>(hkPtr), type, order, retType );
     }
 
+    /// <summary>
+    /// Prepare inline hook without patching the target.
+    /// The patch itself is applied later by HookTransaction::Commit
+    /// </summary>
+    /// <param name="ptr">Target function address</param>
+    /// <param name="hkPtr">Hook function address</param>
+    /// <param name="order">Call order. Hook before original or vice versa</param>
+    /// <param name="retType">Return value. Use origianl or value from hook</param>
+    /// <returns>true on success</returns>
+    bool HookPrepare(
+        type ptr,
+        hktype hkPtr,
+        CallOrder::e order = CallOrder::HookFirst,
+        ReturnMethod::e retType = ReturnMethod::UseOriginal
+        )
+    {
+        if (this->_hooked || this->_patchSize != 0)
+            return false;
+
+        this->_type = HookType::Inline;
+        this->_order = order;
+        this->_retType = retType;
+        this->_callOriginal = this->_original = ptr;
+        this->_callback = hkPtr;
+
+        if (!DetourBase::AllocateBuffer( reinterpret_cast<uint8_t*>(ptr) ))
+            return false;
+
+        return PrepareInline();
+    }
+
+    /// <summary>
+    /// Prepare inline hook without patching the target.
+    /// The patch itself is applied later by HookTransaction::Commit
+    /// </summary>
+    /// <param name="Ptr">Target function address</param>
+    /// <param name="hkPtr">Hook class member address</param>
+    /// <param name="pClass">Hook class address</param>
+    /// <param name="order">Call order. Hook before original or vice versa</param>
+    /// <param name="retType">Return value. Use origianl or value from hook</param>
+    /// <returns>true on success</returns>
+    bool HookPrepare(
+        type Ptr,
+        hktypeC hkPtr,
+        C* pClass,
+        CallOrder::e order = CallOrder::HookFirst,
+        ReturnMethod::e retType = ReturnMethod::UseOriginal
+        )
+    {
+        this->_callbackClass = pClass;
+        return HookPrepare( Ptr, brutal_cast<hktype>(hkPtr), order, retType );
+    }
+
 
     /// <summary>
     /// Restore hooked function
@@ -109,11 +162,8 @@ public:
             case HookType::InternalInline:
 			case HookType::Int3:
 			{
-				DWORD flOld = 0;
-				if (!VirtualProtect(this->_original, this->_origSize, PAGE_EXECUTE_READWRITE, &flOld))
+				if (!DetourBase::AtomicPatch( reinterpret_cast<uint8_t*>(this->_original), this->_origCode, this->_origSize ))
 					return false;
-				memcpy(this->_original, this->_origCode, this->_origSize);
-				VirtualProtect(this->_original, this->_origSize, flOld, &flOld);
 			}
 			break;
 
@@ -141,10 +191,10 @@ public:
 private:
 
     /// <summary>
-    /// Perform inline hook
+    /// Build trampoline and patch bytes without touching the target
     /// </summary>
     /// <returns>true on success</returns>
-    bool HookInline()
+    bool PrepareInline()
     {
         auto jmpToHook  = AsmFactory::GetAssembler();
         auto jmpToThunk = AsmFactory::GetAssembler();
@@ -161,7 +211,7 @@ private:
         (*jmpToThunk)->jmp( (asmjit::Ptr)this->_buf );
         this->_origSize = (*jmpToThunk)->getCodeSize();
 #endif
-        
+
         DetourBase::CopyOldCode( (uint8_t*)this->_original );
 
         // Construct jump to hook handler
@@ -178,17 +228,25 @@ private:
         (*jmpToHook)->relocCode( this->_buf );
 
         (*jmpToThunk)->setBaseAddress( (uintptr_t)this->_original );
-        auto codeSize = (*jmpToThunk)->relocCode( this->_newCode );
+        this->_patchSize = (*jmpToThunk)->relocCode( this->_newCode );
 
-        DWORD flOld = 0;
-        if (!VirtualProtect( this->_original, codeSize, PAGE_EXECUTE_READWRITE, &flOld ))
-            return false;
+        return this->_patchSize != 0;
+    }
 
-        memcpy( this->_original, this->_newCode, codeSize );
+    /// <summary>
+    /// Perform inline hook
+    /// </summary>
+    /// <returns>true on success</returns>
+    bool HookInline()
+    {
+        if (!PrepareInline())
+            return false;
 
-        VirtualProtect( this->_original, codeSize, flOld, &flOld );
+        // Activate without suspending other threads
+        if (!DetourBase::AtomicPatch( reinterpret_cast<uint8_t*>(this->_original), this->_newCode, this->_patchSize ))
+            return false;
 
-        this->_hooked = (codeSize != 0);
+        this->_hooked = true;
         return this->_hooked;
     }
 
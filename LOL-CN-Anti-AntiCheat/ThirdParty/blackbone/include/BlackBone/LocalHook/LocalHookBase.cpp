@@ -1,9 +1,169 @@
 #include "LocalHookBase.h"
+#include "../Misc/Utils.h"
+
+#include <vector>
 
 namespace blackbone
 {
+
+namespace
+{
+
+/// <summary>
+/// Shared executable slab allocator for detour buffers.
+/// Buffers are carved from pooled 64 KB reservations and recycled on
+/// unhook, instead of every hook burning its own 4 KB VirtualAlloc
+/// region and fragmenting the address space near the hooked module.
+/// </summary>
+class TrampolinePool
+{
+public:
+    static TrampolinePool& Instance()
+    {
+        // Deliberately leaked, hooks may outlive static destruction
+        static TrampolinePool* instance = new TrampolinePool;
+        return *instance;
+    }
+
+    /// <summary>
+    /// Get detour buffer as close to target as possible
+    /// </summary>
+    /// <param name="nearest">Target address</param>
+    /// <returns>Buffer, nullptr on failure</returns>
+    uint8_t* Allocate( uint8_t* nearest )
+    {
+        CSLock lck( _lock );
+
+        // Recycled slot within reach of the target
+        for (auto iter = _freeSlots.begin(); iter != _freeSlots.end(); ++iter)
+        {
+            if (InReach( *iter, nearest ))
+            {
+                uint8_t* slot = *iter;
+                _freeSlots.erase( iter );
+                return Wipe( slot );
+            }
+        }
+
+        // Partially used slab within reach
+        for (auto& slab : _slabs)
+        {
+            if (slab.used < SlabSize / SlotSize && InReach( slab.base + slab.used * SlotSize, nearest ))
+                return Wipe( slab.base + slab.used++ * SlotSize );
+        }
+
+        // Reserve a new slab near the target
+        uint8_t* base = AllocateSlab( nearest );
+
+        // Any recycled slot beats failure
+        if (base == nullptr)
+        {
+            if (_freeSlots.empty())
+                return nullptr;
+
+            uint8_t* slot = _freeSlots.back();
+            _freeSlots.pop_back();
+            return Wipe( slot );
+        }
+
+        _slabs.emplace_back( Slab{ base, 1 } );
+        return base;
+    }
+
+    /// <summary>
+    /// Return buffer to the pool for later reuse
+    /// </summary>
+    /// <param name="slot">Buffer obtained from Allocate</param>
+    void Free( uint8_t* slot )
+    {
+        if (slot == nullptr)
+            return;
+
+        CSLock lck( _lock );
+        _freeSlots.emplace_back( slot );
+    }
+
+private:
+    TrampolinePool() = default;
+    TrampolinePool( const TrampolinePool& ) = delete;
+    TrampolinePool& operator =( const TrampolinePool& ) = delete;
+
+    /// <summary>
+    /// Check that a slot is reachable from the target with a near jump
+    /// </summary>
+    static bool InReach( const uint8_t* slot, const uint8_t* nearest )
+    {
+        const intptr_t diff = slot - nearest;
+        return diff < 0x7FF00000ll && diff > -0x7FF00000ll;
+    }
+
+    /// <summary>
+    /// Clear a slot before reuse
+    /// </summary>
+    static uint8_t* Wipe( uint8_t* slot )
+    {
+        memset( slot, 0, SlotSize );
+        return slot;
+    }
+
+    /// <summary>
+    /// Reserve a new slab as close to target as possible
+    /// </summary>
+    /// <param name="nearest">Target address</param>
+    /// <returns>Slab base, nullptr on failure</returns>
+    static uint8_t* AllocateSlab( uint8_t* nearest )
+    {
+        uint8_t* base = nullptr;
+
+        MEMORY_BASIC_INFORMATION mbi = { 0 };
+        for (SIZE_T addr = (SIZE_T)nearest; addr > (SIZE_T)nearest - 0x80000000; addr = (SIZE_T)mbi.BaseAddress - 1)
+        {
+            if (!VirtualQuery( (LPCVOID)addr, &mbi, sizeof( mbi ) ))
+                break;
+
+            if (mbi.State == MEM_FREE && mbi.RegionSize >= SlabSize)
+            {
+                base = (uint8_t*)VirtualAlloc(
+                    (uint8_t*)mbi.BaseAddress + mbi.RegionSize - SlabSize, SlabSize,
+                    MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE
+                    );
+
+                if (base)
+                    break;
+            }
+        }
+
+        // If allocating near the target failed, allocate first suitable
+        if (base == nullptr)
+            base = (uint8_t*)VirtualAlloc( nullptr, SlabSize, MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE );
+
+        return base;
+    }
+
+private:
+    struct Slab
+    {
+        uint8_t* base;      // Reservation base
+        size_t used;        // Slots handed out so far
+    };
+
+    static const size_t SlabSize = 0x10000;     // One allocation granularity unit
+    static const size_t SlotSize = 0x1000;      // Detour buffer layout spans one page
+
+    CriticalSection _lock;              // Pool guard
+    std::vector<Slab> _slabs;           // Live reservations
+    std::vector<uint8_t*> _freeSlots;   // Slots returned by unhooked detours
+};
+
+// Active int3 staging fence, one site at a time
+CriticalSection g_stagingGuard;
+void* volatile g_stagingSite = nullptr;
+
+}
+
 std::unordered_map<void*, DetourBase*> DetourBase::_breakpoints;
 void* DetourBase::_vecHandler = nullptr;
+bool DetourBase::_collectStats = false;
 
 DetourBase::DetourBase()
 {
@@ -11,7 +171,7 @@ DetourBase::DetourBase()
 
 DetourBase::~DetourBase()
 {
-    VirtualFree( _buf, 0, MEM_RELEASE );
+    TrampolinePool::Instance().Free( _buf );
 }
 
 /// <summary>
@@ -24,33 +184,15 @@ bool DetourBase::AllocateBuffer( uint8_t* nearest )
     if (_buf != nullptr)
         return true;
 
-    MEMORY_BASIC_INFORMATION mbi = { 0 };
-    for (SIZE_T addr = (SIZE_T)nearest; addr > (SIZE_T)nearest - 0x80000000; addr = (SIZE_T)mbi.BaseAddress - 1)
-    {
-        if (!VirtualQuery( (LPCVOID)addr, &mbi, sizeof( mbi ) ))
-            break;
-
-        if (mbi.State == MEM_FREE)
-        {
-            _buf = (uint8_t*)VirtualAlloc(
-                (uint8_t*)mbi.BaseAddress + mbi.RegionSize - 0x1000, 0x1000,
-                MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE
-                );
-
-            if (_buf)
-                break;
-        }
-    }
-
-    // If allocating a memory page failed, allocate first suitable
+    _buf = TrampolinePool::Instance().Allocate( nearest );
     if (_buf == nullptr)
-        _buf = (uint8_t*)VirtualAlloc( nullptr, 0x1000, MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE );
+        return false;
 
     _origCode = _buf + 0x100;
     _origThunk = _buf + 0x200;
     _newCode  = _buf + 0x300;
 
-    return _buf != nullptr;
+    return true;
 }
 
 
@@ -114,11 +256,15 @@ void DetourBase::CopyOldCode( uint8_t* ptr )
     uint8_t* src = ptr;
     uint8_t* thunk = _origThunk, *original = _origCode;
     uint32_t all_len = 0;
-    ldasm_data ld = { 0 };
 
-    do 
+    // One decode pass, served from cache on re-hook
+    ldasm_batch_entry entries[LDASM_BATCH_MAX];
+    const uint32_t total = ldasm_batch_cached( ptr, 128, entries, LDASM_BATCH_MAX, is_x64 );
+
+    for (uint32_t i = 0; i < total && all_len < _origSize; i++)
     {
-        uint32_t len = ldasm( src, &ld, is_x64 );
+        const ldasm_data& ld = entries[i].data;
+        const uint32_t len = entries[i].length;
 
         // Determine code end
         if (ld.flags & F_INVALID
@@ -163,7 +309,7 @@ void DetourBase::CopyOldCode( uint8_t* ptr )
         thunk += len;
         original += len;
         all_len += len;
-    } while (all_len < _origSize);
+    }
 
     // Failed to copy old code, use backup plan
     if (all_len < _origSize)
@@ -179,6 +325,70 @@ void DetourBase::CopyOldCode( uint8_t* ptr )
 }
 
 
+/// <summary>
+/// Write patch bytes without suspending other threads.
+/// A patch contained in one aligned qword is applied with a single
+/// interlocked store. Longer sequences are staged behind an int3 fence:
+/// threads entering the site spin in the exception handler until the
+/// real first byte is released
+/// </summary>
+/// <param name="target">Patch site</param>
+/// <param name="code">Patch bytes</param>
+/// <param name="size">Patch size</param>
+/// <returns>true on success</returns>
+bool DetourBase::AtomicPatch( uint8_t* target, const uint8_t* code, size_t size )
+{
+    if (target == nullptr || size == 0 || size > 128)
+        return false;
+
+    DWORD flOld = 0;
+    if (!VirtualProtect( target, size, PAGE_EXECUTE_READWRITE, &flOld ))
+        return false;
+
+    const uintptr_t start = reinterpret_cast<uintptr_t>(target);
+    const uintptr_t qword = start & ~uintptr_t( 7 );
+
+    // Whole patch inside one aligned qword - single interlocked store
+    if (start + size <= qword + sizeof( int64_t ))
+    {
+        int64_t val = *reinterpret_cast<volatile int64_t*>(qword);
+        memcpy( reinterpret_cast<uint8_t*>(&val) + (start - qword), code, size );
+
+        InterlockedExchange64( reinterpret_cast<volatile LONG64*>(qword), val );
+    }
+    else
+    {
+        CSLock lck( g_stagingGuard );
+
+        // Fence needs the exception handler in place
+        if (_vecHandler == nullptr)
+            _vecHandler = AddVectoredExceptionHandler( 1, &DetourBase::VectoredHandler );
+
+        if (_vecHandler == nullptr)
+        {
+            VirtualProtect( target, size, flOld, &flOld );
+            return false;
+        }
+
+        // Close the entry with a fence, fill the tail, release the first byte
+        g_stagingSite = target;
+
+        *reinterpret_cast<volatile uint8_t*>(target) = 0xCC;
+        FlushInstructionCache( GetCurrentProcess(), target, sizeof( uint8_t ) );
+
+        memcpy( target + 1, code + 1, size - 1 );
+        FlushInstructionCache( GetCurrentProcess(), target, size );
+
+        *reinterpret_cast<volatile uint8_t*>(target) = code[0];
+        g_stagingSite = nullptr;
+    }
+
+    VirtualProtect( target, size, flOld, &flOld );
+    FlushInstructionCache( GetCurrentProcess(), target, size );
+
+    return true;
+}
+
 /// <summary>
 /// Exception handler
 /// </summary>
@@ -209,6 +419,13 @@ LONG NTAPI DetourBase::VectoredHandler( PEXCEPTION_POINTERS excpt )
 /// <returns>Exception disposition</returns>
 LONG NTAPI DetourBase::Int3Handler( PEXCEPTION_POINTERS excpt )
 {
+    // Thread ran into a staging fence - retry until the real byte lands
+    if (g_stagingSite != nullptr && excpt->ExceptionRecord->ExceptionAddress == g_stagingSite)
+    {
+        YieldProcessor();
+        return EXCEPTION_CONTINUE_EXECUTION;
+    }
+
     if (_breakpoints.count( excpt->ExceptionRecord->ExceptionAddress ))
     {
         DetourBase* pInst = _breakpoints[excpt->ExceptionRecord->ExceptionAddress];
@@ -219,6 +436,13 @@ LONG NTAPI DetourBase::Int3Handler( PEXCEPTION_POINTERS excpt )
         return EXCEPTION_CONTINUE_EXECUTION;
     }
 
+    // Stale fence trap: the thread hit the staging 0xCC, but the patch
+    // writer released the real first byte and cleared the site before
+    // this handler ran. The byte no longer reads 0xCC, so re-execute it.
+    // A foreign breakpoint still reads 0xCC and falls through
+    if (*reinterpret_cast<volatile uint8_t*>(excpt->ExceptionRecord->ExceptionAddress) != 0xCC)
+        return EXCEPTION_CONTINUE_EXECUTION;
+
     return EXCEPTION_CONTINUE_SEARCH;
 }
 
@@ -6,12 +6,22 @@
 #include "../Asm/LDasm.h"
 #include "../Include/Macro.h"
 
+#include <intrin.h>
 #include <tuple>
 #include <unordered_map>
 
 namespace blackbone
 {
 
+/// <summary>
+/// Per-hook invocation cost counters
+/// </summary>
+struct HookStats
+{
+    int64_t calls = 0;      // Intercepted call count
+    int64_t cycles = 0;     // Total rdtsc cycles spent inside handlers
+};
+
 namespace CallOrder
 {
 enum e
@@ -49,12 +59,52 @@ class DetourBase
 {
     using mapIdx = std::unordered_map<DWORD, int>;
 
+    // Batched installation needs access to prepared patch data
+    friend class HookTransaction;
+
 public:
     BLACKBONE_API DetourBase();
     BLACKBONE_API ~DetourBase();
 
+    /// <summary>
+    /// Toggle rdtsc cost collection for all hooks
+    /// </summary>
+    /// <param name="enable">true to collect per-hook counters</param>
+    BLACKBONE_API static void CollectStats( bool enable ) { _collectStats = enable; }
+
+    /// <summary>
+    /// Get accumulated invocation counters
+    /// </summary>
+    /// <returns>Counters snapshot</returns>
+    BLACKBONE_API HookStats stats() const
+    {
+        HookStats results;
+        results.calls = _statCalls;
+        results.cycles = _statCycles;
+        return results;
+    }
+
+    /// <summary>
+    /// Zero accumulated counters
+    /// </summary>
+    BLACKBONE_API void ResetStats()
+    {
+        InterlockedExchange64( &_statCalls, 0 );
+        InterlockedExchange64( &_statCycles, 0 );
+    }
+
 protected:
 
+    /// <summary>
+    /// Accumulate one handler pass into the lock-free per-hook slot
+    /// </summary>
+    /// <param name="cycles">Cycles spent inside the handler</param>
+    BLACKBONE_API void AccountCall( int64_t cycles )
+    {
+        InterlockedIncrement64( &_statCalls );
+        InterlockedExchangeAdd64( &_statCycles, cycles );
+    }
+
     /// <summary>
     /// Allocate detour buffer as close to target as possible
     /// </summary>
@@ -88,6 +138,19 @@ protected:
     /// <param name="Ptr">Origianl function address</param>
     BLACKBONE_API void CopyOldCode( uint8_t* Ptr );
 
+    /// <summary>
+    /// Write patch bytes without suspending other threads.
+    /// A patch contained in one aligned qword is applied with a single
+    /// interlocked store. Longer sequences are staged behind an int3 fence:
+    /// threads entering the site spin in the exception handler until the
+    /// real first byte is released
+    /// </summary>
+    /// <param name="target">Patch site</param>
+    /// <param name="code">Patch bytes</param>
+    /// <param name="size">Patch size</param>
+    /// <returns>true on success</returns>
+    BLACKBONE_API static bool AtomicPatch( uint8_t* target, const uint8_t* code, size_t size );
+
     /// <summary>
     /// Exception handlers
     /// </summary>
@@ -108,7 +171,10 @@ protected:
     void* _callOriginal = nullptr;      // Pointer to original function 
     
     mapIdx   _hwbpIdx;                  // Thread HWBP index
+    volatile LONGLONG _statCalls = 0;   // Intercepted call count
+    volatile LONGLONG _statCycles = 0;  // Accumulated handler rdtsc cycles
     size_t   _origSize = 0;             // Original code size
+    size_t   _patchSize = 0;            // Prepared patch size, for batched installation
     uint8_t* _buf = nullptr;            // Trampoline buffer
     uint8_t* _origCode = nullptr;       // Original function bytes
     uint8_t* _origThunk = nullptr;      // Original bytes adjusted for relocation
@@ -123,6 +189,9 @@ protected:
 
     // Exception handler
     BLACKBONE_API static void* _vecHandler;
+
+    // Cost collection toggle, off by default
+    BLACKBONE_API static bool _collectStats;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "HookHandlers.h"
+
+namespace blackbone
+{
+
+/// <summary>
+/// Inline detour with everything bound at compile time.
+/// Target signature, calling convention, user callback, call order and
+/// return selection are template parameters, so the generated thunk
+/// tail-jumps to a static handler that calls the callback directly -
+/// no indirect call through stored pointers, no runtime branch on call
+/// order or return method. Intended for hooks firing on hot paths.
+/// One live instance per instantiation: the callback is part of the type.
+/// </summary>
+template<typename Fn, auto hookFn, CallOrder::e order = CallOrder::HookFirst, ReturnMethod::e retType = ReturnMethod::UseOriginal>
+class StaticDetour;
+
+#define BLACKBONE_MAKE_STATIC_DETOUR( CONV )                                                            \
+template<typename R, typename... Args, auto hookFn, CallOrder::e order, ReturnMethod::e retType>        \
+class StaticDetour<R( CONV* )(Args...), hookFn, order, retType> : public DetourBase                     \
+{                                                                                                       \
+public:                                                                                                 \
+    using ReturnType = std::conditional_t<std::is_same_v<R, void>, int, R>;                             \
+                                                                                                        \
+    using type    = R( CONV* )(Args...);                                                                \
+    using hktype  = R( CONV* )(Args&...);                                                               \
+                                                                                                        \
+    /* Workaround for void return type */                                                               \
+    using typeR   = ReturnType( CONV* )(Args...);                                                       \
+    using hktypeR = ReturnType( CONV* )(Args&...);                                                      \
+                                                                                                        \
+public:                                                                                                 \
+    StaticDetour() = default;                                                                           \
+                                                                                                        \
+    ~StaticDetour()                                                                                     \
+    {                                                                                                   \
+        Restore();                                                                                      \
+    }                                                                                                   \
+                                                                                                        \
+    /* Hook function. Returns true on success */                                                        \
+    bool Hook( type ptr )                                                                               \
+    {                                                                                                   \
+        if (this->_hooked || s_instance != nullptr)                                                     \
+            return false;                                                                               \
+                                                                                                        \
+        this->_type = HookType::Inline;                                                                 \
+        this->_callOriginal = this->_original = reinterpret_cast<void*>(ptr);                           \
+                                                                                                        \
+        if (!DetourBase::AllocateBuffer( reinterpret_cast<uint8_t*>(ptr) ))                             \
+            return false;                                                                               \
+                                                                                                        \
+        auto jmpToHook  = AsmFactory::GetAssembler();                                                   \
+        auto jmpToThunk = AsmFactory::GetAssembler();                                                   \
+                                                                                                        \
+        /* Construct jump to thunk */                                                                   \
+        BLACKBONE_STATIC_DETOUR_JUMP( jmpToThunk );                                                     \
+        this->_origSize = (*jmpToThunk)->getCodeSize();                                                 \
+                                                                                                        \
+        DetourBase::CopyOldCode( reinterpret_cast<uint8_t*>(ptr) );                                     \
+                                                                                                        \
+        /* Backup-plan trampoline needs the patch toggled around every */                               \
+        /* original call, which defeats the static fast path */                                         \
+        if (this->_type == HookType::InternalInline)                                                    \
+            return false;                                                                               \
+                                                                                                        \
+        /* Thunk tail-jumps straight to the static handler, no context store */                         \
+        (*jmpToHook)->jmp( (asmjit::Ptr)&StaticDetour::Handler );                                       \
+        (*jmpToHook)->relocCode( this->_buf );                                                          \
+                                                                                                        \
+        (*jmpToThunk)->setBaseAddress( (uintptr_t)this->_original );                                    \
+        this->_patchSize = (*jmpToThunk)->relocCode( this->_newCode );                                  \
+        if (this->_patchSize == 0)                                                                      \
+            return false;                                                                               \
+                                                                                                        \
+        s_instance = this;                                                                              \
+                                                                                                        \
+        /* Activate without suspending other threads */                                                 \
+        if (!DetourBase::AtomicPatch( reinterpret_cast<uint8_t*>(this->_original),                      \
+                                      this->_newCode, this->_patchSize ))                               \
+        {                                                                                               \
+            s_instance = nullptr;                                                                       \
+            return false;                                                                               \
+        }                                                                                               \
+                                                                                                        \
+        return (this->_hooked = true);                                                                  \
+    }                                                                                                   \
+                                                                                                        \
+    /* Restore hooked function. Returns true on success, false if not hooked */                         \
+    bool Restore()                                                                                      \
+    {                                                                                                   \
+        if (!this->_hooked)                                                                             \
+            return false;                                                                               \
+                                                                                                        \
+        if (!DetourBase::AtomicPatch( reinterpret_cast<uint8_t*>(this->_original),                      \
+                                      this->_origCode, this->_origSize ))                               \
+            return false;                                                                               \
+                                                                                                        \
+        s_instance = nullptr;                                                                           \
+        this->_hooked = false;                                                                          \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+private:                                                                                                \
+    static __declspec(noinline) ReturnType CONV Handler( Args... args )                                 \
+    {                                                                                                   \
+        const auto callback = reinterpret_cast<hktypeR>(hookFn);                                        \
+        const auto original = reinterpret_cast<typeR>(s_instance->_callOriginal);                       \
+                                                                                                        \
+        if constexpr (order == CallOrder::NoOriginal)                                                   \
+        {                                                                                               \
+            return callback( args... );                                                                 \
+        }                                                                                               \
+        else if constexpr (order == CallOrder::HookFirst)                                               \
+        {                                                                                               \
+            ReturnType val_new = callback( args... );                                                   \
+            ReturnType val_original = original( args... );                                              \
+                                                                                                        \
+            if constexpr (retType == ReturnMethod::UseOriginal)                                         \
+                return val_original;                                                                    \
+            else                                                                                        \
+                return val_new;                                                                         \
+        }                                                                                               \
+        else                                                                                            \
+        {                                                                                               \
+            ReturnType val_original = original( args... );                                              \
+            ReturnType val_new = callback( args... );                                                   \
+                                                                                                        \
+            if constexpr (retType == ReturnMethod::UseOriginal)                                         \
+                return val_original;                                                                    \
+            else                                                                                        \
+                return val_new;                                                                         \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+private:                                                                                                \
+    static inline StaticDetour* s_instance = nullptr;   /* Installed instance, one per instantiation */ \
+};
+
+// Jump-to-thunk construction, same as Detour::PrepareInline
+#ifdef USE64
+#define BLACKBONE_STATIC_DETOUR_JUMP( a )                               \
+        (*a)->mov( asmjit::host::rax, (uint64_t)this->_buf );           \
+        (*a)->jmp( asmjit::host::rax )
+#else
+#define BLACKBONE_STATIC_DETOUR_JUMP( a )                               \
+        (*a)->jmp( (asmjit::Ptr)this->_buf )
+#endif
+
+BLACKBONE_MAKE_STATIC_DETOUR( __cdecl )
+
+#ifndef USE64
+BLACKBONE_MAKE_STATIC_DETOUR( __stdcall )
+BLACKBONE_MAKE_STATIC_DETOUR( __thiscall )
+BLACKBONE_MAKE_STATIC_DETOUR( __fastcall )
+#endif
+
+#undef BLACKBONE_MAKE_STATIC_DETOUR
+#undef BLACKBONE_STATIC_DETOUR_JUMP
+
+}
@@ -1,6 +1,7 @@
 #include "../Config.h"
 #include "TraceHook.h"
 #include "../Include/Macro.h"
+#include "../Asm/LDasm.h"
 
 #define BEA_USE_STDCALL
 //#define BEA_ENGINE_STATIC
@@ -22,6 +23,38 @@
 namespace blackbone
 {
 
+/// <summary>
+/// Check if instruction transfers control: call/jmp/jcc/loop/ret/int3
+/// </summary>
+/// <param name="opcd">Pointer to instruction opcode</param>
+/// <param name="ld">Decoded instruction data</param>
+/// <returns>true if instruction ends a basic block</returns>
+static bool IsControlTransfer( const uint8_t* opcd, const ldasm_data& ld )
+{
+    const uint8_t op = opcd[0];
+
+    // jcc rel32
+    if (op == 0x0F)
+        return opcd[1] >= 0x80 && opcd[1] <= 0x8F;
+
+    // jcc rel8, loop/jcxz, call/jmp rel, ret, int3
+    if ((op >= 0x70 && op <= 0x7F) || (op >= 0xE0 && op <= 0xE3) ||
+         op == 0xE8 || op == 0xE9 || op == 0xEB ||
+         op == 0xC2 || op == 0xC3 || op == 0xCA || op == 0xCB || op == 0xCC)
+    {
+        return true;
+    }
+
+    // call/jmp r/m
+    if (op == 0xFF && (ld.flags & F_MODRM))
+    {
+        const uint8_t reg = (ld.modrm >> 3) & 7;
+        return reg >= 2 && reg <= 5;
+    }
+
+    return false;
+}
+
 TraceHook::TraceHook()
 {
 }
@@ -113,6 +146,9 @@ bool TraceHook::RemoveHook( void* targetFunc )
 
         if (ctx.hooks.empty())
         {
+            // Remove pending block-end breakpoint
+            RemoveBlockBreak( ctx );
+
             // Remove hook itself
             *(uintptr_t*)ctx.targetPtr = ctx.origPtrVal;
             _contexts.erase( iter );
@@ -160,6 +196,22 @@ LONG TraceHook::VecHandlerP( PEXCEPTION_POINTERS ExceptionInfo )
     // TODO: Somehow determine current hook context
     HookContext* ctx = &_contexts.begin()->second;
 
+    // Block-end breakpoint reached. Restore the patched byte and single-step
+    // over the branch itself so the state machine sees its target
+    if (exptCode == EXCEPTION_BREAKPOINT)
+    {
+        if (ctx->bpAddress == 0 || exptContex->NIP != ctx->bpAddress)
+            return EXCEPTION_CONTINUE_SEARCH;
+
+        RemoveBlockBreak( *ctx );
+
+        ctx->lastIP = exptContex->NIP;
+        ctx->lastSP = exptContex->NSP;
+        exptContex->EFlags |= SingleStep;
+
+        return EXCEPTION_CONTINUE_EXECUTION;
+    }
+
     // Check if exception should be handled
     if (exptCode != EXCEPTION_SINGLE_STEP && exptCode != EXCEPTION_ACCESS_VIOLATION)
     {
@@ -210,9 +262,9 @@ LONG TraceHook::VecHandlerP( PEXCEPTION_POINTERS ExceptionInfo )
                         BreakOnReturn( exptContex->NSP );
                     }
                 }
-                // Step further
+                // Run to the end of the current basic block
                 else
-                    exptContex->EFlags |= SingleStep;
+                    AdvanceToBranch( *ctx, exptContex );
             }
             break;
 
@@ -245,7 +297,7 @@ LONG TraceHook::VecHandlerP( PEXCEPTION_POINTERS ExceptionInfo )
                     }
                 }
 
-                exptContex->EFlags |= SingleStep;
+                AdvanceToBranch( *ctx, exptContex );
             }
             break;
 
@@ -340,6 +392,78 @@ void TraceHook::HandleBranch( HookContext& ctx, PCONTEXT exptContex )
 }
 
 
+/// <summary>
+/// Run current basic block at full speed.
+/// Plants a temporary breakpoint on the next control transfer instruction
+/// so only the branch itself takes an exception. Falls back to
+/// per-instruction stepping if the block can't be decoded
+/// </summary>
+/// <param name="ctx">Current hook context</param>
+/// <param name="exptContex">Thread context</param>
+void TraceHook::AdvanceToBranch( HookContext& ctx, PCONTEXT exptContex )
+{
+    uint8_t* src = (uint8_t*)exptContex->NIP;
+    uint32_t all_len = 0;
+
+    for (;;)
+    {
+        ldasm_data ld = { 0 };
+        uint32_t len = ldasm( src, &ld, is_x64 );
+
+        if (ld.flags & F_INVALID || all_len + len > 128)
+            break;
+
+        if (IsControlTransfer( src + ld.opcd_offset, ld ))
+        {
+            // Single-instruction block, stepping is cheaper than patching
+            if (all_len == 0)
+                break;
+
+            DWORD flOld = 0;
+            if (!VirtualProtect( src, sizeof( uint8_t ), PAGE_EXECUTE_READWRITE, &flOld ))
+                break;
+
+            ctx.bpAddress = (uintptr_t)src;
+            ctx.bpOrigByte = *src;
+            *src = 0xCC;
+
+            VirtualProtect( src, sizeof( uint8_t ), flOld, &flOld );
+            FlushInstructionCache( GetCurrentProcess(), src, sizeof( uint8_t ) );
+            return;
+        }
+
+        src += len;
+        all_len += len;
+    }
+
+    // Step one instruction at a time
+    exptContex->EFlags |= SingleStep;
+}
+
+/// <summary>
+/// Restore byte replaced by the block-end breakpoint
+/// </summary>
+/// <param name="ctx">Current hook context</param>
+void TraceHook::RemoveBlockBreak( HookContext& ctx )
+{
+    if (ctx.bpAddress == 0)
+        return;
+
+    uint8_t* src = (uint8_t*)ctx.bpAddress;
+
+    DWORD flOld = 0;
+    if (VirtualProtect( src, sizeof( uint8_t ), PAGE_EXECUTE_READWRITE, &flOld ))
+    {
+        *src = ctx.bpOrigByte;
+
+        VirtualProtect( src, sizeof( uint8_t ), flOld, &flOld );
+        FlushInstructionCache( GetCurrentProcess(), src, sizeof( uint8_t ) );
+    }
+
+    ctx.bpAddress = 0;
+    ctx.bpOrigByte = 0;
+}
+
 /// <summary>
 /// Setup exception upon function return
 /// </summary>
@@ -45,6 +45,8 @@ struct HookContext
     uintptr_t checkIP = 0;      // Address of instruction that checks target pointer
     uintptr_t breakValue = 0;   // Value used to generate exception
     uintptr_t stateIdx = 0;     // Current state index in state vector
+    uintptr_t bpAddress = 0;    // Temporary breakpoint at current basic block end
+    uint8_t bpOrigByte = 0;     // Byte replaced by the temporary breakpoint
 
     TraceState state = TS_Start;    // Current tracing state
     vecState tracePath;             // Function trace path
@@ -144,6 +146,22 @@ private:
     /// <param name="exptContex">Thread context</param>
     void HandleBranch( HookContext& ctx, PCONTEXT exptContex );
 
+    /// <summary>
+    /// Run current basic block at full speed.
+    /// Plants a temporary breakpoint on the next control transfer instruction
+    /// so only the branch itself takes an exception. Falls back to
+    /// per-instruction stepping if the block can't be decoded
+    /// </summary>
+    /// <param name="ctx">Current hook context</param>
+    /// <param name="exptContex">Thread context</param>
+    void AdvanceToBranch( HookContext& ctx, PCONTEXT exptContex );
+
+    /// <summary>
+    /// Restore byte replaced by the block-end breakpoint
+    /// </summary>
+    /// <param name="ctx">Current hook context</param>
+    void RemoveBlockBreak( HookContext& ctx );
+
     /// <summary>
     /// Restore original pointer value
     /// </summary>
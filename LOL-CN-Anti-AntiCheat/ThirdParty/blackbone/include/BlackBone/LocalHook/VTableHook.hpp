@@ -3,6 +3,8 @@
 #include "LocalHook.hpp"
 #include "../Misc/DynImport.h"
 
+#include <vector>
+
 namespace blackbone
 {
 
@@ -76,12 +78,8 @@ public:
         // Modify VTable copy
         if (copyVtable)
         {
-            // Copy VTable
-            if (vtableLen != 0)
-            {
-                memcpy( this->_buf + 0x300 - sizeof( void* ), (*(void***)ppVtable) - 1, vtableLen * sizeof( void* ) );
-            }
-            else 
+            // Determine table length
+            if (vtableLen == 0)
             {
                 Process proc;
                 proc.Attach( GetCurrentProcessId() );
@@ -94,16 +92,18 @@ public:
                 {
                     vptr = (*(uintptr_t**)ppVtable)[vtableLen];
                     if (vptr < imageBase || vptr >= imageBase + imageSzie)
-                    {
-                        memcpy( this->_buf + 0x300 - sizeof( void* ), (*(void***)ppVtable) - 1, vtableLen * sizeof( void* ) );
                         break;
-                    }
                 }
             }
 
-            // Replace pointer to VTable
-            ((void**)this->_buf + 0x300 / sizeof( uintptr_t ))[index] = this->_buf;
-            *ppVtable = this->_buf + 0x300;
+            // Clone whole table into own writable memory, including RTTI
+            // pointer at slot -1. The copy is patched before it becomes
+            // visible, so the original read-only page is never touched
+            this->_vtCopy.assign( (*(void***)ppVtable) - 1, (*(void***)ppVtable) + vtableLen );
+            this->_vtCopy[index + 1] = this->_buf;
+
+            // Publish the copy with a single aligned pointer store
+            InterlockedExchangePointer( (PVOID volatile*)ppVtable, this->_vtCopy.data() + 1 );
         }
         // Modify pointer in-place
         else
@@ -157,7 +157,8 @@ public:
 
         if (this->_vtCopied)
         {
-            *this->_ppVtable = this->_pVtable;
+            // Swap the original table back with one atomic store
+            InterlockedExchangePointer( (PVOID volatile*)this->_ppVtable, this->_pVtable );
         }
         else
         {
@@ -177,6 +178,7 @@ private:
     void** _ppVtable = nullptr;         // Pointer to VTable pointer
     void*  _pVtable = nullptr;          // Pointer to VTable
     int    _vtIndex = 0;                // VTable function index
+    std::vector<void*> _vtCopy;         // Writable clone of the table, slot 0 holds RTTI pointer
 };
 
 }
\ No newline at end of file
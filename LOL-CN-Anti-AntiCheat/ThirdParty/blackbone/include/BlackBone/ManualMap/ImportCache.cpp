@@ -0,0 +1,171 @@
+#include "ImportCache.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace blackbone
+{
+
+ImportCache& ImportCache::Instance()
+{
+    static ImportCache instance;
+    return instance;
+}
+
+ImportCache::ImportCache()
+{
+    wchar_t tmpPath[MAX_PATH] = { 0 };
+    GetTempPathW( ARRAYSIZE( tmpPath ), tmpPath );
+
+    _cachePath = std::wstring( tmpPath ) + L"BlackBone_imports.dat";
+    Load();
+}
+
+/// <summary>
+/// Get file validity token - size and last write time
+/// </summary>
+/// <param name="path">File path</param>
+/// <returns>Token, 0 if the file is inaccessible</returns>
+uint64_t ImportCache::FileToken( const std::wstring& path )
+{
+    WIN32_FILE_ATTRIBUTE_DATA attrib = { };
+    if (!GetFileAttributesExW( path.c_str(), GetFileExInfoStandard, &attrib ))
+        return 0;
+
+    const uint64_t size = (static_cast<uint64_t>(attrib.nFileSizeHigh) << 32) | attrib.nFileSizeLow;
+    const uint64_t time = (static_cast<uint64_t>(attrib.ftLastWriteTime.dwHighDateTime) << 32) | attrib.ftLastWriteTime.dwLowDateTime;
+
+    return size ^ (time * 0x100000001B3ull);
+}
+
+/// <summary>
+/// Find cached resolution of an import
+/// </summary>
+/// <param name="dependency">Dependency module name</param>
+/// <param name="func">Import name, or #ordinal</param>
+/// <param name="provider">Receives providing module name</param>
+/// <param name="rva">Receives function RVA inside the provider</param>
+/// <returns>true if a cached entry exists</returns>
+bool ImportCache::Lookup( const std::wstring& dependency, const std::string& func, std::wstring& provider, uint32_t& rva )
+{
+    CSLock lck( _lock );
+
+    auto found = _entries.find( Utils::ToLower( dependency ) + L"|" + Utils::AnsiToWstring( func ) );
+    if (found == _entries.end())
+        return false;
+
+    provider = found->second.first;
+    rva = found->second.second;
+    return true;
+}
+
+/// <summary>
+/// Check that the provider file still matches the recorded token.
+/// The token is computed once per provider per run.
+/// </summary>
+/// <param name="provider">Providing module name</param>
+/// <param name="providerPath">Provider file path</param>
+/// <returns>true if cached entries for the provider may be used</returns>
+bool ImportCache::ProviderValid( const std::wstring& provider, const std::wstring& providerPath )
+{
+    CSLock lck( _lock );
+
+    const auto key = Utils::ToLower( provider );
+
+    auto recorded = _providers.find( key );
+    if (recorded == _providers.end())
+        return false;
+
+    auto checked = _checked.find( key );
+    if (checked == _checked.end())
+        checked = _checked.emplace( key, FileToken( providerPath ) ).first;
+
+    return checked->second != 0 && checked->second == recorded->second;
+}
+
+/// <summary>
+/// Record a resolved import
+/// </summary>
+/// <param name="dependency">Dependency module name</param>
+/// <param name="func">Import name, or #ordinal</param>
+/// <param name="provider">Providing module name</param>
+/// <param name="providerPath">Provider file path, for the validity token</param>
+/// <param name="rva">Function RVA inside the provider</param>
+void ImportCache::Store( const std::wstring& dependency, const std::string& func, const std::wstring& provider, const std::wstring& providerPath, uint32_t rva )
+{
+    CSLock lck( _lock );
+
+    const auto providerKey = Utils::ToLower( provider );
+
+    auto checked = _checked.find( providerKey );
+    if (checked == _checked.end())
+        checked = _checked.emplace( providerKey, FileToken( providerPath ) ).first;
+
+    if (checked->second == 0)
+        return;
+
+    _providers[providerKey] = checked->second;
+    _entries[Utils::ToLower( dependency ) + L"|" + Utils::AnsiToWstring( func )] = std::make_pair( providerKey, rva );
+    _dirty = true;
+}
+
+/// <summary>
+/// Load persisted cache from disk
+/// </summary>
+void ImportCache::Load()
+{
+    std::ifstream file( _cachePath, std::ios::in );
+    if (!file)
+        return;
+
+    // One record per line:
+    //   P<tab>provider<tab>token
+    //   E<tab>dependency|func<tab>provider<tab>rva
+    std::string line;
+    while (std::getline( file, line ))
+    {
+        std::istringstream ss( line );
+        std::string tag, first, second, third;
+
+        if (!std::getline( ss, tag, '\t' ) || !std::getline( ss, first, '\t' ) || !std::getline( ss, second, '\t' ))
+            continue;
+
+        if (tag == "P")
+            _providers[Utils::UTF8ToWstring( first )] = strtoull( second.c_str(), nullptr, 16 );
+        else if (tag == "E" && std::getline( ss, third, '\t' ))
+            _entries[Utils::UTF8ToWstring( first )] = std::make_pair( Utils::UTF8ToWstring( second ), static_cast<uint32_t>(strtoul( third.c_str(), nullptr, 16 )) );
+    }
+}
+
+/// <summary>
+/// Persist the cache to disk, if modified
+/// </summary>
+void ImportCache::Save()
+{
+    CSLock lck( _lock );
+
+    if (!_dirty)
+        return;
+
+    std::ofstream file( _cachePath, std::ios::out | std::ios::trunc );
+    if (!file)
+        return;
+
+    char buf[32];
+
+    for (const auto& provider : _providers)
+    {
+        sprintf_s( buf, "%llx", provider.second );
+        file << "P\t" << Utils::WstringToUTF8( provider.first ) << '\t' << buf << '\n';
+    }
+
+    for (const auto& entry : _entries)
+    {
+        sprintf_s( buf, "%x", entry.second.second );
+        file << "E\t" << Utils::WstringToUTF8( entry.first ) << '\t' << Utils::WstringToUTF8( entry.second.first ) << '\t' << buf << '\n';
+    }
+
+    _dirty = false;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../Config.h"
+#include "../Include/Winheaders.h"
+#include "../Misc/Utils.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Disk-persisted import resolution cache.
+/// Maps (dependency, import name) to the module that finally provides
+/// the function and its RVA inside it, so repeat manual-map injections
+/// skip export directory walks entirely. Entries are validated against
+/// the provider file's size and write time before use and re-resolved
+/// on mismatch.
+/// </summary>
+class ImportCache
+{
+public:
+    BLACKBONE_API static ImportCache& Instance();
+
+    /// <summary>
+    /// Find cached resolution of an import
+    /// </summary>
+    /// <param name="dependency">Dependency module name</param>
+    /// <param name="func">Import name, or #ordinal</param>
+    /// <param name="provider">Receives providing module name</param>
+    /// <param name="rva">Receives function RVA inside the provider</param>
+    /// <returns>true if a cached entry exists</returns>
+    BLACKBONE_API bool Lookup( const std::wstring& dependency, const std::string& func, std::wstring& provider, uint32_t& rva );
+
+    /// <summary>
+    /// Record a resolved import
+    /// </summary>
+    /// <param name="dependency">Dependency module name</param>
+    /// <param name="func">Import name, or #ordinal</param>
+    /// <param name="provider">Providing module name</param>
+    /// <param name="providerPath">Provider file path, for the validity token</param>
+    /// <param name="rva">Function RVA inside the provider</param>
+    BLACKBONE_API void Store( const std::wstring& dependency, const std::string& func, const std::wstring& provider, const std::wstring& providerPath, uint32_t rva );
+
+    /// <summary>
+    /// Check that the provider file still matches the recorded token.
+    /// The token is computed once per provider per run.
+    /// </summary>
+    /// <param name="provider">Providing module name</param>
+    /// <param name="providerPath">Provider file path</param>
+    /// <returns>true if cached entries for the provider may be used</returns>
+    BLACKBONE_API bool ProviderValid( const std::wstring& provider, const std::wstring& providerPath );
+
+    /// <summary>
+    /// Persist the cache to disk, if modified
+    /// </summary>
+    BLACKBONE_API void Save();
+
+private:
+    ImportCache();
+    ImportCache( const ImportCache& ) = delete;
+    ImportCache& operator =( const ImportCache& ) = delete;
+
+    /// <summary>
+    /// Load persisted cache from disk
+    /// </summary>
+    void Load();
+
+    /// <summary>
+    /// Get file validity token - size and last write time
+    /// </summary>
+    /// <param name="path">File path</param>
+    /// <returns>Token, 0 if the file is inaccessible</returns>
+    static uint64_t FileToken( const std::wstring& path );
+
+private:
+    CriticalSection _lock;      // Cache guard
+    std::wstring _cachePath;    // Backing file path
+    bool _dirty = false;        // Unsaved changes present
+
+    std::unordered_map<std::wstring, uint64_t> _providers;  // Provider name -> recorded file token
+    std::unordered_map<std::wstring, uint64_t> _checked;    // Provider name -> token computed this run
+    std::unordered_map<std::wstring, std::pair<std::wstring, uint32_t>> _entries;   // dependency|func -> provider, RVA
+};
+
+}
@@ -201,14 +201,16 @@ uint8_t MExcept::_handler64[] =
 
 /// <summary>
 /// Inject VEH wrapper into process
-/// Used to enable execution of SEH handlers out of image
+/// Used to enable execution of SEH handlers out of image.
+/// The codecave and handler registration are reused when already
+/// installed, making repeat calls a table entry write
 /// </summary>
 /// <param name="proc">Target process</param>
 /// <param name="mod">Target module</param>
 /// <param name="partial">Partial exception support</param>
 /// <returns>Error code</returns>
 NTSTATUS MExcept::CreateVEH( Process& proc, ModuleData& mod, bool partial )
-{    
+{
     uint64_t result = 0;
     auto& mods = proc.modules();
 
@@ -221,24 +223,36 @@ NTSTATUS MExcept::CreateVEH( Process& proc, ModuleData& mod, bool partial )
             if (!mem)
                 return mem.status;
 
+            // Allocation is zero-filled, so the table starts out empty
             _pModTable = std::move( mem.result() );
+            _tableMirror.clear();
         }
 
-        ModuleTable table;
-        _pModTable.Read ( 0, table );
+        if (_tableMirror.size() >= _countof( ModuleTable().entry ))
+            return STATUS_NO_MEMORY;
+
+        // Publish the entry before bumping the count, so the remote
+        // handler never observes a half-written slot. The table is
+        // mirrored locally, no remote read-modify-write round trip
+        ExceptionModule entry = { mod.baseAddress, mod.size };
+        _pModTable.Write( FIELD_OFFSET( ModuleTable, entry ) + _tableMirror.size() * sizeof( entry ), entry );
 
-        // Add new entry to the table
-        table.entry[table.count].base = mod.baseAddress;
-        table.entry[table.count].size = mod.size;
-        table.count++;
+        ptr_t count = _tableMirror.size() + 1;
+        NTSTATUS status = _pModTable.Write( FIELD_OFFSET( ModuleTable, count ), count );
+        if (!NT_SUCCESS( status ))
+            return status;
 
-        _pModTable.Write( 0, table );
+        _tableMirror.emplace_back( entry );
     }
 
     // No handler required
     if (partial)
         return STATUS_SUCCESS;
 
+    // Handler already installed for this process, nothing left to set up
+    if (_hVEH != 0 && _pVEHCode.valid() && _vehType == mod.type)
+        return STATUS_SUCCESS;
+
     // VEH codecave
     auto mem = proc.memory().Allocate( 0x2000, PAGE_EXECUTE_READWRITE, 0, false );
     if (!mem)
@@ -284,9 +298,9 @@ NTSTATUS MExcept::CreateVEH( Process& proc, ModuleData& mod, bool partial )
         if (!pDecode)
             return pDecode.status;
 
-        replaceStub( newHandler, handlerSize, 0xDEADDA7A, static_cast<uint32_t>(g_symbols.LdrpInvertedFunctionTable32) );
+        replaceStub( newHandler, handlerSize, 0xDEADDA7A, static_cast<uint32_t>(Symbols().LdrpInvertedFunctionTable32) );
         replaceStub( newHandler, handlerSize, 0xDEADC0DE, static_cast<uint32_t>(pDecode->procAddress) );
-        replaceStub( newHandler, handlerSize, 0xDEADC0D2, static_cast<uint32_t>(g_symbols.LdrProtectMrdata) );
+        replaceStub( newHandler, handlerSize, 0xDEADC0D2, static_cast<uint32_t>(Symbols().LdrProtectMrdata) );
     }
 
     // Write handler data into target process
@@ -312,6 +326,7 @@ NTSTATUS MExcept::CreateVEH( Process& proc, ModuleData& mod, bool partial )
     if (result != 0)
     {
         _hVEH = result;
+        _vehType = mod.type;
         return STATUS_SUCCESS;
     }
     else
@@ -322,39 +337,78 @@ NTSTATUS MExcept::CreateVEH( Process& proc, ModuleData& mod, bool partial )
 }
 
 /// <summary>
-/// Removes VEH from target process
+/// Disable exception support for one image.
+/// The handler stays registered for the process; only the image's
+/// module table entry is retired. Use Teardown to fully remove the VEH
 /// </summary>
 /// <param name="proc">Target process</param>
 /// <param name="partial">Partial exception support</param>
-/// <param name="mt">Mosule type</param>
+/// <param name="mt">Module type</param>
+/// <param name="base">Image base, 0 to leave the table untouched</param>
 /// <returns>Status code</returns>
-NTSTATUS MExcept::RemoveVEH( Process& proc, bool partial, eModType mt )
-{  
-    auto a = AsmFactory::GetAssembler( mt );
-    uint64_t result = 0;
+NTSTATUS MExcept::RemoveVEH( Process& /*proc*/, bool /*partial*/, eModType /*mt*/, ptr_t base )
+{
+    // Retire the image's table entry: shrink the count first so the
+    // remote handler never walks a slot mid-rewrite, then compact the
+    // last entry into the vacated one. At most two small writes and no
+    // remote read - the table contents are known from the local mirror
+    if (base != 0 && _pModTable.valid() && !_tableMirror.empty())
+    {
+        for (size_t i = 0; i < _tableMirror.size(); i++)
+        {
+            if (_tableMirror[i].base != base)
+                continue;
 
-    auto& mods = proc.modules();
-    auto pRemoveHandler = mods.GetNtdllExport( "RtlRemoveVectoredExceptionHandler", mt );
-    if (!pRemoveHandler)
-        return pRemoveHandler.status;
+            ptr_t count = _tableMirror.size() - 1;
+            _pModTable.Write( FIELD_OFFSET( ModuleTable, count ), count );
 
-    a->GenPrologue();
+            if (i != _tableMirror.size() - 1)
+            {
+                _tableMirror[i] = _tableMirror.back();
+                _pModTable.Write( FIELD_OFFSET( ModuleTable, entry ) + i * sizeof( ExceptionModule ), _tableMirror[i] );
+            }
 
-    // RemoveVectoredExceptionHandler(pHandler);
-    a->GenCall( pRemoveHandler->procAddress, { _hVEH } );
+            _tableMirror.pop_back();
+            break;
+        }
+    }
 
-    proc.remote().AddReturnWithEvent( *a );
-    a->GenEpilogue();
+    return STATUS_SUCCESS;
+}
 
-    // Destroy table and handler
-    if (!partial)
+/// <summary>
+/// Unregister the pooled handler and free the remote structures
+/// </summary>
+/// <param name="proc">Target process</param>
+/// <returns>Status code</returns>
+NTSTATUS MExcept::Teardown( Process& proc )
+{
+    if (_hVEH != 0)
     {
+        auto a = AsmFactory::GetAssembler( _vehType );
+        uint64_t result = 0;
+
+        auto& mods = proc.modules();
+        auto pRemoveHandler = mods.GetNtdllExport( "RtlRemoveVectoredExceptionHandler", _vehType );
+        if (!pRemoveHandler)
+            return pRemoveHandler.status;
+
+        a->GenPrologue();
+
+        // RemoveVectoredExceptionHandler(pHandler);
+        a->GenCall( pRemoveHandler->procAddress, { _hVEH } );
+
+        proc.remote().AddReturnWithEvent( *a );
+        a->GenEpilogue();
+
         proc.remote().ExecInWorkerThread( (*a)->make(), (*a)->getCodeSize(), result );
-        _pVEHCode.Free();
         _hVEH = 0;
+        _vehType = mt_unknown;
+    }
 
-        _pModTable.Free();
-    }        
+    _pVEHCode.Free();
+    _pModTable.Free();
+    _tableMirror.clear();
 
     return STATUS_SUCCESS;
 }
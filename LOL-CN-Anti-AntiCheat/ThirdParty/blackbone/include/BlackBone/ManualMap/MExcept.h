@@ -3,6 +3,8 @@
 #include "../Include/Winheaders.h"
 #include "../Process/MemBlock.h"
 
+#include <vector>
+
 namespace blackbone
 {
 
@@ -26,7 +28,11 @@ struct ModuleTable
 };
 
 /// <summary>
-/// Exception handling support for arbitrary code
+/// Exception handling support for arbitrary code.
+/// Remote structures are pooled per target process: the module table is
+/// allocated and the handler registered on first use, and every later
+/// image enable/disable is a small table update, so re-injections after
+/// a reconnect skip the allocation and registration entirely
 /// </summary>
 class MExcept
 {
@@ -36,7 +42,9 @@ public:
 
     /// <summary>
     /// Inject VEH wrapper into process
-    /// Used to enable execution of SEH handlers out of image
+    /// Used to enable execution of SEH handlers out of image.
+    /// The codecave and handler registration are reused when already
+    /// installed, making repeat calls a table entry write
     /// </summary>
     /// <param name="proc">Target process</param>
     /// <param name="mod">Target module</param>
@@ -45,18 +53,28 @@ public:
     BLACKBONE_API NTSTATUS CreateVEH( class Process& proc, ModuleData& mod, bool partial );
 
     /// <summary>
-    /// Removes VEH from target process
+    /// Disable exception support for one image.
+    /// The handler stays registered for the process; only the image's
+    /// module table entry is retired. Use Teardown to fully remove the VEH
     /// </summary>
     /// <param name="proc">Target process</param>
     /// <param name="partial">Partial exception support</param>
-    /// <param name="mt">Mosule type</param>
+    /// <param name="mt">Module type</param>
+    /// <param name="base">Image base, 0 to leave the table untouched</param>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS RemoveVEH( class Process& proc, bool partial, eModType mt, ptr_t base = 0 );
+
+    /// <summary>
+    /// Unregister the pooled handler and free the remote structures
+    /// </summary>
+    /// <param name="proc">Target process</param>
     /// <returns>Status code</returns>
-    BLACKBONE_API NTSTATUS RemoveVEH( class Process& proc, bool partial, eModType mt );
+    BLACKBONE_API NTSTATUS Teardown( class Process& proc );
 
     /// <summary>
     /// Reset data
     /// </summary>
-    BLACKBONE_API  inline void reset() { _pModTable.Free(); }
+    BLACKBONE_API  inline void reset() { _pModTable.Free(); _tableMirror.clear(); }
 
 private:
     MExcept( const MExcept& ) = delete;
@@ -66,6 +84,8 @@ private:
     MemBlock  _pVEHCode;    // VEH function codecave
     MemBlock  _pModTable;   // x64 module address range table
     uint64_t  _hVEH = 0;    // VEH handle
+    eModType  _vehType = mt_unknown;            // Module type the installed handler was built for
+    std::vector<ExceptionModule> _tableMirror;  // Local copy of the remote table, keeps updates write-only
 
     static uint8_t _handler32[];
     static uint8_t _handler64[];
@@ -1,4 +1,5 @@
 #include "MMap.h"
+#include "ImportCache.h"
 #include "../Process/Process.h"
 #include "../Misc/NameResolve.h"
 #include "../Misc/Utils.h"
@@ -394,19 +395,14 @@ call_result_t<ModuleDataPtr> MMap::FindOrMapModule(
         }
     }
 
-    // Core image mapping operations
+    // Core image mapping operations. Relocation happens inside the local
+    // staging copy before anything is written to the target
     if (!NT_SUCCESS( status = CopyImage( pImage ) ))
     {
         pImage->peImage.Release();
         return status;
     }
 
-    if (!NT_SUCCESS( status = RelocateImage( pImage ) ))
-    {
-        pImage->peImage.Release();
-        return status;
-    }
-
     auto mt = ldrEntry.type;
 	ModuleDataPtr pMod;
 
@@ -563,15 +559,41 @@ NTSTATUS MMap::CopyImage( ImageContextPtr pImage )
     // offset to first section equals to header size
     size_t dwHeaderSize = pImage->peImage.headersSize();
 
-    // Copy header
+    // Stage the whole image locally - header, sections and relocations
+    // are assembled with pure memory writes, then pushed to the target
+    // in one batched write instead of a write per section followed by a
+    // full image read-modify-write for relocations
+    std::unique_ptr<uint8_t[]> localImage( new uint8_t[pImage->ldrEntry.size]() );
+    auto pLocal = localImage.get();
+
+    memcpy( pLocal, pImage->peImage.base(), dwHeaderSize );
+
+    // Copy sections
+    for (auto& section : pImage->peImage.sections())
+    {
+        // Skip discardable sections
+        if (!(section.Characteristics & (IMAGE_SCN_MEM_READ | IMAGE_SCN_MEM_WRITE | IMAGE_SCN_MEM_EXECUTE)) ||
+            section.SizeOfRawData == 0)
+            continue;
+
+        uint8_t* pSource = reinterpret_cast<uint8_t*>(pImage->peImage.ResolveRVAToVA( section.VirtualAddress ));
+        memcpy( pLocal + section.VirtualAddress, pSource, section.SizeOfRawData );
+    }
+
+    // Fix relocations in the staging copy
+    status = RelocateImage( pImage, pLocal );
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    // Push the assembled image
     if (pImage->flags & HideVAD)
-        status = Driver().WriteMem( _process.pid(), pImage->imgMem.ptr(), dwHeaderSize, pImage->peImage.base() );
+        status = Driver().WriteMem( _process.pid(), pImage->imgMem.ptr(), pImage->ldrEntry.size, pLocal );
     else
-        status = pImage->imgMem.Write( 0, dwHeaderSize, pImage->peImage.base() );
+        status = pImage->imgMem.Write( 0, pImage->ldrEntry.size, pLocal );
 
     if (!NT_SUCCESS( status ))
     {
-        BLACKBONE_TRACE( L"ManualMap: Failed to copy image headers. Status = 0x%x", status );
+        BLACKBONE_TRACE( L"ManualMap: Failed to copy image. Status = 0x%x", status );
         return status;
     }
 
@@ -586,42 +608,6 @@ NTSTATUS MMap::CopyImage( ImageContextPtr pImage )
         }
     }
 
-    // Copy sections
-    for (auto& section : pImage->peImage.sections())
-    {
-        // Skip discardable sections
-        if (section.Characteristics & (IMAGE_SCN_MEM_READ | IMAGE_SCN_MEM_WRITE | IMAGE_SCN_MEM_EXECUTE))
-        {
-            if (section.SizeOfRawData == 0)
-                continue;
-
-            uint8_t* pSource = reinterpret_cast<uint8_t*>(pImage->peImage.ResolveRVAToVA( section.VirtualAddress ));
-            
-            // Copy section data
-            if (pImage->flags & HideVAD)
-            {
-                status = Driver().WriteMem(
-                    _process.pid(), pImage->imgMem.ptr() + section.VirtualAddress,
-                    section.SizeOfRawData, pSource
-                    );
-            }
-            else
-            {
-                status = pImage->imgMem.Write( section.VirtualAddress, section.SizeOfRawData, pSource );
-            }
-
-            if (!NT_SUCCESS( status ))
-            {
-                BLACKBONE_TRACE(
-                    L"ManualMap: Failed to copy image section at offset 0x%x. Status = 0x%x",
-                    section.VirtualAddress, status
-                    );
-
-                return status;
-            }
-        } 
-    }
-
     return STATUS_SUCCESS;
 }
 
@@ -667,13 +653,13 @@ NTSTATUS MMap::ProtectImageMemory( ImageContextPtr pImage )
 }
 
 /// <summary>
-///  Fix relocations if image wasn't loaded at base address
+///  Fix relocations in the local staging copy if image wasn't loaded at base address
 /// </summary>
 /// <param name="pImage">image data</param>
+/// <param name="pLocalImage">Staged image copy to patch</param>
 /// <returns>true on success</returns>
-NTSTATUS MMap::RelocateImage( ImageContextPtr pImage )
+NTSTATUS MMap::RelocateImage( ImageContextPtr pImage, uint8_t* pLocalImage )
 {
-    NTSTATUS status = STATUS_SUCCESS;
     BLACKBONE_TRACE( L"ManualMap: Relocating image '%ls'", pImage->ldrEntry.fullPath.c_str() );
 
     // Reloc delta
@@ -704,10 +690,8 @@ NTSTATUS MMap::RelocateImage( ImageContextPtr pImage )
         return STATUS_SUCCESS;
     }
 
-    // Read whole image to process it locally
-    std::unique_ptr<uint8_t[]> localImage( new uint8_t[pImage->ldrEntry.size] );
-    auto pLocal = localImage.get();
-    _process.memory().Read( pImage->imgMem.ptr(), pImage->ldrEntry.size, pLocal );
+    // Patch the staging copy, nothing is read from or written to the target
+    auto pLocal = pLocalImage;
 
     while ((uintptr_t)fixrec < end && fixrec->BlockSize)
     {
@@ -749,18 +733,7 @@ NTSTATUS MMap::RelocateImage( ImageContextPtr pImage )
         fixrec = reinterpret_cast<pe::RelocData*>(reinterpret_cast<uintptr_t>(fixrec) + fixrec->BlockSize);
     }
 
-    // Apply relocations, skip header
-    if (pImage->flags & HideVAD)
-        status = Driver().WriteMem( _process.pid(), pImage->ldrEntry.baseAddress + 0x1000, pImage->ldrEntry.size - 0x1000, pLocal + 0x1000 );
-    else
-        status = _process.memory().Write( pImage->ldrEntry.baseAddress + 0x1000, pImage->ldrEntry.size - 0x1000, pLocal + 0x1000 );
-
-    if (!NT_SUCCESS( status ))
-    {
-        BLACKBONE_TRACE( L"ManualMap: Failed to apply relocations. Status = 0x%x", status );
-    }
-
-    return status;
+    return STATUS_SUCCESS;
 }
 
 /// <summary>
@@ -872,6 +845,30 @@ NTSTATUS MMap::ResolveImport( ImageContextPtr pImage, bool useDelayed /*= false
         {
             call_result_t<exportData> expData;
 
+            const std::string funcKey = importFn.importByOrd ?
+                "#" + std::to_string( importFn.importOrdinal ) :
+                importFn.importName;
+
+            // Consult the persistent cache before walking any export directory
+            {
+                std::wstring provider;
+                uint32_t rva = 0;
+
+                if (ImportCache::Instance().Lookup( wstrDll, funcKey, provider, rva ))
+                {
+                    auto provMod = _process.modules().GetModule( provider );
+                    if (provMod && ImportCache::Instance().ProviderValid( provider, provMod->fullPath ))
+                    {
+                        if (pImage->ldrEntry.type == mt_mod64)
+                            *reinterpret_cast<uint64_t*>(pLocal + importFn.ptrRVA) = provMod->baseAddress + rva;
+                        else
+                            *reinterpret_cast<uint32_t*>(pLocal + importFn.ptrRVA) = static_cast<uint32_t>(provMod->baseAddress + rva);
+
+                        continue;
+                    }
+                }
+            }
+
             if (importFn.importByOrd)
                 expData = _process.modules().GetExport( hMod.result(), reinterpret_cast<const char*>(importFn.importOrdinal) );
             else
@@ -929,9 +926,20 @@ NTSTATUS MMap::ResolveImport( ImageContextPtr pImage, bool useDelayed /*= false
                 *reinterpret_cast<uint64_t*>(pLocal + importFn.ptrRVA) = expData->procAddress;
             else
                 *reinterpret_cast<uint32_t*>(pLocal + importFn.ptrRVA) = static_cast<uint32_t>(expData->procAddress);
+
+            // Record resolution against the module that finally provides the function
+            if (auto provMod = _process.modules().GetModule( expData->procAddress, false ))
+            {
+                ImportCache::Instance().Store(
+                    wstrDll, funcKey, provMod->name, provMod->fullPath,
+                    static_cast<uint32_t>(expData->procAddress - provMod->baseAddress)
+                );
+            }
         }
     }
 
+    ImportCache::Instance().Save();
+
     auto status = STATUS_SUCCESS;
 
     // Apply imports, skip header
@@ -1057,7 +1065,7 @@ NTSTATUS MMap::DisableExceptions( ImageContextPtr pImage )
     }
 
     partial = (pImage->flags & PartialExcept) != 0;
-    return _expMgr.RemoveVEH( _process, partial, pImage->peImage.mType() );
+    return _expMgr.RemoveVEH( _process, partial, pImage->peImage.mType(), pImage->ldrEntry.baseAddress );
 }
 
 /// <summary>
@@ -1554,7 +1562,7 @@ NTSTATUS MMap::AllocateInHighMem( MemBlock& imageMem, size_t size )
 void MMap::Cleanup()
 {
     reset();
-    _expMgr.reset();
+    _expMgr.Teardown( _process );
     _process.remote().reset();
 }
 
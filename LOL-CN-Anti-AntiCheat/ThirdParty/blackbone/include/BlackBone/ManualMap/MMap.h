@@ -278,7 +278,9 @@ private:
     call_result_t<uint64_t> RunModuleInitializers( ImageContextPtr pImage, DWORD dwReason, CustomArgs_t* pCustomArgs_t = nullptr );
 
     /// <summary>
-    /// Copies image into target process
+    /// Copies image into target process.
+    /// Header, sections and relocations are staged in a local buffer
+    /// first and pushed remotely with one batched write.
     /// </summary>
     /// <param name="pImage">Image data</param>
     /// <returns>Status code</returns>
@@ -292,11 +294,12 @@ private:
     NTSTATUS ProtectImageMemory( ImageContextPtr pImage );
 
     /// <summary>
-    ///  Fix relocations if image wasn't loaded at base address
+    ///  Fix relocations in the local staging copy if image wasn't loaded at base address
     /// </summary>
     /// <param name="pImage">image data</param>
+    /// <param name="pLocalImage">Staged image copy to patch</param>
     /// <returns>true on success</returns>
-    NTSTATUS RelocateImage( ImageContextPtr pImage );
+    NTSTATUS RelocateImage( ImageContextPtr pImage, uint8_t* pLocalImage );
 
     /// <summary>
     /// Resolves image import or delayed image import
@@ -3,14 +3,138 @@
 #include "../../Include/Macro.h"
 #include "../../Misc/Utils.h"
 #include "../../Misc/DynImport.h"
+#include "../../Misc/OsPersonality.h"
 #include "../../Misc/trace.hpp"
 #include "../../Symbols/SymbolData.h"
 
 #include <3rd_party/VersionApi.h>
 
+#include <fstream>
+#include <sstream>
+
 namespace blackbone
 {
 
+namespace
+{
+
+/// <summary>
+/// Persistent cache of discovered loader structure RVAs.
+/// LdrpHashTable and LdrpModuleIndex are invariant per ntdll build, so
+/// their RVAs are stored keyed by the file's size/write-time token and
+/// bitness, reserving the remote walks and the full ntdll sweep for
+/// cache misses.
+/// </summary>
+class LdrStructCache
+{
+public:
+    struct Entry
+    {
+        ptr_t hashTableRva = 0;     // LdrpHashTable RVA
+        ptr_t moduleIndexRva = 0;   // LdrpModuleIndex RVA, win8+ only
+    };
+
+public:
+    static LdrStructCache& Instance()
+    {
+        static LdrStructCache instance;
+        return instance;
+    }
+
+    /// <summary>
+    /// Build cache key from ntdll file identity and bitness
+    /// </summary>
+    /// <param name="ntdllPath">ntdll file path</param>
+    /// <param name="type">Module type. 32 bit or 64 bit</param>
+    /// <returns>Key, empty if the file is inaccessible</returns>
+    static std::wstring MakeKey( const std::wstring& ntdllPath, eModType type )
+    {
+        WIN32_FILE_ATTRIBUTE_DATA attrib = { };
+        if (!GetFileAttributesExW( ntdllPath.c_str(), GetFileExInfoStandard, &attrib ))
+            return L"";
+
+        const uint64_t size = (static_cast<uint64_t>(attrib.nFileSizeHigh) << 32) | attrib.nFileSizeLow;
+        const uint64_t time = (static_cast<uint64_t>(attrib.ftLastWriteTime.dwHighDateTime) << 32) | attrib.ftLastWriteTime.dwLowDateTime;
+
+        return Utils::FormatString( L"%d|%llx", type == mt_mod32 ? 32 : 64, size ^ (time * 0x100000001B3ull) );
+    }
+
+    /// <summary>
+    /// Find cached RVAs for an ntdll build
+    /// </summary>
+    /// <param name="key">Cache key</param>
+    /// <param name="entry">Receives cached RVAs</param>
+    /// <returns>true if an entry exists</returns>
+    bool Get( const std::wstring& key, Entry& entry )
+    {
+        CSLock lck( _lock );
+
+        auto found = _entries.find( key );
+        if (found == _entries.end())
+            return false;
+
+        entry = found->second;
+        return true;
+    }
+
+    /// <summary>
+    /// Record discovered RVAs and persist the cache
+    /// </summary>
+    /// <param name="key">Cache key</param>
+    /// <param name="entry">Discovered RVAs</param>
+    void Set( const std::wstring& key, const Entry& entry )
+    {
+        CSLock lck( _lock );
+
+        _entries[key] = entry;
+
+        std::ofstream file( _cachePath, std::ios::out | std::ios::trunc );
+        if (!file)
+            return;
+
+        for (const auto& item : _entries)
+        {
+            char buf[64];
+            sprintf_s( buf, "\t%llx\t%llx\n", item.second.hashTableRva, item.second.moduleIndexRva );
+            file << Utils::WstringToUTF8( item.first ) << buf;
+        }
+    }
+
+private:
+    LdrStructCache()
+    {
+        wchar_t tmpPath[MAX_PATH] = { 0 };
+        GetTempPathW( ARRAYSIZE( tmpPath ), tmpPath );
+        _cachePath = std::wstring( tmpPath ) + L"BlackBone_ldrdata.dat";
+
+        std::ifstream file( _cachePath, std::ios::in );
+        if (!file)
+            return;
+
+        std::string line;
+        while (std::getline( file, line ))
+        {
+            std::istringstream ss( line );
+            std::string key, hash, index;
+
+            if (!std::getline( ss, key, '\t' ) || !std::getline( ss, hash, '\t' ) || !std::getline( ss, index, '\t' ))
+                continue;
+
+            Entry entry;
+            entry.hashTableRva = strtoull( hash.c_str(), nullptr, 16 );
+            entry.moduleIndexRva = strtoull( index.c_str(), nullptr, 16 );
+            _entries[Utils::UTF8ToWstring( key )] = entry;
+        }
+    }
+
+private:
+    CriticalSection _lock;              // Cache guard
+    std::wstring _cachePath;            // Backing file path
+    std::map<std::wstring, Entry> _entries;
+};
+
+}
+
 NtLdr::NtLdr( Process& proc )
     : _process( proc )
 {
@@ -37,20 +161,54 @@ bool NtLdr::Init( eModType initFor /*= mt_default*/ )
     if (_initializedFor == mt_unknown)
         _initializedFor = _process.core().isWow64() ? mt_mod32 : mt_mod64;
 
+    // LdrpHashTable and LdrpModuleIndex RVAs are invariant per ntdll build,
+    // try the persisted cache before walking loader structures.
+    // LdrHeapBase is per-process and is always rediscovered.
+    auto pNtdll = _process.modules().GetModule( L"ntdll.dll", LdrList, _initializedFor );
+    std::wstring cacheKey = pNtdll ? LdrStructCache::MakeKey( pNtdll->fullPath, _initializedFor ) : L"";
+
+    LdrStructCache::Entry cached;
+    bool fromCache = !cacheKey.empty() &&
+        LdrStructCache::Instance().Get( cacheKey, cached ) &&
+        cached.hashTableRva != 0 && cached.hashTableRva < pNtdll->size &&
+        (!OsInfo().useModuleIndex || (cached.moduleIndexRva != 0 && cached.moduleIndexRva < pNtdll->size));
+
+    if (fromCache)
+    {
+        _LdrpHashTable = pNtdll->baseAddress + cached.hashTableRva;
+        if (OsInfo().useModuleIndex)
+            _LdrpModuleIndexBase = pNtdll->baseAddress + cached.moduleIndexRva;
+    }
+
     // Select loader version
     if (_initializedFor == mt_mod32)
     {
         FindLdrHeap<uint32_t>();
-        FindLdrpHashTable<uint32_t>();
-        if (IsWindows8OrGreater())
-            FindLdrpModuleIndexBase<uint32_t>();
+        if (!fromCache)
+        {
+            FindLdrpHashTable<uint32_t>();
+            if (OsInfo().useModuleIndex)
+                FindLdrpModuleIndexBase<uint32_t>();
+        }
     }
     else
     {
         FindLdrHeap<uint64_t>();
-        FindLdrpHashTable<uint64_t>();
-        if (IsWindows8OrGreater())
-            FindLdrpModuleIndexBase<uint64_t>();
+        if (!fromCache)
+        {
+            FindLdrpHashTable<uint64_t>();
+            if (OsInfo().useModuleIndex)
+                FindLdrpModuleIndexBase<uint64_t>();
+        }
+    }
+
+    // Persist fresh discovery for subsequent runs
+    if (!fromCache && !cacheKey.empty() && _LdrpHashTable != 0 &&
+        (!OsInfo().useModuleIndex || _LdrpModuleIndexBase != 0))
+    {
+        cached.hashTableRva = _LdrpHashTable - pNtdll->baseAddress;
+        cached.moduleIndexRva = _LdrpModuleIndexBase != 0 ? _LdrpModuleIndexBase - pNtdll->baseAddress : 0;
+        LdrStructCache::Instance().Set( cacheKey, cached );
     }
 
     _nodeMap.clear();
@@ -61,7 +219,7 @@ bool NtLdr::Init( eModType initFor /*= mt_default*/ )
         BLACKBONE_TRACE( "NativeLdr: LdrHeapBase not found" );
     if (_LdrpHashTable == 0)
         BLACKBONE_TRACE( "NativeLdr: LdrpHashTable not found" );
-    if (IsWindows8OrGreater() && _LdrpModuleIndexBase == 0)
+    if (OsInfo().useModuleIndex && _LdrpModuleIndexBase == 0)
         BLACKBONE_TRACE( "NativeLdr: LdrpModuleIndexBase not found" );
 #endif
 
@@ -85,7 +243,7 @@ bool NtLdr::CreateNTReference( NtLdrEntry& mod )
         Init( mod.type );
 
     bool x64Image = (mod.type == mt_mod64);
-    bool w8 = IsWindows8OrGreater();
+    bool w8 = OsInfo().win8Plus;
 
     // Win 8 and higher
     if (w8)
@@ -163,12 +321,12 @@ NTSTATUS NtLdr::AddStaticTLSEntry( NtLdrEntry& mod, ptr_t tlsPtr )
     ptr_t LdrpHandleTlsData = 0;
     if (mod.type == mt_mod64)
     {
-        LdrpHandleTlsData = g_symbols.LdrpHandleTlsData64;
+        LdrpHandleTlsData = Symbols().LdrpHandleTlsData64;
         pNode = SetNode<_LDR_DATA_TABLE_ENTRY_BASE64>( pNode, mod.baseAddress );
     }
     else
     {
-        LdrpHandleTlsData = g_symbols.LdrpHandleTlsData32;
+        LdrpHandleTlsData = Symbols().LdrpHandleTlsData32;
         pNode = SetNode<_LDR_DATA_TABLE_ENTRY_BASE32>( pNode, mod.baseAddress );
     }
 
@@ -212,7 +370,7 @@ NTSTATUS NtLdr::AddStaticTLSEntry( NtLdrEntry& mod, ptr_t tlsPtr )
         uint64_t result = 0;
 
         a->GenPrologue();
-        a->GenCall( LdrpHandleTlsData, { pNode }, IsWindows8Point1OrGreater() ? cc_thiscall : cc_stdcall );
+        a->GenCall( LdrpHandleTlsData, { pNode }, OsInfo().tlsHandleCC );
         _process.remote().AddReturnWithEvent( *a );
         a->GenEpilogue();
 
@@ -235,12 +393,12 @@ NTSTATUS NtLdr::AddStaticTLSEntry( NtLdrEntry& mod, ptr_t tlsPtr )
 /// <returns>true on success</returns>
 bool NtLdr::InsertInvertedFunctionTable( NtLdrEntry& mod )
 { 
-    ptr_t RtlInsertInvertedFunctionTable = g_symbols.RtlInsertInvertedFunctionTable64;
-    ptr_t LdrpInvertedFunctionTable = g_symbols.LdrpInvertedFunctionTable64;
+    ptr_t RtlInsertInvertedFunctionTable = Symbols().RtlInsertInvertedFunctionTable64;
+    ptr_t LdrpInvertedFunctionTable = Symbols().LdrpInvertedFunctionTable64;
     if (mod.type == mt_mod32)
     {
-        RtlInsertInvertedFunctionTable = g_symbols.RtlInsertInvertedFunctionTable32;
-        LdrpInvertedFunctionTable = g_symbols.LdrpInvertedFunctionTable32;
+        RtlInsertInvertedFunctionTable = Symbols().RtlInsertInvertedFunctionTable32;
+        LdrpInvertedFunctionTable = Symbols().LdrpInvertedFunctionTable32;
     }
 
     // Invalid addresses. Probably pattern scan has failed
@@ -260,10 +418,8 @@ bool NtLdr::InsertInvertedFunctionTable( NtLdrEntry& mod )
 
         a->GenPrologue();
 
-        if (IsWindows8Point1OrGreater())
-            a->GenCall( RtlInsertInvertedFunctionTable, { mod.baseAddress, mod.size }, cc_fastcall );
-        else if (IsWindows8OrGreater())
-            a->GenCall( RtlInsertInvertedFunctionTable, { mod.baseAddress, mod.size } );
+        if (OsInfo().win8Plus)
+            a->GenCall( RtlInsertInvertedFunctionTable, { mod.baseAddress, mod.size }, OsInfo().insertInvertedCC );
         else
             a->GenCall( RtlInsertInvertedFunctionTable, { LdrpInvertedFunctionTable, mod.baseAddress, mod.size } );
 
@@ -325,7 +481,7 @@ bool NtLdr::InsertInvertedFunctionTable( NtLdrEntry& mod )
         return false;
     };
 
-    if (IsWindows8OrGreater())
+    if (OsInfo().useNewInvertedTable)
     {
         if(mod.type == mt_mod64)
             return InsertP( _RTL_INVERTED_FUNCTION_TABLE8<DWORD64>() );
@@ -353,9 +509,9 @@ NTSTATUS NtLdr::UnloadTLS( const NtLdrEntry& mod, bool noThread /*= false*/ )
     if (mod.ldrPtr == 0)
         return STATUS_INVALID_ADDRESS;
 
-    ptr_t LdrpReleaseTlsEntry = g_symbols.LdrpReleaseTlsEntry64;
+    ptr_t LdrpReleaseTlsEntry = Symbols().LdrpReleaseTlsEntry64;
     if (mod.type == mt_mod32)
-        LdrpReleaseTlsEntry = g_symbols.LdrpReleaseTlsEntry32;
+        LdrpReleaseTlsEntry = Symbols().LdrpReleaseTlsEntry32;
 
     // Not available
     if (LdrpReleaseTlsEntry == 0)
@@ -365,7 +521,7 @@ NTSTATUS NtLdr::UnloadTLS( const NtLdrEntry& mod, bool noThread /*= false*/ )
     uint64_t result = 0;
 
     a->GenPrologue();
-    a->GenCall( LdrpReleaseTlsEntry, { mod.ldrPtr, 0 }, IsWindows8Point1OrGreater() ? cc_fastcall : cc_stdcall );
+    a->GenCall( LdrpReleaseTlsEntry, { mod.ldrPtr, 0 }, OsInfo().tlsReleaseCC );
 
     _process.remote().AddReturnWithEvent( *a );
     a->GenEpilogue();
@@ -654,7 +810,7 @@ ULONG NtLdr::HashString( const std::wstring& str )
 {
     ULONG hash = 0;
 
-    if (IsWindows8OrGreater())
+    if (OsInfo().win8Plus)
     {
         UNICODE_STRING ustr;
         SAFE_CALL( RtlInitUnicodeString, &ustr, str.c_str() );
@@ -884,7 +1040,7 @@ bool NtLdr::Unlink( const ModuleData& mod, bool noThread /*= false*/ )
 
     // Unlink from graph
     // TODO: Unlink from _LdrpMappingInfoIndex. Still can't decide if it is required.
-    if (IsWindows8OrGreater())
+    if (OsInfo().useModuleIndex)
         ldrEntry = CALL_64_86( x64Image, UnlinkTreeNode, mod, ldrEntry, noThread );
 
     return ldrEntry != 0;
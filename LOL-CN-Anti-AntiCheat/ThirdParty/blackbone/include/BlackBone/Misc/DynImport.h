@@ -2,19 +2,49 @@
 
 #include "../Include/Types.h"
 #include "../Include/Winheaders.h"
+#include "Epoch.h"
 #include "Utils.h"
 #include "InitOnce.h"
 
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
 
 namespace blackbone
 {
 
+/// <summary>
+/// Compile-time FNV-1a of an import name.
+/// Same constants as encstr::fnv1a, so hashes agree across the project
+/// </summary>
+/// <param name="str">Import name</param>
+/// <returns>Name hash</returns>
+constexpr uint32_t import_hash( const char* str )
+{
+    uint32_t result = 0x811c9dc5ul;
+
+    for (; *str != '\0'; str++)
+    {
+        result ^= static_cast<uint32_t>(*str);
+        result *= 16777619ul;
+    }
+
+    return result;
+}
+
 /// <summary>
 /// Dynamic import
 /// </summary>
 class DynImport
 {
+    // Identity hash, keys are FNV-1a hashes already
+    struct HashNop
+    {
+        size_t operator()( uint32_t key ) const { return key; }
+    };
+
+    using mapFuncs = std::unordered_map<uint32_t, FARPROC, HashNop>;
+
 public:
     BLACKBONE_API static DynImport& Instance()
     {
@@ -26,35 +56,52 @@ public:
     DynImport( const DynImport& ) = delete;
 
     /// <summary>
-    /// Get dll function
+    /// Get dll function.
+    /// Wait-free: an epoch guard pins the current snapshot for the duration
+    /// of the hash probe, no locks and no loops - safe from hook context
     /// </summary>
-    /// <param name="name">Function name</param>
+    /// <param name="hash">Function name hash</param>
     /// <returns>Function pointer</returns>
     template<typename T>
-    T get( const std::string& name ) 
+    T get( uint32_t hash )
     {
         InitializeOnce();
 
-        CSLock lck( _mapGuard );
+        epoch::Guard guard;
+
+        auto snapshot = _snapshot.load();
+        if (snapshot == nullptr)
+            return nullptr;
 
-        auto iter = _funcs.find( name );
-        if (iter != _funcs.end())
+        auto iter = snapshot->find( hash );
+        if (iter != snapshot->end())
             return reinterpret_cast<T>(iter->second);
 
         return nullptr;
     }
 
+    /// <summary>
+    /// Get dll function
+    /// </summary>
+    /// <param name="name">Function name</param>
+    /// <returns>Function pointer</returns>
+    template<typename T>
+    T get( const std::string& name )
+    {
+        return get<T>( import_hash( name.c_str() ) );
+    }
+
     /// <summary>
     /// Safely call import
     /// If import not found - return STATUS_ORDINAL_NOT_FOUND
     /// </summary>
-    /// <param name="name">Import name.</param>
+    /// <param name="hash">Import name hash</param>
     /// <param name="...args">Function args</param>
     /// <returns>Function result or STATUS_ORDINAL_NOT_FOUND if import not found</returns>
     template<typename T, typename... Args>
-    NTSTATUS safeNativeCall( const std::string& name, Args&&... args )
+    NTSTATUS safeNativeCall( uint32_t hash, Args&&... args )
     {
-        auto pfn = DynImport::get<T>( name );
+        auto pfn = DynImport::get<T>( hash );
         return pfn ? pfn( std::forward<Args>( args )... ) : STATUS_ORDINAL_NOT_FOUND;
     }
 
@@ -62,14 +109,14 @@ public:
     /// Safely call import
     /// If import not found - return 0
     /// </summary>
-    /// <param name="name">Import name.</param>
+    /// <param name="hash">Import name hash</param>
     /// <param name="...args">Function args</param>
     /// <returns>Function result or 0 if import not found</returns>
     template<typename T, typename... Args>
-    auto safeCall( const std::string& name, Args&&... args )
+    auto safeCall( uint32_t hash, Args&&... args )
     {
-        auto pfn = DynImport::get<T>( name );
-		return pfn ? pfn( std::forward<Args>( args )... ) : std::invoke_result_t<T, Args...>();
+        auto pfn = DynImport::get<T>( hash );
+        return pfn ? pfn( std::forward<Args>( args )... ) : std::invoke_result_t<T, Args...>();
     }
 
     /// <summary>
@@ -97,7 +144,13 @@ public:
         auto proc = GetProcAddress( hMod, name.c_str() );
         if (proc)
         {
-            _funcs.insert( std::make_pair( name, proc ) );
+            // Publish a new immutable snapshot, readers keep the old one.
+            // The previous snapshot is retired and freed after a grace period
+            auto prev = _snapshot.load();
+            auto next = prev != nullptr ? std::make_unique<mapFuncs>( *prev ) : std::make_unique<mapFuncs>();
+            (*next)[import_hash( name.c_str() )] = proc;
+
+            _snapshot.publish( std::move( next ) );
             return proc;
         }
 
@@ -105,14 +158,17 @@ public:
     }
 
 private:
-    std::unordered_map<std::string, FARPROC> _funcs;    // function database
-    CriticalSection _mapGuard;                          // function database guard
+    EpochPtr<mapFuncs> _snapshot;   // Current function database snapshot
+    CriticalSection _mapGuard;      // Snapshot publish guard
 };
 
+// Compile-time name hash for the macros below
+#define DYNIMPORT_HASH(name) (std::integral_constant<uint32_t, blackbone::import_hash( name )>::value)
+
 // Syntax sugar
 #define LOAD_IMPORT(name, module) (DynImport::Instance().load( name, module ))
-#define GET_IMPORT(name) (DynImport::Instance().get<fn ## name>( #name ))
-#define SAFE_NATIVE_CALL(name, ...) (DynImport::Instance().safeNativeCall<fn ## name>( #name, __VA_ARGS__ ))
-#define SAFE_CALL(name, ...) (DynImport::Instance().safeCall<fn ## name>( #name, __VA_ARGS__ ))
+#define GET_IMPORT(name) (DynImport::Instance().get<fn ## name>( DYNIMPORT_HASH( #name ) ))
+#define SAFE_NATIVE_CALL(name, ...) (DynImport::Instance().safeNativeCall<fn ## name>( DYNIMPORT_HASH( #name ), __VA_ARGS__ ))
+#define SAFE_CALL(name, ...) (DynImport::Instance().safeCall<fn ## name>( DYNIMPORT_HASH( #name ), __VA_ARGS__ ))
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+#include "Epoch.h"
+#include "Utils.h"
+
+#include <vector>
+
+namespace blackbone
+{
+namespace epoch
+{
+
+namespace
+{
+
+// Global epoch, bumped on every retirement. Starts at 1 so 0 can mean idle
+std::atomic<uint32_t> g_epoch{ 1 };
+
+// Head of the reader record list. Records are pushed with CAS and never
+// removed; the list length is bounded by the peak thread count
+std::atomic<ThreadRecord*> g_records{ nullptr };
+
+struct RetiredItem
+{
+    void* ptr;
+    void( *deleter )(void*);
+    uint32_t epoch;
+};
+
+// Retirement bookkeeping, writers only
+CriticalSection g_retireGuard;
+std::vector<RetiredItem> g_retired;
+
+/// <summary>
+/// Oldest epoch any reader is currently inside, or the current epoch if
+/// every reader is idle
+/// </summary>
+/// <returns>Minimum active epoch</returns>
+uint32_t MinActiveEpoch()
+{
+    uint32_t minEpoch = g_epoch.load( std::memory_order_acquire );
+    for (auto* record = g_records.load( std::memory_order_acquire ); record != nullptr; record = record->next)
+    {
+        const uint32_t seen = record->epoch.load( std::memory_order_acquire );
+        if (seen != 0 && seen < minEpoch)
+            minEpoch = seen;
+    }
+
+    return minEpoch;
+}
+
+/// <summary>
+/// Destroy every retired item whose grace period has elapsed.
+/// Must be called under g_retireGuard
+/// </summary>
+void ReclaimLocked()
+{
+    const uint32_t minEpoch = MinActiveEpoch();
+
+    size_t kept = 0;
+    for (size_t i = 0; i < g_retired.size(); i++)
+    {
+        // A reader inside epoch e can observe snapshots retired at e or
+        // later, so only items strictly older than every active reader go
+        if (g_retired[i].epoch < minEpoch)
+            g_retired[i].deleter( g_retired[i].ptr );
+        else
+            g_retired[kept++] = g_retired[i];
+    }
+
+    g_retired.resize( kept );
+}
+
+}
+
+ThreadRecord* AcquireRecord()
+{
+    thread_local ThreadRecord* record = nullptr;
+    if (record == nullptr)
+    {
+        record = new ThreadRecord();
+
+        auto* head = g_records.load( std::memory_order_relaxed );
+        do
+        {
+            record->next = head;
+        } while (!g_records.compare_exchange_weak( head, record, std::memory_order_release, std::memory_order_relaxed ));
+    }
+
+    return record;
+}
+
+void Guard::Enter( ThreadRecord* record )
+{
+    // Re-validate after announcing: a writer scanning records between our
+    // epoch load and store must still see us pinned to a current-enough epoch
+    for (;;)
+    {
+        const uint32_t seen = g_epoch.load( std::memory_order_relaxed );
+        record->epoch.store( seen, std::memory_order_seq_cst );
+
+        if (g_epoch.load( std::memory_order_acquire ) == seen)
+            return;
+    }
+}
+
+void Retire( void* ptr, void( *deleter )(void*) )
+{
+    CSLock lck( g_retireGuard );
+
+    const uint32_t retireEpoch = g_epoch.fetch_add( 1, std::memory_order_acq_rel );
+    g_retired.push_back( RetiredItem{ ptr, deleter, retireEpoch } );
+
+    ReclaimLocked();
+}
+
+}
+}
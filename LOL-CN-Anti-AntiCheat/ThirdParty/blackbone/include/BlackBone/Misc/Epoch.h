@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../Include/Winheaders.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace blackbone
+{
+namespace epoch
+{
+
+/// <summary>
+/// Per-thread reader record. Allocated once on first use and linked into a
+/// global list that is never unlinked - an idle record (epoch 0) pins nothing,
+/// so thread exit needs no cleanup
+/// </summary>
+struct ThreadRecord
+{
+    std::atomic<uint32_t> epoch{ 0 };   // 0 - outside any critical section
+    ThreadRecord* next = nullptr;       // Next record in the global list
+};
+
+/// <summary>
+/// Get the calling thread's reader record, registering it on first use
+/// </summary>
+/// <returns>Thread record</returns>
+BLACKBONE_API ThreadRecord* AcquireRecord();
+
+/// <summary>
+/// Retire a snapshot: it is destroyed once every reader that could still
+/// observe it has left its critical section. Also reclaims anything whose
+/// grace period has elapsed
+/// </summary>
+/// <param name="ptr">Snapshot to retire</param>
+/// <param name="deleter">Destruction callback</param>
+BLACKBONE_API void Retire( void* ptr, void( *deleter )(void*) );
+
+/// <summary>
+/// Reader critical section.
+/// Enter/exit cost is two atomic stores to the thread's own record plus a
+/// re-validation load, no locks and no waiting - safe from hook context
+/// </summary>
+class Guard
+{
+public:
+    Guard()
+        : _record( AcquireRecord() )
+    {
+        Enter( _record );
+    }
+
+    ~Guard()
+    {
+        _record->epoch.store( 0, std::memory_order_release );
+    }
+
+    Guard( const Guard& ) = delete;
+    Guard& operator=( const Guard& ) = delete;
+
+private:
+    BLACKBONE_API static void Enter( ThreadRecord* record );
+
+private:
+    ThreadRecord* _record;
+};
+
+}
+
+/// <summary>
+/// Atomic pointer to an immutable snapshot with epoch-based reclamation.
+/// Readers wrap access in epoch::Guard and load the pointer; writers publish
+/// a replacement and retire the old one, which is freed only after a grace
+/// period - after every reader active at publish time has exited
+/// </summary>
+template<typename T>
+class EpochPtr
+{
+public:
+    EpochPtr() = default;
+
+    EpochPtr( const EpochPtr& ) = delete;
+    EpochPtr& operator=( const EpochPtr& ) = delete;
+
+    ~EpochPtr()
+    {
+        // Owner teardown: no readers can remain by contract
+        delete _ptr.load( std::memory_order_relaxed );
+    }
+
+    /// <summary>
+    /// Current snapshot. Only valid under an epoch::Guard
+    /// </summary>
+    /// <returns>Snapshot pointer, nullptr if nothing was published</returns>
+    const T* load() const
+    {
+        return _ptr.load( std::memory_order_acquire );
+    }
+
+    /// <summary>
+    /// Publish a new snapshot and retire the previous one
+    /// </summary>
+    /// <param name="next">Replacement snapshot, ownership is taken</param>
+    void publish( std::unique_ptr<T> next )
+    {
+        T* prev = _ptr.exchange( next.release(), std::memory_order_acq_rel );
+        if (prev != nullptr)
+            epoch::Retire( prev, []( void* p ) { delete static_cast<T*>(p); } );
+    }
+
+private:
+    std::atomic<T*> _ptr{ nullptr };
+};
+
+}
@@ -0,0 +1,48 @@
+#include "FutexEvent.h"
+#include "DynImport.h"
+
+namespace blackbone
+{
+
+FutexEvent::FutexEvent( volatile uint32_t* word )
+    : _word( word )
+{
+}
+
+NTSTATUS FutexEvent::WaitFor( uint32_t value, uint32_t timeout, uint32_t spinCount /*= 4000*/ )
+{
+    // Short spin covers sub-microsecond notifications
+    for (uint32_t i = 0; i < spinCount && *_word != value; i++)
+        YieldProcessor();
+
+    const uint64_t start = GetTickCount64();
+    while (*_word != value)
+    {
+        if (GetTickCount64() - start >= timeout)
+            return STATUS_TIMEOUT;
+
+        // Block on the address, poll where unsupported
+        uint32_t undesired = *_word;
+        LARGE_INTEGER delay = { { 0 } };
+        delay.QuadPart = -10ll * 1000 * 5;
+
+        auto status = SAFE_NATIVE_CALL( RtlWaitOnAddress, (volatile VOID*)_word, &undesired, sizeof( undesired ), &delay );
+        if (status == STATUS_ORDINAL_NOT_FOUND)
+            Sleep( 1 );
+    }
+
+    return STATUS_SUCCESS;
+}
+
+void FutexEvent::Signal( uint32_t value )
+{
+    *_word = value;
+    SAFE_NATIVE_CALL( RtlWakeAddressAll, (PVOID)_word );
+}
+
+uint32_t FutexEvent::Value() const
+{
+    return *_word;
+}
+
+}
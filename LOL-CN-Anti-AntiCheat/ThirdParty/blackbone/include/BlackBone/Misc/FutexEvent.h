@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../Include/Winheaders.h"
+
+#include <cstdint>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Notification primitive over a plain 32-bit word in (optionally shared) memory.
+/// Replaces named kernel events for RPC and hook return handshakes: the signaling
+/// side performs one store to the word, the waiting side spins briefly to cover
+/// sub-microsecond returns and then blocks with RtlWaitOnAddress. No kernel
+/// object is created and no handle exists in either process; a remote signaler
+/// only needs write access to the word, the local waiter is woken by the
+/// address wait timing out and re-checking
+/// </summary>
+class FutexEvent
+{
+public:
+    BLACKBONE_API explicit FutexEvent( volatile uint32_t* word );
+
+    /// <summary>
+    /// Wait until the word holds the given value
+    /// </summary>
+    /// <param name="value">Value to wait for</param>
+    /// <param name="timeout">Wait timeout, in milliseconds</param>
+    /// <param name="spinCount">Spin iterations before blocking</param>
+    /// <returns>Status code, STATUS_TIMEOUT if the value never appeared</returns>
+    BLACKBONE_API NTSTATUS WaitFor( uint32_t value, uint32_t timeout, uint32_t spinCount = 4000 );
+
+    /// <summary>
+    /// Publish a value and wake local waiters
+    /// </summary>
+    /// <param name="value">Value to store</param>
+    BLACKBONE_API void Signal( uint32_t value );
+
+    /// <summary>
+    /// Current word value
+    /// </summary>
+    /// <returns>Value</returns>
+    BLACKBONE_API uint32_t Value() const;
+
+private:
+    volatile uint32_t* _word;
+};
+
+}
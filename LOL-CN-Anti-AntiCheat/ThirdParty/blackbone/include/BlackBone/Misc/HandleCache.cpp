@@ -0,0 +1,67 @@
+#include "HandleCache.h"
+
+#include <algorithm>
+
+namespace blackbone
+{
+
+HandleCache& HandleCache::Instance()
+{
+    static HandleCache instance;
+    return instance;
+}
+
+HandleLease HandleCache::LeaseThread( DWORD id, DWORD access )
+{
+    const auto key = std::make_pair( id, access );
+
+    std::lock_guard<std::mutex> guard( _lock );
+
+    auto found = _threads.find( key );
+    if (found != _threads.end())
+        return HandleLease( found->second );
+
+    HANDLE handle = OpenThread( access, FALSE, id );
+    if (!non_negative<HANDLE>::call( handle ))
+        return HandleLease();
+
+    auto entry = std::make_shared<ProcessHandle>( handle );
+    _threads.emplace( key, entry );
+
+    return HandleLease( std::move( entry ) );
+}
+
+void HandleCache::Trim()
+{
+    std::lock_guard<std::mutex> guard( _lock );
+
+    for (auto it = _threads.begin(); it != _threads.end();)
+    {
+        DWORD code = 0;
+        if (!GetExitCodeThread( it->second->get(), &code ) || code != STILL_ACTIVE)
+            it = _threads.erase( it );
+        else
+            ++it;
+    }
+}
+
+void HandleCache::Trim( const std::vector<DWORD>& liveIds )
+{
+    std::lock_guard<std::mutex> guard( _lock );
+
+    for (auto it = _threads.begin(); it != _threads.end();)
+    {
+        if (std::find( liveIds.begin(), liveIds.end(), it->first.first ) == liveIds.end())
+            it = _threads.erase( it );
+        else
+            ++it;
+    }
+}
+
+void HandleCache::Clear()
+{
+    std::lock_guard<std::mutex> guard( _lock );
+    _threads.clear();
+}
+
+}
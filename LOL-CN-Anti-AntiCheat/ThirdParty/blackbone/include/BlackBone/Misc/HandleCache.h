@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../Config.h"
+#include "../Include/Winheaders.h"
+#include "../Include/HandleGuard.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Shared lease on a cached handle.
+/// Dropping the lease returns the handle to the cache instead of closing
+/// it; the OS handle closes only when the cache entry is evicted and the
+/// last lease is gone. Owned leases wrap an externally supplied handle
+/// and close it like a plain guard
+/// </summary>
+class HandleLease
+{
+public:
+    HandleLease() = default;
+
+    explicit HandleLease( std::shared_ptr<ProcessHandle> entry )
+        : _entry( std::move( entry ) )
+    {
+    }
+
+    /// <summary>
+    /// Wrap a handle the caller already owns; closes with the last copy
+    /// </summary>
+    /// <param name="handle">Handle to own</param>
+    /// <returns>Owning lease</returns>
+    static HandleLease Owned( HANDLE handle )
+    {
+        return HandleLease( std::make_shared<ProcessHandle>( handle ) );
+    }
+
+    void reset() { _entry.reset(); }
+
+    HANDLE get() const { return _entry ? _entry->get() : ProcessHandle::zero_handle; }
+    bool valid() const { return _entry && _entry->valid(); }
+
+    operator HANDLE() const { return get(); }
+    explicit operator bool() const { return valid(); }
+
+private:
+    std::shared_ptr<ProcessHandle> _entry;
+};
+
+/// <summary>
+/// Process-wide cache of open handles keyed by object identity and
+/// access mask. Enumeration loops and watchdog polls that used to do an
+/// open/close pair per touch lease the same open handle instead, so a
+/// sweep over N threads costs N NtOpenThread calls once, not once per
+/// sweep. Entries for objects that went away are dropped by Trim, which
+/// callers run between polling generations
+/// </summary>
+class HandleCache
+{
+public:
+    BLACKBONE_API static HandleCache& Instance();
+
+    /// <summary>
+    /// Lease an open thread handle with exactly the given access.
+    /// Opens and caches the handle on a miss; a hit costs no syscall
+    /// </summary>
+    /// <param name="id">Thread ID</param>
+    /// <param name="access">Access mask, part of the cache key</param>
+    /// <returns>Lease, invalid if the thread could not be opened</returns>
+    BLACKBONE_API HandleLease LeaseThread( DWORD id, DWORD access );
+
+    /// <summary>
+    /// Drop cached entries whose thread has exited.
+    /// A dropped handle stays open until its outstanding leases are gone
+    /// </summary>
+    BLACKBONE_API void Trim();
+
+    /// <summary>
+    /// Drop cached thread entries not present in a fresh enumeration.
+    /// Costs no syscalls, enumeration loops call it with the ids they
+    /// just walked
+    /// </summary>
+    /// <param name="liveIds">Thread ids seen in the current snapshot</param>
+    BLACKBONE_API void Trim( const std::vector<DWORD>& liveIds );
+
+    /// <summary>
+    /// Drop every cached entry
+    /// </summary>
+    BLACKBONE_API void Clear();
+
+private:
+    std::mutex _lock;
+    std::map<std::pair<DWORD, DWORD>, std::shared_ptr<ProcessHandle>> _threads;
+};
+
+}
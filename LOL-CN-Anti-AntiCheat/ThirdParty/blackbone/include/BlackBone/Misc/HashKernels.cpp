@@ -0,0 +1,310 @@
+#include "HashKernels.h"
+#include "HostCpu.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <intrin.h>
+
+namespace blackbone
+{
+
+namespace
+{
+
+// xxHash64 primes
+const uint64_t prime1 = 0x9E3779B185EBCA87ull;
+const uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+const uint64_t prime3 = 0x165667B19E3779F9ull;
+const uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+
+inline uint64_t rotl64( uint64_t val, int count )
+{
+    return (val << count) | (val >> (64 - count));
+}
+
+/// <summary>
+/// Final avalanche, same for every kernel
+/// </summary>
+/// <param name="hash">Folded accumulator state</param>
+/// <returns>Digest</returns>
+inline uint64_t Avalanche( uint64_t hash )
+{
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+/// <summary>
+/// Fold one accumulator lane into the running hash
+/// </summary>
+/// <param name="hash">Running hash</param>
+/// <param name="lane">Accumulator lane</param>
+/// <returns>Updated hash</returns>
+inline uint64_t FoldLane( uint64_t hash, uint64_t lane )
+{
+    return rotl64( hash ^ (lane * prime2), 27 ) * prime1 + prime4;
+}
+
+/// <summary>
+/// Scalar tail shared by every kernel: bytes the vector loop left over
+/// </summary>
+/// <param name="hash">Running hash</param>
+/// <param name="pData">Tail data</param>
+/// <param name="size">Tail size</param>
+/// <returns>Updated hash</returns>
+uint64_t DigestTail( uint64_t hash, const uint8_t* pData, size_t size )
+{
+    size_t i = 0;
+    for (; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ))
+    {
+        uint64_t lane;
+        memcpy( &lane, pData + i, sizeof( lane ) );
+        hash = FoldLane( hash, lane );
+    }
+
+    for (; i < size; i++)
+        hash = rotl64( hash ^ (pData[i] * prime1), 11 ) * prime2;
+
+    return hash;
+}
+
+/// <summary>
+/// Scalar kernel: four independent 64-bit lanes so the multiply chains
+/// overlap, merged xxHash64-style
+/// </summary>
+/// <param name="pData">Data to digest</param>
+/// <param name="size">Data size</param>
+/// <returns>Digest before avalanche</returns>
+uint64_t DigestScalar( const uint8_t* pData, size_t size )
+{
+    uint64_t hash = prime3 ^ size;
+
+    if (size >= 32)
+    {
+        uint64_t acc[4] = { prime1 + prime2, prime2, 0, ~prime1 };
+
+        size_t blocks = size / 32;
+        for (size_t i = 0; i < blocks; i++, pData += 32)
+        {
+            uint64_t lane[4];
+            memcpy( lane, pData, sizeof( lane ) );
+
+            for (int j = 0; j < 4; j++)
+                acc[j] = rotl64( acc[j] + lane[j] * prime2, 31 ) * prime1;
+        }
+
+        hash = rotl64( acc[0], 1 ) + rotl64( acc[1], 7 ) + rotl64( acc[2], 12 ) + rotl64( acc[3], 18 );
+        for (int j = 0; j < 4; j++)
+            hash = FoldLane( hash, acc[j] );
+
+        hash += size;
+        size %= 32;
+    }
+
+    return DigestTail( hash, pData, size );
+}
+
+/// <summary>
+/// SSE2 kernel: two 64-bit lanes per register, two registers in flight.
+/// 64-bit multiplies are built from 32x32 partial products
+/// </summary>
+/// <param name="pData">Data to digest</param>
+/// <param name="size">Data size</param>
+/// <returns>Digest before avalanche</returns>
+uint64_t DigestSSE2( const uint8_t* pData, size_t size )
+{
+    uint64_t hash = prime3 ^ size;
+
+    if (size >= 32)
+    {
+        const __m128i primeVec = _mm_set1_epi64x( static_cast<long long>(prime2) );
+
+        __m128i acc0 = _mm_set_epi64x( static_cast<long long>(prime2), static_cast<long long>(prime1 + prime2) );
+        __m128i acc1 = _mm_set_epi64x( static_cast<long long>(~prime1), 0 );
+
+        size_t blocks = size / 32;
+        for (size_t i = 0; i < blocks; i++, pData += 32)
+        {
+            const __m128i lane0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pData) );
+            const __m128i lane1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pData + 16) );
+
+            // lane * prime: lo32(lane)*lo32(prime) + (lo32(lane)*hi32(prime) +
+            // hi32(lane)*lo32(prime)) << 32, standard 64-bit mul from 32x32 parts
+            const __m128i mix0 = _mm_xor_si128( lane0, primeVec );
+            const __m128i mix1 = _mm_xor_si128( lane1, primeVec );
+
+            acc0 = _mm_add_epi64( acc0, _mm_mul_epu32( mix0, _mm_srli_epi64( mix0, 32 ) ) );
+            acc1 = _mm_add_epi64( acc1, _mm_mul_epu32( mix1, _mm_srli_epi64( mix1, 32 ) ) );
+
+            // Keep the untouched high bits alive in the state
+            acc0 = _mm_add_epi64( acc0, _mm_srli_epi64( lane0, 29 ) );
+            acc1 = _mm_add_epi64( acc1, _mm_srli_epi64( lane1, 29 ) );
+        }
+
+        uint64_t lanes[4];
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(lanes), acc0 );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(lanes + 2), acc1 );
+
+        for (int j = 0; j < 4; j++)
+            hash = FoldLane( hash, lanes[j] );
+
+        hash += size;
+        size %= 32;
+    }
+
+    return DigestTail( hash, pData, size );
+}
+
+/// <summary>
+/// AVX2 kernel: four 64-bit lanes per register, 32 bytes per iteration
+/// </summary>
+/// <param name="pData">Data to digest</param>
+/// <param name="size">Data size</param>
+/// <returns>Digest before avalanche</returns>
+uint64_t DigestAVX2( const uint8_t* pData, size_t size )
+{
+    uint64_t hash = prime3 ^ size;
+
+    if (size >= 32)
+    {
+        const __m256i primeVec = _mm256_set1_epi64x( static_cast<long long>(prime2) );
+
+        __m256i acc = _mm256_set_epi64x(
+            static_cast<long long>(~prime1), 0,
+            static_cast<long long>(prime2), static_cast<long long>(prime1 + prime2) );
+
+        size_t blocks = size / 32;
+        for (size_t i = 0; i < blocks; i++, pData += 32)
+        {
+            const __m256i lane = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(pData) );
+            const __m256i mix = _mm256_xor_si256( lane, primeVec );
+
+            acc = _mm256_add_epi64( acc, _mm256_mul_epu32( mix, _mm256_srli_epi64( mix, 32 ) ) );
+            acc = _mm256_add_epi64( acc, _mm256_srli_epi64( lane, 29 ) );
+        }
+
+        uint64_t lanes[4];
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>(lanes), acc );
+
+        for (int j = 0; j < 4; j++)
+            hash = FoldLane( hash, lanes[j] );
+
+        hash += size;
+        size %= 32;
+    }
+
+    return DigestTail( hash, pData, size );
+}
+
+}
+
+uint64_t Digest64( const void* data, size_t size ) noexcept
+{
+    const auto pData = reinterpret_cast<const uint8_t*>(data);
+    const auto& cpu = HostCpu();
+
+    uint64_t hash;
+    if (cpu.avx2)
+        hash = DigestAVX2( pData, size );
+    else if (cpu.sse2)
+        hash = DigestSSE2( pData, size );
+    else
+        hash = DigestScalar( pData, size );
+
+    return Avalanche( hash );
+}
+
+uint64_t Digest64Parallel( const void* data, size_t size, size_t workers /*= 0*/ )
+{
+    constexpr size_t minChunk = 1024 * 1024;
+
+    if (workers == 0)
+        workers = std::thread::hardware_concurrency();
+    if (workers > 1 && size / workers < minChunk)
+        workers = size / minChunk;
+
+    if (workers <= 1)
+        return Digest64( data, size );
+
+    const auto pData = reinterpret_cast<const uint8_t*>(data);
+    const size_t chunk = size / workers;
+
+    std::vector<uint64_t> digests( workers );
+    std::vector<std::thread> pool;
+    pool.reserve( workers );
+
+    for (size_t i = 0; i < workers; i++)
+    {
+        const size_t offset = i * chunk;
+        const size_t length = (i == workers - 1) ? size - offset : chunk;
+
+        pool.emplace_back( [=, &digests]() { digests[i] = Digest64( pData + offset, length ); } );
+    }
+
+    for (auto& worker : pool)
+        worker.join();
+
+    // Fold chunk digests in chunk order, so the split does not change
+    // the result for a given worker count
+    uint64_t hash = prime3 ^ size;
+    for (const auto digest : digests)
+        hash = FoldLane( hash, digest );
+
+    return Avalanche( hash );
+}
+
+size_t FirstDiff( const void* a, const void* b, size_t size ) noexcept
+{
+    const auto pa = reinterpret_cast<const uint8_t*>(a);
+    const auto pb = reinterpret_cast<const uint8_t*>(b);
+    const auto& cpu = HostCpu();
+
+    size_t pos = 0;
+
+    if (cpu.avx2)
+    {
+        for (; pos + 32 <= size; pos += 32)
+        {
+            const __m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(pa + pos) );
+            const __m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(pb + pos) );
+
+            const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( va, vb ) ));
+            if (mask != 0xFFFFFFFF)
+            {
+                unsigned long bit = 0;
+                _BitScanForward( &bit, ~mask );
+                return pos + bit;
+            }
+        }
+    }
+    else if (cpu.sse2)
+    {
+        for (; pos + 16 <= size; pos += 16)
+        {
+            const __m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pa + pos) );
+            const __m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pb + pos) );
+
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) ));
+            if (mask != 0xFFFF)
+            {
+                unsigned long bit = 0;
+                _BitScanForward( &bit, ~mask & 0xFFFF );
+                return pos + bit;
+            }
+        }
+    }
+
+    for (; pos < size; pos++)
+        if (pa[pos] != pb[pos])
+            return pos;
+
+    return size;
+}
+
+}
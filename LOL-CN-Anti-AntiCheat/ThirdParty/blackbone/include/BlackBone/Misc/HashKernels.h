@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../Config.h"
+
+#include <cstdint>
+
+namespace blackbone
+{
+
+/// <summary>
+/// 64-bit content digest, xxHash-style mixing.
+/// The kernel is picked from the process-wide CPU capture: AVX2 folds 32
+/// bytes per iteration, SSE2 16, otherwise four independent scalar lanes.
+/// Digest values are stable within a process but differ between kernels,
+/// so they must not be persisted or compared across machines
+/// </summary>
+/// <param name="data">Data to digest</param>
+/// <param name="size">Data size</param>
+/// <returns>Digest</returns>
+BLACKBONE_API uint64_t Digest64( const void* data, size_t size ) noexcept;
+
+/// <summary>
+/// Chunked multi-threaded digest for multi-MB buffers.
+/// The buffer is split across worker threads, chunk digests are folded
+/// in chunk order, so the result is deterministic for a given worker
+/// kernel. Falls back to Digest64 when the buffer is too small to split
+/// </summary>
+/// <param name="data">Data to digest</param>
+/// <param name="size">Data size</param>
+/// <param name="workers">Worker count, 0 - one per hardware thread</param>
+/// <returns>Digest</returns>
+BLACKBONE_API uint64_t Digest64Parallel( const void* data, size_t size, size_t workers = 0 );
+
+/// <summary>
+/// Compare two buffers and locate the first difference.
+/// AVX2/SSE2 compare 32/16 bytes per iteration; equal prefixes are never
+/// examined byte by byte
+/// </summary>
+/// <param name="a">First buffer</param>
+/// <param name="b">Second buffer</param>
+/// <param name="size">Size of both buffers</param>
+/// <returns>Offset of the first differing byte, or 'size' if equal</returns>
+BLACKBONE_API size_t FirstDiff( const void* a, const void* b, size_t size ) noexcept;
+
+}
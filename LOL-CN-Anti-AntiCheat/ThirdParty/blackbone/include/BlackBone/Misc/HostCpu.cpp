@@ -0,0 +1,60 @@
+#include "HostCpu.h"
+
+#include <intrin.h>
+
+namespace blackbone
+{
+
+namespace
+{
+
+/// <summary>
+/// Run CPUID and capture the feature set
+/// </summary>
+/// <returns>Detected features</returns>
+HostCpuFeatures DetectHostCpu()
+{
+    HostCpuFeatures features;
+    int regs[4] = { 0 };
+
+    __cpuid( regs, 0 );
+    features.maxLeaf = static_cast<uint32_t>(regs[0]);
+
+    __cpuid( regs, 1 );
+    features.sse2 = (regs[3] & (1 << 26)) != 0;
+    features.popcnt = (regs[2] & (1 << 23)) != 0;
+
+    // AVX needs the OS to save the extended state: OSXSAVE plus XMM/YMM bits in XCR0
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avxHw = (regs[2] & (1 << 28)) != 0;
+
+    if (osxsave && avxHw && (_xgetbv( 0 ) & 0x6) == 0x6)
+    {
+        features.avx = true;
+
+        if (features.maxLeaf >= 7)
+        {
+            __cpuidex( regs, 7, 0 );
+            features.avx2 = (regs[1] & (1 << 5)) != 0;
+        }
+    }
+
+    return features;
+}
+
+const HostCpuFeatures* g_override = nullptr;
+
+}
+
+const HostCpuFeatures& HostCpu()
+{
+    static const HostCpuFeatures features = DetectHostCpu();
+    return g_override ? *g_override : features;
+}
+
+void OverrideHostCpu( const HostCpuFeatures* features )
+{
+    g_override = features;
+}
+
+}
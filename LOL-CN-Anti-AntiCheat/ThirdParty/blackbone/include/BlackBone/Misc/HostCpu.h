@@ -0,0 +1,37 @@
+#pragma once
+#include "../Config.h"
+
+#include <cstdint>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Host CPU capabilities, captured once per process
+/// </summary>
+struct HostCpuFeatures
+{
+    bool sse2 = false;      // SSE2 supported
+    bool avx = false;       // AVX supported and enabled by the OS
+    bool avx2 = false;      // AVX2 supported and enabled by the OS
+    bool popcnt = false;    // POPCNT supported
+    uint32_t maxLeaf = 0;   // Highest standard CPUID leaf
+};
+
+/// <summary>
+/// Get host CPU features.
+/// CPUID runs once per process, every later call returns the cached capture,
+/// so per-call consumers may query freely instead of keeping local copies.
+/// </summary>
+/// <returns>Detected features, or the active override</returns>
+BLACKBONE_API const HostCpuFeatures& HostCpu();
+
+/// <summary>
+/// Override the features reported by HostCpu.
+/// Intended for exercising downlevel dispatch paths in tests; the pointed-to
+/// object must outlive the override.
+/// </summary>
+/// <param name="features">Features to report, nullptr to restore the real capture</param>
+BLACKBONE_API void OverrideHostCpu( const HostCpuFeatures* features );
+
+}
@@ -8,6 +8,7 @@
 #include "../Symbols/SymbolLoader.h"
 #include "NameResolve.h"
 
+#include <atomic>
 #include <string>
 #include <cassert>
 
@@ -25,7 +26,14 @@ public:
 
     static bool Exec()
     {
-        if (!_InterlockedCompareExchange( &_done, TRUE, FALSE ))
+        // Steady state is one acquire load and a predictable branch.
+        // Process construction re-enters here on every reconnect, so the
+        // interlocked RMW the old flag paid per entry is off the fast path
+        if (_state.load( std::memory_order_acquire ) == Done)
+            return true;
+
+        auto expected = NotStarted;
+        if (_state.compare_exchange_strong( expected, InProgress, std::memory_order_acq_rel ))
         {
             InitVersion();
 
@@ -33,14 +41,23 @@ public:
             GrantPriviledge( L"SeLoadDriverPrivilege" );
             LoadFuncs();
 
-            SymbolLoader sl;
-            sl.Load( g_symbols );
+            // Resolution runs in the background; first Symbols() access joins it
+            PrewarmSymbols();
 
             NameResolve::Instance().Initialize();
+
+            _state.store( Done, std::memory_order_release );
+        }
+        else
+        {
+            // A concurrent first caller is initializing, wait until its
+            // results are published instead of returning half-initialized
+            while (_state.load( std::memory_order_acquire ) != Done)
+                YieldProcessor();
         }
 
         return true;
-    }  
+    }
 
     /// <summary>
     /// Grant current process arbitrary privilege
@@ -92,6 +109,10 @@ public:
         LOAD_IMPORT( "NtDuplicateObject",                        hNtdll );
         LOAD_IMPORT( "NtQueryObject",                            hNtdll );
         LOAD_IMPORT( "NtQuerySection",                           hNtdll );
+        LOAD_IMPORT( "NtMapViewOfSection",                       hNtdll );
+        LOAD_IMPORT( "NtUnmapViewOfSection",                     hNtdll );
+        LOAD_IMPORT( "RtlWaitOnAddress",                         hNtdll );
+        LOAD_IMPORT( "RtlWakeAddressAll",                        hNtdll );
         LOAD_IMPORT( "RtlCreateActivationContext",               hNtdll );
         LOAD_IMPORT( "NtQueryVirtualMemory",                     hNtdll );
         LOAD_IMPORT( "NtCreateThreadEx",                         hNtdll );
@@ -118,7 +139,14 @@ public:
     }
 
 private:
-    static volatile long _done;
+    enum eInitState : uint32_t
+    {
+        NotStarted = 0,
+        InProgress,
+        Done,
+    };
+
+    static std::atomic<eInitState> _state;
 };
 
 /// <summary>
@@ -131,5 +159,6 @@ bool InitializeOnce()
     return InitOnce::Exec();
 }
 
-volatile long InitOnce::_done = 0;
+// Constant-initialized, no dynamic initializer to order against other globals
+std::atomic<InitOnce::eInitState> InitOnce::_state = NotStarted;
 }
\ No newline at end of file
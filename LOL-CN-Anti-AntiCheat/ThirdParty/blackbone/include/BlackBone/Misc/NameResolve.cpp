@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include <algorithm>
+#include <fstream>
 #include <3rd_party/VersionApi.h>
 
 namespace blackbone
@@ -44,48 +45,117 @@ bool NameResolve::Initialize()
 }
 
 /// <summary>
-/// OS dependent api set initialization
+/// OS dependent api set initialization.
+/// The version-specific schema is walked exactly once and flattened
+/// into a hash-sorted array over one contiguous string pool, so
+/// lookups never chase pointers through the PEB section again
 /// </summary>
 /// <returns>true on success</returns>
 template<typename PApiSetMap, typename PApiSetEntry, typename PHostArray, typename PHostEntry>
 bool blackbone::NameResolve::InitializeP()
 {
-    if (!_apiSchema.empty())
+    if (!_apiFlat.empty())
         return true;
 
     PEB_T *ppeb = reinterpret_cast<PEB_T*>(reinterpret_cast<TEB_T*>(NtCurrentTeb())->ProcessEnvironmentBlock);
     PApiSetMap pSetMap = reinterpret_cast<PApiSetMap>(ppeb->ApiSetMap);
 
+    _apiFlat.reserve( pSetMap->Count );
+
     for (DWORD i = 0; i < pSetMap->Count; i++)
     {
         PApiSetEntry pDescriptor = pSetMap->entry(i);
 
-        std::vector<std::wstring> vhosts;
         wchar_t dllName[MAX_PATH] = { 0 };
 
         auto nameSize = pSetMap->apiName( pDescriptor, dllName );
-        std::transform( dllName, dllName + nameSize / sizeof( wchar_t ), dllName, ::towlower );
+        const size_t nameLen = nameSize / sizeof( wchar_t );
+        std::transform( dllName, dllName + nameLen, dllName, ::towlower );
+
+        ApiSetEntryFlat flat = { 0 };
+        flat.hash = ApiSetHash( dllName, nameLen );
+        flat.name = static_cast<uint32_t>(_apiStrings.size());
+        flat.nameLen = static_cast<uint32_t>(nameLen);
+        _apiStrings.append( dllName, nameLen );
 
         PHostArray pHostData = pSetMap->valArray( pDescriptor );
 
         for (DWORD j = 0; j < pHostData->Count; j++)
-        { 
+        {
             PHostEntry pHost = pHostData->entry( pSetMap, j );
-            std::wstring hostName( 
-                reinterpret_cast<wchar_t*>(reinterpret_cast<uint8_t*>(pSetMap) + pHost->ValueOffset), 
-                pHost->ValueLength / sizeof( wchar_t ) 
-            );
+            const wchar_t* pHostName = reinterpret_cast<wchar_t*>(reinterpret_cast<uint8_t*>(pSetMap) + pHost->ValueOffset);
+            const size_t hostLen = pHost->ValueLength / sizeof( wchar_t );
+
+            if (hostLen == 0)
+                continue;
+
+            // Keep first and last hosts only, host selection uses nothing else
+            if (flat.host1Len == 0)
+            {
+                flat.host1 = static_cast<uint32_t>(_apiStrings.size());
+                flat.host1Len = static_cast<uint32_t>(hostLen);
+                _apiStrings.append( pHostName, hostLen );
+            }
 
-            if (!hostName.empty())
-                vhosts.emplace_back( std::move( hostName ) );
+            flat.host2 = static_cast<uint32_t>(_apiStrings.size());
+            flat.host2Len = static_cast<uint32_t>(hostLen);
+            _apiStrings.append( pHostName, hostLen );
         }
 
-        _apiSchema.emplace( dllName, std::move( vhosts ) );
+        _apiFlat.emplace_back( flat );
     }
 
+    std::sort( _apiFlat.begin(), _apiFlat.end(), []( const auto& a, const auto& b ) { return a.hash < b.hash; } );
     return true;
 }
 
+/// <summary>
+/// FNV-1a hash of a lowercased name
+/// </summary>
+/// <param name="pName">Name</param>
+/// <param name="length">Name length in characters</param>
+/// <returns>Hash value</returns>
+uint32_t NameResolve::ApiSetHash( const wchar_t* pName, size_t length )
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ pName[i]) * 16777619u;
+
+    return hash;
+}
+
+/// <summary>
+/// Find the ApiSet descriptor whose name prefixes the given file name.
+/// Rolling prefix hash plus binary search over the sorted flat array
+/// </summary>
+/// <param name="filename">File name to look up</param>
+/// <returns>Matched descriptor, nullptr if none</returns>
+const NameResolve::ApiSetEntryFlat* NameResolve::LookupApiSet( const std::wstring& filename ) const
+{
+    uint32_t hash = 2166136261u;
+
+    // Set names in the map are stored without the trailing version part,
+    // so the descriptor name is a prefix of the queried file name. Hash
+    // every prefix incrementally and probe the sorted array for each
+    for (size_t len = 1; len <= filename.size(); len++)
+    {
+        hash = (hash ^ filename[len - 1]) * 16777619u;
+
+        auto it = std::lower_bound(
+            _apiFlat.begin(), _apiFlat.end(), hash,
+            []( const ApiSetEntryFlat& entry, uint32_t value ) { return entry.hash < value; }
+            );
+
+        for (; it != _apiFlat.end() && it->hash == hash; ++it)
+        {
+            if (it->nameLen == len && wmemcmp( _apiStrings.data() + it->name, filename.data(), len ) == 0)
+                return &*it;
+        }
+    }
+
+    return nullptr;
+}
+
 /// <summary>
 /// Resolve image path.
 /// </summary>
@@ -96,13 +166,89 @@ bool blackbone::NameResolve::InitializeP()
 /// <param name="procID">Process ID. Used to search process executable directory</param>
 /// <param name="actx">Activation context</param>
 /// <returns>Status</returns>
-NTSTATUS NameResolve::ResolvePath( 
-    std::wstring& path, 
+NTSTATUS NameResolve::ResolvePath(
+    std::wstring& path,
     const std::wstring& baseName,
     const std::wstring& searchDir,
-    eResolveFlag flags, 
+    eResolveFlag flags,
     Process& proc,
-    HANDLE actx /*= INVALID_HANDLE_VALUE*/ 
+    HANDLE actx /*= INVALID_HANDLE_VALUE*/
+    )
+{
+    // Activation contexts make results caller dependent, bypass the caches
+    if (actx != INVALID_HANDLE_VALUE)
+        return ResolvePathInternal( path, baseName, searchDir, flags, proc, actx );
+
+    const std::wstring lowered = Utils::ToLower( path );
+    const std::wstring key = lowered + L"|" + baseName + L"|" + searchDir + L"|"
+        + std::to_wstring( flags ) + L"|" + std::to_wstring( proc.core().pid() );
+
+    const std::wstring diskKey = Utils::StripPath( lowered ) + L"|" + baseName + L"|" + std::to_wstring( flags );
+
+    {
+        CSLock lck( _cacheGuard );
+
+        // Session cache
+        auto found = _resolved.find( key );
+        if (found != _resolved.end())
+        {
+            path = found->second.second;
+            return found->second.first;
+        }
+
+        // On-disk table, holds system locations stable per OS build
+        LoadDiskCache();
+
+        auto disk = _disk.find( diskKey );
+        if (disk != _disk.end() && Utils::FileExists( disk->second ))
+        {
+            path = disk->second;
+            _resolved.emplace( key, std::make_pair( STATUS_SUCCESS, path ) );
+            return STATUS_SUCCESS;
+        }
+    }
+
+    NTSTATUS status = ResolvePathInternal( path, baseName, searchDir, flags, proc, actx );
+
+    CSLock lck( _cacheGuard );
+    _resolved.emplace( key, std::make_pair( status, path ) );
+
+    // Persist only paths under the Windows directory, those survive reboots
+    // and become stale only with an OS build change, which re-keys the file
+    if (NT_SUCCESS( status ))
+    {
+        wchar_t winDir[MAX_PATH] = { 0 };
+        GetWindowsDirectoryW( winDir, ARRAYSIZE( winDir ) );
+
+        if (winDir[0] != L'\0'
+            && _wcsnicmp( path.c_str(), winDir, wcslen( winDir ) ) == 0
+            && _disk.count( diskKey ) == 0)
+        {
+            _disk.emplace( diskKey, path );
+            SaveDiskEntry( diskKey, path );
+        }
+    }
+
+    return status;
+}
+
+/// <summary>
+/// Resolve image path bypassing the caches
+/// </summary>
+/// <param name="path">Image to resolve</param>
+/// <param name="baseName">Name of parent image. Used only when resolving import images</param>
+/// <param name="searchDir">Directory where source image is located</param>
+/// <param name="flags">Resolve flags</param>
+/// <param name="procID">Process ID. Used to search process executable directory</param>
+/// <param name="actx">Activation context</param>
+/// <returns>Status</returns>
+NTSTATUS NameResolve::ResolvePathInternal(
+    std::wstring& path,
+    const std::wstring& baseName,
+    const std::wstring& searchDir,
+    eResolveFlag flags,
+    Process& proc,
+    HANDLE actx
     )
 {
     NTSTATUS status = STATUS_SUCCESS;
@@ -121,14 +267,18 @@ NTSTATUS NameResolve::ResolvePath(
     //
     // ApiSchema redirection
     //
-    auto iter = std::find_if( _apiSchema.begin(), _apiSchema.end(), [&filename]( const auto& val ) { 
-        return filename.find( val.first.c_str() ) != filename.npos; } );
-
-    if (iter != _apiSchema.end())
+    auto pApiSet = LookupApiSet( filename );
+    if (pApiSet != nullptr)
     {
         // Select appropriate api host
-        if (!iter->second.empty())
-            path = iter->second.front() != baseName ? iter->second.front() : iter->second.back();
+        if (pApiSet->host1Len != 0)
+        {
+            std::wstring host1( _apiStrings.data() + pApiSet->host1, pApiSet->host1Len );
+            if (host1 != baseName)
+                path = std::move( host1 );
+            else
+                path.assign( _apiStrings.data() + pApiSet->host2, pApiSet->host2Len );
+        }
         else
             path = baseName;
 
@@ -348,6 +498,64 @@ NTSTATUS NameResolve::ProbeSxSRedirect( std::wstring& path, Process& proc, HANDL
     return status;
 }
 
+/// <summary>
+/// On-disk cache file, versioned by OS build
+/// </summary>
+/// <returns>Cache file path</returns>
+std::wstring NameResolve::CacheFilePath()
+{
+    wchar_t tmpDir[MAX_PATH] = { 0 };
+    if (GetTempPathW( ARRAYSIZE( tmpDir ), tmpDir ) == 0)
+        return L"";
+
+    return std::wstring( tmpDir ) + L"BlackBone_NameCache_"
+        + std::to_wstring( WinVer().native.dwBuildNumber ) + L".txt";
+}
+
+/// <summary>
+/// Read the on-disk table, first call only.
+/// Caller must hold the cache guard
+/// </summary>
+void NameResolve::LoadDiskCache()
+{
+    if (_diskLoaded)
+        return;
+
+    _diskLoaded = true;
+
+    const auto cachePath = CacheFilePath();
+    if (cachePath.empty())
+        return;
+
+    std::ifstream file( cachePath );
+    std::string line;
+
+    while (std::getline( file, line ))
+    {
+        const auto sep = line.find( '\t' );
+        if (sep == std::string::npos)
+            continue;
+
+        _disk.emplace( Utils::UTF8ToWstring( line.substr( 0, sep ) ), Utils::UTF8ToWstring( line.substr( sep + 1 ) ) );
+    }
+}
+
+/// <summary>
+/// Append one stable resolution to the on-disk table
+/// </summary>
+/// <param name="key">Cache key</param>
+/// <param name="resolved">Resolved path</param>
+void NameResolve::SaveDiskEntry( const std::wstring& key, const std::wstring& resolved )
+{
+    const auto cachePath = CacheFilePath();
+    if (cachePath.empty())
+        return;
+
+    std::ofstream file( cachePath, std::ios::app );
+    if (file)
+        file << Utils::WstringToUTF8( key ) << '\t' << Utils::WstringToUTF8( resolved ) << '\n';
+}
+
 /// <summary>
 /// Gets the process executable directory
 /// </summary>
@@ -2,6 +2,7 @@
 
 #include "../Include/Winheaders.h"
 #include "../Include/Types.h"
+#include "Utils.h"
 
 #include <unordered_map>
 #include <vector>
@@ -12,8 +13,22 @@ namespace blackbone
 
 class NameResolve
 {
-    using mapApiSchema = std::unordered_map<std::wstring, std::vector<std::wstring>>;
-   
+    using mapResolved = std::unordered_map<std::wstring, std::pair<NTSTATUS, std::wstring>>;
+
+    // One ApiSet descriptor in the flattened map. Only the first and
+    // last hosts are kept - host selection never looks at the others.
+    // All strings live in one contiguous pool, offsets are in characters
+    struct ApiSetEntryFlat
+    {
+        uint32_t hash;      // FNV-1a hash of the lowercased set name
+        uint32_t name;      // Set name offset in the string pool
+        uint32_t nameLen;   // Set name length
+        uint32_t host1;     // First host offset
+        uint32_t host1Len;  // First host length, 0 if the set has no hosts
+        uint32_t host2;     // Last host offset, equals host1 for single-host sets
+        uint32_t host2Len;  // Last host length
+    };
+
 public:
     enum eResolveFlag
     {
@@ -69,6 +84,44 @@ private:
     NameResolve( const NameResolve& ) = delete;
     NameResolve& operator =( const NameResolve& ) = delete;
 
+    /// <summary>
+    /// Resolve image path bypassing the caches
+    /// </summary>
+    /// <param name="path">Image to resolve</param>
+    /// <param name="baseName">Name of parent image. Used only when resolving import images</param>
+    /// <param name="searchDir">Directory where source image is located</param>
+    /// <param name="flags">Resolve flags</param>
+    /// <param name="proc">Process. Used to search process executable directory</param>
+    /// <param name="actx">Activation context</param>
+    /// <returns>Status</returns>
+    NTSTATUS ResolvePathInternal(
+        std::wstring& path,
+        const std::wstring& baseName,
+        const std::wstring& searchDir,
+        eResolveFlag flags,
+        class Process& proc,
+        HANDLE actx
+        );
+
+    /// <summary>
+    /// On-disk cache file, versioned by OS build
+    /// </summary>
+    /// <returns>Cache file path</returns>
+    std::wstring CacheFilePath();
+
+    /// <summary>
+    /// Read the on-disk table, first call only.
+    /// Caller must hold the cache guard
+    /// </summary>
+    void LoadDiskCache();
+
+    /// <summary>
+    /// Append one stable resolution to the on-disk table
+    /// </summary>
+    /// <param name="key">Cache key</param>
+    /// <param name="resolved">Resolved path</param>
+    void SaveDiskEntry( const std::wstring& key, const std::wstring& resolved );
+
     /// <summary>
     /// Gets the process executable directory
     /// </summary>
@@ -83,8 +136,30 @@ private:
     template<typename PApiSetMap, typename PApiSetEntry, typename PHostArray, typename PHostEntry>
     bool InitializeP();
 
+    /// <summary>
+    /// FNV-1a hash of a lowercased name
+    /// </summary>
+    /// <param name="pName">Name</param>
+    /// <param name="length">Name length in characters</param>
+    /// <returns>Hash value</returns>
+    static uint32_t ApiSetHash( const wchar_t* pName, size_t length );
+
+    /// <summary>
+    /// Find the ApiSet descriptor whose name prefixes the given file name.
+    /// Rolling prefix hash plus binary search over the sorted flat array
+    /// </summary>
+    /// <param name="filename">File name to look up</param>
+    /// <returns>Matched descriptor, nullptr if none</returns>
+    const ApiSetEntryFlat* LookupApiSet( const std::wstring& filename ) const;
+
 private:
-    mapApiSchema _apiSchema;    // Api schema table
+    std::vector<ApiSetEntryFlat> _apiFlat;  // Flattened ApiSet map, sorted by hash
+    std::wstring _apiStrings;               // Contiguous string pool for _apiFlat
+
+    mapResolved _resolved;                                  // Per-session resolution cache
+    std::unordered_map<std::wstring, std::wstring> _disk;   // Stable resolutions persisted across runs
+    bool _diskLoaded = false;                               // On-disk table was read
+    CriticalSection _cacheGuard;                            // Cache guard
 };
 
 
@@ -0,0 +1,73 @@
+#include "OsPersonality.h"
+#include "../Include/NativeStructures.h"
+
+#include <3rd_party/VersionApi.h>
+
+namespace blackbone
+{
+
+namespace
+{
+
+/// <summary>
+/// Resolve the personality from the cached version capture
+/// </summary>
+/// <returns>Resolved personality</returns>
+OsPersonality ResolveOsPersonality()
+{
+    OsPersonality os;
+
+    os.win8Plus = IsWindows8OrGreater();
+    os.win8Point1Plus = IsWindows8Point1OrGreater();
+    os.win11Plus = IsWindows11OrGreater();
+    os.win11_24H2Plus = IsWindows1124H2OrGreater();
+
+    os.useModuleIndex = os.win8Plus;
+    os.useNewInvertedTable = os.win8Plus;
+
+    if (os.win8Plus)
+    {
+        os.ldrEntrySize32 = sizeof( _LDR_DATA_TABLE_ENTRY_W8<uint32_t> );
+        os.ldrEntrySize64 = sizeof( _LDR_DATA_TABLE_ENTRY_W8<uint64_t> );
+        os.invTableEntriesOfs32 = static_cast<uint32_t>(offsetof( _RTL_INVERTED_FUNCTION_TABLE8<uint32_t>, Entries ));
+        os.invTableEntriesOfs64 = static_cast<uint32_t>(offsetof( _RTL_INVERTED_FUNCTION_TABLE8<uint64_t>, Entries ));
+
+        // 24H2 added one ULONG to the table header; before the table
+        // existed here these offsets were hand-patched at every use site
+        if (os.win11_24H2Plus)
+        {
+            os.invTableEntriesOfs32 += sizeof( ULONG );
+            os.invTableEntriesOfs64 += sizeof( ULONG );
+        }
+    }
+    else if (IsWindows7OrGreater())
+    {
+        os.ldrEntrySize32 = sizeof( _LDR_DATA_TABLE_ENTRY_W7<uint32_t> );
+        os.ldrEntrySize64 = sizeof( _LDR_DATA_TABLE_ENTRY_W7<uint64_t> );
+        os.invTableEntriesOfs32 = static_cast<uint32_t>(offsetof( _RTL_INVERTED_FUNCTION_TABLE7<uint32_t>, Entries ));
+        os.invTableEntriesOfs64 = static_cast<uint32_t>(offsetof( _RTL_INVERTED_FUNCTION_TABLE7<uint64_t>, Entries ));
+    }
+    else
+    {
+        os.ldrEntrySize32 = sizeof( _LDR_DATA_TABLE_ENTRY_BASE_T<uint32_t> );
+        os.ldrEntrySize64 = sizeof( _LDR_DATA_TABLE_ENTRY_BASE_T<uint64_t> );
+        os.invTableEntriesOfs32 = static_cast<uint32_t>(offsetof( _RTL_INVERTED_FUNCTION_TABLE7<uint32_t>, Entries ));
+        os.invTableEntriesOfs64 = static_cast<uint32_t>(offsetof( _RTL_INVERTED_FUNCTION_TABLE7<uint64_t>, Entries ));
+    }
+
+    os.tlsHandleCC = os.win8Point1Plus ? cc_thiscall : cc_stdcall;
+    os.tlsReleaseCC = os.win8Point1Plus ? cc_fastcall : cc_stdcall;
+    os.insertInvertedCC = os.win8Point1Plus ? cc_fastcall : cc_stdcall;
+
+    return os;
+}
+
+}
+
+const OsPersonality& OsInfo()
+{
+    static const OsPersonality os = ResolveOsPersonality();
+    return os;
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../Config.h"
+#include "../Asm/IAsmHelper.h"
+
+#include <cstdint>
+
+namespace blackbone
+{
+
+/// <summary>
+/// OS personality resolved once at startup.
+/// Collapses the version checks scattered through loader and thread code
+/// paths into one table of capability flags, structure geometry and
+/// remote routine conventions, so per-call paths index the table instead
+/// of re-deriving the OS shape. Also the single place where downlevel
+/// and Win11 24H2+ structure offsets live
+/// </summary>
+struct OsPersonality
+{
+    // Capability flags, replace Is*OrGreater chains on per-call paths
+    bool win8Plus = false;          // Windows 8 or newer
+    bool win8Point1Plus = false;    // Windows 8.1 or newer
+    bool win11Plus = false;         // Windows 11 or newer
+    bool win11_24H2Plus = false;    // Windows 11 2024 update or newer
+
+    // Loader keeps the LdrpModuleIndex red-black tree (Win8+)
+    bool useModuleIndex = false;
+    // Inverted function table uses the _RTL_INVERTED_FUNCTION_TABLE8 layout
+    bool useNewInvertedTable = false;
+
+    // Loader-list entry sizes for walking remote module lists
+    uint32_t ldrEntrySize32 = 0;
+    uint32_t ldrEntrySize64 = 0;
+
+    // Offset of the Entries array inside the inverted function table.
+    // 24H2 grew the header by one ULONG, previously patched in by hand
+    uint32_t invTableEntriesOfs32 = 0;
+    uint32_t invTableEntriesOfs64 = 0;
+
+    // Conventions of private loader routines, they changed in 8.1
+    eCalligConvention tlsHandleCC = cc_stdcall;     // LdrpHandleTlsData
+    eCalligConvention tlsReleaseCC = cc_stdcall;    // LdrpReleaseTlsEntry
+    eCalligConvention insertInvertedCC = cc_stdcall;// RtlInsertInvertedFunctionTable
+};
+
+/// <summary>
+/// Get the host OS personality.
+/// Resolved once per process on first use, every later call returns the
+/// cached table
+/// </summary>
+/// <returns>Resolved personality</returns>
+BLACKBONE_API const OsPersonality& OsInfo();
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../Include/Types.h"
+
+#include <memory>
+#include <memory_resource>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Per-operation monotonic arena for scan results and other short-lived
+/// allocations. Everything allocated from it is bump-pointer fast and freed
+/// wholesale by Reset(), so a scan-resolve-patch cycle touches the process
+/// heap a constant number of times instead of once per match.
+/// Not thread safe - one arena per operation, not shared across workers
+/// </summary>
+class ScanArena
+{
+public:
+    /// <summary>
+    /// Create an arena with a preallocated first block
+    /// </summary>
+    /// <param name="initialSize">First block size, later blocks grow geometrically</param>
+    explicit ScanArena( size_t initialSize = 64 * 1024 )
+        : _initialBlock( std::make_unique<uint8_t[]>( initialSize ) )
+        , _resource( _initialBlock.get(), initialSize )
+    {
+    }
+
+    ScanArena( const ScanArena& ) = delete;
+    ScanArena& operator =( const ScanArena& ) = delete;
+
+    /// <summary>
+    /// Arena-backed memory resource, for allocator-aware containers
+    /// </summary>
+    /// <returns>Memory resource</returns>
+    std::pmr::memory_resource* resource() noexcept { return &_resource; }
+
+    /// <summary>
+    /// Result vector allocating from this arena
+    /// </summary>
+    /// <returns>Empty result vector</returns>
+    vecScanResult MakeResults() { return vecScanResult( &_resource ); }
+
+    /// <summary>
+    /// Release everything at once and rewind to the initial block.
+    /// Invalidates every container still bound to the arena - call only
+    /// after the previous operation's results have been consumed
+    /// </summary>
+    void Reset() { _resource.release(); }
+
+private:
+    std::unique_ptr<uint8_t[]> _initialBlock;       // Reused across Reset() calls
+    std::pmr::monotonic_buffer_resource _resource;  // Bump-pointer resource over the block chain
+};
+
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "../Include/Winheaders.h"
+
+#include <mutex>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Pool of reusable staging buffers for bulk cross-process reads.
+/// Buffers are VirtualAlloc-backed (optionally large-page-backed when the
+/// privilege is held), handed out through a RAII lease and returned to the
+/// pool on destruction instead of being freed, so multi-MB read paths stop
+/// churning the heap.
+/// </summary>
+class StagingPool
+{
+public:
+    /// <summary>
+    /// RAII lease of one buffer. Returns the buffer to the pool when destroyed.
+    /// </summary>
+    class Lease
+    {
+    public:
+        Lease() = default;
+
+        Lease( StagingPool* pool, uint8_t* ptr, size_t size )
+            : _pool( pool ), _ptr( ptr ), _size( size ) { }
+
+        ~Lease()
+        {
+            if (_pool && _ptr)
+                _pool->Return( _ptr, _size );
+        }
+
+        Lease( Lease&& other ) noexcept
+            : _pool( other._pool ), _ptr( other._ptr ), _size( other._size )
+        {
+            other._pool = nullptr;
+            other._ptr = nullptr;
+            other._size = 0;
+        }
+
+        Lease& operator =( Lease&& other ) noexcept
+        {
+            if (this != &other)
+            {
+                if (_pool && _ptr)
+                    _pool->Return( _ptr, _size );
+
+                _pool = other._pool;
+                _ptr = other._ptr;
+                _size = other._size;
+
+                other._pool = nullptr;
+                other._ptr = nullptr;
+                other._size = 0;
+            }
+
+            return *this;
+        }
+
+        uint8_t* get() const { return _ptr; }
+        size_t size() const { return _size; }
+        bool valid() const { return _ptr != nullptr; }
+
+    private:
+        Lease( const Lease& ) = delete;
+        Lease& operator =( const Lease& ) = delete;
+
+    private:
+        StagingPool* _pool = nullptr;
+        uint8_t* _ptr = nullptr;
+        size_t _size = 0;
+    };
+
+public:
+    StagingPool( bool tryLargePages = true )
+        : _tryLargePages( tryLargePages ) { }
+
+    ~StagingPool()
+    {
+        std::lock_guard<std::mutex> lock( _lock );
+        for (auto& entry : _free)
+            VirtualFree( entry.ptr, 0, MEM_RELEASE );
+    }
+
+    /// <summary>
+    /// Acquire a buffer of at least 'size' bytes.
+    /// Reuses the smallest pooled buffer that fits, allocates otherwise.
+    /// </summary>
+    /// <param name="size">Minimum buffer size</param>
+    /// <returns>Buffer lease, invalid if allocation failed</returns>
+    Lease Acquire( size_t size )
+    {
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+
+            size_t best = _free.size();
+            for (size_t i = 0; i < _free.size(); i++)
+                if (_free[i].size >= size && (best == _free.size() || _free[i].size < _free[best].size))
+                    best = i;
+
+            if (best != _free.size())
+            {
+                auto entry = _free[best];
+                _free.erase( _free.begin() + best );
+                return Lease( this, entry.ptr, entry.size );
+            }
+        }
+
+        // Round up so slightly different request sizes share buffers
+        constexpr size_t granularity = 64 * 1024;
+        size = (size + granularity - 1) & ~(granularity - 1);
+
+        uint8_t* ptr = nullptr;
+
+        // Large pages need SeLockMemoryPrivilege and a size multiple; silently
+        // fall back when either is missing
+        if (_tryLargePages)
+        {
+            const size_t largePage = GetLargePageMinimum();
+            if (largePage != 0)
+            {
+                const size_t rounded = (size + largePage - 1) & ~(largePage - 1);
+                ptr = reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, rounded, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE ));
+                if (ptr)
+                    size = rounded;
+            }
+        }
+
+        if (!ptr)
+            ptr = reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE ));
+
+        return ptr ? Lease( this, ptr, size ) : Lease();
+    }
+
+    /// <summary>
+    /// Free pooled buffers, outstanding leases stay valid
+    /// </summary>
+    void Trim()
+    {
+        std::lock_guard<std::mutex> lock( _lock );
+        for (auto& entry : _free)
+            VirtualFree( entry.ptr, 0, MEM_RELEASE );
+
+        _free.clear();
+    }
+
+private:
+    friend class Lease;
+
+    struct Entry
+    {
+        uint8_t* ptr;
+        size_t size;
+    };
+
+    /// <summary>
+    /// Return a leased buffer to the pool
+    /// </summary>
+    void Return( uint8_t* ptr, size_t size )
+    {
+        std::lock_guard<std::mutex> lock( _lock );
+
+        // Bound pool footprint
+        constexpr size_t maxPooled = 8;
+        if (_free.size() >= maxPooled)
+        {
+            VirtualFree( ptr, 0, MEM_RELEASE );
+            return;
+        }
+
+        _free.emplace_back( Entry{ ptr, size } );
+    }
+
+private:
+    std::mutex _lock;           // Pool guard
+    std::vector<Entry> _free;   // Returned buffers
+    bool _tryLargePages;        // Attempt MEM_LARGE_PAGES allocations
+};
+
+}
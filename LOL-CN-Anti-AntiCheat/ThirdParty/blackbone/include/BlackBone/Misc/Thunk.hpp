@@ -1,7 +1,11 @@
 #include "../Config.h"
+#include "Utils.h"
 #include <stdint.h>
 #include <winnt.h>
 
+#include <new>
+#include <vector>
+
 // Thunk code
 #pragma pack(push, 1)
 struct ThunkData
@@ -50,6 +54,80 @@ struct ThunkData
 #pragma pack(pop)
 
 
+/// <summary>
+/// Fixed-size executable slots carved from shared pages.
+/// Slots come pre-encoded, so binding one writes only the two
+/// immediates and releasing recycles the slot
+/// </summary>
+class ThunkPool
+{
+    // Keeps slots naturally aligned within a page
+    static const size_t SlotStride = 32;
+    static_assert(sizeof( ThunkData ) <= SlotStride, "Thunk template exceeds slot");
+
+public:
+    static ThunkPool& Instance()
+    {
+        static ThunkPool instance;
+        return instance;
+    }
+
+    ThunkPool( const ThunkPool& ) = delete;
+
+    /// <summary>
+    /// Get a pre-encoded slot
+    /// </summary>
+    /// <returns>Slot, nullptr if page allocation failed</returns>
+    ThunkData* allocate()
+    {
+        blackbone::CSLock lck( _guard );
+
+        if (_free.empty() && !Grow())
+            return nullptr;
+
+        auto slot = _free.back();
+        _free.pop_back();
+        return slot;
+    }
+
+    /// <summary>
+    /// Return slot to the pool
+    /// </summary>
+    /// <param name="slot">Slot to recycle</param>
+    void recycle( ThunkData* slot )
+    {
+        if (slot == nullptr)
+            return;
+
+        blackbone::CSLock lck( _guard );
+        _free.push_back( slot );
+    }
+
+private:
+    ThunkPool() = default;
+
+    /// <summary>
+    /// Carve another executable page into pre-encoded slots
+    /// </summary>
+    /// <returns>true on success</returns>
+    bool Grow()
+    {
+        auto page = reinterpret_cast<uint8_t*>(VirtualAlloc( nullptr, 0x1000, MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE ));
+        if (page == nullptr)
+            return false;
+
+        for (size_t ofst = 0; ofst + SlotStride <= 0x1000; ofst += SlotStride)
+            _free.push_back( new(page + ofst) ThunkData() );
+
+        return true;
+    }
+
+private:
+    std::vector<ThunkData*> _free;      // Unbound slots
+    blackbone::CriticalSection _guard;  // Pool guard
+};
+
+
 template<typename fn, typename C>
 class Win32Thunk;
 
@@ -65,11 +143,20 @@ public:
         : _pMethod( pfn )
         , _pInstance( pInstance )
     {
-        DWORD dwOld = 0;
-        VirtualProtect( &_thunk, sizeof( _thunk ), PAGE_EXECUTE_READWRITE, &dwOld );
-        _thunk.setup( this, &Win32Thunk::WrapHandler );
+        _thunk = ThunkPool::Instance().allocate();
+        if (_thunk != nullptr)
+            _thunk->setup( this, &Win32Thunk::WrapHandler );
     }
 
+    ~Win32Thunk()
+    {
+        ThunkPool::Instance().recycle( _thunk );
+        _thunk = nullptr;
+    }
+
+    Win32Thunk( const Win32Thunk& ) = delete;
+    Win32Thunk& operator =( const Win32Thunk& ) = delete;
+
     /// <summary>
     /// Redirect call
     /// </summary>
@@ -87,11 +174,11 @@ public:
     /// <returns></returns>
     TypeFree GetThunk()
     {
-        return reinterpret_cast<TypeFree>(&_thunk);
+        return reinterpret_cast<TypeFree>(_thunk);
     }
 
 private:
     TypeMember _pMethod = nullptr;  // Member function to call
     C* _pInstance = nullptr;        // Bound instance
-    ThunkData _thunk;               // Thunk code
-};
\ No newline at end of file
+    ThunkData* _thunk = nullptr;    // Pooled thunk slot
+};
@@ -1,39 +1,177 @@
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #pragma warning(push)
 #pragma warning(disable : 4091)
 #include <DbgHelp.h>
 #pragma warning(pop)
 
+// Compile-time verbosity: 0 - off, 1 - default, 2 - verbose.
+// Disabled traces compile to nothing
+#ifdef BLACKBONE_NO_TRACE
+#define BLACKBONE_TRACE_LEVEL 0
+#elif !defined(BLACKBONE_TRACE_LEVEL)
+#define BLACKBONE_TRACE_LEVEL 1
+#endif
+
 namespace blackbone
 {
-#ifndef BLACKBONE_NO_TRACE
+#if BLACKBONE_TRACE_LEVEL > 0
 
-inline void DoTraceV( const char* fmt, va_list va_args )
+namespace trace
 {
-    char buf[2048], userbuf[1024];
-    vsprintf_s( userbuf, fmt, va_args );
-    sprintf_s( buf, "BlackBone: %s\r\n", userbuf );
-    OutputDebugStringA( buf );
+    constexpr uint32_t RecordText = 1024;   // Rendered message capacity
+    constexpr uint32_t RingSize = 64;       // Records per thread, power of two
+    constexpr uint32_t MaxRings = 64;       // Traced thread limit
+
+    /// <summary>
+    /// One captured trace message
+    /// </summary>
+    struct Record
+    {
+        uint64_t timestamp;         // QPC ticks at capture
+        char text[RecordText];      // Message rendered by the caller
+    };
+
+    /// <summary>
+    /// Single-producer ring, owner thread writes head, drain thread writes tail
+    /// </summary>
+    struct Ring
+    {
+        volatile LONG head = 0;
+        volatile LONG tail = 0;
+        Record records[RingSize];
+    };
+
+    inline void* volatile g_rings[MaxRings] = { };
+    inline volatile LONG g_ringCount = 0;
+
+    inline uint64_t Timestamp()
+    {
+        LARGE_INTEGER li = { };
+        QueryPerformanceCounter( &li );
+        return static_cast<uint64_t>(li.QuadPart);
+    }
+
+    /// <summary>
+    /// Format and emit one record, drain thread or synchronous fallback only
+    /// </summary>
+    /// <param name="rec">Captured record</param>
+    inline void Emit( const Record& rec )
+    {
+        char buf[RecordText + 64];
+        sprintf_s( buf, "BlackBone[%llu]: %s\r\n", rec.timestamp, rec.text );
+        OutputDebugStringA( buf );
 
 #ifdef CONSOLE_TRACE
-    printf_s( buf );
+        printf_s( "%s", buf );
 #endif
+    }
+
+    /// <summary>
+    /// Background formatter, walks all per-thread rings
+    /// </summary>
+    inline DWORD WINAPI DrainLoop( LPVOID /*lpParam*/ )
+    {
+        for (;;)
+        {
+            Sleep( 10 );
+
+            const LONG count = g_ringCount;
+            for (LONG i = 0; i < count; i++)
+            {
+                auto ring = reinterpret_cast<Ring*>(ReadPointerAcquire( &g_rings[i] ));
+                if (ring == nullptr)
+                    continue;
+
+                while (ring->tail != ring->head)
+                {
+                    Emit( ring->records[ring->tail & (RingSize - 1)] );
+                    InterlockedIncrement( &ring->tail );
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Get calling thread ring, registering it and the drain thread on first use.
+    /// Rings are never freed: the drain thread may touch them after thread exit
+    /// </summary>
+    /// <returns>Ring, nullptr if the thread limit is reached</returns>
+    inline Ring* ThreadRing()
+    {
+        static const bool drainStarted = []()
+        {
+            auto hThread = CreateThread( nullptr, 0, &DrainLoop, nullptr, 0, nullptr );
+            if (hThread != nullptr)
+                CloseHandle( hThread );
+
+            return hThread != nullptr;
+        }();
+
+        thread_local Ring* ring = []() -> Ring*
+        {
+            if (!drainStarted)
+                return nullptr;
+
+            const LONG idx = InterlockedIncrement( &g_ringCount ) - 1;
+            if (idx >= static_cast<LONG>(MaxRings))
+                return nullptr;
+
+            auto newRing = new Ring();
+            WritePointerRelease( &g_rings[idx], newRing );
+            return newRing;
+        }();
+
+        return ring;
+    }
+
+    /// <summary>
+    /// Queue rendered message for deferred emission.
+    /// Capture cost is one record copy, no kernel calls
+    /// </summary>
+    /// <param name="text">Rendered message</param>
+    inline void Enqueue( const char* text )
+    {
+        auto ring = ThreadRing();
+        if (ring == nullptr || ring->head - ring->tail >= static_cast<LONG>(RingSize))
+        {
+            // No ring or ring exhausted, emit in place
+            Record rec = { };
+            rec.timestamp = Timestamp();
+            strcpy_s( rec.text, text );
+            Emit( rec );
+            return;
+        }
+
+        auto& rec = ring->records[ring->head & (RingSize - 1)];
+        rec.timestamp = Timestamp();
+        strcpy_s( rec.text, text );
+        InterlockedIncrement( &ring->head );
+    }
+}
+
+// Arguments routinely point at transient stack buffers, so the message is
+// rendered at capture and only the slow debugger emission is deferred
+
+inline void DoTraceV( const char* fmt, va_list va_args )
+{
+    char userbuf[1024];
+    vsprintf_s( userbuf, fmt, va_args );
+    trace::Enqueue( userbuf );
 }
 
 inline void DoTraceV( const wchar_t* fmt, va_list va_args )
 {
-    wchar_t buf[2048], userbuf[1024];
+    wchar_t userbuf[1024];
+    char text[1024];
     vswprintf_s( userbuf, fmt, va_args );
-    swprintf_s( buf, L"BlackBone: %ls\r\n", userbuf );
-    OutputDebugStringW( buf );
-
-#ifdef CONSOLE_TRACE
-    wprintf_s( buf );
-#endif
+    sprintf_s( text, "%ls", userbuf );
+    trace::Enqueue( text );
 }
 
 template<typename Ch>
@@ -51,4 +189,10 @@ inline void DoTrace( const Ch* fmt, ... )
 #define BLACKBONE_TRACE(...)
 #endif
 
-}
\ No newline at end of file
+#if BLACKBONE_TRACE_LEVEL >= 2
+#define BLACKBONE_TRACE_VERBOSE(fmt, ...) DoTrace(fmt, ##__VA_ARGS__)
+#else
+#define BLACKBONE_TRACE_VERBOSE(...)
+#endif
+
+}
@@ -4,10 +4,63 @@
 
 #include <algorithm>
 #include <random>
+#include <emmintrin.h>
 
 namespace blackbone
 {
 
+namespace
+{
+    /// <summary>
+    /// Check that the buffer is pure ASCII, 16 bytes per step
+    /// </summary>
+    /// <param name="str">Narrow buffer</param>
+    /// <param name="len">Length in characters</param>
+    /// <returns>true if no character exceeds 0x7F</returns>
+    bool IsAscii( const char* str, size_t len )
+    {
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>(str + i) );
+            if (_mm_movemask_epi8( chunk ) != 0)
+                return false;
+        }
+
+        for (; i < len; i++)
+            if (static_cast<unsigned char>(str[i]) > 0x7F)
+                return false;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Check that the buffer is pure ASCII, 8 characters per step
+    /// </summary>
+    /// <param name="str">Wide buffer</param>
+    /// <param name="len">Length in characters</param>
+    /// <returns>true if no character exceeds 0x7F</returns>
+    bool IsAscii( const wchar_t* str, size_t len )
+    {
+        const __m128i limit = _mm_set1_epi16( 0x007F );
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8)
+        {
+            const __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>(str + i) );
+            if (_mm_movemask_epi8( _mm_cmpeq_epi16( _mm_subs_epu16( chunk, limit ), zero ) ) != 0xFFFF)
+                return false;
+        }
+
+        for (; i < len; i++)
+            if (str[i] > 0x7F)
+                return false;
+
+        return true;
+    }
+}
+
 /// <summary>
 /// Convert UTF-8 string to wide char one
 /// </summary>
@@ -36,6 +89,10 @@ std::string Utils::WstringToUTF8( const std::wstring& str )
 /// <returns>wide char string</returns>
 std::wstring Utils::AnsiToWstring( const std::string& input, DWORD locale /*= CP_ACP*/ )
 {
+    // ASCII maps to itself in every supported code page, widen directly
+    if (IsAscii( input.c_str(), input.length() ))
+        return std::wstring( input.begin(), input.end() );
+
     wchar_t buf[2048] = { 0 };
     MultiByteToWideChar( locale, 0, input.c_str(), (int)input.length(), buf, ARRAYSIZE( buf ) );
     return buf;
@@ -49,6 +106,10 @@ std::wstring Utils::AnsiToWstring( const std::string& input, DWORD locale /*= CP
 /// <returns>ANSI string</returns>
 std::string Utils::WstringToAnsi( const std::wstring& input, DWORD locale /*= CP_ACP*/ )
 {
+    // ASCII maps to itself in every supported code page, narrow directly
+    if (IsAscii( input.c_str(), input.length() ))
+        return std::string( input.begin(), input.end() );
+
     char buf[2048] = { 0 };
     WideCharToMultiByte( locale, 0, input.c_str(), (int)input.length(), buf, ARRAYSIZE( buf ), nullptr, nullptr );
     return buf;
@@ -161,10 +222,48 @@ std::wstring Utils::RandomANString( int length /*= 0*/ )
 /// <returns>Result string</returns>
 std::wstring Utils::ToLower( std::wstring str )
 {
-    std::transform( str.begin(), str.end(), str.begin(), ::towlower );
+    size_t i = 0;
+    const size_t len = str.length();
+
+    // ASCII fast path, 8 characters per step.
+    // Module names and paths are almost always plain ASCII
+    if (len >= 8)
+    {
+        const __m128i limit = _mm_set1_epi16( 0x007F );
+        const __m128i lowA = _mm_set1_epi16( L'A' - 1 );
+        const __m128i highZ = _mm_set1_epi16( L'Z' + 1 );
+        const __m128i caseBit = _mm_set1_epi16( 0x0020 );
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 8 <= len; i += 8)
+        {
+            __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>(&str[i]) );
+
+            // Bail to the generic path at the first non-ASCII character
+            if (_mm_movemask_epi8( _mm_cmpeq_epi16( _mm_subs_epu16( chunk, limit ), zero ) ) != 0xFFFF)
+                break;
+
+            const __m128i isUpper = _mm_and_si128( _mm_cmpgt_epi16( chunk, lowA ), _mm_cmplt_epi16( chunk, highZ ) );
+            chunk = _mm_or_si128( chunk, _mm_and_si128( isUpper, caseBit ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>(&str[i]), chunk );
+        }
+    }
+
+    std::transform( str.begin() + i, str.end(), str.begin() + i, ::towlower );
     return str;
 }
 
+/// <summary>
+/// Case-insensitive string comparison without creating lowered copies
+/// </summary>
+/// <param name="lhs">First string</param>
+/// <param name="rhs">Second string</param>
+/// <returns>true if equal ignoring case</returns>
+bool Utils::iequal( const std::wstring& lhs, const std::wstring& rhs )
+{
+    return lhs.length() == rhs.length() && _wcsicmp( lhs.c_str(), rhs.c_str() ) == 0;
+}
+
 /// <summary>
 /// Get system error description
 /// </summary>
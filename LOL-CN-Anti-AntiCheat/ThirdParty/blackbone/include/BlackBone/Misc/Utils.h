@@ -76,6 +76,14 @@ public:
     /// <returns>Result string</returns>
     BLACKBONE_API static std::wstring ToLower( std::wstring str );
 
+    /// <summary>
+    /// Case-insensitive string comparison without creating lowered copies
+    /// </summary>
+    /// <param name="lhs">First string</param>
+    /// <param name="rhs">Second string</param>
+    /// <returns>true if equal ignoring case</returns>
+    BLACKBONE_API static bool iequal( const std::wstring& lhs, const std::wstring& rhs );
+
     /// <summary>
     /// Generate random alpha-numeric string
     /// </summary>
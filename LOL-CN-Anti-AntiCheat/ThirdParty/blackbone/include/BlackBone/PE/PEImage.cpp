@@ -4,6 +4,7 @@
 #include "../Misc/DynImport.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 #define TLS32(ptr) ((const IMAGE_TLS_DIRECTORY32*)ptr)  // TLS directory
 #define TLS64(ptr) ((const IMAGE_TLS_DIRECTORY64*)ptr)  // TLS directory
@@ -16,6 +17,169 @@ namespace blackbone
 namespace pe
 {
 
+namespace
+{
+
+/// <summary>
+/// Header sanity check descriptor.
+/// A field of 'width' bytes at 'offset' from the table base is masked
+/// and verified to lie within [minVal, maxVal].
+/// </summary>
+struct HeaderCheck
+{
+    uint32_t offset;    // Field offset from the table base
+    uint32_t width;     // Field width in bytes, 2 or 4
+    uint32_t mask;      // Applied before comparison
+    uint32_t minVal;    // Inclusive lower bound
+    uint32_t maxVal;    // Inclusive upper bound
+};
+
+// Checks relative to the DOS header
+constexpr HeaderCheck c_dosChecks[] =
+{
+    // 'MZ' signature
+    { offsetof( IMAGE_DOS_HEADER, e_magic ),  2, 0xFFFF, IMAGE_DOS_SIGNATURE, IMAGE_DOS_SIGNATURE },
+    // NT headers offset is past the DOS header and sane
+    { offsetof( IMAGE_DOS_HEADER, e_lfanew ), 4, 0xFFFFFFFF, sizeof( IMAGE_DOS_HEADER ), 0x10000000 },
+};
+
+// Checks relative to the NT headers
+constexpr HeaderCheck c_ntChecks[] =
+{
+    // 'PE\0\0' signature
+    { offsetof( IMAGE_NT_HEADERS32, Signature ),                       4, 0xFFFFFFFF, IMAGE_NT_SIGNATURE, IMAGE_NT_SIGNATURE },
+    // At least one section, at most the loader limit of 96
+    { offsetof( IMAGE_NT_HEADERS32, FileHeader.NumberOfSections ),     2, 0xFFFF, 1, 96 },
+    // Optional header magic is PE32 (0x10B) or PE32+ (0x20B), bits 0x300 select the flavor
+    { offsetof( IMAGE_NT_HEADERS32, OptionalHeader.Magic ),            2, 0xFCFF, 0x00B, 0x00B },
+    // Optional header is present and large enough
+    { offsetof( IMAGE_NT_HEADERS32, FileHeader.SizeOfOptionalHeader ), 2, 0xFFFF, sizeof( IMAGE_OPTIONAL_HEADER32 ), 0xFFFF },
+};
+
+/// <summary>
+/// Evaluate a check table against a header block
+/// </summary>
+/// <param name="pBase">Table base address</param>
+/// <param name="checks">Check descriptors</param>
+/// <param name="count">Descriptor count</param>
+/// <returns>true if every check passed</returns>
+bool RunHeaderChecks( const void* pBase, const HeaderCheck* checks, size_t count )
+{
+    auto pBytes = reinterpret_cast<const uint8_t*>(pBase);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t value = checks[i].width == 2
+            ? *reinterpret_cast<const uint16_t*>(pBytes + checks[i].offset)
+            : *reinterpret_cast<const uint32_t*>(pBytes + checks[i].offset);
+
+        value &= checks[i].mask;
+        if (value < checks[i].minVal || value > checks[i].maxVal)
+            return false;
+    }
+
+    return true;
+}
+
+// File identities that already passed validation this run.
+// Repeatedly parsed system DLLs skip the check tables.
+CriticalSection g_trustedLock;
+std::unordered_set<std::wstring> g_trustedImages;
+
+/// <summary>
+/// Build trusted-image key from file identity - path, size and write time
+/// </summary>
+/// <param name="path">File path</param>
+/// <returns>Key, empty if the file is inaccessible</returns>
+std::wstring TrustedImageKey( const std::wstring& path )
+{
+    WIN32_FILE_ATTRIBUTE_DATA attrib = { };
+    if (!GetFileAttributesExW( path.c_str(), GetFileExInfoStandard, &attrib ))
+        return L"";
+
+    const uint64_t size = (static_cast<uint64_t>(attrib.nFileSizeHigh) << 32) | attrib.nFileSizeLow;
+    const uint64_t time = (static_cast<uint64_t>(attrib.ftLastWriteTime.dwHighDateTime) << 32) | attrib.ftLastWriteTime.dwLowDateTime;
+
+    return Utils::ToLower( path ) + Utils::FormatString( L"|%llx", size ^ (time * 0x100000001B3ull) );
+}
+
+}
+
+FileProjection::~FileProjection()
+{
+    if (_pBase != nullptr)
+        UnmapViewOfFile( _pBase );
+}
+
+ProjectionCache& ProjectionCache::Instance()
+{
+    static ProjectionCache instance;
+    return instance;
+}
+
+/// <summary>
+/// Get existing projection of a file or create a new one
+/// </summary>
+/// <param name="path">File path</param>
+/// <returns>Projection, nullptr if the file can't be mapped</returns>
+ProjectionPtr ProjectionCache::Get( const std::wstring& path )
+{
+    Handle hFile = CreateFileW(
+        path.c_str(), FILE_GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, 0, NULL
+        );
+
+    if (!hFile)
+        return nullptr;
+
+    // Identity key survives path aliases - hard links, short names, case
+    BY_HANDLE_FILE_INFORMATION info = { };
+    if (!GetFileInformationByHandle( hFile, &info ))
+        return nullptr;
+
+    const auto key = std::make_pair(
+        info.dwVolumeSerialNumber,
+        (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow
+        );
+
+    CSLock lck( _lock );
+
+    auto found = _cache.find( key );
+    if (found != _cache.end())
+    {
+        if (auto existing = found->second.lock())
+            return existing;
+    }
+
+    auto projection = std::make_shared<FileProjection>();
+    projection->_hFile = std::move( hFile );
+
+    // Try mapping as image
+    projection->_hMapping = CreateFileMappingW( projection->_hFile, NULL, SEC_IMAGE | PAGE_READONLY, 0, 0, NULL );
+    if (projection->_hMapping)
+    {
+        projection->_plainData = false;
+        projection->_pBase = MapViewOfFile( projection->_hMapping, FILE_MAP_READ, 0, 0, 0 );
+    }
+    // Map as simple datafile
+    else
+    {
+        projection->_plainData = true;
+        projection->_hMapping = CreateFileMappingW( projection->_hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+        if (projection->_hMapping)
+            projection->_pBase = MapViewOfFile( projection->_hMapping, FILE_MAP_READ, 0, 0, 0 );
+    }
+
+    // Mapping failed
+    if (projection->_pBase == nullptr)
+        return nullptr;
+
+    _cache[key] = projection;
+    return projection;
+}
+
 PEImage::PEImage( void )
 {
 }
@@ -37,38 +201,14 @@ NTSTATUS PEImage::Load( const std::wstring& path, bool skipActx /*= false*/ )
     _imagePath = path;
     _noFile = false;
 
-    _hFile = CreateFileW(
-        path.c_str(), FILE_GENERIC_READ,
-        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
-        NULL, OPEN_EXISTING, 0, NULL
-        );
-
-    if (_hFile)
-    {
-        // Try mapping as image
-        _hMapping = CreateFileMappingW( _hFile, NULL, SEC_IMAGE | PAGE_READONLY, 0, 0, NULL );
-        if (_hMapping)
-        {
-            _isPlainData = false;
-            _pFileBase = MapViewOfFile( _hMapping, FILE_MAP_READ, 0, 0, 0 );
-        }
-        // Map as simple datafile
-        else
-        {
-            _isPlainData = true;
-            _hMapping = CreateFileMappingW( _hFile, NULL, PAGE_READONLY, 0, 0, NULL );
-
-            if (_hMapping)
-                _pFileBase = MapViewOfFile( _hMapping, FILE_MAP_READ, 0, 0, 0 );
-        }
-
-        // Mapping failed
-        if (!_pFileBase)
-            return LastNtStatus();
-    }
-    else
+    // Share one read-only projection among all images of this file
+    _projection = ProjectionCache::Instance().Get( path );
+    if (!_projection)
         return LastNtStatus();
 
+    _pFileBase = _projection->base();
+    _isPlainData = _projection->plainData();
+
     auto status = Parse();
     if (!NT_SUCCESS( status ))
         return status;
@@ -113,11 +253,13 @@ NTSTATUS PEImage::Reload()
 /// <param name="temporary">Preserve file paths for file reopening</param>
 void PEImage::Release( bool temporary /*= false*/ )
 {
-    if (_pFileBase)
-    {
+    // Projection-backed view is unmapped with its last reference
+    if (_projection)
+        _projection.reset();
+    else if (_pFileBase)
         UnmapViewOfFile( _pFileBase );
-        _pFileBase = nullptr;
-    }
+
+    _pFileBase = nullptr;
 
     _hMapping.reset();
     _hFile.reset();
@@ -155,11 +297,25 @@ NTSTATUS PEImage::Parse( void* pImageBase /*= nullptr*/ )
     if (!_pFileBase)
         return STATUS_INVALID_ADDRESS;
 
+    // File-backed images that already passed validation this run skip the check tables
+    std::wstring trustKey;
+    bool trusted = false;
+
+    if (pImageBase == nullptr && !_noFile && !_imagePath.empty())
+    {
+        trustKey = TrustedImageKey( _imagePath );
+        if (!trustKey.empty())
+        {
+            CSLock lck( g_trustedLock );
+            trusted = g_trustedImages.count( trustKey ) != 0;
+        }
+    }
+
     // Get DOS header
     pDosHdr = reinterpret_cast<const IMAGE_DOS_HEADER*>(_pFileBase);
 
     // File not a valid PE file
-    if (pDosHdr->e_magic != IMAGE_DOS_SIGNATURE)
+    if (!trusted && !RunHeaderChecks( pDosHdr, c_dosChecks, ARRAYSIZE( c_dosChecks ) ))
         return STATUS_INVALID_IMAGE_FORMAT;
 
     // Get image header
@@ -167,7 +323,7 @@ NTSTATUS PEImage::Parse( void* pImageBase /*= nullptr*/ )
     _pImageHdr64 = reinterpret_cast<PCHDR64>(_pImageHdr32);
 
     // File not a valid PE file
-    if (_pImageHdr32->Signature != IMAGE_NT_SIGNATURE)
+    if (!trusted && !RunHeaderChecks( _pImageHdr32, c_ntChecks, ARRAYSIZE( c_ntChecks ) ))
         return STATUS_INVALID_IMAGE_FORMAT;
 
     auto GetHeaderData = [this, &pSection]( auto pImageHeader )
@@ -197,6 +353,13 @@ NTSTATUS PEImage::Parse( void* pImageBase /*= nullptr*/ )
     // Exe file
     _isExe = !(_pImageHdr32->FileHeader.Characteristics & IMAGE_FILE_DLL);
 
+    // Underlying data may have changed, directory caches must be rebuilt
+    _sections.clear();
+    _imports.clear();
+    _delayImports.clear();
+    _exports.clear();
+    _importsParsed = _delayImportsParsed = _exportsParsed = false;
+
     // Pure IL image
     auto pCorHdr = reinterpret_cast<PIMAGE_COR20_HEADER>(DirectoryAddress( IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR ));
 
@@ -208,20 +371,48 @@ NTSTATUS PEImage::Parse( void* pImageBase /*= nullptr*/ )
             reinterpret_cast<uint8_t*>(pCorHdr)
             - reinterpret_cast<uint8_t*>(_pFileBase)
             + static_cast<int32_t>(offsetof( IMAGE_COR20_HEADER, Flags )));
+    }
 
 #ifdef COMPILER_MSVC
-        if (_netImage.Init( _imagePath ))
-            _netImage.Parse();
+    // CLR metadata importer is heavyweight COM machinery, instantiated
+    // lazily in net() instead of during every probe
+    _netParsed = false;
 #endif
-    }
 
     // Sections
     for (int i = 0; i < _pImageHdr32->FileHeader.NumberOfSections; ++i, ++pSection)
         _sections.emplace_back( *pSection );
 
+    // Validation passed, later parses of the same file identity skip it
+    if (!trusted && !trustKey.empty())
+    {
+        CSLock lck( g_trustedLock );
+        g_trustedImages.emplace( std::move( trustKey ) );
+    }
+
     return STATUS_SUCCESS;
 }
 
+#ifdef COMPILER_MSVC
+/// <summary>
+/// .NET image parser.
+/// The metadata importer is instantiated on first access, Parse only
+/// records COR directory presence from headers.
+/// </summary>
+/// <returns>.NET image parser</returns>
+ImageNET& PEImage::net()
+{
+    if (_isPureIL && !_netParsed)
+    {
+        _netParsed = true;
+        if (_netImage.Init( _imagePath ))
+            _netImage.Parse();
+    }
+
+    return _netImage;
+}
+#endif
+
 /// <summary>
 /// Processes image imports
 /// </summary>
@@ -231,6 +422,12 @@ mapImports& PEImage::GetImports( bool useDelayed /*= false*/ )
 {
     if(useDelayed)
     {
+        // Decoded on first access only
+        if (_delayImportsParsed)
+            return _delayImports;
+
+        _delayImportsParsed = true;
+
         auto pImportTbl = reinterpret_cast<PIMAGE_DELAYLOAD_DESCRIPTOR>(DirectoryAddress( IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT ));
         if (!pImportTbl)
             return _delayImports;
@@ -279,6 +476,12 @@ mapImports& PEImage::GetImports( bool useDelayed /*= false*/ )
     }
     else
     {
+        // Decoded on first access only
+        if (_importsParsed)
+            return _imports;
+
+        _importsParsed = true;
+
         auto *pImportTbl = reinterpret_cast<PIMAGE_IMPORT_DESCRIPTOR>(DirectoryAddress( IMAGE_DIRECTORY_ENTRY_IMPORT ));
         if (!pImportTbl)
             return _imports;
@@ -343,12 +546,24 @@ mapImports& PEImage::GetImports( bool useDelayed /*= false*/ )
 /// <param name="names">Found exports</param>
 void PEImage::GetExports( vecExports& exports )
 {
+    // Serve the cache without remapping the file
+    if (_exportsParsed)
+    {
+        exports = _exports;
+        return;
+    }
+
     exports.clear();
     Reload();
 
+    _exportsParsed = true;
+
     auto pExport = reinterpret_cast<PIMAGE_EXPORT_DIRECTORY>(DirectoryAddress( IMAGE_DIRECTORY_ENTRY_EXPORT ));
     if (pExport == 0)
+    {
+        Release( true );
         return;
+    }
 
     DWORD *pAddressOfNames = reinterpret_cast<DWORD*>(pExport->AddressOfNames + reinterpret_cast<uintptr_t>(_pFileBase));
     DWORD *pAddressOfFuncs = reinterpret_cast<DWORD*>(pExport->AddressOfFunctions + reinterpret_cast<uintptr_t>(_pFileBase));
@@ -358,6 +573,7 @@ void PEImage::GetExports( vecExports& exports )
         exports.push_back( ExportData( reinterpret_cast<const char*>(_pFileBase)+pAddressOfNames[i], pAddressOfFuncs[pAddressOfOrds[i]] ) );
 
     std::sort( exports.begin(), exports.end() );
+    _exports = exports;
     return Release( true );
 }
 
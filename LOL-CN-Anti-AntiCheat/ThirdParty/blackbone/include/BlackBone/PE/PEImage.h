@@ -83,6 +83,58 @@ using mapImports  = std::unordered_map<std::wstring, std::vector<ImportData>>;
 using vecSections = std::vector<IMAGE_SECTION_HEADER>;
 using vecExports  = std::vector<ExportData>;
 
+/// <summary>
+/// Shared read-only projection of a PE file.
+/// Owned via shared_ptr, the underlying mapping lives while any
+/// PEImage references it.
+/// </summary>
+class FileProjection
+{
+public:
+    BLACKBONE_API ~FileProjection();
+
+    BLACKBONE_API void* base() const { return _pBase; }
+    BLACKBONE_API bool plainData() const { return _plainData; }
+
+private:
+    friend class ProjectionCache;
+
+    Handle _hFile;                  // Underlying file
+    Handle _hMapping;               // Mapping object
+    void*  _pBase = nullptr;        // View base
+    bool   _plainData = false;      // Mapped as plain data file
+};
+
+using ProjectionPtr = std::shared_ptr<FileProjection>;
+
+/// <summary>
+/// Process-wide projection cache.
+/// Images are keyed by volume serial and file index, so every PEImage
+/// loading the same file shares one mapping instead of paging in a
+/// fresh copy. Entries are weakly held and die with their last user.
+/// </summary>
+class ProjectionCache
+{
+public:
+    BLACKBONE_API static ProjectionCache& Instance();
+
+    /// <summary>
+    /// Get existing projection of a file or create a new one
+    /// </summary>
+    /// <param name="path">File path</param>
+    /// <returns>Projection, nullptr if the file can't be mapped</returns>
+    BLACKBONE_API ProjectionPtr Get( const std::wstring& path );
+
+private:
+    ProjectionCache() = default;
+    ProjectionCache( const ProjectionCache& ) = delete;
+    ProjectionCache& operator =( const ProjectionCache& ) = delete;
+
+private:
+    CriticalSection _lock;          // Cache guard
+    std::map<std::pair<uint32_t, uint64_t>, std::weak_ptr<FileProjection>> _cache;  // Keyed by volume serial + file index
+};
+
 /// <summary>
 /// Primitive PE parsing class
 /// </summary>
@@ -287,10 +339,12 @@ public:
 
 #ifdef COMPILER_MSVC
     /// <summary>
-    /// .NET image parser
+    /// .NET image parser.
+    /// The metadata importer is instantiated on first access, Parse only
+    /// records COR directory presence from headers.
     /// </summary>
     /// <returns>.NET image parser</returns>
-    BLACKBONE_API ImageNET& net() { return _netImage; }
+    BLACKBONE_API ImageNET& net();
 #endif
 
 private:
@@ -310,9 +364,10 @@ private:
     void* GetManifest( uint32_t& size, int32_t& manifestID );
 
 private:
-    Handle      _hFile;                         // Target file HANDLE
-    Handle      _hMapping;                      // Memory mapping object
-    void*       _pFileBase = nullptr;           // Mapping base
+    Handle        _hFile;                       // Target file HANDLE
+    Handle        _hMapping;                    // Memory mapping object
+    ProjectionPtr _projection;                  // Shared file projection, if file-backed
+    void*         _pFileBase = nullptr;         // Mapping base
     bool        _isPlainData = false;           // File mapped as plain data file
     bool        _is64 = false;                  // Image is 64 bit
     bool        _isExe = false;                 // Image is an .exe file
@@ -333,12 +388,19 @@ private:
     vecSections _sections;                      // Section info
     mapImports  _imports;                       // Import functions
     mapImports  _delayImports;                  // Import functions
+    vecExports  _exports;                       // Export functions
+
+    // Directories are decoded on first access, flags track what is valid
+    bool _importsParsed = false;                // _imports is populated
+    bool _delayImportsParsed = false;           // _delayImports is populated
+    bool _exportsParsed = false;                // _exports is populated
 
     std::wstring _imagePath;                    // Image path
     std::wstring _manifestPath;                 // Image manifest container
 
 #ifdef COMPILER_MSVC
     ImageNET    _netImage;                      // .net image info
+    bool        _netParsed = false;             // Metadata importer was initialized
 #endif
 };
 
@@ -0,0 +1,178 @@
+#include "PatternBatch.h"
+#include "../Include/Macro.h"
+#include "../Include/Winheaders.h"
+#include "../Process/Process.h"
+
+#include <deque>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Add pattern to the batch
+/// </summary>
+/// <param name="pattern">Pattern bytes, no wildcards</param>
+/// <returns>Index of the pattern, used to address its results</returns>
+size_t PatternBatch::Add( const std::vector<uint8_t>& pattern )
+{
+    _patterns.emplace_back( pattern );
+    _compiled = false;
+    return _patterns.size() - 1;
+}
+
+/// <summary>
+/// Add pattern to the batch
+/// </summary>
+/// <param name="pattern">Pattern bytes, no wildcards</param>
+/// <param name="len">Pattern length. If 0 - treated as C-string</param>
+/// <returns>Index of the pattern, used to address its results</returns>
+size_t PatternBatch::Add( const uint8_t* pattern, size_t len /*= 0*/ )
+{
+    return Add( std::vector<uint8_t>( pattern, pattern + (len ? len : strlen( (const char*)pattern )) ) );
+}
+
+/// <summary>
+/// Build goto/failure automaton from accumulated patterns
+/// </summary>
+void PatternBatch::Compile()
+{
+    _nodes.clear();
+    _nodes.emplace_back();
+
+    // Goto function
+    for (size_t idx = 0; idx < _patterns.size(); idx++)
+    {
+        int32_t cur = 0;
+        for (uint8_t c : _patterns[idx])
+        {
+            if (_nodes[cur].next[c] == -1)
+            {
+                _nodes.emplace_back();
+                _nodes[cur].next[c] = static_cast<int32_t>(_nodes.size() - 1);
+            }
+
+            cur = _nodes[cur].next[c];
+        }
+
+        _nodes[cur].output.emplace_back( idx );
+    }
+
+    // Failure function, BFS from root
+    std::deque<int32_t> queue;
+
+    for (int c = 0; c < 256; c++)
+    {
+        if (_nodes[0].next[c] == -1)
+            _nodes[0].next[c] = 0;
+        else
+        {
+            _nodes[_nodes[0].next[c]].fail = 0;
+            queue.emplace_back( _nodes[0].next[c] );
+        }
+    }
+
+    while (!queue.empty())
+    {
+        int32_t cur = queue.front();
+        queue.pop_front();
+
+        for (int c = 0; c < 256; c++)
+        {
+            int32_t target = _nodes[cur].next[c];
+            if (target == -1)
+            {
+                _nodes[cur].next[c] = _nodes[_nodes[cur].fail].next[c];
+                continue;
+            }
+
+            int32_t fail = _nodes[_nodes[cur].fail].next[c];
+            _nodes[target].fail = fail;
+
+            // Merge suffix matches so scan does not walk failure chains
+            auto& failOut = _nodes[fail].output;
+            _nodes[target].output.insert( _nodes[target].output.end(), failOut.begin(), failOut.end() );
+
+            queue.emplace_back( target );
+        }
+    }
+
+    _compiled = true;
+}
+
+/// <summary>
+/// Scan local memory region once for all patterns
+/// </summary>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="out">Per-pattern found results, indexed by value returned from Add</param>
+/// <param name="value_offset">Value that will be added to resulting addresses</param>
+/// <returns>Total number of found addresses</returns>
+size_t PatternBatch::Scan(
+    void* scanStart,
+    size_t scanSize,
+    std::vector<vecScanResult>& out,
+    ptr_t value_offset /*= 0*/
+    )
+{
+    out.resize( _patterns.size() );
+
+    if (_patterns.empty())
+        return 0;
+
+    if (!_compiled)
+        Compile();
+
+    const uint8_t* cstart = reinterpret_cast<const uint8_t*>(scanStart);
+    size_t total = 0;
+    int32_t state = 0;
+
+    for (size_t pos = 0; pos < scanSize; pos++)
+    {
+        state = _nodes[state].next[cstart[pos]];
+
+        for (size_t idx : _nodes[state].output)
+        {
+            const uint8_t* res = cstart + pos + 1 - _patterns[idx].size();
+
+            if (value_offset != 0)
+                out[idx].emplace_back( REBASE( res, scanStart, value_offset ) );
+            else
+                out[idx].emplace_back( reinterpret_cast<ptr_t>(res) );
+
+            total++;
+        }
+    }
+
+    return total;
+}
+
+/// <summary>
+/// Scan remote memory region once for all patterns
+/// </summary>
+/// <param name="remote">Remote process</param>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="out">Per-pattern found results, indexed by value returned from Add</param>
+/// <returns>Total number of found addresses</returns>
+size_t PatternBatch::ScanRemote(
+    Process& remote,
+    ptr_t scanStart,
+    size_t scanSize,
+    std::vector<vecScanResult>& out
+    )
+{
+    size_t total = 0;
+    uint8_t *pBuffer = reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, scanSize, MEM_COMMIT, PAGE_READWRITE ));
+
+    if (pBuffer && remote.memory().Read( scanStart, scanSize, pBuffer ) == STATUS_SUCCESS)
+        total = Scan( pBuffer, scanSize, out, scanStart );
+    else
+        out.resize( _patterns.size() );
+
+    if (pBuffer)
+        VirtualFree( pBuffer, 0, MEM_RELEASE );
+
+    return total;
+}
+
+}
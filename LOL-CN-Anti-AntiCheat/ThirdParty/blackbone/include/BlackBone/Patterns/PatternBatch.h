@@ -0,0 +1,95 @@
+#pragma once
+
+#include "PatternSearch.h"
+
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Multi-pattern scanner.
+/// Compiles all added patterns into one Aho-Corasick automaton so a region
+/// is walked once regardless of pattern count.
+/// </summary>
+class PatternBatch
+{
+public:
+    BLACKBONE_API PatternBatch() = default;
+    BLACKBONE_API ~PatternBatch() = default;
+
+    /// <summary>
+    /// Add pattern to the batch
+    /// </summary>
+    /// <param name="pattern">Pattern bytes, no wildcards</param>
+    /// <returns>Index of the pattern, used to address its results</returns>
+    BLACKBONE_API size_t Add( const std::vector<uint8_t>& pattern );
+
+    /// <summary>
+    /// Add pattern to the batch
+    /// </summary>
+    /// <param name="pattern">Pattern bytes, no wildcards</param>
+    /// <param name="len">Pattern length. If 0 - treated as C-string</param>
+    /// <returns>Index of the pattern, used to address its results</returns>
+    BLACKBONE_API size_t Add( const uint8_t* pattern, size_t len = 0 );
+
+    /// <summary>
+    /// Number of patterns in the batch
+    /// </summary>
+    BLACKBONE_API size_t Count() const { return _patterns.size(); }
+
+    /// <summary>
+    /// Scan local memory region once for all patterns
+    /// </summary>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="out">Per-pattern found results, indexed by value returned from Add</param>
+    /// <param name="value_offset">Value that will be added to resulting addresses</param>
+    /// <returns>Total number of found addresses</returns>
+    BLACKBONE_API size_t Scan(
+        void* scanStart,
+        size_t scanSize,
+        std::vector<vecScanResult>& out,
+        ptr_t value_offset = 0
+        );
+
+    /// <summary>
+    /// Scan remote memory region once for all patterns
+    /// </summary>
+    /// <param name="remote">Remote process</param>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="out">Per-pattern found results, indexed by value returned from Add</param>
+    /// <returns>Total number of found addresses</returns>
+    BLACKBONE_API size_t ScanRemote(
+        class Process& remote,
+        ptr_t scanStart,
+        size_t scanSize,
+        std::vector<vecScanResult>& out
+        );
+
+private:
+    /// <summary>
+    /// Trie node. goto links for all byte values plus failure link
+    /// </summary>
+    struct Node
+    {
+        int32_t next[256];              // Goto transitions, -1 if absent
+        int32_t fail = 0;               // Failure link
+        std::vector<size_t> output;     // Patterns ending at this node
+
+        Node() { memset( next, 0xFF, sizeof( next ) ); }
+    };
+
+    /// <summary>
+    /// Build goto/failure automaton from accumulated patterns
+    /// </summary>
+    void Compile();
+
+private:
+    std::vector<std::vector<uint8_t>> _patterns;    // Patterns to search
+    std::vector<Node> _nodes;                       // Automaton nodes, root at index 0
+    bool _compiled = false;                         // Automaton matches _patterns
+};
+
+}
@@ -1,14 +1,44 @@
 #include "PatternSearch.h"
 #include "../Include/Macro.h"
 #include "../Include/Winheaders.h"
+#include "../Misc/HostCpu.h"
 #include "../Process/Process.h"
 
 #include <algorithm>
 #include <memory>
+#include <thread>
+#include <intrin.h>
 
 namespace blackbone
 {
 
+namespace
+{
+
+enum eVecSupport
+{
+    VecNone = 0,
+    VecSSE2,
+    VecAVX2,
+};
+
+/// <summary>
+/// Best supported vector instruction set, from the process-wide CPU capture.
+/// Queried per scan so a HostCpu override takes effect immediately.
+/// </summary>
+/// <returns>Supported instruction set</returns>
+eVecSupport VectorSupport()
+{
+    const auto& cpu = HostCpu();
+
+    if (cpu.avx2)
+        return VecAVX2;
+
+    return cpu.sse2 ? VecSSE2 : VecNone;
+}
+
+}
+
 PatternSearch::PatternSearch( const std::vector<uint8_t>& pattern )
     : _pattern( pattern )
 {
@@ -35,8 +65,9 @@ PatternSearch::PatternSearch( const uint8_t* pattern, size_t len /*= 0*/ )
 }
 
 /// <summary>
-/// Default pattern matching with wildcards.
-/// std::search is approximately 2x faster than naive approach.
+/// Pattern matching with wildcards.
+/// Boyer-Moore-Horspool with a skip table aware of wildcard positions:
+/// no shift may jump past the last wildcard, since it matches any byte.
 /// </summary>
 /// <param name="wildcard">Pattern wildcard</param>
 /// <param name="scanStart">Starting address</param>
@@ -44,34 +75,59 @@ PatternSearch::PatternSearch( const uint8_t* pattern, size_t len /*= 0*/ )
 /// <param name="out">Found results</param>
 /// <param name="value_offset">Value that will be added to resulting addresses</param>
 /// <returns>Number of found addresses</returns>
-size_t PatternSearch::Search( 
-    uint8_t wildcard, 
-    void* scanStart, 
-    size_t scanSize, 
-    std::vector<ptr_t>& out, 
-    ptr_t value_offset /*= 0*/ 
+size_t PatternSearch::Search(
+    uint8_t wildcard,
+    void* scanStart,
+    size_t scanSize,
+    vecScanResult& out,
+    ptr_t value_offset /*= 0*/
     ) const
 {
-    const uint8_t* cstart = (const uint8_t*)scanStart;
-    const uint8_t* cend   = cstart + scanSize;
+    size_t bad_char_skip[UCHAR_MAX + 1];
 
-    auto comparer = [&wildcard]( uint8_t val1, uint8_t val2 )
-    {
-        return (val1 == val2 || val2 == wildcard);
-    };
+    const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
+    const uint8_t* needle   = &_pattern[0];
+    uintptr_t       nlen     = _pattern.size();
+    uintptr_t       scan     = 0;
+    uintptr_t       last     = nlen - 1;
+
+    //
+    // Preprocess.
+    // Default shift is limited by the rightmost wildcard before the last
+    // position - a wildcard 'occurs' every byte value at its offset.
+    //
+    size_t default_skip = nlen;
+    for (scan = 0; scan < last; ++scan)
+        if (needle[scan] == wildcard)
+            default_skip = last - scan;
 
-    for (;;)
+    for (scan = 0; scan <= UCHAR_MAX; ++scan)
+        bad_char_skip[scan] = default_skip;
+
+    for (scan = 0; scan < last; ++scan)
+        if (needle[scan] != wildcard && last - scan < bad_char_skip[needle[scan]])
+            bad_char_skip[needle[scan]] = last - scan;
+
+    //
+    // Search
+    //
+    while (scanSize >= static_cast<size_t>(nlen))
     {
-        const uint8_t* res = std::search( cstart, cend, _pattern.begin(), _pattern.end(), comparer );
-        if (res >= cend)
-            break;
+        for (scan = last; haystack[scan] == needle[scan] || needle[scan] == wildcard; --scan)
+        {
+            if (scan == 0)
+            {
+                if (value_offset != 0)
+                    out.emplace_back( REBASE( haystack, scanStart, value_offset ) );
+                else
+                    out.emplace_back( reinterpret_cast<ptr_t>(haystack) );
 
-        if (value_offset != 0)
-            out.emplace_back( REBASE( res, scanStart, value_offset ) );
-        else
-            out.emplace_back( reinterpret_cast<ptr_t>(res) );
+                break;
+            }
+        }
 
-        cstart = res + _pattern.size();
+        scanSize -= bad_char_skip[haystack[last]];
+        haystack += bad_char_skip[haystack[last]];
     }
 
     return out.size();
@@ -89,10 +145,14 @@ size_t PatternSearch::Search(
 size_t PatternSearch::Search( 
     void* scanStart,
     size_t scanSize, 
-    std::vector<ptr_t>& out,
+    vecScanResult& out,
     ptr_t value_offset /*= 0*/ 
     ) const
 {
+    // Vector kernel needs at least 2 anchor bytes and a block worth of data
+    if (_engine == Vectorized && _pattern.size() >= 2 && scanSize >= 64 && VectorSupport() != VecNone)
+        return SearchVectorized( scanStart, scanSize, out, value_offset );
+
     size_t bad_char_skip[UCHAR_MAX + 1];
 
     const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
@@ -135,6 +195,333 @@ size_t PatternSearch::Search(
     return out.size();
 }
 
+/// <summary>
+/// Pattern matching with wildcards, stops at first match
+/// </summary>
+/// <param name="wildcard">Pattern wildcard</param>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="value_offset">Value that will be added to resulting address</param>
+/// <returns>Address of first match, 0 if not found</returns>
+ptr_t PatternSearch::SearchFirst(
+    uint8_t wildcard,
+    void* scanStart,
+    size_t scanSize,
+    ptr_t value_offset /*= 0*/
+    ) const
+{
+    size_t bad_char_skip[UCHAR_MAX + 1];
+
+    const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
+    const uint8_t* needle   = &_pattern[0];
+    uintptr_t       nlen     = _pattern.size();
+    uintptr_t       scan     = 0;
+    uintptr_t       last     = nlen - 1;
+
+    size_t default_skip = nlen;
+    for (scan = 0; scan < last; ++scan)
+        if (needle[scan] == wildcard)
+            default_skip = last - scan;
+
+    for (scan = 0; scan <= UCHAR_MAX; ++scan)
+        bad_char_skip[scan] = default_skip;
+
+    for (scan = 0; scan < last; ++scan)
+        if (needle[scan] != wildcard && last - scan < bad_char_skip[needle[scan]])
+            bad_char_skip[needle[scan]] = last - scan;
+
+    while (scanSize >= static_cast<size_t>(nlen))
+    {
+        for (scan = last; haystack[scan] == needle[scan] || needle[scan] == wildcard; --scan)
+        {
+            if (scan == 0)
+                return value_offset != 0 ?
+                    REBASE( haystack, scanStart, value_offset ) :
+                    reinterpret_cast<ptr_t>(haystack);
+        }
+
+        scanSize -= bad_char_skip[haystack[last]];
+        haystack += bad_char_skip[haystack[last]];
+    }
+
+    return 0;
+}
+
+/// <summary>
+/// Full pattern match, no wildcards, stops at first match
+/// </summary>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="value_offset">Value that will be added to resulting address</param>
+/// <returns>Address of first match, 0 if not found</returns>
+ptr_t PatternSearch::SearchFirst(
+    void* scanStart,
+    size_t scanSize,
+    ptr_t value_offset /*= 0*/
+    ) const
+{
+    size_t bad_char_skip[UCHAR_MAX + 1];
+
+    const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
+    const uint8_t* needle   = &_pattern[0];
+    uintptr_t       nlen     = _pattern.size();
+    uintptr_t       scan     = 0;
+    uintptr_t       last     = nlen - 1;
+
+    for (scan = 0; scan <= UCHAR_MAX; ++scan)
+        bad_char_skip[scan] = nlen;
+
+    for (scan = 0; scan < last; ++scan)
+        bad_char_skip[needle[scan]] = last - scan;
+
+    while (scanSize >= static_cast<size_t>(nlen))
+    {
+        for (scan = last; haystack[scan] == needle[scan]; --scan)
+        {
+            if (scan == 0)
+                return value_offset != 0 ?
+                    REBASE( haystack, scanStart, value_offset ) :
+                    reinterpret_cast<ptr_t>(haystack);
+        }
+
+        scanSize -= bad_char_skip[haystack[last]];
+        haystack += bad_char_skip[haystack[last]];
+    }
+
+    return 0;
+}
+
+/// <summary>
+/// Search first pattern match in remote process, reading in increasing chunks
+/// </summary>
+/// <param name="remote">Remote process</param>
+/// <param name="useWildcard">True if pattern contains wildcards</param>
+/// <param name="wildcard">Pattern wildcard</param>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <returns>Address of first match, 0 if not found</returns>
+ptr_t PatternSearch::SearchFirstRemote(
+    Process& remote,
+    bool useWildcard,
+    uint8_t wildcard,
+    ptr_t scanStart,
+    size_t scanSize
+    ) const
+{
+    constexpr size_t maxChunk = 0x400000;   // 4 MB
+    size_t chunk = 0x10000;                 // 64 KB, doubled while no match
+
+    const size_t overlap = _pattern.size() - 1;
+
+    uint8_t* buf = reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, maxChunk + overlap, MEM_COMMIT, PAGE_READWRITE ));
+    if (!buf)
+        return 0;
+
+    ptr_t found = 0;
+
+    for (size_t offset = 0; offset < scanSize && found == 0; offset += chunk, chunk = (std::min)( chunk * 2, maxChunk ))
+    {
+        const size_t length = (std::min)( chunk + overlap, scanSize - offset );
+        if (length < _pattern.size())
+            break;
+
+        if (remote.memory().Read( scanStart + offset, length, buf ) != STATUS_SUCCESS)
+            continue;
+
+        found = useWildcard ?
+            SearchFirst( wildcard, buf, length, scanStart + offset ) :
+            SearchFirst( buf, length, scanStart + offset );
+    }
+
+    VirtualFree( buf, 0, MEM_RELEASE );
+
+    return found;
+}
+
+/// <summary>
+/// Select scan engine used by the wildcard-free Search overload
+/// </summary>
+/// <param name="engine">Desired engine</param>
+void PatternSearch::SetSearchEngine( eSearchEngine engine )
+{
+    _engine = engine;
+}
+
+/// <summary>
+/// Vectorized exact match.
+/// Anchors on the first and last pattern bytes compared 32 (AVX2) or 16 (SSE2)
+/// positions per iteration, verifying full candidates with memcmp.
+/// </summary>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="out">Found results</param>
+/// <param name="value_offset">Value that will be added to resulting addresses</param>
+/// <returns>Number of found addresses</returns>
+size_t PatternSearch::SearchVectorized(
+    void* scanStart,
+    size_t scanSize,
+    vecScanResult& out,
+    ptr_t value_offset
+    ) const
+{
+    const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
+    const uint8_t* needle   = &_pattern[0];
+    const size_t   nlen     = _pattern.size();
+    const size_t   last     = nlen - 1;
+
+    auto report = [&]( const uint8_t* pos )
+    {
+        if (value_offset != 0)
+            out.emplace_back( REBASE( pos, scanStart, value_offset ) );
+        else
+            out.emplace_back( reinterpret_cast<ptr_t>(pos) );
+    };
+
+    size_t pos = 0;
+
+    if (VectorSupport() == VecAVX2)
+    {
+        const __m256i first = _mm256_set1_epi8( static_cast<char>(needle[0]) );
+        const __m256i final = _mm256_set1_epi8( static_cast<char>(needle[last]) );
+
+        for (; pos + last + 32 <= scanSize; pos += 32)
+        {
+            const __m256i blockFirst = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(haystack + pos) );
+            const __m256i blockLast  = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(haystack + pos + last) );
+
+            uint32_t mask = _mm256_movemask_epi8( _mm256_and_si256(
+                _mm256_cmpeq_epi8( first, blockFirst ),
+                _mm256_cmpeq_epi8( final, blockLast ) ) );
+
+            while (mask != 0)
+            {
+                unsigned long bit = 0;
+                _BitScanForward( &bit, mask );
+                mask &= mask - 1;
+
+                if (memcmp( haystack + pos + bit + 1, needle + 1, last ) == 0)
+                    report( haystack + pos + bit );
+            }
+        }
+    }
+    else
+    {
+        const __m128i first = _mm_set1_epi8( static_cast<char>(needle[0]) );
+        const __m128i final = _mm_set1_epi8( static_cast<char>(needle[last]) );
+
+        for (; pos + last + 16 <= scanSize; pos += 16)
+        {
+            const __m128i blockFirst = _mm_loadu_si128( reinterpret_cast<const __m128i*>(haystack + pos) );
+            const __m128i blockLast  = _mm_loadu_si128( reinterpret_cast<const __m128i*>(haystack + pos + last) );
+
+            uint32_t mask = _mm_movemask_epi8( _mm_and_si128(
+                _mm_cmpeq_epi8( first, blockFirst ),
+                _mm_cmpeq_epi8( final, blockLast ) ) );
+
+            while (mask != 0)
+            {
+                unsigned long bit = 0;
+                _BitScanForward( &bit, mask );
+                mask &= mask - 1;
+
+                if (memcmp( haystack + pos + bit + 1, needle + 1, last ) == 0)
+                    report( haystack + pos + bit );
+            }
+        }
+    }
+
+    // Scalar tail
+    for (; pos + nlen <= scanSize; ++pos)
+        if (haystack[pos] == needle[0] && memcmp( haystack + pos + 1, needle + 1, last ) == 0)
+            report( haystack + pos );
+
+    return out.size();
+}
+
+/// <summary>
+/// Enable chunk-parallel scanning of remote regions
+/// </summary>
+/// <param name="workers">Worker count, 0 - one per hardware thread</param>
+void PatternSearch::SetParallelScan( bool enable, size_t workers /*= 0*/ )
+{
+    _parallel = enable;
+    _workers = workers;
+}
+
+/// <summary>
+/// Scan local buffer split into per-worker chunks with pattern-length overlap.
+/// Chunk results are kept separate and concatenated in chunk order, so 'out'
+/// stays sorted by address exactly as the serial scan produces it.
+/// </summary>
+/// <param name="useWildcard">True if pattern contains wildcards</param>
+/// <param name="wildcard">Pattern wildcard</param>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="out">Found results, in address order</param>
+/// <param name="value_offset">Value that will be added to resulting addresses</param>
+/// <returns>Number of found addresses</returns>
+size_t PatternSearch::SearchParallel(
+    bool useWildcard,
+    uint8_t wildcard,
+    void* scanStart,
+    size_t scanSize,
+    vecScanResult& out,
+    ptr_t value_offset
+    ) const
+{
+    constexpr size_t minChunk = 256 * 1024;
+
+    size_t workers = _workers ? _workers : std::thread::hardware_concurrency();
+    if (workers > 1 && scanSize / workers < minChunk)
+        workers = scanSize / minChunk;
+
+    if (workers <= 1)
+    {
+        return useWildcard ?
+            Search( wildcard, scanStart, scanSize, out, value_offset ) :
+            Search( scanStart, scanSize, out, value_offset );
+    }
+
+    uint8_t* cstart  = reinterpret_cast<uint8_t*>(scanStart);
+    const size_t overlap = _pattern.size() - 1;
+    const size_t chunk   = scanSize / workers;
+
+    // Per-worker lists stay on the default resource: a caller-supplied
+    // monotonic arena behind 'out' is not thread safe
+    std::vector<vecScanResult> results( workers );
+    std::vector<std::thread> pool;
+    pool.reserve( workers );
+
+    for (size_t i = 0; i < workers; i++)
+    {
+        const size_t offset = i * chunk;
+
+        // Last chunk takes the remainder, others extend by pattern length
+        // so matches crossing a boundary are found exactly once
+        size_t length = (i == workers - 1) ? scanSize - offset : chunk + overlap;
+        if (offset + length > scanSize)
+            length = scanSize - offset;
+
+        pool.emplace_back( [=, &results]()
+        {
+            ptr_t chunkOffset = value_offset ? value_offset + offset : 0;
+
+            if (useWildcard)
+                Search( wildcard, cstart + offset, length, results[i], chunkOffset );
+            else
+                Search( cstart + offset, length, results[i], chunkOffset );
+        } );
+    }
+
+    for (auto& worker : pool)
+        worker.join();
+
+    for (auto& result : results)
+        out.insert( out.end(), result.begin(), result.end() );
+
+    return out.size();
+}
+
 /// <summary>
 /// Search pattern in remote process
 /// </summary>
@@ -149,16 +536,18 @@ size_t PatternSearch::SearchRemote(
     uint8_t wildcard, 
     ptr_t scanStart, 
     size_t scanSize, 
-    std::vector<ptr_t>& out 
+    vecScanResult& out 
     ) const
 {
-    uint8_t *pBuffer = reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, scanSize, MEM_COMMIT, PAGE_READWRITE ));
-
-    if (pBuffer && remote.memory().Read( scanStart, scanSize, pBuffer ) == STATUS_SUCCESS)
-        Search( wildcard, pBuffer, scanSize, out, scanStart );
+    auto buffer = remote.stagingPool().Acquire( scanSize );
 
-    if (pBuffer)
-        VirtualFree( pBuffer, 0, MEM_RELEASE );
+    if (buffer.valid() && remote.memory().Read( scanStart, scanSize, buffer.get() ) == STATUS_SUCCESS)
+    {
+        if (_parallel)
+            SearchParallel( true, wildcard, buffer.get(), scanSize, out, scanStart );
+        else
+            Search( wildcard, buffer.get(), scanSize, out, scanStart );
+    }
 
     return out.size();
 }
@@ -175,16 +564,112 @@ size_t PatternSearch::SearchRemote(
     Process& remote, 
     ptr_t scanStart, 
     size_t scanSize, 
-    std::vector<ptr_t>& out 
+    vecScanResult& out 
+    ) const
+{
+    auto buffer = remote.stagingPool().Acquire( scanSize );
+
+    if (buffer.valid() && remote.memory().Read( scanStart, scanSize, buffer.get() ) == STATUS_SUCCESS)
+    {
+        if (_parallel)
+            SearchParallel( false, 0, buffer.get(), scanSize, out, scanStart );
+        else
+            Search( buffer.get(), scanSize, out, scanStart );
+    }
+
+    return out.size();
+}
+
+/// <summary>
+/// Search pattern in remote process, streaming the region through two
+/// reusable fixed-size buffers so cross-process reads overlap with scanning
+/// </summary>
+/// <param name="remote">Remote process</param>
+/// <param name="useWildcard">True if pattern contains wildcards</param>
+/// <param name="wildcard">Pattern wildcard</param>
+/// <param name="scanStart">Starting address</param>
+/// <param name="scanSize">Size of region to scan</param>
+/// <param name="out">Found results</param>
+/// <param name="chunkSize">Size of one streaming buffer</param>
+/// <returns>Number of found addresses</returns>
+size_t PatternSearch::SearchRemoteStream(
+    Process& remote,
+    bool useWildcard,
+    uint8_t wildcard,
+    ptr_t scanStart,
+    size_t scanSize,
+    vecScanResult& out,
+    size_t chunkSize /*= 0x400000*/
     ) const
 {
-    uint8_t *pBuffer = reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, scanSize, MEM_COMMIT, PAGE_READWRITE ));
+    // Region fits into one buffer - nothing to overlap
+    if (scanSize <= chunkSize)
+        return useWildcard ?
+            SearchRemote( remote, wildcard, scanStart, scanSize, out ) :
+            SearchRemote( remote, scanStart, scanSize, out );
+
+    const size_t overlap = _pattern.size() - 1;
+    const size_t bufsize = chunkSize + overlap;
+
+    // Two buffers, allocated once and alternated between read and scan
+    uint8_t* buffers[2] =
+    {
+        reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, bufsize, MEM_COMMIT, PAGE_READWRITE )),
+        reinterpret_cast<uint8_t*>(VirtualAlloc( NULL, bufsize, MEM_COMMIT, PAGE_READWRITE ))
+    };
 
-    if (pBuffer && remote.memory().Read( scanStart, scanSize, pBuffer ) == STATUS_SUCCESS)
-        Search( pBuffer, scanSize, out, scanStart );
+    if (!buffers[0] || !buffers[1])
+    {
+        if (buffers[0]) VirtualFree( buffers[0], 0, MEM_RELEASE );
+        if (buffers[1]) VirtualFree( buffers[1], 0, MEM_RELEASE );
+        return out.size();
+    }
+
+    auto readChunk = [&]( size_t index, uint8_t* buffer ) -> size_t
+    {
+        const ptr_t offset = index * chunkSize;
+        size_t length = (std::min)( bufsize, scanSize - static_cast<size_t>(offset) );
+
+        if (remote.memory().Read( scanStart + offset, length, buffer ) != STATUS_SUCCESS)
+            return 0;
+
+        return length;
+    };
+
+    const size_t chunks = (scanSize + chunkSize - 1) / chunkSize;
+    size_t current = 0;
+    size_t curLength = readChunk( 0, buffers[0] );
+
+    for (size_t i = 0; i < chunks; i++)
+    {
+        size_t nextLength = 0;
 
-    if (pBuffer)
-        VirtualFree( pBuffer, 0, MEM_RELEASE );
+        // Fetch chunk i+1 while chunk i is scanned
+        std::thread reader;
+        if (i + 1 < chunks)
+            reader = std::thread( [&]() { nextLength = readChunk( i + 1, buffers[(current + 1) % 2] ); } );
+
+        if (curLength >= _pattern.size())
+        {
+            // Limit match starts to this chunk's own territory
+            const size_t scanLen = (std::min)( curLength, chunkSize + overlap );
+            const ptr_t  offset  = scanStart + i * chunkSize;
+
+            if (useWildcard)
+                Search( wildcard, buffers[current], scanLen, out, offset );
+            else
+                Search( buffers[current], scanLen, out, offset );
+        }
+
+        if (reader.joinable())
+            reader.join();
+
+        curLength = nextLength;
+        current = (current + 1) % 2;
+    }
+
+    VirtualFree( buffers[0], 0, MEM_RELEASE );
+    VirtualFree( buffers[1], 0, MEM_RELEASE );
 
     return out.size();
 }
@@ -201,7 +686,7 @@ size_t PatternSearch::SearchRemoteWhole(
     Process& remote, 
     bool useWildcard, 
     uint8_t wildcard, 
-    std::vector<ptr_t>& out 
+    vecScanResult& out 
     ) const
 {
     MEMORY_BASIC_INFORMATION64 mbi = { 0 };
@@ -236,7 +721,9 @@ size_t PatternSearch::SearchRemoteWhole(
         if (remote.memory().Read( memptr, static_cast<size_t>(mbi.RegionSize), buf ) != STATUS_SUCCESS)
             continue;
 
-        if (useWildcard)
+        if (_parallel)
+            SearchParallel( useWildcard, wildcard, buf, static_cast<size_t>(mbi.RegionSize), out, memptr );
+        else if (useWildcard)
             Search( wildcard, buf, static_cast<size_t>(mbi.RegionSize), out, memptr );
         else
             Search( buf, static_cast<size_t>(mbi.RegionSize), out, memptr );
@@ -247,5 +734,71 @@ size_t PatternSearch::SearchRemoteWhole(
     return out.size();
 }
 
+/// <summary>
+/// Search pattern in remote process regions passing a filter
+/// </summary>
+/// <param name="remote">Remote process</param>
+/// <param name="useWildcard">True if pattern contains wildcards</param>
+/// <param name="wildcard">Pattern wildcard</param>
+/// <param name="filter">Region constraints</param>
+/// <param name="out">Found results</param>
+/// <returns>Number of found addresses</returns>
+size_t PatternSearch::SearchRemoteFiltered(
+    Process& remote,
+    bool useWildcard,
+    uint8_t wildcard,
+    const RegionFilter& filter,
+    vecScanResult& out
+    ) const
+{
+    constexpr uint32_t execMask = PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+    out.clear();
+
+    // Snapshot the memory map once instead of querying per address
+    auto regions = remote.memory().EnumRegions();
+
+    size_t  bufsize = 1 * 1024 * 1024;  // 1 MB
+    uint8_t *buf = reinterpret_cast<uint8_t*>(VirtualAlloc( 0, bufsize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE ));
+
+    for (const auto& mbi : regions)
+    {
+        if (mbi.State != MEM_COMMIT || mbi.Protect == PAGE_NOACCESS)
+            continue;
+
+        // Filter before any cross-process read happens
+        if (filter.executableOnly && !(mbi.Protect & execMask))
+            continue;
+        if (filter.protectMask != 0 && !(mbi.Protect & filter.protectMask))
+            continue;
+        if (filter.typeMask != 0 && !(mbi.Type & filter.typeMask))
+            continue;
+        if (filter.rangeEnd != 0 && (mbi.BaseAddress >= filter.rangeEnd || mbi.BaseAddress + mbi.RegionSize <= filter.rangeStart))
+            continue;
+
+        // Reallocate buffer
+        if (mbi.RegionSize > bufsize)
+        {
+            bufsize = static_cast<size_t>(mbi.RegionSize);
+            VirtualFree( buf, 0, MEM_RELEASE );
+            buf = reinterpret_cast<uint8_t*>(VirtualAlloc( 0, bufsize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE ));
+        }
+
+        if (remote.memory().Read( mbi.BaseAddress, static_cast<size_t>(mbi.RegionSize), buf ) != STATUS_SUCCESS)
+            continue;
+
+        if (_parallel)
+            SearchParallel( useWildcard, wildcard, buf, static_cast<size_t>(mbi.RegionSize), out, mbi.BaseAddress );
+        else if (useWildcard)
+            Search( wildcard, buf, static_cast<size_t>(mbi.RegionSize), out, mbi.BaseAddress );
+        else
+            Search( buf, static_cast<size_t>(mbi.RegionSize), out, mbi.BaseAddress );
+    }
+
+    VirtualFree( buf, 0, MEM_RELEASE );
+
+    return out.size();
+}
+
 
 }
\ No newline at end of file
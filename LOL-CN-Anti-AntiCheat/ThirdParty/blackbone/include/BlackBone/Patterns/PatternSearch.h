@@ -9,9 +9,32 @@
 namespace blackbone
 {
 
+/// <summary>
+/// Remote region constraints for filtered whole-process scans.
+/// Zeroed fields don't constrain.
+/// </summary>
+struct RegionFilter
+{
+    uint32_t protectMask = 0;       // Any of these protection flags must be set
+    uint32_t typeMask = 0;          // Any of MEM_IMAGE/MEM_MAPPED/MEM_PRIVATE
+    ptr_t rangeStart = 0;           // Restrict scan to [rangeStart, rangeEnd), e.g. one module
+    ptr_t rangeEnd = 0;
+    bool executableOnly = false;    // Shorthand for all PAGE_EXECUTE_* protections
+};
+
 class PatternSearch
 {
 public:
+    /// <summary>
+    /// Local scan engine
+    /// </summary>
+    enum eSearchEngine
+    {
+        Scalar = 0,     // Boyer-Moore-Horspool, byte at a time
+        Vectorized,     // 32/16 bytes per iteration with AVX2 or SSE2, picked by CPUID.
+                        // Falls back to Scalar when neither is supported or the pattern is too short.
+    };
+
     BLACKBONE_API PatternSearch( const std::vector<uint8_t>& pattern );
     BLACKBONE_API PatternSearch( const std::initializer_list<uint8_t>&& pattern );
     BLACKBONE_API PatternSearch( const std::string& pattern );
@@ -21,8 +44,8 @@ public:
     BLACKBONE_API ~PatternSearch() = default;
 
     /// <summary>
-    /// Default pattern matching with wildcards.
-    /// std::search is approximately 2x faster than naive approach.
+    /// Pattern matching with wildcards.
+    /// Boyer-Moore-Horspool with a wildcard-aware skip table.
     /// </summary>
     /// <param name="wildcard">Pattern wildcard</param>
     /// <param name="scanStart">Starting address</param>
@@ -34,7 +57,7 @@ public:
         uint8_t wildcard, 
         void* scanStart, 
         size_t scanSize, 
-        std::vector<ptr_t>& out, 
+        vecScanResult& out, 
         ptr_t value_offset = 0 
         ) const;
 
@@ -47,13 +70,81 @@ public:
     /// <param name="out">Found results</param>
     /// <param name="value_offset">Value that will be added to resulting addresses</param>
     /// <returns>Number of found addresses</returns>
-    BLACKBONE_API size_t Search( 
-        void* scanStart, 
-        size_t scanSize, 
-        std::vector<ptr_t>& out, 
-        ptr_t value_offset = 0 
+    BLACKBONE_API size_t Search(
+        void* scanStart,
+        size_t scanSize,
+        vecScanResult& out,
+        ptr_t value_offset = 0
+        ) const;
+
+    /// <summary>
+    /// Pattern matching with wildcards, stops at first match
+    /// </summary>
+    /// <param name="wildcard">Pattern wildcard</param>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="value_offset">Value that will be added to resulting address</param>
+    /// <returns>Address of first match, 0 if not found</returns>
+    BLACKBONE_API ptr_t SearchFirst(
+        uint8_t wildcard,
+        void* scanStart,
+        size_t scanSize,
+        ptr_t value_offset = 0
         ) const;
 
+    /// <summary>
+    /// Full pattern match, no wildcards, stops at first match
+    /// </summary>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="value_offset">Value that will be added to resulting address</param>
+    /// <returns>Address of first match, 0 if not found</returns>
+    BLACKBONE_API ptr_t SearchFirst(
+        void* scanStart,
+        size_t scanSize,
+        ptr_t value_offset = 0
+        ) const;
+
+    /// <summary>
+    /// Search first pattern match in remote process.
+    /// The region is read in small increasing chunks from the start, so a
+    /// match near the beginning never pulls in the rest of the module.
+    /// </summary>
+    /// <param name="remote">Remote process</param>
+    /// <param name="useWildcard">True if pattern contains wildcards</param>
+    /// <param name="wildcard">Pattern wildcard</param>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <returns>Address of first match, 0 if not found</returns>
+    BLACKBONE_API ptr_t SearchFirstRemote(
+        class Process& remote,
+        bool useWildcard,
+        uint8_t wildcard,
+        ptr_t scanStart,
+        size_t scanSize
+        ) const;
+
+    /// <summary>
+    /// Select scan engine used by the wildcard-free Search overload
+    /// </summary>
+    /// <param name="engine">Desired engine</param>
+    BLACKBONE_API void SetSearchEngine( eSearchEngine engine );
+
+    /// <summary>
+    /// Enable chunk-parallel scanning of remote regions.
+    /// Buffers read from the remote process are partitioned across a worker
+    /// pool with pattern-length overlap at chunk boundaries, results are
+    /// merged back in address order.
+    /// </summary>
+    /// <param name="workers">Worker count, 0 - one per hardware thread</param>
+    BLACKBONE_API void SetParallelScan( bool enable, size_t workers = 0 );
+
+    /// <summary>
+    /// Get pattern length in bytes
+    /// </summary>
+    /// <returns>Length</returns>
+    BLACKBONE_API size_t PatternLength() const { return _pattern.size(); }
+
     /// <summary>
     /// Search pattern in remote process
     /// </summary>
@@ -68,7 +159,7 @@ public:
         uint8_t wildcard, 
         ptr_t scanStart,
         size_t scanSize, 
-        std::vector<ptr_t>& out 
+        vecScanResult& out 
         ) const;
 
     /// <summary>
@@ -83,7 +174,31 @@ public:
         class Process& remote, 
         ptr_t scanStart, 
         size_t scanSize, 
-        std::vector<ptr_t>& out 
+        vecScanResult& out 
+        ) const;
+
+    /// <summary>
+    /// Search pattern in remote process, streaming the region through two
+    /// reusable fixed-size buffers. The read of chunk N+1 overlaps with the
+    /// scan of chunk N, chunks share a pattern-length overlap so matches
+    /// crossing a boundary are found exactly once.
+    /// </summary>
+    /// <param name="remote">Remote process</param>
+    /// <param name="useWildcard">True if pattern contains wildcards</param>
+    /// <param name="wildcard">Pattern wildcard</param>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="out">Found results</param>
+    /// <param name="chunkSize">Size of one streaming buffer</param>
+    /// <returns>Number of found addresses</returns>
+    BLACKBONE_API size_t SearchRemoteStream(
+        class Process& remote,
+        bool useWildcard,
+        uint8_t wildcard,
+        ptr_t scanStart,
+        size_t scanSize,
+        vecScanResult& out,
+        size_t chunkSize = 0x400000
         ) const;
 
     /// <summary>
@@ -94,15 +209,73 @@ public:
     /// <param name="wildcard">Pattern wildcard</param>
     /// <param name="out">Found results</param>
     /// <returns>Number of found addresses</returns>
-    BLACKBONE_API size_t SearchRemoteWhole( 
-        class Process& remote, 
-        bool useWildcard, 
-        uint8_t wildcard, 
-        std::vector<ptr_t>& out 
+    BLACKBONE_API size_t SearchRemoteWhole(
+        class Process& remote,
+        bool useWildcard,
+        uint8_t wildcard,
+        vecScanResult& out
+        ) const;
+
+    /// <summary>
+    /// Search pattern in remote process regions passing a filter.
+    /// The remote memory map is snapshotted once and regions failing the
+    /// protection/type/range constraints are never read, so e.g. code
+    /// signature scans touch only executable pages.
+    /// </summary>
+    /// <param name="remote">Remote process</param>
+    /// <param name="useWildcard">True if pattern contains wildcards</param>
+    /// <param name="wildcard">Pattern wildcard</param>
+    /// <param name="filter">Region constraints</param>
+    /// <param name="out">Found results</param>
+    /// <returns>Number of found addresses</returns>
+    BLACKBONE_API size_t SearchRemoteFiltered(
+        class Process& remote,
+        bool useWildcard,
+        uint8_t wildcard,
+        const RegionFilter& filter,
+        vecScanResult& out
+        ) const;
+
+private:
+    /// <summary>
+    /// Vectorized exact match, 32 bytes per iteration with AVX2 or 16 with SSE2
+    /// </summary>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="out">Found results</param>
+    /// <param name="value_offset">Value that will be added to resulting addresses</param>
+    /// <returns>Number of found addresses</returns>
+    size_t SearchVectorized(
+        void* scanStart,
+        size_t scanSize,
+        vecScanResult& out,
+        ptr_t value_offset
+        ) const;
+
+    /// <summary>
+    /// Scan local buffer split into per-worker chunks with pattern-length overlap
+    /// </summary>
+    /// <param name="useWildcard">True if pattern contains wildcards</param>
+    /// <param name="wildcard">Pattern wildcard</param>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="out">Found results, in address order</param>
+    /// <param name="value_offset">Value that will be added to resulting addresses</param>
+    /// <returns>Number of found addresses</returns>
+    size_t SearchParallel(
+        bool useWildcard,
+        uint8_t wildcard,
+        void* scanStart,
+        size_t scanSize,
+        vecScanResult& out,
+        ptr_t value_offset
         ) const;
 
 private:
     std::vector<uint8_t> _pattern;      // Pattern to search
+    eSearchEngine _engine = Scalar;     // Engine for local exact scans
+    size_t _workers = 0;                // Worker count for parallel scan, 0 - hardware threads
+    bool _parallel = false;             // Partition remote buffers across workers
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "ScanIndex.h"
+#include "../Misc/HashKernels.h"
+
+#include <algorithm>
+
+namespace blackbone
+{
+
+namespace
+{
+const size_t pageSize = 0x1000;
+}
+
+ScanIndex::ScanIndex( PatternSearch pattern, bool useWildcard /*= false*/, uint8_t wildcard /*= 0xCC*/ )
+    : _pattern( std::move( pattern ) )
+    , _useWildcard( useWildcard )
+    , _wildcard( wildcard )
+{
+}
+
+/// <summary>
+/// Scan a buffer, incrementally when it was scanned before.
+/// The buffer must be the same region across calls; a size change
+/// drops the index and rebuilds it with a full scan.
+/// </summary>
+/// <param name="data">Buffer start</param>
+/// <param name="size">Buffer size</param>
+/// <param name="value_offset">Value that will be added to resulting addresses</param>
+/// <param name="out">Found results, in address order</param>
+/// <returns>Status</returns>
+NTSTATUS ScanIndex::Scan( const void* data, size_t size, ptr_t value_offset, vecScanResult& out )
+{
+    const size_t patLen = _pattern.PatternLength();
+    if (data == nullptr || size == 0 || patLen == 0 || patLen > size)
+        return STATUS_INVALID_PARAMETER;
+
+    auto pData = static_cast<const uint8_t*>(data);
+    const size_t pageCount = (size + pageSize - 1) / pageSize;
+
+    if (!_built || size != _indexedSize)
+    {
+        Reset();
+        _digests.resize( pageCount );
+        _matches.resize( pageCount );
+        _indexedSize = size;
+    }
+
+    _lastScanned = 0;
+    for (size_t page = 0; page < pageCount; page++)
+    {
+        const size_t pageStart = page * pageSize;
+        const size_t pageBytes = (std::min)( pageSize, size - pageStart );
+
+        // A match starting in this page can extend up to patLen-1 bytes
+        // into the next one, so the digest and the fine scan both cover
+        // that overhang - the digest changes whenever any byte that can
+        // affect this page's recorded matches changes, and a boundary
+        // match is kept only if it starts inside the page, which keeps it
+        // unique
+        const size_t scanBytes = (std::min)( pageBytes + patLen - 1, size - pageStart );
+        const uint64_t digest = Digest64( pData + pageStart, scanBytes );
+
+        if (_built && digest == _digests[page])
+            continue;
+
+        vecScanResult found;
+        if (_useWildcard)
+            _pattern.Search( _wildcard, const_cast<uint8_t*>(pData + pageStart), scanBytes, found );
+        else
+            _pattern.Search( const_cast<uint8_t*>(pData + pageStart), scanBytes, found );
+
+        // Search returns absolute addresses when no value_offset is given
+        auto& pageMatches = _matches[page];
+        pageMatches.clear();
+        for (const auto match : found)
+        {
+            const auto offset = match - reinterpret_cast<ptr_t>(pData + pageStart);
+            if (offset < pageBytes)
+                pageMatches.push_back( static_cast<uint32_t>(offset) );
+        }
+
+        _digests[page] = digest;
+        _lastScanned++;
+    }
+
+    _built = true;
+
+    for (size_t page = 0; page < pageCount; page++)
+        for (const auto offset : _matches[page])
+            out.emplace_back( value_offset + page * pageSize + offset );
+
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Drop the index; the next Scan is a full one
+/// </summary>
+void ScanIndex::Reset()
+{
+    _built = false;
+    _indexedSize = 0;
+    _lastScanned = 0;
+    _digests.clear();
+    _matches.clear();
+}
+
+}
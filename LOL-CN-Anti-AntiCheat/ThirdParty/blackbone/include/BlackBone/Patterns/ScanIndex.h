@@ -0,0 +1,66 @@
+#pragma once
+
+#include "PatternSearch.h"
+
+namespace blackbone
+{
+
+/// <summary>
+/// Two-level scan index over PatternSearch.
+/// First contact scans the whole buffer and records a 64-bit digest plus
+/// the match offsets of every 4KB page. Later scans digest each page and
+/// fine-scan only the pages whose digest changed, reusing the recorded
+/// offsets everywhere else - a re-scan after reconnect costs time
+/// proportional to changed bytes, which is typically near zero. Matches
+/// crossing a page boundary are attributed to the page they start in;
+/// the digest and fine scan of a page both extend one pattern length
+/// into the next, so boundary matches are found exactly once and a
+/// change to the straddled bytes invalidates the page they start in.
+/// </summary>
+class ScanIndex
+{
+public:
+    BLACKBONE_API explicit ScanIndex( PatternSearch pattern, bool useWildcard = false, uint8_t wildcard = 0xCC );
+    BLACKBONE_API ~ScanIndex() = default;
+
+    /// <summary>
+    /// Scan a buffer, incrementally when it was scanned before.
+    /// The buffer must be the same region across calls; a size change
+    /// drops the index and rebuilds it with a full scan.
+    /// </summary>
+    /// <param name="data">Buffer start</param>
+    /// <param name="size">Buffer size</param>
+    /// <param name="value_offset">Value that will be added to resulting addresses</param>
+    /// <param name="out">Found results, in address order</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Scan( const void* data, size_t size, ptr_t value_offset, vecScanResult& out );
+
+    /// <summary>
+    /// Drop the index; the next Scan is a full one
+    /// </summary>
+    BLACKBONE_API void Reset();
+
+    /// <summary>
+    /// Get number of indexed pages
+    /// </summary>
+    /// <returns>Page count</returns>
+    BLACKBONE_API size_t pages() const { return _digests.size(); }
+
+    /// <summary>
+    /// Get number of pages fine-scanned by the last Scan call
+    /// </summary>
+    /// <returns>Page count</returns>
+    BLACKBONE_API size_t lastScannedPages() const { return _lastScanned; }
+
+private:
+    PatternSearch _pattern;                     // Pattern, fine-scans changed pages
+    bool _useWildcard;                          // Wildcard-aware fine scan
+    uint8_t _wildcard;                          // Pattern wildcard
+    bool _built = false;                        // Baseline captured
+    size_t _indexedSize = 0;                    // Buffer size the index was built for
+    size_t _lastScanned = 0;                    // Pages fine-scanned by the last call
+    std::vector<uint64_t> _digests;             // Per-page digests
+    std::vector<std::vector<uint32_t>> _matches;// Per-page match start offsets, page-relative
+};
+
+}
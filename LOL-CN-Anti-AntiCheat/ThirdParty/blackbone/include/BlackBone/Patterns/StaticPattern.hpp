@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../Include/Types.h"
+#include "../Include/Macro.h"
+
+#include <array>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Compile-time compiled pattern.
+/// Byte array, wildcard mask and the wildcard-aware BMH shift table are all
+/// baked into the binary as constexpr data, so constructing a scanner on the
+/// attach path costs zero allocations and zero preprocessing.
+/// </summary>
+template<size_t N>
+struct static_pattern_t
+{
+    static_assert(N >= 2, "Pattern must be at least 2 bytes long");
+
+    std::array<uint8_t, N> pattern = {};
+    std::array<uint8_t, N> mask = {};           // non-zero = wildcard at this offset
+    std::array<uint16_t, 256> bad_char_skip = {};
+
+    /// <summary>
+    /// Compile pattern from raw bytes
+    /// </summary>
+    /// <param name="bytes">Pattern bytes</param>
+    /// <param name="wildcard">Byte value treated as wildcard</param>
+    constexpr static_pattern_t( const uint8_t( &bytes )[N], uint8_t wildcard = 0xCC )
+    {
+        constexpr size_t last = N - 1;
+
+        for (size_t i = 0; i < N; i++)
+        {
+            pattern[i] = bytes[i];
+            mask[i] = (bytes[i] == wildcard) ? 1 : 0;
+        }
+
+        // Same table the runtime wildcard Search builds:
+        // no shift may jump past the rightmost wildcard
+        size_t default_skip = N;
+        for (size_t i = 0; i < last; i++)
+            if (mask[i])
+                default_skip = last - i;
+
+        for (size_t i = 0; i < 256; i++)
+            bad_char_skip[i] = static_cast<uint16_t>(default_skip);
+
+        for (size_t i = 0; i < last; i++)
+            if (!mask[i] && last - i < bad_char_skip[pattern[i]])
+                bad_char_skip[pattern[i]] = static_cast<uint16_t>(last - i);
+    }
+
+    /// <summary>
+    /// Scan local memory region
+    /// </summary>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <param name="out">Found results</param>
+    /// <param name="value_offset">Value that will be added to resulting addresses</param>
+    /// <returns>Number of found addresses</returns>
+    size_t Search( void* scanStart, size_t scanSize, vecScanResult& out, ptr_t value_offset = 0 ) const
+    {
+        constexpr size_t last = N - 1;
+        const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
+
+        while (scanSize >= N)
+        {
+            for (size_t scan = last; haystack[scan] == pattern[scan] || mask[scan]; --scan)
+            {
+                if (scan == 0)
+                {
+                    if (value_offset != 0)
+                        out.emplace_back( REBASE( haystack, scanStart, value_offset ) );
+                    else
+                        out.emplace_back( reinterpret_cast<ptr_t>(haystack) );
+
+                    break;
+                }
+            }
+
+            scanSize -= bad_char_skip[haystack[last]];
+            haystack += bad_char_skip[haystack[last]];
+        }
+
+        return out.size();
+    }
+
+    /// <summary>
+    /// Scan local memory region, stop at first match
+    /// </summary>
+    /// <param name="scanStart">Starting address</param>
+    /// <param name="scanSize">Size of region to scan</param>
+    /// <returns>Address of first match, 0 if not found</returns>
+    ptr_t SearchFirst( void* scanStart, size_t scanSize ) const
+    {
+        constexpr size_t last = N - 1;
+        const uint8_t* haystack = reinterpret_cast<const uint8_t*>(scanStart);
+
+        while (scanSize >= N)
+        {
+            for (size_t scan = last; haystack[scan] == pattern[scan] || mask[scan]; --scan)
+                if (scan == 0)
+                    return reinterpret_cast<ptr_t>(haystack);
+
+            scanSize -= bad_char_skip[haystack[last]];
+            haystack += bad_char_skip[haystack[last]];
+        }
+
+        return 0;
+    }
+};
+
+/// <summary>
+/// Compile pattern from a string literal, e.g.
+/// constexpr auto pat = make_static_pattern( "\x48\x8B\xCC\x05", '\xCC' );
+/// The trailing string terminator is dropped.
+/// </summary>
+/// <param name="str">Pattern literal</param>
+/// <param name="wildcard">Byte value treated as wildcard</param>
+/// <returns>Compiled pattern</returns>
+template<size_t N>
+constexpr static_pattern_t<N - 1> make_static_pattern( const char( &str )[N], uint8_t wildcard = 0xCC )
+{
+    uint8_t bytes[N - 1] = {};
+    for (size_t i = 0; i < N - 1; i++)
+        bytes[i] = static_cast<uint8_t>(str[i]);
+
+    return static_pattern_t<N - 1>( bytes, wildcard );
+}
+
+}
@@ -0,0 +1,126 @@
+#include "AsyncMemory.h"
+#include "ProcessMemory.h"
+
+namespace blackbone
+{
+
+AsyncMemory::AsyncMemory( ProcessMemory& memory )
+    : _memory( memory )
+{
+}
+
+AsyncMemory::~AsyncMemory()
+{
+    if (_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lg( _lock );
+            _stop = true;
+        }
+
+        _cv.notify_one();
+        _thread.join();
+    }
+}
+
+/// <summary>
+/// Queue an asynchronous memory read
+/// </summary>
+/// <param name="address">Memory address to read from</param>
+/// <param name="size">Size of data to read</param>
+/// <param name="pResult">Receives read data, must stay valid until the future is ready</param>
+/// <returns>Future completion status</returns>
+std::future<NTSTATUS> AsyncMemory::ReadAsync( ptr_t address, size_t size, void* pResult )
+{
+    auto promise = std::make_shared<std::promise<NTSTATUS>>();
+    auto future = promise->get_future();
+
+    Enqueue( Op{ Op::read, address, size, pResult, {},
+        [promise]( NTSTATUS status ) { promise->set_value( status ); } } );
+
+    return future;
+}
+
+/// <summary>
+/// Queue an asynchronous memory write. Data is copied before return,
+/// the source buffer may be reused immediately.
+/// </summary>
+/// <param name="address">Memory address to write to</param>
+/// <param name="size">Size of data to write</param>
+/// <param name="pData">Buffer to write</param>
+/// <returns>Future completion status</returns>
+std::future<NTSTATUS> AsyncMemory::WriteAsync( ptr_t address, size_t size, const void* pData )
+{
+    auto promise = std::make_shared<std::promise<NTSTATUS>>();
+    auto future = promise->get_future();
+
+    std::vector<uint8_t> data( static_cast<const uint8_t*>(pData), static_cast<const uint8_t*>(pData) + size );
+
+    Enqueue( Op{ Op::write, address, size, nullptr, std::move( data ),
+        [promise]( NTSTATUS status ) { promise->set_value( status ); } } );
+
+    return future;
+}
+
+/// <summary>
+/// Block until every currently queued operation has completed
+/// </summary>
+void AsyncMemory::Drain()
+{
+    std::unique_lock<std::mutex> lg( _lock );
+    _idle.wait( lg, [this]() { return _queue.empty() && _inflight == 0; } );
+}
+
+/// <summary>
+/// Queue an operation, starting the I/O thread on first use
+/// </summary>
+/// <param name="op">Operation</param>
+void AsyncMemory::Enqueue( Op&& op )
+{
+    {
+        std::lock_guard<std::mutex> lg( _lock );
+        _queue.emplace_back( std::move( op ) );
+
+        if (!_thread.joinable())
+            _thread = std::thread( &AsyncMemory::Worker, this );
+    }
+
+    _cv.notify_one();
+}
+
+/// <summary>
+/// I/O thread: drain the queue in batches until stopped
+/// </summary>
+void AsyncMemory::Worker()
+{
+    std::unique_lock<std::mutex> lg( _lock );
+    for (;;)
+    {
+        _cv.wait( lg, [this]() { return _stop || !_queue.empty(); } );
+        if (_stop && _queue.empty())
+            return;
+
+        // Take the whole queue at once so back-to-back operations are
+        // issued without re-acquiring the lock in between
+        std::deque<Op> batch;
+        batch.swap( _queue );
+        _inflight = batch.size();
+        lg.unlock();
+
+        for (auto& op : batch)
+        {
+            NTSTATUS status = op.kind == Op::read ?
+                _memory.Read( op.address, op.size, op.pResult ) :
+                _memory.Write( op.address, op.size, op.data.data() );
+
+            op.complete( status );
+        }
+
+        lg.lock();
+        _inflight = 0;
+        if (_queue.empty())
+            _idle.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "MemBlock.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Asynchronous layer over ProcessMemory.
+/// Queued reads and writes are drained in batches by a dedicated I/O
+/// thread, so callers can overlap cross-process I/O with local work and
+/// collect results through futures when they are actually needed.
+/// </summary>
+class AsyncMemory
+{
+public:
+    BLACKBONE_API AsyncMemory( class ProcessMemory& memory );
+    BLACKBONE_API ~AsyncMemory();
+
+    /// <summary>
+    /// Queue an asynchronous memory read
+    /// </summary>
+    /// <param name="address">Memory address to read from</param>
+    /// <param name="size">Size of data to read</param>
+    /// <param name="pResult">Receives read data, must stay valid until the future is ready</param>
+    /// <returns>Future completion status</returns>
+    BLACKBONE_API std::future<NTSTATUS> ReadAsync( ptr_t address, size_t size, void* pResult );
+
+    /// <summary>
+    /// Queue an asynchronous strict-typed read
+    /// </summary>
+    /// <param name="address">Memory address to read from</param>
+    /// <returns>Future read result</returns>
+    template<class T>
+    std::future<call_result_t<T>> ReadAsync( ptr_t address )
+    {
+        auto state = std::make_shared<std::pair<std::promise<call_result_t<T>>, T>>();
+        auto future = state->first.get_future();
+
+        Enqueue( Op{ Op::read, address, sizeof( T ), &state->second, {},
+            [state]( NTSTATUS status )
+            {
+                if (NT_SUCCESS( status ))
+                    state->first.set_value( call_result_t<T>( state->second ) );
+                else
+                    state->first.set_value( call_result_t<T>( status ) );
+            } } );
+
+        return future;
+    }
+
+    /// <summary>
+    /// Queue an asynchronous memory write. Data is copied before return,
+    /// the source buffer may be reused immediately.
+    /// </summary>
+    /// <param name="address">Memory address to write to</param>
+    /// <param name="size">Size of data to write</param>
+    /// <param name="pData">Buffer to write</param>
+    /// <returns>Future completion status</returns>
+    BLACKBONE_API std::future<NTSTATUS> WriteAsync( ptr_t address, size_t size, const void* pData );
+
+    /// <summary>
+    /// Queue an asynchronous strict-typed write
+    /// </summary>
+    /// <param name="address">Memory address to write to</param>
+    /// <param name="data">Data to write</param>
+    /// <returns>Future completion status</returns>
+    template<class T>
+    std::future<NTSTATUS> WriteAsync( ptr_t address, const T& data )
+    {
+        return WriteAsync( address, sizeof( T ), &data );
+    }
+
+    /// <summary>
+    /// Block until every currently queued operation has completed
+    /// </summary>
+    BLACKBONE_API void Drain();
+
+private:
+    struct Op
+    {
+        enum eKind { read, write };
+
+        eKind kind;
+        ptr_t address;
+        size_t size;
+        void* pResult;                              // Read destination
+        std::vector<uint8_t> data;                  // Write payload copy
+        std::function<void( NTSTATUS )> complete;   // Completion callback
+    };
+
+private:
+    AsyncMemory( const AsyncMemory& ) = delete;
+    AsyncMemory& operator =( const AsyncMemory& ) = delete;
+
+    /// <summary>
+    /// Queue an operation, starting the I/O thread on first use
+    /// </summary>
+    /// <param name="op">Operation</param>
+    void Enqueue( Op&& op );
+
+    /// <summary>
+    /// I/O thread: drain the queue in batches until stopped
+    /// </summary>
+    void Worker();
+
+private:
+    class ProcessMemory& _memory;   // Target process memory
+    std::thread _thread;            // Dedicated I/O thread
+    std::mutex _lock;               // Queue guard
+    std::condition_variable _cv;    // Queue signal
+    std::condition_variable _idle;  // Drain signal
+    std::deque<Op> _queue;          // Pending operations
+    size_t _inflight = 0;           // Operations taken but not completed
+    bool _stop = false;             // Shutdown flag
+};
+
+}
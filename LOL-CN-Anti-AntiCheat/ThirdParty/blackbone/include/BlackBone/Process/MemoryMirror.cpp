@@ -0,0 +1,62 @@
+#include "MemoryMirror.h"
+
+namespace blackbone
+{
+
+/// <summary>
+/// Map image file backing a remote module
+/// </summary>
+/// <param name="imagePath">Module file path</param>
+/// <param name="remoteBase">Module base in the remote process</param>
+/// <param name="remoteSize">Module image size</param>
+/// <returns>Status code</returns>
+NTSTATUS MemoryMirror::Map( const std::wstring& imagePath, ptr_t remoteBase, size_t remoteSize )
+{
+    Unmap();
+
+    HANDLE hFile = CreateFileW(
+        imagePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+        );
+
+    if (hFile == INVALID_HANDLE_VALUE)
+        return STATUS_OBJECT_NAME_NOT_FOUND;
+
+    // SEC_IMAGE reproduces section placement, so remote RVAs stay valid
+    HANDLE hSection = CreateFileMappingW( hFile, NULL, PAGE_READONLY | SEC_IMAGE, 0, 0, NULL );
+    CloseHandle( hFile );
+
+    if (hSection == NULL)
+        return STATUS_INVALID_IMAGE_FORMAT;
+
+    _pView = MapViewOfFile( hSection, FILE_MAP_READ, 0, 0, 0 );
+    CloseHandle( hSection );
+
+    if (_pView == nullptr)
+        return STATUS_CONFLICTING_ADDRESSES;
+
+    MEMORY_BASIC_INFORMATION mbi = { 0 };
+    VirtualQuery( _pView, &mbi, sizeof( mbi ) );
+
+    _remoteBase = remoteBase;
+    _size = remoteSize ? remoteSize : static_cast<size_t>(mbi.RegionSize);
+
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Unmap view and release section
+/// </summary>
+void MemoryMirror::Unmap()
+{
+    if (_pView)
+    {
+        UnmapViewOfFile( _pView );
+        _pView = nullptr;
+    }
+
+    _remoteBase = 0;
+    _size = 0;
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../Include/Winheaders.h"
+#include "../Include/Types.h"
+
+#include <string>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Zero-copy local view of a remote module's image bytes.
+/// The module's backing file is mapped as SEC_IMAGE, which reproduces the
+/// in-memory section layout, so remote addresses translate to local pointers
+/// by plain offset arithmetic. Scans and hash checks over the mirror cost
+/// pure memory bandwidth instead of one syscall per chunk.
+/// </summary>
+class MemoryMirror
+{
+public:
+    BLACKBONE_API MemoryMirror() = default;
+    BLACKBONE_API ~MemoryMirror() { Unmap(); }
+
+    BLACKBONE_API MemoryMirror( MemoryMirror&& other ) noexcept
+        : _pView( other._pView )
+        , _remoteBase( other._remoteBase )
+        , _size( other._size )
+    {
+        other._pView = nullptr;
+        other._remoteBase = 0;
+        other._size = 0;
+    }
+
+    BLACKBONE_API MemoryMirror& operator =( MemoryMirror&& other ) noexcept
+    {
+        if (this != &other)
+        {
+            Unmap();
+
+            _pView = other._pView;
+            _remoteBase = other._remoteBase;
+            _size = other._size;
+
+            other._pView = nullptr;
+            other._remoteBase = 0;
+            other._size = 0;
+        }
+
+        return *this;
+    }
+
+    /// <summary>
+    /// Map image file backing a remote module
+    /// </summary>
+    /// <param name="imagePath">Module file path</param>
+    /// <param name="remoteBase">Module base in the remote process</param>
+    /// <param name="remoteSize">Module image size</param>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS Map( const std::wstring& imagePath, ptr_t remoteBase, size_t remoteSize );
+
+    /// <summary>
+    /// Unmap view and release section
+    /// </summary>
+    BLACKBONE_API void Unmap();
+
+    /// <summary>
+    /// Translate remote address to a local pointer inside the view
+    /// </summary>
+    /// <param name="remoteAddress">Address in the remote process</param>
+    /// <returns>Local pointer, nullptr if address is outside the mirrored module</returns>
+    BLACKBONE_API void* translate( ptr_t remoteAddress ) const
+    {
+        if (!_pView || remoteAddress < _remoteBase || remoteAddress >= _remoteBase + _size)
+            return nullptr;
+
+        return reinterpret_cast<uint8_t*>(_pView) + (remoteAddress - _remoteBase);
+    }
+
+    BLACKBONE_API void* base() const { return _pView; }
+    BLACKBONE_API ptr_t remoteBase() const { return _remoteBase; }
+    BLACKBONE_API size_t size() const { return _size; }
+    BLACKBONE_API bool valid() const { return _pView != nullptr; }
+
+private:
+    MemoryMirror( const MemoryMirror& ) = delete;
+    MemoryMirror& operator =( const MemoryMirror& ) = delete;
+
+private:
+    void* _pView = nullptr;     // Local SEC_IMAGE view
+    ptr_t _remoteBase = 0;      // Module base in the remote process
+    size_t _size = 0;           // Mirrored size
+};
+
+}
@@ -0,0 +1,128 @@
+#include "ModuleSnapshot.h"
+#include "../Misc/HashKernels.h"
+
+#include <algorithm>
+
+namespace blackbone
+{
+
+namespace
+{
+const size_t pageSize = 0x1000;
+}
+
+ModuleSnapshot::~ModuleSnapshot()
+{
+    Reset();
+}
+
+/// <summary>
+/// Capture a baseline for a module loaded in the current process
+/// </summary>
+/// <param name="hMod">Module handle</param>
+/// <returns>Status</returns>
+NTSTATUS ModuleSnapshot::Capture( HMODULE hMod )
+{
+    if (hMod == NULL)
+        return STATUS_INVALID_PARAMETER;
+
+    Reset();
+
+    wchar_t path[MAX_PATH] = { 0 };
+    if (GetModuleFileNameW( hMod, path, _countof( path ) ) == 0)
+        return STATUS_NOT_FOUND;
+
+    HANDLE hFile = CreateFileW( path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if (hFile == INVALID_HANDLE_VALUE)
+        return STATUS_NOT_FOUND;
+
+    // SEC_IMAGE reuses the file's existing image section, so the view
+    // shares physical pages with the loaded module until divergence and
+    // carries the same per-boot relocated bytes
+    _mapping = CreateFileMappingW( hFile, nullptr, PAGE_READONLY | SEC_IMAGE, 0, 0, nullptr );
+    CloseHandle( hFile );
+    if (_mapping == NULL)
+        return STATUS_INVALID_IMAGE_FORMAT;
+
+    _baseline = static_cast<const uint8_t*>(MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 ));
+    if (_baseline == nullptr)
+    {
+        CloseHandle( _mapping );
+        _mapping = NULL;
+        return STATUS_MEMORY_NOT_ALLOCATED;
+    }
+
+    _module = reinterpret_cast<const uint8_t*>(hMod);
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Compare the live module against the baseline. Only non-writable
+/// sections are diffed - writable data diverges by design. Adjacent
+/// changed pages are coalesced into one range.
+/// </summary>
+/// <param name="changed">Receives changed ranges</param>
+/// <returns>Status</returns>
+NTSTATUS ModuleSnapshot::Diff( std::vector<ModuleChange>& changed ) const
+{
+    changed.clear();
+    if (_baseline == nullptr)
+        return STATUS_NOT_FOUND;
+
+    auto pDos = reinterpret_cast<const IMAGE_DOS_HEADER*>(_baseline);
+    auto pNt = reinterpret_cast<const IMAGE_NT_HEADERS*>(_baseline + pDos->e_lfanew);
+    auto pSections = IMAGE_FIRST_SECTION( pNt );
+
+    for (WORD i = 0; i < pNt->FileHeader.NumberOfSections; i++)
+    {
+        if (pSections[i].Characteristics & IMAGE_SCN_MEM_WRITE)
+            continue;
+        if (!(pSections[i].Characteristics & (IMAGE_SCN_CNT_CODE | IMAGE_SCN_CNT_INITIALIZED_DATA)))
+            continue;
+
+        const size_t sectionSize = pSections[i].Misc.VirtualSize;
+        const ptr_t sectionRva = pSections[i].VirtualAddress;
+
+        // Page-wise SIMD compare; a diverged page has become private in
+        // one of the views, an identical one is still the same physical
+        // page and the compare runs at memory bandwidth
+        for (size_t offset = 0; offset < sectionSize; offset += pageSize)
+        {
+            const size_t block = (std::min)( pageSize, sectionSize - offset );
+            const size_t diff = FirstDiff( _module + sectionRva + offset, _baseline + sectionRva + offset, block );
+            if (diff >= block)
+                continue;
+
+            const ptr_t rva = sectionRva + offset;
+            if (!changed.empty() && changed.back().rva + changed.back().size == rva)
+                changed.back().size += block;
+            else
+                changed.push_back( { rva, block } );
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Release the baseline view
+/// </summary>
+void ModuleSnapshot::Reset()
+{
+    if (_baseline != nullptr)
+    {
+        UnmapViewOfFile( _baseline );
+        _baseline = nullptr;
+    }
+
+    if (_mapping != NULL)
+    {
+        CloseHandle( _mapping );
+        _mapping = NULL;
+    }
+
+    _module = nullptr;
+}
+
+}
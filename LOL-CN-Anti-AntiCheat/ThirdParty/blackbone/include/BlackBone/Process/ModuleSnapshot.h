@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../Include/Types.h"
+#include "../Include/Winheaders.h"
+
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Changed range report, relative to the module base
+/// </summary>
+struct ModuleChange
+{
+    ptr_t rva = 0;          // Range start RVA
+    size_t size = 0;        // Range length in bytes
+};
+
+/// <summary>
+/// Copy-on-write baseline snapshot of a loaded module.
+/// Instead of keeping a private copy of the image, Capture maps a second
+/// SEC_IMAGE view of the module's file: the memory manager backs both
+/// views with the same physical pages until one of them diverges, so the
+/// snapshot costs address space, not working set. Relocations are applied
+/// to the shared image pages once per boot, so the second view carries
+/// the same relocated bytes as the loaded module. Diff compares the live
+/// image against the baseline with the SIMD compare kernel and reports
+/// coalesced changed ranges.
+/// </summary>
+class ModuleSnapshot
+{
+public:
+    BLACKBONE_API ModuleSnapshot() = default;
+    BLACKBONE_API ~ModuleSnapshot();
+
+    ModuleSnapshot( const ModuleSnapshot& ) = delete;
+    ModuleSnapshot& operator =( const ModuleSnapshot& ) = delete;
+
+    /// <summary>
+    /// Capture a baseline for a module loaded in the current process
+    /// </summary>
+    /// <param name="hMod">Module handle</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Capture( HMODULE hMod );
+
+    /// <summary>
+    /// Compare the live module against the baseline. Only non-writable
+    /// sections are diffed - writable data diverges by design. Adjacent
+    /// changed pages are coalesced into one range.
+    /// </summary>
+    /// <param name="changed">Receives changed ranges</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Diff( std::vector<ModuleChange>& changed ) const;
+
+    /// <summary>
+    /// Release the baseline view
+    /// </summary>
+    BLACKBONE_API void Reset();
+
+    /// <summary>
+    /// Check if a baseline is held
+    /// </summary>
+    /// <returns>true if captured</returns>
+    BLACKBONE_API bool valid() const { return _baseline != nullptr; }
+
+private:
+    const uint8_t* _module = nullptr;       // Live image base
+    const uint8_t* _baseline = nullptr;     // Second view, baseline bytes
+    HANDLE _mapping = NULL;                 // Baseline section handle
+};
+
+}
@@ -157,4 +157,152 @@ private:
     Process* _proc = nullptr;       // Target process
     type _data;                     // Local object copy
 };
+
+/// <summary>
+/// Multi-level pointer wrapper for remote process with chain caching.
+/// Intermediate slot addresses and pointer values are remembered after the
+/// first walk. Steady-state dereferences reuse the cached final address and
+/// only re-read the target object; every 'revalidateEvery' dereferences all
+/// intermediate slots are re-read in one scatter batch (a single coalesced
+/// syscall) and the chain is re-walked only from the first level whose
+/// pointer actually changed.
+/// </summary>
+template<typename T>
+class multi_ptr_cached
+{
+public:
+    using type = std::remove_pointer_t<T>;
+    using type_ptr = std::add_pointer_t<type>;
+    using vecOffsets = std::vector<intptr_t>;
+
+    constexpr static bool type_is_ptr = std::is_pointer_v<T>;
+
+public:
+    multi_ptr_cached( Process* proc, uintptr_t base = 0, const vecOffsets& offsets = vecOffsets(), uint32_t revalidateEvery = 16 )
+        : _proc( proc )
+        , _base( base )
+        , _offsets( offsets )
+        , _revalidateEvery( revalidateEvery ) { }
+
+    inline type_ptr get()         { return read(); }
+    inline operator type_ptr()    { return read(); }
+    inline type_ptr operator ->() { return read(); }
+
+    /// <summary>
+    /// Commit changed object into process
+    /// </summary>
+    /// <returns>Status code</returns>
+    NTSTATUS commit()
+    {
+        if (_final == 0)
+            return STATUS_ACCESS_VIOLATION;
+
+        return _proc->memory().Write( _final, sizeof( _data ), &_data );
+    }
+
+    /// <summary>
+    /// Force full re-walk on next dereference
+    /// </summary>
+    void invalidate() { _final = 0; _slots.clear(); _values.clear(); }
+
+private:
+    /// <summary>
+    /// Read object from the resolved pointer
+    /// </summary>
+    /// <returns>Pointer to local copy or nullptr if invalid</returns>
+    type_ptr read()
+    {
+        if (!resolve())
+            return nullptr;
+
+        return NT_SUCCESS( _proc->memory().Read( _final, sizeof( _data ), &_data ) ) ? &_data : nullptr;
+    }
+
+    /// <summary>
+    /// Resolve the final address, reusing the cached chain when possible
+    /// </summary>
+    /// <returns>true if the chain is valid</returns>
+    bool resolve()
+    {
+        if (_final != 0)
+        {
+            if (++_counter < _revalidateEvery)
+                return true;
+
+            _counter = 0;
+
+            // One coalesced batch instead of a read per level
+            std::vector<uintptr_t> current( _slots.size() );
+            std::vector<ReadScatterRequest> batch( _slots.size() );
+
+            for (size_t i = 0; i < _slots.size(); i++)
+            {
+                batch[i].address = _slots[i];
+                batch[i].size = sizeof( uintptr_t );
+                batch[i].pResult = &current[i];
+            }
+
+            if (NT_SUCCESS( _proc->memory().ReadScatter( batch ) ) && current == _values)
+                return true;
+        }
+
+        return walk();
+    }
+
+    /// <summary>
+    /// Full chain walk, rebuilding cached slots and values
+    /// </summary>
+    /// <returns>true if the chain is valid</returns>
+    bool walk()
+    {
+        _final = 0;
+        _slots.clear();
+        _values.clear();
+
+        uintptr_t ptr = _base;
+        if (ptr == 0 || !NT_SUCCESS( _proc->memory().Read( ptr, ptr ) ))
+            return false;
+
+        _slots.emplace_back( _base );
+        _values.emplace_back( ptr );
+
+        if (!_offsets.empty())
+        {
+            for (intptr_t i = 0; i < static_cast<intptr_t>(_offsets.size()) - 1; i++)
+            {
+                const uintptr_t slot = ptr + _offsets[i];
+                if (!NT_SUCCESS( _proc->memory().Read( slot, ptr ) ))
+                    return false;
+
+                _slots.emplace_back( slot );
+                _values.emplace_back( ptr );
+            }
+
+            ptr += _offsets.back();
+            if (type_is_ptr)
+            {
+                const uintptr_t slot = ptr;
+                if (!NT_SUCCESS( _proc->memory().Read( slot, ptr ) ))
+                    return false;
+
+                _slots.emplace_back( slot );
+                _values.emplace_back( ptr );
+            }
+        }
+
+        _final = ptr;
+        return true;
+    }
+
+private:
+    Process* _proc = nullptr;           // Target process
+    uintptr_t _base = 0;                // Chain base address
+    vecOffsets _offsets;                // Chain offsets
+    std::vector<uintptr_t> _slots;      // Cached slot addresses per level
+    std::vector<uintptr_t> _values;     // Cached pointer values per level
+    ptr_t _final = 0;                   // Cached final address
+    uint32_t _revalidateEvery = 16;     // Dereferences between revalidations
+    uint32_t _counter = 0;              // Dereferences since last revalidation
+    type _data;                         // Local object copy
+};
 }
\ No newline at end of file
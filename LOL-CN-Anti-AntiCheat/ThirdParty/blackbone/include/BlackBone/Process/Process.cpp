@@ -36,6 +36,27 @@ Process::~Process(void)
 /// <returns>Status code</returns>
 NTSTATUS Process::Attach( DWORD pid, DWORD access /*= DEFAULT_ACCESS_P*/ )
 {
+    // Fast re-attach: same pid, handle still open with the requested rights,
+    // process still alive. The open handle keeps the process object alive so
+    // the pid cannot have been recycled, the wow64 barrier is a property of
+    // that process, and the module cache stays warm. One exit-code query
+    // replaces the full open/subsystem-detect/reconstruct sequence.
+    if (pid != 0 && pid == _core.pid() && _core.handle() != nullptr)
+    {
+        DWORD exitCode = 0;
+        if (GetExitCodeProcess( _core.handle(), &exitCode ) && exitCode == STILL_ACTIVE)
+        {
+            if ((access & _core.grantedAccess()) == access)
+                return STATUS_SUCCESS;
+
+            // Broader rights requested: duplicate the live handle with the
+            // widened mask instead of close/reopen, which would drop the
+            // handle-table entry and race any handle protection
+            if (NT_SUCCESS( _core.UpgradeAccess( access ) ))
+                return STATUS_SUCCESS;
+        }
+    }
+
     Detach();
     return _core.Open( pid, access );
 }
@@ -13,6 +13,7 @@
 #include "../Include/NativeStructures.h"
 #include "../Include/CallResult.h"
 #include "../Misc/InitOnce.h"
+#include "../Misc/StagingPool.hpp"
 
 #include <string>
 #include <list>
@@ -210,6 +211,7 @@ public:
     BLACKBONE_API RemoteExec&      remote()     { return _remote;     }  // Remote code execution
     BLACKBONE_API MMap&            mmap()       { return _mmap;       }  // Manual module mapping
     BLACKBONE_API NtLdr&           nativeLdr()  { return _nativeLdr;  }  // Native loader routines
+    BLACKBONE_API StagingPool&     stagingPool(){ return _staging;    }  // Reusable bulk-read buffers
 
     // Sugar
     BLACKBONE_API const Wow64Barrier& barrier() const { return _core._native->GetWow64Barrier(); }
@@ -228,6 +230,7 @@ private:
     RemoteExec      _remote;        // Remote code execution
     MMap            _mmap;          // Manual module mapping
     NtLdr           _nativeLdr;     // Native loader routines
+    StagingPool     _staging;       // Reusable bulk-read buffers
 };
 
 }
@@ -39,6 +39,9 @@ NTSTATUS ProcessCore::Open( DWORD pid, DWORD access )
     if (_hProcess)
     {
         _pid = pid;
+
+        // Pseudo handle and the win10 reopen both carry full rights
+        _access = (pid == GetCurrentProcessId()) ? PROCESS_ALL_ACCESS : access;
         return Init();
     }
 
@@ -60,25 +63,93 @@ NTSTATUS ProcessCore::Open( HANDLE handle )
 }
 
 
+/// <summary>
+/// Get access mask covering the given feature set
+/// </summary>
+/// <param name="features">Combination of ProcessFeatures flags</param>
+/// <returns>Access mask</returns>
+DWORD ProcessCore::AccessFromFeatures( DWORD features )
+{
+    DWORD access = PROCESS_QUERY_INFORMATION;
+
+    if (features & pf_memoryRead)
+        access |= PROCESS_VM_READ;
+    if (features & pf_memoryWrite)
+        access |= PROCESS_VM_WRITE | PROCESS_VM_OPERATION;
+    if (features & pf_remoteExec)
+        access |= PROCESS_CREATE_THREAD | PROCESS_SET_QUOTA | PROCESS_SUSPEND_RESUME;
+    if (features & pf_handleAccess)
+        access |= PROCESS_DUP_HANDLE;
+    if (features & pf_terminate)
+        access |= PROCESS_TERMINATE;
+
+    return access;
+}
+
+/// <summary>
+/// Upgrade handle rights in place through NtDuplicateObject.
+/// The process object is never released, so the pid cannot be
+/// recycled and no open/close window is exposed. Granted rights
+/// accumulate in the cached access bitmap
+/// </summary>
+/// <param name="access">Additionally required rights</param>
+/// <returns>Status</returns>
+NTSTATUS ProcessCore::UpgradeAccess( DWORD access )
+{
+    if (!_hProcess)
+        return STATUS_INVALID_HANDLE;
+
+    // Cached bitmap already covers the request
+    if ((access & _access) == access)
+        return STATUS_SUCCESS;
+
+    const DWORD mask = _access | access;
+
+    ProcessHandle hUpgraded;
+    NTSTATUS status = SAFE_NATIVE_CALL(
+        NtDuplicateObject,
+        GetCurrentProcess(), static_cast<HANDLE>(_hProcess),
+        GetCurrentProcess(), &hUpgraded,
+        mask, 0, 0
+        );
+
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    _hProcess = std::move( hUpgraded );
+    _access = mask;
+
+    // Subsystem keeps a raw copy of the handle
+    return Init();
+}
+
 /// <summary>
 /// Initialize some internal data
 /// </summary>
 /// <returns>Status code</returns>
 NTSTATUS ProcessCore::Init()
 {
-    // Detect x86 OS
-    SYSTEM_INFO info = { { 0 } };
-    GetNativeSystemInfo( &info );
+    // Detect x86 OS, constant for the OS lifetime
+    static const bool x86OS = []()
+    {
+        SYSTEM_INFO info = { { 0 } };
+        GetNativeSystemInfo( &info );
+        return info.wProcessorArchitecture == PROCESSOR_ARCHITECTURE_INTEL;
+    }();
 
-    if (info.wProcessorArchitecture == PROCESSOR_ARCHITECTURE_INTEL)
+    if (x86OS)
     {
         _native = std::make_unique<x86Native>( _hProcess );
     }
     else
     {
-        // Detect wow64 barrier
-        BOOL wowSrc = FALSE;
-        IsWow64Process( GetCurrentProcess(), &wowSrc );
+        // Detect wow64 barrier, own bitness never changes
+        static const BOOL wowSrc = []()
+        {
+            BOOL wow = FALSE;
+            IsWow64Process( GetCurrentProcess(), &wow );
+            return wow;
+        }();
 
         if (wowSrc == TRUE)
             _native = std::make_unique<NativeWow64>( _hProcess );
@@ -112,6 +183,7 @@ void ProcessCore::Close()
     _hProcess.reset();
     _native.reset();
     _pid = 0;
+    _access = 0;
 }
 
 bool ProcessCore::isProtected()
@@ -11,15 +11,42 @@
 namespace blackbone
 {
 
+// Feature groups used to derive an upfront process access mask, so a
+// handle can be opened once with everything the enabled features need
+enum ProcessFeatures : DWORD
+{
+    pf_memoryRead   = 0x01,     // Read remote memory
+    pf_memoryWrite  = 0x02,     // Write/protect remote memory
+    pf_remoteExec   = 0x04,     // Threads, APC, suspend/resume
+    pf_handleAccess = 0x08,     // Handle duplication and queries
+    pf_terminate    = 0x10,     // Process termination
+
+    pf_all = pf_memoryRead | pf_memoryWrite | pf_remoteExec | pf_handleAccess | pf_terminate
+};
+
 class ProcessCore
 {
 public:
+    /// <summary>
+    /// Get access mask covering the given feature set
+    /// </summary>
+    /// <param name="features">Combination of ProcessFeatures flags</param>
+    /// <returns>Access mask</returns>
+    BLACKBONE_API static DWORD AccessFromFeatures( DWORD features );
+
 
     /// <summary>
     /// Check if target process is running in WOW64 mode
     /// </summary>
     /// <returns>true if process is WOW64</returns>
-    BLACKBONE_API inline bool isWow64() const { return _native->GetWow64Barrier().targetWow64; }
+    BLACKBONE_API inline bool isWow64() const { return barrier().targetWow64; }
+
+    /// <summary>
+    /// Get precomputed WOW64 barrier descriptor.
+    /// Derived once on open, no queries at call time
+    /// </summary>
+    /// <returns>Barrier info</returns>
+    BLACKBONE_API inline const Wow64Barrier& barrier() const { return _native->GetWow64Barrier(); }
 
     /// <summary>
     /// Get process handle
@@ -38,6 +65,12 @@ public:
     /// </summary>
     /// <returns>true if DEP is enabled for process</returns>
     BLACKBONE_API inline bool DEP() const { return _dep; };
+
+    /// <summary>
+    /// Get access rights the process handle was opened with
+    /// </summary>
+    /// <returns>Access mask, 0 if opened from a foreign handle</returns>
+    BLACKBONE_API inline DWORD grantedAccess() const { return _access; }
   
     /// <summary>
     /// Get system routines
@@ -97,6 +130,16 @@ private:
     /// <returns>Status</returns>
     NTSTATUS Open( HANDLE handle );
 
+    /// <summary>
+    /// Upgrade handle rights in place through NtDuplicateObject.
+    /// The process object is never released, so the pid cannot be
+    /// recycled and no open/close window is exposed. Granted rights
+    /// accumulate in the cached access bitmap
+    /// </summary>
+    /// <param name="access">Additionally required rights</param>
+    /// <returns>Status</returns>
+    NTSTATUS UpgradeAccess( DWORD access );
+
     /// <summary>
     /// Initialize some internal data
     /// </summary>
@@ -111,6 +154,7 @@ private:
 private:
     ProcessHandle _hProcess;        // Process handle
     DWORD         _pid = 0;         // Process ID
+    DWORD         _access = 0;      // Rights the handle was opened with
     ptrNative     _native;          // Api wrapper
     bool          _dep = true;      // DEP state for process
 };
@@ -2,6 +2,9 @@
 #include "Process.h"
 #include "../Misc/Trace.hpp"
 
+#include <algorithm>
+#include <thread>
+
 namespace blackbone
 {
 
@@ -60,6 +63,54 @@ NTSTATUS ProcessMemory::Query( ptr_t pAddr, PMEMORY_BASIC_INFORMATION64 pInfo )
     return _core.native()->VirtualQueryExT( pAddr, pInfo );
 }
 
+/// <summary>
+/// Get memory region info from the cached memory map snapshot
+/// </summary>
+/// <param name="pAddr">Memory address</param>
+/// <param name="pInfo">Retrieved info</param>
+/// <returns>Status</returns>
+NTSTATUS ProcessMemory::QueryCached( ptr_t pAddr, PMEMORY_BASIC_INFORMATION64 pInfo )
+{
+    if (_mapGeneration == 0)
+        RefreshMap();
+
+    // Last region starting at or before the address
+    auto it = std::upper_bound(
+        _mapSnapshot.begin(), _mapSnapshot.end(), pAddr,
+        []( ptr_t addr, const MEMORY_BASIC_INFORMATION64& mbi ) { return addr < mbi.BaseAddress; }
+        );
+
+    if (it != _mapSnapshot.begin())
+    {
+        --it;
+        if (pAddr >= it->BaseAddress && pAddr < it->BaseAddress + it->RegionSize)
+        {
+            *pInfo = *it;
+            return STATUS_SUCCESS;
+        }
+    }
+
+    // Not covered by the snapshot - ask the kernel
+    return Query( pAddr, pInfo );
+}
+
+/// <summary>
+/// Re-enumerate the remote memory map and bump the snapshot generation
+/// </summary>
+/// <returns>New generation number</returns>
+uint32_t ProcessMemory::RefreshMap()
+{
+    _mapSnapshot = _core.native()->EnumRegions( true );
+
+    std::sort( _mapSnapshot.begin(), _mapSnapshot.end(),
+        []( const MEMORY_BASIC_INFORMATION64& a, const MEMORY_BASIC_INFORMATION64& b )
+        {
+            return a.BaseAddress < b.BaseAddress;
+        } );
+
+    return ++_mapGeneration;
+}
+
 /// <summary>
 /// Change memory protection
 /// </summary>
@@ -102,6 +153,15 @@ NTSTATUS ProcessMemory::Read( ptr_t dwAddress, size_t dwSize, PVOID pResult, boo
     // Read all committed memory regions
     else
     {
+        struct ReadRun
+        {
+            ptr_t start;
+            size_t size;
+        };
+
+        // Walk the region map once and merge adjacent readable regions,
+        // so each run costs one large read instead of many small ones
+        std::vector<ReadRun> runs;
         MEMORY_BASIC_INFORMATION64 mbi = { 0 };
 
         for (ptr_t memptr = dwAddress; memptr < dwAddress + dwSize; memptr = mbi.BaseAddress + mbi.RegionSize)
@@ -113,17 +173,73 @@ NTSTATUS ProcessMemory::Read( ptr_t dwAddress, size_t dwSize, PVOID pResult, boo
             if (mbi.State != MEM_COMMIT || mbi.Protect == PAGE_NOACCESS)
                 continue;
 
-            uint64_t region_ptr = memptr - dwAddress;
+            // Clip region to the requested range
+            const ptr_t runStart = (std::max)( static_cast<ptr_t>(mbi.BaseAddress), dwAddress );
+            const ptr_t runEnd = (std::min)( mbi.BaseAddress + mbi.RegionSize, dwAddress + dwSize );
+            if (runEnd <= runStart)
+                continue;
+
+            if (!runs.empty() && runs.back().start + runs.back().size == runStart)
+                runs.back().size += static_cast<size_t>(runEnd - runStart);
+            else
+                runs.emplace_back( ReadRun{ runStart, static_cast<size_t>(runEnd - runStart) } );
+        }
 
-            auto status = _core.native()->ReadProcessMemoryT(
-                mbi.BaseAddress,
-                reinterpret_cast<uint8_t*>(pResult) + region_ptr,
-                static_cast<size_t>(mbi.RegionSize),
-                &dwRead
+        auto readRun = [&]( const ReadRun& run ) -> NTSTATUS
+        {
+            DWORD64 read = 0;
+            return _core.native()->ReadProcessMemoryT(
+                run.start,
+                reinterpret_cast<uint8_t*>(pResult) + (run.start - dwAddress),
+                run.size,
+                &read
             );
+        };
+
+        // Spread runs across a worker pool when there is enough work to hide
+        // the thread startup cost, otherwise stay serial
+        constexpr size_t parallelThreshold = 4 * 1024 * 1024;
+
+        size_t total = 0;
+        for (const auto& run : runs)
+            total += run.size;
+
+        size_t workers = (std::min)( { runs.size(), static_cast<size_t>(std::thread::hardware_concurrency()), total / parallelThreshold } );
+
+        if (workers > 1)
+        {
+            std::vector<NTSTATUS> statuses( workers, STATUS_SUCCESS );
+            std::vector<std::thread> pool;
+            pool.reserve( workers );
+
+            for (size_t w = 0; w < workers; w++)
+            {
+                pool.emplace_back( [&, w]()
+                {
+                    for (size_t i = w; i < runs.size(); i += workers)
+                    {
+                        auto status = readRun( runs[i] );
+                        if (!NT_SUCCESS( status ) && NT_SUCCESS( statuses[w] ))
+                            statuses[w] = status;
+                    }
+                } );
+            }
+
+            for (auto& worker : pool)
+                worker.join();
 
-            if (!NT_SUCCESS( status ))
-                return status;
+            for (auto status : statuses)
+                if (!NT_SUCCESS( status ))
+                    return status;
+        }
+        else
+        {
+            for (const auto& run : runs)
+            {
+                auto status = readRun( run );
+                if (!NT_SUCCESS( status ))
+                    return status;
+            }
         }
     }
 
@@ -157,6 +273,84 @@ NTSTATUS ProcessMemory::Read( const std::vector<ptr_t>& adrList, size_t dwSize,
     return Read( ptr + adrList.back(), dwSize, pResult, handleHoles );
 }
 
+/// <summary>
+/// Read many independent entries with a minimal number of syscalls
+/// </summary>
+/// <param name="requests">Read entries, per-entry status is filled</param>
+/// <returns>STATUS_SUCCESS if every entry succeeded, otherwise first error</returns>
+NTSTATUS ProcessMemory::ReadScatter( std::vector<ReadScatterRequest>& requests )
+{
+    constexpr ptr_t pageMask = 0xFFF;
+    constexpr size_t maxSpan = 1024 * 1024;     // Never merge into spans larger than 1 MB
+
+    if (requests.empty())
+        return STATUS_INVALID_PARAMETER;
+
+    // Process entries in address order without disturbing caller's ordering
+    std::vector<size_t> order( requests.size() );
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    std::sort( order.begin(), order.end(), [&requests]( size_t a, size_t b )
+    {
+        return requests[a].address < requests[b].address;
+    } );
+
+    std::vector<uint8_t> staging;
+    NTSTATUS firstError = STATUS_SUCCESS;
+
+    for (size_t i = 0; i < order.size();)
+    {
+        // Grow span while the next entry starts on a page the span already touches
+        ptr_t spanStart = requests[order[i]].address & ~pageMask;
+        ptr_t spanEnd = (requests[order[i]].address + requests[order[i]].size + pageMask) & ~pageMask;
+
+        size_t j = i + 1;
+        for (; j < order.size(); j++)
+        {
+            const auto& next = requests[order[j]];
+            const ptr_t nextStart = next.address & ~pageMask;
+            const ptr_t nextEnd = (next.address + next.size + pageMask) & ~pageMask;
+
+            if (nextStart > spanEnd || nextEnd - spanStart > maxSpan)
+                break;
+
+            if (nextEnd > spanEnd)
+                spanEnd = nextEnd;
+        }
+
+        const size_t spanSize = static_cast<size_t>(spanEnd - spanStart);
+        if (staging.size() < spanSize)
+            staging.resize( spanSize );
+
+        DWORD64 read = 0;
+        auto status = _core.native()->ReadProcessMemoryT( spanStart, staging.data(), spanSize, &read );
+
+        for (size_t k = i; k < j; k++)
+        {
+            auto& entry = requests[order[k]];
+
+            if (NT_SUCCESS( status ))
+            {
+                memcpy( entry.pResult, staging.data() + (entry.address - spanStart), entry.size );
+                entry.status = STATUS_SUCCESS;
+            }
+            else
+            {
+                // Span touched an unreadable page, retry this entry on its own
+                entry.status = Read( entry.address, entry.size, entry.pResult );
+            }
+
+            if (!NT_SUCCESS( entry.status ) && NT_SUCCESS( firstError ))
+                firstError = entry.status;
+        }
+
+        i = j;
+    }
+
+    return firstError;
+}
+
 /// <summary>
 /// Write data
 /// </summary>
@@ -192,6 +386,19 @@ NTSTATUS ProcessMemory::Write( const std::vector<ptr_t>& adrList, size_t dwSize,
     return Write( ptr + adrList.back(), dwSize, pData );
 }
 
+/// <summary>
+/// Create zero-copy local mirror of a remote module's image bytes
+/// </summary>
+/// <param name="imagePath">Module file path</param>
+/// <param name="remoteBase">Module base in the remote process</param>
+/// <param name="remoteSize">Module image size, 0 to take the view size</param>
+/// <param name="mirror">Resulting mirror</param>
+/// <returns>Status</returns>
+NTSTATUS ProcessMemory::MirrorModule( const std::wstring& imagePath, ptr_t remoteBase, size_t remoteSize, MemoryMirror& mirror )
+{
+    return mirror.Map( imagePath, remoteBase, remoteSize );
+}
+
 /// <summary>
 /// Enumerate valid memory regions
 /// </summary>
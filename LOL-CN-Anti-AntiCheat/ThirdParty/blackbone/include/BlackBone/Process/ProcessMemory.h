@@ -3,6 +3,7 @@
 #include "../Include/Winheaders.h"
 #include "RPC/RemoteMemory.h"
 #include "MemBlock.h"
+#include "MemoryMirror.h"
 
 #include <vector>
 #include <list>
@@ -10,6 +11,17 @@
 namespace blackbone
 {
 
+/// <summary>
+/// One entry of a scatter read
+/// </summary>
+struct ReadScatterRequest
+{
+    ptr_t address = 0;                          // Remote address to read from
+    size_t size = 0;                            // Size of data to read
+    PVOID pResult = nullptr;                    // Output buffer
+    NTSTATUS status = STATUS_UNSUCCESSFUL;      // Per-entry result
+};
+
 class ProcessMemory : public RemoteMemory
 {
 public:
@@ -43,6 +55,29 @@ public:
     /// <returns>Status</returns>
     BLACKBONE_API NTSTATUS Query( ptr_t pAddr, PMEMORY_BASIC_INFORMATION64 pInfo );
 
+    /// <summary>
+    /// Get memory region info from the cached memory map snapshot.
+    /// The snapshot is materialized in one enumeration pass and lookups are
+    /// served by binary search without kernel transitions. Callers control
+    /// staleness through RefreshMap and the generation counter; addresses
+    /// outside the snapshot fall back to a live Query.
+    /// </summary>
+    /// <param name="pAddr">Memory address</param>
+    /// <param name="pInfo">Retrieved info</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS QueryCached( ptr_t pAddr, PMEMORY_BASIC_INFORMATION64 pInfo );
+
+    /// <summary>
+    /// Re-enumerate the remote memory map and bump the snapshot generation
+    /// </summary>
+    /// <returns>New generation number</returns>
+    BLACKBONE_API uint32_t RefreshMap();
+
+    /// <summary>
+    /// Current snapshot generation, 0 if no snapshot was taken yet
+    /// </summary>
+    BLACKBONE_API uint32_t mapGeneration() const { return _mapGeneration; }
+
     /// <summary>
     /// Change memory protection
     /// </summary>
@@ -79,6 +114,16 @@ public:
     /// <returns>Status</returns>
     BLACKBONE_API NTSTATUS Read( const std::vector<ptr_t>& adrList, size_t dwSize, PVOID pResult, bool handleHoles = false );
 
+    /// <summary>
+    /// Read many independent entries with a minimal number of syscalls.
+    /// Entries whose pages overlap or touch are coalesced into one remote
+    /// read of the covering span and sliced into the per-entry buffers
+    /// locally. Entry order does not matter, results land in-place.
+    /// </summary>
+    /// <param name="requests">Read entries, per-entry status is filled</param>
+    /// <returns>STATUS_SUCCESS if every entry succeeded, otherwise first error</returns>
+    BLACKBONE_API NTSTATUS ReadScatter( std::vector<ReadScatterRequest>& requests );
+
     /// <summary>
     /// Write data
     /// </summary>
@@ -171,6 +216,19 @@ public:
         return Write( std::forward<std::vector<ptr_t>>( adrList ), sizeof( T ), &data );
     }
 
+    /// <summary>
+    /// Create zero-copy local mirror of a remote module's image bytes.
+    /// The module's backing file is mapped as SEC_IMAGE locally, after which
+    /// reads over the module cost no syscalls. Runtime modifications made by
+    /// the remote process to its private copies are not reflected.
+    /// </summary>
+    /// <param name="imagePath">Module file path</param>
+    /// <param name="remoteBase">Module base in the remote process</param>
+    /// <param name="remoteSize">Module image size, 0 to take the view size</param>
+    /// <param name="mirror">Resulting mirror</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS MirrorModule( const std::wstring& imagePath, ptr_t remoteBase, size_t remoteSize, MemoryMirror& mirror );
+
     /// <summary>
     /// Enumerate valid memory regions
     /// </summary>
@@ -188,6 +246,9 @@ private:
 private:
     class Process* _process;    // Owning process object
     class ProcessCore& _core;   // Core routines
+
+    std::vector<MEMORY_BASIC_INFORMATION64> _mapSnapshot;   // Cached memory map, sorted by base
+    uint32_t _mapGeneration = 0;                            // Snapshot generation counter
 };
 
 }
\ No newline at end of file
@@ -19,6 +19,25 @@
 
 namespace blackbone
 {
+
+namespace
+{
+// FNV-1a, 64 bit
+inline uint64_t hashExportName( const char* name )
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (; *name; name++)
+        hash = (hash ^ static_cast<uint8_t>(*name)) * 0x100000001B3ull;
+
+    return hash;
+}
+
+// Loader notification routines, not present in SDK headers
+using fnLdrDllNotification = void( CALLBACK* )(ULONG reason, const void* pData, void* pContext);
+using fnLdrRegisterDllNotification = NTSTATUS( NTAPI* )(ULONG flags, fnLdrDllNotification callback, void* pContext, void** pCookie);
+using fnLdrUnregisterDllNotification = NTSTATUS( NTAPI* )(void* cookie);
+}
+
 ProcessModules::ProcessModules( class Process& proc )
     : _proc( proc )
     , _memory( _proc.memory() )
@@ -29,6 +48,106 @@ ProcessModules::ProcessModules( class Process& proc )
 
 ProcessModules::~ProcessModules()
 {
+    if (_ldrNotifyCookie != nullptr)
+    {
+        auto pUnregister = reinterpret_cast<fnLdrUnregisterDllNotification>(
+            GetProcAddress( GetModuleHandleW( L"ntdll.dll" ), "LdrUnregisterDllNotification" ));
+
+        if (pUnregister != nullptr)
+            pUnregister( _ldrNotifyCookie );
+    }
+}
+
+/// <summary>
+/// Local DLL load/unload notification callback
+/// </summary>
+void CALLBACK ProcessModules::LoadNotification( ULONG /*reason*/, const void* /*pData*/, void* pContext )
+{
+    reinterpret_cast<ProcessModules*>(pContext)->_loadEvents.fetch_add( 1, std::memory_order_relaxed );
+}
+
+/// <summary>
+/// Register for local DLL-load notifications, once
+/// </summary>
+void ProcessModules::InitLoadNotification()
+{
+    if (_ldrNotifyTried)
+        return;
+
+    _ldrNotifyTried = true;
+
+    auto pRegister = reinterpret_cast<fnLdrRegisterDllNotification>(
+        GetProcAddress( GetModuleHandleW( L"ntdll.dll" ), "LdrRegisterDllNotification" ));
+
+    if (pRegister != nullptr)
+        pRegister( 0, &ProcessModules::LoadNotification, this, &_ldrNotifyCookie );
+}
+
+/// <summary>
+/// Check if the target loader list may have changed since the last call.
+/// Local process - DLL-load notification counter, remote process -
+/// loader list head links. Errs on the side of reporting a change.
+/// </summary>
+/// <param name="type">Module type. 32 bit or 64 bit</param>
+/// <returns>true if the module cache must be refreshed</returns>
+bool ProcessModules::LoaderListChanged( eModType type )
+{
+    // Local process: rely on loader notifications
+    if (_core.pid() == GetCurrentProcessId())
+    {
+        InitLoadNotification();
+        if (_ldrNotifyCookie != nullptr)
+        {
+            const uint32_t events = _loadEvents.load( std::memory_order_relaxed );
+            if (events == _loadEventsSeen)
+                return false;
+
+            _loadEventsSeen = events;
+            return true;
+        }
+    }
+
+    // Remote process: compare loader list head links. Loads and unloads
+    // relink the list, a middle-of-list unlink by other tooling does not -
+    // that case still goes through GetModule revalidation on lookup miss.
+    ptr_t head[2] = { 0, 0 };
+
+    if (type == mt_mod32)
+    {
+        _PEB32 peb = { 0 };
+        _LIST_ENTRY_T<uint32_t> links = { 0, 0 };
+
+        if (_core.peb32( &peb ) == 0 || peb.Ldr == 0)
+            return true;
+
+        if (!NT_SUCCESS( _memory.Read( peb.Ldr + offsetOf( &_PEB_LDR_DATA232::InLoadOrderModuleList ), links ) ))
+            return true;
+
+        head[0] = links.Flink;
+        head[1] = links.Blink;
+    }
+    else
+    {
+        _PEB64 peb = { 0 };
+        _LIST_ENTRY_T<uint64_t> links = { 0, 0 };
+
+        if (_core.peb64( &peb ) == 0 || peb.Ldr == 0)
+            return true;
+
+        if (!NT_SUCCESS( _memory.Read( peb.Ldr + offsetOf( &_PEB_LDR_DATA264::InLoadOrderModuleList ), links ) ))
+            return true;
+
+        head[0] = links.Flink;
+        head[1] = links.Blink;
+    }
+
+    auto& snap = _ldrHeadSnap[type == mt_mod32 ? 0 : 1];
+    if (head[0] != 0 && head[0] == snap[0] && head[1] == snap[1])
+        return false;
+
+    snap[0] = head[0];
+    snap[1] = head[1];
+    return true;
 }
 
 /// <summary>
@@ -73,8 +192,10 @@ ModuleDataPtr ProcessModules::GetModule(
 
     auto key = std::make_pair( name, type );
 
-    // Fast lookup
-    if (_modules.count( key ) && (_modules[key]->manual || ValidateModule( _modules[key]->baseAddress )))
+    // Fast lookup. While the loader list is unchanged the cached entry is
+    // served as-is, skipping remote header validation entirely
+    if (_modules.count( key ) &&
+        (_modules[key]->manual || !LoaderListChanged( type ) || ValidateModule( _modules[key]->baseAddress )))
         return _modules[key];
 
     UpdateModuleCache( search, type );
@@ -163,6 +284,10 @@ const ProcessModules::mapModules& ProcessModules::GetAllModules( eModSeachType s
     eModType mt = _core.isWow64() ? mt_mod32 : mt_mod64;
     CSLock lck( _modGuard );
 
+    // Serve the cached snapshot while no load or unload has happened
+    if (search == LdrList && !_modules.empty() && !LoaderListChanged( mt ))
+        return _modules;
+
     // Remove non-manual modules
     for (auto iter = _modules.begin(); iter != _modules.end();)
     {
@@ -198,6 +323,84 @@ ProcessModules::mapModules ProcessModules::GetManualModules()
     return mods;
 }
 
+/// <summary>
+/// Enumerate process modules from the loader list without per-entry
+/// heap allocations. Name strings live in the caller-supplied arena
+/// and stay valid until it is reset.
+/// </summary>
+/// <param name="arena">String storage</param>
+/// <param name="result">Found modules, appended</param>
+/// <param name="type">Module type. 32 bit or 64 bit</param>
+/// <returns>Number of modules found</returns>
+size_t ProcessModules::EnumModulesLight( ModuleArena& arena, std::vector<ModuleDataLight>& result, eModType type /*= mt_default*/ )
+{
+    if (type == mt_default)
+        type = _proc.barrier().targetWow64 ? mt_mod32 : mt_mod64;
+
+    return type == mt_mod32 ?
+        EnumModulesLightT<uint32_t>( arena, result ) :
+        EnumModulesLightT<uint64_t>( arena, result );
+}
+
+/// <summary>
+/// Loader list walk behind EnumModulesLight
+/// </summary>
+/// <param name="arena">String storage</param>
+/// <param name="result">Found modules, appended</param>
+/// <returns>Number of modules found</returns>
+template<typename T>
+size_t ProcessModules::EnumModulesLightT( ModuleArena& arena, std::vector<ModuleDataLight>& result )
+{
+    NTSTATUS status = STATUS_SUCCESS;
+    _PEB_T<T> peb = { };
+    _PEB_LDR_DATA2_T<T> ldr = { };
+
+    ptr_t pebPtr = 0;
+    if constexpr (sizeof( T ) == sizeof( uint32_t ))
+        pebPtr = _core.peb32( reinterpret_cast<_PEB32*>(&peb) );
+    else
+        pebPtr = _core.peb64( reinterpret_cast<_PEB64*>(&peb) );
+
+    if (pebPtr == 0 || peb.Ldr == 0 || !NT_SUCCESS( _memory.Read( peb.Ldr, ldr ) ))
+        return 0;
+
+    const size_t sizeBefore = result.size();
+
+    for (T head = ldr.InLoadOrderModuleList.Flink;
+        NT_SUCCESS( status ) && head != (peb.Ldr + FIELD_OFFSET( _PEB_LDR_DATA2_T<T>, InLoadOrderModuleList ));
+        status = _memory.Read( static_cast<ptr_t>(head), head ))
+    {
+        wchar_t localPath[512] = { 0 };
+        _LDR_DATA_TABLE_ENTRY_BASE_T<T> localdata = { { 0 } };
+
+        _memory.Read( head, localdata );
+        _memory.Read( localdata.FullDllName.Buffer, localdata.FullDllName.Length, localPath );
+
+        const size_t chars = localdata.FullDllName.Length / sizeof( wchar_t );
+        wchar_t* path = arena.alloc( chars + 1 );
+        if (path == nullptr)
+            break;
+
+        for (size_t i = 0; i < chars; i++)
+            path[i] = towlower( localPath[i] );
+        path[chars] = 0;
+
+        ModuleDataLight data;
+        data.baseAddress = localdata.DllBase;
+        data.size = localdata.SizeOfImage;
+        data.ldrPtr = static_cast<ptr_t>(head);
+        data.type = (sizeof( T ) < sizeof( uint64_t )) ? mt_mod32 : mt_mod64;
+        data.fullPath = std::wstring_view( path, chars );
+
+        const size_t sep = data.fullPath.find_last_of( L"\\/" );
+        data.name = sep != data.fullPath.npos ? data.fullPath.substr( sep + 1 ) : data.fullPath;
+
+        result.emplace_back( data );
+    }
+
+    return result.size() - sizeBefore;
+}
+
 /// <summary>
 /// Get export address. Forwarded exports will be automatically resolved if forward module is present
 /// </summary>
@@ -225,7 +428,102 @@ call_result_t<exportData> ProcessModules::GetExport( const ModuleData& hMod, con
     if (hMod.baseAddress == 0)
         return STATUS_INVALID_PARAMETER_1;
 
-    std::unique_ptr<IMAGE_EXPORT_DIRECTORY, decltype(&free)> expData( nullptr, &free );
+    auto index = GetExportIndex( hMod );
+    if (!index.success())
+        return index.status;
+
+    auto pIndex = index.result();
+    uint32_t rva = 0;
+
+    // Find by ordinal
+    if (reinterpret_cast<uintptr_t>(name_ord) <= 0xFFFF)
+    {
+        const WORD ordinal = static_cast<WORD>(reinterpret_cast<uintptr_t>(name_ord));
+        if (ordinal < pIndex->ordinalBase || ordinal - pIndex->ordinalBase >= pIndex->functions.size())
+            return STATUS_NOT_FOUND;
+
+        rva = pIndex->functions[ordinal - pIndex->ordinalBase];
+    }
+    // Find by hashed name
+    else
+    {
+        const uint64_t hash = hashExportName( name_ord );
+        const size_t mask = pIndex->table.size() - 1;
+
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            const auto& entry = pIndex->table[slot];
+            if (entry.hash == 0)
+                return STATUS_NOT_FOUND;
+
+            if (entry.hash == hash && strcmp( reinterpret_cast<const char*>(pIndex->blob.data() + entry.nameOfs), name_ord ) == 0)
+            {
+                rva = entry.rva;
+                break;
+            }
+        }
+    }
+
+    if (rva == 0)
+        return STATUS_NOT_FOUND;
+
+    data.procAddress = rva + hMod.baseAddress;
+
+    // Check forwarded export
+    if (data.procAddress >= hMod.baseAddress + pIndex->dirBase &&
+        data.procAddress <= hMod.baseAddress + pIndex->dirBase + pIndex->dirSize)
+    {
+        // Forward string already resides in the local directory copy
+        char forwardStr[255] = { 0 };
+        const size_t fwdOfs = rva - pIndex->dirBase;
+        memcpy( forwardStr, pIndex->blob.data() + fwdOfs, min( sizeof( forwardStr ) - 1, pIndex->blob.size() - fwdOfs ) );
+
+        std::string chainExp( forwardStr );
+
+        std::string strDll = chainExp.substr( 0, chainExp.find( "." ) ) + ".dll";
+        std::string strName = chainExp.substr( chainExp.find( "." ) + 1, strName.npos );
+        std::wstring wDll( Utils::AnsiToWstring( strDll ) );
+
+        // Fill export data info
+        data.isForwarded = true;
+        data.forwardModule = wDll;
+        data.forwardByOrd = (strName.find( "#" ) == 0);
+
+        if (data.forwardByOrd)
+            data.forwardOrdinal = static_cast<WORD>(atoi( strName.c_str() + 1 ));
+        else
+            data.forwardName = strName;
+
+        // Check if forward mod is loaded
+        auto hChainMod = GetModule( wDll, LdrList, pIndex->mtype, baseModule );
+        if (hChainMod == nullptr)
+            return call_result_t<exportData>( data, STATUS_SOME_NOT_MAPPED );
+
+        // Import by ordinal
+        if (data.forwardByOrd)
+            return GetExport( hChainMod, reinterpret_cast<const char*>(data.forwardOrdinal), wDll.c_str() );
+        // Import by name
+        else
+            return GetExport( hChainMod, strName.c_str(), wDll.c_str() );
+    }
+
+    return data;
+}
+
+/// <summary>
+/// Get cached export index for a module, building it on first use
+/// </summary>
+/// <param name="hMod">Module to index</param>
+/// <returns>Export index or error code</returns>
+call_result_t<ProcessModules::ExportIndex*> ProcessModules::GetExportIndex( const ModuleData& hMod )
+{
+    {
+        CSLock lck( _modGuard );
+
+        auto found = _exports.find( hMod.baseAddress );
+        if (found != _exports.end())
+            return found->second.get();
+    }
 
     IMAGE_DOS_HEADER hdrDos = { 0 };
     uint8_t hdrNt32[sizeof( IMAGE_NT_HEADERS64 )] = { 0 };
@@ -245,116 +543,93 @@ call_result_t<exportData> ProcessModules::GetExport( const ModuleData& hMod, con
         return STATUS_INVALID_IMAGE_FORMAT;
 
     if (phdrNt32->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR32_MAGIC)
+    {
         expBase = phdrNt32->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress;
+        expSize = phdrNt32->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size;
+    }
     else
+    {
         expBase = phdrNt64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress;
+        expSize = phdrNt64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size;
+    }
 
-    // Exports are present
-    if (expBase)
-    {
-        if (phdrNt32->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR32_MAGIC)
-            expSize = phdrNt32->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size;
-        else
-            expSize = phdrNt64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size;
+    // No exports present
+    if (expBase == 0)
+        return STATUS_NOT_FOUND;
+
+    auto index = std::make_unique<ExportIndex>();
+
+    // Single bulk read of the whole directory
+    index->blob.resize( expSize );
+    if (auto status = _memory.Read( hMod.baseAddress + expBase, expSize, index->blob.data() ); !NT_SUCCESS( status ))
+        return status;
 
-        expData.reset( reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(malloc( expSize )) );
-        IMAGE_EXPORT_DIRECTORY* pExpData = expData.get();
+    auto pExpData = reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(index->blob.data());
 
-        if( auto status = _memory.Read( hMod.baseAddress + expBase, expSize, pExpData ); !NT_SUCCESS( status ) )
+    // Fix invalid directory size
+    if (expSize <= sizeof( IMAGE_EXPORT_DIRECTORY ))
+    {
+        // New size should take care of max number of present names (max name length is assumed to be 255 chars)
+        expSize = static_cast<DWORD>(
+            pExpData->AddressOfNameOrdinals - expBase
+            + max( pExpData->NumberOfFunctions, pExpData->NumberOfNames ) * 255
+            );
+
+        index->blob.assign( expSize, 0 );
+        pExpData = reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(index->blob.data());
+        if (auto status = _memory.Read( hMod.baseAddress + expBase, expSize, index->blob.data() ); !NT_SUCCESS( status ))
             return status;
+    }
 
-        // Fix invalid directory size
-        if (expSize <= sizeof( IMAGE_EXPORT_DIRECTORY ))
-        {
-            // New size should take care of max number of present names (max name length is assumed to be 255 chars)
-            expSize = static_cast<DWORD>(
-                pExpData->AddressOfNameOrdinals - expBase
-                + max( pExpData->NumberOfFunctions, pExpData->NumberOfNames ) * 255
-                );
-
-            expData.reset( reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(malloc( expSize )) );
-            pExpData = expData.get();
-            if (auto status = _memory.Read( hMod.baseAddress + expBase, expSize, pExpData ); !NT_SUCCESS( status ))
-                return status;
-        }
+    index->dirBase = expBase;
+    index->dirSize = expSize;
+    index->ordinalBase = pExpData->Base;
+    index->mtype = (phdrNt32->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR32_MAGIC) ? mt_mod32 : mt_mod64;
 
-        WORD* pAddressOfOrds = reinterpret_cast<WORD*>(
-            pExpData->AddressOfNameOrdinals + reinterpret_cast<uintptr_t>(pExpData) - expBase);
+    const WORD* pAddressOfOrds = reinterpret_cast<const WORD*>(
+        index->blob.data() + (pExpData->AddressOfNameOrdinals - expBase));
 
-        DWORD* pAddressOfNames = reinterpret_cast<DWORD*>(
-            pExpData->AddressOfNames + reinterpret_cast<uintptr_t>(pExpData) - expBase);
+    const DWORD* pAddressOfNames = reinterpret_cast<const DWORD*>(
+        index->blob.data() + (pExpData->AddressOfNames - expBase));
 
-        DWORD* pAddressOfFuncs = reinterpret_cast<DWORD*>(
-            pExpData->AddressOfFunctions + reinterpret_cast<uintptr_t>(pExpData) - expBase);
+    const DWORD* pAddressOfFuncs = reinterpret_cast<const DWORD*>(
+        index->blob.data() + (pExpData->AddressOfFunctions - expBase));
 
-        for (DWORD i = 0; i < pExpData->NumberOfFunctions; ++i)
-        {
-            WORD OrdIndex = 0xFFFF;
-            char *pName = nullptr;
+    index->functions.assign( pAddressOfFuncs, pAddressOfFuncs + pExpData->NumberOfFunctions );
 
-            // Find by index
-            if (reinterpret_cast<uintptr_t>(name_ord) <= 0xFFFF)
-            {
-                OrdIndex = static_cast<WORD>(i);
-            }
-            // Find by name
-            else if (reinterpret_cast<uintptr_t>(name_ord) > 0xFFFF && i < pExpData->NumberOfNames)
-            {
-                pName = (char*)(pAddressOfNames[i] + reinterpret_cast<uintptr_t>(pExpData) - expBase);
-                OrdIndex = static_cast<WORD>(pAddressOfOrds[i]);
-            }
-            else
-                return STATUS_NOT_FOUND;
+    // Power-of-2 table sized for a load factor below 0.5
+    size_t tableSize = 16;
+    while (tableSize < pExpData->NumberOfNames * 2)
+        tableSize *= 2;
+
+    index->table.resize( tableSize );
+    const size_t tableMask = tableSize - 1;
+
+    for (DWORD i = 0; i < pExpData->NumberOfNames; i++)
+    {
+        const uint32_t nameOfs = pAddressOfNames[i] - static_cast<uint32_t>(expBase);
+        const WORD ordIndex = pAddressOfOrds[i];
+        if (nameOfs >= index->blob.size() || ordIndex >= index->functions.size())
+            continue;
+
+        const uint64_t hash = hashExportName( reinterpret_cast<const char*>(index->blob.data() + nameOfs) );
 
-            if ((reinterpret_cast<uintptr_t>(name_ord) <= 0xFFFF && (WORD)((uintptr_t)name_ord) == (OrdIndex + pExpData->Base)) ||
-                (reinterpret_cast<uintptr_t>(name_ord) > 0xFFFF && strcmp( pName, name_ord ) == 0))
+        // Linear probing
+        for (size_t slot = hash & tableMask;; slot = (slot + 1) & tableMask)
+        {
+            if (index->table[slot].hash == 0)
             {
-                data.procAddress = pAddressOfFuncs[OrdIndex] + hMod.baseAddress;
-
-                // Check forwarded export
-                if (data.procAddress >= hMod.baseAddress + expBase &&
-                    data.procAddress <= hMod.baseAddress + expBase + expSize)
-                {
-                    char forwardStr[255] = { 0 };
-
-                    _memory.Read( data.procAddress, sizeof( forwardStr ), forwardStr );
-
-                    std::string chainExp( forwardStr );
-
-                    std::string strDll = chainExp.substr( 0, chainExp.find( "." ) ) + ".dll";
-                    std::string strName = chainExp.substr( chainExp.find( "." ) + 1, strName.npos );
-                    std::wstring wDll( Utils::AnsiToWstring( strDll ) );
-
-                    // Fill export data info
-                    data.isForwarded = true;
-                    data.forwardModule = wDll;
-                    data.forwardByOrd = (strName.find( "#" ) == 0);
-
-                    if (data.forwardByOrd)
-                        data.forwardOrdinal = static_cast<WORD>(atoi( strName.c_str() + 1 ));
-                    else
-                        data.forwardName = strName;
-
-                    // Check if forward mod is loaded
-                    auto mt = (phdrNt32->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR32_MAGIC) ? mt_mod32 : mt_mod64;
-                    auto hChainMod = GetModule( wDll, LdrList, mt, baseModule );
-                    if (hChainMod == nullptr)
-                        return call_result_t<exportData>( data, STATUS_SOME_NOT_MAPPED );
-
-                    // Import by ordinal
-                    if (data.forwardByOrd)
-                        return GetExport( hChainMod, reinterpret_cast<const char*>(data.forwardOrdinal), wDll.c_str() );
-                    // Import by name
-                    else
-                        return GetExport( hChainMod, strName.c_str(), wDll.c_str() );
-                }
-
-                return data;
+                index->table[slot] = ExportIndex::Slot{ hash, nameOfs, index->functions[ordIndex] };
+                break;
             }
         }
     }
 
-    return STATUS_NOT_FOUND;
+    CSLock lck( _modGuard );
+
+    auto& entry = _exports[hMod.baseAddress];
+    entry = std::move( index );
+    return entry.get();
 }
 
 /// <summary>
@@ -459,7 +734,7 @@ call_result_t<ModuleDataPtr> ProcessModules::Inject( const std::wstring& path, T
     if (switchMode == ForceSwitch && !_ldrPatched && IsWindows7OrGreater() && !IsWindows8OrGreater())
     {
         uint8_t patch[] = { 0x90, 0x90, 0x90, 0x90, 0x90, 0x90 };
-        auto patchBase = g_symbols.LdrKernel32PatchAddress;
+        auto patchBase = Symbols().LdrKernel32PatchAddress;
 
         if (patchBase != 0)
         {
@@ -492,7 +767,8 @@ call_result_t<ModuleDataPtr> ProcessModules::Inject( const std::wstring& path, T
     }
     else
     {
-        status = _proc.remote().ExecInNewThread( (*a)->make(), (*a)->getCodeSize(), res, switchMode );
+        // Bare call stub without the event epilogue, completion comes from the thread join
+        status = _proc.remote().ExecInNewThread( (*a)->make(), (*a)->getCodeSize(), res, switchMode, Exec_Isolated );
         if (NT_SUCCESS( status ))
             status = static_cast<NTSTATUS>(res);
     }
@@ -537,7 +813,8 @@ NTSTATUS ProcessModules::Unload( const ModuleDataPtr& hMod )
     a->GenCall( pUnload->procAddress, { hMod->baseAddress } );
     (*a)->ret();
 
-    _proc.remote().ExecInNewThread( (*a)->make(), (*a)->getCodeSize(), res, threadSwitch );
+    // Bare call stub without the event epilogue, completion comes from the thread join
+    _proc.remote().ExecInNewThread( (*a)->make(), (*a)->getCodeSize(), res, threadSwitch, Exec_Isolated );
 
     // Remove module from cache
     _modules.erase( std::make_pair( hMod->name, hMod->type ) );
@@ -954,8 +1231,12 @@ void ProcessModules::reset()
 {
     CSLock lck( _modGuard );
 
-    _modules.clear(); 
+    _modules.clear();
+    _exports.clear();
     _ldrPatched = false;
+
+    _loadEventsSeen = _loadEvents.load( std::memory_order_relaxed ) - 1;
+    memset( _ldrHeadSnap, 0, sizeof( _ldrHeadSnap ) );
 }
 
 }
\ No newline at end of file
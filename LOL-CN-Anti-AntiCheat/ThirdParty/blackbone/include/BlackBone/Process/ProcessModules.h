@@ -8,9 +8,13 @@
 #include "../Misc/Utils.h"
 #include "Threads/Thread.h"
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include <algorithm>
 
 namespace std
@@ -30,6 +34,70 @@ namespace std
 namespace blackbone
 {
 
+/// <summary>
+/// Bump arena backing light module enumeration.
+/// Hands out chunks of a few large blocks instead of one heap
+/// allocation per string; blocks are never reallocated, so
+/// views into the arena stay valid until reset.
+/// </summary>
+class ModuleArena
+{
+public:
+    BLACKBONE_API explicit ModuleArena( size_t blockSize = 0x8000 )
+        : _blockSize( blockSize ) { }
+
+    /// <summary>
+    /// Bump-allocate a character run
+    /// </summary>
+    /// <param name="count">Characters to allocate</param>
+    /// <returns>Allocated run, nullptr if count exceeds the block size</returns>
+    BLACKBONE_API wchar_t* alloc( size_t count )
+    {
+        if (count > _blockSize)
+            return nullptr;
+
+        if (_blocks.empty() || _used + count > _blockSize)
+        {
+            _blocks.emplace_back( std::make_unique<wchar_t[]>( _blockSize ) );
+            _used = 0;
+        }
+
+        wchar_t* ptr = _blocks.back().get() + _used;
+        _used += count;
+        return ptr;
+    }
+
+    /// <summary>
+    /// Reuse storage for the next enumeration.
+    /// Invalidates all previously returned views.
+    /// </summary>
+    BLACKBONE_API void reset()
+    {
+        if (_blocks.size() > 1)
+            _blocks.resize( 1 );
+
+        _used = 0;
+    }
+
+private:
+    size_t _blockSize;                              // Characters per block
+    size_t _used = 0;                               // Characters used in the last block
+    std::vector<std::unique_ptr<wchar_t[]>> _blocks;
+};
+
+/// <summary>
+/// Module info referencing arena-held strings, no per-entry allocations
+/// </summary>
+struct ModuleDataLight
+{
+    module_t baseAddress = 0;       // Base image address
+    module_t size = 0;              // Size of image
+    ptr_t ldrPtr = 0;               // LDR entry address
+    eModType type = mt_unknown;     // Module type
+    std::wstring_view name;         // File name, points into the arena
+    std::wstring_view fullPath;     // Full path, points into the arena
+};
+
 struct exportData
 {
     ptr_t procAddress = 0;          // Function address
@@ -113,6 +181,17 @@ public:
     /// <returns>List of modules</returns>
     BLACKBONE_API mapModules GetManualModules();
 
+    /// <summary>
+    /// Enumerate process modules from the loader list without per-entry
+    /// heap allocations. Name strings live in the caller-supplied arena
+    /// and stay valid until it is reset.
+    /// </summary>
+    /// <param name="arena">String storage</param>
+    /// <param name="result">Found modules, appended</param>
+    /// <param name="type">Module type. 32 bit or 64 bit</param>
+    /// <returns>Number of modules found</returns>
+    BLACKBONE_API size_t EnumModulesLight( ModuleArena& arena, std::vector<ModuleDataLight>& result, eModType type = mt_default );
+
     /// <summary>
     /// Get export address. Forwarded exports will be automatically resolved if forward module is present
     /// </summary>
@@ -235,20 +314,87 @@ public:
     /// </summary>
     BLACKBONE_API void reset();
 
+private:
+    /// <summary>
+    /// Per-module export index.
+    /// Holds a local copy of the export directory and an open-addressed
+    /// FNV-1a name hash table, so repeat lookups touch no remote memory.
+    /// </summary>
+    struct ExportIndex
+    {
+        struct Slot
+        {
+            uint64_t hash = 0;      // FNV-1a of export name, 0 if slot is empty
+            uint32_t nameOfs = 0;   // Name offset inside 'blob', for verification
+            uint32_t rva = 0;       // Function RVA
+        };
+
+        uintptr_t dirBase = 0;          // Export directory RVA
+        DWORD dirSize = 0;              // Export directory size
+        DWORD ordinalBase = 0;          // First export ordinal
+        eModType mtype = mt_default;    // Module type
+        std::vector<uint8_t> blob;      // Local copy of the export directory
+        std::vector<DWORD> functions;   // AddressOfFunctions copy
+        std::vector<Slot> table;        // Name hash table, power-of-2 sized
+    };
+
 private:
     ProcessModules( const ProcessModules& ) = delete;
     ProcessModules operator =(const ProcessModules&) = delete;
 
     void UpdateModuleCache( eModSeachType search, eModType type );
 
+    /// <summary>
+    /// Get cached export index for a module, building it on first use
+    /// </summary>
+    /// <param name="hMod">Module to index</param>
+    /// <returns>Export index or error code</returns>
+    call_result_t<ExportIndex*> GetExportIndex( const ModuleData& hMod );
+
+    /// <summary>
+    /// Check if the target loader list may have changed since the last call.
+    /// Local process - DLL-load notification counter, remote process -
+    /// loader list head links. Errs on the side of reporting a change.
+    /// </summary>
+    /// <param name="type">Module type. 32 bit or 64 bit</param>
+    /// <returns>true if the module cache must be refreshed</returns>
+    bool LoaderListChanged( eModType type );
+
+    /// <summary>
+    /// Register for local DLL-load notifications, once
+    /// </summary>
+    void InitLoadNotification();
+
+    /// <summary>
+    /// Local DLL load/unload notification callback
+    /// </summary>
+    static void CALLBACK LoadNotification( ULONG reason, const void* pData, void* pContext );
+
+    /// <summary>
+    /// Loader list walk behind EnumModulesLight
+    /// </summary>
+    /// <param name="arena">String storage</param>
+    /// <param name="result">Found modules, appended</param>
+    /// <returns>Number of modules found</returns>
+    template<typename T>
+    size_t EnumModulesLightT( ModuleArena& arena, std::vector<ModuleDataLight>& result );
+
 private:
     class Process&       _proc;
     class ProcessMemory& _memory;
     class ProcessCore&   _core;
 
     mapModules _modules;            // Fast lookup cache
-    CriticalSection _modGuard;      // Module guard        
+    CriticalSection _modGuard;      // Module guard
     bool _ldrPatched;               // Win7 loader patch flag
+
+    std::unordered_map<module_t, std::unique_ptr<ExportIndex>> _exports;    // Per-module export indices
+
+    std::atomic<uint32_t> _loadEvents{ 0 };     // Local DLL load/unload notification count
+    uint32_t _loadEventsSeen = 0;               // Count consumed by the last cache refresh
+    void* _ldrNotifyCookie = nullptr;           // LdrRegisterDllNotification cookie
+    bool _ldrNotifyTried = false;               // Notification registration was attempted
+    ptr_t _ldrHeadSnap[2][2] = {};              // Loader list head links per module type
 };
 
 };
@@ -1,6 +1,7 @@
 #include "RemoteExec.h"
 #include "../Process.h"
 #include "../../Misc/DynImport.h"
+#include "../../Misc/FutexEvent.h"
 #include "../../Symbols/SymbolData.h"
 
 #include <3rd_party/VersionApi.h>
@@ -8,6 +9,19 @@
 #include <AccCtrl.h>
 #include <Aclapi.h>
 
+// Cached call-site block layout
+#define SITE_SLOTS_OFFSET   0x000   // Scalar argument slots, 8 bytes each
+#define SITE_PFN_OFFSET     0x0F8   // Target function pointer slot
+#define SITE_DATA_OFFSET    0x100   // Staged structures and strings
+#define SITE_CODE_OFFSET    0x800   // Argument-indirect call stub
+#define SITE_BLOCK_SIZE     0x1000
+#define SITE_MAX_ARGS       (SITE_PFN_OFFSET / sizeof( uint64_t ))
+#define SITE_CACHE_MAX      64      // Cached sites per process
+
+// Largest payload Exec_Auto hands to an existing thread; call stubs sit
+// well below this, bigger blocks amortize a thread creation themselves
+#define SMALL_EXEC_MAX      0x400
+
 namespace blackbone
 {
 
@@ -17,7 +31,12 @@ RemoteExec::RemoteExec( Process& proc )
     , _memory( _process.memory() )
     , _threads( _process.threads() )
     , _hWaitEvent( NULL )
+    , _hSharedSection( NULL )
+    , _pUserDataLocal( nullptr )
+    , _callSeq( 0 )
     , _apcPatched( false )
+    , _batchCount( 0 )
+    , _batchDataOffset( ARGS_OFFSET )
 {
 }
 
@@ -27,25 +46,25 @@ RemoteExec::~RemoteExec()
 }
 
 /// <summary>
-/// Create new thread and execute code in it. Wait until execution ends
+/// Execute code in a new thread. Wait until execution ends.
+/// With Exec_Auto, small payloads are routed to the live worker or
+/// hijack thread instead of paying a full remote thread lifecycle
 /// </summary>
 /// <param name="pCode">Code to execute</param>
 /// <param name="size">Code size</param>
 /// <param name="callResult">Code return value</param>
 /// <param name="modeSwitch">Switch wow64 thread to long mode upon creation</param>
+/// <param name="policy">Execution thread routing policy</param>
 /// <returns>Status</returns>
 NTSTATUS RemoteExec::ExecInNewThread(
     PVOID pCode, size_t size,
     uint64_t& callResult,
-    eThreadModeSwitch modeSwitch /*= AutoSwitch*/
+    eThreadModeSwitch modeSwitch /*= AutoSwitch*/,
+    eExecPolicy policy /*= Exec_Auto*/
     )
 {
     NTSTATUS status = STATUS_SUCCESS;
 
-    // Write code
-    if (!NT_SUCCESS( status = CopyCode( pCode, size ) ))
-        return status;
-
     bool switchMode = false;
     switch (modeSwitch)
     {
@@ -58,6 +77,25 @@ NTSTATUS RemoteExec::ExecInNewThread(
         break;
     }
 
+    // Small one-shot payloads ride an existing thread when one is alive:
+    // the thread creation, scheduling and teardown a dedicated thread
+    // costs (~1 ms) dwarfs the call itself. Mode-switched code still
+    // needs its own thread, as does anything the caller marked isolated
+    if (policy == Exec_Auto && !switchMode && size <= SMALL_EXEC_MAX)
+    {
+        bool workerReady = _hWaitEvent && (_hijackThread
+            ? _hijackThread->valid()
+            : _workerThread && _workerThread->valid());
+
+        // Once routed the payload runs exactly once, no re-run on failure
+        if (workerReady)
+            return ExecInWorkerThread( pCode, size, callResult );
+    }
+
+    // Write code
+    if (!NT_SUCCESS( status = CopyCode( pCode, size ) ))
+        return status;
+
     auto a = switchMode ? AsmFactory::GetAssembler( AsmFactory::asm64 ) 
                         : AsmFactory::GetAssembler( _process.core().isWow64() );
 
@@ -153,10 +191,7 @@ NTSTATUS RemoteExec::ExecInWorkerThread( PVOID pCode, size_t size, uint64_t& cal
     // Execute code in thread context
     // TODO: Find out why am I passing pRemoteCode as an argument???
     if (NT_SUCCESS( _process.core().native()->QueueApcT( _workerThread->handle(), pRemoteCode, pRemoteCode ) ))
-    {
-        status = WaitForSingleObject( _hWaitEvent, 30 * 1000 /*wait 30s*/ );
-        callResult = _userData.Read<uint64_t>( RET_OFFSET, 0 );
-    }
+        status = WaitComplete( 30 * 1000 /*wait 30s*/, callResult );
     else
         return LastNtStatus();
 
@@ -166,6 +201,103 @@ NTSTATUS RemoteExec::ExecInWorkerThread( PVOID pCode, size_t size, uint64_t& cal
     return status;
 }
 
+/// <summary>
+/// Execute a batch of code blocks in the worker thread in one pass
+/// </summary>
+/// <param name="items">Code blocks, executed in order</param>
+/// <param name="callResult">Result of the last block</param>
+/// <returns>Status</returns>
+NTSTATUS RemoteExec::ExecInWorkerThreadBatch( const std::vector<ApcBatchItem>& items, uint64_t& callResult )
+{
+    NTSTATUS status = STATUS_SUCCESS;
+
+    if (items.empty())
+        return STATUS_INVALID_PARAMETER;
+
+    // Batching relies on APC delivery into the worker thread
+    if (_hijackThread)
+        return STATUS_NOT_SUPPORTED;
+
+    assert( _workerThread );
+    assert( _hWaitEvent != NULL );
+    if (!_workerThread || !_hWaitEvent)
+        return STATUS_INVALID_PARAMETER;
+
+    // Blocks are laid out back to back, 16-byte aligned
+    size_t totalSize = 0;
+    for (auto& item : items)
+    {
+        if (item.pCode == nullptr || item.size == 0)
+            return STATUS_INVALID_PARAMETER;
+
+        totalSize = Align( totalSize + item.size, 16 );
+    }
+
+    // Ensure capacity, same policy as CopyCode
+    if (!_userCode.valid())
+    {
+        auto mem = _memory.Allocate( totalSize );
+        if (!mem)
+            return mem.status;
+
+        _userCode = std::move( mem.result() );
+    }
+
+    if (totalSize > _userCode.size())
+    {
+        auto res = _userCode.Realloc( totalSize );
+        if (!res)
+            return res.status;
+    }
+
+    // Write every block in one layout pass
+    size_t offset = 0;
+    std::vector<ptr_t> entryPoints;
+    entryPoints.reserve( items.size() );
+
+    for (auto& item : items)
+    {
+        if (!NT_SUCCESS( status = _userCode.Write( offset, item.size, item.pCode ) ))
+            return status;
+
+        entryPoints.emplace_back( _userCode.ptr() + offset );
+        offset = Align( offset + item.size, 16 );
+    }
+
+    if (_hWaitEvent)
+        ResetEvent( _hWaitEvent );
+
+    // Queue the whole batch before the worker wakes: one alertable wait
+    // in the worker then drains every APC in queue order
+    for (ptr_t entry : entryPoints)
+    {
+        if (!NT_SUCCESS( _process.core().native()->QueueApcT( _workerThread->handle(), entry, entry ) ))
+            return LastNtStatus();
+    }
+
+    if (_pUserDataLocal != nullptr)
+    {
+        // The last stub published the highest sequence number during
+        // assembly, so a single wait completes only after the final item
+        status = WaitComplete( 30 * 1000, callResult );
+    }
+    else
+    {
+        // Event fallback: every stub signals, drain one wait per item
+        for (size_t i = 0; i < items.size() && NT_SUCCESS( status ); i++)
+        {
+            status = WaitComplete( 30 * 1000, callResult );
+            if (i + 1 < items.size())
+                ResetEvent( _hWaitEvent );
+        }
+    }
+
+    // Ensure APC functions fully return
+    Sleep( 1 );
+
+    return status;
+}
+
 /// <summary>
 /// Execute code in context of any existing thread
 /// </summary>
@@ -276,10 +408,7 @@ NTSTATUS RemoteExec::ExecInAnyThread( PVOID pCode, size_t size, uint64_t& callRe
 
     thd->Resume();
     if (NT_SUCCESS( status ))
-    {
-        WaitForSingleObject( _hWaitEvent, 20 * 1000/*INFINITE*/ );
-        status = _userData.Read( RET_OFFSET, callResult );
-    }
+        status = WaitComplete( 20 * 1000/*INFINITE*/, callResult );
 
     return status;
 }
@@ -340,8 +469,14 @@ NTSTATUS RemoteExec::CreateRPCEnvironment( WorkerThreadMode mode /*= Worker_None
         return status;
     if (!NT_SUCCESS( status = allocMem( _userCode ) ))
         return status;
-    if (!NT_SUCCESS( status = allocMem( _userData, 0x4000, PAGE_READWRITE ) ))
-        return status;
+
+    // Prefer a section mapped into both processes for _userData, call results
+    // are then observed locally without event waits or remote reads
+    if (!_userData.valid() && !NT_SUCCESS( CreateResultChannel() ))
+    {
+        if (!NT_SUCCESS( status = allocMem( _userData, 0x4000, PAGE_READWRITE ) ))
+            return status;
+    }
 
     // Create RPC thread
     if (mode == Worker_CreateNew)
@@ -488,6 +623,101 @@ NTSTATUS RemoteExec::CreateAPCEvent( DWORD threadID )
     return _userData.Write( EVENT_OFFSET, sizeof( int32_t ), &hRemoteHandle );
 }
 
+/// <summary>
+/// Back _userData with a section mapped into both processes
+/// </summary>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::CreateResultChannel()
+{
+    if (_pUserDataLocal != nullptr)
+        return STATUS_SUCCESS;
+
+    _hSharedSection = CreateFileMappingW( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, 0x4000, NULL );
+    if (_hSharedSection == NULL)
+        return LastNtStatus();
+
+    _pUserDataLocal = MapViewOfFile( _hSharedSection, FILE_MAP_ALL_ACCESS, 0, 0, 0 );
+    if (_pUserDataLocal == nullptr)
+    {
+        CloseResultChannel();
+        return LastNtStatus();
+    }
+
+    // Map the same section into the target, ViewShare
+    PVOID pRemote = nullptr;
+    SIZE_T viewSize = 0;
+
+    NTSTATUS status = SAFE_NATIVE_CALL(
+        NtMapViewOfSection,
+        _hSharedSection, _process.core().handle(), &pRemote,
+        static_cast<ULONG_PTR>(0), static_cast<SIZE_T>(0), static_cast<PLARGE_INTEGER>(nullptr),
+        &viewSize, static_cast<ULONG>(1), static_cast<ULONG>(0), static_cast<ULONG>(PAGE_READWRITE)
+        );
+
+    if (!NT_SUCCESS( status ))
+    {
+        CloseResultChannel();
+        return status;
+    }
+
+    // Caller-owned block, the view is released in CloseResultChannel
+    _userData = MemBlock( &_memory, reinterpret_cast<ptr_t>(pRemote), 0x4000, PAGE_READWRITE, false );
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Unmap and close the shared result channel
+/// </summary>
+void RemoteExec::CloseResultChannel()
+{
+    if (_pUserDataLocal != nullptr && _userData.valid())
+    {
+        SAFE_NATIVE_CALL( NtUnmapViewOfSection, _process.core().handle(), reinterpret_cast<PVOID>(_userData.ptr<uintptr_t>()) );
+        _userData.Reset();
+    }
+
+    if (_pUserDataLocal != nullptr)
+    {
+        UnmapViewOfFile( _pUserDataLocal );
+        _pUserDataLocal = nullptr;
+    }
+
+    if (_hSharedSection != NULL)
+    {
+        CloseHandle( _hSharedSection );
+        _hSharedSection = NULL;
+    }
+}
+
+/// <summary>
+/// Wait for remote call completion
+/// </summary>
+/// <param name="timeout">Wait timeout, in milliseconds</param>
+/// <param name="callResult">Execution result</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::WaitComplete( uint32_t timeout, uint64_t& callResult )
+{
+    // Shared channel: the stub publishes a sequence number after the result,
+    // the common fast return is observed without any kernel transition
+    if (_pUserDataLocal != nullptr)
+    {
+        auto pBytes = static_cast<volatile uint8_t*>(_pUserDataLocal);
+
+        FutexEvent seqEvent( reinterpret_cast<volatile uint32_t*>(pBytes + SEQ_OFFSET) );
+        NTSTATUS status = seqEvent.WaitFor( _callSeq, timeout );
+        if (!NT_SUCCESS( status ))
+            return status;
+
+        callResult = *reinterpret_cast<volatile uint64_t*>(pBytes + RET_OFFSET);
+        return STATUS_SUCCESS;
+    }
+
+    // Event handshake fallback
+    NTSTATUS status = WaitForSingleObject( _hWaitEvent, timeout );
+    callResult = _userData.Read<uint64_t>( RET_OFFSET, 0 );
+    return status;
+}
+
 /// <summary>
 /// Generate assembly code for remote call.
 /// </summary>
@@ -512,26 +742,9 @@ NTSTATUS RemoteExec::PrepareCallAssembly(
         return STATUS_INVALID_PARAMETER_3;
 
     // Copy structures and strings
-    for (auto& arg : args)
-    {
-        // Transform 64 bit imm values
-        if (arg.type == AsmVariant::imm && arg.size > sizeof( uint32_t ) && a.assembler()->getArch() == asmjit::kArchX86)
-        {
-            arg.type = AsmVariant::dataStruct;
-            arg.buf.resize( arg.size );
-            memcpy( arg.buf.data(), &arg.imm_val64, arg.size );
-            arg.imm_val64 = reinterpret_cast<uint64_t>(arg.buf.data());
-        }
-
-        if (arg.type == AsmVariant::dataStruct || arg.type == AsmVariant::dataPtr)
-        {
-            _userData.Write( data_offset, arg.size, reinterpret_cast<const void*>(arg.imm_val) );
-            arg.new_imm_val = _userData.ptr() + data_offset;
-
-            // Add some padding after data
-            data_offset += arg.size + 0x10;
-        }
-    }
+    NTSTATUS status = StageArguments( a, args, data_offset );
+    if (!NT_SUCCESS( status ))
+        return status;
 
     // Insert hidden variable if return type is struct.
     // This variable contains address of buffer in which return value is copied
@@ -566,6 +779,393 @@ NTSTATUS RemoteExec::PrepareCallAssembly(
     return STATUS_SUCCESS;
 }
 
+/// <summary>
+/// Copy structure and string arguments into the user data block
+/// </summary>
+/// <param name="a">Underlying assembler object</param>
+/// <param name="args">Function arguments</param>
+/// <param name="data_offset">Running offset inside the block</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::StageArguments( IAsmHelper& a, std::vector<AsmVariant>& args, uintptr_t& data_offset )
+{
+    for (auto& arg : args)
+    {
+        // Transform 64 bit imm values
+        if (arg.type == AsmVariant::imm && arg.size > sizeof( uint32_t ) && a.assembler()->getArch() == asmjit::kArchX86)
+        {
+            arg.type = AsmVariant::dataStruct;
+            arg.buf.resize( arg.size );
+            memcpy( arg.buf.data(), &arg.imm_val64, arg.size );
+            arg.imm_val64 = reinterpret_cast<uint64_t>(arg.buf.data());
+        }
+
+        if (arg.type == AsmVariant::dataStruct || arg.type == AsmVariant::dataPtr)
+        {
+            _userData.Write( data_offset, arg.size, reinterpret_cast<const void*>(arg.imm_val) );
+            arg.new_imm_val = _userData.ptr() + data_offset;
+
+            // Add some padding after data
+            data_offset += arg.size + 0x10;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Read data staged inside the user data block, addressed by its
+/// remote pointer. Results and output arguments land in the same
+/// block that is polled for completion, so when the block is backed
+/// by the shared section this costs a memcpy instead of a remote read
+/// </summary>
+/// <param name="remotePtr">Remote address of the data</param>
+/// <param name="size">Read size</param>
+/// <param name="pResult">Receives read data</param>
+/// <returns>Status</returns>
+NTSTATUS RemoteExec::ReadStagedData( ptr_t remotePtr, size_t size, void* pResult )
+{
+    if (_userData.valid() && remotePtr >= _userData.ptr() && remotePtr + size <= _userData.ptr() + _userData.size())
+        return ReadUserData( static_cast<uint32_t>(remotePtr - _userData.ptr()), size, pResult );
+
+    // Staged outside the block (e.g. a cached call-site stub), plain read
+    return _memory.Read( remotePtr, size, pResult );
+}
+
+/// <summary>
+/// Begin a batched call pipeline.
+/// Queued calls are serialized into one command buffer and executed by
+/// the worker thread in a single wake, amortizing synchronization cost
+/// across the batch
+/// </summary>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::PipelineBegin()
+{
+    NTSTATUS status = CreateRPCEnvironment( Worker_CreateNew, true );
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    _batchAsm = AsmFactory::GetAssembler( _process.core().isWow64() );
+    if (!_batchAsm)
+        return STATUS_NOT_SUPPORTED;
+
+    _batchCount = 0;
+    _batchDataOffset = ARGS_OFFSET;
+
+    _batchAsm->GenPrologue();
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Append a call to the pipeline.
+/// Only integer and pointer return values are captured
+/// </summary>
+/// <param name="pfn">Remote function pointer</param>
+/// <param name="args">Function arguments</param>
+/// <param name="cc">Calling convention</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::PipelineAdd( ptr_t pfn, std::vector<AsmVariant>& args, eCalligConvention cc /*= cc_stdcall*/ )
+{
+    if (!_batchAsm)
+        return STATUS_INVALID_DEVICE_STATE;
+
+    // Invalid calling convention
+    if (cc < cc_cdecl || cc > cc_fastcall)
+        return STATUS_INVALID_PARAMETER_3;
+
+    if (_batchCount >= BATCH_MAX_CALLS)
+        return STATUS_TOO_MANY_COMMANDS;
+
+    NTSTATUS status = StageArguments( *_batchAsm, args, _batchDataOffset );
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    // Argument staging must not spill into the result area
+    if (_batchDataOffset > BATCH_RET_OFFSET)
+        return STATUS_BUFFER_OVERFLOW;
+
+    _batchAsm->GenCall( pfn, args, cc );
+    SaveCallResult( *_batchAsm, static_cast<uint32_t>(BATCH_RET_OFFSET + _batchCount * sizeof( uint64_t )) );
+
+    ++_batchCount;
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Execute all queued calls in one worker wake
+/// </summary>
+/// <param name="results">Per-call return values, in queue order</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::PipelineExecute( std::vector<uint64_t>& results )
+{
+    if (!_batchAsm)
+        return STATUS_INVALID_DEVICE_STATE;
+
+    auto a = std::move( _batchAsm );
+    const uint32_t count = _batchCount;
+    _batchCount = 0;
+
+    if (count == 0)
+        return STATUS_SUCCESS;
+
+    AddReturnWithEvent( *a );
+    a->GenEpilogue();
+
+    uint64_t tmpResult = 0;
+    NTSTATUS status = ExecInWorkerThread( (*a)->make(), (*a)->getCodeSize(), tmpResult );
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    // All results come back in one read
+    results.resize( count );
+    return ReadUserData( BATCH_RET_OFFSET, count * sizeof( uint64_t ), results.data() );
+}
+
+/// <summary>
+/// Execute a call through the call-site code cache.
+/// The stub for a given call shape is assembled and written remotely once,
+/// arguments are passed through a per-site data block, so repeated calls
+/// cost one argument write and a worker wake - no per-call assembly or
+/// code copy. Returns STATUS_NOT_SUPPORTED for shapes the cache can't
+/// parameterize (float/struct returns, register or stack arguments)
+/// </summary>
+/// <param name="pfn">Remote function pointer</param>
+/// <param name="args">Function arguments</param>
+/// <param name="cc">Calling convention</param>
+/// <param name="retType">Return type</param>
+/// <param name="callResult">Call result</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::ExecCached(
+    ptr_t pfn,
+    std::vector<AsmVariant>& args,
+    eCalligConvention cc,
+    eReturnType retType,
+    uint64_t& callResult
+    )
+{
+    NTSTATUS status = STATUS_SUCCESS;
+
+    // Worker thread dispatch only
+    if (_hijackThread || !_workerThread || !_hWaitEvent)
+        return STATUS_INVALID_DEVICE_STATE;
+
+    // Invalid calling convention
+    if (cc < cc_cdecl || cc > cc_fastcall)
+        return STATUS_INVALID_PARAMETER_3;
+
+    // Return shapes that need extra codegen per call
+    if (retType == rt_struct || retType == rt_float || retType == rt_double)
+        return STATUS_NOT_SUPPORTED;
+
+    if (args.size() > SITE_MAX_ARGS)
+        return STATUS_NOT_SUPPORTED;
+
+    for (auto& arg : args)
+    {
+        // Transform 64 bit imm values
+        if (arg.type == AsmVariant::imm && arg.size > sizeof( uint32_t ) && _process.core().isWow64())
+        {
+            arg.type = AsmVariant::dataStruct;
+            arg.buf.resize( arg.size );
+            memcpy( arg.buf.data(), &arg.imm_val64, arg.size );
+            arg.imm_val64 = reinterpret_cast<uint64_t>(arg.buf.data());
+        }
+
+        if (arg.type != AsmVariant::imm && arg.type != AsmVariant::dataPtr && arg.type != AsmVariant::dataStruct)
+            return STATUS_NOT_SUPPORTED;
+    }
+
+    // The target pointer travels through the block, so one stub per
+    // call shape serves every function of that shape
+    const uint64_t sig = SiteSignature( args, cc, retType );
+
+    // Unbounded growth guard
+    if (_callSites.size() >= SITE_CACHE_MAX && _callSites.count( sig ) == 0)
+        _callSites.clear();
+
+    auto& site = _callSites[sig];
+    if (!site.block.valid() || site.signature != sig)
+    {
+        if (!NT_SUCCESS( status = BuildCallSite( site, args, cc, retType ) ))
+        {
+            _callSites.erase( sig );
+            return status;
+        }
+
+        site.signature = sig;
+    }
+
+    if (!NT_SUCCESS( status = StageSiteArguments( site, args, pfn ) ))
+        return status;
+
+    if (_hWaitEvent)
+        ResetEvent( _hWaitEvent );
+
+    // Re-trigger the cached stub
+    if (_pUserDataLocal != nullptr)
+        ++_callSeq;
+
+    const ptr_t pRemoteCode = site.block.ptr() + SITE_CODE_OFFSET;
+    if (!NT_SUCCESS( _process.core().native()->QueueApcT( _workerThread->handle(), pRemoteCode, pRemoteCode ) ))
+        return LastNtStatus();
+
+    status = WaitComplete( 30 * 1000 /*wait 30s*/, callResult );
+
+    // Ensure APC function fully returns
+    Sleep( 1 );
+
+    return status;
+}
+
+/// <summary>
+/// Assemble and write the argument-indirect stub for a call site
+/// </summary>
+/// <param name="site">Site to fill</param>
+/// <param name="args">Function arguments</param>
+/// <param name="cc">Calling convention</param>
+/// <param name="retType">Return type</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::BuildCallSite( CallSite& site, vecArgs& args, eCalligConvention cc, eReturnType retType )
+{
+    auto a = AsmFactory::GetAssembler( _process.core().isWow64() );
+    if (!a)
+        return STATUS_NOT_SUPPORTED;
+
+    if (!site.block.valid())
+    {
+        auto mem = _memory.Allocate( SITE_BLOCK_SIZE );
+        if (!mem)
+            return mem.status;
+
+        site.block = std::move( mem.result() );
+    }
+
+    const bool x64Stub = (*a)->getArch() != asmjit::kArchX86;
+
+    // Scalar arguments are loaded from the slot area at run time,
+    // staged data keeps a fixed remote address per site
+    std::vector<AsmVariant> stubArgs;
+    stubArgs.reserve( args.size() );
+
+    uintptr_t data_offset = SITE_DATA_OFFSET;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        auto& arg = args[i];
+        const auto slot = SITE_SLOTS_OFFSET + i * sizeof( uint64_t );
+
+        if (arg.type == AsmVariant::imm)
+        {
+            if (x64Stub)
+                stubArgs.emplace_back( asmjit::host::qword_ptr( asmjit::host::r10, static_cast<int32_t>(slot) ) );
+            else
+                stubArgs.emplace_back( asmjit::host::dword_ptr_abs( static_cast<asmjit::Ptr>(site.block.ptr() + slot) ) );
+        }
+        else
+        {
+            stubArgs.emplace_back( arg );
+            stubArgs.back().new_imm_val = site.block.ptr() + data_offset;
+            data_offset += arg.size + 0x10;
+        }
+    }
+
+    // Staged data must not spill into the code area
+    if (data_offset > SITE_CODE_OFFSET)
+        return STATUS_BUFFER_OVERFLOW;
+
+    site.dataEnd = data_offset;
+
+    a->GenPrologue();
+
+    // Slot base for run time argument loads. The target pointer is read
+    // from its slot as well, keeping the stub free of call immediates
+    if (x64Stub)
+    {
+        (*a)->mov( asmjit::host::r10, asmjit::imm( static_cast<int64_t>(site.block.ptr()) ) );
+        (*a)->mov( asmjit::host::r11, asmjit::host::qword_ptr( asmjit::host::r10, SITE_PFN_OFFSET ) );
+
+        a->GenCall( AsmFunctionPtr( asmjit::host::r11 ), stubArgs, cc );
+    }
+    else
+    {
+        (*a)->mov( asmjit::host::eax, asmjit::host::dword_ptr_abs( static_cast<asmjit::Ptr>(site.block.ptr() + SITE_PFN_OFFSET) ) );
+
+        a->GenCall( AsmFunctionPtr( asmjit::host::eax ), stubArgs, cc );
+    }
+
+    ptr_t ptr = _userData.ptr();
+    auto pSetEvent = _mods.GetNtdllExport( "NtSetEvent", mt_default );
+    if (pSetEvent)
+        a->SaveRetValAndSignalEvent( pSetEvent->procAddress, ptr + RET_OFFSET, ptr + EVENT_OFFSET, ptr + ERR_OFFSET, retType );
+
+    // The stub runs many times, so the sequence number is incremented in
+    // place instead of being baked in as an immediate
+    if (_pUserDataLocal != nullptr)
+    {
+        (*a)->mov( (*a)->zax, ptr + SEQ_OFFSET );
+        (*a)->inc( asmjit::host::dword_ptr( (*a)->zax ) );
+    }
+
+    a->GenEpilogue();
+
+    const size_t codeSize = (*a)->getCodeSize();
+    if (SITE_CODE_OFFSET + codeSize > site.block.size())
+        return STATUS_BUFFER_OVERFLOW;
+
+    return site.block.Write( SITE_CODE_OFFSET, codeSize, (*a)->make() );
+}
+
+/// <summary>
+/// Publish argument slots and staged data with one remote write
+/// </summary>
+/// <param name="site">Target site</param>
+/// <param name="args">Function arguments</param>
+/// <param name="pfn">Remote function pointer</param>
+/// <returns>Status code</returns>
+NTSTATUS RemoteExec::StageSiteArguments( CallSite& site, vecArgs& args, ptr_t pfn )
+{
+    // Compose slots and staged data locally
+    std::vector<uint8_t> staging( site.dataEnd, 0 );
+    memcpy( staging.data() + SITE_PFN_OFFSET, &pfn, sizeof( pfn ) );
+
+    uintptr_t data_offset = SITE_DATA_OFFSET;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        auto& arg = args[i];
+
+        if (arg.type == AsmVariant::imm)
+        {
+            memcpy( staging.data() + SITE_SLOTS_OFFSET + i * sizeof( uint64_t ), &arg.imm_val64, sizeof( uint64_t ) );
+        }
+        else
+        {
+            memcpy( staging.data() + data_offset, reinterpret_cast<const void*>(arg.imm_val), arg.size );
+            arg.new_imm_val = site.block.ptr() + data_offset;
+            data_offset += arg.size + 0x10;
+        }
+    }
+
+    return site.block.Write( 0, staging.size(), staging.data() );
+}
+
+/// <summary>
+/// Hash call shape: convention, return type, argument layout
+/// </summary>
+uint64_t RemoteExec::SiteSignature( const vecArgs& args, eCalligConvention cc, eReturnType retType )
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash]( uint64_t val ) { hash = (hash ^ val) * 0x100000001B3ull; };
+
+    mix( static_cast<uint64_t>(cc) );
+    mix( static_cast<uint64_t>(retType) );
+
+    for (const auto& arg : args)
+    {
+        mix( static_cast<uint64_t>(arg.type) );
+        mix( arg.size );
+    }
+
+    return hash;
+}
+
 /// <summary>
 /// Copy executable code into remote codecave for future execution
 /// </summary>
@@ -622,6 +1222,16 @@ void RemoteExec::AddReturnWithEvent(
     auto pSetEvent = _process.modules().GetNtdllExport( "NtSetEvent", mt );
     if(pSetEvent)
         a.SaveRetValAndSignalEvent( pSetEvent->procAddress, ptr + retOffset, ptr + EVENT_OFFSET, ptr + ERR_OFFSET, retType );
+
+    // Publish the call sequence number into the shared channel.
+    // Emitted after the result and status stores so the local waiter
+    // never observes a half-written result
+    if (_pUserDataLocal != nullptr)
+    {
+        ++_callSeq;
+        a->mov( a->zax, ptr + SEQ_OFFSET );
+        a->mov( asmjit::host::dword_ptr( a->zax ), asmjit::imm( _callSeq ) );
+    }
 }
 
 /// <summary>
@@ -666,6 +1276,8 @@ void RemoteExec::TerminateWorker()
         _workerThread.reset();
         _workerCode.Free();
     }
+
+    CloseResultChannel();
 }
 
 /// <summary>
@@ -679,6 +1291,12 @@ void RemoteExec::reset()
     _userData.Reset();
     _workerCode.Reset();
 
+    _batchAsm.reset();
+    _batchCount = 0;
+    _batchDataOffset = ARGS_OFFSET;
+    _callSites.clear();
+
+    _callSeq = 0;
     _apcPatched = false;
 }
 
@@ -5,12 +5,19 @@
 #include "../Threads/Threads.h"
 #include "../MemBlock.h"
 
+#include <map>
+
 // User data offsets
 #define INTRET_OFFSET   0x00
 #define RET_OFFSET      0x08
 #define ERR_OFFSET      0x10
 #define EVENT_OFFSET    0x18
-#define ARGS_OFFSET     0x20
+#define SEQ_OFFSET      0x20
+#define ARGS_OFFSET     0x28
+
+// Batched call pipeline result area
+#define BATCH_RET_OFFSET 0x2800
+#define BATCH_MAX_CALLS  0x80
 
 
 namespace blackbone
@@ -23,6 +30,12 @@ enum WorkerThreadMode
     Worker_UseExisting,     // Hijack existing thread
 };
 
+enum eExecPolicy
+{
+    Exec_Auto,              // Route small payloads to an existing worker or hijack thread
+    Exec_Isolated,          // Always execute in a dedicated new thread
+};
+
 class RemoteExec
 {
     using vecArgs = std::vector<AsmVariant>;
@@ -35,11 +48,15 @@ public:
     /// Create environment for future remote procedure calls
     ///
     /// _userData layout (x86/x64):
-    /// --------------------------------------------------------------------------------------------------------------------------
-    /// | Internal return value | Return value |  Last Status code  |  Event handle   |  Space for copied arguments and strings  |
-    /// -------------------------------------------------------------------------------------------------------------------------
-    /// |       8/8 bytes       |   8/8 bytes  |      8/8 bytes     |    8/8 bytes    |                                          |
-    /// --------------------------------------------------------------------------------------------------------------------------
+    /// ------------------------------------------------------------------------------------------------------------------------------------------
+    /// | Internal return value | Return value |  Last Status code  |  Event handle   | Call sequence |  Space for copied arguments and strings  |
+    /// ------------------------------------------------------------------------------------------------------------------------------------------
+    /// |       8/8 bytes       |   8/8 bytes  |      8/8 bytes     |    8/8 bytes    |   8/8 bytes   |                                          |
+    /// ------------------------------------------------------------------------------------------------------------------------------------------
+    ///
+    /// When possible _userData is backed by a section mapped into both processes,
+    /// the remote stub then publishes results and a sequence number readable
+    /// locally without event handshakes or remote memory reads
     /// </summary>
     /// <param name="mode">Worket thread mode</param>
     /// <param name="bEvent">Create sync event for worker thread</param>
@@ -47,17 +64,25 @@ public:
     BLACKBONE_API NTSTATUS CreateRPCEnvironment( WorkerThreadMode mode = Worker_None, bool bEvent = false );
 
     /// <summary>
-    /// Create new thread and execute code in it. Wait until execution ends
+    /// Execute code in a new thread. Wait until execution ends.
+    /// With Exec_Auto, small payloads are routed to the live worker or
+    /// hijack thread instead - an APC into an existing thread is orders
+    /// of magnitude cheaper than a full remote thread lifecycle. Routing
+    /// assumes the stub was built the usual way (AddReturnWithEvent as
+    /// epilogue); pass Exec_Isolated for code that genuinely needs its
+    /// own thread. Mode-switched and large payloads always get one
     /// </summary>
     /// <param name="pCode">Code to execute</param>
     /// <param name="size">Code size</param>
     /// <param name="callResult">Code return value</param>
     /// <param name="modeSwitch">Switch wow64 thread to long mode upon creation</param>
+    /// <param name="policy">Execution thread routing policy</param>
     /// <returns>Status</returns>
     BLACKBONE_API NTSTATUS ExecInNewThread(
-        PVOID pCode, size_t size, 
-        uint64_t& callResult, 
-        eThreadModeSwitch modeSwitch = AutoSwitch 
+        PVOID pCode, size_t size,
+        uint64_t& callResult,
+        eThreadModeSwitch modeSwitch = AutoSwitch,
+        eExecPolicy policy = Exec_Auto
         );
 
     /// <summary>
@@ -69,6 +94,29 @@ public:
     /// <returns>Status</returns>
     BLACKBONE_API NTSTATUS ExecInWorkerThread( PVOID pCode, size_t size, uint64_t& callResult );
 
+    /// <summary>
+    /// One work item of an APC batch
+    /// </summary>
+    struct ApcBatchItem
+    {
+        PVOID pCode = nullptr;      // Locally assembled stub
+        size_t size = 0;            // Stub size, in bytes
+    };
+
+    /// <summary>
+    /// Execute a batch of code blocks in the worker thread in one pass.
+    /// All blocks are written remotely with one layout pass and queued as
+    /// APCs before the worker wakes, so one alertable wait drains the whole
+    /// batch in order and queue syscalls are amortized across it. With the
+    /// shared result channel completion is a single wait for the last item's
+    /// sequence number; with the event fallback each item still signals.
+    /// Stubs must be built the usual way (AddReturnWithEvent as epilogue)
+    /// </summary>
+    /// <param name="items">Code blocks, executed in order</param>
+    /// <param name="callResult">Result of the last block</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS ExecInWorkerThreadBatch( const std::vector<ApcBatchItem>& items, uint64_t& callResult );
+
     /// <summary>
     /// Execute code in context of any existing thread
     /// </summary>
@@ -104,6 +152,54 @@ public:
         eReturnType retType
     );
 
+    /// <summary>
+    /// Begin a batched call pipeline.
+    /// Queued calls are serialized into one command buffer and executed by
+    /// the worker thread in a single wake, amortizing synchronization cost
+    /// across the batch
+    /// </summary>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS PipelineBegin();
+
+    /// <summary>
+    /// Append a call to the pipeline.
+    /// Only integer and pointer return values are captured
+    /// </summary>
+    /// <param name="pfn">Remote function pointer</param>
+    /// <param name="args">Function arguments</param>
+    /// <param name="cc">Calling convention</param>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS PipelineAdd( ptr_t pfn, std::vector<AsmVariant>& args, eCalligConvention cc = cc_stdcall );
+
+    /// <summary>
+    /// Execute all queued calls in one worker wake
+    /// </summary>
+    /// <param name="results">Per-call return values, in queue order</param>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS PipelineExecute( std::vector<uint64_t>& results );
+
+    /// <summary>
+    /// Execute a call through the call-site code cache.
+    /// The stub for a given call shape is assembled and written remotely once,
+    /// arguments are passed through a per-site data block, so repeated calls
+    /// cost one argument write and a worker wake - no per-call assembly or
+    /// code copy. Returns STATUS_NOT_SUPPORTED for shapes the cache can't
+    /// parameterize (float/struct returns, register or stack arguments)
+    /// </summary>
+    /// <param name="pfn">Remote function pointer</param>
+    /// <param name="args">Function arguments</param>
+    /// <param name="cc">Calling convention</param>
+    /// <param name="retType">Return type</param>
+    /// <param name="callResult">Call result</param>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS ExecCached(
+        ptr_t pfn,
+        std::vector<AsmVariant>& args,
+        eCalligConvention cc,
+        eReturnType retType,
+        uint64_t& callResult
+    );
+
     /// <summary>
     /// Generate return from function with event synchronization
     /// </summary>
@@ -139,12 +235,19 @@ public:
         if constexpr (sizeof( T ) > sizeof( uint64_t ))
         {
             if constexpr (std::is_reference_v<T>)
-                return _userData.Read( _userData.Read<uintptr_t>( RET_OFFSET, 0 ), sizeof( T ), reinterpret_cast<PVOID>(&result) );
+            {
+                uintptr_t ptr = 0;
+                NTSTATUS status = ReadUserData( RET_OFFSET, sizeof( ptr ), &ptr );
+                if (!NT_SUCCESS( status ))
+                    return status;
+
+                return ReadStagedData( ptr, sizeof( T ), reinterpret_cast<PVOID>(&result) );
+            }
             else
-                return _userData.Read( ARGS_OFFSET, sizeof( T ), reinterpret_cast<PVOID>(&result) );
+                return ReadUserData( ARGS_OFFSET, sizeof( T ), reinterpret_cast<PVOID>(&result) );
         }
         else
-            return _userData.Read( RET_OFFSET, sizeof( T ), reinterpret_cast<PVOID>(&result) );
+            return ReadUserData( RET_OFFSET, sizeof( T ), reinterpret_cast<PVOID>(&result) );
     }
 
     /// <summary>
@@ -153,9 +256,41 @@ public:
     /// <returns></returns>
     BLACKBONE_API NTSTATUS GetLastStatus()
     {
-        return _userData.Read<NTSTATUS>( ERR_OFFSET, STATUS_NOT_FOUND );
+        NTSTATUS lastStatus = STATUS_NOT_FOUND;
+        ReadUserData( ERR_OFFSET, sizeof( lastStatus ), &lastStatus );
+        return lastStatus;
+    }
+
+    /// <summary>
+    /// Read from the user data block, through the shared view when present
+    /// </summary>
+    /// <param name="offset">Offset inside the block</param>
+    /// <param name="size">Read size</param>
+    /// <param name="pResult">Receives read data</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS ReadUserData( uint32_t offset, size_t size, void* pResult )
+    {
+        if (_pUserDataLocal != nullptr && offset + size <= _userData.size())
+        {
+            memcpy( pResult, static_cast<const uint8_t*>(_pUserDataLocal) + offset, size );
+            return STATUS_SUCCESS;
+        }
+
+        return _userData.Read( offset, size, pResult );
     }
 
+    /// <summary>
+    /// Read data staged inside the user data block, addressed by its
+    /// remote pointer. Results and output arguments land in the same
+    /// block that is polled for completion, so when the block is backed
+    /// by the shared section this costs a memcpy instead of a remote read
+    /// </summary>
+    /// <param name="remotePtr">Remote address of the data</param>
+    /// <param name="size">Read size</param>
+    /// <param name="pResult">Receives read data</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS ReadStagedData( ptr_t remotePtr, size_t size, void* pResult );
+
     /// <summary>
     /// Terminate existing worker thread
     /// </summary>
@@ -199,6 +334,70 @@ private:
     /// <returns>Status code</returns>
     NTSTATUS CreateAPCEvent( DWORD threadID );
 
+    /// <summary>
+    /// Back _userData with a section mapped into both processes
+    /// </summary>
+    /// <returns>Status code</returns>
+    NTSTATUS CreateResultChannel();
+
+    /// <summary>
+    /// Unmap and close the shared result channel
+    /// </summary>
+    void CloseResultChannel();
+
+    /// <summary>
+    /// Wait for remote call completion
+    /// </summary>
+    /// <param name="timeout">Wait timeout, in milliseconds</param>
+    /// <param name="callResult">Execution result</param>
+    /// <returns>Status code</returns>
+    NTSTATUS WaitComplete( uint32_t timeout, uint64_t& callResult );
+
+    /// <summary>
+    /// Copy structure and string arguments into the user data block
+    /// </summary>
+    /// <param name="a">Underlying assembler object</param>
+    /// <param name="args">Function arguments</param>
+    /// <param name="data_offset">Running offset inside the block</param>
+    /// <returns>Status code</returns>
+    NTSTATUS StageArguments( IAsmHelper& a, std::vector<AsmVariant>& args, uintptr_t& data_offset );
+
+    /// <summary>
+    /// Cached remote call stub
+    /// </summary>
+    struct CallSite
+    {
+        MemBlock block;         // Remote block: argument slots, staged data, stub code
+        uint64_t signature = 0; // Call shape hash, for collision detection
+        uintptr_t dataEnd = 0;  // End of the staged data area
+    };
+
+    /// <summary>
+    /// Assemble and write the argument-indirect stub for a call shape.
+    /// The target pointer is loaded from the block, so the stub contains
+    /// no per-function immediates
+    /// </summary>
+    /// <param name="site">Site to fill</param>
+    /// <param name="args">Function arguments</param>
+    /// <param name="cc">Calling convention</param>
+    /// <param name="retType">Return type</param>
+    /// <returns>Status code</returns>
+    NTSTATUS BuildCallSite( CallSite& site, vecArgs& args, eCalligConvention cc, eReturnType retType );
+
+    /// <summary>
+    /// Publish target pointer, argument slots and staged data with one remote write
+    /// </summary>
+    /// <param name="site">Target site</param>
+    /// <param name="args">Function arguments</param>
+    /// <param name="pfn">Remote function pointer</param>
+    /// <returns>Status code</returns>
+    NTSTATUS StageSiteArguments( CallSite& site, vecArgs& args, ptr_t pfn );
+
+    /// <summary>
+    /// Hash call shape: convention, return type, argument layout
+    /// </summary>
+    static uint64_t SiteSignature( const vecArgs& args, eCalligConvention cc, eReturnType retType );
+
     /// <summary>
     /// Copy executable code into remote codecave for future execution
     /// </summary>
@@ -218,12 +417,21 @@ private:
     class ProcessThreads& _threads;
 
     ThreadPtr _workerThread;    // Worker thread handle
-    ThreadPtr _hijackThread;    // Thread to use for hijacking  
+    ThreadPtr _hijackThread;    // Thread to use for hijacking
     HANDLE    _hWaitEvent;      // APC sync event handle
     MemBlock  _workerCode;      // Worker thread address space
     MemBlock  _userCode;        // Codecave for code execution
     MemBlock  _userData;        // Region to store copied structures and strings
+    HANDLE    _hSharedSection;  // Section backing _userData, if shared
+    void*     _pUserDataLocal;  // Local view of the shared section
+    uint32_t  _callSeq;         // Sequence number of the last dispatched call
     bool      _apcPatched;      // KiUserApcDispatcher was patched
+
+    AsmHelperPtr _batchAsm;     // Pipeline command buffer under construction
+    uint32_t  _batchCount;      // Queued pipeline calls
+    uintptr_t _batchDataOffset; // Argument staging offset for the pipeline
+
+    std::map<uint64_t, CallSite> _callSites;    // Cached call stubs keyed by call shape
 };
 
 
@@ -2,6 +2,7 @@
 
 #include "../../Include/CallResult.h"
 #include "../../Asm/IAsmHelper.h"
+#include "../../Asm/AsmLayout.hpp"
 #include "../Process.h"
 
 #include <type_traits>
@@ -17,6 +18,9 @@ class RemoteFunctionBase
 public:
     using ReturnType = std::conditional_t<std::is_same_v<R, void>, int, R>;
 
+    // Whole-signature marshaling layout, a compile-time constant
+    using Layout = AsmCallLayout<Conv, Args...>;
+
     struct CallArguments
     {
         CallArguments( const Args&... args )
@@ -32,6 +36,7 @@ public:
 
         CallArguments( const std::initializer_list<AsmVariant>& args )
             : arguments{ args }
+            , fromList( true )
         {
             // Since initializer_list can't be moved from, dataStruct types must be fixed
             for (auto& arg : arguments)
@@ -49,6 +54,9 @@ public:
         }
 
         std::vector<AsmVariant> arguments;
+        // Hand-built lists bypass the signature, so the compile-time
+        // layout cannot vouch for them
+        bool fromList = false;
     };
 
 public:
@@ -90,19 +98,25 @@ public:
         else if constexpr (!std::is_reference_v<ReturnType> && sizeof( ReturnType ) > sizeof( uint64_t ))
             retType = rt_struct;
 
-        _process.remote().PrepareCallAssembly( *a, _ptr, args.arguments, Conv, retType );
-
         // Choose execution thread
         if (!contextThread)
         {
+            _process.remote().PrepareCallAssembly( *a, _ptr, args.arguments, Conv, retType );
             status = _process.remote().ExecInNewThread( (*a)->make(), (*a)->getCodeSize(), tmpResult );
         }
         else if (contextThread == _process.remote().getWorker())
         {
-            status = _process.remote().ExecInWorkerThread( (*a)->make(), (*a)->getCodeSize(), tmpResult );
+            // Re-triggering a cached call-site stub skips per-call assembly and code copy
+            status = _process.remote().ExecCached( _ptr, args.arguments, Conv, retType, tmpResult );
+            if (status == STATUS_NOT_SUPPORTED || status == STATUS_INVALID_DEVICE_STATE)
+            {
+                _process.remote().PrepareCallAssembly( *a, _ptr, args.arguments, Conv, retType );
+                status = _process.remote().ExecInWorkerThread( (*a)->make(), (*a)->getCodeSize(), tmpResult );
+            }
         }
         else
         {
+            _process.remote().PrepareCallAssembly( *a, _ptr, args.arguments, Conv, retType );
             status = _process.remote().ExecInAnyThread( (*a)->make(), (*a)->getCodeSize(), tmpResult, contextThread );
         }
 
@@ -110,10 +124,22 @@ public:
         if (!NT_SUCCESS( status ) || !NT_SUCCESS( status = _process.remote().GetCallResult( result ) ))
             return call_result_t<ReturnType>( result, status );
 
-        // Update arguments
-        for (auto& arg : args.arguments)
-            if (arg.type == AsmVariant::dataPtr)
-                _process.memory().Read( arg.new_imm_val, arg.size, reinterpret_cast<void*>(arg.imm_val) );
+        // Update arguments. Output data sits in the same block the call
+        // protocol completes through, so no extra round trip is needed
+        // when the block is shared. Signatures without pointer arguments
+        // skip the whole pass at compile time
+        if constexpr (Layout::data_copy_count != 0)
+        {
+            for (auto& arg : args.arguments)
+                if (arg.type == AsmVariant::dataPtr)
+                    _process.remote().ReadStagedData( arg.new_imm_val, arg.size, reinterpret_cast<void*>(arg.imm_val) );
+        }
+        else if (args.fromList)
+        {
+            for (auto& arg : args.arguments)
+                if (arg.type == AsmVariant::dataPtr)
+                    _process.remote().ReadStagedData( arg.new_imm_val, arg.size, reinterpret_cast<void*>(arg.imm_val) );
+        }
 
         return call_result_t<ReturnType>( result, STATUS_SUCCESS );
     }
@@ -44,7 +44,7 @@ NTSTATUS RemoteHook::EnsureDebug()
     BOOL isDebugged = FALSE;
 
     // Can't debug x64 process from x32 one.
-    if (_core.native()->GetWow64Barrier().type == wow_32_64)
+    if (_core.barrier().type == wow_32_64)
         return STATUS_OBJECT_TYPE_MISMATCH;
 
     // Already under debugger
@@ -247,7 +247,7 @@ DWORD RemoteHook::EventThread()
     _debugPID = _core.pid();
 
     // Determine if target is Wow64
-    _x64Target = !_core.native()->GetWow64Barrier().targetWow64;
+    _x64Target = !_core.barrier().targetWow64;
     _wordSize = _x64Target ? sizeof( int64_t ) : sizeof( int32_t );
 
     // 
@@ -410,7 +410,7 @@ DWORD RemoteHook::OnSinglestep( const DEBUG_EVENT& DebugEv )
     // Prevent highest bit extension.
     ptr_t addr = (uintptr_t)DebugEv.u.Exception.ExceptionRecord.ExceptionAddress;
     ptr_t ip = 0, sp = 0;
-    bool use64 = !_core.native()->GetWow64Barrier().x86OS;
+    bool use64 = !_core.barrier().x86OS;
     _CONTEXT32 ctx32 = { 0 };
     _CONTEXT64 ctx64 = { 0 };
 
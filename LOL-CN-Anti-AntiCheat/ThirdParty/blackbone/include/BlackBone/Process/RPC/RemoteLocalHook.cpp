@@ -1,6 +1,7 @@
 #include "RemoteLocalHook.h"
 
 #include "../Process.h"
+#include "../WriteBatch.h"
 #include "../../Asm/LDasm.h"
 
 namespace blackbone
@@ -33,20 +34,30 @@ NTSTATUS RemoteLocalHook::AllocateMem( ptr_t /*address*/, size_t codeSize )
 }
 
 NTSTATUS RemoteLocalHook::SetHook( ptr_t address, asmjit::Assembler& hook )
+{
+    NTSTATUS status = Prepare( address, hook );
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    return InstallSet( _process, { this } );
+}
+
+NTSTATUS RemoteLocalHook::Prepare( ptr_t address, asmjit::Assembler& hook )
 {
     _address = address;
+    _prepared = false;
+
     NTSTATUS status = AllocateMem( address, hook.getCodeSize() );
     if (!NT_SUCCESS( status ))
         return status;
 
-    return _process.core().isWow64() ? SetHook32( address, hook ) : SetHook64( address, hook );
+    return _process.core().isWow64() ? Prepare32( address, hook ) : Prepare64( address, hook );
 }
 
-NTSTATUS RemoteLocalHook::SetHook32( ptr_t address, asmjit::Assembler& hook )
+NTSTATUS RemoteLocalHook::Prepare32( ptr_t address, asmjit::Assembler& hook )
 {
-    NTSTATUS status = STATUS_SUCCESS;
-    auto& mem = _process.memory();
-
+    // The only remote access of the whole preparation: the target
+    // prologue is fetched once and relocated locally
     if (!CopyOldCode( address, false ))
         return STATUS_PARTIAL_COPY;
 
@@ -58,26 +69,51 @@ NTSTATUS RemoteLocalHook::SetHook32( ptr_t address, asmjit::Assembler& hook )
     hook.setBaseAddress( _hookData.ptr<int32_t>() );
     hook.relocCode( buf );
 
-    mem.Write( _pHookCode, buf );
-    mem.Write( _pThunkCode, _ctx.hook32.codeSize + _ctx.hook32.jmp_size, _ctx.hook32.original_code );
-
-    DWORD flOld = 0;
-    mem.Protect( address, sizeof( _ctx.hook32.jmp_code ), PAGE_EXECUTE_READWRITE, &flOld );
-    status = mem.Write( address, _ctx.hook32.jmp_code );
-    mem.Protect( address, sizeof( _ctx.hook32.jmp_code ), flOld );
+    _hookCode.assign( buf, buf + hook.getCodeSize() );
+    _prepared = true;
 
-    if (NT_SUCCESS( status ))
-        _hooked = true;
-
-    return status;
+    return STATUS_SUCCESS;
 }
 
-NTSTATUS RemoteLocalHook::SetHook64( ptr_t /*address*/, asmjit::Assembler& /*hook*/ )
+NTSTATUS RemoteLocalHook::Prepare64( ptr_t /*address*/, asmjit::Assembler& /*hook*/ )
 {
     _hook64 = true;
     return STATUS_NOT_IMPLEMENTED;
 }
 
+NTSTATUS RemoteLocalHook::Stage( WriteBatch& batch )
+{
+    if (!_prepared)
+        return STATUS_INVALID_PARAMETER;
+
+    batch.Add( _pHookCode, _hookCode.data(), _hookCode.size() );
+    batch.Add( _pThunkCode, _ctx.hook32.original_code, _ctx.hook32.codeSize + _ctx.hook32.jmp_size );
+    batch.Add( _address, _ctx.hook32.jmp_code, sizeof( _ctx.hook32.jmp_code ) );
+
+    return STATUS_SUCCESS;
+}
+
+NTSTATUS RemoteLocalHook::InstallSet( Process& process, const std::vector<RemoteLocalHook*>& hooks )
+{
+    WriteBatch batch( process.memory() );
+
+    for (auto pHook : hooks)
+    {
+        NTSTATUS status = pHook->Stage( batch );
+        if (!NT_SUCCESS( status ))
+            return status;
+    }
+
+    // One coalesced pass: protection flips and writes are per merged
+    // span, not per hook site
+    NTSTATUS status = batch.Flush();
+    if (NT_SUCCESS( status ))
+        for (auto pHook : hooks)
+            pHook->Confirm();
+
+    return status;
+}
+
 NTSTATUS RemoteLocalHook::Restore()
 {
     if (!_hooked)
@@ -91,9 +127,11 @@ NTSTATUS RemoteLocalHook::Restore()
     if (NT_SUCCESS( status ))
     {
         _hookData.Free();
+        _hookCode.clear();
         _pHookCode = _pThunkCode = 0;
         _address = 0;
         _hooked = false;
+        _prepared = false;
     }
 
     return status;
@@ -5,6 +5,8 @@
 #include "../../Include/Types.h"
 #include "../MemBlock.h"
 
+#include <vector>
+
 
 namespace blackbone
 {
@@ -47,7 +49,12 @@ union HookCtx
 
 
 /// <summary>
-/// In-process remote hook
+/// In-process remote hook.
+/// A hook may be prepared ahead of installation: Prepare fetches the
+/// target bytes once and precomputes the relocated prologue and detour
+/// code locally, Stage queues the resulting writes into a WriteBatch, so
+/// a fixed set of sites installs with one batched write pass instead of
+/// one assemble/read/write cycle per site
 /// </summary>
 class RemoteLocalHook
 {
@@ -58,15 +65,47 @@ public:
     NTSTATUS SetHook( ptr_t address, asmjit::Assembler& hook );
     NTSTATUS Restore();
 
+    /// <summary>
+    /// Precompute everything the hook needs: allocate the remote block,
+    /// read the target prologue once, relocate it, and assemble the
+    /// detour code locally. The target is not touched
+    /// </summary>
+    /// <param name="address">Target address</param>
+    /// <param name="hook">Hook code</param>
+    /// <returns>Status code</returns>
+    NTSTATUS Prepare( ptr_t address, asmjit::Assembler& hook );
+
+    /// <summary>
+    /// Queue the prepared code and patch writes into a batch.
+    /// Call Confirm after the batch flush succeeds
+    /// </summary>
+    /// <param name="batch">Batch collecting writes for the whole hook set</param>
+    /// <returns>Status code</returns>
+    NTSTATUS Stage( class WriteBatch& batch );
+
+    /// <summary>
+    /// Mark the staged hook live after its batch was flushed
+    /// </summary>
+    void Confirm() { _hooked = _prepared; }
+
+    /// <summary>
+    /// Prepare, stage and flush in one go.
+    /// A set of hooks should share one batch via Prepare/Stage instead
+    /// </summary>
+    /// <param name="hooks">Hooks to install, all prepared</param>
+    /// <param name="process">Target process</param>
+    /// <returns>Status code</returns>
+    static NTSTATUS InstallSet( class Process& process, const std::vector<RemoteLocalHook*>& hooks );
+
 private:
     RemoteLocalHook( const RemoteLocalHook& ) = delete;
     RemoteLocalHook& operator = (const RemoteLocalHook&) = delete;
 
     NTSTATUS AllocateMem( ptr_t address, size_t codeSize );
 
-    NTSTATUS SetHook32( ptr_t address, asmjit::Assembler& hook );
+    NTSTATUS Prepare32( ptr_t address, asmjit::Assembler& hook );
 
-    NTSTATUS SetHook64( ptr_t address, asmjit::Assembler& hook );
+    NTSTATUS Prepare64( ptr_t address, asmjit::Assembler& hook );
 
     bool CopyOldCode( ptr_t address, bool x64 );
 
@@ -78,6 +117,9 @@ private:
     ptr_t _pThunkCode = 0;
     ptr_t _address = 0;
 
+    std::vector<uint8_t> _hookCode; // Relocated detour code, ready to copy
+
+    bool _prepared = false;
     bool _hooked = false;
     bool _hook64 = false;
 };
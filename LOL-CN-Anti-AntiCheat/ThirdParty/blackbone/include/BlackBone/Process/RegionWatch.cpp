@@ -0,0 +1,123 @@
+#include "RegionWatch.h"
+#include "ProcessMemory.h"
+#include "../Misc/HashKernels.h"
+
+namespace blackbone
+{
+
+namespace
+{
+const size_t pageSize = 0x1000;
+}
+
+RegionWatch::RegionWatch( ProcessMemory& memory )
+    : _memory( memory )
+{
+}
+
+/// <summary>
+/// Compute 64-bit digest of one page
+/// </summary>
+/// <param name="pData">Page data</param>
+/// <param name="size">Data size</param>
+/// <returns>Digest</returns>
+uint64_t RegionWatch::PageDigest( const uint8_t* pData, size_t size )
+{
+    // SIMD kernel picked from the CPU capture; digests are in-memory
+    // per-session state, so kernel-dependent values are fine here
+    return Digest64( pData, size );
+}
+
+/// <summary>
+/// Start watching a range. Bounds are expanded to page granularity
+/// and the baseline digests are captured immediately.
+/// </summary>
+/// <param name="address">Range start</param>
+/// <param name="size">Range size</param>
+/// <returns>Status</returns>
+NTSTATUS RegionWatch::Watch( ptr_t address, size_t size )
+{
+    if (address == 0 || size == 0)
+        return STATUS_INVALID_PARAMETER;
+
+    const ptr_t base = address & ~static_cast<ptr_t>(pageSize - 1);
+    const size_t aligned = Align( static_cast<size_t>(address - base) + size, pageSize );
+
+    if (_buffer.size() < aligned)
+        _buffer.resize( aligned );
+
+    NTSTATUS status = _memory.Read( base, aligned, _buffer.data() );
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    Range range;
+    range.size = aligned;
+    range.digests.reserve( aligned / pageSize );
+
+    for (size_t page = 0; page < aligned; page += pageSize)
+        range.digests.emplace_back( PageDigest( _buffer.data() + page, pageSize ) );
+
+    _ranges[base] = std::move( range );
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Stop watching a range
+/// </summary>
+/// <param name="address">Range start passed to Watch</param>
+/// <returns>Status</returns>
+NTSTATUS RegionWatch::Unwatch( ptr_t address )
+{
+    const ptr_t base = address & ~static_cast<ptr_t>(pageSize - 1);
+    return _ranges.erase( base ) != 0 ? STATUS_SUCCESS : STATUS_NOT_FOUND;
+}
+
+/// <summary>
+/// Re-read all watched ranges and report pages whose digest changed.
+/// Reported digests become the new baseline.
+/// </summary>
+/// <param name="changed">Receives changed pages</param>
+/// <returns>Status. Unreadable ranges are skipped, not treated as changed</returns>
+NTSTATUS RegionWatch::Poll( std::vector<PageChange>& changed )
+{
+    if (_ranges.empty())
+        return STATUS_NOT_FOUND;
+
+    for (auto& entry : _ranges)
+    {
+        if (_buffer.size() < entry.second.size)
+            _buffer.resize( entry.second.size );
+
+        // One bulk read per range; pages the target unmapped or
+        // reprotected since the baseline are skipped until readable again
+        if (!NT_SUCCESS( _memory.Read( entry.first, entry.second.size, _buffer.data() ) ))
+            continue;
+
+        for (size_t i = 0; i < entry.second.digests.size(); i++)
+        {
+            const uint64_t digest = PageDigest( _buffer.data() + i * pageSize, pageSize );
+            if (digest == entry.second.digests[i])
+                continue;
+
+            changed.emplace_back( PageChange{ entry.first + i * pageSize, entry.second.digests[i], digest } );
+            entry.second.digests[i] = digest;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Get number of watched pages
+/// </summary>
+/// <returns>Page count</returns>
+size_t RegionWatch::pages() const
+{
+    size_t total = 0;
+    for (const auto& entry : _ranges)
+        total += entry.second.digests.size();
+
+    return total;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MemBlock.h"
+
+#include <map>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Changed page report
+/// </summary>
+struct PageChange
+{
+    ptr_t address = 0;          // Page base address
+    uint64_t oldDigest = 0;     // Digest at previous poll
+    uint64_t newDigest = 0;     // Digest at this poll
+};
+
+/// <summary>
+/// Change detection over remote memory regions.
+/// Keeps one 64-bit digest per page of each watched range instead of a
+/// full copy, re-reads ranges in single bulk operations on every poll
+/// and reports only the pages whose digest changed since the last one.
+/// </summary>
+class RegionWatch
+{
+public:
+    BLACKBONE_API RegionWatch( class ProcessMemory& memory );
+    BLACKBONE_API ~RegionWatch() = default;
+
+    /// <summary>
+    /// Start watching a range. Bounds are expanded to page granularity
+    /// and the baseline digests are captured immediately.
+    /// </summary>
+    /// <param name="address">Range start</param>
+    /// <param name="size">Range size</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Watch( ptr_t address, size_t size );
+
+    /// <summary>
+    /// Stop watching a range
+    /// </summary>
+    /// <param name="address">Range start passed to Watch</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Unwatch( ptr_t address );
+
+    /// <summary>
+    /// Re-read all watched ranges and report pages whose digest changed.
+    /// Reported digests become the new baseline.
+    /// </summary>
+    /// <param name="changed">Receives changed pages</param>
+    /// <returns>Status. Unreadable ranges are skipped, not treated as changed</returns>
+    BLACKBONE_API NTSTATUS Poll( std::vector<PageChange>& changed );
+
+    /// <summary>
+    /// Get number of watched pages
+    /// </summary>
+    /// <returns>Page count</returns>
+    BLACKBONE_API size_t pages() const;
+
+    /// <summary>
+    /// Compute 64-bit digest of one page
+    /// </summary>
+    /// <param name="pData">Page data</param>
+    /// <param name="size">Data size</param>
+    /// <returns>Digest</returns>
+    BLACKBONE_API static uint64_t PageDigest( const uint8_t* pData, size_t size );
+
+private:
+    RegionWatch( const RegionWatch& ) = delete;
+    RegionWatch& operator =( const RegionWatch& ) = delete;
+
+private:
+    struct Range
+    {
+        size_t size = 0;                // Page-aligned range size
+        std::vector<uint64_t> digests;  // One digest per page
+    };
+
+    class ProcessMemory& _memory;       // Target process memory
+    std::map<ptr_t, Range> _ranges;     // Watched ranges by page-aligned base
+    std::vector<uint8_t> _buffer;       // Reusable read buffer
+};
+
+}
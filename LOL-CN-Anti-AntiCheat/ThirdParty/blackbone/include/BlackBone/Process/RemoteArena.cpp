@@ -0,0 +1,107 @@
+#include "RemoteArena.h"
+#include "ProcessMemory.h"
+
+#include <algorithm>
+
+namespace blackbone
+{
+
+RemoteArena::RemoteArena( ProcessMemory& memory )
+    : _memory( memory )
+{
+}
+
+/// <summary>
+/// Reserve the backing region in the target process
+/// </summary>
+/// <param name="size">Arena size</param>
+/// <param name="protection">Memory protection of the backing region</param>
+/// <returns>Status</returns>
+NTSTATUS RemoteArena::Init( size_t size /*= 0x200000*/, DWORD protection /*= PAGE_EXECUTE_READWRITE*/ )
+{
+    auto block = MemBlock::Allocate( _memory, size, 0, protection );
+    if (!block.success())
+        return block.status;
+
+    _backing = std::move( block.result() );
+    _free.assign( 1, Span{ _backing.ptr(), _backing.size() } );
+    _allocs.clear();
+
+    return STATUS_SUCCESS;
+}
+
+/// <summary>
+/// Sub-allocate a block from the arena without kernel calls
+/// </summary>
+/// <param name="size">Block size</param>
+/// <returns>Memory block. If failed - returned block will be invalid</returns>
+call_result_t<MemBlock> RemoteArena::Allocate( size_t size )
+{
+    if (!_backing.valid())
+        return call_result_t<MemBlock>( STATUS_NOT_FOUND );
+
+    // Keep sub-allocations pointer-aligned
+    size = Align( size, 16 );
+
+    // First fit
+    for (size_t i = 0; i < _free.size(); i++)
+    {
+        if (_free[i].size < size)
+            continue;
+
+        const ptr_t ptr = _free[i].ptr;
+
+        if (_free[i].size == size)
+            _free.erase( _free.begin() + i );
+        else
+        {
+            _free[i].ptr += size;
+            _free[i].size -= size;
+        }
+
+        _allocs.emplace( ptr, size );
+
+        // Block does not own the memory, arena keeps the reservation
+        return call_result_t<MemBlock>( MemBlock( &_memory, ptr, size, _backing.protection(), false ) );
+    }
+
+    return call_result_t<MemBlock>( STATUS_NO_MEMORY );
+}
+
+/// <summary>
+/// Return a sub-allocated block to the arena free list
+/// </summary>
+/// <param name="ptr">Block address obtained from Allocate</param>
+/// <returns>Status</returns>
+NTSTATUS RemoteArena::Free( ptr_t ptr )
+{
+    auto found = _allocs.find( ptr );
+    if (found == _allocs.end())
+        return STATUS_NOT_FOUND;
+
+    Span span{ found->first, found->second };
+    _allocs.erase( found );
+
+    auto pos = std::lower_bound( _free.begin(), _free.end(), span,
+        []( const Span& a, const Span& b ) { return a.ptr < b.ptr; } );
+
+    pos = _free.insert( pos, span );
+
+    // Coalesce with the following span
+    if (pos + 1 != _free.end() && pos->ptr + pos->size == (pos + 1)->ptr)
+    {
+        pos->size += (pos + 1)->size;
+        _free.erase( pos + 1 );
+    }
+
+    // Coalesce with the preceding span
+    if (pos != _free.begin() && (pos - 1)->ptr + (pos - 1)->size == pos->ptr)
+    {
+        (pos - 1)->size += pos->size;
+        _free.erase( pos );
+    }
+
+    return STATUS_SUCCESS;
+}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "MemBlock.h"
+
+#include <map>
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Remote allocation arena.
+/// Reserves one large region in the target process up front and serves
+/// sub-allocations from a local free list, so the frequent short-lived
+/// blocks created by remote calls cost no NtAllocateVirtualMemory /
+/// NtFreeVirtualMemory round trips after the initial reservation.
+/// </summary>
+class RemoteArena
+{
+public:
+    BLACKBONE_API RemoteArena( class ProcessMemory& memory );
+    BLACKBONE_API ~RemoteArena() = default;
+
+    /// <summary>
+    /// Reserve the backing region in the target process
+    /// </summary>
+    /// <param name="size">Arena size</param>
+    /// <param name="protection">Memory protection of the backing region</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Init( size_t size = 0x200000, DWORD protection = PAGE_EXECUTE_READWRITE );
+
+    /// <summary>
+    /// Sub-allocate a block from the arena without kernel calls.
+    /// The returned MemBlock does not own its memory, return it with Free.
+    /// </summary>
+    /// <param name="size">Block size</param>
+    /// <returns>Memory block. If failed - returned block will be invalid</returns>
+    BLACKBONE_API call_result_t<MemBlock> Allocate( size_t size );
+
+    /// <summary>
+    /// Return a sub-allocated block to the arena free list
+    /// </summary>
+    /// <param name="ptr">Block address obtained from Allocate</param>
+    /// <returns>Status</returns>
+    BLACKBONE_API NTSTATUS Free( ptr_t ptr );
+
+    BLACKBONE_API ptr_t base() const { return _backing.ptr(); }
+    BLACKBONE_API size_t size() const { return _backing.size(); }
+    BLACKBONE_API bool valid() const { return _backing.valid(); }
+
+private:
+    RemoteArena( const RemoteArena& ) = delete;
+    RemoteArena& operator =( const RemoteArena& ) = delete;
+
+private:
+    struct Span
+    {
+        ptr_t ptr;
+        size_t size;
+    };
+
+    class ProcessMemory& _memory;       // Target process memory
+    MemBlock _backing;                  // Single remote reservation
+    std::vector<Span> _free;            // Free spans, sorted by address
+    std::map<ptr_t, size_t> _allocs;    // Live sub-allocations
+};
+
+}
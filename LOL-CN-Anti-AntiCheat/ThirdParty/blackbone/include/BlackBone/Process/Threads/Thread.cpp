@@ -9,13 +9,13 @@ namespace blackbone
 Thread::Thread( DWORD id, ProcessCore* core, DWORD access /*= DEFAULT_ACCESS*/ )
     : _core( core )
     , _id( id )
-    , _handle( OpenThread( access, FALSE, id ) )
-{  
+    , _handle( HandleCache::Instance().LeaseThread( id, access ) )
+{
 }
 
 Thread::Thread( HANDLE handle, ProcessCore* core )
     : _core( core )
-    , _handle( handle )
+    , _handle( HandleLease::Owned( handle ) )
 {
     _id = (handle ? GetThreadIdT( handle ) : 0);
 }
@@ -56,7 +56,7 @@ bool Thread::Suspend()
         return true;
     
     // Target process is x86 and not running on x86 OS
-    const auto& barrier = _core->native()->GetWow64Barrier();
+    const auto& barrier = _core->barrier();
     if (barrier.type == wow_64_32 && !barrier.x86OS)
         return (SAFE_CALL(Wow64SuspendThread, _handle ) != -1);
     else
@@ -84,7 +84,7 @@ bool Thread::Suspended()
     if (_id == GetCurrentThreadId())
         return false;
 
-    auto count = (_core->isWow64() && !_core->native()->GetWow64Barrier().x86OS)
+    auto count = (_core->isWow64() && !_core->barrier().x86OS)
         ? SAFE_CALL( Wow64SuspendThread, _handle )
         : SuspendThread( _handle );
 
@@ -211,7 +211,7 @@ call_result_t<int> Thread::AddHWBP( ptr_t addr, HWBPType type, HWBPLength length
 {
     _CONTEXT64 context64 = { 0 };
     _CONTEXT32 context32 = { 0 };
-    bool use64 = !_core->native()->GetWow64Barrier().x86OS;
+    bool use64 = !_core->barrier().x86OS;
 
     // CONTEXT_DEBUG_REGISTERS can be operated without thread suspension
     auto status = use64 ? GetContext( context64, CONTEXT64_DEBUG_REGISTERS, true ) : GetContext( context32, CONTEXT_DEBUG_REGISTERS, true );
@@ -260,7 +260,7 @@ NTSTATUS Thread::RemoveHWBP( int idx )
    
     _CONTEXT64 context64 = { 0 };
     _CONTEXT32 context32 = { 0 };
-    bool use64 = !_core->native()->GetWow64Barrier().x86OS;
+    bool use64 = !_core->barrier().x86OS;
     auto status = use64 ? GetContext( context64, CONTEXT64_DEBUG_REGISTERS, true ) : GetContext( context32, CONTEXT_DEBUG_REGISTERS, true );
     auto pDR7 = use64 ? reinterpret_cast<regDR7*>(&context64.Dr7) : reinterpret_cast<regDR7*>(&context32.Dr7);
     if (!NT_SUCCESS( status ))
@@ -284,7 +284,7 @@ NTSTATUS Thread::RemoveHWBP( ptr_t ptr )
 {
     _CONTEXT64 context64 = { 0 };
     _CONTEXT32 context32 = { 0 };
-    bool use64 = !_core->native()->GetWow64Barrier().x86OS;
+    bool use64 = !_core->barrier().x86OS;
     auto status = use64 ? GetContext( context64, CONTEXT64_DEBUG_REGISTERS, true ) : GetContext( context32, CONTEXT_DEBUG_REGISTERS, true );
     auto pDR7 = use64 ? reinterpret_cast<regDR7*>(&context64.Dr7) : reinterpret_cast<regDR7*>(&context32.Dr7);
     if (!NT_SUCCESS( status ))
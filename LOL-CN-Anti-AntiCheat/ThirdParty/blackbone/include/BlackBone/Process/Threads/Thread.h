@@ -6,6 +6,7 @@
 #include "../../Include/CallResult.h"
 #include "../../Include/HandleGuard.h"
 #include "../../Include/Types.h"
+#include "../../Misc/HandleCache.h"
 #include "../../Misc/Utils.h"
 
 #include <memory>
@@ -268,7 +269,7 @@ private:
     class ProcessCore* _core;       // Core routines
 
     DWORD _id = 0;                  // Thread ID
-    ProcessHandle _handle;          // Thread handle
+    HandleLease _handle;            // Thread handle, leased from the process-wide cache
 };
 
 using ThreadPtr = std::shared_ptr<Thread>;
@@ -1,16 +1,116 @@
 #include "Threads.h"
 #include "../ProcessCore.h"
+#include "../ProcessMemory.h"
 #include "../../DriverControl/DriverControl.h"
+#include "../../Misc/DynImport.h"
 
+#include <emmintrin.h>
 #include <memory>
 #include <random>
 #include <algorithm>
 
 namespace blackbone
 {
-    
+
+ThreadSnapshot::ThreadSnapshot( ProcessCore& core )
+    : _core( core )
+{
+}
+
+ThreadSnapshot::~ThreadSnapshot()
+{
+    if (_buffer)
+        VirtualFree( _buffer, 0, MEM_RELEASE );
+}
+
+/// <summary>
+/// Refresh the snapshot from a new system query
+/// </summary>
+/// <returns>Status code</returns>
+NTSTATUS ThreadSnapshot::Update()
+{
+    ULONG returnLength = 0;
+    NTSTATUS status = STATUS_INFO_LENGTH_MISMATCH;
+
+    // Query into the existing buffer; grow only when the system outgrew it
+    if (_buffer)
+        status = SAFE_NATIVE_CALL( NtQuerySystemInformation, (SYSTEM_INFORMATION_CLASS)57, _buffer, _bufSize, &returnLength );
+
+    while (status == STATUS_INFO_LENGTH_MISMATCH)
+    {
+        if (_buffer)
+            VirtualFree( _buffer, 0, MEM_RELEASE );
+
+        // Over-allocate so thread churn between polls doesn't force a regrow
+        _bufSize = (returnLength != 0 ? returnLength : 0x100000) + 0x10000;
+        _buffer = (uint8_t*)VirtualAlloc( NULL, _bufSize, MEM_COMMIT, PAGE_READWRITE );
+        if (!_buffer)
+        {
+            _bufSize = 0;
+            return STATUS_NO_MEMORY;
+        }
+
+        status = SAFE_NATIVE_CALL( NtQuerySystemInformation, (SYSTEM_INFORMATION_CLASS)57, _buffer, _bufSize, &returnLength );
+    }
+
+    if (!NT_SUCCESS( status ))
+        return status;
+
+    // Locate target process entry
+    std::vector<ThreadRef> captured;
+    for (auto pInfo = reinterpret_cast<_SYSTEM_PROCESS_INFORMATION_T<DWORD_PTR>*>(_buffer);;)
+    {
+        if (pInfo->UniqueProcessId == _core.pid())
+        {
+            captured.reserve( pInfo->NumberOfThreads );
+            for (ULONG i = 0; i < pInfo->NumberOfThreads; i++)
+            {
+                auto& thd = pInfo->Threads[i];
+
+                ThreadRef ref;
+                ref.tid = static_cast<DWORD>(thd.ThreadInfo.ClientId.UniqueThread);
+                ref.startAddress = thd.ThreadInfo.StartAddress;
+                ref.createTime = thd.ThreadInfo.CreateTime.QuadPart;
+
+                captured.emplace_back( ref );
+            }
+
+            break;
+        }
+
+        if (pInfo->NextEntryOffset)
+            pInfo = reinterpret_cast<_SYSTEM_PROCESS_INFORMATION_T<DWORD_PTR>*>((uint8_t*)pInfo + pInfo->NextEntryOffset);
+        else
+            break;
+    }
+
+    std::sort( captured.begin(), captured.end(), []( const ThreadRef& a, const ThreadRef& b ) { return a.tid < b.tid; } );
+
+    // Delta against the previous generation, both sides sorted by tid
+    _created.clear();
+    _exited.clear();
+
+    auto itNew = captured.begin();
+    auto itOld = _threads.begin();
+    while (itNew != captured.end() || itOld != _threads.end())
+    {
+        if (itOld == _threads.end() || (itNew != captured.end() && itNew->tid < itOld->tid))
+            _created.emplace_back( *itNew++ );
+        else if (itNew == captured.end() || itOld->tid < itNew->tid)
+            _exited.emplace_back( (itOld++)->tid );
+        else
+            ++itNew, ++itOld;
+    }
+
+    _threads.swap( captured );
+    _generation++;
+
+    return status;
+}
+
 ProcessThreads::ProcessThreads( ProcessCore& core )
     : _core( core )
+    , _snapshot( core )
 {
 }
 
@@ -61,6 +161,7 @@ std::vector<ThreadPtr> ProcessThreads::getAll() const
     tEntry.dwSize = sizeof( THREADENTRY32 );
 
     // Iterate threads
+    std::vector<DWORD> liveIds;
     for (BOOL success = Thread32First( hThreadSnapshot, &tEntry );
         success != FALSE;
         success = Thread32Next( hThreadSnapshot, &tEntry ))
@@ -68,12 +169,173 @@ std::vector<ThreadPtr> ProcessThreads::getAll() const
         if (tEntry.th32OwnerProcessID != _core.pid())
             continue;
 
+        liveIds.emplace_back( tEntry.th32ThreadID );
         result.emplace_back( std::make_shared<Thread>( tEntry.th32ThreadID, &_core ) );
     }
 
+    // Retire leases for threads gone from this snapshot, costs no syscalls
+    HandleCache::Instance().Trim( liveIds );
+
+    return result;
+}
+
+/// <summary>
+/// Capture contexts from several threads in one suspend cycle.
+/// All targets are suspended in one pass, queried back to back, then
+/// resumed in one pass, instead of a suspend/query/resume round trip
+/// per thread.
+/// </summary>
+/// <param name="targets">Threads to capture</param>
+/// <param name="flags">Context flags</param>
+/// <returns>Captured contexts, one entry per target</returns>
+std::vector<CapturedContext> ProcessThreads::CaptureContexts( const std::vector<ThreadPtr>& targets, DWORD flags ) const
+{
+    // One contiguous allocation for all contexts
+    std::vector<CapturedContext> result( targets.size() );
+    std::vector<bool> suspended( targets.size(), false );
+
+    // Suspend pass
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        result[i].tid = targets[i]->id();
+        result[i].status = STATUS_INVALID_THREAD;
+        suspended[i] = targets[i]->Suspend();
+    }
+
+    // Everything is frozen at the same moment, query contexts back to back
+    for (size_t i = 0; i < targets.size(); i++)
+        if (suspended[i])
+            result[i].status = targets[i]->GetContext( result[i].ctx, flags, true );
+
+    // Resume pass
+    for (size_t i = 0; i < targets.size(); i++)
+        if (suspended[i])
+            targets[i]->Resume();
+
     return result;
 }
 
+namespace
+{
+/// <summary>
+/// 16-byte wide equality compare, tail handled bytewise
+/// </summary>
+/// <param name="pData">Read data</param>
+/// <param name="pExpected">Expected bytes</param>
+/// <param name="size">Compare size</param>
+/// <returns>true if equal</returns>
+bool BytesMatchWide( const uint8_t* pData, const uint8_t* pExpected, size_t size )
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pData + i) );
+        const __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pExpected + i) );
+
+        if (_mm_movemask_epi8( _mm_cmpeq_epi8( a, b ) ) != 0xFFFF)
+            return false;
+    }
+
+    for (; i < size; i++)
+        if (pData[i] != pExpected[i])
+            return false;
+
+    return true;
+}
+}
+
+/// <summary>
+/// Verify known thread entry points across all live threads.
+/// One snapshot update, one scatter read of the entry bytes and one
+/// vectorized compare pass - the whole sweep costs a handful of
+/// syscalls regardless of thread count
+/// </summary>
+/// <param name="expected">Expected entries</param>
+/// <param name="memory">Target process memory</param>
+/// <returns>Per-thread results, one entry per live thread</returns>
+std::vector<EntrySweepResult> ProcessThreads::SweepThreadEntries(
+    const std::vector<EntryExpectation>& expected,
+    ProcessMemory& memory
+    )
+{
+    std::vector<EntrySweepResult> results;
+
+    // One system query covers entry addresses for every live thread
+    if (!NT_SUCCESS( _snapshot.Update() ))
+        return results;
+
+    const auto& threads = _snapshot.threads();
+    results.resize( threads.size() );
+
+    // Match snapshot entries against expectations and size the byte pool
+    std::vector<ptrdiff_t> matched( threads.size(), -1 );
+    size_t poolSize = 0;
+
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        results[i].tid = threads[i].tid;
+        results[i].startAddress = threads[i].startAddress;
+        results[i].readStatus = STATUS_SUCCESS;
+
+        for (size_t j = 0; j < expected.size(); j++)
+        {
+            if (expected[j].entry == threads[i].startAddress)
+            {
+                results[i].knownEntry = true;
+                if (!expected[j].startBytes.empty())
+                {
+                    matched[i] = static_cast<ptrdiff_t>(j);
+                    poolSize += expected[j].startBytes.size();
+                }
+                break;
+            }
+        }
+    }
+
+    if (poolSize == 0)
+        return results;
+
+    // Sized upfront so request buffers stay put
+    std::vector<uint8_t> pool( poolSize );
+    std::vector<ReadScatterRequest> reads;
+    std::vector<size_t> owner;
+
+    size_t poolOffset = 0;
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        if (matched[i] < 0)
+            continue;
+
+        const auto& bytes = expected[matched[i]].startBytes;
+
+        ReadScatterRequest req;
+        req.address = threads[i].startAddress;
+        req.size = bytes.size();
+        req.pResult = pool.data() + poolOffset;
+
+        reads.emplace_back( req );
+        owner.emplace_back( i );
+        poolOffset += bytes.size();
+    }
+
+    // One batched read for every entry, then compare in 16-byte lanes
+    memory.ReadScatter( reads );
+
+    for (size_t r = 0; r < reads.size(); r++)
+    {
+        auto& result = results[owner[r]];
+        result.readStatus = reads[r].status;
+
+        if (NT_SUCCESS( reads[r].status ))
+        {
+            const auto& bytes = expected[matched[owner[r]]].startBytes;
+            result.bytesMatch = BytesMatchWide( static_cast<const uint8_t*>(reads[r].pResult), bytes.data(), bytes.size() );
+        }
+    }
+
+    return results;
+}
+
 /// <summary>
 /// Get main process thread
 /// </summary>
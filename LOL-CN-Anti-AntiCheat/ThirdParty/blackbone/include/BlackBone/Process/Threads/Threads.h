@@ -9,6 +9,102 @@
 namespace blackbone
 {
 
+/// <summary>
+/// Lightweight thread reference taken from a snapshot.
+/// No handle is opened and no Thread object is constructed.
+/// </summary>
+struct ThreadRef
+{
+    DWORD tid = 0;              // Thread ID
+    ptr_t startAddress = 0;     // Thread start address
+    uint64_t createTime = 0;    // Thread creation time
+};
+
+/// <summary>
+/// Reusable snapshot of process threads.
+/// The system information buffer is grown once and reused across updates,
+/// and each update reports the threads created or exited since the previous one.
+/// </summary>
+class ThreadSnapshot
+{
+public:
+    BLACKBONE_API ThreadSnapshot( class ProcessCore& core );
+    BLACKBONE_API ~ThreadSnapshot();
+
+    ThreadSnapshot( const ThreadSnapshot& ) = delete;
+    ThreadSnapshot& operator =( const ThreadSnapshot& ) = delete;
+
+    /// <summary>
+    /// Refresh the snapshot from a new system query
+    /// </summary>
+    /// <returns>Status code</returns>
+    BLACKBONE_API NTSTATUS Update();
+
+    /// <summary>
+    /// All threads captured by the last Update, sorted by thread ID
+    /// </summary>
+    /// <returns>Thread references</returns>
+    BLACKBONE_API const std::vector<ThreadRef>& threads() const { return _threads; }
+
+    /// <summary>
+    /// Threads present in the last Update but not in the one before it
+    /// </summary>
+    /// <returns>Thread references</returns>
+    BLACKBONE_API const std::vector<ThreadRef>& created() const { return _created; }
+
+    /// <summary>
+    /// IDs of threads present in the previous Update but gone from the last one
+    /// </summary>
+    /// <returns>Thread IDs</returns>
+    BLACKBONE_API const std::vector<DWORD>& exited() const { return _exited; }
+
+    /// <summary>
+    /// Number of successful updates
+    /// </summary>
+    /// <returns>Generation counter</returns>
+    BLACKBONE_API uint64_t generation() const { return _generation; }
+
+private:
+    class ProcessCore& _core;           // Core process functions
+    uint8_t* _buffer = nullptr;         // Reused query buffer
+    ULONG _bufSize = 0;                 // Current buffer capacity
+    std::vector<ThreadRef> _threads;    // Last snapshot, sorted by tid
+    std::vector<ThreadRef> _created;    // Delta vs previous snapshot
+    std::vector<DWORD> _exited;         // Delta vs previous snapshot
+    uint64_t _generation = 0;           // Successful update count
+};
+
+/// <summary>
+/// Expected thread entry point for a verification sweep
+/// </summary>
+struct EntryExpectation
+{
+    ptr_t entry = 0;                    // Known-good entry address
+    std::vector<uint8_t> startBytes;    // Expected bytes at the entry, may be empty
+};
+
+/// <summary>
+/// Per-thread result of an entry verification sweep
+/// </summary>
+struct EntrySweepResult
+{
+    DWORD tid = 0;              // Thread ID
+    ptr_t startAddress = 0;     // Entry address from the snapshot
+    bool knownEntry = false;    // Entry matched one of the expectations
+    bool bytesMatch = false;    // Start bytes matched the expectation
+    NTSTATUS readStatus = 0;    // Status of the start-byte read
+};
+
+/// <summary>
+/// Context captured from one thread during a batch capture
+/// </summary>
+struct CapturedContext
+{
+    DWORD tid = 0;          // Thread ID
+    NTSTATUS status = 0;    // Per-thread capture status
+    CONTEXT_T ctx = { };    // Native thread context
+};
+
 class ProcessThreads
 {
 public:
@@ -68,8 +164,47 @@ public:
     /// <returns>Pointer to thread object, nullptr if failed</returns>
     BLACKBONE_API ThreadPtr get( DWORD id ) const;
 
+    /// <summary>
+    /// Capture contexts from several threads in one suspend cycle.
+    /// All targets are suspended in one pass, queried back to back, then
+    /// resumed in one pass, instead of a suspend/query/resume round trip
+    /// per thread.
+    /// </summary>
+    /// <param name="targets">Threads to capture</param>
+    /// <param name="flags">Context flags</param>
+    /// <returns>Captured contexts, one entry per target</returns>
+    BLACKBONE_API std::vector<CapturedContext> CaptureContexts(
+        const std::vector<ThreadPtr>& targets,
+#ifdef USE64
+        DWORD flags = CONTEXT64_ALL
+#else
+        DWORD flags = CONTEXT_ALL
+#endif
+        ) const;
+
+    /// <summary>
+    /// Verify known thread entry points across all live threads.
+    /// One snapshot update, one scatter read of the entry bytes and one
+    /// vectorized compare pass - the whole sweep costs a handful of
+    /// syscalls regardless of thread count
+    /// </summary>
+    /// <param name="expected">Expected entries</param>
+    /// <param name="memory">Target process memory</param>
+    /// <returns>Per-thread results, one entry per live thread</returns>
+    BLACKBONE_API std::vector<EntrySweepResult> SweepThreadEntries(
+        const std::vector<EntryExpectation>& expected,
+        class ProcessMemory& memory
+        );
+
+    /// <summary>
+    /// Get reusable thread snapshot
+    /// </summary>
+    /// <returns>Snapshot object</returns>
+    BLACKBONE_API ThreadSnapshot& snapshot() { return _snapshot; }
+
 private:
     class ProcessCore& _core;   // Core process functions
+    ThreadSnapshot _snapshot;   // Reusable enumeration snapshot
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "WriteBatch.h"
+#include "ProcessMemory.h"
+
+#include <algorithm>
+
+namespace blackbone
+{
+
+WriteBatch::WriteBatch( ProcessMemory& memory )
+    : _memory( memory )
+{
+}
+
+/// <summary>
+/// Queue one patch
+/// </summary>
+/// <param name="address">Remote address to write to</param>
+/// <param name="pData">Bytes to write</param>
+/// <param name="size">Size of data</param>
+void WriteBatch::Add( ptr_t address, const void* pData, size_t size )
+{
+    Patch patch;
+    patch.address = address;
+    patch.data.assign( reinterpret_cast<const uint8_t*>(pData), reinterpret_cast<const uint8_t*>(pData) + size );
+
+    _patches.emplace_back( std::move( patch ) );
+}
+
+/// <summary>
+/// Apply all queued patches and clear the batch
+/// </summary>
+/// <param name="makeWritable">Flip span protection around the write</param>
+/// <returns>STATUS_SUCCESS if every span was applied, otherwise first error</returns>
+NTSTATUS WriteBatch::Flush( bool makeWritable /*= true*/ )
+{
+    constexpr ptr_t pageMask = 0xFFF;
+
+    if (_patches.empty())
+        return STATUS_SUCCESS;
+
+    std::sort( _patches.begin(), _patches.end(), []( const Patch& a, const Patch& b )
+    {
+        return a.address < b.address;
+    } );
+
+    NTSTATUS firstError = STATUS_SUCCESS;
+
+    // Merge runs of patches sharing or touching pages into one span:
+    // one protect, one write, one restore per span
+    for (size_t i = 0; i < _patches.size();)
+    {
+        ptr_t spanStart = _patches[i].address;
+        ptr_t spanEnd = spanStart + _patches[i].data.size();
+
+        size_t j = i + 1;
+        for (; j < _patches.size(); j++)
+        {
+            const ptr_t nextStart = _patches[j].address;
+            if ((nextStart & ~pageMask) > ((spanEnd + pageMask) & ~pageMask))
+                break;
+
+            const ptr_t nextEnd = nextStart + _patches[j].data.size();
+            if (nextEnd > spanEnd)
+                spanEnd = nextEnd;
+        }
+
+        // Gaps between patches keep their current bytes
+        std::vector<uint8_t> span( static_cast<size_t>(spanEnd - spanStart) );
+        auto status = _memory.Read( spanStart, span.size(), span.data() );
+
+        if (NT_SUCCESS( status ))
+        {
+            for (size_t k = i; k < j; k++)
+                memcpy( span.data() + (_patches[k].address - spanStart), _patches[k].data.data(), _patches[k].data.size() );
+
+            DWORD oldProt = 0;
+            if (makeWritable)
+                status = _memory.Protect( spanStart, span.size(), PAGE_EXECUTE_READWRITE, &oldProt );
+
+            if (NT_SUCCESS( status ))
+            {
+                status = _memory.Write( spanStart, span.size(), span.data() );
+
+                if (makeWritable)
+                    _memory.Protect( spanStart, span.size(), oldProt );
+            }
+        }
+
+        if (!NT_SUCCESS( status ) && NT_SUCCESS( firstError ))
+            firstError = status;
+
+        i = j;
+    }
+
+    _patches.clear();
+
+    return firstError;
+}
+
+}
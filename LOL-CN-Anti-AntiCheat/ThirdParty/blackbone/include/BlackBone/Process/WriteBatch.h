@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../Include/Winheaders.h"
+#include "../Include/Types.h"
+
+#include <vector>
+
+namespace blackbone
+{
+
+/// <summary>
+/// Write-coalescing patch builder.
+/// Accumulates (address, bytes) pairs and flushes them with a minimal
+/// syscall sequence: patches are sorted, contiguous ones are merged into
+/// single writes, and protection is flipped once per merged span instead of
+/// once per patch site. Shrinks the window during which target code is
+/// writable and inconsistent.
+/// </summary>
+class WriteBatch
+{
+public:
+    BLACKBONE_API WriteBatch( class ProcessMemory& memory );
+    BLACKBONE_API ~WriteBatch() = default;
+
+    /// <summary>
+    /// Queue one patch
+    /// </summary>
+    /// <param name="address">Remote address to write to</param>
+    /// <param name="pData">Bytes to write</param>
+    /// <param name="size">Size of data</param>
+    BLACKBONE_API void Add( ptr_t address, const void* pData, size_t size );
+
+    /// <summary>
+    /// Queue one patch
+    /// </summary>
+    /// <param name="address">Remote address to write to</param>
+    /// <param name="data">Value to write</param>
+    template<class T>
+    void Add( ptr_t address, const T& data )
+    {
+        Add( address, &data, sizeof( T ) );
+    }
+
+    /// <summary>
+    /// Apply all queued patches and clear the batch
+    /// </summary>
+    /// <param name="makeWritable">
+    /// If true, each merged span is protected PAGE_EXECUTE_READWRITE for the
+    /// write and restored afterwards
+    /// </param>
+    /// <returns>STATUS_SUCCESS if every span was applied, otherwise first error</returns>
+    BLACKBONE_API NTSTATUS Flush( bool makeWritable = true );
+
+    /// <summary>
+    /// Discard queued patches
+    /// </summary>
+    BLACKBONE_API void Clear() { _patches.clear(); }
+
+    BLACKBONE_API size_t count() const { return _patches.size(); }
+
+private:
+    WriteBatch( const WriteBatch& ) = delete;
+    WriteBatch& operator =( const WriteBatch& ) = delete;
+
+private:
+    struct Patch
+    {
+        ptr_t address;              // Remote address
+        std::vector<uint8_t> data;  // Bytes to write
+    };
+
+    class ProcessMemory& _memory;   // Target process memory
+    std::vector<Patch> _patches;    // Queued patches
+};
+
+}
@@ -13,8 +13,14 @@ namespace blackbone
 Native::Native( HANDLE hProcess, bool x86OS /*= false*/ )
     : _hProcess( hProcess )
 {
-    SYSTEM_INFO info = { { 0 } };
-    GetNativeSystemInfo( &info );
+    // Constant for the OS lifetime, queried once
+    static const SYSTEM_INFO info = []()
+    {
+        SYSTEM_INFO si = { { 0 } };
+        GetNativeSystemInfo( &si );
+        return si;
+    }();
+
     _pageSize = info.dwPageSize;
 
     // x86 OS, emulate WOW64 processes
@@ -27,8 +33,15 @@ Native::Native( HANDLE hProcess, bool x86OS /*= false*/ )
     }
     else
     {
-        BOOL wowSrc = FALSE, wowTgt = FALSE;
-        IsWow64Process( GetCurrentProcess(), &wowSrc );
+        // Own bitness never changes, only the target side needs a query
+        static const BOOL wowSrc = []()
+        {
+            BOOL wow = FALSE;
+            IsWow64Process( GetCurrentProcess(), &wow );
+            return wow;
+        }();
+
+        BOOL wowTgt = FALSE;
         IsWow64Process( _hProcess, &wowTgt );
 
         _wowBarrier.sourceWow64 = (wowSrc == TRUE);
@@ -255,6 +268,30 @@ NTSTATUS Native::GetThreadContextT( HANDLE hThread, _CONTEXT64& ctx )
     return LastNtStatus();
 }
 
+/// <summary>
+/// Get native thread contexts for a set of threads.
+/// ContextFlags must be pre-set in every entry. On WOW64 the whole
+/// set is queried within a single barrier crossing
+/// </summary>
+/// <param name="hThreads">Thread handles</param>
+/// <param name="contexts">Thread contexts, must match handle count</param>
+/// <returns>Status of the first failed query, STATUS_SUCCESS if all succeeded</returns>
+NTSTATUS Native::GetThreadContextBatchT( const std::vector<HANDLE>& hThreads, std::vector<_CONTEXT64>& contexts )
+{
+    if (hThreads.size() != contexts.size())
+        return STATUS_INVALID_PARAMETER;
+
+    NTSTATUS status = STATUS_SUCCESS;
+    for (size_t i = 0; i < hThreads.size(); i++)
+    {
+        NTSTATUS st = GetThreadContextT( hThreads[i], contexts[i] );
+        if (!NT_SUCCESS( st ) && NT_SUCCESS( status ))
+            status = st;
+    }
+
+    return status;
+}
+
 /// <summary>
 /// Get WOW64 thread context
 /// </summary>
@@ -142,6 +142,16 @@ public:
     /// <returns>Status code</returns>
     virtual NTSTATUS GetThreadContextT( HANDLE hThread, _CONTEXT32& ctx );
 
+    /// <summary>
+    /// Get native thread contexts for a set of threads.
+    /// ContextFlags must be pre-set in every entry. On WOW64 the whole
+    /// set is queried within a single barrier crossing
+    /// </summary>
+    /// <param name="hThreads">Thread handles</param>
+    /// <param name="contexts">Thread contexts, must match handle count</param>
+    /// <returns>Status of the first failed query, STATUS_SUCCESS if all succeeded</returns>
+    virtual NTSTATUS GetThreadContextBatchT( const std::vector<HANDLE>& hThreads, std::vector<_CONTEXT64>& contexts );
+
     /// <summary>
     /// Set native thread context
     /// </summary>
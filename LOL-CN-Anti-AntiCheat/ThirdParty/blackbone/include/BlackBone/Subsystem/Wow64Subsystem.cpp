@@ -236,6 +236,44 @@ NTSTATUS NativeWow64::GetThreadContextT( HANDLE hThread, _CONTEXT64& ctx )
     return static_cast<NTSTATUS>(X64Call( gtc, 2, (DWORD64)hThread, (DWORD64)&ctx ));
 }
 
+/// <summary>
+/// Get native thread contexts for a set of threads.
+/// All queries run inside one x86->x64 crossing
+/// </summary>
+/// <param name="hThreads">Thread handles</param>
+/// <param name="contexts">Thread contexts, must match handle count</param>
+/// <returns>Status of the first failed query, STATUS_SUCCESS if all succeeded</returns>
+NTSTATUS NativeWow64::GetThreadContextBatchT( const std::vector<HANDLE>& hThreads, std::vector<_CONTEXT64>& contexts )
+{
+    if (hThreads.size() != contexts.size())
+        return STATUS_INVALID_PARAMETER;
+
+    if (hThreads.empty())
+        return STATUS_SUCCESS;
+
+    static ptr_t gtc = GetProcAddress64Cached( getNTDLL64(), "NtGetContextThread" );
+    if (gtc == 0)
+        return STATUS_ORDINAL_NOT_FOUND;
+
+    std::vector<X64_CALL_ENTRY> entries( hThreads.size() );
+    for (size_t i = 0; i < hThreads.size(); i++)
+    {
+        entries[i].func = gtc;
+        entries[i].argC = 2;
+        entries[i].args[0] = (DWORD64)hThreads[i];
+        entries[i].args[1] = (DWORD64)&contexts[i];
+    }
+
+    if (!X64CallBatch( entries.data(), static_cast<int>(entries.size()) ))
+        return STATUS_UNSUCCESSFUL;
+
+    for (const auto& entry : entries)
+        if (!NT_SUCCESS( static_cast<NTSTATUS>(entry.rax) ))
+            return static_cast<NTSTATUS>(entry.rax);
+
+    return STATUS_SUCCESS;
+}
+
 /// <summary>
 /// Set WOW64 thread context
 /// </summary>
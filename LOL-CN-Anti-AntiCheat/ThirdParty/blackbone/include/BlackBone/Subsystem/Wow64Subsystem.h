@@ -120,6 +120,15 @@ public:
     /// <returns>Status code</returns>
     virtual NTSTATUS GetThreadContextT( HANDLE hThread, _CONTEXT32& ctx );
 
+    /// <summary>
+    /// Get native thread contexts for a set of threads.
+    /// All queries run inside one x86->x64 crossing
+    /// </summary>
+    /// <param name="hThreads">Thread handles</param>
+    /// <param name="contexts">Thread contexts, must match handle count</param>
+    /// <returns>Status of the first failed query, STATUS_SUCCESS if all succeeded</returns>
+    virtual NTSTATUS GetThreadContextBatchT( const std::vector<HANDLE>& hThreads, std::vector<_CONTEXT64>& contexts );
+
     /// <summary>
     /// Set native thread context
     /// </summary>
@@ -1,7 +1,9 @@
 #include "PDBHelper.h"
+#include "../Include/HandleGuard.h"
 #include "../Misc/Trace.hpp"
 
 #include <cstdint>
+#include <fstream>
 #include <sstream>
 
 #define CHECK_SUCCESS(e)\
@@ -17,6 +19,13 @@
 namespace blackbone
 {
 
+namespace
+{
+    // 'BBS2', bumped when the entry layout changed from names to name hashes
+    const uint32_t SymCacheMagic = 0x32534242;
+    const uint32_t RSDSMagic = 0x53445352;      // 'RSDS'
+}
+
 PDBHelper::PDBHelper()
 {
     CoInitialize( nullptr );
@@ -52,24 +61,49 @@ PDBHelper::~PDBHelper()
 /// <returns>Status code</returns>
 HRESULT PDBHelper::Init( const std::wstring& file, ptr_t base /*= 0*/ )
 {
+    _base = base;
+
+    // Session already open for this image, serve repeat queries from it
+    if (file == _file && !_cache.empty())
+        return S_OK;
+
+    // Serve symbols from the binary cache when the PDB signature matches,
+    // skipping DIA and PDB download entirely
+    GUID guid = { };
+    DWORD age = 0;
+    const bool haveSignature = SUCCEEDED( GetPdbSignature( file, guid, age ) );
+
+    if (haveSignature && LoadSymbolCache( guid, age ))
+    {
+        _file = file;
+        return S_OK;
+    }
+
     CHECK_SUCCESS( CoCreateDiaDataSource() );
     CHECK_SUCCESS( _source->loadDataForExe( file.c_str(), _sympath.empty() ? nullptr : _sympath.c_str(), nullptr ) );
     CHECK_SUCCESS( _source->openSession( &_session ) );
     CHECK_SUCCESS( _session->get_globalScope( &_global ) );
-    
-    _base = base;
-    return PopulateSymbols();
+
+    HRESULT hr = PopulateSymbols();
+    if (SUCCEEDED( hr ))
+    {
+        _file = file;
+        if (haveSignature)
+            SaveSymbolCache( guid, age );
+    }
+
+    return hr;
 }
 
 /// <summary>
 /// Get symbol RVA
 /// </summary>
-/// <param name="symName">Symbol name</param>
+/// <param name="symHash">Symbol name hash, see sym_hash</param>
 /// <param name="result">Resulting RVA</param>
 /// <returns>Status code</returns>
-HRESULT PDBHelper::GetSymAddress( const std::wstring& symName, ptr_t& result )
+HRESULT PDBHelper::GetSymAddress( uint32_t symHash, ptr_t& result )
 {
-    auto found = _cache.find( symName );
+    auto found = _cache.find( symHash );
     if (found != _cache.end())
     {
         result = _base + found->second;
@@ -157,7 +191,7 @@ HRESULT PDBHelper::PopulateSymbols()
                 wname.erase( pos );
             }
 
-            _cache.emplace( std::move( wname ), rva );
+            _cache.emplace( sym_hash( wname.c_str() ), rva );
         }
 
         symbol.Release();
@@ -166,4 +200,230 @@ HRESULT PDBHelper::PopulateSymbols()
     return S_OK;
 }
 
+/// <summary>
+/// Extract PDB GUID and age from the PE debug directory
+/// </summary>
+/// <param name="file">Fully qualified path to target PE file</param>
+/// <param name="guid">Receives PDB GUID</param>
+/// <param name="age">Receives PDB age</param>
+/// <returns>Status code</returns>
+HRESULT PDBHelper::GetPdbSignature( const std::wstring& file, GUID& guid, DWORD& age )
+{
+    Handle hFile = CreateFileW( file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr );
+    if (!hFile)
+        return HRESULT_FROM_WIN32( GetLastError() );
+
+    Handle hMap = CreateFileMappingW( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if (!hMap)
+        return HRESULT_FROM_WIN32( GetLastError() );
+
+    auto pBase = static_cast<const uint8_t*>(MapViewOfFile( hMap, FILE_MAP_READ, 0, 0, 0 ));
+    if (pBase == nullptr)
+        return HRESULT_FROM_WIN32( GetLastError() );
+
+    HRESULT hr = E_PDB_DBG_NOT_FOUND;
+
+    const auto pDos = reinterpret_cast<const IMAGE_DOS_HEADER*>(pBase);
+    const auto pNt = reinterpret_cast<const IMAGE_NT_HEADERS32*>(pBase + pDos->e_lfanew);
+
+    if (pDos->e_magic == IMAGE_DOS_SIGNATURE && pNt->Signature == IMAGE_NT_SIGNATURE)
+    {
+        DWORD dbgRva = 0, dbgSize = 0;
+        if (pNt->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR64_MAGIC)
+        {
+            const auto pNt64 = reinterpret_cast<const IMAGE_NT_HEADERS64*>(pNt);
+            dbgRva = pNt64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG].VirtualAddress;
+            dbgSize = pNt64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG].Size;
+        }
+        else
+        {
+            dbgRva = pNt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG].VirtualAddress;
+            dbgSize = pNt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG].Size;
+        }
+
+        // File is not mapped as an image, translate the directory RVA
+        DWORD dbgOffset = 0;
+        auto pSection = IMAGE_FIRST_SECTION( pNt );
+        for (WORD i = 0; i < pNt->FileHeader.NumberOfSections; i++, pSection++)
+        {
+            if (dbgRva >= pSection->VirtualAddress && dbgRva < pSection->VirtualAddress + pSection->Misc.VirtualSize)
+            {
+                dbgOffset = pSection->PointerToRawData + (dbgRva - pSection->VirtualAddress);
+                break;
+            }
+        }
+
+        if (dbgOffset != 0)
+        {
+            const auto pEntries = reinterpret_cast<const IMAGE_DEBUG_DIRECTORY*>(pBase + dbgOffset);
+            for (DWORD i = 0; i < dbgSize / sizeof( IMAGE_DEBUG_DIRECTORY ); i++)
+            {
+                // RSDS CodeView record: magic, GUID, age, pdb path
+                if (pEntries[i].Type != IMAGE_DEBUG_TYPE_CODEVIEW || pEntries[i].PointerToRawData == 0)
+                    continue;
+
+                const uint8_t* pCV = pBase + pEntries[i].PointerToRawData;
+                if (*reinterpret_cast<const uint32_t*>(pCV) == RSDSMagic)
+                {
+                    guid = *reinterpret_cast<const GUID*>(pCV + sizeof( uint32_t ));
+                    age = *reinterpret_cast<const DWORD*>(pCV + sizeof( uint32_t ) + sizeof( GUID ));
+                    hr = S_OK;
+                    break;
+                }
+            }
+        }
+    }
+
+    UnmapViewOfFile( pBase );
+    return hr;
+}
+
+/// <summary>
+/// On-disk cache file for a PDB signature
+/// </summary>
+/// <param name="guid">PDB GUID</param>
+/// <param name="age">PDB age</param>
+/// <returns>Cache file path</returns>
+std::wstring PDBHelper::CacheFilePath( const GUID& guid, DWORD age )
+{
+    wchar_t tmpPath[MAX_PATH] = { 0 };
+    if (GetTempPathW( _countof( tmpPath ), tmpPath ) == 0)
+        return L"";
+
+    wchar_t name[128] = { 0 };
+    swprintf_s(
+        name, L"BlackBone_Sym_%08lX%04hX%04hX%02X%02X%02X%02X%02X%02X%02X%02X_%lu.bin",
+        guid.Data1, guid.Data2, guid.Data3,
+        guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3],
+        guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7],
+        age
+        );
+
+    return std::wstring( tmpPath ) + name;
+}
+
+/// <summary>
+/// Fill symbol map from the binary cache
+/// </summary>
+/// <param name="guid">PDB GUID</param>
+/// <param name="age">PDB age</param>
+/// <returns>true if the map was populated</returns>
+bool PDBHelper::LoadSymbolCache( const GUID& guid, DWORD age )
+{
+    const auto cachePath = CacheFilePath( guid, age );
+    if (cachePath.empty())
+        return false;
+
+    Handle hFile = CreateFileW( cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr );
+    if (!hFile)
+        return false;
+
+    const DWORD size = GetFileSize( hFile, nullptr );
+    if (size < 2 * sizeof( uint32_t ))
+        return false;
+
+    Handle hMap = CreateFileMappingW( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if (!hMap)
+        return false;
+
+    auto pData = static_cast<const uint8_t*>(MapViewOfFile( hMap, FILE_MAP_READ, 0, 0, 0 ));
+    if (pData == nullptr)
+        return false;
+
+    // Layout: magic, count, then fixed { hash, rva } pairs
+    const uint8_t* ptr = pData;
+    uint32_t count = 0;
+    bool ok = false;
+
+    if (*reinterpret_cast<const uint32_t*>(ptr) == SymCacheMagic)
+    {
+        count = *reinterpret_cast<const uint32_t*>(ptr + sizeof( uint32_t ));
+        ptr += 2 * sizeof( uint32_t );
+
+        if (count != 0 && size >= 2 * sizeof( uint32_t ) + count * 2 * sizeof( uint32_t ))
+        {
+            _cache.reserve( count );
+            for (uint32_t i = 0; i < count; i++, ptr += 2 * sizeof( uint32_t ))
+            {
+                const uint32_t hash = *reinterpret_cast<const uint32_t*>(ptr);
+                const uint32_t rva = *reinterpret_cast<const uint32_t*>(ptr + sizeof( uint32_t ));
+                _cache.emplace( hash, rva );
+            }
+
+            ok = true;
+        }
+    }
+
+    UnmapViewOfFile( pData );
+    return ok;
+}
+
+/// <summary>
+/// Persist symbol map to the binary cache
+/// </summary>
+/// <param name="guid">PDB GUID</param>
+/// <param name="age">PDB age</param>
+void PDBHelper::SaveSymbolCache( const GUID& guid, DWORD age )
+{
+    const auto cachePath = CacheFilePath( guid, age );
+    if (cachePath.empty() || _cache.empty())
+        return;
+
+    std::ofstream file( cachePath, std::ios::binary | std::ios::trunc );
+    if (!file)
+        return;
+
+    const uint32_t count = static_cast<uint32_t>(_cache.size());
+    file.write( reinterpret_cast<const char*>(&SymCacheMagic), sizeof( SymCacheMagic ) );
+    file.write( reinterpret_cast<const char*>(&count), sizeof( count ) );
+
+    for (const auto& entry : _cache)
+    {
+        file.write( reinterpret_cast<const char*>(&entry.first), sizeof( entry.first ) );
+        file.write( reinterpret_cast<const char*>(&entry.second), sizeof( entry.second ) );
+    }
+}
+
+PDBSessionPool& PDBSessionPool::Instance()
+{
+    static PDBSessionPool instance;
+    return instance;
+}
+
+/// <summary>
+/// Get the session for an image, creating it on first use.
+/// The caller still runs Init, which is a no-op on an open session
+/// </summary>
+/// <param name="file">Fully qualified path to target PE file</param>
+/// <returns>Pooled session</returns>
+std::shared_ptr<PDBHelper> PDBSessionPool::Get( const std::wstring& file )
+{
+    std::lock_guard<std::mutex> guard( _lock );
+    EvictIdle();
+
+    auto& entry = _sessions[file];
+    if (!entry.session)
+        entry.session = std::make_shared<PDBHelper>();
+
+    entry.lastUsed = GetTickCount64();
+    return entry.session;
+}
+
+/// <summary>
+/// Drop sessions idle longer than the timeout.
+/// Must be called with the pool lock held
+/// </summary>
+void PDBSessionPool::EvictIdle()
+{
+    const uint64_t now = GetTickCount64();
+    for (auto iter = _sessions.begin(); iter != _sessions.end();)
+    {
+        // Outstanding shared_ptr holders keep an evicted session usable
+        if (now - iter->second.lastUsed > IdleTimeoutMs)
+            iter = _sessions.erase( iter );
+        else
+            ++iter;
+    }
+}
+
 }
\ No newline at end of file
@@ -3,14 +3,41 @@
 #include <3rd_party/DIA/dia2.h>
 #include <Objbase.h>
 #include <atlcomcli.h>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
 namespace blackbone
 {
 
+/// <summary>
+/// Compile-time FNV-1a of a symbol name.
+/// Same constants as encstr::fnv1a and import_hash, so hashes agree across the project
+/// </summary>
+/// <param name="str">Symbol name</param>
+/// <returns>Name hash</returns>
+constexpr uint32_t sym_hash( const wchar_t* str )
+{
+    uint32_t result = 0x811c9dc5ul;
+
+    for (; *str != L'\0'; str++)
+    {
+        result ^= static_cast<uint32_t>(*str);
+        result *= 16777619ul;
+    }
+
+    return result;
+}
+
 class PDBHelper
 {
+    // Identity hash, keys are FNV-1a hashes already
+    struct HashNop
+    {
+        size_t operator()( uint32_t key ) const { return key; }
+    };
+
 public:
     PDBHelper();
     ~PDBHelper();
@@ -26,10 +53,10 @@ public:
     /// <summary>
     /// Get symbol RVA
     /// </summary>
-    /// <param name="symName">Symbol name</param>
+    /// <param name="symHash">Symbol name hash, see sym_hash</param>
     /// <param name="result">Resulting RVA</param>
     /// <returns>Status code</returns>
-    HRESULT GetSymAddress( const std::wstring& symName, ptr_t& result );
+    HRESULT GetSymAddress( uint32_t symHash, ptr_t& result );
 
 private:
     /// <summary>
@@ -38,6 +65,38 @@ private:
     /// <returns>Status code</returns>
     HRESULT CoCreateDiaDataSource();
 
+    /// <summary>
+    /// Extract PDB GUID and age from the PE debug directory
+    /// </summary>
+    /// <param name="file">Fully qualified path to target PE file</param>
+    /// <param name="guid">Receives PDB GUID</param>
+    /// <param name="age">Receives PDB age</param>
+    /// <returns>Status code</returns>
+    HRESULT GetPdbSignature( const std::wstring& file, GUID& guid, DWORD& age );
+
+    /// <summary>
+    /// On-disk cache file for a PDB signature
+    /// </summary>
+    /// <param name="guid">PDB GUID</param>
+    /// <param name="age">PDB age</param>
+    /// <returns>Cache file path</returns>
+    std::wstring CacheFilePath( const GUID& guid, DWORD age );
+
+    /// <summary>
+    /// Fill symbol map from the binary cache
+    /// </summary>
+    /// <param name="guid">PDB GUID</param>
+    /// <param name="age">PDB age</param>
+    /// <returns>true if the map was populated</returns>
+    bool LoadSymbolCache( const GUID& guid, DWORD age );
+
+    /// <summary>
+    /// Persist symbol map to the binary cache
+    /// </summary>
+    /// <param name="guid">PDB GUID</param>
+    /// <param name="age">PDB age</param>
+    void SaveSymbolCache( const GUID& guid, DWORD age );
+
     /// <summary>
     /// Build module symbol map
     /// </summary>
@@ -51,8 +110,49 @@ private:
     CComPtr<IDiaSymbol>     _global;
 
     uint64_t _base = 0;                                     // Base ptr to add to RVAs
+    std::wstring _file;                                     // Image the session was initialized for
     std::wstring _sympath;                                  // Symbol cache directory
-    std::unordered_map<std::wstring, uint32_t> _cache;      // Symbol name <--> RVA map
+    std::unordered_map<uint32_t, uint32_t, HashNop> _cache; // Symbol name hash <--> RVA map
+};
+
+/// <summary>
+/// Process-lifetime pool of PDB sessions.
+/// Repeat queries against an already opened image reuse the session instead
+/// of re-paying COM init and PDB open; idle sessions are evicted to bound memory
+/// </summary>
+class PDBSessionPool
+{
+public:
+    static PDBSessionPool& Instance();
+
+    /// <summary>
+    /// Get the session for an image, creating it on first use.
+    /// The caller still runs Init, which is a no-op on an open session
+    /// </summary>
+    /// <param name="file">Fully qualified path to target PE file</param>
+    /// <returns>Pooled session</returns>
+    std::shared_ptr<PDBHelper> Get( const std::wstring& file );
+
+private:
+    PDBSessionPool() = default;
+
+    /// <summary>
+    /// Drop sessions idle longer than the timeout.
+    /// Must be called with the pool lock held
+    /// </summary>
+    void EvictIdle();
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<PDBHelper> session;
+        uint64_t lastUsed = 0;          // Tick count of last Get
+    };
+
+    static const uint64_t IdleTimeoutMs = 60 * 1000;
+
+    std::mutex _lock;
+    std::unordered_map<std::wstring, Entry> _sessions;
 };
 
 }
\ No newline at end of file
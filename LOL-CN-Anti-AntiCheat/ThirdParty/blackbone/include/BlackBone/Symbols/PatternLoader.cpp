@@ -4,6 +4,7 @@
 #include "../Misc/Trace.hpp"
 #include <3rd_party/VersionApi.h>
 
+#include <fstream>
 #include <memory>
 #include <unordered_map>
 
@@ -27,6 +28,167 @@ struct ScanParams
     ptr_t diff = 0;
 };
 
+namespace
+{
+    const uint32_t PatternCacheMagic = 0x43504242;  // 'BBPC'
+
+    /// <summary>
+    /// Cached symbol entry: discovered address plus one byte of the image
+    /// at that address, re-checked on load to detect a changed binary
+    /// </summary>
+    struct CachedSymbol
+    {
+        ptr_t value = 0;
+        uint8_t probe = 0;
+    };
+
+    /// <summary>
+    /// Fixed field order used by the pattern cache file
+    /// </summary>
+    /// <param name="data">Symbol set</param>
+    /// <returns>Field list</returns>
+    std::vector<ptr_t*> CacheFields( SymbolData& data )
+    {
+        return {
+            &data.LdrKernel32PatchAddress,
+            &data.APC64PatchAddress,
+            &data.LdrpHandleTlsData32,
+            &data.LdrpHandleTlsData64,
+            &data.LdrpInvertedFunctionTable32,
+            &data.LdrpInvertedFunctionTable64,
+            &data.RtlInsertInvertedFunctionTable32,
+            &data.RtlInsertInvertedFunctionTable64,
+            &data.LdrpReleaseTlsEntry32,
+            &data.LdrpReleaseTlsEntry64,
+            &data.LdrProtectMrdata,
+        };
+    }
+
+    /// <summary>
+    /// Get PE header timestamp of a mapped image
+    /// </summary>
+    /// <param name="image">Mapped image</param>
+    /// <returns>TimeDateStamp, 0 if not loaded</returns>
+    uint32_t ImageStamp( const pe::PEImage& image )
+    {
+        if (image.base() == nullptr)
+            return 0;
+
+        auto pDos = reinterpret_cast<const IMAGE_DOS_HEADER*>(image.base());
+        auto pNt = reinterpret_cast<const IMAGE_NT_HEADERS32*>(reinterpret_cast<const uint8_t*>(image.base()) + pDos->e_lfanew);
+        return pNt->FileHeader.TimeDateStamp;
+    }
+
+    /// <summary>
+    /// Resolve preferred-base address back into the local mapping
+    /// </summary>
+    /// <param name="value">Address in preferred image space</param>
+    /// <param name="image">Mapped image</param>
+    /// <returns>Local pointer, nullptr if outside the image</returns>
+    const uint8_t* MappedAddress( ptr_t value, const pe::PEImage& image )
+    {
+        if (image.base() == nullptr || value < image.imageBase() || value >= image.imageBase() + image.imageSize())
+            return nullptr;
+
+        return reinterpret_cast<const uint8_t*>(image.base()) + static_cast<size_t>(value - image.imageBase());
+    }
+
+    /// <summary>
+    /// Pattern cache file, keyed by ntdll timestamps and OS build
+    /// </summary>
+    /// <param name="stamp32">x86 ntdll timestamp</param>
+    /// <param name="stamp64">x64 ntdll timestamp</param>
+    /// <returns>Cache file path</returns>
+    std::wstring PatternCachePath( uint32_t stamp32, uint32_t stamp64 )
+    {
+        wchar_t tmpPath[MAX_PATH] = { 0 };
+        if (GetTempPathW( _countof( tmpPath ), tmpPath ) == 0)
+            return L"";
+
+        wchar_t name[64] = { 0 };
+        swprintf_s( name, L"BlackBone_Patterns_%08X_%08X_%lu.bin", stamp32, stamp64, WinVer().native.dwBuildNumber );
+        return std::wstring( tmpPath ) + name;
+    }
+
+    /// <summary>
+    /// Fill missing symbols from the pattern cache.
+    /// Each entry is validated with one byte-compare against the mapped image
+    /// </summary>
+    /// <param name="path">Cache file path</param>
+    /// <param name="ntdll32">Mapped x86 ntdll</param>
+    /// <param name="ntdll64">Mapped x64 ntdll</param>
+    /// <param name="result">Result</param>
+    void LoadPatternCache( const std::wstring& path, const pe::PEImage& ntdll32, const pe::PEImage& ntdll64, SymbolData& result )
+    {
+        auto fields = CacheFields( result );
+
+        std::ifstream file( path, std::ios::binary );
+        if (!file)
+            return;
+
+        uint32_t magic = 0, count = 0;
+        file.read( reinterpret_cast<char*>(&magic), sizeof( magic ) );
+        file.read( reinterpret_cast<char*>(&count), sizeof( count ) );
+        if (!file || magic != PatternCacheMagic || count != fields.size())
+            return;
+
+        for (auto* pField : fields)
+        {
+            CachedSymbol entry;
+            file.read( reinterpret_cast<char*>(&entry), sizeof( entry ) );
+            if (!file)
+                return;
+
+            if (*pField != 0 || entry.value == 0)
+                continue;
+
+            auto ptr = MappedAddress( entry.value, ntdll32 );
+            if (ptr == nullptr)
+                ptr = MappedAddress( entry.value, ntdll64 );
+
+            if (ptr != nullptr && *ptr == entry.probe)
+                *pField = entry.value;
+        }
+    }
+
+    /// <summary>
+    /// Persist discovered symbols for the next launch
+    /// </summary>
+    /// <param name="path">Cache file path</param>
+    /// <param name="ntdll32">Mapped x86 ntdll</param>
+    /// <param name="ntdll64">Mapped x64 ntdll</param>
+    /// <param name="result">Result</param>
+    void SavePatternCache( const std::wstring& path, const pe::PEImage& ntdll32, const pe::PEImage& ntdll64, SymbolData& result )
+    {
+        auto fields = CacheFields( result );
+
+        std::ofstream file( path, std::ios::binary | std::ios::trunc );
+        if (!file)
+            return;
+
+        const uint32_t count = static_cast<uint32_t>(fields.size());
+        file.write( reinterpret_cast<const char*>(&PatternCacheMagic), sizeof( PatternCacheMagic ) );
+        file.write( reinterpret_cast<const char*>(&count), sizeof( count ) );
+
+        for (auto* pField : fields)
+        {
+            CachedSymbol entry;
+            entry.value = *pField;
+
+            auto ptr = MappedAddress( entry.value, ntdll32 );
+            if (ptr == nullptr)
+                ptr = MappedAddress( entry.value, ntdll64 );
+
+            if (ptr != nullptr)
+                entry.probe = *ptr;
+            else
+                entry.value = 0;
+
+            file.write( reinterpret_cast<const char*>(&entry), sizeof( entry ) );
+        }
+    }
+}
+
 void FindPattern( const ScanParams& scan32, const ScanParams& scan64, const OffsetData& rule, ptr_t& result )
 {
     // Skip if already found
@@ -37,7 +199,7 @@ void FindPattern( const ScanParams& scan32, const ScanParams& scan64, const Offs
 
     const ScanParams& scan = rule.bit64 ? scan64 : scan32;
 
-    std::vector<ptr_t> found;
+    vecScanResult found;
     rule.pattern.Search( reinterpret_cast<void*>(scan.start), static_cast<size_t>(scan.size), found );
     if (!found.empty())
     {
@@ -234,6 +396,12 @@ NTSTATUS ScanSymbolPatterns( const pe::PEImage& ntdll32, const pe::PEImage& ntdl
         fillRanges( ntdll64, scan64 );
     }  
 
+    // Reuse results persisted by a previous launch, keyed by ntdll version.
+    // Validated entries are skipped by FindPattern, so only misses are scanned
+    auto cachePath = PatternCachePath( ImageStamp( ntdll32 ), ImageStamp( ntdll64 ) );
+    if (!cachePath.empty())
+        LoadPatternCache( cachePath, ntdll32, ntdll64, result );
+
     std::unordered_map<ptr_t*, OffsetData> patterns;
     OSFillPatterns( patterns, result );
 
@@ -280,6 +448,9 @@ NTSTATUS ScanSymbolPatterns( const pe::PEImage& ntdll32, const pe::PEImage& ntdl
     }
 #endif
 
+    if (!cachePath.empty())
+        SavePatternCache( cachePath, ntdll32, ntdll64, result );
+
     return STATUS_SUCCESS;
 }
 
@@ -1,7 +1,164 @@
 #pragma once
 #include "SymbolData.h"
+#include "SymbolLoader.h"
+#include "../Include/Winheaders.h"
+#include "../Include/HandleGuard.h"
+#include <3rd_party/VersionApi.h>
+
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 namespace blackbone
 {
 	SymbolData g_symbols;
-}
\ No newline at end of file
+
+namespace
+{
+    const uint32_t SymbolBlockMagic = 0x44534242;  // 'BBSD'
+
+    /// <summary>
+    /// On-disk layout, written and mapped verbatim.
+    /// SymbolData is trivially copyable so no serialization step exists
+    /// </summary>
+    struct SymbolDataBlock
+    {
+        uint32_t magic = SymbolBlockMagic;
+        uint32_t size = sizeof( SymbolData );
+        uint64_t stamp = 0;
+        SymbolData data;
+    };
+
+    /// <summary>
+    /// Version stamp of the running system: OS build number combined with
+    /// the PE timestamp of the loaded ntdll. Changes on any Windows update
+    /// </summary>
+    /// <returns>Version stamp</returns>
+    uint64_t CurrentStamp()
+    {
+        auto base = reinterpret_cast<const uint8_t*>(GetModuleHandleW( L"ntdll.dll" ));
+        if (base == nullptr)
+            return 0;
+
+        auto pDos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        auto pNt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + pDos->e_lfanew);
+        return (static_cast<uint64_t>(WinVer().native.dwBuildNumber) << 32) | pNt->FileHeader.TimeDateStamp;
+    }
+
+    /// <summary>
+    /// Symbol block file path
+    /// </summary>
+    /// <returns>File path, empty string on failure</returns>
+    std::wstring SymbolBlockPath()
+    {
+        wchar_t tmpPath[MAX_PATH] = { 0 };
+        if (GetTempPathW( _countof( tmpPath ), tmpPath ) == 0)
+            return L"";
+
+        return std::wstring( tmpPath ) + L"BlackBone_Symbols.bin";
+    }
+}
+
+/// <summary>
+/// Populate symbols from the memory-mapped block left by a previous run.
+/// The view is shared read-only with any other process that mapped it
+/// </summary>
+/// <param name="result">Found symbols</param>
+/// <returns>true if the block exists and matches the current system version</returns>
+bool MapSymbolData( SymbolData& result )
+{
+    auto path = SymbolBlockPath();
+    if (path.empty())
+        return false;
+
+    Handle file = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if (!file)
+        return false;
+
+    Handle mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, sizeof( SymbolDataBlock ), nullptr );
+    if (!mapping)
+        return false;
+
+    auto pBlock = reinterpret_cast<const SymbolDataBlock*>(MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, sizeof( SymbolDataBlock ) ));
+    if (pBlock == nullptr)
+        return false;
+
+    const bool valid = pBlock->magic == SymbolBlockMagic
+        && pBlock->size == sizeof( SymbolData )
+        && pBlock->stamp == CurrentStamp();
+
+    // Taken from the view verbatim
+    if (valid)
+        result = pBlock->data;
+
+    UnmapViewOfFile( pBlock );
+    return valid;
+}
+
+/// <summary>
+/// Write resolved symbols to the block file for later runs
+/// </summary>
+/// <param name="data">Resolved symbols</param>
+void PersistSymbolData( const SymbolData& data )
+{
+    auto path = SymbolBlockPath();
+    if (path.empty())
+        return;
+
+    SymbolDataBlock block;
+    block.stamp = CurrentStamp();
+    block.data = data;
+
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    if (file)
+        file.write( reinterpret_cast<const char*>(&block), sizeof( block ) );
+}
+
+namespace
+{
+    std::once_flag s_resolveFlag;
+
+    /// <summary>
+    /// Resolve the symbol set: mapped block first, full PDB/pattern path on miss
+    /// </summary>
+    void ResolveSymbols()
+    {
+        if (!MapSymbolData( g_symbols ))
+        {
+            SymbolLoader sl;
+            sl.Load( g_symbols );
+            PersistSymbolData( g_symbols );
+        }
+    }
+}
+
+/// <summary>
+/// Symbol set, resolved on first access
+/// </summary>
+/// <returns>Resolved symbols</returns>
+const SymbolData& Symbols()
+{
+    std::call_once( s_resolveFlag, ResolveSymbols );
+    return g_symbols;
+}
+
+/// <summary>
+/// Start symbol resolution in the background so that the first
+/// Symbols() call does not pay for it
+/// </summary>
+void PrewarmSymbols()
+{
+    std::thread( []() { std::call_once( s_resolveFlag, ResolveSymbols ); } ).detach();
+}
+
+/// <summary>
+/// Adopt an externally resolved symbol set, skipping resolution entirely.
+/// No-op if resolution already ran
+/// </summary>
+/// <param name="data">Resolved symbols</param>
+void SetSymbols( const SymbolData& data )
+{
+    std::call_once( s_resolveFlag, [&data]() { g_symbols = data; } );
+}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "../include/Types.h"
+#include <type_traits>
 
 namespace blackbone
 {
@@ -22,6 +23,41 @@ struct SymbolData
     ptr_t LdrProtectMrdata = 0;                     // LdrProtectMrdata address
 };
 
+static_assert( std::is_trivially_copyable<SymbolData>::value, "SymbolData must map from disk verbatim" );
+
 extern SymbolData g_symbols;
 
+/// <summary>
+/// Populate symbols from the memory-mapped block left by a previous run.
+/// The view is shared read-only with any other process that mapped it
+/// </summary>
+/// <param name="result">Found symbols</param>
+/// <returns>true if the block exists and matches the current system version</returns>
+bool MapSymbolData( SymbolData& result );
+
+/// <summary>
+/// Write resolved symbols to the block file for later runs
+/// </summary>
+/// <param name="data">Resolved symbols</param>
+void PersistSymbolData( const SymbolData& data );
+
+/// <summary>
+/// Symbol set, resolved on first access
+/// </summary>
+/// <returns>Resolved symbols</returns>
+const SymbolData& Symbols();
+
+/// <summary>
+/// Start symbol resolution in the background so that the first
+/// Symbols() call does not pay for it
+/// </summary>
+void PrewarmSymbols();
+
+/// <summary>
+/// Adopt an externally resolved symbol set, skipping resolution entirely.
+/// No-op if resolution already ran
+/// </summary>
+/// <param name="data">Resolved symbols</param>
+void SetSymbols( const SymbolData& data );
+
 }
\ No newline at end of file
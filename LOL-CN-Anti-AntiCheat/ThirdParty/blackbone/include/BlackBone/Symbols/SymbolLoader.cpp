@@ -3,6 +3,8 @@
 #include "../Symbols/PatternLoader.h"
 #include "../PE/PEImage.h"
 
+#include <future>
+
 namespace blackbone
 {
 
@@ -33,7 +35,6 @@ SymbolLoader::SymbolLoader()
 NTSTATUS SymbolLoader::Load( SymbolData& result )
 {
     pe::PEImage ntdll32, ntdll64;
-    PDBHelper sym32, sym64;
 
     wchar_t buf[MAX_PATH] = { 0 };
     GetWindowsDirectoryW( buf, MAX_PATH );
@@ -52,29 +53,52 @@ NTSTATUS SymbolLoader::Load( SymbolData& result )
         ntdll32.Load( std::wstring( windir + L"\\SysWOW64\\ntdll.dll" ), true );       
     }
 
-    HRESULT hr = sym32.Init( ntdll32.path(), ntdll32.imageBase() );
-    if (!_x86OS && SUCCEEDED( hr ))
+    // Sessions come from the pool, so a repeat Load reuses the open PDBs
+    auto sym32 = PDBSessionPool::Instance().Get( ntdll32.path() );
+    auto sym64 = PDBSessionPool::Instance().Get( ntdll64.path() );
+
+    // Both images are processed concurrently. Symbol lookup is served from the
+    // in-memory map after Init, so the worker result is only a status code.
+    // First-run PDB downloads dominate here and overlap almost entirely.
+    std::future<HRESULT> hr64;
+    if (!_x86OS)
     {
-        FsRedirector fsr( _wow64Process );
-        hr = sym64.Init( ntdll64.path(), ntdll64.imageBase() );
+        hr64 = std::async( std::launch::async, [&]()
+        {
+            // Per-thread state, the worker needs its own apartment and redirection
+            CoInitialize( nullptr );
+            FsRedirector fsr( _wow64Process );
+
+            HRESULT hres = sym64->Init( ntdll64.path(), ntdll64.imageBase() );
+            CoUninitialize();
+            return hres;
+        } );
+    }
+
+    HRESULT hr = sym32->Init( ntdll32.path(), ntdll32.imageBase() );
+    if (!_x86OS)
+    {
+        HRESULT hres = hr64.get();
+        if (SUCCEEDED( hr ))
+            hr = hres;
     }
 
-    // Get addresses from pdb
+    // Get addresses from pdb, names hashed at compile time
     if (SUCCEEDED( hr ))
     {
-        sym32.GetSymAddress( L"LdrpHandleTlsData", result.LdrpHandleTlsData32 );
-        sym64.GetSymAddress( L"LdrpHandleTlsData", result.LdrpHandleTlsData64 );
+        sym32->GetSymAddress( sym_hash( L"LdrpHandleTlsData" ), result.LdrpHandleTlsData32 );
+        sym64->GetSymAddress( sym_hash( L"LdrpHandleTlsData" ), result.LdrpHandleTlsData64 );
 
-        sym32.GetSymAddress( L"LdrpInvertedFunctionTable", result.LdrpInvertedFunctionTable32 );
-        sym64.GetSymAddress( L"LdrpInvertedFunctionTable", result.LdrpInvertedFunctionTable64 );
+        sym32->GetSymAddress( sym_hash( L"LdrpInvertedFunctionTable" ), result.LdrpInvertedFunctionTable32 );
+        sym64->GetSymAddress( sym_hash( L"LdrpInvertedFunctionTable" ), result.LdrpInvertedFunctionTable64 );
 
-        sym32.GetSymAddress( L"RtlInsertInvertedFunctionTable", result.RtlInsertInvertedFunctionTable32 );
-        sym64.GetSymAddress( L"RtlInsertInvertedFunctionTable", result.RtlInsertInvertedFunctionTable64 );
+        sym32->GetSymAddress( sym_hash( L"RtlInsertInvertedFunctionTable" ), result.RtlInsertInvertedFunctionTable32 );
+        sym64->GetSymAddress( sym_hash( L"RtlInsertInvertedFunctionTable" ), result.RtlInsertInvertedFunctionTable64 );
 
-        sym32.GetSymAddress( L"LdrpReleaseTlsEntry", result.LdrpReleaseTlsEntry32 );
-        sym64.GetSymAddress( L"LdrpReleaseTlsEntry", result.LdrpReleaseTlsEntry64 );
+        sym32->GetSymAddress( sym_hash( L"LdrpReleaseTlsEntry" ), result.LdrpReleaseTlsEntry32 );
+        sym64->GetSymAddress( sym_hash( L"LdrpReleaseTlsEntry" ), result.LdrpReleaseTlsEntry64 );
 
-        sym32.GetSymAddress( L"LdrProtectMrdata", result.LdrProtectMrdata );
+        sym32->GetSymAddress( sym_hash( L"LdrProtectMrdata" ), result.LdrProtectMrdata );
     }
    
     // Fill missing symbols from patterns
@@ -3,6 +3,7 @@
 #include "../Include/Winheaders.h"
 #include <type_traits>
 #include <cstdint>
+#include <cstring>
 
 extern "C" void* syscall_stub();
 
@@ -10,6 +11,144 @@ namespace blackbone
 {
 namespace syscall
 {
+    /// <summary>
+    /// Compile-time function ids for the startup-built syscall table
+    /// </summary>
+    enum eSyscallId
+    {
+        id_NtOpenProcess = 0,
+        id_NtClose,
+        id_NtAllocateVirtualMemory,
+        id_NtFreeVirtualMemory,
+        id_NtProtectVirtualMemory,
+        id_NtReadVirtualMemory,
+        id_NtWriteVirtualMemory,
+        id_NtQueryVirtualMemory,
+        id_NtQueryInformationProcess,
+        id_NtSetInformationProcess,
+        id_NtQueryInformationThread,
+        id_NtSetInformationThread,
+        id_NtCreateThreadEx,
+        id_NtOpenThread,
+        id_NtSuspendThread,
+        id_NtResumeThread,
+        id_NtGetContextThread,
+        id_NtSetContextThread,
+        id_NtQueueApcThread,
+        id_NtQuerySystemInformation,
+        id_NtQueryObject,
+        id_NtDuplicateObject,
+        id_NtCreateEvent,
+        id_NtSetEvent,
+        id_NtWaitForSingleObject,
+        id_NtCreateSection,
+        id_NtMapViewOfSection,
+        id_NtUnmapViewOfSection,
+        id_NtDelayExecution,
+        id_NtYieldExecution,
+
+        id_count
+    };
+
+    namespace detail
+    {
+        // Export names matching eSyscallId, same order
+        inline const char* const syscall_names[id_count] =
+        {
+            "NtOpenProcess",
+            "NtClose",
+            "NtAllocateVirtualMemory",
+            "NtFreeVirtualMemory",
+            "NtProtectVirtualMemory",
+            "NtReadVirtualMemory",
+            "NtWriteVirtualMemory",
+            "NtQueryVirtualMemory",
+            "NtQueryInformationProcess",
+            "NtSetInformationProcess",
+            "NtQueryInformationThread",
+            "NtSetInformationThread",
+            "NtCreateThreadEx",
+            "NtOpenThread",
+            "NtSuspendThread",
+            "NtResumeThread",
+            "NtGetContextThread",
+            "NtSetContextThread",
+            "NtQueueApcThread",
+            "NtQuerySystemInformation",
+            "NtQueryObject",
+            "NtDuplicateObject",
+            "NtCreateEvent",
+            "NtSetEvent",
+            "NtWaitForSingleObject",
+            "NtCreateSection",
+            "NtMapViewOfSection",
+            "NtUnmapViewOfSection",
+            "NtDelayExecution",
+            "NtYieldExecution",
+        };
+
+        /// <summary>
+        /// Extract all service numbers with a single walk over
+        /// ntdll's export directory
+        /// </summary>
+        /// <param name="indices">Receives one service number per id, -1 if unresolved</param>
+        inline void build_table( int* indices )
+        {
+            for (int id = 0; id < id_count; id++)
+                indices[id] = -1;
+
+#ifdef USE64
+            const auto base = reinterpret_cast<const uint8_t*>(GetModuleHandleW( L"ntdll.dll" ));
+            if (base == nullptr)
+                return;
+
+            const auto pDos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+            const auto pNt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + pDos->e_lfanew);
+            const auto& dir = pNt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+            if (dir.VirtualAddress == 0)
+                return;
+
+            const auto pExport = reinterpret_cast<const IMAGE_EXPORT_DIRECTORY*>(base + dir.VirtualAddress);
+            const auto pNames = reinterpret_cast<const DWORD*>(base + pExport->AddressOfNames);
+            const auto pOrdinals = reinterpret_cast<const WORD*>(base + pExport->AddressOfNameOrdinals);
+            const auto pFuncs = reinterpret_cast<const DWORD*>(base + pExport->AddressOfFunctions);
+
+            for (DWORD i = 0; i < pExport->NumberOfNames; i++)
+            {
+                const char* name = reinterpret_cast<const char*>(base + pNames[i]);
+                if (name[0] != 'N' || name[1] != 't')
+                    continue;
+
+                for (int id = 0; id < id_count; id++)
+                {
+                    if (indices[id] == -1 && strcmp( name, syscall_names[id] ) == 0)
+                    {
+                        // mov r10, rcx; mov eax, <number>
+                        const uint8_t* pfn = base + pFuncs[pOrdinals[i]];
+                        indices[id] = *reinterpret_cast<const int*>(pfn + 4);
+                        break;
+                    }
+                }
+            }
+#endif
+        }
+
+        /// <summary>
+        /// Flat table of service numbers, built once on first use
+        /// </summary>
+        /// <returns>Table indexed by eSyscallId</returns>
+        inline const int* table()
+        {
+            static const struct TableHolder
+            {
+                int indices[id_count];
+                TableHolder() { build_table( indices ); }
+            } holder;
+
+            return holder.indices;
+        }
+    }
+
     template<typename T>
     using to_int64 = std::conditional_t<sizeof( T ) < sizeof( int64_t ), int64_t, T>;
 
@@ -46,6 +185,26 @@ namespace syscall
         return syscall<NTSTATUS>( index, std::forward<Args>( args )... );
     }
 
+    /// <summary>
+    /// Get service number from the startup-built table.
+    /// Steady-state cost is one array read, no export lookups
+    /// </summary>
+    /// <param name="id">Compile-time function id</param>
+    /// <returns>Service number, -1 if unresolved</returns>
+    inline int get_index( eSyscallId id )
+    {
+        return (id >= 0 && id < id_count) ? detail::table()[id] : -1;
+    }
+
+    /// <summary>
+    /// Direct syscall with a compile-time function id
+    /// </summary>
+    template<eSyscallId id, typename... Args>
+    NTSTATUS nt_syscall( Args&&... args )
+    {
+        return syscall<NTSTATUS>( get_index( id ), std::forward<Args>( args )... );
+    }
+
     inline int get_index( const wchar_t* modName, const char* func )
     {
 #ifdef USE32